@@ -143,6 +143,8 @@ public final class TJ {
   public static final int PARAM_MAXMEMORY = 23;
   public static final int PARAM_MAXPIXELS = 24;
   public static final int PARAM_SAVEMARKERS = 25;
+  public static final int PARAM_NUMTHREADS = 26;
+  public static final int PARAM_PIPELINE = 27;
 
   public static final int NUMERR = 2;
   public static final int ERR_WARNING = 0;
@@ -696,6 +698,33 @@ public final class TJ {
 
   // --------------------------------------------------------------------------
 
+  public static native int tj3BuildIndex(Pointer handle, Pointer jpegBuf,
+                                         NativeLong jpegSize,
+                                         PointerByReference indexBuf,
+                                         NativeLongByReference indexSize);
+
+  public static void buildIndex(Pointer handle, Pointer jpegBuf,
+                                NativeLong jpegSize,
+                                PointerByReference indexBuf,
+                                NativeLongByReference indexSize)
+                                throws Exception {
+    if (tj3BuildIndex(handle, jpegBuf, jpegSize, indexBuf, indexSize) < 0)
+      throw new Exception(tj3GetErrorStr(handle), tj3GetErrorCode(handle));
+  }
+
+  // --------------------------------------------------------------------------
+
+  public static native int tj3SetIndex(Pointer handle, Pointer indexBuf,
+                                       NativeLong indexSize);
+
+  public static void setIndex(Pointer handle, Pointer indexBuf,
+                              NativeLong indexSize) throws Exception {
+    if (tj3SetIndex(handle, indexBuf, indexSize) < 0)
+      throw new Exception(tj3GetErrorStr(handle), tj3GetErrorCode(handle));
+  }
+
+  // --------------------------------------------------------------------------
+
   public static native int tj3Decompress8(Pointer handle, Pointer jpegBuf,
                                           NativeLong jpegSize, Pointer dstBuf,
                                           int pitch, int pixelFormat);
@@ -740,6 +769,66 @@ public final class TJ {
 
   // --------------------------------------------------------------------------
 
+  public static native Pointer tj3DecompressFile8(Pointer handle,
+                                                  String filename,
+                                                  IntByReference width,
+                                                  int align,
+                                                  IntByReference height,
+                                                  int pixelFormat);
+
+  public static Pointer decompressFile8(Pointer handle, String filename,
+                                        IntByReference width, int align,
+                                        IntByReference height,
+                                        int pixelFormat) throws Exception {
+    Pointer retval = tj3DecompressFile8(handle, filename, width, align,
+                                        height, pixelFormat);
+    if (retval == null)
+      throw new Exception(tj3GetErrorStr(handle), tj3GetErrorCode(handle));
+    return retval;
+  }
+
+  // --------------------------------------------------------------------------
+
+  public static native Pointer tj3DecompressFile12(Pointer handle,
+                                                   String filename,
+                                                   IntByReference width,
+                                                   int align,
+                                                   IntByReference height,
+                                                   int pixelFormat);
+
+  public static Pointer decompressFile12(Pointer handle, String filename,
+                                         IntByReference width, int align,
+                                         IntByReference height,
+                                         int pixelFormat) throws Exception {
+    Pointer retval = tj3DecompressFile12(handle, filename, width, align,
+                                         height, pixelFormat);
+    if (retval == null)
+      throw new Exception(tj3GetErrorStr(handle), tj3GetErrorCode(handle));
+    return retval;
+  }
+
+  // --------------------------------------------------------------------------
+
+  public static native Pointer tj3DecompressFile16(Pointer handle,
+                                                   String filename,
+                                                   IntByReference width,
+                                                   int align,
+                                                   IntByReference height,
+                                                   int pixelFormat);
+
+  public static Pointer decompressFile16(Pointer handle, String filename,
+                                         IntByReference width, int align,
+                                         IntByReference height,
+                                         int pixelFormat) throws Exception {
+    Pointer retval = tj3DecompressFile16(handle, filename, width, align,
+                                         height, pixelFormat);
+    if (retval == null)
+      throw new Exception(tj3GetErrorStr(handle), tj3GetErrorCode(handle));
+    return retval;
+  }
+
+  // --------------------------------------------------------------------------
+
   public static native int
     tj3DecompressToYUVPlanes8(Pointer handle, Pointer jpegBuf,
                               NativeLong jpegSize, PointerReference dstPlanes,
@@ -39,9 +39,10 @@ final class TJBench {
   private TJBench() {}
 
   private static boolean stopOnWarning, bottomUp, noRealloc = true,
-    fastUpsample, fastDCT, optimize, progressive, arithmetic, lossless, noICC;
+    fastUpsample, fastDCT, optimize, progressive, arithmetic, lossless, noICC,
+    pipeline;
   private static int precision = 8, maxScans = 0, restartIntervalBlocks = 0,
-    restartIntervalRows = 0, maxMemory = 0, maxPixels = 0;
+    restartIntervalRows = 0, maxMemory = 0, maxPixels = 0, numThreads = 1;
   private static String ext = null;
   private static boolean compOnly, decompOnly, write = true, doTile, doYUV;
   private static int sampleSize, pf = TJ.PF_BGR, quiet = 0, yuvAlign = 1;
@@ -191,6 +192,8 @@ final class TJBench {
       TJ.set(handle, TJ.PARAM_SCANLIMIT, maxScans);
       TJ.set(handle, TJ.PARAM_MAXMEMORY, maxMemory);
       TJ.set(handle, TJ.PARAM_MAXPIXELS, maxPixels);
+      TJ.set(handle, TJ.PARAM_NUMTHREADS, numThreads);
+      TJ.set(handle, TJ.PARAM_PIPELINE, pipeline ? 1 : 0);
       if (noICC)
         TJ.set(handle, TJ.PARAM_SAVEMARKERS, 0);
 
@@ -426,6 +429,7 @@ final class TJBench {
         TJ.set(handle, TJ.PARAM_RESTARTBLOCKS, restartIntervalBlocks);
         TJ.set(handle, TJ.PARAM_RESTARTROWS, restartIntervalRows);
         TJ.set(handle, TJ.PARAM_MAXMEMORY, maxMemory);
+        TJ.set(handle, TJ.PARAM_NUMTHREADS, numThreads);
 
         if (doYUV) {
           yuvSize = TJ.yuvBufSize(tilew, yuvAlign, tileh, subsamp);
@@ -881,6 +885,9 @@ final class TJBench {
     System.out.println("-nowrite");
     System.out.println("    Do not write reference or output images (improves consistency of benchmark");
     System.out.println("    results)");
+    System.out.println("-pipeline");
+    System.out.println("    Perform entropy decoding and image reconstruction in separate threads when");
+    System.out.println("    decompressing single-scan lossy JPEG images");
     System.out.println("-pixelformat {rgb|bgr|rgbx|bgrx|xbgr|xrgb|gray}");
     System.out.println("    Use the specified pixel format for packed-pixel source/destination buffers");
     System.out.println("    [default = BGR]");
@@ -902,6 +909,9 @@ final class TJBench {
     System.out.println("-strict");
     System.out.println("    Immediately discontinue the current compression/decompression/transform");
     System.out.println("    operation if a warning (non-fatal error) occurs");
+    System.out.println("-threads N");
+    System.out.println("    Use up to N threads when compressing or decompressing lossy JPEG images");
+    System.out.println("    (0 = one thread per CPU) [default = 1]");
     System.out.println("-tile");
     System.out.println("    Compress/transform the input image into separate JPEG tiles of varying");
     System.out.println("    sizes (useful for measuring JPEG overhead)");
@@ -1165,8 +1175,10 @@ final class TJBench {
                    matchArg(argv[i], "-optimise", 2)) {
             optimize = true;
             xformOpt |= TJ.XOPT_OPTIMIZE;
-          } else if (matchArg(argv[i], "-pixelformat", 3) &&
-                     i < argv.length - 1) {
+          } else if (matchArg(argv[i], "-pipeline", 4))
+            pipeline = true;
+          else if (matchArg(argv[i], "-pixelformat", 3) &&
+                   i < argv.length - 1) {
             i++;
             if (argv[i].equalsIgnoreCase("bgr"))
               pf = TJ.PF_BGR;
@@ -1292,6 +1304,16 @@ final class TJBench {
               if (!match) usage();
             } else
               usage();
+          } else if (matchArg(argv[i], "-threads", 3) &&
+                     i < argv.length - 1) {
+            int temp = -1;
+
+            try {
+              temp = Integer.parseInt(argv[++i]);
+            } catch (NumberFormatException e) {}
+            if (temp < 0)
+              usage();
+            numThreads = temp;
           } else if (matchArg(argv[i], "-tile", 3)) {
             doTile = true;  xformOpt |= TJ.XOPT_CROP;
           } else if (matchArg(argv[i], "-transverse", 7))
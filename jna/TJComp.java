@@ -93,7 +93,10 @@ final class TJComp {
     System.out.println("    implies -optimize unless -arithmetic is also specified)");
     System.out.println("-restart N");
     System.out.println("    Add a restart marker every N MCU rows [default = 0 (no restart markers)].");
-    System.out.println("    Append 'B' to specify the restart marker interval in MCUs (lossy only.)\n");
+    System.out.println("    Append 'B' to specify the restart marker interval in MCUs (lossy only.)");
+    System.out.println("-threads N");
+    System.out.println("    Use up to N threads to compress lossy JPEG images with restart markers or");
+    System.out.println("    to optimize Huffman tables (0 = one thread per CPU) [default = 1]\n");
 
     System.out.println("LOSSY JPEG OPTIONS (CAN BE ABBREVIATED)");
     System.out.println("---------------------------------------");
@@ -145,8 +148,9 @@ final class TJComp {
     try {
       int i;
       int arithmetic = -1, colorspace = TJ.CS_DEFAULT, fastDCT = -1,
-        losslessPSV = -1, losslessPt = -1, maxMemory = -1, optimize = -1,
-        precision = 8, progressive = -1, quality = DEFAULT_QUALITY,
+        losslessPSV = -1, losslessPt = -1, maxMemory = -1, numThreads = -1,
+        optimize = -1, precision = 8, progressive = -1,
+        quality = DEFAULT_QUALITY,
         restartIntervalBlocks = -1, restartIntervalRows = -1,
         subsamp = DEFAULT_SUBSAMP;
       boolean noICC = false;
@@ -233,6 +237,15 @@ final class TJComp {
             restartIntervalBlocks = temp;
           else
             restartIntervalRows = temp;
+        } else if (matchArg(argv[i], "-threads", 2) && i < argv.length - 1) {
+          int temp = -1;
+
+          try {
+            temp = Integer.parseInt(argv[++i]);
+          } catch (NumberFormatException e) {}
+          if (temp < 0)
+            usage();
+          numThreads = temp;
         } else if (matchArg(argv[i], "-subsamp", 2) && i < argv.length - 1) {
           i++;
           if (matchArg(argv[i], "444", 3))
@@ -286,6 +299,8 @@ final class TJComp {
           TJ.set(tjInstance, TJ.PARAM_RESTARTROWS, restartIntervalRows);
         if (maxMemory >= 0)
           TJ.set(tjInstance, TJ.PARAM_MAXMEMORY, maxMemory);
+        if (numThreads >= 0)
+          TJ.set(tjInstance, TJ.PARAM_NUMTHREADS, numThreads);
         if (noICC)
           TJ.set(tjInstance, TJ.PARAM_SAVEMARKERS, 0);
 
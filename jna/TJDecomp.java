@@ -99,10 +99,16 @@ final class TJDecomp {
     System.out.println("-noicc");
     System.out.println("    Do not transfer the embedded ICC profile (if any) from the JPEG image to a");
     System.out.println("    PNG output image");
+    System.out.println("-pipeline");
+    System.out.println("    Perform entropy decoding and image reconstruction in separate threads when");
+    System.out.println("    decompressing single-scan lossy JPEG images");
     System.out.println("-strict");
     System.out.println("    Treat all warnings as fatal; abort immediately if incomplete or corrupt");
     System.out.println("    data is encountered in the JPEG image, rather than trying to salvage the");
-    System.out.println("    rest of the image\n");
+    System.out.println("    rest of the image");
+    System.out.println("-threads N");
+    System.out.println("    Use up to N threads to decompress lossy JPEG images (0 = one thread per");
+    System.out.println("    CPU) [default = 1]\n");
 
     System.out.println("LOSSY JPEG OPTIONS (CAN BE ABBREVIATED)");
     System.out.println("---------------------------------------");
@@ -170,9 +176,10 @@ final class TJDecomp {
 
       int i;
       int colorspace, fastDCT = -1, fastUpsample = -1, jpegPrecision,
-        maxMemory = -1, maxScans = -1, pixelFormat = TJ.PF_UNKNOWN,
-        precision = -1, stopOnWarning = -1, subsamp;
-      boolean lossless, noICC = false;
+        maxMemory = -1, maxScans = -1, numThreads = -1,
+        pixelFormat = TJ.PF_UNKNOWN, precision = -1, stopOnWarning = -1,
+        subsamp;
+      boolean lossless, noICC = false, pipeline = false;
       TJ.Region croppingRegion = TJ.UNCROPPED;
       TJ.ScalingFactor scalingFactor = TJ.UNSCALED;
       String iccFilename = null;
@@ -236,6 +243,8 @@ final class TJDecomp {
           noICC = true;
         else if (matchArg(argv[i], "-nosmooth", 2))
           fastUpsample = 1;
+        else if (matchArg(argv[i], "-pipeline", 2))
+          pipeline = true;
         else if (matchArg(argv[i], "-precision", 4) && i < argv.length - 1) {
           int temp = 0;
 
@@ -249,7 +258,16 @@ final class TJDecomp {
           pixelFormat = TJ.PF_RGB;
         else if (matchArg(argv[i], "-strict", 3))
           stopOnWarning = 1;
-        else if (matchArg(argv[i], "-scale", 2) && i < argv.length - 1) {
+        else if (matchArg(argv[i], "-threads", 2) && i < argv.length - 1) {
+          int temp = -1;
+
+          try {
+            temp = Integer.parseInt(argv[++i]);
+          } catch (NumberFormatException e) {}
+          if (temp < 0)
+            usage();
+          numThreads = temp;
+        } else if (matchArg(argv[i], "-scale", 2) && i < argv.length - 1) {
           int tempNum = 0, tempDenom = 0;
           boolean match = false, scanned = true;
           Scanner scanner = new Scanner(argv[++i]).useDelimiter("/");
@@ -289,6 +307,10 @@ final class TJDecomp {
           TJ.set(tjInstance, TJ.PARAM_SCANLIMIT, maxScans);
         if (maxMemory >= 0)
           TJ.set(tjInstance, TJ.PARAM_MAXMEMORY, maxMemory);
+        if (numThreads >= 0)
+          TJ.set(tjInstance, TJ.PARAM_NUMTHREADS, numThreads);
+        if (pipeline)
+          TJ.set(tjInstance, TJ.PARAM_PIPELINE, 1);
 
         File jpegFile = new File(argv[i++]);
         try (FileInputStream fis = new FileInputStream(jpegFile)) {
@@ -2,7 +2,7 @@
  * Scaled Integer Inverse DCT (Arm Neon)
  *
  * Copyright (C) 2020, Arm Limited.
- * Copyright (C) 2020, 2024-2025, D. R. Commander.
+ * Copyright (C) 2020, 2024-2026, D. R. Commander.
  *
  * This software is provided 'as-is', without any express or implied
  * warranty.  In no event will the authors be held liable for any damages
@@ -29,18 +29,39 @@
 #define CONST_BITS  13
 #define PASS1_BITS  2
 
+#define F_0_077  637
+#define F_0_170  1395
 #define F_0_211  1730
+#define F_0_314  2578
+#define F_0_353  2896
+#define F_0_366  2998
 #define F_0_509  4176
+#define F_0_513  4209
 #define F_0_601  4926
+#define F_0_613  5027
+#define F_0_707  5793
 #define F_0_720  5906
 #define F_0_765  6270
+#define F_0_790  6476
+#define F_0_831  6810
 #define F_0_850  6967
+#define F_0_881  7223
 #define F_0_899  7373
+#define F_0_935  7663
+#define F_1_000  8192
 #define F_1_061  8697
+#define F_1_224  10033
 #define F_1_272  10426
+#define F_1_274  10438
+#define F_1_378  11295
+#define F_1_414  11585
 #define F_1_451  11893
+#define F_1_841  15083
 #define F_1_847  15137
+#define F_1_870  15326
 #define F_2_172  17799
+#define F_2_176  17828
+#define F_2_470  20239
 #define F_2_562  20995
 #define F_3_624  29692
 
@@ -478,3 +499,289 @@ jsimd_idct_4x4_neon(void *dct_table, JCOEFPTR coef_block,
   vst2_lane_u16((uint16_t *)outptr2, output_01_23, 2);
   vst2_lane_u16((uint16_t *)outptr3, output_01_23, 3);
 }
+
+
+/* jsimd_idct_7x7_neon(), jsimd_idct_6x6_neon(), jsimd_idct_5x5_neon(), and
+ * jsimd_idct_3x3_neon() are inverse DCT functions that produce reduced-size
+ * NxN output from an 8x8 DCT block.  They produce exactly the same output as
+ * the corresponding jpeg_idct_NxN() functions in jidctint.c.
+ *
+ * In each 1-D pass of those functions, output k and output N-1-k are formed
+ * from the same even part and odd part (with the sign of the odd part
+ * reversed), and each part is a weighted sum of the even-numbered or
+ * odd-numbered inputs.  Rather than mirroring the butterfly structure of the C
+ * code, the constant tables below hold the combined weights for each output
+ * k <= (N-1)/2, so that both passes reduce to a series of multiply-accumulate
+ * operations.  The weights are sums of the same scaled integer constants used
+ * in jidctint.c, so the 32-bit intermediate results are identical.
+ */
+
+ALIGN(16) static const int16_t jsimd_idct_7x7_neon_consts[4][7] = {
+  { F_1_000, F_0_613 + F_0_935 - F_0_170, F_1_274, F_0_170 + F_0_935,
+    F_0_881, F_0_613, F_1_274 - F_0_077 - F_0_881 },
+  { F_1_000, F_0_170 + F_0_935, F_0_314, F_0_935 - F_0_170 - F_1_378,
+    F_0_881 - F_0_314 - F_1_841, -F_1_378, -F_0_881 },
+  { F_1_000, F_0_613, F_0_314 + F_1_274 - F_2_470, -F_1_378,
+    -F_0_314, F_0_613 + F_1_870 - F_1_378, F_1_274 },
+  { F_1_000, 0, -F_1_414, 0, F_1_414, 0, -F_1_414 }
+};
+
+ALIGN(16) static const int16_t jsimd_idct_6x6_neon_consts[3][6] = {
+  { F_1_000, F_1_000 + F_0_366, F_1_224, F_1_000, F_0_707, F_0_366 },
+  { F_1_000, F_1_000, 0, -F_1_000, -F_0_707 * 2, -F_1_000 },
+  { F_1_000, F_0_366, -F_1_224, -F_1_000, F_0_707, F_1_000 + F_0_366 }
+};
+
+ALIGN(16) static const int16_t jsimd_idct_5x5_neon_consts[3][5] = {
+  { F_1_000, F_0_513 + F_0_831, F_0_353 + F_0_790, F_0_831,
+    F_0_790 - F_0_353 },
+  { F_1_000, F_0_831, F_0_353 - F_0_790, F_0_831 - F_2_176,
+    -F_0_353 - F_0_790 },
+  { F_1_000, 0, -F_0_353 * 4, 0, F_0_353 * 4 }
+};
+
+ALIGN(16) static const int16_t jsimd_idct_3x3_neon_consts[2][3] = {
+  { F_1_000, F_1_224, F_0_707 },
+  { F_1_000, 0, -F_0_707 * 2 }
+};
+
+
+/* Perform one 1-D pass of an NxN inverse DCT on eight columns (pass 1) or
+ * eight rows (pass 2) at once.  in[j] holds input j for each of the eight
+ * columns or rows, and out_l[k] and out_h[k] receive the unscaled 32-bit
+ * results for output k.
+ */
+
+static INLINE void jsimd_idct_nxn_pass(int n, const int16_t *consts,
+                                       const int16x8_t *in, int32x4_t *out_l,
+                                       int32x4_t *out_h)
+{
+  int j, k;
+
+  for (k = 0; k < (n + 1) / 2; k++, consts += n) {
+    /* Even part */
+    int32x4_t even_l = vmull_n_s16(vget_low_s16(in[0]), consts[0]);
+    int32x4_t even_h = vmull_n_s16(vget_high_s16(in[0]), consts[0]);
+    for (j = 2; j < n; j += 2) {
+      even_l = vmlal_n_s16(even_l, vget_low_s16(in[j]), consts[j]);
+      even_h = vmlal_n_s16(even_h, vget_high_s16(in[j]), consts[j]);
+    }
+
+    if (k == n - 1 - k) {
+      out_l[k] = even_l;
+      out_h[k] = even_h;
+      break;
+    }
+
+    /* Odd part */
+    int32x4_t odd_l = vmull_n_s16(vget_low_s16(in[1]), consts[1]);
+    int32x4_t odd_h = vmull_n_s16(vget_high_s16(in[1]), consts[1]);
+    for (j = 3; j < n; j += 2) {
+      odd_l = vmlal_n_s16(odd_l, vget_low_s16(in[j]), consts[j]);
+      odd_h = vmlal_n_s16(odd_h, vget_high_s16(in[j]), consts[j]);
+    }
+
+    out_l[k] = vaddq_s32(even_l, odd_l);
+    out_h[k] = vaddq_s32(even_h, odd_h);
+    out_l[n - 1 - k] = vsubq_s32(even_l, odd_l);
+    out_h[n - 1 - k] = vsubq_s32(even_h, odd_h);
+  }
+}
+
+
+/* Dequantize the DCT coefficients, perform both passes of an NxN inverse DCT,
+ * and return the output samples.  cols[k] receives output column k for each
+ * of the N output rows (lanes N through 7 are "don't care.")
+ */
+
+static INLINE void jsimd_idct_nxn(int n, const int16_t *consts,
+                                  void *dct_table, JCOEFPTR coef_block,
+                                  uint8x8_t *cols)
+{
+  ISLOW_MULT_TYPE *quantptr = dct_table;
+  int16x8_t rows[DCTSIZE];
+  int32x4_t out_l[DCTSIZE - 1], out_h[DCTSIZE - 1];
+  int k;
+
+  /* Load and dequantize the DCT coefficients.  Only the first N rows and
+   * columns contribute to the output.
+   */
+  for (k = 0; k < n; k++)
+    rows[k] = vmulq_s16(vld1q_s16(coef_block + k * DCTSIZE),
+                        vld1q_s16(quantptr + k * DCTSIZE));
+
+  /* Pass 1: process columns from input. */
+  jsimd_idct_nxn_pass(n, consts, rows, out_l, out_h);
+
+  /* Descale and narrow to 16-bit. */
+  for (k = 0; k < n; k++)
+    rows[k] = vcombine_s16(vrshrn_n_s32(out_l[k], CONST_BITS - PASS1_BITS),
+                           vrshrn_n_s32(out_h[k], CONST_BITS - PASS1_BITS));
+  for (; k < DCTSIZE; k++)
+    rows[k] = vdupq_n_s16(0);
+
+  /* Transpose 8x8 block to perform IDCT on rows in second pass. */
+  int16x8x2_t rows_01 = vtrnq_s16(rows[0], rows[1]);
+  int16x8x2_t rows_23 = vtrnq_s16(rows[2], rows[3]);
+  int16x8x2_t rows_45 = vtrnq_s16(rows[4], rows[5]);
+  int16x8x2_t rows_67 = vtrnq_s16(rows[6], rows[7]);
+
+  int32x4x2_t cols_04_26 = vtrnq_s32(vreinterpretq_s32_s16(rows_01.val[0]),
+                                     vreinterpretq_s32_s16(rows_23.val[0]));
+  int32x4x2_t cols_15_37 = vtrnq_s32(vreinterpretq_s32_s16(rows_01.val[1]),
+                                     vreinterpretq_s32_s16(rows_23.val[1]));
+  int32x4x2_t cols_04_26_h =
+    vtrnq_s32(vreinterpretq_s32_s16(rows_45.val[0]),
+              vreinterpretq_s32_s16(rows_67.val[0]));
+  int32x4x2_t cols_15_37_h =
+    vtrnq_s32(vreinterpretq_s32_s16(rows_45.val[1]),
+              vreinterpretq_s32_s16(rows_67.val[1]));
+
+  int16x8_t cols_s16[DCTSIZE];
+  cols_s16[0] = vreinterpretq_s16_s32(
+    vcombine_s32(vget_low_s32(cols_04_26.val[0]),
+                 vget_low_s32(cols_04_26_h.val[0])));
+  cols_s16[1] = vreinterpretq_s16_s32(
+    vcombine_s32(vget_low_s32(cols_15_37.val[0]),
+                 vget_low_s32(cols_15_37_h.val[0])));
+  cols_s16[2] = vreinterpretq_s16_s32(
+    vcombine_s32(vget_low_s32(cols_04_26.val[1]),
+                 vget_low_s32(cols_04_26_h.val[1])));
+  cols_s16[3] = vreinterpretq_s16_s32(
+    vcombine_s32(vget_low_s32(cols_15_37.val[1]),
+                 vget_low_s32(cols_15_37_h.val[1])));
+  cols_s16[4] = vreinterpretq_s16_s32(
+    vcombine_s32(vget_high_s32(cols_04_26.val[0]),
+                 vget_high_s32(cols_04_26_h.val[0])));
+  cols_s16[5] = vreinterpretq_s16_s32(
+    vcombine_s32(vget_high_s32(cols_15_37.val[0]),
+                 vget_high_s32(cols_15_37_h.val[0])));
+  cols_s16[6] = vreinterpretq_s16_s32(
+    vcombine_s32(vget_high_s32(cols_04_26.val[1]),
+                 vget_high_s32(cols_04_26_h.val[1])));
+
+  /* Pass 2: process rows from work array. */
+  jsimd_idct_nxn_pass(n, consts, cols_s16, out_l, out_h);
+
+  /* Descale, clamp to range [0-255], and narrow to 8-bit.  (Narrowing to the
+   * upper 16 bits first and then applying the remaining rounding shift gives
+   * the same result as a single rounding shift.)
+   */
+  for (k = 0; k < n; k++) {
+    int16x8_t col = vcombine_s16(vshrn_n_s32(out_l[k], 16),
+                                 vshrn_n_s32(out_h[k], 16));
+    col = vrsraq_n_s16(vdupq_n_s16(CENTERJSAMPLE), col,
+                       CONST_BITS + PASS1_BITS + 3 - 16);
+    cols[k] = vqmovun_s16(col);
+  }
+}
+
+
+HIDDEN void
+jsimd_idct_7x7_neon(void *dct_table, JCOEFPTR coef_block,
+                    JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  uint8x8_t cols[7];
+
+  jsimd_idct_nxn(7, &jsimd_idct_7x7_neon_consts[0][0], dct_table, coef_block,
+                 cols);
+
+  /* Store 7x7 block to memory.  (VST4 and VST3 of 8-bit elements complete
+   * the transpose.)
+   */
+  uint8x8x4_t cols_0123 = { { cols[0], cols[1], cols[2], cols[3] } };
+  uint8x8x3_t cols_456 = { { cols[4], cols[5], cols[6] } };
+
+  vst4_lane_u8(output_buf[0] + output_col, cols_0123, 0);
+  vst3_lane_u8(output_buf[0] + output_col + 4, cols_456, 0);
+  vst4_lane_u8(output_buf[1] + output_col, cols_0123, 1);
+  vst3_lane_u8(output_buf[1] + output_col + 4, cols_456, 1);
+  vst4_lane_u8(output_buf[2] + output_col, cols_0123, 2);
+  vst3_lane_u8(output_buf[2] + output_col + 4, cols_456, 2);
+  vst4_lane_u8(output_buf[3] + output_col, cols_0123, 3);
+  vst3_lane_u8(output_buf[3] + output_col + 4, cols_456, 3);
+  vst4_lane_u8(output_buf[4] + output_col, cols_0123, 4);
+  vst3_lane_u8(output_buf[4] + output_col + 4, cols_456, 4);
+  vst4_lane_u8(output_buf[5] + output_col, cols_0123, 5);
+  vst3_lane_u8(output_buf[5] + output_col + 4, cols_456, 5);
+  vst4_lane_u8(output_buf[6] + output_col, cols_0123, 6);
+  vst3_lane_u8(output_buf[6] + output_col + 4, cols_456, 6);
+}
+
+
+HIDDEN void
+jsimd_idct_6x6_neon(void *dct_table, JCOEFPTR coef_block,
+                    JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  uint8x8_t cols[6];
+
+  jsimd_idct_nxn(6, &jsimd_idct_6x6_neon_consts[0][0], dct_table, coef_block,
+                 cols);
+
+  /* Store 6x6 block to memory.  (VST3 of 8-bit elements completes the
+   * transpose.)
+   */
+  uint8x8x3_t cols_012 = { { cols[0], cols[1], cols[2] } };
+  uint8x8x3_t cols_345 = { { cols[3], cols[4], cols[5] } };
+
+  vst3_lane_u8(output_buf[0] + output_col, cols_012, 0);
+  vst3_lane_u8(output_buf[0] + output_col + 3, cols_345, 0);
+  vst3_lane_u8(output_buf[1] + output_col, cols_012, 1);
+  vst3_lane_u8(output_buf[1] + output_col + 3, cols_345, 1);
+  vst3_lane_u8(output_buf[2] + output_col, cols_012, 2);
+  vst3_lane_u8(output_buf[2] + output_col + 3, cols_345, 2);
+  vst3_lane_u8(output_buf[3] + output_col, cols_012, 3);
+  vst3_lane_u8(output_buf[3] + output_col + 3, cols_345, 3);
+  vst3_lane_u8(output_buf[4] + output_col, cols_012, 4);
+  vst3_lane_u8(output_buf[4] + output_col + 3, cols_345, 4);
+  vst3_lane_u8(output_buf[5] + output_col, cols_012, 5);
+  vst3_lane_u8(output_buf[5] + output_col + 3, cols_345, 5);
+}
+
+
+HIDDEN void
+jsimd_idct_5x5_neon(void *dct_table, JCOEFPTR coef_block,
+                    JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  uint8x8_t cols[5];
+
+  jsimd_idct_nxn(5, &jsimd_idct_5x5_neon_consts[0][0], dct_table, coef_block,
+                 cols);
+
+  /* Store 5x5 block to memory.  (VST3 and VST2 of 8-bit elements complete
+   * the transpose.)
+   */
+  uint8x8x3_t cols_012 = { { cols[0], cols[1], cols[2] } };
+  uint8x8x2_t cols_34 = { { cols[3], cols[4] } };
+
+  vst3_lane_u8(output_buf[0] + output_col, cols_012, 0);
+  vst2_lane_u8(output_buf[0] + output_col + 3, cols_34, 0);
+  vst3_lane_u8(output_buf[1] + output_col, cols_012, 1);
+  vst2_lane_u8(output_buf[1] + output_col + 3, cols_34, 1);
+  vst3_lane_u8(output_buf[2] + output_col, cols_012, 2);
+  vst2_lane_u8(output_buf[2] + output_col + 3, cols_34, 2);
+  vst3_lane_u8(output_buf[3] + output_col, cols_012, 3);
+  vst2_lane_u8(output_buf[3] + output_col + 3, cols_34, 3);
+  vst3_lane_u8(output_buf[4] + output_col, cols_012, 4);
+  vst2_lane_u8(output_buf[4] + output_col + 3, cols_34, 4);
+}
+
+
+HIDDEN void
+jsimd_idct_3x3_neon(void *dct_table, JCOEFPTR coef_block,
+                    JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  uint8x8_t cols[3];
+
+  jsimd_idct_nxn(3, &jsimd_idct_3x3_neon_consts[0][0], dct_table, coef_block,
+                 cols);
+
+  /* Store 3x3 block to memory.  (VST3 of 8-bit elements completes the
+   * transpose.)
+   */
+  uint8x8x3_t cols_012 = { { cols[0], cols[1], cols[2] } };
+
+  vst3_lane_u8(output_buf[0] + output_col, cols_012, 0);
+  vst3_lane_u8(output_buf[1] + output_col, cols_012, 1);
+  vst3_lane_u8(output_buf[2] + output_col, cols_012, 2);
+}
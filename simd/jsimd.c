@@ -44,6 +44,7 @@
 
 #define IS_ALIGNED_SSE(ptr)  (IS_ALIGNED(ptr, 4)) /* 16 byte alignment */
 #define IS_ALIGNED_AVX(ptr)  (IS_ALIGNED(ptr, 5)) /* 32 byte alignment */
+#define IS_ALIGNED_AVX512(ptr)  (IS_ALIGNED(ptr, 6)) /* 64 byte alignment */
 
 #endif
 
@@ -72,6 +73,10 @@ init_simd(j_common_ptr cinfo)
 #ifndef NO_GETENV
   /* Force different settings through environment variables */
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#if SIMD_ARCHITECTURE == X86_64
+  if (!GETENV_S(env, 2, "JSIMD_FORCEAVX2") && !strcmp(env, "1"))
+    simd_support &= JSIMD_AVX2 | JSIMD_SSE2 | JSIMD_SSE;
+#endif
   if (!GETENV_S(env, 2, "JSIMD_FORCESSE2") && !strcmp(env, "1"))
     simd_support &= JSIMD_SSE2 | JSIMD_SSE;
 #if SIMD_ARCHITECTURE == I386
@@ -123,6 +128,13 @@ jsimd_set_rgb_ycc(j_compress_ptr cinfo)
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#ifdef WITH_AVX512
+  if ((cinfo->master->simd_support & JSIMD_AVX512) &&
+      IS_ALIGNED_AVX512(jconst_rgb_ycc_convert_avx512)) {
+    SET_SIMD_EXTRGB_COLOR_CONVERTER(ycc, avx512);
+    return JSIMD_AVX512;
+  }
+#endif
   if ((cinfo->master->simd_support & JSIMD_AVX2) &&
       IS_ALIGNED_AVX(jconst_rgb_ycc_convert_avx2)) {
     SET_SIMD_EXTRGB_COLOR_CONVERTER(ycc, avx2);
@@ -231,6 +243,40 @@ jsimd_color_convert(j_compress_ptr cinfo, JSAMPARRAY input_buf,
 }
 
 
+HIDDEN unsigned int
+jsimd12_set_rgb_ycc(j_compress_ptr cinfo)
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JDIMENSION) != 4)
+    return JSIMD_NONE;
+  if ((RGB_PIXELSIZE != 3) && (RGB_PIXELSIZE != 4))
+    return JSIMD_NONE;
+  if (!cinfo->cconvert)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst12_rgb_ycc_convert_avx2)) {
+    SET_SIMD12_EXTRGB_COLOR_CONVERTER(avx2);
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN void
+jsimd12_color_convert(j_compress_ptr cinfo, J12SAMPARRAY input_buf,
+                      J12SAMPIMAGE output_buf, JDIMENSION output_row,
+                      int num_rows)
+{
+  cinfo->cconvert->color_convert_simd_12(cinfo->image_width, input_buf,
+                                         output_buf, output_row, num_rows);
+}
+
+
 HIDDEN unsigned int
 jsimd_set_ycc_rgb(j_decompress_ptr cinfo)
 {
@@ -246,6 +292,13 @@ jsimd_set_ycc_rgb(j_decompress_ptr cinfo)
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#ifdef WITH_AVX512
+  if ((cinfo->master->simd_support & JSIMD_AVX512) &&
+      IS_ALIGNED_AVX512(jconst_ycc_rgb_convert_avx512)) {
+    SET_SIMD_EXTRGB_COLOR_DECONVERTER(avx512);
+    return JSIMD_AVX512;
+  }
+#endif
   if ((cinfo->master->simd_support & JSIMD_AVX2) &&
       IS_ALIGNED_AVX(jconst_ycc_rgb_convert_avx2)) {
     SET_SIMD_EXTRGB_COLOR_DECONVERTER(avx2);
@@ -321,6 +374,40 @@ jsimd_color_deconvert(j_decompress_ptr cinfo, JSAMPIMAGE input_buf,
 }
 
 
+HIDDEN unsigned int
+jsimd12_set_ycc_rgb(j_decompress_ptr cinfo)
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JDIMENSION) != 4)
+    return JSIMD_NONE;
+  if ((RGB_PIXELSIZE != 3) && (RGB_PIXELSIZE != 4))
+    return JSIMD_NONE;
+  if (!cinfo->cconvert)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst12_ycc_rgb_convert_avx2)) {
+    SET_SIMD12_EXTRGB_COLOR_DECONVERTER(avx2);
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN void
+jsimd12_color_deconvert(j_decompress_ptr cinfo, J12SAMPIMAGE input_buf,
+                        JDIMENSION input_row, J12SAMPARRAY output_buf,
+                        int num_rows)
+{
+  cinfo->cconvert->color_convert_simd_12(cinfo->output_width, input_buf,
+                                         input_row, output_buf, num_rows);
+}
+
+
 HIDDEN unsigned int
 jsimd_set_h2v1_downsample(j_compress_ptr cinfo)
 {
@@ -381,6 +468,44 @@ jsimd_h2v1_downsample(j_compress_ptr cinfo, jpeg_component_info *compptr,
 }
 
 
+HIDDEN unsigned int
+jsimd12_set_h2v1_downsample(j_compress_ptr cinfo)
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JDIMENSION) != 4)
+    return JSIMD_NONE;
+  if (!cinfo->downsample)
+    return JSIMD_NONE;
+  /* The SIMD routines assume that each component is a whole number of
+   * 8-sample-wide blocks.
+   */
+  if (cinfo->master->lossless)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64
+  if (cinfo->master->simd_support & JSIMD_AVX2) {
+    cinfo->downsample->h2v1_downsample_simd_12 = jsimd12_h2v1_downsample_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN void
+jsimd12_h2v1_downsample(j_compress_ptr cinfo, jpeg_component_info *compptr,
+                        J12SAMPARRAY input_data, J12SAMPARRAY output_data)
+{
+  cinfo->downsample->h2v1_downsample_simd_12(cinfo->image_width,
+                                             cinfo->max_v_samp_factor,
+                                             compptr->v_samp_factor,
+                                             compptr->width_in_blocks,
+                                             input_data, output_data);
+}
+
+
 HIDDEN unsigned int
 jsimd_set_h2v2_downsample(j_compress_ptr cinfo)
 {
@@ -446,6 +571,44 @@ jsimd_h2v2_downsample(j_compress_ptr cinfo, jpeg_component_info *compptr,
 }
 
 
+HIDDEN unsigned int
+jsimd12_set_h2v2_downsample(j_compress_ptr cinfo)
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JDIMENSION) != 4)
+    return JSIMD_NONE;
+  if (!cinfo->downsample)
+    return JSIMD_NONE;
+  /* The SIMD routines assume that each component is a whole number of
+   * 8-sample-wide blocks.
+   */
+  if (cinfo->master->lossless)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64
+  if (cinfo->master->simd_support & JSIMD_AVX2) {
+    cinfo->downsample->h2v2_downsample_simd_12 = jsimd12_h2v2_downsample_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN void
+jsimd12_h2v2_downsample(j_compress_ptr cinfo, jpeg_component_info *compptr,
+                        J12SAMPARRAY input_data, J12SAMPARRAY output_data)
+{
+  cinfo->downsample->h2v2_downsample_simd_12(cinfo->image_width,
+                                             cinfo->max_v_samp_factor,
+                                             compptr->v_samp_factor,
+                                             compptr->width_in_blocks,
+                                             input_data, output_data);
+}
+
+
 HIDDEN unsigned int
 jsimd_set_h2v1_upsample(j_decompress_ptr cinfo)
 {
@@ -575,6 +738,13 @@ jsimd_set_h2v1_fancy_upsample(j_decompress_ptr cinfo)
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#ifdef WITH_AVX512
+  if ((cinfo->master->simd_support & JSIMD_AVX512) &&
+      IS_ALIGNED_AVX512(jconst_fancy_upsample_avx512)) {
+    cinfo->upsample->h2v1_upsample_simd = jsimd_h2v1_fancy_upsample_avx512;
+    return JSIMD_AVX512;
+  }
+#endif
   if ((cinfo->master->simd_support & JSIMD_AVX2) &&
       IS_ALIGNED_AVX(jconst_fancy_upsample_avx2)) {
     cinfo->upsample->h2v1_upsample_simd = jsimd_h2v1_fancy_upsample_avx2;
@@ -627,6 +797,41 @@ jsimd_h2v1_fancy_upsample(j_decompress_ptr cinfo, jpeg_component_info *compptr,
 }
 
 
+HIDDEN unsigned int
+jsimd12_set_h2v1_fancy_upsample(j_decompress_ptr cinfo)
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JDIMENSION) != 4)
+    return JSIMD_NONE;
+  if (!cinfo->upsample)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst12_fancy_upsample_avx2)) {
+    cinfo->upsample->h2v1_upsample_simd_12 =
+      jsimd12_h2v1_fancy_upsample_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN void
+jsimd12_h2v1_fancy_upsample(j_decompress_ptr cinfo,
+                            jpeg_component_info *compptr,
+                            J12SAMPARRAY input_data,
+                            J12SAMPARRAY *output_data_ptr)
+{
+  cinfo->upsample->h2v1_upsample_simd_12(cinfo->max_v_samp_factor,
+                                         compptr->downsampled_width,
+                                         input_data, output_data_ptr);
+}
+
+
 HIDDEN unsigned int
 jsimd_set_h2v2_fancy_upsample(j_decompress_ptr cinfo)
 {
@@ -640,6 +845,13 @@ jsimd_set_h2v2_fancy_upsample(j_decompress_ptr cinfo)
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#ifdef WITH_AVX512
+  if ((cinfo->master->simd_support & JSIMD_AVX512) &&
+      IS_ALIGNED_AVX512(jconst_fancy_upsample_avx512)) {
+    cinfo->upsample->h2v2_upsample_simd = jsimd_h2v2_fancy_upsample_avx512;
+    return JSIMD_AVX512;
+  }
+#endif
   if ((cinfo->master->simd_support & JSIMD_AVX2) &&
       IS_ALIGNED_AVX(jconst_fancy_upsample_avx2)) {
     cinfo->upsample->h2v2_upsample_simd = jsimd_h2v2_fancy_upsample_avx2;
@@ -692,6 +904,41 @@ jsimd_h2v2_fancy_upsample(j_decompress_ptr cinfo, jpeg_component_info *compptr,
 }
 
 
+HIDDEN unsigned int
+jsimd12_set_h2v2_fancy_upsample(j_decompress_ptr cinfo)
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JDIMENSION) != 4)
+    return JSIMD_NONE;
+  if (!cinfo->upsample)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst12_fancy_upsample_avx2)) {
+    cinfo->upsample->h2v2_upsample_simd_12 =
+      jsimd12_h2v2_fancy_upsample_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN void
+jsimd12_h2v2_fancy_upsample(j_decompress_ptr cinfo,
+                            jpeg_component_info *compptr,
+                            J12SAMPARRAY input_data,
+                            J12SAMPARRAY *output_data_ptr)
+{
+  cinfo->upsample->h2v2_upsample_simd_12(cinfo->max_v_samp_factor,
+                                         compptr->downsampled_width,
+                                         input_data, output_data_ptr);
+}
+
+
 #if SIMD_ARCHITECTURE == ARM64 || SIMD_ARCHITECTURE == ARM
 
 HIDDEN unsigned int
@@ -740,6 +987,13 @@ jsimd_set_h2v1_merged_upsample(j_decompress_ptr cinfo)
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#ifdef WITH_AVX512
+  if ((cinfo->master->simd_support & JSIMD_AVX512) &&
+      IS_ALIGNED_AVX512(jconst_merged_upsample_avx512)) {
+    SET_SIMD_EXTRGB_MERGED_UPSAMPLER(h2v1, avx512);
+    return JSIMD_AVX512;
+  }
+#endif
   if ((cinfo->master->simd_support & JSIMD_AVX2) &&
       IS_ALIGNED_AVX(jconst_merged_upsample_avx2)) {
     SET_SIMD_EXTRGB_MERGED_UPSAMPLER(h2v1, avx2);
@@ -804,6 +1058,13 @@ jsimd_set_h2v2_merged_upsample(j_decompress_ptr cinfo)
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#ifdef WITH_AVX512
+  if ((cinfo->master->simd_support & JSIMD_AVX512) &&
+      IS_ALIGNED_AVX512(jconst_merged_upsample_avx512)) {
+    SET_SIMD_EXTRGB_MERGED_UPSAMPLER(h2v2, avx512);
+    return JSIMD_AVX512;
+  }
+#endif
   if ((cinfo->master->simd_support & JSIMD_AVX2) &&
       IS_ALIGNED_AVX(jconst_merged_upsample_avx2)) {
     SET_SIMD_EXTRGB_MERGED_UPSAMPLER(h2v2, avx2);
@@ -868,6 +1129,12 @@ jsimd_set_convsamp(j_compress_ptr cinfo, convsamp_method_ptr *method)
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#ifdef WITH_AVX512
+  if (cinfo->master->simd_support & JSIMD_AVX512) {
+    *method = jsimd_convsamp_avx512;
+    return JSIMD_AVX512;
+  }
+#endif
   if (cinfo->master->simd_support & JSIMD_AVX2) {
     *method = jsimd_convsamp_avx2;
     return JSIMD_AVX2;
@@ -903,6 +1170,26 @@ jsimd_set_convsamp(j_compress_ptr cinfo, convsamp_method_ptr *method)
 }
 
 
+HIDDEN unsigned int
+jsimd12_set_convsamp(j_compress_ptr cinfo,
+                     void (**method) (J12SAMPARRAY, JDIMENSION, int *))
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JDIMENSION) != 4)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64
+  if (cinfo->master->simd_support & JSIMD_AVX2) {
+    *method = jsimd12_convsamp_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
 HIDDEN unsigned int
 jsimd_set_convsamp_float(j_compress_ptr cinfo,
                          float_convsamp_method_ptr *method)
@@ -917,6 +1204,12 @@ jsimd_set_convsamp_float(j_compress_ptr cinfo,
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#if SIMD_ARCHITECTURE == X86_64
+  if (cinfo->master->simd_support & JSIMD_AVX2) {
+    *method = jsimd_convsamp_float_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
   if (cinfo->master->simd_support & JSIMD_SSE2) {
     *method = jsimd_convsamp_float_sse2;
     return JSIMD_SSE2;
@@ -946,6 +1239,13 @@ jsimd_set_fdct_islow(j_compress_ptr cinfo, forward_DCT_method_ptr *method)
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#ifdef WITH_AVX512
+  if ((cinfo->master->simd_support & JSIMD_AVX512) &&
+      IS_ALIGNED_AVX512(jconst_fdct_islow_avx512)) {
+    *method = jsimd_fdct_islow_avx512;
+    return JSIMD_AVX512;
+  }
+#endif
   if ((cinfo->master->simd_support & JSIMD_AVX2) &&
       IS_ALIGNED_AVX(jconst_fdct_islow_avx2)) {
     *method = jsimd_fdct_islow_avx2;
@@ -988,6 +1288,23 @@ jsimd_set_fdct_islow(j_compress_ptr cinfo, forward_DCT_method_ptr *method)
 }
 
 
+HIDDEN unsigned int
+jsimd12_set_fdct_islow(j_compress_ptr cinfo, void (**method) (int *))
+{
+  init_simd((j_common_ptr)cinfo);
+
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst12_fdct_islow_avx2)) {
+    *method = jsimd12_fdct_islow_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
 HIDDEN unsigned int
 jsimd_set_fdct_ifast(j_compress_ptr cinfo, forward_DCT_method_ptr *method)
 {
@@ -997,6 +1314,13 @@ jsimd_set_fdct_ifast(j_compress_ptr cinfo, forward_DCT_method_ptr *method)
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst_fdct_ifast_avx2)) {
+    *method = jsimd_fdct_ifast_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
   if ((cinfo->master->simd_support & JSIMD_SSE2) &&
       IS_ALIGNED_SSE(jconst_fdct_ifast_sse2)) {
     *method = jsimd_fdct_ifast_sse2;
@@ -1043,6 +1367,13 @@ jsimd_set_fdct_float(j_compress_ptr cinfo, float_DCT_method_ptr *method)
   if (sizeof(FAST_FLOAT) != 4)
     return JSIMD_NONE;
 
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst_fdct_float_avx2)) {
+    *method = jsimd_fdct_float_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
   if ((cinfo->master->simd_support & JSIMD_SSE) &&
       IS_ALIGNED_SSE(jconst_fdct_float_sse)) {
     *method = jsimd_fdct_float_sse;
@@ -1071,6 +1402,12 @@ jsimd_set_quantize(j_compress_ptr cinfo, quantize_method_ptr *method)
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#ifdef WITH_AVX512
+  if (cinfo->master->simd_support & JSIMD_AVX512) {
+    *method = jsimd_quantize_avx512;
+    return JSIMD_AVX512;
+  }
+#endif
   if (cinfo->master->simd_support & JSIMD_AVX2) {
     *method = jsimd_quantize_avx2;
     return JSIMD_AVX2;
@@ -1111,6 +1448,26 @@ jsimd_set_quantize(j_compress_ptr cinfo, quantize_method_ptr *method)
 }
 
 
+HIDDEN unsigned int
+jsimd12_set_quantize(j_compress_ptr cinfo,
+                     void (**method) (JCOEFPTR, int *, int *))
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JCOEF) != 2)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64
+  if (cinfo->master->simd_support & JSIMD_AVX2) {
+    *method = jsimd12_quantize_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
 HIDDEN unsigned int
 jsimd_set_quantize_float(j_compress_ptr cinfo,
                          float_quantize_method_ptr *method)
@@ -1123,6 +1480,12 @@ jsimd_set_quantize_float(j_compress_ptr cinfo,
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#if SIMD_ARCHITECTURE == X86_64
+  if (cinfo->master->simd_support & JSIMD_AVX2) {
+    *method = jsimd_quantize_float_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
   if (cinfo->master->simd_support & JSIMD_SSE2) {
     *method = jsimd_quantize_float_sse2;
     return JSIMD_SSE2;
@@ -1160,6 +1523,13 @@ jsimd_set_idct_islow(j_decompress_ptr cinfo)
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#ifdef WITH_AVX512
+  if ((cinfo->master->simd_support & JSIMD_AVX512) &&
+      IS_ALIGNED_AVX512(jconst_idct_islow_avx512)) {
+    cinfo->idct->idct_simd = jsimd_idct_islow_avx512;
+    return JSIMD_AVX512;
+  }
+#endif
   if ((cinfo->master->simd_support & JSIMD_AVX2) &&
       IS_ALIGNED_AVX(jconst_idct_islow_avx2)) {
     cinfo->idct->idct_simd = jsimd_idct_islow_avx2;
@@ -1212,6 +1582,46 @@ jsimd_idct_islow(j_decompress_ptr cinfo, jpeg_component_info *compptr,
 }
 
 
+HIDDEN unsigned int
+jsimd12_set_idct_islow(j_decompress_ptr cinfo)
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JCOEF) != 2)
+    return JSIMD_NONE;
+  if (sizeof(JDIMENSION) != 4)
+    return JSIMD_NONE;
+  if (!cinfo->idct)
+    return JSIMD_NONE;
+  /* The C implementation scales the DCT coefficients when decompressing an
+   * 8-bit-per-sample JPEG image into 12-bit-per-sample buffers.  The SIMD
+   * implementation does not.
+   */
+  if (cinfo->master->jpeg_data_precision != cinfo->data_precision)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst12_idct_islow_avx2)) {
+    cinfo->idct->idct_simd_12 = jsimd12_idct_islow_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN void
+jsimd12_idct_islow(j_decompress_ptr cinfo, jpeg_component_info *compptr,
+                   JCOEFPTR coef_block, J12SAMPARRAY output_buf,
+                   JDIMENSION output_col)
+{
+  cinfo->idct->idct_simd_12(compptr->dct_table, coef_block, output_buf,
+                            output_col);
+}
+
+
 HIDDEN unsigned int
 jsimd_set_idct_ifast(j_decompress_ptr cinfo)
 {
@@ -1231,6 +1641,13 @@ jsimd_set_idct_ifast(j_decompress_ptr cinfo)
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst_idct_ifast_avx2)) {
+    cinfo->idct->idct_simd = jsimd_idct_ifast_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
   if ((cinfo->master->simd_support & JSIMD_SSE2) &&
       IS_ALIGNED_SSE(jconst_idct_ifast_sse2)) {
     cinfo->idct->idct_simd = jsimd_idct_ifast_sse2;
@@ -1297,6 +1714,13 @@ jsimd_set_idct_float(j_decompress_ptr cinfo)
   if (!cinfo->idct)
     return JSIMD_NONE;
 
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst_idct_float_avx2)) {
+    cinfo->idct->idct_simd = jsimd_idct_float_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
   if ((cinfo->master->simd_support & JSIMD_SSE2) &&
       IS_ALIGNED_SSE(jconst_idct_float_sse2)) {
     cinfo->idct->idct_simd = jsimd_idct_float_sse2;
@@ -1378,6 +1802,49 @@ jsimd_idct_2x2(j_decompress_ptr cinfo, jpeg_component_info *compptr,
 }
 
 
+HIDDEN unsigned int
+jsimd_set_idct_3x3(j_decompress_ptr cinfo)
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JCOEF) != 2)
+    return JSIMD_NONE;
+  if (BITS_IN_JSAMPLE != 8)
+    return JSIMD_NONE;
+  if (sizeof(JDIMENSION) != 4)
+    return JSIMD_NONE;
+  if (sizeof(ISLOW_MULT_TYPE) != 2)
+    return JSIMD_NONE;
+  if (!cinfo->idct)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+  if ((cinfo->master->simd_support & JSIMD_SSE2) &&
+      IS_ALIGNED_SSE(jconst_idct_red_sse2)) {
+    cinfo->idct->idct_3x3_simd = jsimd_idct_3x3_sse2;
+    return JSIMD_SSE2;
+  }
+#elif SIMD_ARCHITECTURE == ARM64 || SIMD_ARCHITECTURE == ARM
+  if (cinfo->master->simd_support & JSIMD_NEON) {
+    cinfo->idct->idct_3x3_simd = jsimd_idct_3x3_neon;
+    return JSIMD_NEON;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN void
+jsimd_idct_3x3(j_decompress_ptr cinfo, jpeg_component_info *compptr,
+               JCOEFPTR coef_block, JSAMPARRAY output_buf,
+               JDIMENSION output_col)
+{
+  cinfo->idct->idct_3x3_simd(compptr->dct_table, coef_block, output_buf,
+                             output_col);
+}
+
+
 HIDDEN unsigned int
 jsimd_set_idct_4x4(j_decompress_ptr cinfo)
 {
@@ -1395,6 +1862,13 @@ jsimd_set_idct_4x4(j_decompress_ptr cinfo)
     return JSIMD_NONE;
 
 #if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst_idct_red_avx2)) {
+    cinfo->idct->idct_4x4_simd = jsimd_idct_4x4_avx2;
+    return JSIMD_AVX2;
+  }
+#endif
   if ((cinfo->master->simd_support & JSIMD_SSE2) &&
       IS_ALIGNED_SSE(jconst_idct_red_sse2)) {
     cinfo->idct->idct_4x4_simd = jsimd_idct_4x4_sse2;
@@ -1427,6 +1901,135 @@ jsimd_idct_4x4(j_decompress_ptr cinfo, jpeg_component_info *compptr,
 }
 
 
+HIDDEN unsigned int
+jsimd_set_idct_5x5(j_decompress_ptr cinfo)
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JCOEF) != 2)
+    return JSIMD_NONE;
+  if (BITS_IN_JSAMPLE != 8)
+    return JSIMD_NONE;
+  if (sizeof(JDIMENSION) != 4)
+    return JSIMD_NONE;
+  if (sizeof(ISLOW_MULT_TYPE) != 2)
+    return JSIMD_NONE;
+  if (!cinfo->idct)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+  if ((cinfo->master->simd_support & JSIMD_SSE2) &&
+      IS_ALIGNED_SSE(jconst_idct_red_sse2)) {
+    cinfo->idct->idct_5x5_simd = jsimd_idct_5x5_sse2;
+    return JSIMD_SSE2;
+  }
+#elif SIMD_ARCHITECTURE == ARM64 || SIMD_ARCHITECTURE == ARM
+  if (cinfo->master->simd_support & JSIMD_NEON) {
+    cinfo->idct->idct_5x5_simd = jsimd_idct_5x5_neon;
+    return JSIMD_NEON;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN void
+jsimd_idct_5x5(j_decompress_ptr cinfo, jpeg_component_info *compptr,
+               JCOEFPTR coef_block, JSAMPARRAY output_buf,
+               JDIMENSION output_col)
+{
+  cinfo->idct->idct_5x5_simd(compptr->dct_table, coef_block, output_buf,
+                             output_col);
+}
+
+
+HIDDEN unsigned int
+jsimd_set_idct_6x6(j_decompress_ptr cinfo)
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JCOEF) != 2)
+    return JSIMD_NONE;
+  if (BITS_IN_JSAMPLE != 8)
+    return JSIMD_NONE;
+  if (sizeof(JDIMENSION) != 4)
+    return JSIMD_NONE;
+  if (sizeof(ISLOW_MULT_TYPE) != 2)
+    return JSIMD_NONE;
+  if (!cinfo->idct)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+  if ((cinfo->master->simd_support & JSIMD_SSE2) &&
+      IS_ALIGNED_SSE(jconst_idct_red_sse2)) {
+    cinfo->idct->idct_6x6_simd = jsimd_idct_6x6_sse2;
+    return JSIMD_SSE2;
+  }
+#elif SIMD_ARCHITECTURE == ARM64 || SIMD_ARCHITECTURE == ARM
+  if (cinfo->master->simd_support & JSIMD_NEON) {
+    cinfo->idct->idct_6x6_simd = jsimd_idct_6x6_neon;
+    return JSIMD_NEON;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN void
+jsimd_idct_6x6(j_decompress_ptr cinfo, jpeg_component_info *compptr,
+               JCOEFPTR coef_block, JSAMPARRAY output_buf,
+               JDIMENSION output_col)
+{
+  cinfo->idct->idct_6x6_simd(compptr->dct_table, coef_block, output_buf,
+                             output_col);
+}
+
+
+HIDDEN unsigned int
+jsimd_set_idct_7x7(j_decompress_ptr cinfo)
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JCOEF) != 2)
+    return JSIMD_NONE;
+  if (BITS_IN_JSAMPLE != 8)
+    return JSIMD_NONE;
+  if (sizeof(JDIMENSION) != 4)
+    return JSIMD_NONE;
+  if (sizeof(ISLOW_MULT_TYPE) != 2)
+    return JSIMD_NONE;
+  if (!cinfo->idct)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64 || SIMD_ARCHITECTURE == I386
+  if ((cinfo->master->simd_support & JSIMD_SSE2) &&
+      IS_ALIGNED_SSE(jconst_idct_red_sse2)) {
+    cinfo->idct->idct_7x7_simd = jsimd_idct_7x7_sse2;
+    return JSIMD_SSE2;
+  }
+#elif SIMD_ARCHITECTURE == ARM64 || SIMD_ARCHITECTURE == ARM
+  if (cinfo->master->simd_support & JSIMD_NEON) {
+    cinfo->idct->idct_7x7_simd = jsimd_idct_7x7_neon;
+    return JSIMD_NEON;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN void
+jsimd_idct_7x7(j_decompress_ptr cinfo, jpeg_component_info *compptr,
+               JCOEFPTR coef_block, JSAMPARRAY output_buf,
+               JDIMENSION output_col)
+{
+  cinfo->idct->idct_7x7_simd(compptr->dct_table, coef_block, output_buf,
+                             output_col);
+}
+
+
 HIDDEN unsigned int
 jsimd_set_huff_encode_one_block(j_compress_ptr cinfo)
 {
@@ -1510,3 +2113,98 @@ jsimd_set_encode_mcu_AC_refine_prepare(j_compress_ptr cinfo,
 
   return JSIMD_NONE;
 }
+
+
+HIDDEN unsigned int
+jsimd_set_difference(j_compress_ptr cinfo, int psv,
+  void (**method) (JSAMPROW, JSAMPROW, JDIFFROW, JDIMENSION, int))
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JDIMENSION) != 4 || sizeof(JDIFF) != 4)
+    return JSIMD_NONE;
+  if (psv < 1 || psv > 7)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst_difference_avx2)) {
+    SET_SIMD_DIFFERENCER(jsimd, avx2);
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN unsigned int
+jsimd12_set_difference(j_compress_ptr cinfo, int psv,
+  void (**method) (J12SAMPROW, J12SAMPROW, JDIFFROW, JDIMENSION, int))
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JDIMENSION) != 4 || sizeof(JDIFF) != 4)
+    return JSIMD_NONE;
+  if (psv < 1 || psv > 7)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst_difference_avx2)) {
+    SET_SIMD_DIFFERENCER(jsimd12, avx2);
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN unsigned int
+jsimd16_set_difference(j_compress_ptr cinfo, int psv,
+  void (**method) (J16SAMPROW, J16SAMPROW, JDIFFROW, JDIMENSION, int))
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JDIMENSION) != 4 || sizeof(JDIFF) != 4)
+    return JSIMD_NONE;
+  if (psv < 1 || psv > 7)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst_difference_avx2)) {
+    SET_SIMD_DIFFERENCER(jsimd16, avx2);
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
+
+
+HIDDEN unsigned int
+jsimd_set_undifference(j_decompress_ptr cinfo, int psv,
+  void (**method) (JDIFFROW, JDIFFROW, JDIFFROW, JDIMENSION, int))
+{
+  init_simd((j_common_ptr)cinfo);
+
+  if (sizeof(JDIMENSION) != 4 || sizeof(JDIFF) != 4)
+    return JSIMD_NONE;
+  /* Predictors 6 and 7 cannot be expressed as prefix sums, so there are no
+   * SIMD implementations of them.
+   */
+  if (psv < 1 || psv > 5)
+    return JSIMD_NONE;
+
+#if SIMD_ARCHITECTURE == X86_64
+  if ((cinfo->master->simd_support & JSIMD_AVX2) &&
+      IS_ALIGNED_AVX(jconst_undifference_avx2)) {
+    SET_SIMD_UNDIFFERENCER(avx2);
+    return JSIMD_AVX2;
+  }
+#endif
+
+  return JSIMD_NONE;
+}
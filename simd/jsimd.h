@@ -1,6 +1,6 @@
 /*
  * Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
- * Copyright (C) 2011, 2014, 2022, 2025, D. R. Commander.
+ * Copyright (C) 2011, 2014, 2022, 2025-2026, D. R. Commander.
  * Copyright (C) 2015-2016, 2018, 2022, Matthieu Darbois.
  * Copyright (C) 2020, Arm Limited.
  *
@@ -34,6 +34,13 @@ EXTERN(void) jsimd_color_convert(j_compress_ptr cinfo, JSAMPARRAY input_buf,
                                  JSAMPIMAGE output_buf, JDIMENSION output_row,
                                  int num_rows);
 
+EXTERN(unsigned int) jsimd12_set_rgb_ycc(j_compress_ptr cinfo);
+
+EXTERN(void) jsimd12_color_convert(j_compress_ptr cinfo,
+                                   J12SAMPARRAY input_buf,
+                                   J12SAMPIMAGE output_buf,
+                                   JDIMENSION output_row, int num_rows);
+
 EXTERN(unsigned int) jsimd_set_ycc_rgb(j_decompress_ptr cinfo);
 
 EXTERN(unsigned int) jsimd_set_ycc_rgb565(j_decompress_ptr cinfo);
@@ -42,6 +49,13 @@ EXTERN(void) jsimd_color_deconvert(j_decompress_ptr cinfo,
                                    JSAMPIMAGE input_buf, JDIMENSION input_row,
                                    JSAMPARRAY output_buf, int num_rows);
 
+EXTERN(unsigned int) jsimd12_set_ycc_rgb(j_decompress_ptr cinfo);
+
+EXTERN(void) jsimd12_color_deconvert(j_decompress_ptr cinfo,
+                                     J12SAMPIMAGE input_buf,
+                                     JDIMENSION input_row,
+                                     J12SAMPARRAY output_buf, int num_rows);
+
 
 /* Downsampling */
 EXTERN(unsigned int) jsimd_set_h2v1_downsample(j_compress_ptr cinfo);
@@ -56,6 +70,18 @@ EXTERN(void) jsimd_h2v2_downsample(j_compress_ptr cinfo,
                                    JSAMPARRAY input_data,
                                    JSAMPARRAY output_data);
 
+EXTERN(unsigned int) jsimd12_set_h2v1_downsample(j_compress_ptr cinfo);
+EXTERN(void) jsimd12_h2v1_downsample(j_compress_ptr cinfo,
+                                     jpeg_component_info *compptr,
+                                     J12SAMPARRAY input_data,
+                                     J12SAMPARRAY output_data);
+
+EXTERN(unsigned int) jsimd12_set_h2v2_downsample(j_compress_ptr cinfo);
+EXTERN(void) jsimd12_h2v2_downsample(j_compress_ptr cinfo,
+                                     jpeg_component_info *compptr,
+                                     J12SAMPARRAY input_data,
+                                     J12SAMPARRAY output_data);
+
 
 /* Plain Upsampling */
 EXTERN(unsigned int) jsimd_set_h2v1_upsample(j_decompress_ptr cinfo);
@@ -84,6 +110,18 @@ EXTERN(void) jsimd_h2v2_fancy_upsample(j_decompress_ptr cinfo,
                                        JSAMPARRAY input_data,
                                        JSAMPARRAY *output_data_ptr);
 
+EXTERN(unsigned int) jsimd12_set_h2v1_fancy_upsample(j_decompress_ptr cinfo);
+EXTERN(void) jsimd12_h2v1_fancy_upsample(j_decompress_ptr cinfo,
+                                         jpeg_component_info *compptr,
+                                         J12SAMPARRAY input_data,
+                                         J12SAMPARRAY *output_data_ptr);
+
+EXTERN(unsigned int) jsimd12_set_h2v2_fancy_upsample(j_decompress_ptr cinfo);
+EXTERN(void) jsimd12_h2v2_fancy_upsample(j_decompress_ptr cinfo,
+                                         jpeg_component_info *compptr,
+                                         J12SAMPARRAY input_data,
+                                         J12SAMPARRAY *output_data_ptr);
+
 #if SIMD_ARCHITECTURE == ARM64 || SIMD_ARCHITECTURE == ARM
 EXTERN(unsigned int) jsimd_set_h1v2_fancy_upsample(j_decompress_ptr cinfo);
 EXTERN(void) jsimd_h1v2_fancy_upsample(j_decompress_ptr cinfo,
@@ -119,3 +157,24 @@ EXTERN(unsigned int) jsimd_set_encode_mcu_AC_first_prepare
 EXTERN(unsigned int) jsimd_set_encode_mcu_AC_refine_prepare
   (j_compress_ptr cinfo,
    int (**method) (const JCOEF *, const int *, int, int, UJCOEF *, size_t *));
+
+
+/* Lossless Sample Differencing/Undifferencing */
+EXTERN(unsigned int) jsimd_set_difference
+  (j_compress_ptr cinfo, int psv,
+   void (**method) (JSAMPROW, JSAMPROW, JDIFFROW, JDIMENSION, int));
+
+EXTERN(unsigned int) jsimd12_set_difference
+  (j_compress_ptr cinfo, int psv,
+   void (**method) (J12SAMPROW, J12SAMPROW, JDIFFROW, JDIMENSION, int));
+
+EXTERN(unsigned int) jsimd16_set_difference
+  (j_compress_ptr cinfo, int psv,
+   void (**method) (J16SAMPROW, J16SAMPROW, JDIFFROW, JDIMENSION, int));
+
+/* The undifferencers operate only on difference values, so they are
+ * independent of the data precision.
+ */
+EXTERN(unsigned int) jsimd_set_undifference
+  (j_decompress_ptr cinfo, int psv,
+   void (**method) (JDIFFROW, JDIFFROW, JDIFFROW, JDIMENSION, int));
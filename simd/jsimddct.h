@@ -1,6 +1,6 @@
 /*
  * Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
- * Copyright (C) 2025, D. R. Commander.
+ * Copyright (C) 2025-2026, D. R. Commander.
  *
  * This software is provided 'as-is', without any express or implied
  * warranty.  In no event will the authors be held liable for any damages
@@ -30,6 +30,13 @@ EXTERN(unsigned int) jsimd_set_convsamp(j_compress_ptr cinfo,
 EXTERN(unsigned int) jsimd_set_convsamp_float
   (j_compress_ptr cinfo, float_convsamp_method_ptr *method);
 
+/* The 12-bit sample conversion, forward DCT, and quantization routines use
+ * 32-bit DCTELEMs, irrespective of the data precision of the caller.
+ */
+EXTERN(unsigned int) jsimd12_set_convsamp
+  (j_compress_ptr cinfo,
+   void (**method) (J12SAMPARRAY, JDIMENSION, int *));
+
 
 /* Forward DCT */
 EXTERN(unsigned int) jsimd_set_fdct_islow(j_compress_ptr cinfo,
@@ -41,6 +48,9 @@ EXTERN(unsigned int) jsimd_set_fdct_ifast(j_compress_ptr cinfo,
 EXTERN(unsigned int) jsimd_set_fdct_float(j_compress_ptr cinfo,
                                           float_DCT_method_ptr *method);
 
+EXTERN(unsigned int) jsimd12_set_fdct_islow(j_compress_ptr cinfo,
+                                            void (**method) (int *));
+
 
 /* Quantization */
 EXTERN(unsigned int) jsimd_set_quantize(j_compress_ptr cinfo,
@@ -49,6 +59,9 @@ EXTERN(unsigned int) jsimd_set_quantize(j_compress_ptr cinfo,
 EXTERN(unsigned int) jsimd_set_quantize_float
   (j_compress_ptr cinfo, float_quantize_method_ptr *method);
 
+EXTERN(unsigned int) jsimd12_set_quantize
+  (j_compress_ptr cinfo, void (**method) (JCOEFPTR, int *, int *));
+
 
 /* Inverse DCT */
 EXTERN(unsigned int) jsimd_set_idct_islow(j_decompress_ptr cinfo);
@@ -69,6 +82,12 @@ EXTERN(void) jsimd_idct_float(j_decompress_ptr cinfo,
                               JCOEFPTR coef_block, JSAMPARRAY output_buf,
                               JDIMENSION output_col);
 
+EXTERN(unsigned int) jsimd12_set_idct_islow(j_decompress_ptr cinfo);
+EXTERN(void) jsimd12_idct_islow(j_decompress_ptr cinfo,
+                                jpeg_component_info *compptr,
+                                JCOEFPTR coef_block, J12SAMPARRAY output_buf,
+                                JDIMENSION output_col);
+
 
 /* Scaled Integer Inverse DCT */
 EXTERN(unsigned int) jsimd_set_idct_2x2(j_decompress_ptr cinfo);
@@ -76,7 +95,27 @@ EXTERN(void) jsimd_idct_2x2(j_decompress_ptr cinfo,
                             jpeg_component_info *compptr, JCOEFPTR coef_block,
                             JSAMPARRAY output_buf, JDIMENSION output_col);
 
+EXTERN(unsigned int) jsimd_set_idct_3x3(j_decompress_ptr cinfo);
+EXTERN(void) jsimd_idct_3x3(j_decompress_ptr cinfo,
+                            jpeg_component_info *compptr, JCOEFPTR coef_block,
+                            JSAMPARRAY output_buf, JDIMENSION output_col);
+
 EXTERN(unsigned int) jsimd_set_idct_4x4(j_decompress_ptr cinfo);
 EXTERN(void) jsimd_idct_4x4(j_decompress_ptr cinfo,
                             jpeg_component_info *compptr, JCOEFPTR coef_block,
                             JSAMPARRAY output_buf, JDIMENSION output_col);
+
+EXTERN(unsigned int) jsimd_set_idct_5x5(j_decompress_ptr cinfo);
+EXTERN(void) jsimd_idct_5x5(j_decompress_ptr cinfo,
+                            jpeg_component_info *compptr, JCOEFPTR coef_block,
+                            JSAMPARRAY output_buf, JDIMENSION output_col);
+
+EXTERN(unsigned int) jsimd_set_idct_6x6(j_decompress_ptr cinfo);
+EXTERN(void) jsimd_idct_6x6(j_decompress_ptr cinfo,
+                            jpeg_component_info *compptr, JCOEFPTR coef_block,
+                            JSAMPARRAY output_buf, JDIMENSION output_col);
+
+EXTERN(unsigned int) jsimd_set_idct_7x7(j_decompress_ptr cinfo);
+EXTERN(void) jsimd_idct_7x7(j_decompress_ptr cinfo,
+                            jpeg_component_info *compptr, JCOEFPTR coef_block,
+                            JSAMPARRAY output_buf, JDIMENSION output_col);
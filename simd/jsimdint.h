@@ -1,6 +1,7 @@
 /*
  * Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
- * Copyright (C) 2011, 2014-2016, 2018, 2020, 2022, 2025, D. R. Commander.
+ * Copyright (C) 2011, 2014-2016, 2018, 2020, 2022, 2025-2026,
+ *           D. R. Commander.
  * Copyright (C) 2014, Linaro Limited.
  * Copyright (C) 2015-2016, 2018, 2022, Matthieu Darbois.
  * Copyright (C) 2016-2018, Loongson Technology Corporation Limited, BeiJing.
@@ -97,6 +98,9 @@ EXTERN(void) jsimd_extxrgb_##cs##_convert_##instrset \
   (JDIMENSION img_width, JSAMPARRAY input_buf, JSAMPIMAGE output_buf, \
    JDIMENSION output_row, int num_rows);
 
+extern const int jconst_rgb_ycc_convert_avx512[];
+DEFINE_SIMD_EXTRGB_COLOR_CONVERTERS(ycc, avx512)
+
 extern const int jconst_rgb_ycc_convert_avx2[];
 DEFINE_SIMD_EXTRGB_COLOR_CONVERTERS(ycc, avx2)
 extern const int jconst_rgb_gray_convert_avx2[];
@@ -122,6 +126,68 @@ DEFINE_SIMD_EXTRGB_COLOR_CONVERTERS(gray, rvv)
 DEFINE_SIMD_EXTRGB_COLOR_CONVERTERS(ycc, mmi)
 DEFINE_SIMD_EXTRGB_COLOR_CONVERTERS(gray, mmi)
 
+#define SET_SIMD12_EXTRGB_COLOR_CONVERTER(instrset) { \
+  switch (cinfo->in_color_space) { \
+    case JCS_EXT_RGB: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_extrgb_ycc_convert_##instrset; \
+      break; \
+    case JCS_EXT_RGBX: \
+    case JCS_EXT_RGBA: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_extrgbx_ycc_convert_##instrset; \
+      break; \
+    case JCS_EXT_BGR: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_extbgr_ycc_convert_##instrset; \
+      break; \
+    case JCS_EXT_BGRX: \
+    case JCS_EXT_BGRA: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_extbgrx_ycc_convert_##instrset; \
+      break; \
+    case JCS_EXT_XBGR: \
+    case JCS_EXT_ABGR: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_extxbgr_ycc_convert_##instrset; \
+      break; \
+    case JCS_EXT_XRGB: \
+    case JCS_EXT_ARGB: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_extxrgb_ycc_convert_##instrset; \
+      break; \
+    default: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_rgb_ycc_convert_##instrset; \
+  } \
+}
+
+#define DEFINE_SIMD12_EXTRGB_COLOR_CONVERTERS(instrset) \
+EXTERN(void) jsimd12_rgb_ycc_convert_##instrset \
+  (JDIMENSION img_width, J12SAMPARRAY input_buf, J12SAMPIMAGE output_buf, \
+   JDIMENSION output_row, int num_rows); \
+EXTERN(void) jsimd12_extrgb_ycc_convert_##instrset \
+  (JDIMENSION img_width, J12SAMPARRAY input_buf, J12SAMPIMAGE output_buf, \
+   JDIMENSION output_row, int num_rows); \
+EXTERN(void) jsimd12_extrgbx_ycc_convert_##instrset \
+  (JDIMENSION img_width, J12SAMPARRAY input_buf, J12SAMPIMAGE output_buf, \
+   JDIMENSION output_row, int num_rows); \
+EXTERN(void) jsimd12_extbgr_ycc_convert_##instrset \
+  (JDIMENSION img_width, J12SAMPARRAY input_buf, J12SAMPIMAGE output_buf, \
+   JDIMENSION output_row, int num_rows); \
+EXTERN(void) jsimd12_extbgrx_ycc_convert_##instrset \
+  (JDIMENSION img_width, J12SAMPARRAY input_buf, J12SAMPIMAGE output_buf, \
+   JDIMENSION output_row, int num_rows); \
+EXTERN(void) jsimd12_extxbgr_ycc_convert_##instrset \
+  (JDIMENSION img_width, J12SAMPARRAY input_buf, J12SAMPIMAGE output_buf, \
+   JDIMENSION output_row, int num_rows); \
+EXTERN(void) jsimd12_extxrgb_ycc_convert_##instrset \
+  (JDIMENSION img_width, J12SAMPARRAY input_buf, J12SAMPIMAGE output_buf, \
+   JDIMENSION output_row, int num_rows);
+
+extern const int jconst12_rgb_ycc_convert_avx2[];
+DEFINE_SIMD12_EXTRGB_COLOR_CONVERTERS(avx2)
+
 
 /* YCbCr-to-RGB Color Conversion */
 
@@ -184,6 +250,9 @@ EXTERN(void) jsimd_ycc_extxrgb_convert_##instrset \
   (JDIMENSION out_width, JSAMPIMAGE input_buf, JDIMENSION input_row, \
    JSAMPARRAY output_buf, int num_rows);
 
+extern const int jconst_ycc_rgb_convert_avx512[];
+DEFINE_SIMD_EXTRGB_COLOR_DECONVERTERS(avx512)
+
 extern const int jconst_ycc_rgb_convert_avx2[];
 DEFINE_SIMD_EXTRGB_COLOR_DECONVERTERS(avx2)
 
@@ -200,6 +269,68 @@ DEFINE_SIMD_EXTRGB_COLOR_DECONVERTERS(rvv)
 
 DEFINE_SIMD_EXTRGB_COLOR_DECONVERTERS(mmi)
 
+#define SET_SIMD12_EXTRGB_COLOR_DECONVERTER(instrset) { \
+  switch (cinfo->out_color_space) { \
+    case JCS_EXT_RGB: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_ycc_extrgb_convert_##instrset; \
+      break; \
+    case JCS_EXT_RGBX: \
+    case JCS_EXT_RGBA: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_ycc_extrgbx_convert_##instrset; \
+      break; \
+    case JCS_EXT_BGR: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_ycc_extbgr_convert_##instrset; \
+      break; \
+    case JCS_EXT_BGRX: \
+    case JCS_EXT_BGRA: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_ycc_extbgrx_convert_##instrset; \
+      break; \
+    case JCS_EXT_XBGR: \
+    case JCS_EXT_ABGR: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_ycc_extxbgr_convert_##instrset; \
+      break; \
+    case JCS_EXT_XRGB: \
+    case JCS_EXT_ARGB: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_ycc_extxrgb_convert_##instrset; \
+      break; \
+    default: \
+      cinfo->cconvert->color_convert_simd_12 = \
+        jsimd12_ycc_rgb_convert_##instrset; \
+  } \
+}
+
+#define DEFINE_SIMD12_EXTRGB_COLOR_DECONVERTERS(instrset) \
+EXTERN(void) jsimd12_ycc_rgb_convert_##instrset \
+  (JDIMENSION out_width, J12SAMPIMAGE input_buf, JDIMENSION input_row, \
+   J12SAMPARRAY output_buf, int num_rows); \
+EXTERN(void) jsimd12_ycc_extrgb_convert_##instrset \
+  (JDIMENSION out_width, J12SAMPIMAGE input_buf, JDIMENSION input_row, \
+   J12SAMPARRAY output_buf, int num_rows); \
+EXTERN(void) jsimd12_ycc_extrgbx_convert_##instrset \
+  (JDIMENSION out_width, J12SAMPIMAGE input_buf, JDIMENSION input_row, \
+   J12SAMPARRAY output_buf, int num_rows); \
+EXTERN(void) jsimd12_ycc_extbgr_convert_##instrset \
+  (JDIMENSION out_width, J12SAMPIMAGE input_buf, JDIMENSION input_row, \
+   J12SAMPARRAY output_buf, int num_rows); \
+EXTERN(void) jsimd12_ycc_extbgrx_convert_##instrset \
+  (JDIMENSION out_width, J12SAMPIMAGE input_buf, JDIMENSION input_row, \
+   J12SAMPARRAY output_buf, int num_rows); \
+EXTERN(void) jsimd12_ycc_extxbgr_convert_##instrset \
+  (JDIMENSION out_width, J12SAMPIMAGE input_buf, JDIMENSION input_row, \
+   J12SAMPARRAY output_buf, int num_rows); \
+EXTERN(void) jsimd12_ycc_extxrgb_convert_##instrset \
+  (JDIMENSION out_width, J12SAMPIMAGE input_buf, JDIMENSION input_row, \
+   J12SAMPARRAY output_buf, int num_rows);
+
+extern const int jconst12_ycc_rgb_convert_avx2[];
+DEFINE_SIMD12_EXTRGB_COLOR_DECONVERTERS(avx2)
+
 
 /* YCbCr-to-RGB565 Color Conversion */
 
@@ -256,6 +387,15 @@ EXTERN(void) jsimd_h2v2_downsample_mmi
   (JDIMENSION image_width, int max_v_samp_factor, JDIMENSION v_samp_factor,
    JDIMENSION width_in_blocks, JSAMPARRAY input_data, JSAMPARRAY output_data);
 
+EXTERN(void) jsimd12_h2v1_downsample_avx2
+  (JDIMENSION image_width, int max_v_samp_factor, JDIMENSION v_samp_factor,
+   JDIMENSION width_in_blocks, J12SAMPARRAY input_data,
+   J12SAMPARRAY output_data);
+EXTERN(void) jsimd12_h2v2_downsample_avx2
+  (JDIMENSION image_width, int max_v_samp_factor, JDIMENSION v_samp_factor,
+   JDIMENSION width_in_blocks, J12SAMPARRAY input_data,
+   J12SAMPARRAY output_data);
+
 
 /* Plain Upsampling */
 
@@ -304,6 +444,14 @@ EXTERN(void) jsimd_h2v2_upsample_rvv
 
 /* Fancy (Smooth) Upsampling */
 
+extern const int jconst_fancy_upsample_avx512[];
+EXTERN(void) jsimd_h2v1_fancy_upsample_avx512
+  (int max_v_samp_factor, JDIMENSION downsampled_width, JSAMPARRAY input_data,
+   JSAMPARRAY *output_data_ptr);
+EXTERN(void) jsimd_h2v2_fancy_upsample_avx512
+  (int max_v_samp_factor, JDIMENSION downsampled_width, JSAMPARRAY input_data,
+   JSAMPARRAY *output_data_ptr);
+
 extern const int jconst_fancy_upsample_avx2[];
 EXTERN(void) jsimd_h2v1_fancy_upsample_avx2
   (int max_v_samp_factor, JDIMENSION downsampled_width, JSAMPARRAY input_data,
@@ -358,6 +506,14 @@ EXTERN(void) jsimd_h2v2_fancy_upsample_mmi
   (int max_v_samp_factor, JDIMENSION downsampled_width, JSAMPARRAY input_data,
    JSAMPARRAY *output_data_ptr);
 
+extern const int jconst12_fancy_upsample_avx2[];
+EXTERN(void) jsimd12_h2v1_fancy_upsample_avx2
+  (int max_v_samp_factor, JDIMENSION downsampled_width,
+   J12SAMPARRAY input_data, J12SAMPARRAY *output_data_ptr);
+EXTERN(void) jsimd12_h2v2_fancy_upsample_avx2
+  (int max_v_samp_factor, JDIMENSION downsampled_width,
+   J12SAMPARRAY input_data, J12SAMPARRAY *output_data_ptr);
+
 
 /* Merged Upsampling/Color Conversion */
 
@@ -420,6 +576,10 @@ EXTERN(void) jsimd_##samp##_extxrgb_merged_upsample_##instrset \
   (JDIMENSION output_width, JSAMPIMAGE input_buf, \
    JDIMENSION in_row_group_ctr, JSAMPARRAY output_buf);
 
+extern const int jconst_merged_upsample_avx512[];
+DEFINE_SIMD_EXTRGB_MERGED_UPSAMPLERS(h2v1, avx512)
+DEFINE_SIMD_EXTRGB_MERGED_UPSAMPLERS(h2v2, avx512)
+
 extern const int jconst_merged_upsample_avx2[];
 DEFINE_SIMD_EXTRGB_MERGED_UPSAMPLERS(h2v1, avx2)
 DEFINE_SIMD_EXTRGB_MERGED_UPSAMPLERS(h2v2, avx2)
@@ -446,6 +606,9 @@ DEFINE_SIMD_EXTRGB_MERGED_UPSAMPLERS(h2v2, mmi)
 
 /* Integer Sample Conversion */
 
+EXTERN(void) jsimd_convsamp_avx512
+  (JSAMPARRAY sample_data, JDIMENSION start_col, DCTELEM *workspace);
+
 EXTERN(void) jsimd_convsamp_avx2
   (JSAMPARRAY sample_data, JDIMENSION start_col, DCTELEM *workspace);
 
@@ -464,9 +627,15 @@ EXTERN(void) jsimd_convsamp_altivec
 EXTERN(void) jsimd_convsamp_rvv
   (JSAMPARRAY sample_data, JDIMENSION start_col, DCTELEM *workspace);
 
+EXTERN(void) jsimd12_convsamp_avx2
+  (J12SAMPARRAY sample_data, JDIMENSION start_col, int *workspace);
+
 
 /* Floating Point Sample Conversion */
 
+EXTERN(void) jsimd_convsamp_float_avx2
+  (JSAMPARRAY sample_data, JDIMENSION start_col, FAST_FLOAT *workspace);
+
 EXTERN(void) jsimd_convsamp_float_sse2
   (JSAMPARRAY sample_data, JDIMENSION start_col, FAST_FLOAT *workspace);
 
@@ -479,8 +648,13 @@ EXTERN(void) jsimd_convsamp_float_3dnow
 
 /* Integer Forward DCT */
 
+extern const int jconst_fdct_islow_avx512[];
+EXTERN(void) jsimd_fdct_islow_avx512(DCTELEM *data);
+
 extern const int jconst_fdct_islow_avx2[];
 EXTERN(void) jsimd_fdct_islow_avx2(DCTELEM *data);
+extern const int jconst_fdct_ifast_avx2[];
+EXTERN(void) jsimd_fdct_ifast_avx2(DCTELEM *data);
 
 extern const int jconst_fdct_islow_sse2[];
 EXTERN(void) jsimd_fdct_islow_sse2(DCTELEM *data);
@@ -502,9 +676,15 @@ EXTERN(void) jsimd_fdct_ifast_rvv(DCTELEM *data);
 EXTERN(void) jsimd_fdct_islow_mmi(DCTELEM *data);
 EXTERN(void) jsimd_fdct_ifast_mmi(DCTELEM *data);
 
+extern const int jconst12_fdct_islow_avx2[];
+EXTERN(void) jsimd12_fdct_islow_avx2(int *data);
+
 
 /* Floating Point Forward DCT */
 
+extern const int jconst_fdct_float_avx2[];
+EXTERN(void) jsimd_fdct_float_avx2(FAST_FLOAT *data);
+
 extern const int jconst_fdct_float_sse[];
 EXTERN(void) jsimd_fdct_float_sse(FAST_FLOAT *data);
 
@@ -513,6 +693,9 @@ EXTERN(void) jsimd_fdct_float_3dnow(FAST_FLOAT *data);
 
 /* Integer Quantization */
 
+EXTERN(void) jsimd_quantize_avx512
+  (JCOEFPTR coef_block, DCTELEM *divisors, DCTELEM *workspace);
+
 EXTERN(void) jsimd_quantize_avx2
   (JCOEFPTR coef_block, DCTELEM *divisors, DCTELEM *workspace);
 
@@ -534,9 +717,15 @@ EXTERN(void) jsimd_quantize_rvv
 EXTERN(void) jsimd_quantize_mmi
   (JCOEFPTR coef_block, DCTELEM *divisors, DCTELEM *workspace);
 
+EXTERN(void) jsimd12_quantize_avx2
+  (JCOEFPTR coef_block, int *divisors, int *workspace);
+
 
 /* Floating Point Quantization */
 
+EXTERN(void) jsimd_quantize_float_avx2
+  (JCOEFPTR coef_block, FAST_FLOAT *divisors, FAST_FLOAT *workspace);
+
 EXTERN(void) jsimd_quantize_float_sse2
   (JCOEFPTR coef_block, FAST_FLOAT *divisors, FAST_FLOAT *workspace);
 
@@ -549,10 +738,23 @@ EXTERN(void) jsimd_quantize_float_3dnow
 
 /* Inverse DCT */
 
+extern const int jconst_idct_islow_avx512[];
+EXTERN(void) jsimd_idct_islow_avx512
+  (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
+   JDIMENSION output_col);
+
 extern const int jconst_idct_islow_avx2[];
 EXTERN(void) jsimd_idct_islow_avx2
   (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
    JDIMENSION output_col);
+extern const int jconst_idct_ifast_avx2[];
+EXTERN(void) jsimd_idct_ifast_avx2
+  (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
+   JDIMENSION output_col);
+extern const int jconst_idct_float_avx2[];
+EXTERN(void) jsimd_idct_float_avx2
+  (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
+   JDIMENSION output_col);
 
 extern const int jconst_idct_islow_sse2[];
 EXTERN(void) jsimd_idct_islow_sse2
@@ -611,16 +813,38 @@ EXTERN(void) jsimd_idct_ifast_mmi
   (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
    JDIMENSION output_col);
 
+extern const int jconst12_idct_islow_avx2[];
+EXTERN(void) jsimd12_idct_islow_avx2
+  (void *dct_table, JCOEFPTR coef_block, J12SAMPARRAY output_buf,
+   JDIMENSION output_col);
+
 
 /* Scaled Integer Inverse DCT */
 
+extern const int jconst_idct_red_avx2[];
+EXTERN(void) jsimd_idct_4x4_avx2
+  (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
+   JDIMENSION output_col);
+
 extern const int jconst_idct_red_sse2[];
 EXTERN(void) jsimd_idct_2x2_sse2
   (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
    JDIMENSION output_col);
+EXTERN(void) jsimd_idct_3x3_sse2
+  (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
+   JDIMENSION output_col);
 EXTERN(void) jsimd_idct_4x4_sse2
   (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
    JDIMENSION output_col);
+EXTERN(void) jsimd_idct_5x5_sse2
+  (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
+   JDIMENSION output_col);
+EXTERN(void) jsimd_idct_6x6_sse2
+  (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
+   JDIMENSION output_col);
+EXTERN(void) jsimd_idct_7x7_sse2
+  (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
+   JDIMENSION output_col);
 
 EXTERN(void) jsimd_idct_2x2_mmx
   (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
@@ -632,9 +856,21 @@ EXTERN(void) jsimd_idct_4x4_mmx
 EXTERN(void) jsimd_idct_2x2_neon
   (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
    JDIMENSION output_col);
+EXTERN(void) jsimd_idct_3x3_neon
+  (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
+   JDIMENSION output_col);
 EXTERN(void) jsimd_idct_4x4_neon
   (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
    JDIMENSION output_col);
+EXTERN(void) jsimd_idct_5x5_neon
+  (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
+   JDIMENSION output_col);
+EXTERN(void) jsimd_idct_6x6_neon
+  (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
+   JDIMENSION output_col);
+EXTERN(void) jsimd_idct_7x7_neon
+  (void *dct_table, JCOEFPTR coef_block, JSAMPARRAY output_buf,
+   JDIMENSION output_col);
 
 
 /* Huffman Encoding */
@@ -664,3 +900,111 @@ EXTERN(void) jsimd_encode_mcu_AC_first_prepare_neon
 EXTERN(int) jsimd_encode_mcu_AC_refine_prepare_neon
   (const JCOEF *block, const int *jpeg_natural_order_start, int Sl, int Al,
    UJCOEF *absvalues, size_t *bits);
+
+/* Lossless Sample Differencing/Undifferencing */
+
+#define SET_SIMD_DIFFERENCER(prefix, instrset) { \
+  switch (psv) { \
+    case 1:  *method = prefix##_difference1_##instrset;  break; \
+    case 2:  *method = prefix##_difference2_##instrset;  break; \
+    case 3:  *method = prefix##_difference3_##instrset;  break; \
+    case 4:  *method = prefix##_difference4_##instrset;  break; \
+    case 5:  *method = prefix##_difference5_##instrset;  break; \
+    case 6:  *method = prefix##_difference6_##instrset;  break; \
+    default:  *method = prefix##_difference7_##instrset; \
+  } \
+}
+
+#define SET_SIMD_UNDIFFERENCER(instrset) { \
+  switch (psv) { \
+    case 1:  *method = jsimd_undifference1_##instrset;  break; \
+    case 2:  *method = jsimd_undifference2_##instrset;  break; \
+    case 3:  *method = jsimd_undifference3_##instrset;  break; \
+    case 4:  *method = jsimd_undifference4_##instrset;  break; \
+    default:  *method = jsimd_undifference5_##instrset; \
+  } \
+}
+
+extern const int jconst_difference_avx2[];
+EXTERN(void) jsimd_difference1_avx2
+  (JSAMPROW input_buf, JSAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd_difference2_avx2
+  (JSAMPROW input_buf, JSAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd_difference3_avx2
+  (JSAMPROW input_buf, JSAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd_difference4_avx2
+  (JSAMPROW input_buf, JSAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd_difference5_avx2
+  (JSAMPROW input_buf, JSAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd_difference6_avx2
+  (JSAMPROW input_buf, JSAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd_difference7_avx2
+  (JSAMPROW input_buf, JSAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+
+EXTERN(void) jsimd12_difference1_avx2
+  (J12SAMPROW input_buf, J12SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd12_difference2_avx2
+  (J12SAMPROW input_buf, J12SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd12_difference3_avx2
+  (J12SAMPROW input_buf, J12SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd12_difference4_avx2
+  (J12SAMPROW input_buf, J12SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd12_difference5_avx2
+  (J12SAMPROW input_buf, J12SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd12_difference6_avx2
+  (J12SAMPROW input_buf, J12SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd12_difference7_avx2
+  (J12SAMPROW input_buf, J12SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+
+EXTERN(void) jsimd16_difference1_avx2
+  (J16SAMPROW input_buf, J16SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd16_difference2_avx2
+  (J16SAMPROW input_buf, J16SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd16_difference3_avx2
+  (J16SAMPROW input_buf, J16SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd16_difference4_avx2
+  (J16SAMPROW input_buf, J16SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd16_difference5_avx2
+  (J16SAMPROW input_buf, J16SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd16_difference6_avx2
+  (J16SAMPROW input_buf, J16SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd16_difference7_avx2
+  (J16SAMPROW input_buf, J16SAMPROW prev_row, JDIFFROW diff_buf,
+   JDIMENSION width, int initial_predictor);
+
+extern const int jconst_undifference_avx2[];
+EXTERN(void) jsimd_undifference1_avx2
+  (JDIFFROW diff_buf, JDIFFROW prev_row, JDIFFROW undiff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd_undifference2_avx2
+  (JDIFFROW diff_buf, JDIFFROW prev_row, JDIFFROW undiff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd_undifference3_avx2
+  (JDIFFROW diff_buf, JDIFFROW prev_row, JDIFFROW undiff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd_undifference4_avx2
+  (JDIFFROW diff_buf, JDIFFROW prev_row, JDIFFROW undiff_buf,
+   JDIMENSION width, int initial_predictor);
+EXTERN(void) jsimd_undifference5_avx2
+  (JDIFFROW diff_buf, JDIFFROW prev_row, JDIFFROW undiff_buf,
+   JDIMENSION width, int initial_predictor);
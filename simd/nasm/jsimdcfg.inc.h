@@ -72,6 +72,16 @@
 
 %define _cpp_protection_CENTERJSAMPLE  CENTERJSAMPLE
 
+; Representation of a single 12-bit sample.
+; In this SIMD implementation, this must be 'short'.
+;
+
+%define J12SAMPLE          word            ; short
+%define SIZEOF_J12SAMPLE   SIZEOF_WORD     ; sizeof(J12SAMPLE)
+
+%define _cpp_protection_MAXJ12SAMPLE     MAXJ12SAMPLE
+%define _cpp_protection_CENTERJ12SAMPLE  CENTERJ12SAMPLE
+
 ; Representation of a DCT frequency coefficient.
 ; In this SIMD implementation, this must be 'short'.
 ;
@@ -95,6 +105,13 @@
 %define SIZEOF_JSAMPIMAGE  SIZEOF_POINTER  ; sizeof(JSAMPIMAGE)
 %define SIZEOF_JCOEFPTR    SIZEOF_POINTER  ; sizeof(JCOEFPTR)
 
+%define J12SAMPROW           POINTER         ; J12SAMPLE *     (jpeglib.h)
+%define J12SAMPARRAY         POINTER         ; J12SAMPROW *    (jpeglib.h)
+%define J12SAMPIMAGE         POINTER         ; J12SAMPARRAY *  (jpeglib.h)
+%define SIZEOF_J12SAMPROW    SIZEOF_POINTER  ; sizeof(J12SAMPROW)
+%define SIZEOF_J12SAMPARRAY  SIZEOF_POINTER  ; sizeof(J12SAMPARRAY)
+%define SIZEOF_J12SAMPIMAGE  SIZEOF_POINTER  ; sizeof(J12SAMPIMAGE)
+
 ;
 ; -- jdct.h
 ;
@@ -122,6 +139,15 @@
 %define FLOAT_MULT_TYPE         FP32         ; must be float
 %define SIZEOF_FLOAT_MULT_TYPE  SIZEOF_FP32  ; sizeof(FLOAT_MULT_TYPE)
 
+; 12-bit data requires 32-bit intermediate values, so the 12-bit
+; implementations use 'int' for both DCTELEM and ISLOW_MULT_TYPE.
+
+%define J12DCTELEM                dword         ; int
+%define SIZEOF_J12DCTELEM         SIZEOF_DWORD  ; sizeof(DCTELEM)
+
+%define J12ISLOW_MULT_TYPE         dword         ; int
+%define SIZEOF_J12ISLOW_MULT_TYPE  SIZEOF_DWORD  ; sizeof(ISLOW_MULT_TYPE)
+
 ;
 ; -- jsimd.h
 ;
@@ -132,3 +158,4 @@
 %define _cpp_protection_JSIMD_SSE    JSIMD_SSE
 %define _cpp_protection_JSIMD_SSE2   JSIMD_SSE2
 %define _cpp_protection_JSIMD_AVX2   JSIMD_AVX2
+%define _cpp_protection_JSIMD_AVX512 JSIMD_AVX512
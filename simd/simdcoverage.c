@@ -45,6 +45,8 @@ static const char *instrset_name(int instrset) {
       return "AVX2";
     case JSIMD_MMI:
       return "MMI";
+    case JSIMD_AVX512:
+      return "AVX-512";
     default:
       return "Unknown";
   }
@@ -138,7 +140,11 @@ int main(void)
   D_COVERAGE_TEST(jsimd_set_idct_ifast);
   D_COVERAGE_TEST(jsimd_set_idct_float);
   D_COVERAGE_TEST(jsimd_set_idct_2x2);
+  D_COVERAGE_TEST(jsimd_set_idct_3x3);
   D_COVERAGE_TEST(jsimd_set_idct_4x4);
+  D_COVERAGE_TEST(jsimd_set_idct_5x5);
+  D_COVERAGE_TEST(jsimd_set_idct_6x6);
+  D_COVERAGE_TEST(jsimd_set_idct_7x7);
   C_COVERAGE_TEST(jsimd_set_huff_encode_one_block);
   C_COVERAGE_TEST2(jsimd_set_encode_mcu_AC_first_prepare,
                    encode_mcu_AC_first_method);
@@ -0,0 +1,234 @@
+;
+; RGB-to-YCbCr Color Conversion (64-bit AVX-512)
+;
+; Copyright (C) 2009, 2016, 2024-2026, D. R. Commander.
+; Copyright (C) 2015, Intel Corporation.
+; Copyright (C) 2018, Matthias Räncker.
+; Copyright (C) 2023, Aliaksiej Kandracienka.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler).  Yasm does not
+; support AVX-512 instructions.
+
+%include "jcolsamp.inc"
+
+; --------------------------------------------------------------------------
+;
+; Convert some rows of samples to the JPEG colorspace.
+;
+; Each iteration of the column loop converts 64 pixels.  The final (partial)
+; group of pixels in each row is read and written using masked loads and
+; stores, so no bytes beyond the end of the input row are accessed.
+;
+; GLOBAL(void)
+; jsimd_rgb_ycc_convert_avx512(JDIMENSION img_width, JSAMPARRAY input_buf,
+;                              JSAMPIMAGE output_buf, JDIMENSION output_row,
+;                              int num_rows)
+;
+; r10d = JDIMENSION img_width
+; r11 = JSAMPARRAY input_buf
+; r12 = JSAMPIMAGE output_buf
+; r13d = JDIMENSION output_row
+; r14d = int num_rows
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_rgb_ycc_convert_avx512)
+
+EXTN(jsimd_rgb_ycc_convert_avx512):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 5
+    push        rbx
+
+    mov         ecx, r10d
+    test        rcx, rcx
+    jz          near .return
+
+    push        rcx
+
+    mov         rsi, r12
+    mov         ecx, r13d
+    mov         rdip, JSAMPARRAY [rsi + 0 * SIZEOF_JSAMPARRAY]
+    mov         rbxp, JSAMPARRAY [rsi + 1 * SIZEOF_JSAMPARRAY]
+    mov         rdxp, JSAMPARRAY [rsi + 2 * SIZEOF_JSAMPARRAY]
+    lea         rdi, [rdi + rcx * SIZEOF_JSAMPROW]
+    lea         rbx, [rbx + rcx * SIZEOF_JSAMPROW]
+    lea         rdx, [rdx + rcx * SIZEOF_JSAMPROW]
+
+    pop         rcx
+
+    mov         rsi, r11
+    mov         eax, r14d
+    test        rax, rax
+    jle         near .return
+
+    ; NOTE: The values of RGB_RED, RGB_GREEN, and RGB_BLUE determine the
+    ; offsets of red, green, and blue within each pixel, so they are added to
+    ; the vpshufb controls that extract the components.
+
+%if RGB_PIXELSIZE == 3
+    vbroadcasti32x4 zmm18, [rel PD_SHUF_RGB]
+%else
+    vbroadcasti32x4 zmm18, [rel PD_SHUF_RGBX]
+%endif
+    mov         r8d, (RGB_GREEN << WORD_BIT) | RGB_RED
+    vpbroadcastd zmm16, r8d
+    vpaddb      zmm16, zmm16, zmm18     ; zmm16 = RG shuffle control
+    mov         r8d, (RGB_GREEN << WORD_BIT) | RGB_BLUE
+    vpbroadcastd zmm17, r8d
+    vpaddb      zmm17, zmm17, zmm18     ; zmm17 = BG shuffle control
+
+    vpmovzxbd   zmm18, [rel PB_TRANSPOSE]
+%if RGB_PIXELSIZE == 3
+    vpmovzxbd   zmm19, [rel PB_EXPAND_RGB + 0 * SIZEOF_XMMWORD]
+    vpmovzxbd   zmm20, [rel PB_EXPAND_RGB + 1 * SIZEOF_XMMWORD]
+    vpmovzxbd   zmm21, [rel PB_EXPAND_RGB + 2 * SIZEOF_XMMWORD]
+    vpmovzxbd   zmm22, [rel PB_EXPAND_RGB + 3 * SIZEOF_XMMWORD]
+%endif
+
+.rowloop:
+    push        rdx
+    push        rbx
+    push        rdi
+    push        rsi
+    push        rcx                     ; col
+
+    mov         rsip, JSAMPROW [rsi]    ; inptr
+    mov         rdip, JSAMPROW [rdi]    ; outptr0
+    mov         rbxp, JSAMPROW [rbx]    ; outptr1
+    mov         rdxp, JSAMPROW [rdx]    ; outptr2
+
+    cmp         rcx, byte SIZEOF_ZMMWORD
+    jae         near .columnloop
+
+.column_ld:
+    ; Generate the load masks k1-k3 (k1-k4 if RGB_PIXELSIZE == 4) and the
+    ; store mask k5 for the remaining pixels.
+    imul        r8d, ecx, RGB_PIXELSIZE
+    vpbroadcastb zmm29, r8d
+    mov         r9d, SIZEOF_ZMMWORD
+    vpbroadcastb zmm30, r9d
+    vmovdqa64   zmm31, ZMMWORD [rel PB_INDEX]
+    vpcmpub     k1, zmm29, zmm31, 6     ; k1 = (zmm29 > index)
+    vpsubusb    zmm29, zmm29, zmm30
+    vpcmpub     k2, zmm29, zmm31, 6
+    vpsubusb    zmm29, zmm29, zmm30
+    vpcmpub     k3, zmm29, zmm31, 6
+%if RGB_PIXELSIZE == 4
+    vpsubusb    zmm29, zmm29, zmm30
+    vpcmpub     k4, zmm29, zmm31, 6
+%endif
+    vpbroadcastb zmm29, ecx
+    vpcmpub     k5, zmm29, zmm31, 6
+
+    vmovdqu8    zmm0{k1}{z}, ZMMWORD [rsi + 0 * SIZEOF_ZMMWORD]
+    vmovdqu8    zmm1{k2}{z}, ZMMWORD [rsi + 1 * SIZEOF_ZMMWORD]
+    vmovdqu8    zmm2{k3}{z}, ZMMWORD [rsi + 2 * SIZEOF_ZMMWORD]
+%if RGB_PIXELSIZE == 4
+    vmovdqu8    zmm3{k4}{z}, ZMMWORD [rsi + 3 * SIZEOF_ZMMWORD]
+%endif
+    jmp         short .rgb_ycc_cnv
+
+.columnloop:
+    vmovdqu64   zmm0, ZMMWORD [rsi + 0 * SIZEOF_ZMMWORD]
+    vmovdqu64   zmm1, ZMMWORD [rsi + 1 * SIZEOF_ZMMWORD]
+    vmovdqu64   zmm2, ZMMWORD [rsi + 2 * SIZEOF_ZMMWORD]
+%if RGB_PIXELSIZE == 4
+    vmovdqu64   zmm3, ZMMWORD [rsi + 3 * SIZEOF_ZMMWORD]
+%endif
+
+.rgb_ycc_cnv:
+%if RGB_PIXELSIZE == 3  ; ---------------
+
+    ; zmm0 = (P00 P01 P02 ... P14 P15 P16 P17 P18 P19 P20 P21.)
+    ; zmm1 = (.P21. P22 ... P38 P39 P40 P41 P42.)
+    ; zmm2 = (.P42 P43 ... P61 P62 P63)
+
+    vpermd      zmm3, zmm22, zmm2
+                ; zmm3 = (P48 P49 P50 P51 - ... P60 P61 P62 P63 -)
+    vpermt2d    zmm2, zmm21, zmm1
+                ; zmm2 = (P32 P33 P34 P35 - ... P44 P45 P46 P47 -)
+    vpermt2d    zmm1, zmm20, zmm0
+                ; zmm1 = (P16 P17 P18 P19 - ... P28 P29 P30 P31 -)
+    vpermd      zmm0, zmm19, zmm0
+                ; zmm0 = (P00 P01 P02 P03 - ... P12 P13 P14 P15 -)
+
+%endif  ; RGB_PIXELSIZE ; ---------------
+
+    ; zmm0 = pixels  0-15
+    ; zmm1 = pixels 16-31
+    ; zmm2 = pixels 32-47
+    ; zmm3 = pixels 48-63
+
+    DORGBYCC    zmm0, zmm16, zmm17, zmm4, zmm5, zmm6, zmm30, zmm31
+    DORGBYCC    zmm1, zmm16, zmm17, zmm7, zmm23, zmm24, zmm30, zmm31
+
+    vpackssdw   zmm4, zmm4, zmm7        ; zmm4 = Y(0-31)
+    vpackssdw   zmm5, zmm5, zmm23       ; zmm5 = Cb(0-31)
+    vpackssdw   zmm6, zmm6, zmm24       ; zmm6 = Cr(0-31)
+
+    DORGBYCC    zmm2, zmm16, zmm17, zmm0, zmm1, zmm7, zmm30, zmm31
+    DORGBYCC    zmm3, zmm16, zmm17, zmm2, zmm23, zmm24, zmm30, zmm31
+
+    vpackssdw   zmm0, zmm0, zmm2        ; zmm0 = Y(32-63)
+    vpackssdw   zmm1, zmm1, zmm23       ; zmm1 = Cb(32-63)
+    vpackssdw   zmm7, zmm7, zmm24       ; zmm7 = Cr(32-63)
+
+    vpackuswb   zmm4, zmm4, zmm0
+    vpackuswb   zmm5, zmm5, zmm1
+    vpackuswb   zmm6, zmm6, zmm7
+    vpermd      zmm4, zmm18, zmm4       ; zmm4 = Y(0-63)
+    vpermd      zmm5, zmm18, zmm5       ; zmm5 = Cb(0-63)
+    vpermd      zmm6, zmm18, zmm6       ; zmm6 = Cr(0-63)
+
+    cmp         rcx, byte SIZEOF_ZMMWORD
+    jb          short .column_st
+
+    vmovdqu64   ZMMWORD [rdi], zmm4     ; Save Y
+    vmovdqu64   ZMMWORD [rbx], zmm5     ; Save Cb
+    vmovdqu64   ZMMWORD [rdx], zmm6     ; Save Cr
+
+    sub         rcx, byte SIZEOF_ZMMWORD
+    add         rsi, RGB_PIXELSIZE * SIZEOF_ZMMWORD  ; inptr
+    add         rdi, byte SIZEOF_ZMMWORD             ; outptr0
+    add         rbx, byte SIZEOF_ZMMWORD             ; outptr1
+    add         rdx, byte SIZEOF_ZMMWORD             ; outptr2
+    cmp         rcx, byte SIZEOF_ZMMWORD
+    jae         near .columnloop
+    test        rcx, rcx
+    jnz         near .column_ld
+    jmp         short .nextrow
+
+.column_st:
+    vmovdqu8    ZMMWORD [rdi]{k5}, zmm4  ; Save Y
+    vmovdqu8    ZMMWORD [rbx]{k5}, zmm5  ; Save Cb
+    vmovdqu8    ZMMWORD [rdx]{k5}, zmm6  ; Save Cr
+
+.nextrow:
+    pop         rcx                     ; col
+    pop         rsi
+    pop         rdi
+    pop         rbx
+    pop         rdx
+
+    add         rsi, byte SIZEOF_JSAMPROW  ; input_buf
+    add         rdi, byte SIZEOF_JSAMPROW
+    add         rbx, byte SIZEOF_JSAMPROW
+    add         rdx, byte SIZEOF_JSAMPROW
+    dec         rax                        ; num_rows
+    jg          near .rowloop
+
+.return:
+    pop         rbx
+    vzeroupper
+    UNCOLLECT_ARGS 5
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
@@ -0,0 +1,246 @@
+;
+; RGB-to-YCbCr Color Conversion (64-bit AVX2, 12-bit samples)
+;
+; Copyright (C) 2026, D. R. Commander.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+
+%include "jcolsamp.inc"
+
+; --------------------------------------------------------------------------
+;
+; Convert some rows of samples to the JPEG colorspace.
+;
+; GLOBAL(void)
+; jsimd12_rgb_ycc_convert_avx2(JDIMENSION img_width, J12SAMPARRAY input_buf,
+;                              J12SAMPIMAGE output_buf, JDIMENSION output_row,
+;                              int num_rows)
+;
+; r10d = JDIMENSION img_width
+; r11 = J12SAMPARRAY input_buf
+; r12 = J12SAMPIMAGE output_buf
+; r13d = JDIMENSION output_row
+; r14d = int num_rows
+
+%define wk(i)   r15 - (WK_NUM - (i)) * SIZEOF_YMMWORD  ; ymmword wk[WK_NUM]
+%define WK_NUM  2
+
+    align       32
+    GLOBAL_FUNCTION(jsimd12_rgb_ycc_convert_avx2)
+
+EXTN(jsimd12_rgb_ycc_convert_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    push        r15
+    and         rsp, byte (-SIZEOF_YMMWORD)  ; align to 256 bits
+    ; Allocate stack space for wk array.  r15 is used to access it.
+    mov         r15, rsp
+    sub         rsp, (SIZEOF_YMMWORD * WK_NUM)
+    PUSH_XMM    4
+    COLLECT_ARGS 5
+    push        rbx
+
+    mov         ecx, r10d
+    test        rcx, rcx
+    jz          near .return
+
+    push        rcx
+
+    mov         rsi, r12
+    mov         ecx, r13d
+    mov         rdip, J12SAMPARRAY [rsi + 0 * SIZEOF_J12SAMPARRAY]
+    mov         rbxp, J12SAMPARRAY [rsi + 1 * SIZEOF_J12SAMPARRAY]
+    mov         rdxp, J12SAMPARRAY [rsi + 2 * SIZEOF_J12SAMPARRAY]
+    lea         rdi, [rdi + rcx * SIZEOF_J12SAMPROW]
+    lea         rbx, [rbx + rcx * SIZEOF_J12SAMPROW]
+    lea         rdx, [rdx + rcx * SIZEOF_J12SAMPROW]
+
+    pop         rcx
+
+    mov         rsi, r11
+    mov         eax, r14d
+    test        rax, rax
+    jle         near .return
+.rowloop:
+    push        rdx
+    push        rbx
+    push        rdi
+    push        rsi
+    push        rcx                     ; col
+
+    mov         rsip, J12SAMPROW [rsi]  ; inptr
+    mov         rdip, J12SAMPROW [rdi]  ; outptr0
+    mov         rbxp, J12SAMPROW [rbx]  ; outptr1
+    mov         rdxp, J12SAMPROW [rdx]  ; outptr2
+
+.columnloop:
+    cmp         rcx, byte SIZEOF_XMMWORD / SIZEOF_J12SAMPLE
+    jae         short .rgb_ycc_cnv
+
+    ; -- Copy the last (partial) group of pixels into the wk array, so that
+    ;    the loads below do not read past the end of the input row.
+
+    push        rdi
+    push        rcx
+    vpxor       ymm8, ymm8, ymm8
+    vmovdqa     YMMWORD [wk(0)], ymm8
+    vmovdqa     YMMWORD [wk(1)], ymm8
+%if RGB_PIXELSIZE == 3
+    lea         rcx, [rcx + rcx * 2]    ; imul rcx, RGB_PIXELSIZE
+%else
+    shl         rcx, 2                  ; imul rcx, RGB_PIXELSIZE
+%endif
+    shl         rcx, 1                  ; imul rcx, SIZEOF_J12SAMPLE
+    lea         rdi, [wk(0)]
+    cld
+    rep movsb
+    pop         rcx
+    pop         rdi
+    lea         rsi, [wk(0)]
+    mov         rcx, SIZEOF_XMMWORD / SIZEOF_J12SAMPLE
+
+.rgb_ycc_cnv:
+    ; NOTE: The values of RGB_RED, RGB_GREEN, and RGB_BLUE determine the
+    ; mapping of components A, B, C, and D to red, green, and blue.
+
+%if RGB_PIXELSIZE == 3  ; ---------------
+
+    vbroadcasti128 ymm8, XMMWORD [rsi + 0 * RGB_PIXELSIZE * SIZEOF_J12SAMPLE]
+    vbroadcasti128 ymm9, XMMWORD [rsi + 2 * RGB_PIXELSIZE * SIZEOF_J12SAMPLE]
+    vbroadcasti128 ymm10, \
+                XMMWORD [rsi + 4 * RGB_PIXELSIZE * SIZEOF_J12SAMPLE]
+    vbroadcasti128 ymm11, \
+                XMMWORD [rsi + 6 * RGB_PIXELSIZE * SIZEOF_J12SAMPLE - 4]
+    vpshufb     ymm8, ymm8, [rel PB_SHUF_RGB0]
+                ; ymm8  = (A0 B0 C0 -- A1 B1 C1 --)
+    vpshufb     ymm9, ymm9, [rel PB_SHUF_RGB0]
+                ; ymm9  = (A2 B2 C2 -- A3 B3 C3 --)
+    vpshufb     ymm10, ymm10, [rel PB_SHUF_RGB0]
+                ; ymm10 = (A4 B4 C4 -- A5 B5 C5 --)
+    vpshufb     ymm11, ymm11, [rel PB_SHUF_RGB1]
+                ; ymm11 = (A6 B6 C6 -- A7 B7 C7 --)
+
+%else  ; RGB_PIXELSIZE == 4 ; -----------
+
+    vpmovzxwd   ymm8, XMMWORD [rsi + 0 * SIZEOF_XMMWORD]
+                ; ymm8  = (A0 B0 C0 D0 A1 B1 C1 D1)
+    vpmovzxwd   ymm9, XMMWORD [rsi + 1 * SIZEOF_XMMWORD]
+                ; ymm9  = (A2 B2 C2 D2 A3 B3 C3 D3)
+    vpmovzxwd   ymm10, XMMWORD [rsi + 2 * SIZEOF_XMMWORD]
+                ; ymm10 = (A4 B4 C4 D4 A5 B5 C5 D5)
+    vpmovzxwd   ymm11, XMMWORD [rsi + 3 * SIZEOF_XMMWORD]
+                ; ymm11 = (A6 B6 C6 D6 A7 B7 C7 D7)
+
+%endif  ; RGB_PIXELSIZE ; ---------------
+
+    vpunpckldq  ymmB, ymm8, ymm9        ; ymmB  = (A0 A2 B0 B2 A1 A3 B1 B3)
+    vpunpckhdq  ymm8, ymm8, ymm9        ; ymm8  = (C0 C2 D0 D2 C1 C3 D1 D3)
+    vpunpckldq  ymmD, ymm10, ymm11      ; ymmD  = (A4 A6 B4 B6 A5 A7 B5 B7)
+    vpunpckhdq  ymm10, ymm10, ymm11     ; ymm10 = (C4 C6 D4 D6 C5 C7 D5 D7)
+
+    vpunpcklqdq ymmA, ymmB, ymmD        ; ymmA = (A0 A2 A4 A6 A1 A3 A5 A7)
+    vpunpckhqdq ymmC, ymmB, ymmD        ; ymmC = (B0 B2 B4 B6 B1 B3 B5 B7)
+    vpunpcklqdq ymmE, ymm8, ymm10       ; ymmE = (C0 C2 C4 C6 C1 C3 C5 C7)
+    vpunpckhqdq ymmG, ymm8, ymm10       ; ymmG = (D0 D2 D4 D6 D1 D3 D5 D7)
+
+    ; ymm0 = R = (R0 R2 R4 R6 R1 R3 R5 R7)
+    ; ymm2 = G = (G0 G2 G4 G6 G1 G3 G5 G7)
+    ; ymm4 = B = (B0 B2 B4 B6 B1 B3 B5 B7)
+
+    vmovdqa     ymm9, [rel PD_MAXJ12SAMPLE]
+    vpand       ymm0, ymm0, ymm9        ; Mask out-of-range samples, as the
+    vpand       ymm2, ymm2, ymm9        ; C implementation does.
+    vpand       ymm4, ymm4, ymm9
+
+    ; (Original)
+    ; Y  =  0.29900 * R + 0.58700 * G + 0.11400 * B
+    ; Cb = -0.16874 * R - 0.33126 * G + 0.50000 * B + CENTERJ12SAMPLE
+    ; Cr =  0.50000 * R - 0.41869 * G - 0.08131 * B + CENTERJ12SAMPLE
+    ;
+    ; (This implementation)
+    ; Y  =  0.29900 * R + 0.33700 * G + 0.11400 * B + 0.25000 * G
+    ; Cb = -0.16874 * R - 0.33126 * G + 0.50000 * B + CENTERJ12SAMPLE
+    ; Cr =  0.50000 * R - 0.41869 * G - 0.08131 * B + CENTERJ12SAMPLE
+
+    vpslld      ymm1, ymm2, WORD_BIT
+    vpor        ymm3, ymm0, ymm1        ; ymm3 = RG
+    vpor        ymm5, ymm4, ymm1        ; ymm5 = BG
+
+    vpmaddwd    ymm6, ymm3, [rel PW_F0299_F0337]
+                ; ymm6 = R * FIX(0.299) + G * FIX(0.337)
+    vpmaddwd    ymm7, ymm5, [rel PW_F0114_F0250]
+                ; ymm7 = B * FIX(0.114) + G * FIX(0.250)
+    vpmaddwd    ymm3, ymm3, [rel PW_MF016_MF033]
+                ; ymm3 = R * -FIX(0.168) + G * -FIX(0.331)
+    vpmaddwd    ymm5, ymm5, [rel PW_MF008_MF041]
+                ; ymm5 = B * -FIX(0.081) + G * -FIX(0.418)
+
+    vpslld      ymm4, ymm4, (SCALEBITS - 1)  ; ymm4 = B * FIX(0.500)
+    vpslld      ymm0, ymm0, (SCALEBITS - 1)  ; ymm0 = R * FIX(0.500)
+
+    vmovdqa     ymm1, [rel PD_ONEHALFM1_CJ]  ; ymm1 = [PD_ONEHALFM1_CJ]
+
+    vpaddd      ymm6, ymm6, ymm7
+    vpaddd      ymm6, ymm6, [rel PD_ONEHALF]
+    vpsrld      ymm6, ymm6, SCALEBITS   ; ymm6 = Y
+    vpaddd      ymm3, ymm3, ymm4
+    vpaddd      ymm3, ymm3, ymm1
+    vpsrld      ymm3, ymm3, SCALEBITS   ; ymm3 = Cb
+    vpaddd      ymm5, ymm5, ymm0
+    vpaddd      ymm5, ymm5, ymm1
+    vpsrld      ymm5, ymm5, SCALEBITS   ; ymm5 = Cr
+
+    vpackusdw   ymm6, ymm6, ymm3
+                ; ymm6 = (Y0 Y2 Y4 Y6 Cb0 Cb2 Cb4 Cb6
+                ;         Y1 Y3 Y5 Y7 Cb1 Cb3 Cb5 Cb7)
+    vpackusdw   ymm5, ymm5, ymm5
+                ; ymm5 = (Cr0 Cr2 Cr4 Cr6 Cr0 Cr2 Cr4 Cr6
+                ;         Cr1 Cr3 Cr5 Cr7 Cr1 Cr3 Cr5 Cr7)
+    vextracti128 xmm7, ymm6, 1
+    vextracti128 xmm1, ymm5, 1
+    vpunpcklwd  xmm0, xmm6, xmm7        ; xmm0 = Y
+    vpunpckhwd  xmm3, xmm6, xmm7        ; xmm3 = Cb
+    vpunpcklwd  xmm5, xmm5, xmm1        ; xmm5 = Cr
+
+    vmovdqu     XMMWORD [rdi], xmm0     ; Save Y
+    vmovdqu     XMMWORD [rbx], xmm3     ; Save Cb
+    vmovdqu     XMMWORD [rdx], xmm5     ; Save Cr
+
+    add         rsi, RGB_PIXELSIZE * SIZEOF_XMMWORD  ; inptr
+    add         rdi, byte SIZEOF_XMMWORD             ; outptr0
+    add         rbx, byte SIZEOF_XMMWORD             ; outptr1
+    add         rdx, byte SIZEOF_XMMWORD             ; outptr2
+    sub         rcx, byte SIZEOF_XMMWORD / SIZEOF_J12SAMPLE
+    jnz         near .columnloop
+
+    pop         rcx                     ; col
+    pop         rsi
+    pop         rdi
+    pop         rbx
+    pop         rdx
+
+    add         rsi, byte SIZEOF_J12SAMPROW  ; input_buf
+    add         rdi, byte SIZEOF_J12SAMPROW
+    add         rbx, byte SIZEOF_J12SAMPROW
+    add         rdx, byte SIZEOF_J12SAMPROW
+    dec         rax                          ; num_rows
+    jg          near .rowloop
+
+.return:
+    pop         rbx
+    vzeroupper
+    UNCOLLECT_ARGS 5
+    POP_XMM     4
+    lea         rsp, [rbp - 8]
+    pop         r15
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
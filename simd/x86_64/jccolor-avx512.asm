@@ -0,0 +1,195 @@
+;
+; RGB-to-YCbCr Color Conversion (64-bit AVX-512)
+;
+; Copyright (C) 2009, 2016, 2024, 2026, D. R. Commander.
+; Copyright (C) 2015, Intel Corporation.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler).  Yasm does not
+; support AVX-512 instructions.
+
+%include "jsimdext.inc"
+
+; --------------------------------------------------------------------------
+
+%define SCALEBITS  16
+
+F_0_081 equ  5329                ; FIX(0.08131)
+F_0_114 equ  7471                ; FIX(0.11400)
+F_0_168 equ 11059                ; FIX(0.16874)
+F_0_250 equ 16384                ; FIX(0.25000)
+F_0_299 equ 19595                ; FIX(0.29900)
+F_0_331 equ 21709                ; FIX(0.33126)
+F_0_418 equ 27439                ; FIX(0.41869)
+F_0_587 equ 38470                ; FIX(0.58700)
+F_0_337 equ (F_0_587 - F_0_250)  ; FIX(0.58700) - FIX(0.25000)
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      64
+    GLOBAL_DATA(jconst_rgb_ycc_convert_avx512)
+
+EXTN(jconst_rgb_ycc_convert_avx512):
+
+PW_F0299_F0337  times 16 dw  F_0_299,  F_0_337
+PW_F0114_F0250  times 16 dw  F_0_114,  F_0_250
+PW_MF016_MF033  times 16 dw -F_0_168, -F_0_331
+PW_MF008_MF041  times 16 dw -F_0_081, -F_0_418
+PD_ONEHALFM1_CJ times 16 dd  (1 << (SCALEBITS - 1)) - 1 + \
+                             (CENTERJSAMPLE << SCALEBITS)
+PD_ONEHALF      times 16 dd  (1 << (SCALEBITS - 1))
+
+; Byte indices, used to generate the masks for partial loads and stores
+PB_INDEX        db   0,  1,  2,  3,  4,  5,  6,  7
+                db   8,  9, 10, 11, 12, 13, 14, 15
+                db  16, 17, 18, 19, 20, 21, 22, 23
+                db  24, 25, 26, 27, 28, 29, 30, 31
+                db  32, 33, 34, 35, 36, 37, 38, 39
+                db  40, 41, 42, 43, 44, 45, 46, 47
+                db  48, 49, 50, 51, 52, 53, 54, 55
+                db  56, 57, 58, 59, 60, 61, 62, 63
+
+; Byte offsets of the four pixels in each 128-bit lane, arranged as vpshufb
+; controls that extract two components from each pixel into a pair of words
+; (0x80 zeroes the high byte of each word.)  The offsets of the components
+; within a pixel are added at run time.
+PD_SHUF_RGB     dd  0x80008000, 0x80038003, 0x80068006, 0x80098009
+PD_SHUF_RGBX    dd  0x80008000, 0x80048004, 0x80088008, 0x800C800C
+
+; vpermd/vpermt2d indices that spread 64 3-byte pixels across four registers,
+; such that each 128-bit lane contains four pixels
+PB_EXPAND_RGB   db   0,  1,  2,  2,  3,  4,  5,  5
+                db   6,  7,  8,  8,  9, 10, 11, 11
+                db  28, 29, 30, 30, 31,  0,  1,  1
+                db   2,  3,  4,  4,  5,  6,  7,  7
+                db  24, 25, 26, 26, 27, 28, 29, 29
+                db  30, 31,  0,  0,  1,  2,  3,  3
+                db   4,  5,  6,  6,  7,  8,  9,  9
+                db  10, 11, 12, 12, 13, 14, 15, 15
+
+; vpermd indices that restore the order of the samples after vpackssdw and
+; vpackuswb have interleaved the 128-bit lanes of four registers
+PB_TRANSPOSE    db   0,  4,  8, 12,  1,  5,  9, 13
+                db   2,  6, 10, 14,  3,  7, 11, 15
+
+    ALIGNZ      64
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Convert 16 pixels, each stored in a dword, to 16 dwords each of Y, Cb, and
+; Cr.
+;
+; %1 = pixels, %2 = RG shuffle control, %3 = BG shuffle control,
+; %4 = Y (output), %5 = Cb (output), %6 = Cr (output), %7-%8 = temporaries
+;
+; (Original)
+; Y  =  0.29900 * R + 0.58700 * G + 0.11400 * B
+; Cb = -0.16874 * R - 0.33126 * G + 0.50000 * B + CENTERJSAMPLE
+; Cr =  0.50000 * R - 0.41869 * G - 0.08131 * B + CENTERJSAMPLE
+;
+; (This implementation)
+; Y  =  0.29900 * R + 0.33700 * G + 0.11400 * B + 0.25000 * G
+; Cb = -0.16874 * R - 0.33126 * G + 0.50000 * B + CENTERJSAMPLE
+; Cr =  0.50000 * R - 0.41869 * G - 0.08131 * B + CENTERJSAMPLE
+
+%macro DORGBYCC 8
+    vpshufb     %7, %1, %2              ; %7 = (R0 G0 R1 G1 ... Rf Gf)
+    vpshufb     %8, %1, %3              ; %8 = (B0 G0 B1 G1 ... Bf Gf)
+
+    vpmaddwd    %4, %7, [rel PW_F0299_F0337]
+                ; %4 = R * FIX(0.299) + G * FIX(0.337)
+    vpmaddwd    %5, %8, [rel PW_F0114_F0250]
+                ; %5 = B * FIX(0.114) + G * FIX(0.250)
+    vpaddd      %4, %4, %5
+    vpaddd      %4, %4, [rel PD_ONEHALF]
+    vpsrld      %4, %4, SCALEBITS       ; %4 = Y
+
+    vpmaddwd    %5, %7, [rel PW_MF016_MF033]
+                ; %5 = R * -FIX(0.168) + G * -FIX(0.331)
+    vpmaddwd    %6, %8, [rel PW_MF008_MF041]
+                ; %6 = B * -FIX(0.081) + G * -FIX(0.418)
+    vpslld      %7, %7, WORD_BIT
+    vpslld      %8, %8, WORD_BIT
+    vpsrld      %7, %7, 1               ; %7 = R * FIX(0.500)
+    vpsrld      %8, %8, 1               ; %8 = B * FIX(0.500)
+    vpaddd      %5, %5, %8
+    vpaddd      %6, %6, %7
+    vpaddd      %5, %5, [rel PD_ONEHALFM1_CJ]
+    vpaddd      %6, %6, [rel PD_ONEHALFM1_CJ]
+    vpsrld      %5, %5, SCALEBITS       ; %5 = Cb
+    vpsrld      %6, %6, SCALEBITS       ; %6 = Cr
+%endmacro
+
+%include "jccolext-avx512.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_RGB_RED
+%define RGB_GREEN  EXT_RGB_GREEN
+%define RGB_BLUE  EXT_RGB_BLUE
+%define RGB_PIXELSIZE  EXT_RGB_PIXELSIZE
+%define jsimd_rgb_ycc_convert_avx512  jsimd_extrgb_ycc_convert_avx512
+%include "jccolext-avx512.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_RGBX_RED
+%define RGB_GREEN  EXT_RGBX_GREEN
+%define RGB_BLUE  EXT_RGBX_BLUE
+%define RGB_PIXELSIZE  EXT_RGBX_PIXELSIZE
+%define jsimd_rgb_ycc_convert_avx512  jsimd_extrgbx_ycc_convert_avx512
+%include "jccolext-avx512.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_BGR_RED
+%define RGB_GREEN  EXT_BGR_GREEN
+%define RGB_BLUE  EXT_BGR_BLUE
+%define RGB_PIXELSIZE  EXT_BGR_PIXELSIZE
+%define jsimd_rgb_ycc_convert_avx512  jsimd_extbgr_ycc_convert_avx512
+%include "jccolext-avx512.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_BGRX_RED
+%define RGB_GREEN  EXT_BGRX_GREEN
+%define RGB_BLUE  EXT_BGRX_BLUE
+%define RGB_PIXELSIZE  EXT_BGRX_PIXELSIZE
+%define jsimd_rgb_ycc_convert_avx512  jsimd_extbgrx_ycc_convert_avx512
+%include "jccolext-avx512.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_XBGR_RED
+%define RGB_GREEN  EXT_XBGR_GREEN
+%define RGB_BLUE  EXT_XBGR_BLUE
+%define RGB_PIXELSIZE  EXT_XBGR_PIXELSIZE
+%define jsimd_rgb_ycc_convert_avx512  jsimd_extxbgr_ycc_convert_avx512
+%include "jccolext-avx512.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_XRGB_RED
+%define RGB_GREEN  EXT_XRGB_GREEN
+%define RGB_BLUE  EXT_XRGB_BLUE
+%define RGB_PIXELSIZE  EXT_XRGB_PIXELSIZE
+%define jsimd_rgb_ycc_convert_avx512  jsimd_extxrgb_ycc_convert_avx512
+%include "jccolext-avx512.asm"
@@ -0,0 +1,184 @@
+;
+; Lossless JPEG Sample Differencing (64-bit AVX2)
+;
+; Copyright (C) 2026, D. R. Commander.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+;
+; The differencers in this file process eight samples at a time, using 32-bit
+; lanes.  Ra (the sample to the left) and Rc (the sample above and to the left)
+; are obtained by rotating the current row and the previous row one lane to the
+; right and inserting the last sample from the previous group of eight.  For
+; the first column, both Ra and Rc are taken from the initial predictor, which
+; makes all seven predictors reduce to the predictor that the JPEG standard
+; specifies for that column.
+
+%include "jsimdext.inc"
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      32
+    GLOBAL_DATA(jconst_difference_avx2)
+
+EXTN(jconst_difference_avx2):
+
+PD_ROTATE       dd 7, 0, 1, 2, 3, 4, 5, 6
+
+    ALIGNZ      32
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Load eight samples and zero-extend or sign-extend them to 32 bits
+
+%macro LOADSAMP8 2
+    vpmovzxbd   %1, MMWORD [%2]
+%endmacro
+
+%macro LOADSAMP12 2
+    vpmovsxwd   %1, XMMWORD [%2]
+%endmacro
+
+%macro LOADSAMP16 2
+    vpmovzxwd   %1, XMMWORD [%2]
+%endmacro
+
+;
+; Difference a row of samples.
+;
+; GLOBAL(void)
+; jsimd_difference<psv>_avx2(_JSAMPROW input_buf, _JSAMPROW prev_row,
+;                            JDIFFROW diff_buf, JDIMENSION width,
+;                            int initial_predictor)
+;
+; %1 = function name
+; %2 = predictor selection value (1-7)
+; %3 = data precision (8, 12, or 16)
+;
+; r10 = _JSAMPROW input_buf
+; r11 = _JSAMPROW prev_row
+; r12 = JDIFFROW diff_buf
+; r13d = JDIMENSION width
+; r14d = int initial_predictor
+
+%macro DIFFERENCE 3
+%if %3 == 8
+%define SIZEOF_SAMP  1
+%else
+%define SIZEOF_SAMP  2
+%endif
+
+    align       32
+    GLOBAL_FUNCTION(%1)
+
+EXTN(%1):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 5
+
+    mov         ecx, r13d               ; width
+    test        rcx, rcx
+    jz          near %%return
+
+    mov         rsi, r10                ; input_buf
+    mov         rdi, r11                ; prev_row
+    mov         rdx, r12                ; diff_buf
+
+    vmovdqa     ymm5, [rel PD_ROTATE]
+    vmovd       xmm6, r14d              ; ymm6 = (initial -- -- -- ...)
+    vmovdqa     ymm7, ymm6
+
+%%columnloop:
+    LOADSAMP%3  ymm0, rsi               ; ymm0 = samp
+%if %2 != 1
+    LOADSAMP%3  ymm1, rdi               ; ymm1 = Rb
+%endif
+
+%if %2 != 2 && %2 != 3
+    vpermd      ymm2, ymm5, ymm0
+    vpblendd    ymm3, ymm2, ymm6, 0x01  ; ymm3 = Ra
+    vmovdqa     ymm6, ymm2
+%endif
+%if %2 >= 3 && %2 <= 6
+    vpermd      ymm4, ymm5, ymm1
+    vpblendd    ymm2, ymm4, ymm7, 0x01  ; ymm2 = Rc
+    vmovdqa     ymm7, ymm4
+%endif
+
+%if %2 == 1
+    vpsubd      ymm0, ymm0, ymm3        ; samp - Ra
+%elif %2 == 2
+    vpsubd      ymm0, ymm0, ymm1        ; samp - Rb
+%elif %2 == 3
+    vpsubd      ymm0, ymm0, ymm2        ; samp - Rc
+%elif %2 == 4
+    vpaddd      ymm4, ymm3, ymm1
+    vpsubd      ymm4, ymm4, ymm2        ; ymm4 = Ra + Rb - Rc
+    vpsubd      ymm0, ymm0, ymm4
+%elif %2 == 5
+    vpsubd      ymm4, ymm1, ymm2
+    vpsrad      ymm4, ymm4, 1
+    vpaddd      ymm4, ymm4, ymm3        ; ymm4 = Ra + ((Rb - Rc) >> 1)
+    vpsubd      ymm0, ymm0, ymm4
+%elif %2 == 6
+    vpsubd      ymm4, ymm3, ymm2
+    vpsrad      ymm4, ymm4, 1
+    vpaddd      ymm4, ymm4, ymm1        ; ymm4 = Rb + ((Ra - Rc) >> 1)
+    vpsubd      ymm0, ymm0, ymm4
+%else
+    vpaddd      ymm4, ymm3, ymm1
+    vpsrad      ymm4, ymm4, 1           ; ymm4 = (Ra + Rb) >> 1
+    vpsubd      ymm0, ymm0, ymm4
+%endif
+
+    vmovdqu     YMMWORD [rdx], ymm0
+
+    add         rsi, byte 8 * SIZEOF_SAMP
+    add         rdi, byte 8 * SIZEOF_SAMP
+    add         rdx, byte SIZEOF_YMMWORD
+    sub         rcx, byte 8
+    jg          near %%columnloop
+
+%%return:
+    vzeroupper
+    UNCOLLECT_ARGS 5
+    pop         rbp
+    ret
+
+%undef SIZEOF_SAMP
+%endmacro
+
+    DIFFERENCE  jsimd_difference1_avx2, 1, 8
+    DIFFERENCE  jsimd_difference2_avx2, 2, 8
+    DIFFERENCE  jsimd_difference3_avx2, 3, 8
+    DIFFERENCE  jsimd_difference4_avx2, 4, 8
+    DIFFERENCE  jsimd_difference5_avx2, 5, 8
+    DIFFERENCE  jsimd_difference6_avx2, 6, 8
+    DIFFERENCE  jsimd_difference7_avx2, 7, 8
+
+    DIFFERENCE  jsimd12_difference1_avx2, 1, 12
+    DIFFERENCE  jsimd12_difference2_avx2, 2, 12
+    DIFFERENCE  jsimd12_difference3_avx2, 3, 12
+    DIFFERENCE  jsimd12_difference4_avx2, 4, 12
+    DIFFERENCE  jsimd12_difference5_avx2, 5, 12
+    DIFFERENCE  jsimd12_difference6_avx2, 6, 12
+    DIFFERENCE  jsimd12_difference7_avx2, 7, 12
+
+    DIFFERENCE  jsimd16_difference1_avx2, 1, 16
+    DIFFERENCE  jsimd16_difference2_avx2, 2, 16
+    DIFFERENCE  jsimd16_difference3_avx2, 3, 16
+    DIFFERENCE  jsimd16_difference4_avx2, 4, 16
+    DIFFERENCE  jsimd16_difference5_avx2, 5, 16
+    DIFFERENCE  jsimd16_difference6_avx2, 6, 16
+    DIFFERENCE  jsimd16_difference7_avx2, 7, 16
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
@@ -0,0 +1,293 @@
+;
+; Downsampling (64-bit AVX2, 12-bit samples)
+;
+; Copyright (C) 2026, D. R. Commander.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+
+%include "jsimdext.inc"
+
+; --------------------------------------------------------------------------
+; Expand a component horizontally from image_width to output_cols * 2 by
+; duplicating the rightmost samples.
+; r10d = JDIMENSION image_width
+; r11 = int max_v_samp_factor
+; r14 = J12SAMPARRAY input_data
+; rcx = output_cols
+
+%macro EXPAND_RIGHT_EDGE 0
+    mov         edx, r10d
+
+    push        rcx
+    shl         rcx, 1                  ; output_cols * 2
+    sub         rcx, rdx
+    jle         short .expand_end
+
+    mov         rax, r11
+    test        rax, rax
+    jle         short .expand_end
+
+    cld
+    mov         rsi, r14                ; input_data
+.expandloop:
+    push        rax
+    push        rcx
+
+    mov         rdip, J12SAMPROW [rsi]
+    lea         rdi, [rdi + rdx * SIZEOF_J12SAMPLE]
+    mov         ax, J12SAMPLE [rdi - SIZEOF_J12SAMPLE]
+
+    rep stosw
+
+    pop         rcx
+    pop         rax
+
+    add         rsi, byte SIZEOF_J12SAMPROW
+    dec         rax
+    jg          short .expandloop
+
+.expand_end:
+    pop         rcx                     ; output_cols
+%endmacro
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Downsample components from a single plane.
+; This version handles the common case of 2:1 horizontal and 1:1 vertical,
+; without smoothing.
+;
+; GLOBAL(void)
+; jsimd12_h2v1_downsample_avx2(JDIMENSION image_width, int max_v_samp_factor,
+;                              JDIMENSION v_samp_factor,
+;                              JDIMENSION width_in_blocks,
+;                              J12SAMPARRAY input_data,
+;                              J12SAMPARRAY output_data)
+;
+; r10d = JDIMENSION image_width
+; r11 = int max_v_samp_factor
+; r12d = JDIMENSION v_samp_factor
+; r13d = JDIMENSION width_in_blocks
+; r14 = J12SAMPARRAY input_data
+; r15 = J12SAMPARRAY output_data
+
+    align       32
+    GLOBAL_FUNCTION(jsimd12_h2v1_downsample_avx2)
+
+EXTN(jsimd12_h2v1_downsample_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 6
+
+    mov         ecx, r13d
+    shl         rcx, 3                  ; imul rcx, DCTSIZE (rcx = output_cols)
+    jz          near .return
+
+    ; -- expand_right_edge
+
+    EXPAND_RIGHT_EDGE
+
+    ; -- h2v1_downsample
+
+    mov         eax, r12d               ; rowctr
+    test        eax, eax
+    jle         near .return
+
+    mov         rdx, 0x0000000100000000  ; bias pattern
+    vmovq       xmm7, rdx
+    vpbroadcastq ymm7, xmm7             ; ymm7 = { 0, 1, 0, 1, 0, 1, 0, 1 }
+    vpcmpeqd    ymm6, ymm6, ymm6
+    vpsrld      ymm6, ymm6, WORD_BIT    ; ymm6 = { 0xFFFF 0x0000 0xFFFF .. }
+
+    mov         rsi, r14                ; input_data
+    mov         rdi, r15                ; output_data
+.rowloop:
+    push        rcx
+    push        rdi
+    push        rsi
+
+    mov         rsip, J12SAMPROW [rsi]  ; inptr
+    mov         rdip, J12SAMPROW [rdi]  ; outptr
+
+.columnloop:
+    vmovdqu     ymm0, YMMWORD [rsi + 0 * SIZEOF_YMMWORD]
+    vpsrld      ymm2, ymm0, WORD_BIT
+    vpand       ymm0, ymm0, ymm6
+    vpaddd      ymm0, ymm0, ymm2
+    vpaddd      ymm0, ymm0, ymm7
+    vpsrld      ymm0, ymm0, 1
+
+    cmp         rcx, byte SIZEOF_YMMWORD / SIZEOF_J12SAMPLE
+    jb          short .column_r8
+
+    vmovdqu     ymm1, YMMWORD [rsi + 1 * SIZEOF_YMMWORD]
+    vpsrld      ymm3, ymm1, WORD_BIT
+    vpand       ymm1, ymm1, ymm6
+    vpaddd      ymm1, ymm1, ymm3
+    vpaddd      ymm1, ymm1, ymm7
+    vpsrld      ymm1, ymm1, 1
+
+    vpackusdw   ymm0, ymm0, ymm1
+    vpermq      ymm0, ymm0, 0xd8
+
+    vmovdqu     YMMWORD [rdi + 0 * SIZEOF_YMMWORD], ymm0
+
+    add         rsi, byte 2 * SIZEOF_YMMWORD  ; inptr
+    add         rdi, byte 1 * SIZEOF_YMMWORD  ; outptr
+    sub         rcx, byte SIZEOF_YMMWORD / SIZEOF_J12SAMPLE  ; outcol
+    jnz         short .columnloop
+    jmp         short .nextrow
+
+.column_r8:
+    ; rcx can only be 8 here
+    vextracti128 xmm1, ymm0, 1
+    vpackusdw   xmm0, xmm0, xmm1
+    vmovdqu     XMMWORD [rdi + 0 * SIZEOF_XMMWORD], xmm0
+
+.nextrow:
+    pop         rsi
+    pop         rdi
+    pop         rcx
+
+    add         rsi, byte SIZEOF_J12SAMPROW  ; input_data
+    add         rdi, byte SIZEOF_J12SAMPROW  ; output_data
+    dec         rax                          ; rowctr
+    jg          near .rowloop
+
+.return:
+    vzeroupper
+    UNCOLLECT_ARGS 6
+    pop         rbp
+    ret
+
+; --------------------------------------------------------------------------
+;
+; Downsample components from a single plane.
+; This version handles the standard case of 2:1 horizontal and 2:1 vertical,
+; without smoothing.
+;
+; GLOBAL(void)
+; jsimd12_h2v2_downsample_avx2(JDIMENSION image_width, int max_v_samp_factor,
+;                              JDIMENSION v_samp_factor,
+;                              JDIMENSION width_in_blocks,
+;                              J12SAMPARRAY input_data,
+;                              J12SAMPARRAY output_data)
+;
+; r10d = JDIMENSION image_width
+; r11 = int max_v_samp_factor
+; r12d = JDIMENSION v_samp_factor
+; r13d = JDIMENSION width_in_blocks
+; r14 = J12SAMPARRAY input_data
+; r15 = J12SAMPARRAY output_data
+
+    align       32
+    GLOBAL_FUNCTION(jsimd12_h2v2_downsample_avx2)
+
+EXTN(jsimd12_h2v2_downsample_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 6
+
+    mov         ecx, r13d
+    shl         rcx, 3                  ; imul rcx, DCTSIZE (rcx = output_cols)
+    jz          near .return
+
+    ; -- expand_right_edge
+
+    EXPAND_RIGHT_EDGE
+
+    ; -- h2v2_downsample
+
+    mov         eax, r12d               ; rowctr
+    test        rax, rax
+    jle         near .return
+
+    mov         rdx, 0x0000000200000001  ; bias pattern
+    vmovq       xmm7, rdx
+    vpbroadcastq ymm7, xmm7             ; ymm7 = { 1, 2, 1, 2, 1, 2, 1, 2 }
+    vpcmpeqd    ymm6, ymm6, ymm6
+    vpsrld      ymm6, ymm6, WORD_BIT    ; ymm6 = { 0xFFFF 0x0000 0xFFFF .. }
+
+    mov         rsi, r14                ; input_data
+    mov         rdi, r15                ; output_data
+.rowloop:
+    push        rcx
+    push        rdi
+    push        rsi
+
+    mov         rdxp, J12SAMPROW [rsi + 0 * SIZEOF_J12SAMPROW]  ; inptr0
+    mov         rsip, J12SAMPROW [rsi + 1 * SIZEOF_J12SAMPROW]  ; inptr1
+    mov         rdip, J12SAMPROW [rdi]                          ; outptr
+
+.columnloop:
+    vmovdqu     ymm0, YMMWORD [rdx + 0 * SIZEOF_YMMWORD]
+    vmovdqu     ymm1, YMMWORD [rsi + 0 * SIZEOF_YMMWORD]
+    vpsrld      ymm4, ymm0, WORD_BIT
+    vpand       ymm0, ymm0, ymm6
+    vpsrld      ymm5, ymm1, WORD_BIT
+    vpand       ymm1, ymm1, ymm6
+    vpaddd      ymm0, ymm0, ymm4
+    vpaddd      ymm1, ymm1, ymm5
+    vpaddd      ymm0, ymm0, ymm1
+    vpaddd      ymm0, ymm0, ymm7
+    vpsrld      ymm0, ymm0, 2
+
+    cmp         rcx, byte SIZEOF_YMMWORD / SIZEOF_J12SAMPLE
+    jb          short .column_r8
+
+    vmovdqu     ymm2, YMMWORD [rdx + 1 * SIZEOF_YMMWORD]
+    vmovdqu     ymm3, YMMWORD [rsi + 1 * SIZEOF_YMMWORD]
+    vpsrld      ymm4, ymm2, WORD_BIT
+    vpand       ymm2, ymm2, ymm6
+    vpsrld      ymm5, ymm3, WORD_BIT
+    vpand       ymm3, ymm3, ymm6
+    vpaddd      ymm2, ymm2, ymm4
+    vpaddd      ymm3, ymm3, ymm5
+    vpaddd      ymm2, ymm2, ymm3
+    vpaddd      ymm2, ymm2, ymm7
+    vpsrld      ymm2, ymm2, 2
+
+    vpackusdw   ymm0, ymm0, ymm2
+    vpermq      ymm0, ymm0, 0xd8
+
+    vmovdqu     YMMWORD [rdi + 0 * SIZEOF_YMMWORD], ymm0
+
+    add         rdx, byte 2 * SIZEOF_YMMWORD  ; inptr0
+    add         rsi, byte 2 * SIZEOF_YMMWORD  ; inptr1
+    add         rdi, byte 1 * SIZEOF_YMMWORD  ; outptr
+    sub         rcx, byte SIZEOF_YMMWORD / SIZEOF_J12SAMPLE  ; outcol
+    jnz         short .columnloop
+    jmp         short .nextrow
+
+.column_r8:
+    ; rcx can only be 8 here
+    vextracti128 xmm2, ymm0, 1
+    vpackusdw   xmm0, xmm0, xmm2
+    vmovdqu     XMMWORD [rdi + 0 * SIZEOF_XMMWORD], xmm0
+
+.nextrow:
+    pop         rsi
+    pop         rdi
+    pop         rcx
+
+    add         rsi, byte 2 * SIZEOF_J12SAMPROW  ; input_data
+    add         rdi, byte 1 * SIZEOF_J12SAMPROW  ; output_data
+    dec         rax                              ; rowctr
+    jg          near .rowloop
+
+.return:
+    vzeroupper
+    UNCOLLECT_ARGS 6
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
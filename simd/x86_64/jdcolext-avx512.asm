@@ -0,0 +1,332 @@
+;
+; YCbCr-to-RGB Color Conversion (64-bit AVX-512)
+;
+; Copyright 2009, 2012 Pierre Ossman <ossman@cendio.se> for Cendio AB
+; Copyright (C) 2009, 2012, 2016, 2024-2026, D. R. Commander.
+; Copyright (C) 2015, Intel Corporation.
+; Copyright (C) 2018, Matthias Räncker.
+; Copyright (C) 2023, Aliaksiej Kandracienka.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler).  Yasm does not
+; support AVX-512 instructions.
+
+%include "jcolsamp.inc"
+
+; --------------------------------------------------------------------------
+;
+; Convert some rows of samples to the output colorspace.
+;
+; Each iteration of the column loop converts 64 pixels.  The final (partial)
+; group of pixels in each row is written using masked stores, so no bytes
+; beyond the end of the output row are modified.
+;
+; GLOBAL(void)
+; jsimd_ycc_rgb_convert_avx512(JDIMENSION out_width, JSAMPIMAGE input_buf,
+;                              JDIMENSION input_row, JSAMPARRAY output_buf,
+;                              int num_rows)
+;
+; r10d = JDIMENSION out_width
+; r11 = JSAMPIMAGE input_buf
+; r12d = JDIMENSION input_row
+; r13 = JSAMPARRAY output_buf
+; r14d = int num_rows
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_ycc_rgb_convert_avx512)
+
+EXTN(jsimd_ycc_rgb_convert_avx512):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 5
+    push        rbx
+
+    mov         ecx, r10d               ; num_cols
+    test        rcx, rcx
+    jz          near .return
+
+    push        rcx
+
+    mov         rdi, r11
+    mov         ecx, r12d
+    mov         rsip, JSAMPARRAY [rdi + 0 * SIZEOF_JSAMPARRAY]
+    mov         rbxp, JSAMPARRAY [rdi + 1 * SIZEOF_JSAMPARRAY]
+    mov         rdxp, JSAMPARRAY [rdi + 2 * SIZEOF_JSAMPARRAY]
+    lea         rsi, [rsi + rcx * SIZEOF_JSAMPROW]
+    lea         rbx, [rbx + rcx * SIZEOF_JSAMPROW]
+    lea         rdx, [rdx + rcx * SIZEOF_JSAMPROW]
+
+    pop         rcx
+
+    mov         rdi, r13
+    mov         eax, r14d
+    test        rax, rax
+    jle         near .return
+
+    vpternlogd  zmm24, zmm24, zmm24, 0xFF
+    vpsllw      zmm25, zmm24, 7     ; zmm25 = { 0xFF80 0xFF80 0xFF80 0xFF80 .. }
+    vpsrlw      zmm24, zmm24, BYTE_BIT  ; zmm24 = { 0xFF 0x00 0xFF 0x00 .. }
+    vbroadcasti32x4 zmm26, [rel PB_INTERLEAVE]
+    vpmovzxbd   zmm27, [rel PB_TRANSPOSE]
+%if RGB_PIXELSIZE == 3
+    vbroadcasti32x4 zmm28, [rel PB_COMPRESS_RGB]
+    vpmovzxbd   zmm29, [rel PB_PACK_RGB + 0 * SIZEOF_XMMWORD]
+    vpmovzxbd   zmm30, [rel PB_PACK_RGB + 1 * SIZEOF_XMMWORD]
+    vpmovzxbd   zmm31, [rel PB_PACK_RGB + 2 * SIZEOF_XMMWORD]
+%endif
+.rowloop:
+    push        rax
+    push        rdi
+    push        rdx
+    push        rbx
+    push        rsi
+    push        rcx                     ; col
+
+    mov         rsip, JSAMPROW [rsi]    ; inptr0
+    mov         rbxp, JSAMPROW [rbx]    ; inptr1
+    mov         rdxp, JSAMPROW [rdx]    ; inptr2
+    mov         rdip, JSAMPROW [rdi]    ; outptr
+.columnloop:
+
+    vmovdqu64   zmm5, ZMMWORD [rbx]     ; zmm5 = Cb(0..63)
+    vmovdqu64   zmm1, ZMMWORD [rdx]     ; zmm1 = Cr(0..63)
+
+    vpandq      zmm4, zmm24, zmm5       ; zmm4 = Cb(0 2 4 .. 62) = CbE
+    vpsrlw      zmm5, zmm5, BYTE_BIT    ; zmm5 = Cb(1 3 5 .. 63) = CbO
+    vpandq      zmm0, zmm24, zmm1       ; zmm0 = Cr(0 2 4 .. 62) = CrE
+    vpsrlw      zmm1, zmm1, BYTE_BIT    ; zmm1 = Cr(1 3 5 .. 63) = CrO
+
+    vpaddw      zmm2, zmm4, zmm25
+    vpaddw      zmm3, zmm5, zmm25
+    vpaddw      zmm6, zmm0, zmm25
+    vpaddw      zmm7, zmm1, zmm25
+
+    ; (Original)
+    ; R = Y                + 1.40200 * Cr
+    ; G = Y - 0.34414 * Cb - 0.71414 * Cr
+    ; B = Y + 1.77200 * Cb
+    ;
+    ; (This implementation)
+    ; R = Y                + 0.40200 * Cr + Cr
+    ; G = Y - 0.34414 * Cb + 0.28586 * Cr - Cr
+    ; B = Y - 0.22800 * Cb + Cb + Cb
+
+    vpaddw      zmm4, zmm2, zmm2        ; zmm4 = 2 * CbE
+    vpaddw      zmm5, zmm3, zmm3        ; zmm5 = 2 * CbO
+    vpaddw      zmm0, zmm6, zmm6        ; zmm0 = 2 * CrE
+    vpaddw      zmm1, zmm7, zmm7        ; zmm1 = 2 * CrO
+
+    vpmulhw     zmm4, zmm4, [rel PW_MF0228]  ; zmm4 = (2 * CbE * -FIX(0.22800))
+    vpmulhw     zmm5, zmm5, [rel PW_MF0228]  ; zmm5 = (2 * CbO * -FIX(0.22800))
+    vpmulhw     zmm0, zmm0, [rel PW_F0402]   ; zmm0 = (2 * CrE * FIX(0.40200))
+    vpmulhw     zmm1, zmm1, [rel PW_F0402]   ; zmm1 = (2 * CrO * FIX(0.40200))
+
+    vpaddw      zmm4, zmm4, [rel PW_ONE]
+    vpaddw      zmm5, zmm5, [rel PW_ONE]
+    vpsraw      zmm4, zmm4, 1           ; zmm4 = (CbE * -FIX(0.22800))
+    vpsraw      zmm5, zmm5, 1           ; zmm5 = (CbO * -FIX(0.22800))
+    vpaddw      zmm0, zmm0, [rel PW_ONE]
+    vpaddw      zmm1, zmm1, [rel PW_ONE]
+    vpsraw      zmm0, zmm0, 1           ; zmm0 = (CrE * FIX(0.40200))
+    vpsraw      zmm1, zmm1, 1           ; zmm1 = (CrO * FIX(0.40200))
+
+    vpaddw      zmm4, zmm4, zmm2
+    vpaddw      zmm5, zmm5, zmm3
+    vpaddw      zmm16, zmm4, zmm2      ; zmm16 = (CbE * FIX(1.77200)) = (B - Y)E
+    vpaddw      zmm17, zmm5, zmm3      ; zmm17 = (CbO * FIX(1.77200)) = (B - Y)O
+    vpaddw      zmm0, zmm0, zmm6       ; zmm0 = (CrE * FIX(1.40200)) = (R - Y)E
+    vpaddw      zmm1, zmm1, zmm7       ; zmm1 = (CrO * FIX(1.40200)) = (R - Y)O
+
+    vpunpckhwd  zmm4, zmm2, zmm6
+    vpunpcklwd  zmm2, zmm2, zmm6
+    vpmaddwd    zmm2, zmm2, [rel PW_MF0344_F0285]
+    vpmaddwd    zmm4, zmm4, [rel PW_MF0344_F0285]
+    vpunpckhwd  zmm5, zmm3, zmm7
+    vpunpcklwd  zmm3, zmm3, zmm7
+    vpmaddwd    zmm3, zmm3, [rel PW_MF0344_F0285]
+    vpmaddwd    zmm5, zmm5, [rel PW_MF0344_F0285]
+
+    vpaddd      zmm2, zmm2, [rel PD_ONEHALF]
+    vpaddd      zmm4, zmm4, [rel PD_ONEHALF]
+    vpsrad      zmm2, zmm2, SCALEBITS
+    vpsrad      zmm4, zmm4, SCALEBITS
+    vpaddd      zmm3, zmm3, [rel PD_ONEHALF]
+    vpaddd      zmm5, zmm5, [rel PD_ONEHALF]
+    vpsrad      zmm3, zmm3, SCALEBITS
+    vpsrad      zmm5, zmm5, SCALEBITS
+
+    vpackssdw   zmm2, zmm2, zmm4
+                ; zmm2 = CbE * -FIX(0.344) + CrE * FIX(0.285)
+    vpackssdw   zmm3, zmm3, zmm5
+                ; zmm3 = CbO * -FIX(0.344) + CrO * FIX(0.285)
+    vpsubw      zmm2, zmm2, zmm6
+                ; zmm2 = CbE * -FIX(0.344) + CrE * -FIX(0.714) = (G - Y)E
+    vpsubw      zmm3, zmm3, zmm7
+                ; zmm3 = CbO * -FIX(0.344) + CrO * -FIX(0.714) = (G - Y)O
+
+    vmovdqu64   zmm5, ZMMWORD [rsi]     ; zmm5 = Y(0..63)
+
+    vpandq      zmm4, zmm24, zmm5       ; zmm4 = Y(0 2 4 .. 62) = YE
+    vpsrlw      zmm5, zmm5, BYTE_BIT    ; zmm5 = Y(1 3 5 .. 63) = YO
+
+    vpaddw      zmm0, zmm0, zmm4        ; zmm0 = ((R - Y)E + YE) = RE
+    vpaddw      zmm1, zmm1, zmm5        ; zmm1 = ((R - Y)O + YO) = RO
+    vpackuswb   zmm0, zmm0, zmm1
+
+    vpaddw      zmm2, zmm2, zmm4        ; zmm2 = ((G - Y)E + YE) = GE
+    vpaddw      zmm3, zmm3, zmm5        ; zmm3 = ((G - Y)O + YO) = GO
+    vpackuswb   zmm2, zmm2, zmm3
+
+    vpaddw      zmm4, zmm4, zmm16       ; zmm4 = (YE + (B - Y)E) = BE
+    vpaddw      zmm5, zmm5, zmm17       ; zmm5 = (YO + (B - Y)O) = BO
+    vpackuswb   zmm4, zmm4, zmm5
+
+    ; Each 128-bit lane of zmm0, zmm2, and zmm4 now contains the even samples
+    ; from the corresponding lane of the input, followed by the odd samples.
+    ; Restore the natural order of the samples within each lane, and then
+    ; distribute them such that lane i contains samples 4i-4i+3,
+    ; 4i+16-4i+19, 4i+32-4i+35, and 4i+48-4i+51.
+
+    vpshufb     zmm0, zmm0, zmm26
+    vpshufb     zmm2, zmm2, zmm26
+    vpshufb     zmm4, zmm4, zmm26
+    vpermd      zmm0, zmm27, zmm0       ; zmm0 = R
+    vpermd      zmm2, zmm27, zmm2       ; zmm2 = G
+    vpermd      zmm4, zmm27, zmm4       ; zmm4 = B
+
+%if RGB_PIXELSIZE == 4
+%ifdef RGBX_FILLER_0XFF
+    vpternlogd  zmm6, zmm6, zmm6, 0xFF  ; zmm6 = X
+%else
+    vpxord      zmm6, zmm6, zmm6        ; zmm6 = X
+%endif
+%endif
+
+    ; NOTE: The values of RGB_RED, RGB_GREEN, and RGB_BLUE determine the
+    ; mapping of components A, B, C, and D to red, green, and blue.  (If
+    ; RGB_PIXELSIZE == 3, then component D is discarded.)
+    ;
+    ; zmmA = A, zmmC = B, zmmE = C, zmmG = D
+
+    vpunpckhbw  zmmB, zmmA, zmmC
+    vpunpcklbw  zmmA, zmmA, zmmC
+    vpunpckhbw  zmmF, zmmE, zmmG
+    vpunpcklbw  zmmE, zmmE, zmmG
+
+    vpunpckhwd  zmmC, zmmA, zmmE        ; zmmC = (ABCD16 ABCD17 .. ABCD31)
+    vpunpcklwd  zmmA, zmmA, zmmE        ; zmmA = (ABCD0 ABCD1 .. ABCD15)
+    vpunpckhwd  zmmD, zmmB, zmmF        ; zmmD = (ABCD48 ABCD49 .. ABCD63)
+    vpunpcklwd  zmmB, zmmB, zmmF        ; zmmB = (ABCD32 ABCD33 .. ABCD47)
+
+%if RGB_PIXELSIZE == 3  ; ---------------
+
+    vpshufb     zmmA, zmmA, zmm28
+    vpshufb     zmmC, zmmC, zmm28
+    vpshufb     zmmB, zmmB, zmm28
+    vpshufb     zmmD, zmmD, zmm28
+    vpermt2d    zmmA, zmm29, zmmC       ; zmmA = (ABC0 ABC1 .. ABC20 AB21)
+    vpermt2d    zmmC, zmm30, zmmB       ; zmmC = (C21 ABC22 .. ABC41 A42)
+    vpermt2d    zmmB, zmm31, zmmD       ; zmmB = (BC42 ABC43 .. ABC63)
+
+    cmp         rcx, byte SIZEOF_ZMMWORD
+    jb          near .column_st
+
+    test        rdi, SIZEOF_ZMMWORD - 1
+    jnz         short .out1
+    ; --(aligned)-------------------
+    vmovntdq    ZMMWORD [rdi + 0 * SIZEOF_ZMMWORD], zmmA
+    vmovntdq    ZMMWORD [rdi + 1 * SIZEOF_ZMMWORD], zmmC
+    vmovntdq    ZMMWORD [rdi + 2 * SIZEOF_ZMMWORD], zmmB
+    jmp         short .out0
+.out1:  ; --(unaligned)-----------------
+    vmovdqu64   ZMMWORD [rdi + 0 * SIZEOF_ZMMWORD], zmmA
+    vmovdqu64   ZMMWORD [rdi + 1 * SIZEOF_ZMMWORD], zmmC
+    vmovdqu64   ZMMWORD [rdi + 2 * SIZEOF_ZMMWORD], zmmB
+
+%else  ; RGB_PIXELSIZE == 4 ; -----------
+
+    cmp         rcx, byte SIZEOF_ZMMWORD
+    jb          near .column_st
+
+    test        rdi, SIZEOF_ZMMWORD - 1
+    jnz         short .out1
+    ; --(aligned)-------------------
+    vmovntdq    ZMMWORD [rdi + 0 * SIZEOF_ZMMWORD], zmmA
+    vmovntdq    ZMMWORD [rdi + 1 * SIZEOF_ZMMWORD], zmmC
+    vmovntdq    ZMMWORD [rdi + 2 * SIZEOF_ZMMWORD], zmmB
+    vmovntdq    ZMMWORD [rdi + 3 * SIZEOF_ZMMWORD], zmmD
+    jmp         short .out0
+.out1:  ; --(unaligned)-----------------
+    vmovdqu64   ZMMWORD [rdi + 0 * SIZEOF_ZMMWORD], zmmA
+    vmovdqu64   ZMMWORD [rdi + 1 * SIZEOF_ZMMWORD], zmmC
+    vmovdqu64   ZMMWORD [rdi + 2 * SIZEOF_ZMMWORD], zmmB
+    vmovdqu64   ZMMWORD [rdi + 3 * SIZEOF_ZMMWORD], zmmD
+
+%endif  ; RGB_PIXELSIZE ; ---------------
+
+.out0:
+    add         rdi, RGB_PIXELSIZE * SIZEOF_ZMMWORD  ; outptr
+    sub         rcx, byte SIZEOF_ZMMWORD
+    jz          near .nextrow
+
+    add         rsi, byte SIZEOF_ZMMWORD  ; inptr0
+    add         rbx, byte SIZEOF_ZMMWORD  ; inptr1
+    add         rdx, byte SIZEOF_ZMMWORD  ; inptr2
+    jmp         near .columnloop
+
+.column_st:
+    ; Generate the store masks k1-k3 (k1-k4 if RGB_PIXELSIZE == 4) for the
+    ; remaining pixels.
+    imul        r8d, ecx, RGB_PIXELSIZE
+    vpbroadcastb zmm16, r8d
+    mov         r9d, SIZEOF_ZMMWORD
+    vpbroadcastb zmm17, r9d
+    vmovdqa64   zmm18, ZMMWORD [rel PB_INDEX]
+    vpcmpub     k1, zmm16, zmm18, 6     ; k1 = (zmm16 > index)
+    vpsubusb    zmm16, zmm16, zmm17
+    vpcmpub     k2, zmm16, zmm18, 6
+    vpsubusb    zmm16, zmm16, zmm17
+    vpcmpub     k3, zmm16, zmm18, 6
+%if RGB_PIXELSIZE == 4
+    vpsubusb    zmm16, zmm16, zmm17
+    vpcmpub     k4, zmm16, zmm18, 6
+%endif
+
+    vmovdqu8    ZMMWORD [rdi + 0 * SIZEOF_ZMMWORD]{k1}, zmmA
+    vmovdqu8    ZMMWORD [rdi + 1 * SIZEOF_ZMMWORD]{k2}, zmmC
+    vmovdqu8    ZMMWORD [rdi + 2 * SIZEOF_ZMMWORD]{k3}, zmmB
+%if RGB_PIXELSIZE == 4
+    vmovdqu8    ZMMWORD [rdi + 3 * SIZEOF_ZMMWORD]{k4}, zmmD
+%endif
+
+.nextrow:
+    pop         rcx
+    pop         rsi
+    pop         rbx
+    pop         rdx
+    pop         rdi
+    pop         rax
+
+    add         rsi, byte SIZEOF_JSAMPROW
+    add         rbx, byte SIZEOF_JSAMPROW
+    add         rdx, byte SIZEOF_JSAMPROW
+    add         rdi, byte SIZEOF_JSAMPROW  ; output_buf
+    dec         rax                        ; num_rows
+    jg          near .rowloop
+
+    sfence                              ; flush the write buffer
+
+.return:
+    pop         rbx
+    vzeroupper
+    UNCOLLECT_ARGS 5
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
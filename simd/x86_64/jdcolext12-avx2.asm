@@ -0,0 +1,238 @@
+;
+; YCbCr-to-RGB Color Conversion (64-bit AVX2, 12-bit samples)
+;
+; Copyright (C) 2026, D. R. Commander.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+
+%include "jcolsamp.inc"
+
+; --------------------------------------------------------------------------
+;
+; Store eight pixels of interleaved output (ymm8 = pixels 0-3, ymm9 = pixels
+; 4-7) to the address specified by the first argument.  With 3-component
+; pixels, each 128-bit lane holds two pixels in its low 12 bytes, so the lanes
+; are stored with overlapping writes, the last of which writes 4 bytes past the
+; end of the eighth pixel.
+
+%macro STOREPIX 1
+%if RGB_PIXELSIZE == 3
+    vmovdqu     XMMWORD [%1 + 0 * RGB_PIXELSIZE * SIZEOF_J12SAMPLE], xmm8
+    vextracti128 XMMWORD [%1 + 2 * RGB_PIXELSIZE * SIZEOF_J12SAMPLE], ymm8, 1
+    vmovdqu     XMMWORD [%1 + 4 * RGB_PIXELSIZE * SIZEOF_J12SAMPLE], xmm9
+    vextracti128 XMMWORD [%1 + 6 * RGB_PIXELSIZE * SIZEOF_J12SAMPLE], ymm9, 1
+%else
+    vmovdqu     YMMWORD [%1 + 0 * SIZEOF_YMMWORD], ymm8
+    vmovdqu     YMMWORD [%1 + 1 * SIZEOF_YMMWORD], ymm9
+%endif
+%endmacro
+
+; --------------------------------------------------------------------------
+;
+; Convert some rows of samples to the output colorspace.
+;
+; GLOBAL(void)
+; jsimd12_ycc_rgb_convert_avx2(JDIMENSION out_width, J12SAMPIMAGE input_buf,
+;                              JDIMENSION input_row, J12SAMPARRAY output_buf,
+;                              int num_rows)
+;
+; r10d = JDIMENSION out_width
+; r11 = J12SAMPIMAGE input_buf
+; r12d = JDIMENSION input_row
+; r13 = J12SAMPARRAY output_buf
+; r14d = int num_rows
+
+%define wk(i)   r15 - (WK_NUM - (i)) * SIZEOF_YMMWORD  ; ymmword wk[WK_NUM]
+%define WK_NUM  2
+
+    align       32
+    GLOBAL_FUNCTION(jsimd12_ycc_rgb_convert_avx2)
+
+EXTN(jsimd12_ycc_rgb_convert_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    push        r15
+    and         rsp, byte (-SIZEOF_YMMWORD)  ; align to 256 bits
+    ; Allocate stack space for wk array.  r15 is used to access it.
+    mov         r15, rsp
+    sub         rsp, byte (WK_NUM * SIZEOF_YMMWORD)
+    PUSH_XMM    4
+    COLLECT_ARGS 5
+    push        rbx
+
+    mov         ecx, r10d               ; num_cols
+    test        rcx, rcx
+    jz          near .return
+
+    push        rcx
+
+    mov         rdi, r11
+    mov         ecx, r12d
+    mov         rsip, J12SAMPARRAY [rdi + 0 * SIZEOF_J12SAMPARRAY]
+    mov         rbxp, J12SAMPARRAY [rdi + 1 * SIZEOF_J12SAMPARRAY]
+    mov         rdxp, J12SAMPARRAY [rdi + 2 * SIZEOF_J12SAMPARRAY]
+    lea         rsi, [rsi + rcx * SIZEOF_J12SAMPROW]
+    lea         rbx, [rbx + rcx * SIZEOF_J12SAMPROW]
+    lea         rdx, [rdx + rcx * SIZEOF_J12SAMPROW]
+
+    pop         rcx
+
+    mov         rdi, r13
+    mov         eax, r14d
+    test        rax, rax
+    jle         near .return
+.rowloop:
+    push        rax
+    push        rdi
+    push        rdx
+    push        rbx
+    push        rsi
+    push        rcx                     ; col
+
+    mov         rsip, J12SAMPROW [rsi]  ; inptr0
+    mov         rbxp, J12SAMPROW [rbx]  ; inptr1
+    mov         rdxp, J12SAMPROW [rdx]  ; inptr2
+    mov         rdip, J12SAMPROW [rdi]  ; outptr
+.columnloop:
+
+    vpmovzxwd   ymm8, XMMWORD [rsi]     ; ymm8 = Y(01234567)
+    vpmovzxwd   ymm5, XMMWORD [rbx]     ; ymm5 = Cb(01234567)
+    vpmovzxwd   ymm1, XMMWORD [rdx]     ; ymm1 = Cr(01234567)
+
+    vmovdqa     ymm9, [rel PD_CENTERJ12SAMPLE]
+    vpsubd      ymm5, ymm5, ymm9        ; ymm5 = Cb - CENTERJ12SAMPLE
+    vpsubd      ymm1, ymm1, ymm9        ; ymm1 = Cr - CENTERJ12SAMPLE
+
+    ; R = Y                + 1.40200 * Cr
+    ; G = Y - 0.34414 * Cb - 0.71414 * Cr
+    ; B = Y + 1.77200 * Cb
+
+    vmovdqa     ymm9, [rel PD_ONEHALF]
+
+    vpmulld     ymm0, ymm1, [rel PD_F1402]
+    vpmulld     ymm4, ymm5, [rel PD_F1772]
+    vpmulld     ymm2, ymm5, [rel PD_MF0344]
+    vpmulld     ymm3, ymm1, [rel PD_MF0714]
+    vpaddd      ymm2, ymm2, ymm3
+
+    vpaddd      ymm0, ymm0, ymm9
+    vpaddd      ymm4, ymm4, ymm9
+    vpaddd      ymm2, ymm2, ymm9
+    vpsrad      ymm0, ymm0, SCALEBITS   ; ymm0 = FIX(1.402) * Cr
+    vpsrad      ymm4, ymm4, SCALEBITS   ; ymm4 = FIX(1.772) * Cb
+    vpsrad      ymm2, ymm2, SCALEBITS
+                ; ymm2 = -FIX(0.344) * Cb - FIX(0.714) * Cr
+
+    vpaddd      ymm0, ymm0, ymm8        ; ymm0 = R
+    vpaddd      ymm2, ymm2, ymm8        ; ymm2 = G
+    vpaddd      ymm4, ymm4, ymm8        ; ymm4 = B
+
+    vpxor       ymm10, ymm10, ymm10
+    vmovdqa     ymm11, [rel PD_MAXJ12SAMPLE]
+    vpmaxsd     ymm0, ymm0, ymm10
+    vpmaxsd     ymm2, ymm2, ymm10
+    vpmaxsd     ymm4, ymm4, ymm10
+    vpminsd     ymm0, ymm0, ymm11
+    vpminsd     ymm2, ymm2, ymm11
+    vpminsd     ymm4, ymm4, ymm11
+    vmovdqa     ymm6, ymm11             ; ymm6 = X (alpha)
+
+    ; NOTE: The values of RGB_RED, RGB_GREEN, and RGB_BLUE determine the
+    ; mapping of components A, B, C, and D to red, green, and blue.
+    ;
+    ; ymmA = (A0 A1 A2 A3 A4 A5 A6 A7)
+    ; ymmC = (B0 B1 B2 B3 B4 B5 B6 B7)
+    ; ymmE = (C0 C1 C2 C3 C4 C5 C6 C7)
+    ; ymmG = (D0 D1 D2 D3 D4 D5 D6 D7)
+
+    vpslld      ymm8, ymmC, WORD_BIT
+    vpor        ymm8, ymm8, ymmA        ; ymm8 = (A0 B0 A1 B1 .. A7 B7)
+%if RGB_PIXELSIZE == 3
+    vmovdqa     ymm9, ymmE              ; ymm9 = (C0 -- C1 -- .. C7 --)
+%else
+    vpslld      ymm9, ymmG, WORD_BIT
+    vpor        ymm9, ymm9, ymmE        ; ymm9 = (C0 D0 C1 D1 .. C7 D7)
+%endif
+
+    vpunpckldq  ymm10, ymm8, ymm9
+                ; ymm10 = (A0 B0 C0 D0 A1 B1 C1 D1 A4 B4 C4 D4 A5 B5 C5 D5)
+    vpunpckhdq  ymm11, ymm8, ymm9
+                ; ymm11 = (A2 B2 C2 D2 A3 B3 C3 D3 A6 B6 C6 D6 A7 B7 C7 D7)
+    vperm2i128  ymm8, ymm10, ymm11, 0x20
+                ; ymm8 = (A0 B0 C0 D0 A1 B1 C1 D1 A2 B2 C2 D2 A3 B3 C3 D3)
+    vperm2i128  ymm9, ymm10, ymm11, 0x31
+                ; ymm9 = (A4 B4 C4 D4 A5 B5 C5 D5 A6 B6 C6 D6 A7 B7 C7 D7)
+
+%if RGB_PIXELSIZE == 3
+    vpshufb     ymm8, ymm8, [rel PB_SHUF_RGB]
+                ; ymm8 = (A0 B0 C0 A1 B1 C1 -- -- A2 B2 C2 A3 B3 C3 -- --)
+    vpshufb     ymm9, ymm9, [rel PB_SHUF_RGB]
+                ; ymm9 = (A4 B4 C4 A5 B5 C5 -- -- A6 B6 C6 A7 B7 C7 -- --)
+
+    cmp         rcx, byte SIZEOF_XMMWORD / SIZEOF_J12SAMPLE
+    jbe         short .column_st
+%else
+    cmp         rcx, byte SIZEOF_XMMWORD / SIZEOF_J12SAMPLE
+    jb          short .column_st
+%endif
+
+    STOREPIX    rdi
+
+    add         rdi, RGB_PIXELSIZE * SIZEOF_XMMWORD  ; outptr
+    sub         rcx, byte SIZEOF_XMMWORD / SIZEOF_J12SAMPLE
+    jz          short .nextrow
+
+    add         rsi, byte SIZEOF_XMMWORD  ; inptr0
+    add         rbx, byte SIZEOF_XMMWORD  ; inptr1
+    add         rdx, byte SIZEOF_XMMWORD  ; inptr2
+    jmp         near .columnloop
+
+.column_st:
+    ; -- Store the last (partial) group of pixels into the wk array, and copy
+    ;    only the remaining pixels to the output row, so that nothing is
+    ;    written past the end of the row.
+
+    lea         rsi, [wk(0)]
+    STOREPIX    rsi
+%if RGB_PIXELSIZE == 3
+    lea         rcx, [rcx + rcx * 2]    ; imul rcx, RGB_PIXELSIZE
+%else
+    shl         rcx, 2                  ; imul rcx, RGB_PIXELSIZE
+%endif
+    shl         rcx, 1                  ; imul rcx, SIZEOF_J12SAMPLE
+    cld
+    rep movsb
+
+.nextrow:
+    pop         rcx
+    pop         rsi
+    pop         rbx
+    pop         rdx
+    pop         rdi
+    pop         rax
+
+    add         rsi, byte SIZEOF_J12SAMPROW
+    add         rbx, byte SIZEOF_J12SAMPROW
+    add         rdx, byte SIZEOF_J12SAMPROW
+    add         rdi, byte SIZEOF_J12SAMPROW  ; output_buf
+    dec         rax                          ; num_rows
+    jg          near .rowloop
+
+.return:
+    pop         rbx
+    vzeroupper
+    UNCOLLECT_ARGS 5
+    POP_XMM     4
+    lea         rsp, [rbp - 8]
+    pop         r15
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
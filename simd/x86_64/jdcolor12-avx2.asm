@@ -0,0 +1,118 @@
+;
+; YCbCr-to-RGB Color Conversion (64-bit AVX2, 12-bit samples)
+;
+; Copyright (C) 2026, D. R. Commander.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+
+%include "jsimdext.inc"
+
+; --------------------------------------------------------------------------
+
+%define SCALEBITS  16
+
+F_0_344 equ  22554              ; FIX(0.34414)
+F_0_714 equ  46802              ; FIX(0.71414)
+F_1_402 equ  91881              ; FIX(1.40200)
+F_1_772 equ 116130              ; FIX(1.77200)
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      32
+    GLOBAL_DATA(jconst12_ycc_rgb_convert_avx2)
+
+EXTN(jconst12_ycc_rgb_convert_avx2):
+
+PD_F1402           times 8 dd  F_1_402
+PD_F1772           times 8 dd  F_1_772
+PD_MF0344          times 8 dd -F_0_344
+PD_MF0714          times 8 dd -F_0_714
+PD_ONEHALF         times 8 dd  1 << (SCALEBITS - 1)
+PD_CENTERJ12SAMPLE times 8 dd  CENTERJ12SAMPLE
+PD_MAXJ12SAMPLE    times 8 dd  MAXJ12SAMPLE
+
+; Shuffle mask that removes the fourth component from two 4-component pixels
+; in each 128-bit lane, leaving two 3-component pixels in the low 12 bytes.
+PB_SHUF_RGB        db  0,  1,  2,  3,  4,  5,  8,  9, 10, 11, 12, 13
+                   db -1, -1, -1, -1
+                   db  0,  1,  2,  3,  4,  5,  8,  9, 10, 11, 12, 13
+                   db -1, -1, -1, -1
+
+    ALIGNZ      32
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+%include "jdcolext12-avx2.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_RGB_RED
+%define RGB_GREEN  EXT_RGB_GREEN
+%define RGB_BLUE  EXT_RGB_BLUE
+%define RGB_PIXELSIZE  EXT_RGB_PIXELSIZE
+%define jsimd12_ycc_rgb_convert_avx2  jsimd12_ycc_extrgb_convert_avx2
+%include "jdcolext12-avx2.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_RGBX_RED
+%define RGB_GREEN  EXT_RGBX_GREEN
+%define RGB_BLUE  EXT_RGBX_BLUE
+%define RGB_PIXELSIZE  EXT_RGBX_PIXELSIZE
+%define jsimd12_ycc_rgb_convert_avx2  jsimd12_ycc_extrgbx_convert_avx2
+%include "jdcolext12-avx2.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_BGR_RED
+%define RGB_GREEN  EXT_BGR_GREEN
+%define RGB_BLUE  EXT_BGR_BLUE
+%define RGB_PIXELSIZE  EXT_BGR_PIXELSIZE
+%define jsimd12_ycc_rgb_convert_avx2  jsimd12_ycc_extbgr_convert_avx2
+%include "jdcolext12-avx2.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_BGRX_RED
+%define RGB_GREEN  EXT_BGRX_GREEN
+%define RGB_BLUE  EXT_BGRX_BLUE
+%define RGB_PIXELSIZE  EXT_BGRX_PIXELSIZE
+%define jsimd12_ycc_rgb_convert_avx2  jsimd12_ycc_extbgrx_convert_avx2
+%include "jdcolext12-avx2.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_XBGR_RED
+%define RGB_GREEN  EXT_XBGR_GREEN
+%define RGB_BLUE  EXT_XBGR_BLUE
+%define RGB_PIXELSIZE  EXT_XBGR_PIXELSIZE
+%define jsimd12_ycc_rgb_convert_avx2  jsimd12_ycc_extxbgr_convert_avx2
+%include "jdcolext12-avx2.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_XRGB_RED
+%define RGB_GREEN  EXT_XRGB_GREEN
+%define RGB_BLUE  EXT_XRGB_BLUE
+%define RGB_PIXELSIZE  EXT_XRGB_PIXELSIZE
+%define jsimd12_ycc_rgb_convert_avx2  jsimd12_ycc_extxrgb_convert_avx2
+%include "jdcolext12-avx2.asm"
@@ -0,0 +1,154 @@
+;
+; Lossless JPEG Sample Undifferencing (64-bit AVX2)
+;
+; Copyright (C) 2026, D. R. Commander.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+;
+; The undifferencers in this file process eight samples at a time, using
+; 32-bit lanes.  Since the reconstructed samples are calculated modulo 2^16,
+; predictors 1, 4, and 5 can be expressed as prefix sums:
+;
+;   Predictor 1:  Ra[i] = initial + sum(diff[0..i])
+;   Predictor 4:  Ra[i] = sum(diff[0..i]) + Rb[i]
+;   Predictor 5:  Ra[i] = initial + sum(diff[0..i] + ((Rb - Rc)[0..i] >> 1))
+;
+; (For the first column, Rc is the initial predictor, which is equal to Rb.)
+; Predictors 6 and 7 do not have such a formulation, so they are not
+; implemented here.
+
+%include "jsimdext.inc"
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      32
+    GLOBAL_DATA(jconst_undifference_avx2)
+
+EXTN(jconst_undifference_avx2):
+
+PD_ROTATE       dd 7, 0, 1, 2, 3, 4, 5, 6
+PD_FFFF         times 8 dd 0xFFFF
+
+    ALIGNZ      32
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+;
+; Undifference a row of samples.
+;
+; GLOBAL(void)
+; jsimd_undifference<psv>_avx2(JDIFFROW diff_buf, JDIFFROW prev_row,
+;                              JDIFFROW undiff_buf, JDIMENSION width,
+;                              int initial_predictor)
+;
+; %1 = function name
+; %2 = predictor selection value (1-5)
+;
+; r10 = JDIFFROW diff_buf
+; r11 = JDIFFROW prev_row
+; r12 = JDIFFROW undiff_buf
+; r13d = JDIMENSION width
+; r14d = int initial_predictor
+;
+; NOTE: prev_row and undiff_buf may point to the same storage area, so each
+; group of eight Rb values is loaded before the corresponding group of
+; reconstructed samples is stored.
+
+%macro UNDIFFERENCE 2
+    align       32
+    GLOBAL_FUNCTION(%1)
+
+EXTN(%1):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 5
+
+    mov         ecx, r13d               ; width
+    test        rcx, rcx
+    jz          near %%return
+
+    mov         rsi, r10                ; diff_buf
+    mov         rdi, r11                ; prev_row
+    mov         rdx, r12                ; undiff_buf
+
+    vmovdqa     ymm5, [rel PD_ROTATE]
+    vmovdqa     ymm4, [rel PD_FFFF]
+%if %2 == 4
+    vpxor       ymm6, ymm6, ymm6        ; ymm6 = running sum
+%else
+    vmovd       xmm6, r14d
+    vpbroadcastd ymm6, xmm6             ; ymm6 = running sum
+%endif
+    vmovd       xmm7, r14d              ; ymm7 = (initial -- -- -- ...)
+
+%%columnloop:
+    vmovdqu     ymm0, YMMWORD [rsi]     ; ymm0 = diff
+%if %2 != 1
+    vmovdqu     ymm1, YMMWORD [rdi]     ; ymm1 = Rb
+%endif
+
+%if %2 == 2
+    vpaddd      ymm0, ymm0, ymm1        ; diff + Rb
+%elif %2 == 3
+    vpermd      ymm2, ymm5, ymm1
+    vpblendd    ymm3, ymm2, ymm7, 0x01  ; ymm3 = Rc
+    vmovdqa     ymm7, ymm2
+    vpaddd      ymm0, ymm0, ymm3        ; diff + Rc
+%else
+%if %2 == 5
+    vpermd      ymm2, ymm5, ymm1
+    vpblendd    ymm3, ymm2, ymm7, 0x01  ; ymm3 = Rc
+    vmovdqa     ymm7, ymm2
+    vpsubd      ymm3, ymm1, ymm3
+    vpsrad      ymm3, ymm3, 1
+    vpaddd      ymm0, ymm0, ymm3        ; ymm0 = diff + ((Rb - Rc) >> 1)
+%endif
+    ; Compute the prefix sum of ymm0, and add the running sum.
+    vpslldq     ymm2, ymm0, 4
+    vpaddd      ymm0, ymm0, ymm2
+    vpslldq     ymm2, ymm0, 8
+    vpaddd      ymm0, ymm0, ymm2
+    vpshufd     ymm2, ymm0, 0xFF
+    vperm2i128  ymm2, ymm2, ymm2, 0x08
+    vpaddd      ymm0, ymm0, ymm2
+    vpaddd      ymm0, ymm0, ymm6
+    vpshufd     ymm6, ymm0, 0xFF
+    vperm2i128  ymm6, ymm6, ymm6, 0x11
+%if %2 == 4
+    vpaddd      ymm0, ymm0, ymm1        ; sum(diff) + Rb
+%endif
+%endif
+
+    vpand       ymm0, ymm0, ymm4
+    vmovdqu     YMMWORD [rdx], ymm0
+
+    add         rsi, byte SIZEOF_YMMWORD
+    add         rdi, byte SIZEOF_YMMWORD
+    add         rdx, byte SIZEOF_YMMWORD
+    sub         rcx, byte 8
+    jg          near %%columnloop
+
+%%return:
+    vzeroupper
+    UNCOLLECT_ARGS 5
+    pop         rbp
+    ret
+%endmacro
+
+    UNDIFFERENCE jsimd_undifference1_avx2, 1
+    UNDIFFERENCE jsimd_undifference2_avx2, 2
+    UNDIFFERENCE jsimd_undifference3_avx2, 3
+    UNDIFFERENCE jsimd_undifference4_avx2, 4
+    UNDIFFERENCE jsimd_undifference5_avx2, 5
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
@@ -0,0 +1,166 @@
+;
+; Merged Upsampling/Color Conversion (64-bit AVX-512)
+;
+; Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
+; Copyright (C) 2009, 2016, 2024, 2026, D. R. Commander.
+; Copyright (C) 2015, Intel Corporation.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler).  Yasm does not
+; support AVX-512 instructions.
+
+%include "jsimdext.inc"
+
+; --------------------------------------------------------------------------
+
+%define SCALEBITS  16
+
+F_0_344 equ  22554              ; FIX(0.34414)
+F_0_714 equ  46802              ; FIX(0.71414)
+F_1_402 equ  91881              ; FIX(1.40200)
+F_1_772 equ 116130              ; FIX(1.77200)
+F_0_402 equ (F_1_402 - 65536)   ; FIX(1.40200) - FIX(1)
+F_0_285 equ ( 65536 - F_0_714)  ; FIX(1) - FIX(0.71414)
+F_0_228 equ (131072 - F_1_772)  ; FIX(2) - FIX(1.77200)
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      64
+    GLOBAL_DATA(jconst_merged_upsample_avx512)
+
+EXTN(jconst_merged_upsample_avx512):
+
+PW_F0402        times 32 dw  F_0_402
+PW_MF0228       times 32 dw -F_0_228
+PW_MF0344_F0285 times 16 dw -F_0_344, F_0_285
+PW_ONE          times 32 dw  1
+PD_ONEHALF      times 16 dd  1 << (SCALEBITS - 1)
+
+; Byte indices, used to generate the masks for partial stores
+PB_INDEX        db   0,  1,  2,  3,  4,  5,  6,  7
+                db   8,  9, 10, 11, 12, 13, 14, 15
+                db  16, 17, 18, 19, 20, 21, 22, 23
+                db  24, 25, 26, 27, 28, 29, 30, 31
+                db  32, 33, 34, 35, 36, 37, 38, 39
+                db  40, 41, 42, 43, 44, 45, 46, 47
+                db  48, 49, 50, 51, 52, 53, 54, 55
+                db  56, 57, 58, 59, 60, 61, 62, 63
+
+; vpshufb control that interleaves the even and odd samples in each 128-bit
+; lane after vpackuswb
+PB_INTERLEAVE   db   0,  8,  1,  9,  2, 10,  3, 11
+                db   4, 12,  5, 13,  6, 14,  7, 15
+
+; vpermd indices that distribute the samples across the 128-bit lanes such
+; that vpunpck[lh]bw and vpunpck[lh]wd produce pixels in their natural order
+PB_TRANSPOSE    db   0,  4,  8, 12,  1,  5,  9, 13
+                db   2,  6, 10, 14,  3,  7, 11, 15
+
+; vpshufb control that removes the fourth byte of each 4-byte pixel
+PB_COMPRESS_RGB db   0,  1,  2,  4,  5,  6,  8,  9
+                db  10, 12, 13, 14, -1, -1, -1, -1
+
+; vpermt2d indices that pack 64 3-byte pixels (12 bytes per 128-bit lane) into
+; three registers
+PB_PACK_RGB     db   0,  1,  2,  4,  5,  6,  8,  9
+                db  10, 12, 13, 14, 16, 17, 18, 20
+                db   5,  6,  8,  9, 10, 12, 13, 14
+                db  16, 17, 18, 20, 21, 22, 24, 25
+                db  10, 12, 13, 14, 16, 17, 18, 20
+                db  21, 22, 24, 25, 26, 28, 29, 30
+
+    ALIGNZ      64
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+%include "jdmrgext-avx512.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_RGB_RED
+%define RGB_GREEN  EXT_RGB_GREEN
+%define RGB_BLUE  EXT_RGB_BLUE
+%define RGB_PIXELSIZE  EXT_RGB_PIXELSIZE
+%define jsimd_h2v1_merged_upsample_avx512 \
+  jsimd_h2v1_extrgb_merged_upsample_avx512
+%define jsimd_h2v2_merged_upsample_avx512 \
+  jsimd_h2v2_extrgb_merged_upsample_avx512
+%include "jdmrgext-avx512.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_RGBX_RED
+%define RGB_GREEN  EXT_RGBX_GREEN
+%define RGB_BLUE  EXT_RGBX_BLUE
+%define RGB_PIXELSIZE  EXT_RGBX_PIXELSIZE
+%define jsimd_h2v1_merged_upsample_avx512 \
+  jsimd_h2v1_extrgbx_merged_upsample_avx512
+%define jsimd_h2v2_merged_upsample_avx512 \
+  jsimd_h2v2_extrgbx_merged_upsample_avx512
+%include "jdmrgext-avx512.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_BGR_RED
+%define RGB_GREEN  EXT_BGR_GREEN
+%define RGB_BLUE  EXT_BGR_BLUE
+%define RGB_PIXELSIZE  EXT_BGR_PIXELSIZE
+%define jsimd_h2v1_merged_upsample_avx512 \
+  jsimd_h2v1_extbgr_merged_upsample_avx512
+%define jsimd_h2v2_merged_upsample_avx512 \
+  jsimd_h2v2_extbgr_merged_upsample_avx512
+%include "jdmrgext-avx512.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_BGRX_RED
+%define RGB_GREEN  EXT_BGRX_GREEN
+%define RGB_BLUE  EXT_BGRX_BLUE
+%define RGB_PIXELSIZE  EXT_BGRX_PIXELSIZE
+%define jsimd_h2v1_merged_upsample_avx512 \
+  jsimd_h2v1_extbgrx_merged_upsample_avx512
+%define jsimd_h2v2_merged_upsample_avx512 \
+  jsimd_h2v2_extbgrx_merged_upsample_avx512
+%include "jdmrgext-avx512.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_XBGR_RED
+%define RGB_GREEN  EXT_XBGR_GREEN
+%define RGB_BLUE  EXT_XBGR_BLUE
+%define RGB_PIXELSIZE  EXT_XBGR_PIXELSIZE
+%define jsimd_h2v1_merged_upsample_avx512 \
+  jsimd_h2v1_extxbgr_merged_upsample_avx512
+%define jsimd_h2v2_merged_upsample_avx512 \
+  jsimd_h2v2_extxbgr_merged_upsample_avx512
+%include "jdmrgext-avx512.asm"
+
+%undef RGB_RED
+%undef RGB_GREEN
+%undef RGB_BLUE
+%undef RGB_PIXELSIZE
+%define RGB_RED  EXT_XRGB_RED
+%define RGB_GREEN  EXT_XRGB_GREEN
+%define RGB_BLUE  EXT_XRGB_BLUE
+%define RGB_PIXELSIZE  EXT_XRGB_PIXELSIZE
+%define jsimd_h2v1_merged_upsample_avx512 \
+  jsimd_h2v1_extxrgb_merged_upsample_avx512
+%define jsimd_h2v2_merged_upsample_avx512 \
+  jsimd_h2v2_extxrgb_merged_upsample_avx512
+%include "jdmrgext-avx512.asm"
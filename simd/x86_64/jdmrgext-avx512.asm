@@ -0,0 +1,380 @@
+;
+; Merged Upsampling/Color Conversion (64-bit AVX-512)
+;
+; Copyright 2009, 2012 Pierre Ossman <ossman@cendio.se> for Cendio AB
+; Copyright (C) 2009, 2012, 2016, 2024-2026, D. R. Commander.
+; Copyright (C) 2015, Intel Corporation.
+; Copyright (C) 2018, Matthias Räncker.
+; Copyright (C) 2023, Aliaksiej Kandracienka.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler).  Yasm does not
+; support AVX-512 instructions.
+
+%include "jcolsamp.inc"
+
+; --------------------------------------------------------------------------
+;
+; Upsample and color convert for the case of 2:1 horizontal and 1:1 vertical.
+;
+; Each iteration of the column loop converts 32 chroma samples and 64 luma
+; samples.  The final (partial) group of pixels in each row is written using
+; masked stores, so no bytes beyond the end of the output row are modified.
+;
+; GLOBAL(void)
+; jsimd_h2v1_merged_upsample_avx512(JDIMENSION output_width,
+;                                   JSAMPIMAGE input_buf,
+;                                   JDIMENSION in_row_group_ctr,
+;                                   JSAMPARRAY output_buf)
+;
+; r10d = JDIMENSION output_width
+; r11 = JSAMPIMAGE input_buf
+; r12d = JDIMENSION in_row_group_ctr
+; r13 = JSAMPARRAY output_buf
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_h2v1_merged_upsample_avx512)
+
+EXTN(jsimd_h2v1_merged_upsample_avx512):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 4
+    push        rbx
+
+    mov         ecx, r10d               ; col
+    test        rcx, rcx
+    jz          near .return
+
+    push        rcx
+
+    mov         rdi, r11
+    mov         ecx, r12d
+    mov         rsip, JSAMPARRAY [rdi + 0 * SIZEOF_JSAMPARRAY]
+    mov         rbxp, JSAMPARRAY [rdi + 1 * SIZEOF_JSAMPARRAY]
+    mov         rdxp, JSAMPARRAY [rdi + 2 * SIZEOF_JSAMPARRAY]
+    mov         rdi, r13
+    mov         rsip, JSAMPROW [rsi + rcx * SIZEOF_JSAMPROW]  ; inptr0
+    mov         rbxp, JSAMPROW [rbx + rcx * SIZEOF_JSAMPROW]  ; inptr1
+    mov         rdxp, JSAMPROW [rdx + rcx * SIZEOF_JSAMPROW]  ; inptr2
+    mov         rdip, JSAMPROW [rdi]                          ; outptr
+
+    pop         rcx                     ; col
+
+    vpternlogd  zmm24, zmm24, zmm24, 0xFF
+    vpsllw      zmm25, zmm24, 7     ; zmm25 = { 0xFF80 0xFF80 0xFF80 0xFF80 .. }
+    vpsrlw      zmm24, zmm24, BYTE_BIT  ; zmm24 = { 0xFF 0x00 0xFF 0x00 .. }
+    vbroadcasti32x4 zmm26, [rel PB_INTERLEAVE]
+    vpmovzxbd   zmm27, [rel PB_TRANSPOSE]
+%if RGB_PIXELSIZE == 3
+    vbroadcasti32x4 zmm28, [rel PB_COMPRESS_RGB]
+    vpmovzxbd   zmm29, [rel PB_PACK_RGB + 0 * SIZEOF_XMMWORD]
+    vpmovzxbd   zmm30, [rel PB_PACK_RGB + 1 * SIZEOF_XMMWORD]
+    vpmovzxbd   zmm31, [rel PB_PACK_RGB + 2 * SIZEOF_XMMWORD]
+%endif
+
+.columnloop:
+
+    vpmovzxbw   zmm2, YMMWORD [rbx]     ; zmm2 = Cb(0..31)
+    vpmovzxbw   zmm3, YMMWORD [rdx]     ; zmm3 = Cr(0..31)
+
+    vpaddw      zmm2, zmm2, zmm25
+    vpaddw      zmm3, zmm3, zmm25
+
+    ; (Original)
+    ; R = Y                + 1.40200 * Cr
+    ; G = Y - 0.34414 * Cb - 0.71414 * Cr
+    ; B = Y + 1.77200 * Cb
+    ;
+    ; (This implementation)
+    ; R = Y                + 0.40200 * Cr + Cr
+    ; G = Y - 0.34414 * Cb + 0.28586 * Cr - Cr
+    ; B = Y - 0.22800 * Cb + Cb + Cb
+
+    vpaddw      zmm4, zmm2, zmm2        ; zmm4 = 2 * Cb
+    vpaddw      zmm0, zmm3, zmm3        ; zmm0 = 2 * Cr
+
+    vpmulhw     zmm4, zmm4, [rel PW_MF0228]  ; zmm4 = (2 * Cb * -FIX(0.22800))
+    vpmulhw     zmm0, zmm0, [rel PW_F0402]   ; zmm0 = (2 * Cr * FIX(0.40200))
+
+    vpaddw      zmm4, zmm4, [rel PW_ONE]
+    vpsraw      zmm4, zmm4, 1           ; zmm4 = (Cb * -FIX(0.22800))
+    vpaddw      zmm0, zmm0, [rel PW_ONE]
+    vpsraw      zmm0, zmm0, 1           ; zmm0 = (Cr * FIX(0.40200))
+
+    vpaddw      zmm4, zmm4, zmm2
+    vpaddw      zmm16, zmm4, zmm2       ; zmm16 = (Cb * FIX(1.77200)) = (B - Y)
+    vpaddw      zmm17, zmm0, zmm3       ; zmm17 = (Cr * FIX(1.40200)) = (R - Y)
+
+    vpunpckhwd  zmm5, zmm2, zmm3
+    vpunpcklwd  zmm2, zmm2, zmm3
+    vpmaddwd    zmm2, zmm2, [rel PW_MF0344_F0285]
+    vpmaddwd    zmm5, zmm5, [rel PW_MF0344_F0285]
+
+    vpaddd      zmm2, zmm2, [rel PD_ONEHALF]
+    vpaddd      zmm5, zmm5, [rel PD_ONEHALF]
+    vpsrad      zmm2, zmm2, SCALEBITS
+    vpsrad      zmm5, zmm5, SCALEBITS
+
+    vpackssdw   zmm2, zmm2, zmm5
+                ; zmm2 = Cb * -FIX(0.344) + Cr * FIX(0.285)
+    vpsubw      zmm18, zmm2, zmm3
+                ; zmm18 = Cb * -FIX(0.344) + Cr * -FIX(0.714) = (G - Y)
+
+    vmovdqu64   zmm7, ZMMWORD [rsi]     ; zmm7 = Y(0..63)
+
+    vpandq      zmm6, zmm24, zmm7       ; zmm6 = Y(0 2 4 .. 62) = YE
+    vpsrlw      zmm7, zmm7, BYTE_BIT    ; zmm7 = Y(1 3 5 .. 63) = YO
+
+    vpaddw      zmm0, zmm17, zmm6       ; zmm0 = ((R - Y) + YE) = RE
+    vpaddw      zmm1, zmm17, zmm7       ; zmm1 = ((R - Y) + YO) = RO
+    vpackuswb   zmm0, zmm0, zmm1
+
+    vpaddw      zmm2, zmm18, zmm6       ; zmm2 = ((G - Y) + YE) = GE
+    vpaddw      zmm3, zmm18, zmm7       ; zmm3 = ((G - Y) + YO) = GO
+    vpackuswb   zmm2, zmm2, zmm3
+
+    vpaddw      zmm4, zmm16, zmm6       ; zmm4 = ((B - Y) + YE) = BE
+    vpaddw      zmm5, zmm16, zmm7       ; zmm5 = ((B - Y) + YO) = BO
+    vpackuswb   zmm4, zmm4, zmm5
+
+    ; Each 128-bit lane of zmm0, zmm2, and zmm4 now contains the even samples
+    ; from the corresponding lane of the input, followed by the odd samples.
+    ; Restore the natural order of the samples within each lane, and then
+    ; distribute them such that lane i contains samples 4i-4i+3,
+    ; 4i+16-4i+19, 4i+32-4i+35, and 4i+48-4i+51.
+
+    vpshufb     zmm0, zmm0, zmm26
+    vpshufb     zmm2, zmm2, zmm26
+    vpshufb     zmm4, zmm4, zmm26
+    vpermd      zmm0, zmm27, zmm0       ; zmm0 = R
+    vpermd      zmm2, zmm27, zmm2       ; zmm2 = G
+    vpermd      zmm4, zmm27, zmm4       ; zmm4 = B
+
+%if RGB_PIXELSIZE == 4
+%ifdef RGBX_FILLER_0XFF
+    vpternlogd  zmm6, zmm6, zmm6, 0xFF  ; zmm6 = X
+%else
+    vpxord      zmm6, zmm6, zmm6        ; zmm6 = X
+%endif
+%endif
+
+    ; NOTE: The values of RGB_RED, RGB_GREEN, and RGB_BLUE determine the
+    ; mapping of components A, B, C, and D to red, green, and blue.  (If
+    ; RGB_PIXELSIZE == 3, then component D is discarded.)
+    ;
+    ; zmmA = A, zmmC = B, zmmE = C, zmmG = D
+
+    vpunpckhbw  zmmB, zmmA, zmmC
+    vpunpcklbw  zmmA, zmmA, zmmC
+    vpunpckhbw  zmmF, zmmE, zmmG
+    vpunpcklbw  zmmE, zmmE, zmmG
+
+    vpunpckhwd  zmmC, zmmA, zmmE        ; zmmC = (ABCD16 ABCD17 .. ABCD31)
+    vpunpcklwd  zmmA, zmmA, zmmE        ; zmmA = (ABCD0 ABCD1 .. ABCD15)
+    vpunpckhwd  zmmD, zmmB, zmmF        ; zmmD = (ABCD48 ABCD49 .. ABCD63)
+    vpunpcklwd  zmmB, zmmB, zmmF        ; zmmB = (ABCD32 ABCD33 .. ABCD47)
+
+%if RGB_PIXELSIZE == 3  ; ---------------
+
+    vpshufb     zmmA, zmmA, zmm28
+    vpshufb     zmmC, zmmC, zmm28
+    vpshufb     zmmB, zmmB, zmm28
+    vpshufb     zmmD, zmmD, zmm28
+    vpermt2d    zmmA, zmm29, zmmC       ; zmmA = (ABC0 ABC1 .. ABC20 AB21)
+    vpermt2d    zmmC, zmm30, zmmB       ; zmmC = (C21 ABC22 .. ABC41 A42)
+    vpermt2d    zmmB, zmm31, zmmD       ; zmmB = (BC42 ABC43 .. ABC63)
+
+    cmp         rcx, byte SIZEOF_ZMMWORD
+    jb          near .column_st
+
+    test        rdi, SIZEOF_ZMMWORD - 1
+    jnz         short .out1
+    ; --(aligned)-------------------
+    vmovntdq    ZMMWORD [rdi + 0 * SIZEOF_ZMMWORD], zmmA
+    vmovntdq    ZMMWORD [rdi + 1 * SIZEOF_ZMMWORD], zmmC
+    vmovntdq    ZMMWORD [rdi + 2 * SIZEOF_ZMMWORD], zmmB
+    jmp         short .out0
+.out1:  ; --(unaligned)-----------------
+    vmovdqu64   ZMMWORD [rdi + 0 * SIZEOF_ZMMWORD], zmmA
+    vmovdqu64   ZMMWORD [rdi + 1 * SIZEOF_ZMMWORD], zmmC
+    vmovdqu64   ZMMWORD [rdi + 2 * SIZEOF_ZMMWORD], zmmB
+
+%else  ; RGB_PIXELSIZE == 4 ; -----------
+
+    cmp         rcx, byte SIZEOF_ZMMWORD
+    jb          near .column_st
+
+    test        rdi, SIZEOF_ZMMWORD - 1
+    jnz         short .out1
+    ; --(aligned)-------------------
+    vmovntdq    ZMMWORD [rdi + 0 * SIZEOF_ZMMWORD], zmmA
+    vmovntdq    ZMMWORD [rdi + 1 * SIZEOF_ZMMWORD], zmmC
+    vmovntdq    ZMMWORD [rdi + 2 * SIZEOF_ZMMWORD], zmmB
+    vmovntdq    ZMMWORD [rdi + 3 * SIZEOF_ZMMWORD], zmmD
+    jmp         short .out0
+.out1:  ; --(unaligned)-----------------
+    vmovdqu64   ZMMWORD [rdi + 0 * SIZEOF_ZMMWORD], zmmA
+    vmovdqu64   ZMMWORD [rdi + 1 * SIZEOF_ZMMWORD], zmmC
+    vmovdqu64   ZMMWORD [rdi + 2 * SIZEOF_ZMMWORD], zmmB
+    vmovdqu64   ZMMWORD [rdi + 3 * SIZEOF_ZMMWORD], zmmD
+
+%endif  ; RGB_PIXELSIZE ; ---------------
+
+.out0:
+    add         rdi, RGB_PIXELSIZE * SIZEOF_ZMMWORD  ; outptr
+    sub         rcx, byte SIZEOF_ZMMWORD
+    jz          near .endcolumn
+
+    add         rsi, byte SIZEOF_ZMMWORD  ; inptr0
+    add         rbx, byte SIZEOF_YMMWORD  ; inptr1
+    add         rdx, byte SIZEOF_YMMWORD  ; inptr2
+    jmp         near .columnloop
+
+.column_st:
+    ; Generate the store masks k1-k3 (k1-k4 if RGB_PIXELSIZE == 4) for the
+    ; remaining pixels.
+    imul        r8d, ecx, RGB_PIXELSIZE
+    vpbroadcastb zmm16, r8d
+    mov         r9d, SIZEOF_ZMMWORD
+    vpbroadcastb zmm17, r9d
+    vmovdqa64   zmm18, ZMMWORD [rel PB_INDEX]
+    vpcmpub     k1, zmm16, zmm18, 6     ; k1 = (zmm16 > index)
+    vpsubusb    zmm16, zmm16, zmm17
+    vpcmpub     k2, zmm16, zmm18, 6
+    vpsubusb    zmm16, zmm16, zmm17
+    vpcmpub     k3, zmm16, zmm18, 6
+%if RGB_PIXELSIZE == 4
+    vpsubusb    zmm16, zmm16, zmm17
+    vpcmpub     k4, zmm16, zmm18, 6
+%endif
+
+    vmovdqu8    ZMMWORD [rdi + 0 * SIZEOF_ZMMWORD]{k1}, zmmA
+    vmovdqu8    ZMMWORD [rdi + 1 * SIZEOF_ZMMWORD]{k2}, zmmC
+    vmovdqu8    ZMMWORD [rdi + 2 * SIZEOF_ZMMWORD]{k3}, zmmB
+%if RGB_PIXELSIZE == 4
+    vmovdqu8    ZMMWORD [rdi + 3 * SIZEOF_ZMMWORD]{k4}, zmmD
+%endif
+
+.endcolumn:
+    sfence                              ; flush the write buffer
+
+.return:
+    pop         rbx
+    vzeroupper
+    UNCOLLECT_ARGS 4
+    pop         rbp
+    ret
+
+
+; --------------------------------------------------------------------------
+;
+; Upsample and color convert for the case of 2:1 horizontal and 2:1 vertical.
+;
+; GLOBAL(void)
+; jsimd_h2v2_merged_upsample_avx512(JDIMENSION output_width,
+;                                   JSAMPIMAGE input_buf,
+;                                   JDIMENSION in_row_group_ctr,
+;                                   JSAMPARRAY output_buf)
+;
+; r10d = JDIMENSION output_width
+; r11 = JSAMPIMAGE input_buf
+; r12d = JDIMENSION in_row_group_ctr
+; r13 = JSAMPARRAY output_buf
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_h2v2_merged_upsample_avx512)
+
+EXTN(jsimd_h2v2_merged_upsample_avx512):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 4
+    push        rbx
+
+    mov         eax, r10d
+
+    mov         rdi, r11
+    mov         ecx, r12d
+    mov         rsip, JSAMPARRAY [rdi + 0 * SIZEOF_JSAMPARRAY]
+    mov         rbxp, JSAMPARRAY [rdi + 1 * SIZEOF_JSAMPARRAY]
+    mov         rdxp, JSAMPARRAY [rdi + 2 * SIZEOF_JSAMPARRAY]
+    mov         rdi, r13
+    lea         rsi, [rsi + rcx * SIZEOF_JSAMPROW]
+
+    sub         rsp, SIZEOF_JSAMPARRAY * 4
+    mov         JSAMPARRAY [rsp + 0 * SIZEOF_JSAMPARRAY], rsip  ; intpr00
+    mov         JSAMPARRAY [rsp + 1 * SIZEOF_JSAMPARRAY], rbxp  ; intpr1
+    mov         JSAMPARRAY [rsp + 2 * SIZEOF_JSAMPARRAY], rdxp  ; intpr2
+    mov         rbx, rsp
+
+    push        rdi
+    push        rcx
+    push        rax
+
+    %ifdef WIN64
+    mov         r8, rcx
+    mov         r9, rdi
+    mov         rcx, rax
+    mov         rdx, rbx
+    %else
+    mov         rdx, rcx
+    mov         rcx, rdi
+    mov         rdi, rax
+    mov         rsi, rbx
+    %endif
+
+    call        EXTN(jsimd_h2v1_merged_upsample_avx512)
+
+    pop         rax
+    pop         rcx
+    pop         rdi
+    mov         rsip, JSAMPARRAY [rsp + 0 * SIZEOF_JSAMPARRAY]
+    mov         rbxp, JSAMPARRAY [rsp + 1 * SIZEOF_JSAMPARRAY]
+    mov         rdxp, JSAMPARRAY [rsp + 2 * SIZEOF_JSAMPARRAY]
+
+    add         rdi, byte SIZEOF_JSAMPROW  ; outptr1
+    add         rsi, byte SIZEOF_JSAMPROW  ; inptr01
+
+    mov         JSAMPARRAY [rsp + 0 * SIZEOF_JSAMPARRAY], rsip  ; intpr00
+    mov         JSAMPARRAY [rsp + 1 * SIZEOF_JSAMPARRAY], rbxp  ; intpr1
+    mov         JSAMPARRAY [rsp + 2 * SIZEOF_JSAMPARRAY], rdxp  ; intpr2
+    mov         rbx, rsp
+
+    push        rdi
+    push        rcx
+    push        rax
+
+    %ifdef WIN64
+    mov         r8, rcx
+    mov         r9, rdi
+    mov         rcx, rax
+    mov         rdx, rbx
+    %else
+    mov         rdx, rcx
+    mov         rcx, rdi
+    mov         rdi, rax
+    mov         rsi, rbx
+    %endif
+
+    call        EXTN(jsimd_h2v1_merged_upsample_avx512)
+
+    pop         rax
+    pop         rcx
+    pop         rdi
+    mov         rsip, JSAMPARRAY [rsp + 0 * SIZEOF_JSAMPARRAY]
+    mov         rbxp, JSAMPARRAY [rsp + 1 * SIZEOF_JSAMPARRAY]
+    mov         rdxp, JSAMPARRAY [rsp + 2 * SIZEOF_JSAMPARRAY]
+    add         rsp, SIZEOF_JSAMPARRAY * 4
+
+    pop         rbx
+    UNCOLLECT_ARGS 4
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
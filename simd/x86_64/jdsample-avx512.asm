@@ -0,0 +1,363 @@
+;
+; Upsampling (64-bit AVX-512)
+;
+; Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
+; Copyright (C) 2009, 2016, 2024-2026, D. R. Commander.
+; Copyright (C) 2015, Intel Corporation.
+; Copyright (C) 2018, Matthias Räncker.
+; Copyright (C) 2023, Aliaksiej Kandracienka.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler).  Yasm does not
+; support AVX-512 instructions.
+
+%include "jsimdext.inc"
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      64
+    GLOBAL_DATA(jconst_fancy_upsample_avx512)
+
+EXTN(jconst_fancy_upsample_avx512):
+
+PW_ONE   times 32 dw 1
+PW_TWO   times 32 dw 2
+PW_THREE times 32 dw 3
+PW_SEVEN times 32 dw 7
+PW_EIGHT times 32 dw 8
+
+; vpermi2w indices that shift a row of 32 words right by one word, inserting
+; word 31 of the second source register
+PB_SHIFT_RIGHT  db  63,  0,  1,  2,  3,  4,  5,  6
+                db   7,  8,  9, 10, 11, 12, 13, 14
+                db  15, 16, 17, 18, 19, 20, 21, 22
+                db  23, 24, 25, 26, 27, 28, 29, 30
+
+; vpermi2w indices that shift a row of 32 words left by one word, inserting
+; word 0 of the second source register
+PB_SHIFT_LEFT   db   1,  2,  3,  4,  5,  6,  7,  8
+                db   9, 10, 11, 12, 13, 14, 15, 16
+                db  17, 18, 19, 20, 21, 22, 23, 24
+                db  25, 26, 27, 28, 29, 30, 31, 32
+
+; vpermw indices that shift a row of 32 words left by one word, replicating
+; the last word
+PB_SHIFT_LEFT_LAST \
+                db   1,  2,  3,  4,  5,  6,  7,  8
+                db   9, 10, 11, 12, 13, 14, 15, 16
+                db  17, 18, 19, 20, 21, 22, 23, 24
+                db  25, 26, 27, 28, 29, 30, 31, 31
+
+    ALIGNZ      64
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Fancy processing for the common case of 2:1 horizontal and 1:1 vertical.
+;
+; The upsampling algorithm is linear interpolation between component centers,
+; also known as a "triangle filter".  This is a good compromise between speed
+; and visual quality.  The centers of the output components are 1/4 and 3/4 of
+; the way between input component centers.
+;
+; Each iteration of the column loop upsamples 32 input samples, which are
+; zero-extended to words so that the neighboring samples can be obtained with
+; word permutations rather than by splicing 128-bit lanes.
+;
+; GLOBAL(void)
+; jsimd_h2v1_fancy_upsample_avx512(int max_v_samp_factor,
+;                                  JDIMENSION downsampled_width,
+;                                  JSAMPARRAY input_data,
+;                                  JSAMPARRAY *output_data_ptr)
+;
+; r10 = int max_v_samp_factor
+; r11d = JDIMENSION downsampled_width
+; r12 = JSAMPARRAY input_data
+; r13 = JSAMPARRAY *output_data_ptr
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_h2v1_fancy_upsample_avx512)
+
+EXTN(jsimd_h2v1_fancy_upsample_avx512):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 4
+
+    mov         eax, r11d               ; colctr
+    test        rax, rax
+    jz          near .return
+
+    mov         rcx, r10                ; rowctr
+    test        rcx, rcx
+    jz          near .return
+
+    mov         rsi, r12                ; input_data
+    mov         rdi, r13
+    mov         rdip, JSAMPARRAY [rdi]  ; output_data
+
+    vpmovzxbw   zmm16, [rel PB_SHIFT_RIGHT]
+    vpmovzxbw   zmm17, [rel PB_SHIFT_LEFT_LAST]
+
+.rowloop:
+    push        rax                     ; colctr
+    push        rdi
+    push        rsi
+
+    mov         rsip, JSAMPROW [rsi]    ; inptr
+    mov         rdip, JSAMPROW [rdi]    ; outptr
+
+    test        rax, SIZEOF_YMMWORD - 1
+    jz          short .skip
+    mov         dl, JSAMPLE [rsi + (rax - 1) * SIZEOF_JSAMPLE]
+    mov         JSAMPLE [rsi + rax * SIZEOF_JSAMPLE], dl
+                ; insert a dummy sample
+.skip:
+    movzx       edx, JSAMPLE [rsi]
+    vpbroadcastw zmm7, edx              ; zmm7 = ( 0  0  0 ...  0  0  0)
+
+    add         rax, byte SIZEOF_YMMWORD - 1
+    and         rax, byte -SIZEOF_YMMWORD
+    cmp         rax, byte SIZEOF_YMMWORD
+    ja          short .columnloop
+
+.columnloop_last:
+    vpmovzxbw   zmm1, YMMWORD [rsi]     ; zmm1 = ( 0  1  2 ... 29 30 31)
+    vpermw      zmm3, zmm17, zmm1       ; zmm3 = ( 1  2  3 ... 30 31 31)
+    jmp         short .upsample
+
+.columnloop:
+    vpmovzxbw   zmm1, YMMWORD [rsi]     ; zmm1 = ( 0  1  2 ... 29 30 31)
+    vpmovzxbw   zmm3, YMMWORD [rsi + 1]  ; zmm3 = ( 1  2  3 ... 30 31 32)
+
+.upsample:
+    vmovdqa64   zmm2, zmm16
+    vpermi2w    zmm2, zmm1, zmm7        ; zmm2 = (-1  0  1 ... 28 29 30)
+    vmovdqa64   zmm7, zmm1              ; zmm7 = (-- -- -- ... -- -- 31)
+
+    vpmullw     zmm1, zmm1, [rel PW_THREE]
+    vpaddw      zmm2, zmm2, [rel PW_ONE]
+    vpaddw      zmm3, zmm3, [rel PW_TWO]
+
+    vpaddw      zmm2, zmm2, zmm1
+    vpsrlw      zmm2, zmm2, 2           ; zmm2 = OutE = ( 0  2  4 ... 58 60 62)
+    vpaddw      zmm3, zmm3, zmm1
+    vpsrlw      zmm3, zmm3, 2           ; zmm3 = OutO = ( 1  3  5 ... 59 61 63)
+
+    vpsllw      zmm3, zmm3, BYTE_BIT
+    vpord       zmm2, zmm2, zmm3        ; zmm2 = Out = ( 0  1  2 ... 61 62 63)
+
+    vmovdqu64   ZMMWORD [rdi], zmm2
+
+    sub         rax, byte SIZEOF_YMMWORD
+    add         rsi, byte SIZEOF_YMMWORD  ; inptr
+    add         rdi, byte SIZEOF_ZMMWORD  ; outptr
+    cmp         rax, byte SIZEOF_YMMWORD
+    ja          near .columnloop
+    test        eax, eax
+    jnz         near .columnloop_last
+
+    pop         rsi
+    pop         rdi
+    pop         rax
+
+    add         rsi, byte SIZEOF_JSAMPROW  ; input_data
+    add         rdi, byte SIZEOF_JSAMPROW  ; output_data
+    dec         rcx                        ; rowctr
+    jg          near .rowloop
+
+.return:
+    vzeroupper
+    UNCOLLECT_ARGS 4
+    pop         rbp
+    ret
+
+; --------------------------------------------------------------------------
+;
+; Fancy processing for the common case of 2:1 horizontal and 2:1 vertical.
+; Again a triangle filter; see comments for h2v1 case, above.
+;
+; The vertically-interpolated samples for the next group of 32 columns are
+; computed before the current group is upsampled horizontally, so the
+; intermediate data can be kept in registers.
+;
+; GLOBAL(void)
+; jsimd_h2v2_fancy_upsample_avx512(int max_v_samp_factor,
+;                                  JDIMENSION downsampled_width,
+;                                  JSAMPARRAY input_data,
+;                                  JSAMPARRAY *output_data_ptr)
+;
+; r10 = int max_v_samp_factor
+; r11d = JDIMENSION downsampled_width
+; r12 = JSAMPARRAY input_data
+; r13 = JSAMPARRAY *output_data_ptr
+
+; Compute the vertically-interpolated samples for 32 columns.
+;
+; %1 = Int0 (output), %2 = Int1 (output), %3 = offset
+
+%macro DOVERT 3
+    vpmovzxbw   %1, YMMWORD [rbx + %3]  ; %1 = row[ 0]
+    vpmovzxbw   %2, YMMWORD [rcx + %3]  ; %2 = row[-1]
+    vpmovzxbw   zmm6, YMMWORD [rsi + %3]  ; zmm6 = row[+1]
+    vpmullw     %1, %1, [rel PW_THREE]
+    vpaddw      zmm6, zmm6, %1          ; zmm6 = Int1
+    vpaddw      %1, %1, %2              ; %1 = Int0
+    vmovdqa64   %2, zmm6                ; %2 = Int1
+%endmacro
+
+; Upsample 32 vertically-interpolated samples horizontally and store the
+; result.
+;
+; %1 = Int (this group), %2 = Int (previous group), %3 = Int(1 .. 32),
+; %4 = output row
+
+%macro DOHORIZ 4
+    vmovdqa64   zmm6, zmm16
+    vpermi2w    zmm6, %1, %2            ; zmm6 = (-1  0  1 ... 28 29 30)
+    vpmullw     zmm7, %1, [rel PW_THREE]
+    vpaddw      zmm6, zmm6, [rel PW_EIGHT]
+    vpaddw      %3, %3, [rel PW_SEVEN]
+
+    vpaddw      zmm6, zmm6, zmm7
+    vpsrlw      zmm6, zmm6, 4           ; zmm6 = OutE = ( 0  2  4 ... 58 60 62)
+    vpaddw      %3, %3, zmm7
+    vpsrlw      %3, %3, 4               ; %3 = OutO = ( 1  3  5 ... 59 61 63)
+
+    vpsllw      %3, %3, BYTE_BIT
+    vpord       zmm6, zmm6, %3          ; zmm6 = Out = ( 0  1  2 ... 61 62 63)
+
+    vmovdqu64   ZMMWORD [%4], zmm6
+%endmacro
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_h2v2_fancy_upsample_avx512)
+
+EXTN(jsimd_h2v2_fancy_upsample_avx512):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 4
+    push        rbx
+
+    mov         eax, r11d               ; colctr
+    test        rax, rax
+    jz          near .return
+
+    mov         rcx, r10                ; rowctr
+    test        rcx, rcx
+    jz          near .return
+
+    mov         rsi, r12                ; input_data
+    mov         rdi, r13
+    mov         rdip, JSAMPARRAY [rdi]  ; output_data
+
+    vpmovzxbw   zmm16, [rel PB_SHIFT_RIGHT]
+    vpmovzxbw   zmm17, [rel PB_SHIFT_LEFT]
+    vpmovzxbw   zmm18, [rel PB_SHIFT_LEFT_LAST]
+
+.rowloop:
+    push        rax                     ; colctr
+    push        rcx
+    push        rdi
+    push        rsi
+
+    mov         rcxp, JSAMPROW [rsi - 1 * SIZEOF_JSAMPROW]  ; inptr1(above)
+    mov         rbxp, JSAMPROW [rsi + 0 * SIZEOF_JSAMPROW]  ; inptr0
+    mov         rsip, JSAMPROW [rsi + 1 * SIZEOF_JSAMPROW]  ; inptr1(below)
+    mov         rdxp, JSAMPROW [rdi + 0 * SIZEOF_JSAMPROW]  ; outptr0
+    mov         rdip, JSAMPROW [rdi + 1 * SIZEOF_JSAMPROW]  ; outptr1
+
+    test        rax, SIZEOF_YMMWORD - 1
+    jz          short .skip
+    push        rdx
+    mov         dl, JSAMPLE [rcx + (rax - 1) * SIZEOF_JSAMPLE]
+    mov         JSAMPLE [rcx + rax * SIZEOF_JSAMPLE], dl
+    mov         dl, JSAMPLE [rbx + (rax - 1) * SIZEOF_JSAMPLE]
+    mov         JSAMPLE [rbx + rax * SIZEOF_JSAMPLE], dl
+    mov         dl, JSAMPLE [rsi + (rax - 1) * SIZEOF_JSAMPLE]
+    mov         JSAMPLE [rsi + rax * SIZEOF_JSAMPLE], dl
+                ; insert a dummy sample
+    pop         rdx
+.skip:
+    ; -- process the first column block
+
+    DOVERT      zmm0, zmm1, 0 * SIZEOF_YMMWORD
+                ; zmm0 = Int0 = ( 0  1  2 ... 29 30 31)
+                ; zmm1 = Int1 = ( 0  1  2 ... 29 30 31)
+
+    vpbroadcastw zmm4, xmm0             ; zmm4 = ( 0  0  0 ...  0  0  0)
+    vpbroadcastw zmm5, xmm1             ; zmm5 = ( 0  0  0 ...  0  0  0)
+
+    add         rax, byte SIZEOF_YMMWORD - 1
+    and         rax, byte -SIZEOF_YMMWORD
+    cmp         rax, byte SIZEOF_YMMWORD
+    ja          short .columnloop
+
+.columnloop_last:
+    ; -- process the last column block
+
+    vpermw      zmm2, zmm18, zmm0       ; zmm2 = Int0( 1  2  3 ... 30 31 31)
+    vpermw      zmm3, zmm18, zmm1       ; zmm3 = Int1( 1  2  3 ... 30 31 31)
+
+    DOHORIZ     zmm0, zmm4, zmm2, rdx
+    DOHORIZ     zmm1, zmm5, zmm3, rdi
+
+    jmp         short .nextrow
+
+.columnloop:
+    ; -- process the next column block
+
+    DOVERT      zmm2, zmm3, 1 * SIZEOF_YMMWORD
+                ; zmm2 = Int0 = (32 33 34 ... 61 62 63)
+                ; zmm3 = Int1 = (32 33 34 ... 61 62 63)
+
+    vmovdqa64   zmm22, zmm17
+    vpermi2w    zmm22, zmm0, zmm2       ; zmm22 = Int0( 1  2  3 ... 30 31 32)
+    vmovdqa64   zmm23, zmm17
+    vpermi2w    zmm23, zmm1, zmm3       ; zmm23 = Int1( 1  2  3 ... 30 31 32)
+
+    DOHORIZ     zmm0, zmm4, zmm22, rdx
+    DOHORIZ     zmm1, zmm5, zmm23, rdi
+
+    vmovdqa64   zmm4, zmm0              ; zmm4 = Int0(-- -- -- ... -- -- 31)
+    vmovdqa64   zmm5, zmm1              ; zmm5 = Int1(-- -- -- ... -- -- 31)
+    vmovdqa64   zmm0, zmm2
+    vmovdqa64   zmm1, zmm3
+
+    sub         rax, byte SIZEOF_YMMWORD
+    add         rcx, byte 1 * SIZEOF_YMMWORD  ; inptr1(above)
+    add         rbx, byte 1 * SIZEOF_YMMWORD  ; inptr0
+    add         rsi, byte 1 * SIZEOF_YMMWORD  ; inptr1(below)
+    add         rdx, byte 1 * SIZEOF_ZMMWORD  ; outptr0
+    add         rdi, byte 1 * SIZEOF_ZMMWORD  ; outptr1
+    cmp         rax, byte SIZEOF_YMMWORD
+    ja          near .columnloop
+    jmp         near .columnloop_last
+
+.nextrow:
+    pop         rsi
+    pop         rdi
+    pop         rcx
+    pop         rax
+
+    add         rsi, byte 1 * SIZEOF_JSAMPROW  ; input_data
+    add         rdi, byte 2 * SIZEOF_JSAMPROW  ; output_data
+    sub         rcx, byte 2                    ; rowctr
+    jg          near .rowloop
+
+.return:
+    pop         rbx
+    vzeroupper
+    UNCOLLECT_ARGS 4
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
@@ -0,0 +1,383 @@
+;
+; Upsampling (64-bit AVX2, 12-bit samples)
+;
+; Copyright (C) 2026, D. R. Commander.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+;
+; With 12-bit samples, the weighted sums computed by the triangle filter never
+; exceed 16 bits, so these routines operate directly on the samples without
+; unpacking them.
+
+%include "jsimdext.inc"
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      32
+    GLOBAL_DATA(jconst12_fancy_upsample_avx2)
+
+EXTN(jconst12_fancy_upsample_avx2):
+
+PW_ONE   times 16 dw 1
+PW_TWO   times 16 dw 2
+PW_THREE times 16 dw 3
+PW_SEVEN times 16 dw 7
+PW_EIGHT times 16 dw 8
+
+    ALIGNZ      32
+
+; --------------------------------------------------------------------------
+; Interleave the even and odd output samples and store them
+; %1: Even output samples ( 0  2  4 ... 26 28 30)
+; %2: Odd output samples ( 1  3  5 ... 27 29 31)
+; %3, %4: Temporary registers
+; %5: Output pointer
+
+%macro STOREOUT 5
+    vpunpcklwd  %3, %1, %2
+                ; %3 = ( 0  1  2  3  4  5  6  7 16 17 18 19 20 21 22 23)
+    vpunpckhwd  %4, %1, %2
+                ; %4 = ( 8  9 10 11 12 13 14 15 24 25 26 27 28 29 30 31)
+    vperm2i128  %1, %3, %4, 0x20
+                ; %1 = ( 0  1  2  3  4  5  6  7  8  9 10 11 12 13 14 15)
+    vperm2i128  %2, %3, %4, 0x31
+                ; %2 = (16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31)
+
+    vmovdqu     YMMWORD [%5 + 0 * SIZEOF_YMMWORD], %1
+    vmovdqu     YMMWORD [%5 + 1 * SIZEOF_YMMWORD], %2
+%endmacro
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Fancy processing for the common case of 2:1 horizontal and 1:1 vertical.
+;
+; The upsampling algorithm is linear interpolation between component centers,
+; also known as a "triangle filter".  This is a good compromise between speed
+; and visual quality.  The centers of the output components are 1/4 and 3/4 of
+; the way between input component centers.
+;
+; GLOBAL(void)
+; jsimd12_h2v1_fancy_upsample_avx2(int max_v_samp_factor,
+;                                  JDIMENSION downsampled_width,
+;                                  J12SAMPARRAY input_data,
+;                                  J12SAMPARRAY *output_data_ptr)
+;
+; r10 = int max_v_samp_factor
+; r11d = JDIMENSION downsampled_width
+; r12 = J12SAMPARRAY input_data
+; r13 = J12SAMPARRAY *output_data_ptr
+
+    align       32
+    GLOBAL_FUNCTION(jsimd12_h2v1_fancy_upsample_avx2)
+
+EXTN(jsimd12_h2v1_fancy_upsample_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    PUSH_XMM    3
+    COLLECT_ARGS 4
+
+    mov         eax, r11d               ; colctr
+    test        rax, rax
+    jz          near .return
+
+    mov         rcx, r10                ; rowctr
+    test        rcx, rcx
+    jz          near .return
+
+    mov         rsi, r12                ; input_data
+    mov         rdi, r13
+    mov         rdip, J12SAMPARRAY [rdi]  ; output_data
+
+    vpxor       ymm0, ymm0, ymm0        ; ymm0 = (all 0's)
+    vpcmpeqb    xmm9, xmm9, xmm9
+    vpsrldq     xmm10, xmm9, (SIZEOF_XMMWORD - 2)
+                ; (ffff ---- ---- ... ---- ----) LSB is ffff
+
+    vpslldq     xmm9, xmm9, (SIZEOF_XMMWORD - 2)
+    vperm2i128  ymm9, ymm9, ymm9, 1
+                ; (---- ---- ... ---- ---- ffff) MSB is ffff
+
+.rowloop:
+    push        rax                     ; colctr
+    push        rdi
+    push        rsi
+
+    mov         rsip, J12SAMPROW [rsi]  ; inptr
+    mov         rdip, J12SAMPROW [rdi]  ; outptr
+
+    test        rax, (SIZEOF_YMMWORD / SIZEOF_J12SAMPLE) - 1
+    jz          short .skip
+    mov         dx, J12SAMPLE [rsi + (rax - 1) * SIZEOF_J12SAMPLE]
+    mov         J12SAMPLE [rsi + rax * SIZEOF_J12SAMPLE], dx
+                ; insert a dummy sample
+.skip:
+    vpand       ymm7, ymm10, YMMWORD [rsi + 0 * SIZEOF_YMMWORD]
+
+    add         rax, byte (SIZEOF_YMMWORD / SIZEOF_J12SAMPLE) - 1
+    and         rax, byte -(SIZEOF_YMMWORD / SIZEOF_J12SAMPLE)
+    cmp         rax, byte (SIZEOF_YMMWORD / SIZEOF_J12SAMPLE)
+    ja          short .columnloop
+
+.columnloop_last:
+    vpand       ymm6, ymm9, YMMWORD [rsi + 0 * SIZEOF_YMMWORD]
+    jmp         short .upsample
+
+.columnloop:
+    vmovdqu     ymm6, YMMWORD [rsi + 1 * SIZEOF_YMMWORD]
+    vperm2i128  ymm6, ymm0, ymm6, 0x20
+    vpslldq     ymm6, ymm6, (SIZEOF_XMMWORD - 2)
+
+.upsample:
+    vmovdqu     ymm1, YMMWORD [rsi + 0 * SIZEOF_YMMWORD]
+                ; ymm1 = ( 0  1  2 ... 13 14 15)
+
+    vperm2i128  ymm2, ymm0, ymm1, 0x20
+    vpalignr    ymm2, ymm1, ymm2, (SIZEOF_XMMWORD - 2)
+                ; ymm2 = (--  0  1 ... 12 13 14)
+    vperm2i128  ymm4, ymm0, ymm1, 0x03
+    vpalignr    ymm3, ymm4, ymm1, 2     ; ymm3 = ( 1  2  3 ... 14 15 --)
+
+    vpor        ymm2, ymm2, ymm7        ; ymm2 = (-1  0  1 ... 12 13 14)
+    vpor        ymm3, ymm3, ymm6        ; ymm3 = ( 1  2  3 ... 14 15 16)
+
+    vpsrldq     ymm7, ymm4, (SIZEOF_XMMWORD - 2)
+                ; ymm7 = (15 -- -- ... -- -- --)
+
+    vpmullw     ymm1, ymm1, [rel PW_THREE]
+    vpaddw      ymm2, ymm2, [rel PW_ONE]
+    vpaddw      ymm3, ymm3, [rel PW_TWO]
+
+    vpaddw      ymm2, ymm2, ymm1
+    vpsrlw      ymm2, ymm2, 2
+                ; ymm2 = OutE = ( 0  2  4 ... 26 28 30)
+    vpaddw      ymm3, ymm3, ymm1
+    vpsrlw      ymm3, ymm3, 2
+                ; ymm3 = OutO = ( 1  3  5 ... 27 29 31)
+
+    STOREOUT    ymm2, ymm3, ymm4, ymm5, rdi
+
+    sub         rax, byte (SIZEOF_YMMWORD / SIZEOF_J12SAMPLE)
+    add         rsi, byte 1 * SIZEOF_YMMWORD  ; inptr
+    add         rdi, byte 2 * SIZEOF_YMMWORD  ; outptr
+    cmp         rax, byte (SIZEOF_YMMWORD / SIZEOF_J12SAMPLE)
+    ja          near .columnloop
+    test        eax, eax
+    jnz         near .columnloop_last
+
+    pop         rsi
+    pop         rdi
+    pop         rax
+
+    add         rsi, byte SIZEOF_J12SAMPROW  ; input_data
+    add         rdi, byte SIZEOF_J12SAMPROW  ; output_data
+    dec         rcx                          ; rowctr
+    jg          near .rowloop
+
+.return:
+    vzeroupper
+    UNCOLLECT_ARGS 4
+    POP_XMM     3
+    pop         rbp
+    ret
+
+; --------------------------------------------------------------------------
+;
+; Fancy processing for the common case of 2:1 horizontal and 2:1 vertical.
+; Again a triangle filter; see comments for h2v1 case, above.
+;
+; GLOBAL(void)
+; jsimd12_h2v2_fancy_upsample_avx2(int max_v_samp_factor,
+;                                  JDIMENSION downsampled_width,
+;                                  J12SAMPARRAY input_data,
+;                                  J12SAMPARRAY *output_data_ptr)
+;
+; r10 = int max_v_samp_factor
+; r11d = JDIMENSION downsampled_width
+; r12 = J12SAMPARRAY input_data
+; r13 = J12SAMPARRAY *output_data_ptr
+
+; Upsample one row of column sums
+; %1: Column sums for this column block
+; %2: Last column sum of the previous column block (in the LSW)
+;     (on return, the last column sum of this column block)
+; %3: First column sum of the next column block (in the MSW)
+; %4: Output pointer
+
+%macro UPSAMPLE_ROW 4
+    vperm2i128  ymm1, ymm15, %1, 0x20
+    vpalignr    ymm1, %1, ymm1, (SIZEOF_XMMWORD - 2)
+                ; ymm1 = (--  0  1 ... 12 13 14)
+    vperm2i128  ymm3, ymm15, %1, 0x03
+    vpalignr    ymm2, ymm3, %1, 2       ; ymm2 = ( 1  2  3 ... 14 15 --)
+
+    vpor        ymm1, ymm1, %2          ; ymm1 = (-1  0  1 ... 12 13 14)
+    vpor        ymm2, ymm2, %3          ; ymm2 = ( 1  2  3 ... 14 15 16)
+
+    vpsrldq     %2, ymm3, (SIZEOF_XMMWORD - 2)
+                ; %2 = (15 -- -- ... -- -- --)
+
+    vpmullw     ymm0, %1, [rel PW_THREE]
+    vpaddw      ymm1, ymm1, [rel PW_EIGHT]
+    vpaddw      ymm2, ymm2, [rel PW_SEVEN]
+
+    vpaddw      ymm1, ymm1, ymm0
+    vpsrlw      ymm1, ymm1, 4
+                ; ymm1 = OutE = ( 0  2  4 ... 26 28 30)
+    vpaddw      ymm2, ymm2, ymm0
+    vpsrlw      ymm2, ymm2, 4
+                ; ymm2 = OutO = ( 1  3  5 ... 27 29 31)
+
+    STOREOUT    ymm1, ymm2, ymm3, ymm4, %4
+%endmacro
+
+    align       32
+    GLOBAL_FUNCTION(jsimd12_h2v2_fancy_upsample_avx2)
+
+EXTN(jsimd12_h2v2_fancy_upsample_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    PUSH_XMM    8
+    COLLECT_ARGS 4
+    push        rbx
+
+    mov         eax, r11d               ; colctr
+    test        rax, rax
+    jz          near .return
+
+    mov         rcx, r10                ; rowctr
+    test        rcx, rcx
+    jz          near .return
+
+    mov         rsi, r12                ; input_data
+    mov         rdi, r13
+    mov         rdip, J12SAMPARRAY [rdi]  ; output_data
+
+    vpxor       ymm15, ymm15, ymm15     ; ymm15 = (all 0's)
+    vpcmpeqb    xmm13, xmm13, xmm13
+    vpsrldq     xmm14, xmm13, (SIZEOF_XMMWORD - 2)
+                ; (ffff ---- ---- ... ---- ----) LSB is ffff
+    vpslldq     xmm13, xmm13, (SIZEOF_XMMWORD - 2)
+    vperm2i128  ymm13, ymm13, ymm13, 1
+                ; (---- ---- ... ---- ---- ffff) MSB is ffff
+
+.rowloop:
+    push        rax                     ; colctr
+    push        rcx
+    push        rdi
+    push        rsi
+
+    mov         rcxp, J12SAMPROW [rsi - 1 * SIZEOF_J12SAMPROW]  ; inptr1(above)
+    mov         rbxp, J12SAMPROW [rsi + 0 * SIZEOF_J12SAMPROW]  ; inptr0
+    mov         rsip, J12SAMPROW [rsi + 1 * SIZEOF_J12SAMPROW]  ; inptr1(below)
+    mov         rdxp, J12SAMPROW [rdi + 0 * SIZEOF_J12SAMPROW]  ; outptr0
+    mov         rdip, J12SAMPROW [rdi + 1 * SIZEOF_J12SAMPROW]  ; outptr1
+
+    test        rax, (SIZEOF_YMMWORD / SIZEOF_J12SAMPLE) - 1
+    jz          short .skip
+    push        rdx
+    mov         dx, J12SAMPLE [rcx + (rax - 1) * SIZEOF_J12SAMPLE]
+    mov         J12SAMPLE [rcx + rax * SIZEOF_J12SAMPLE], dx
+    mov         dx, J12SAMPLE [rbx + (rax - 1) * SIZEOF_J12SAMPLE]
+    mov         J12SAMPLE [rbx + rax * SIZEOF_J12SAMPLE], dx
+    mov         dx, J12SAMPLE [rsi + (rax - 1) * SIZEOF_J12SAMPLE]
+    mov         J12SAMPLE [rsi + rax * SIZEOF_J12SAMPLE], dx
+                ; insert a dummy sample
+    pop         rdx
+.skip:
+    ; -- process the first column block
+
+    vmovdqu     ymm0, YMMWORD [rbx + 0 * SIZEOF_YMMWORD]  ; ymm0 = row[ 0][0]
+    vmovdqu     ymm12, YMMWORD [rcx + 0 * SIZEOF_YMMWORD]  ; ymm12 = row[-1][0]
+    vmovdqu     ymm11, YMMWORD [rsi + 0 * SIZEOF_YMMWORD]  ; ymm11 = row[+1][0]
+
+    vpmullw     ymm0, ymm0, [rel PW_THREE]
+    vpaddw      ymm12, ymm12, ymm0      ; ymm12 = Int0 = ( 0  1 ... 14 15)
+    vpaddw      ymm11, ymm11, ymm0      ; ymm11 = Int1 = ( 0  1 ... 14 15)
+
+    vpand       ymm10, ymm12, ymm14     ; ymm10 = ( 0 -- -- ... -- -- --)
+    vpand       ymm9, ymm11, ymm14      ; ymm9  = ( 0 -- -- ... -- -- --)
+
+    add         rax, byte (SIZEOF_YMMWORD / SIZEOF_J12SAMPLE) - 1
+    and         rax, byte -(SIZEOF_YMMWORD / SIZEOF_J12SAMPLE)
+    cmp         rax, byte (SIZEOF_YMMWORD / SIZEOF_J12SAMPLE)
+    ja          short .columnloop
+
+.columnloop_last:
+    ; -- process the last column block
+
+    vpand       ymm8, ymm12, ymm13      ; ymm8 = (-- -- -- ... -- -- 15)
+    vpand       ymm7, ymm11, ymm13      ; ymm7 = (-- -- -- ... -- -- 15)
+
+    jmp         short .upsample
+
+.columnloop:
+    ; -- process the next column block
+
+    vmovdqu     ymm0, YMMWORD [rbx + 1 * SIZEOF_YMMWORD]  ; ymm0 = row[ 0][1]
+    vmovdqu     ymm5, YMMWORD [rcx + 1 * SIZEOF_YMMWORD]  ; ymm5 = row[-1][1]
+    vmovdqu     ymm6, YMMWORD [rsi + 1 * SIZEOF_YMMWORD]  ; ymm6 = row[+1][1]
+
+    vpmullw     ymm0, ymm0, [rel PW_THREE]
+    vpaddw      ymm5, ymm5, ymm0        ; ymm5 = Int0 = (16 17 18 ... 29 30 31)
+    vpaddw      ymm6, ymm6, ymm0        ; ymm6 = Int1 = (16 17 18 ... 29 30 31)
+
+    vperm2i128  ymm8, ymm15, ymm5, 0x20
+    vpslldq     ymm8, ymm8, (SIZEOF_XMMWORD - 2)
+                ; ymm8 = (-- -- -- ... -- -- 16)
+    vperm2i128  ymm7, ymm15, ymm6, 0x20
+    vpslldq     ymm7, ymm7, (SIZEOF_XMMWORD - 2)
+                ; ymm7 = (-- -- -- ... -- -- 16)
+
+.upsample:
+    ; -- process the upper row
+
+    UPSAMPLE_ROW ymm12, ymm10, ymm8, rdx
+
+    ; -- process the lower row
+
+    UPSAMPLE_ROW ymm11, ymm9, ymm7, rdi
+
+    vmovdqa     ymm12, ymm5
+    vmovdqa     ymm11, ymm6
+
+    sub         rax, byte (SIZEOF_YMMWORD / SIZEOF_J12SAMPLE)
+    add         rcx, byte 1 * SIZEOF_YMMWORD  ; inptr1(above)
+    add         rbx, byte 1 * SIZEOF_YMMWORD  ; inptr0
+    add         rsi, byte 1 * SIZEOF_YMMWORD  ; inptr1(below)
+    add         rdx, byte 2 * SIZEOF_YMMWORD  ; outptr0
+    add         rdi, byte 2 * SIZEOF_YMMWORD  ; outptr1
+    cmp         rax, byte (SIZEOF_YMMWORD / SIZEOF_J12SAMPLE)
+    ja          near .columnloop
+    test        rax, rax
+    jnz         near .columnloop_last
+
+    pop         rsi
+    pop         rdi
+    pop         rcx
+    pop         rax
+
+    add         rsi, byte 1 * SIZEOF_J12SAMPROW  ; input_data
+    add         rdi, byte 2 * SIZEOF_J12SAMPROW  ; output_data
+    sub         rcx, byte 2                      ; rowctr
+    jg          near .rowloop
+
+.return:
+    pop         rbx
+    vzeroupper
+    UNCOLLECT_ARGS 4
+    POP_XMM     8
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
@@ -0,0 +1,204 @@
+;
+; Floating Point Forward DCT (64-bit AVX2)
+;
+; Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
+; Copyright (C) 2009, 2016, 2024-2026, D. R. Commander.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+;
+; This file contains a floating-point implementation of the forward DCT
+; (Discrete Cosine Transform).  The following code is based directly on the
+; IJG's original jfdctflt.c;  see jfdctflt.c for more details.
+;
+; Each ymm register holds one row or column of eight floats, so the whole
+; block fits in registers, and no workspace is needed.  FMA instructions are
+; deliberately not used, so the results are identical to those of the SSE
+; implementation.
+
+%include "jsimdext.inc"
+%include "jdct.inc"
+
+; --------------------------------------------------------------------------
+
+; In-place 8x8x32-bit matrix transpose using AVX instructions
+; %1-%8: Input/output registers
+; %9: Temp register
+;
+; On input, %1-%8 contain rows 0-7.  On output, columns 0-7 are in %3, %4, %1,
+; %2, %8, %9, %6, and %7 (respectively), and %5 is free.
+
+%macro DOTRANSPOSE 9
+    ; %1 = (00 01 02 03 04 05 06 07), %2 = (10 11 12 13 14 15 16 17), ...
+    vperm2f128  %9, %1, %5, 0x20        ; %9 = (00 01 02 03 40 41 42 43)
+    vperm2f128  %5, %1, %5, 0x31        ; %5 = (04 05 06 07 44 45 46 47)
+    vperm2f128  %1, %2, %6, 0x20        ; %1 = (10 11 12 13 50 51 52 53)
+    vperm2f128  %6, %2, %6, 0x31        ; %6 = (14 15 16 17 54 55 56 57)
+    vperm2f128  %2, %3, %7, 0x20        ; %2 = (20 21 22 23 60 61 62 63)
+    vperm2f128  %7, %3, %7, 0x31        ; %7 = (24 25 26 27 64 65 66 67)
+    vperm2f128  %3, %4, %8, 0x20        ; %3 = (30 31 32 33 70 71 72 73)
+    vperm2f128  %8, %4, %8, 0x31        ; %8 = (34 35 36 37 74 75 76 77)
+
+    vunpcklps   %4, %9, %1              ; %4 = (00 10 01 11 40 50 41 51)
+    vunpckhps   %9, %9, %1              ; %9 = (02 12 03 13 42 52 43 53)
+    vunpcklps   %1, %2, %3              ; %1 = (20 30 21 31 60 70 61 71)
+    vunpckhps   %2, %2, %3              ; %2 = (22 32 23 33 62 72 63 73)
+    vshufps     %3, %4, %1, 0x44        ; %3 = (00 10 20 30 40 50 60 70)
+    vshufps     %4, %4, %1, 0xEE        ; %4 = (01 11 21 31 41 51 61 71)
+    vshufps     %1, %9, %2, 0x44        ; %1 = (02 12 22 32 42 52 62 72)
+    vshufps     %2, %9, %2, 0xEE        ; %2 = (03 13 23 33 43 53 63 73)
+
+    vunpcklps   %9, %5, %6              ; %9 = (04 14 05 15 44 54 45 55)
+    vunpckhps   %5, %5, %6              ; %5 = (06 16 07 17 46 56 47 57)
+    vunpcklps   %6, %7, %8              ; %6 = (24 34 25 35 64 74 65 75)
+    vunpckhps   %7, %7, %8              ; %7 = (26 36 27 37 66 76 67 77)
+    vshufps     %8, %9, %6, 0x44        ; %8 = (04 14 24 34 44 54 64 74)
+    vshufps     %9, %9, %6, 0xEE        ; %9 = (05 15 25 35 45 55 65 75)
+    vshufps     %6, %5, %7, 0x44        ; %6 = (06 16 26 36 46 56 66 76)
+    vshufps     %7, %5, %7, 0xEE        ; %7 = (07 17 27 37 47 57 67 77)
+%endmacro
+
+; --------------------------------------------------------------------------
+
+; In-place 8-point floating point FDCT
+; %1-%8: Input/output registers
+; %9: Temp register
+;
+; On input, %1-%8 contain data0-data7.  On output, data0-data7 are in %2, %5,
+; %3, %1, %4, %6, %9, and %8 (respectively), and %7 is free.
+
+%macro DODCT 9
+    vaddps      %9, %1, %8              ; %9 = data0 + data7 = tmp0
+    vsubps      %8, %1, %8              ; %8 = data0 - data7 = tmp7
+    vaddps      %1, %2, %7              ; %1 = data1 + data6 = tmp1
+    vsubps      %7, %2, %7              ; %7 = data1 - data6 = tmp6
+    vaddps      %2, %3, %6              ; %2 = data2 + data5 = tmp2
+    vsubps      %6, %3, %6              ; %6 = data2 - data5 = tmp5
+    vaddps      %3, %4, %5              ; %3 = data3 + data4 = tmp3
+    vsubps      %5, %4, %5              ; %5 = data3 - data4 = tmp4
+
+    ; -- Even part
+
+    vaddps      %4, %9, %3              ; %4 = tmp10
+    vsubps      %9, %9, %3              ; %9 = tmp13
+    vaddps      %3, %1, %2              ; %3 = tmp11
+    vsubps      %1, %1, %2              ; %1 = tmp12
+
+    vaddps      %1, %1, %9
+    vmulps      %1, %1, [rel PD_0_707]  ; %1 = z1
+
+    vaddps      %2, %4, %3              ; %2 = data0
+    vsubps      %4, %4, %3              ; %4 = data4
+    vaddps      %3, %9, %1              ; %3 = data2
+    vsubps      %9, %9, %1              ; %9 = data6
+
+    ; -- Odd part
+
+    vaddps      %5, %5, %6              ; %5 = tmp10
+    vaddps      %6, %6, %7              ; %6 = tmp11
+    vaddps      %7, %7, %8              ; %7 = tmp12
+
+    vmulps      %6, %6, [rel PD_0_707]  ; %6 = z3
+
+    vsubps      %1, %5, %7
+    vmulps      %1, %1, [rel PD_0_382]  ; %1 = z5
+    vmulps      %5, %5, [rel PD_0_541]  ; %5 = MULTIPLY(tmp10, FIX_0_541196)
+    vmulps      %7, %7, [rel PD_1_306]  ; %7 = MULTIPLY(tmp12, FIX_1_306562)
+    vaddps      %5, %5, %1              ; %5 = z2
+    vaddps      %7, %7, %1              ; %7 = z4
+
+    vsubps      %1, %8, %6              ; %1 = z13
+    vaddps      %8, %8, %6              ; %8 = z11
+
+    vaddps      %6, %1, %5              ; %6 = data5
+    vsubps      %1, %1, %5              ; %1 = data3
+    vaddps      %5, %8, %7              ; %5 = data1
+    vsubps      %8, %8, %7              ; %8 = data7
+%endmacro
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      32
+    GLOBAL_DATA(jconst_fdct_float_avx2)
+
+EXTN(jconst_fdct_float_avx2):
+
+PD_0_382 times 8 dd 0.382683432365089771728460
+PD_0_707 times 8 dd 0.707106781186547524400844
+PD_0_541 times 8 dd 0.541196100146196984399723
+PD_1_306 times 8 dd 1.306562964876376527856643
+
+    ALIGNZ      32
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Perform the forward DCT on one block of samples.
+;
+; GLOBAL(void)
+; jsimd_fdct_float_avx2(FAST_FLOAT *data)
+;
+; r10 = FAST_FLOAT *data
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_fdct_float_avx2)
+
+EXTN(jsimd_fdct_float_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    PUSH_XMM    1
+    COLLECT_ARGS 1
+
+    ; ---- Pass 1: process rows.
+
+    vmovups     ymm0, YMMWORD [YMMBLOCK(0, 0, r10, SIZEOF_FAST_FLOAT)]
+    vmovups     ymm1, YMMWORD [YMMBLOCK(1, 0, r10, SIZEOF_FAST_FLOAT)]
+    vmovups     ymm2, YMMWORD [YMMBLOCK(2, 0, r10, SIZEOF_FAST_FLOAT)]
+    vmovups     ymm3, YMMWORD [YMMBLOCK(3, 0, r10, SIZEOF_FAST_FLOAT)]
+    vmovups     ymm4, YMMWORD [YMMBLOCK(4, 0, r10, SIZEOF_FAST_FLOAT)]
+    vmovups     ymm5, YMMWORD [YMMBLOCK(5, 0, r10, SIZEOF_FAST_FLOAT)]
+    vmovups     ymm6, YMMWORD [YMMBLOCK(6, 0, r10, SIZEOF_FAST_FLOAT)]
+    vmovups     ymm7, YMMWORD [YMMBLOCK(7, 0, r10, SIZEOF_FAST_FLOAT)]
+
+    DOTRANSPOSE ymm0, ymm1, ymm2, ymm3, ymm4, ymm5, ymm6, ymm7, ymm8
+               ; ymm2 = col0, ymm3 = col1, ymm0 = col2, ymm1 = col3,
+               ; ymm7 = col4, ymm8 = col5, ymm5 = col6, ymm6 = col7
+
+    DODCT       ymm2, ymm3, ymm0, ymm1, ymm7, ymm8, ymm5, ymm6, ymm4
+               ; ymm3 = data0, ymm7 = data1, ymm0 = data2, ymm2 = data3,
+               ; ymm1 = data4, ymm8 = data5, ymm4 = data6, ymm6 = data7
+
+    ; ---- Pass 2: process columns.
+
+    DOTRANSPOSE ymm3, ymm7, ymm0, ymm2, ymm1, ymm8, ymm4, ymm6, ymm5
+               ; ymm0 = row0, ymm2 = row1, ymm3 = row2, ymm7 = row3,
+               ; ymm6 = row4, ymm5 = row5, ymm8 = row6, ymm4 = row7
+
+    DODCT       ymm0, ymm2, ymm3, ymm7, ymm6, ymm5, ymm8, ymm4, ymm1
+               ; ymm2 = data0, ymm6 = data1, ymm3 = data2, ymm0 = data3,
+               ; ymm7 = data4, ymm5 = data5, ymm1 = data6, ymm4 = data7
+
+    vmovups     YMMWORD [YMMBLOCK(0, 0, r10, SIZEOF_FAST_FLOAT)], ymm2
+    vmovups     YMMWORD [YMMBLOCK(1, 0, r10, SIZEOF_FAST_FLOAT)], ymm6
+    vmovups     YMMWORD [YMMBLOCK(2, 0, r10, SIZEOF_FAST_FLOAT)], ymm3
+    vmovups     YMMWORD [YMMBLOCK(3, 0, r10, SIZEOF_FAST_FLOAT)], ymm0
+    vmovups     YMMWORD [YMMBLOCK(4, 0, r10, SIZEOF_FAST_FLOAT)], ymm7
+    vmovups     YMMWORD [YMMBLOCK(5, 0, r10, SIZEOF_FAST_FLOAT)], ymm5
+    vmovups     YMMWORD [YMMBLOCK(6, 0, r10, SIZEOF_FAST_FLOAT)], ymm1
+    vmovups     YMMWORD [YMMBLOCK(7, 0, r10, SIZEOF_FAST_FLOAT)], ymm4
+
+    vzeroupper
+    UNCOLLECT_ARGS 1
+    POP_XMM     1
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
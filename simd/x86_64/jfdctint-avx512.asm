@@ -0,0 +1,278 @@
+;
+; Accurate Integer Forward DCT (64-bit AVX-512)
+;
+; Copyright (C) 2026, D. R. Commander.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler).  Yasm does not
+; support AVX-512 instructions.
+;
+; This file contains a slower but more accurate integer implementation of the
+; forward DCT (Discrete Cosine Transform).  The following code is based
+; directly on the IJG's original jfdctint.c; see jfdctint.c for more details.
+;
+; As in the AVX-512 accurate integer inverse DCT, the whole 8x8 block is
+; processed by each pass, and each pair of inputs that is needed by one
+; vpmaddwd instruction is gathered directly from the output of the previous
+; pass rather than transposing the block.  All of the gathered pairs are
+; aligned doublewords (with the word order reversed for (in7, in6) and
+; (in3, in2)), so the gathers can use vpermi2d.
+
+%include "jsimdext.inc"
+%include "jdct.inc"
+
+; --------------------------------------------------------------------------
+
+%define CONST_BITS  13
+%define PASS1_BITS  2
+
+%define DESCALE_P1  (CONST_BITS - PASS1_BITS)
+%define DESCALE_P2  (CONST_BITS + PASS1_BITS)
+
+%if CONST_BITS == 13
+F_0_298 equ  2446  ; FIX(0.298631336)
+F_0_390 equ  3196  ; FIX(0.390180644)
+F_0_541 equ  4433  ; FIX(0.541196100)
+F_0_765 equ  6270  ; FIX(0.765366865)
+F_0_899 equ  7373  ; FIX(0.899976223)
+F_1_000 equ  8192  ; FIX(1.000000000)
+F_1_175 equ  9633  ; FIX(1.175875602)
+F_1_501 equ 12299  ; FIX(1.501321110)
+F_1_847 equ 15137  ; FIX(1.847759065)
+F_1_961 equ 16069  ; FIX(1.961570560)
+F_2_053 equ 16819  ; FIX(2.053119869)
+F_2_562 equ 20995  ; FIX(2.562915447)
+F_3_072 equ 25172  ; FIX(3.072711026)
+%else
+; NASM cannot do compile-time arithmetic on floating-point constants.
+%define DESCALE(x, n)  (((x) + (1 << ((n) - 1))) >> (n))
+F_0_298 equ DESCALE( 320652955, 30 - CONST_BITS)  ; FIX(0.298631336)
+F_0_390 equ DESCALE( 418953276, 30 - CONST_BITS)  ; FIX(0.390180644)
+F_0_541 equ DESCALE( 581104887, 30 - CONST_BITS)  ; FIX(0.541196100)
+F_0_765 equ DESCALE( 821806413, 30 - CONST_BITS)  ; FIX(0.765366865)
+F_0_899 equ DESCALE( 966342111, 30 - CONST_BITS)  ; FIX(0.899976223)
+F_1_000 equ (1 << CONST_BITS)                     ; FIX(1.000000000)
+F_1_175 equ DESCALE(1262586813, 30 - CONST_BITS)  ; FIX(1.175875602)
+F_1_501 equ DESCALE(1612031267, 30 - CONST_BITS)  ; FIX(1.501321110)
+F_1_847 equ DESCALE(1984016188, 30 - CONST_BITS)  ; FIX(1.847759065)
+F_1_961 equ DESCALE(2106220350, 30 - CONST_BITS)  ; FIX(1.961570560)
+F_2_053 equ DESCALE(2204520673, 30 - CONST_BITS)  ; FIX(2.053119869)
+F_2_562 equ DESCALE(2751909506, 30 - CONST_BITS)  ; FIX(2.562915447)
+F_3_072 equ DESCALE(3299298341, 30 - CONST_BITS)  ; FIX(3.072711026)
+%endif
+
+; Diagonal terms of the folded odd-part matrix (see DODCT)
+F_DATA7_IN4 equ (F_0_298 - F_0_899 - F_1_961 + F_1_175)
+F_DATA5_IN5 equ (F_2_053 - F_2_562 - F_0_390 + F_1_175)
+F_DATA3_IN6 equ (F_3_072 - F_2_562 - F_1_961 + F_1_175)
+F_DATA1_IN7 equ (F_1_501 - F_0_899 - F_0_390 + F_1_175)
+
+; --------------------------------------------------------------------------
+; In-place 8x8x16-bit accurate integer forward DCT using AVX-512 instructions
+; %1-%2: Input/output registers
+; %3-%8: Temp registers
+; %9:    Pass (1 or 2)
+;
+; On input, %1 and %2 contain the 64 samples in the order expected by
+; PB_GATHER_P%9.  On output,
+;   %1 = (00 01 02 03 20 21 22 23  04 05 06 07 24 25 26 27
+;         40 41 42 43 60 61 62 63  44 45 46 47 64 65 66 67)
+;   %2 = (10 11 12 13 70 71 72 73  14 15 16 17 74 75 76 77
+;         30 31 32 33 50 51 52 53  34 35 36 37 54 55 56 57)
+; where the first digit is the output index (the column index in Pass 1, the
+; row index in Pass 2) and the second digit is the row (Pass 1) or column
+; (Pass 2) being transformed.
+
+%macro DODCT 9
+    vprold      %3, %1, 16
+    vprold      %4, %2, 16
+    vpmovzxbd   %5, [rel PB_GATHER_P %+ %9 + 0 * SIZEOF_XMMWORD]
+    vpmovzxbd   %6, [rel PB_GATHER_P %+ %9 + 1 * SIZEOF_XMMWORD]
+    vpmovzxbd   %7, [rel PB_GATHER_P %+ %9 + 2 * SIZEOF_XMMWORD]
+    vpmovzxbd   %8, [rel PB_GATHER_P %+ %9 + 3 * SIZEOF_XMMWORD]
+    vpermi2d    %5, %1, %2              ; %5 = in01_01
+    vpermi2d    %6, %1, %2              ; %6 = in45_45
+    vpermi2d    %7, %3, %4              ; %7 = in76_76
+    vpermi2d    %8, %3, %4              ; %8 = in32_32
+
+    vpaddw      %1, %5, %7              ; %1 = in01 + in76 = tmp0_1
+    vpsubw      %5, %5, %7              ; %5 = in01 - in76 = tmp7_6
+    vpaddw      %2, %8, %6              ; %2 = in32 + in45 = tmp3_2
+    vpsubw      %8, %8, %6              ; %8 = in32 - in45 = tmp4_5
+
+    ; -- Even part
+
+    ; (Original)
+    ; z1 = (tmp12 + tmp13) * 0.541196100;
+    ; data2 = z1 + tmp13 * 0.765366865;
+    ; data6 = z1 + tmp12 * -1.847759065;
+    ;
+    ; (This implementation)
+    ; data2 = tmp13 * (0.541196100 + 0.765366865) + tmp12 * 0.541196100;
+    ; data6 = tmp13 * 0.541196100 + tmp12 * (0.541196100 - 1.847759065);
+    ;
+    ; data0 and data4 are computed with a multiplier of 1.0, so that all
+    ; outputs can be descaled in the same way.
+
+    vpaddw      %3, %1, %2              ; %3 = tmp0_1 + tmp3_2 = tmp10_11
+    vpsubw      %4, %1, %2              ; %4 = tmp0_1 - tmp3_2 = tmp13_12
+    vpmaddwd    %3, %3, [rel PW_F100_F100_F100_MF100]  ; %3 = data0_4
+    vpmaddwd    %4, %4, [rel PW_F130_F054_F054_MF130]  ; %4 = data2_6
+
+    ; -- Odd part
+
+    ; (Original)
+    ; z1 = tmp4 + tmp7;  z2 = tmp5 + tmp6;
+    ; z3 = tmp4 + tmp6;  z4 = tmp5 + tmp7;
+    ; z5 = (z3 + z4) * 1.175875602;
+    ; tmp4 = tmp4 * 0.298631336;  tmp5 = tmp5 * 2.053119869;
+    ; tmp6 = tmp6 * 3.072711026;  tmp7 = tmp7 * 1.501321110;
+    ; z1 = z1 * -0.899976223;  z2 = z2 * -2.562915447;
+    ; z3 = z3 * -1.961570560;  z4 = z4 * -0.390180644;
+    ; z3 += z5;  z4 += z5;
+    ; data7 = tmp4 + z1 + z3;  data5 = tmp5 + z2 + z4;
+    ; data3 = tmp6 + z2 + z3;  data1 = tmp7 + z1 + z4;
+    ;
+    ; (This implementation)
+    ; data1 = tmp4 * (1.175875602 - 0.899976223) +
+    ;         tmp5 * (1.175875602 - 0.390180644) + tmp6 * 1.175875602 +
+    ;         tmp7 * (1.501321110 - 0.899976223 - 0.390180644 + 1.175875602);
+    ; data3 = tmp4 * (1.175875602 - 1.961570560) +
+    ;         tmp5 * (1.175875602 - 2.562915447) +
+    ;         tmp6 * (3.072711026 - 2.562915447 - 1.961570560 + 1.175875602) +
+    ;         tmp7 * 1.175875602;
+    ; data5 = tmp4 * 1.175875602 +
+    ;         tmp5 * (2.053119869 - 2.562915447 - 0.390180644 + 1.175875602) +
+    ;         tmp6 * (1.175875602 - 2.562915447) +
+    ;         tmp7 * (1.175875602 - 0.390180644);
+    ; data7 = tmp4 * (0.298631336 - 0.899976223 - 1.961570560 + 1.175875602) +
+    ;         tmp5 * 1.175875602 + tmp6 * (1.175875602 - 1.961570560) +
+    ;         tmp7 * (1.175875602 - 0.899976223);
+
+    vpmaddwd    %1, %8, [rel PW_F028_F079_MF079_MF139]
+    vpmaddwd    %2, %5, [rel PW_F139_F118_F118_MF028]
+    vpmaddwd    %8, %8, [rel PW_MF139_F118_F118_F028]
+    vpmaddwd    %5, %5, [rel PW_F028_MF079_F079_MF139]
+    vpaddd      %1, %1, %2              ; %1 = data1_3
+    vpaddd      %8, %8, %5              ; %8 = data7_5
+
+    ; -- Descale and pack
+
+    vpbroadcastd %2, [rel PD_DESCALE_P %+ %9]
+    vpaddd      %3, %3, %2
+    vpaddd      %4, %4, %2
+    vpaddd      %1, %1, %2
+    vpaddd      %8, %8, %2
+    vpsrad      %3, %3, DESCALE_P %+ %9
+    vpsrad      %4, %4, DESCALE_P %+ %9
+    vpsrad      %1, %1, DESCALE_P %+ %9
+    vpsrad      %8, %8, DESCALE_P %+ %9
+
+    vpackssdw   %2, %1, %8              ; %2 = data1_7_3_5
+    vpackssdw   %1, %3, %4              ; %1 = data0_2_4_6
+%endmacro
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      64
+    GLOBAL_DATA(jconst_fdct_islow_avx512)
+
+EXTN(jconst_fdct_islow_avx512):
+
+PW_F100_F100_F100_MF100    times 8  dw  F_1_000,  F_1_000
+                           times 8  dw  F_1_000, -F_1_000
+PW_F130_F054_F054_MF130    times 8  dw  (F_0_541 + F_0_765),  F_0_541
+                           times 8  dw  F_0_541, (F_0_541 - F_1_847)
+PW_F028_F079_MF079_MF139   times 8  dw  (F_1_175 - F_0_899), (F_1_175 - F_0_390)
+                           times 8  dw  (F_1_175 - F_1_961), (F_1_175 - F_2_562)
+PW_F139_F118_F118_MF028    times 8  dw  F_DATA1_IN7, F_1_175
+                           times 8  dw  F_1_175, F_DATA3_IN6
+PW_MF139_F118_F118_F028    times 8  dw  F_DATA7_IN4, F_1_175
+                           times 8  dw  F_1_175, F_DATA5_IN5
+PW_F028_MF079_F079_MF139   times 8  dw  (F_1_175 - F_0_899), (F_1_175 - F_1_961)
+                           times 8  dw  (F_1_175 - F_0_390), (F_1_175 - F_2_562)
+
+    ; Doubleword gather indices for (in0, in1), (in4, in5), (in7, in6), and
+    ; (in3, in2)
+
+PB_GATHER_P1               db   0,  4,  8, 12, 16, 20, 24, 28
+                           db   0,  4,  8, 12, 16, 20, 24, 28
+                           db   2,  6, 10, 14, 18, 22, 26, 30
+                           db   2,  6, 10, 14, 18, 22, 26, 30
+                           db   3,  7, 11, 15, 19, 23, 27, 31
+                           db   3,  7, 11, 15, 19, 23, 27, 31
+                           db   1,  5,  9, 13, 17, 21, 25, 29
+                           db   1,  5,  9, 13, 17, 21, 25, 29
+PB_GATHER_P2               db   0, 16,  2, 24,  8, 26, 10, 18
+                           db   0, 16,  2, 24,  8, 26, 10, 18
+                           db   4, 20,  6, 28, 12, 30, 14, 22
+                           db   4, 20,  6, 28, 12, 30, 14, 22
+                           db   5, 21,  7, 29, 13, 31, 15, 23
+                           db   5, 21,  7, 29, 13, 31, 15, 23
+                           db   1, 17,  3, 25,  9, 27, 11, 19
+                           db   1, 17,  3, 25,  9, 27, 11, 19
+
+    ; Quadword permutation indices for restoring the natural order
+
+PB_TRANSPOSE               db   0,  2,  8, 10,  1,  3, 12, 14
+                           db   4,  6, 13, 15,  5,  7,  9, 11
+PD_DESCALE_P1              dd  1 << (DESCALE_P1 - 1)
+PD_DESCALE_P2              dd  1 << (DESCALE_P2 - 1)
+
+    ALIGNZ      64
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Perform the forward DCT on one block of samples.
+;
+; GLOBAL(void)
+; jsimd_fdct_islow_avx512(DCTELEM *data)
+;
+; r10 = DCTELEM *data
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_fdct_islow_avx512)
+
+EXTN(jsimd_fdct_islow_avx512):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 1
+
+    ; ---- Pass 1: process rows.
+
+    vmovdqu64   zmm0, ZMMWORD [ZMMBLOCK(0, 0, r10, SIZEOF_DCTELEM)]
+                ; zmm0 = (00 01 02 03 04 05 06 07 ... 30 31 32 33 34 35 36 37)
+    vmovdqu64   zmm1, ZMMWORD [ZMMBLOCK(4, 0, r10, SIZEOF_DCTELEM)]
+                ; zmm1 = (40 41 42 43 44 45 46 47 ... 70 71 72 73 74 75 76 77)
+
+    DODCT       zmm0, zmm1, zmm16, zmm17, zmm18, zmm19, zmm20, zmm21, 1
+                ; zmm0 = data0_2_4_6, zmm1 = data1_7_3_5
+
+    ; ---- Pass 2: process columns.
+
+    DODCT       zmm0, zmm1, zmm16, zmm17, zmm18, zmm19, zmm20, zmm21, 2
+                ; zmm0 = data0_2_4_6, zmm1 = data1_7_3_5
+
+    vpmovzxbq   zmm2, [rel PB_TRANSPOSE + 0 * SIZEOF_MMWORD]
+    vpmovzxbq   zmm3, [rel PB_TRANSPOSE + 1 * SIZEOF_MMWORD]
+    vpermi2q    zmm2, zmm0, zmm1        ; zmm2 = data0_1_2_3
+    vpermi2q    zmm3, zmm0, zmm1        ; zmm3 = data4_5_6_7
+
+    vmovdqu64   ZMMWORD [ZMMBLOCK(0, 0, r10, SIZEOF_DCTELEM)], zmm2
+    vmovdqu64   ZMMWORD [ZMMBLOCK(4, 0, r10, SIZEOF_DCTELEM)], zmm3
+
+    vzeroupper
+    UNCOLLECT_ARGS 1
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
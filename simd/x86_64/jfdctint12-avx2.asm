@@ -0,0 +1,269 @@
+;
+; Accurate Integer Forward DCT (64-bit AVX2, 12-bit samples)
+;
+; Copyright (C) 2026, D. R. Commander.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+;
+; This file contains a slower but more accurate integer implementation of the
+; forward DCT (Discrete Cosine Transform).  The following code is based
+; directly on the IJG's original jfdctint.c; see jfdctint.c for more details.
+;
+; With 12-bit samples, the intermediate values require 32 bits, so this
+; implementation operates on eight 32-bit DCTELEMs per register and uses
+; vpmulld rather than vpmaddwd for the multiplications.
+
+%include "jsimdext.inc"
+%include "jdct.inc"
+
+; --------------------------------------------------------------------------
+
+%define CONST_BITS  13
+%define PASS1_BITS  1
+
+%define DESCALE_P1  (CONST_BITS - PASS1_BITS)
+%define DESCALE_P2  (CONST_BITS + PASS1_BITS)
+
+F_0_298 equ  2446  ; FIX(0.298631336)
+F_0_390 equ  3196  ; FIX(0.390180644)
+F_0_541 equ  4433  ; FIX(0.541196100)
+F_0_765 equ  6270  ; FIX(0.765366865)
+F_0_899 equ  7373  ; FIX(0.899976223)
+F_1_175 equ  9633  ; FIX(1.175875602)
+F_1_501 equ 12299  ; FIX(1.501321110)
+F_1_847 equ 15137  ; FIX(1.847759065)
+F_1_961 equ 16069  ; FIX(1.961570560)
+F_2_053 equ 16819  ; FIX(2.053119869)
+F_2_562 equ 20995  ; FIX(2.562915447)
+F_3_072 equ 25172  ; FIX(3.072711026)
+
+; --------------------------------------------------------------------------
+; In-place 8x8x32-bit matrix transpose using AVX2 instructions
+; %1-%8:  Input registers (rows 0-7)
+; %9-%16: Output registers (columns 0-7)
+
+%macro DOTRANSPOSE 16
+    ; %1 = (00 01 02 03 04 05 06 07), %2 = (10 11 12 13 14 15 16 17), ...
+
+    ; transpose coefficients(phase 1)
+    vpunpckldq  %9, %1, %2              ; %9  = (00 10 01 11 04 14 05 15)
+    vpunpckhdq  %10, %1, %2             ; %10 = (02 12 03 13 06 16 07 17)
+    vpunpckldq  %11, %3, %4             ; %11 = (20 30 21 31 24 34 25 35)
+    vpunpckhdq  %12, %3, %4             ; %12 = (22 32 23 33 26 36 27 37)
+    vpunpckldq  %13, %5, %6             ; %13 = (40 50 41 51 44 54 45 55)
+    vpunpckhdq  %14, %5, %6             ; %14 = (42 52 43 53 46 56 47 57)
+    vpunpckldq  %15, %7, %8             ; %15 = (60 70 61 71 64 74 65 75)
+    vpunpckhdq  %16, %7, %8             ; %16 = (62 72 63 73 66 76 67 77)
+
+    ; transpose coefficients(phase 2)
+    vpunpcklqdq %1, %9, %11             ; %1 = (00 10 20 30 04 14 24 34)
+    vpunpckhqdq %2, %9, %11             ; %2 = (01 11 21 31 05 15 25 35)
+    vpunpcklqdq %3, %10, %12            ; %3 = (02 12 22 32 06 16 26 36)
+    vpunpckhqdq %4, %10, %12            ; %4 = (03 13 23 33 07 17 27 37)
+    vpunpcklqdq %5, %13, %15            ; %5 = (40 50 60 70 44 54 64 74)
+    vpunpckhqdq %6, %13, %15            ; %6 = (41 51 61 71 45 55 65 75)
+    vpunpcklqdq %7, %14, %16            ; %7 = (42 52 62 72 46 56 66 76)
+    vpunpckhqdq %8, %14, %16            ; %8 = (43 53 63 73 47 57 67 77)
+
+    ; transpose coefficients(phase 3)
+    vperm2i128  %9, %1, %5, 0x20        ; %9  = (00 10 20 30 40 50 60 70)
+    vperm2i128  %13, %1, %5, 0x31       ; %13 = (04 14 24 34 44 54 64 74)
+    vperm2i128  %10, %2, %6, 0x20       ; %10 = (01 11 21 31 41 51 61 71)
+    vperm2i128  %14, %2, %6, 0x31       ; %14 = (05 15 25 35 45 55 65 75)
+    vperm2i128  %11, %3, %7, 0x20       ; %11 = (02 12 22 32 42 52 62 72)
+    vperm2i128  %15, %3, %7, 0x31       ; %15 = (06 16 26 36 46 56 66 76)
+    vperm2i128  %12, %4, %8, 0x20       ; %12 = (03 13 23 33 43 53 63 73)
+    vperm2i128  %16, %4, %8, 0x31       ; %16 = (07 17 27 37 47 57 67 77)
+%endmacro
+
+; --------------------------------------------------------------------------
+; In-place 8x8x32-bit accurate integer forward DCT using AVX2 instructions
+; %1-%8:  Input registers (data0-data7)
+; %9-%16: Temp registers
+; %17:    Pass (1 or 2)
+;
+; Output: %5 = data0, %16 = data1, %2 = data2, %15 = data3, %6 = data4,
+;         %14 = data5, %4 = data6, %13 = data7
+
+%macro DODCT 17
+    vpaddd      %9, %1, %8              ; %9  = data0 + data7 = tmp0
+    vpsubd      %16, %1, %8             ; %16 = data0 - data7 = tmp7
+    vpaddd      %10, %2, %7             ; %10 = data1 + data6 = tmp1
+    vpsubd      %15, %2, %7             ; %15 = data1 - data6 = tmp6
+    vpaddd      %11, %3, %6             ; %11 = data2 + data5 = tmp2
+    vpsubd      %14, %3, %6             ; %14 = data2 - data5 = tmp5
+    vpaddd      %12, %4, %5             ; %12 = data3 + data4 = tmp3
+    vpsubd      %13, %4, %5             ; %13 = data3 - data4 = tmp4
+
+    vmovdqa     %8, [rel PD_DESCALE_P %+ %17]
+
+    ; -- Even part
+
+    vpaddd      %1, %9, %12             ; %1 = tmp0 + tmp3 = tmp10
+    vpsubd      %2, %9, %12             ; %2 = tmp0 - tmp3 = tmp13
+    vpaddd      %3, %10, %11            ; %3 = tmp1 + tmp2 = tmp11
+    vpsubd      %4, %10, %11            ; %4 = tmp1 - tmp2 = tmp12
+
+    vpaddd      %5, %1, %3              ; %5 = tmp10 + tmp11
+    vpsubd      %6, %1, %3              ; %6 = tmp10 - tmp11
+%if %17 == 1
+    vpslld      %5, %5, PASS1_BITS      ; %5 = data0
+    vpslld      %6, %6, PASS1_BITS      ; %6 = data4
+%else
+    vmovdqa     %7, [rel PD_DESCALE_P2X]
+    vpaddd      %5, %5, %7
+    vpaddd      %6, %6, %7
+    vpsrad      %5, %5, PASS1_BITS      ; %5 = data0
+    vpsrad      %6, %6, PASS1_BITS      ; %6 = data4
+%endif
+
+    vpaddd      %7, %4, %2
+    vpmulld     %7, %7, [rel PD_F054]   ; %7 = z1
+    vpmulld     %2, %2, [rel PD_F076]
+    vpmulld     %4, %4, [rel PD_MF184]
+    vpaddd      %2, %2, %7              ; %2 = z1 + tmp13 * 0.765366865
+    vpaddd      %4, %4, %7              ; %4 = z1 + tmp12 * -1.847759065
+
+    vpaddd      %2, %2, %8
+    vpaddd      %4, %4, %8
+    vpsrad      %2, %2, DESCALE_P %+ %17  ; %2 = data2
+    vpsrad      %4, %4, DESCALE_P %+ %17  ; %4 = data6
+
+    ; -- Odd part
+
+    vpaddd      %1, %13, %16            ; %1 = tmp4 + tmp7 = z1
+    vpaddd      %3, %14, %15            ; %3 = tmp5 + tmp6 = z2
+    vpaddd      %7, %13, %15            ; %7 = tmp4 + tmp6 = z3
+    vpaddd      %9, %14, %16            ; %9 = tmp5 + tmp7 = z4
+    vpaddd      %10, %7, %9
+    vpmulld     %10, %10, [rel PD_F117]  ; %10 = z5
+
+    vpmulld     %13, %13, [rel PD_F029]  ; %13 = tmp4
+    vpmulld     %14, %14, [rel PD_F205]  ; %14 = tmp5
+    vpmulld     %15, %15, [rel PD_F307]  ; %15 = tmp6
+    vpmulld     %16, %16, [rel PD_F150]  ; %16 = tmp7
+    vpmulld     %1, %1, [rel PD_MF089]   ; %1 = z1
+    vpmulld     %3, %3, [rel PD_MF256]   ; %3 = z2
+    vpmulld     %7, %7, [rel PD_MF196]   ; %7 = z3
+    vpmulld     %9, %9, [rel PD_MF039]   ; %9 = z4
+
+    vpaddd      %7, %7, %10             ; %7 = z3 + z5
+    vpaddd      %9, %9, %10             ; %9 = z4 + z5
+
+    vpaddd      %13, %13, %1
+    vpaddd      %14, %14, %3
+    vpaddd      %15, %15, %3
+    vpaddd      %16, %16, %1
+    vpaddd      %13, %13, %7            ; %13 = tmp4 + z1 + z3
+    vpaddd      %14, %14, %9            ; %14 = tmp5 + z2 + z4
+    vpaddd      %15, %15, %7            ; %15 = tmp6 + z2 + z3
+    vpaddd      %16, %16, %9            ; %16 = tmp7 + z1 + z4
+
+    vpaddd      %13, %13, %8
+    vpaddd      %14, %14, %8
+    vpaddd      %15, %15, %8
+    vpaddd      %16, %16, %8
+    vpsrad      %13, %13, DESCALE_P %+ %17  ; %13 = data7
+    vpsrad      %14, %14, DESCALE_P %+ %17  ; %14 = data5
+    vpsrad      %15, %15, DESCALE_P %+ %17  ; %15 = data3
+    vpsrad      %16, %16, DESCALE_P %+ %17  ; %16 = data1
+%endmacro
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      32
+    GLOBAL_DATA(jconst12_fdct_islow_avx2)
+
+EXTN(jconst12_fdct_islow_avx2):
+
+PD_F029        times 8 dd  F_0_298
+PD_MF039       times 8 dd -F_0_390
+PD_F054        times 8 dd  F_0_541
+PD_F076        times 8 dd  F_0_765
+PD_MF089       times 8 dd -F_0_899
+PD_F117        times 8 dd  F_1_175
+PD_F150        times 8 dd  F_1_501
+PD_MF184       times 8 dd -F_1_847
+PD_MF196       times 8 dd -F_1_961
+PD_F205        times 8 dd  F_2_053
+PD_MF256       times 8 dd -F_2_562
+PD_F307        times 8 dd  F_3_072
+PD_DESCALE_P1  times 8 dd  1 << (DESCALE_P1 - 1)
+PD_DESCALE_P2  times 8 dd  1 << (DESCALE_P2 - 1)
+PD_DESCALE_P2X times 8 dd  1 << (PASS1_BITS - 1)
+
+    ALIGNZ      32
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Perform the forward DCT on one block of samples.
+;
+; GLOBAL(void)
+; jsimd12_fdct_islow_avx2(int *data)
+;
+; r10 = int *data
+
+    align       32
+    GLOBAL_FUNCTION(jsimd12_fdct_islow_avx2)
+
+EXTN(jsimd12_fdct_islow_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    PUSH_XMM    8
+    COLLECT_ARGS 1
+
+    ; ---- Pass 1: process rows.
+
+    vmovdqu     ymm0, YMMWORD [YMMBLOCK(0, 0, r10, SIZEOF_J12DCTELEM)]
+    vmovdqu     ymm1, YMMWORD [YMMBLOCK(1, 0, r10, SIZEOF_J12DCTELEM)]
+    vmovdqu     ymm2, YMMWORD [YMMBLOCK(2, 0, r10, SIZEOF_J12DCTELEM)]
+    vmovdqu     ymm3, YMMWORD [YMMBLOCK(3, 0, r10, SIZEOF_J12DCTELEM)]
+    vmovdqu     ymm4, YMMWORD [YMMBLOCK(4, 0, r10, SIZEOF_J12DCTELEM)]
+    vmovdqu     ymm5, YMMWORD [YMMBLOCK(5, 0, r10, SIZEOF_J12DCTELEM)]
+    vmovdqu     ymm6, YMMWORD [YMMBLOCK(6, 0, r10, SIZEOF_J12DCTELEM)]
+    vmovdqu     ymm7, YMMWORD [YMMBLOCK(7, 0, r10, SIZEOF_J12DCTELEM)]
+
+    DOTRANSPOSE ymm0, ymm1, ymm2, ymm3, ymm4, ymm5, ymm6, ymm7, \
+                ymm8, ymm9, ymm10, ymm11, ymm12, ymm13, ymm14, ymm15
+
+    DODCT       ymm8, ymm9, ymm10, ymm11, ymm12, ymm13, ymm14, ymm15, \
+                ymm0, ymm1, ymm2, ymm3, ymm4, ymm5, ymm6, ymm7, 1
+                ; ymm12 = data0, ymm7 = data1, ymm9 = data2, ymm6 = data3,
+                ; ymm13 = data4, ymm5 = data5, ymm11 = data6, ymm4 = data7
+
+    ; ---- Pass 2: process columns.
+
+    DOTRANSPOSE ymm12, ymm7, ymm9, ymm6, ymm13, ymm5, ymm11, ymm4, \
+                ymm8, ymm10, ymm14, ymm15, ymm0, ymm1, ymm2, ymm3
+
+    DODCT       ymm8, ymm10, ymm14, ymm15, ymm0, ymm1, ymm2, ymm3, \
+                ymm12, ymm7, ymm9, ymm6, ymm13, ymm5, ymm11, ymm4, 2
+                ; ymm0 = data0, ymm4 = data1, ymm10 = data2, ymm11 = data3,
+                ; ymm1 = data4, ymm5 = data5, ymm15 = data6, ymm13 = data7
+
+    vmovdqu     YMMWORD [YMMBLOCK(0, 0, r10, SIZEOF_J12DCTELEM)], ymm0
+    vmovdqu     YMMWORD [YMMBLOCK(1, 0, r10, SIZEOF_J12DCTELEM)], ymm4
+    vmovdqu     YMMWORD [YMMBLOCK(2, 0, r10, SIZEOF_J12DCTELEM)], ymm10
+    vmovdqu     YMMWORD [YMMBLOCK(3, 0, r10, SIZEOF_J12DCTELEM)], ymm11
+    vmovdqu     YMMWORD [YMMBLOCK(4, 0, r10, SIZEOF_J12DCTELEM)], ymm1
+    vmovdqu     YMMWORD [YMMBLOCK(5, 0, r10, SIZEOF_J12DCTELEM)], ymm5
+    vmovdqu     YMMWORD [YMMBLOCK(6, 0, r10, SIZEOF_J12DCTELEM)], ymm15
+    vmovdqu     YMMWORD [YMMBLOCK(7, 0, r10, SIZEOF_J12DCTELEM)], ymm13
+
+    vzeroupper
+    UNCOLLECT_ARGS 1
+    POP_XMM     8
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
@@ -0,0 +1,353 @@
+;
+; Floating Point Inverse DCT (64-bit AVX2)
+;
+; Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
+; Copyright (C) 2009, 2016, 2024-2026, D. R. Commander.
+; Copyright (C) 2018, Matthias Räncker.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+;
+; This file contains a floating-point implementation of the inverse DCT
+; (Discrete Cosine Transform).  The following code is based directly on the
+; IJG's original jidctflt.c; see jidctflt.c for more details.
+;
+; Each ymm register holds one row or column of eight floats, so the whole
+; block fits in registers, and no workspace is needed.  FMA instructions are
+; deliberately not used, so the results are identical to those of the SSE2
+; implementation.
+
+%include "jsimdext.inc"
+%include "jdct.inc"
+
+; --------------------------------------------------------------------------
+
+; In-place 8x8x32-bit matrix transpose using AVX instructions
+; %1-%8: Input/output registers
+; %9: Temp register
+;
+; On input, %1-%8 contain rows 0-7.  On output, columns 0-7 are in %3, %4, %1,
+; %2, %8, %9, %6, and %7 (respectively), and %5 is free.
+
+%macro DOTRANSPOSE 9
+    ; %1 = (00 01 02 03 04 05 06 07), %2 = (10 11 12 13 14 15 16 17), ...
+    vperm2f128  %9, %1, %5, 0x20        ; %9 = (00 01 02 03 40 41 42 43)
+    vperm2f128  %5, %1, %5, 0x31        ; %5 = (04 05 06 07 44 45 46 47)
+    vperm2f128  %1, %2, %6, 0x20        ; %1 = (10 11 12 13 50 51 52 53)
+    vperm2f128  %6, %2, %6, 0x31        ; %6 = (14 15 16 17 54 55 56 57)
+    vperm2f128  %2, %3, %7, 0x20        ; %2 = (20 21 22 23 60 61 62 63)
+    vperm2f128  %7, %3, %7, 0x31        ; %7 = (24 25 26 27 64 65 66 67)
+    vperm2f128  %3, %4, %8, 0x20        ; %3 = (30 31 32 33 70 71 72 73)
+    vperm2f128  %8, %4, %8, 0x31        ; %8 = (34 35 36 37 74 75 76 77)
+
+    vunpcklps   %4, %9, %1              ; %4 = (00 10 01 11 40 50 41 51)
+    vunpckhps   %9, %9, %1              ; %9 = (02 12 03 13 42 52 43 53)
+    vunpcklps   %1, %2, %3              ; %1 = (20 30 21 31 60 70 61 71)
+    vunpckhps   %2, %2, %3              ; %2 = (22 32 23 33 62 72 63 73)
+    vshufps     %3, %4, %1, 0x44        ; %3 = (00 10 20 30 40 50 60 70)
+    vshufps     %4, %4, %1, 0xEE        ; %4 = (01 11 21 31 41 51 61 71)
+    vshufps     %1, %9, %2, 0x44        ; %1 = (02 12 22 32 42 52 62 72)
+    vshufps     %2, %9, %2, 0xEE        ; %2 = (03 13 23 33 43 53 63 73)
+
+    vunpcklps   %9, %5, %6              ; %9 = (04 14 05 15 44 54 45 55)
+    vunpckhps   %5, %5, %6              ; %5 = (06 16 07 17 46 56 47 57)
+    vunpcklps   %6, %7, %8              ; %6 = (24 34 25 35 64 74 65 75)
+    vunpckhps   %7, %7, %8              ; %7 = (26 36 27 37 66 76 67 77)
+    vshufps     %8, %9, %6, 0x44        ; %8 = (04 14 24 34 44 54 64 74)
+    vshufps     %9, %9, %6, 0xEE        ; %9 = (05 15 25 35 45 55 65 75)
+    vshufps     %6, %5, %7, 0x44        ; %6 = (06 16 26 36 46 56 66 76)
+    vshufps     %7, %5, %7, 0xEE        ; %7 = (07 17 27 37 47 57 67 77)
+%endmacro
+
+; --------------------------------------------------------------------------
+
+; In-place 8-point floating point IDCT
+; %1-%8: Input/output registers
+; %9: Temp register
+;
+; On input, %1-%8 contain in0-in7.  On output, data0-data7 are in %7, %5, %1,
+; %8, %9, %6, %4, and %3 (respectively), and %2 is free.
+
+%macro DODCT 9
+    ; -- Even part
+
+    vaddps      %9, %1, %5              ; %9 = tmp10
+    vsubps      %1, %1, %5              ; %1 = tmp11
+    vaddps      %5, %3, %7              ; %5 = tmp13
+    vsubps      %3, %3, %7
+
+    vmulps      %3, %3, [rel PD_1_414]
+    vsubps      %3, %3, %5              ; %3 = tmp12
+
+    vaddps      %7, %9, %5              ; %7 = tmp0
+    vsubps      %9, %9, %5              ; %9 = tmp3
+    vaddps      %5, %1, %3              ; %5 = tmp1
+    vsubps      %1, %1, %3              ; %1 = tmp2
+
+    ; -- Odd part
+
+    vaddps      %3, %6, %4              ; %3 = z13
+    vsubps      %6, %6, %4              ; %6 = z10
+    vaddps      %4, %2, %8              ; %4 = z11
+    vsubps      %2, %2, %8              ; %2 = z12
+
+    vsubps      %8, %4, %3
+    vaddps      %4, %4, %3              ; %4 = tmp7
+
+    vmulps      %8, %8, [rel PD_1_414]  ; %8 = tmp11
+
+    vaddps      %3, %6, %2
+    vmulps      %3, %3, [rel PD_1_847]  ; %3 = z5
+    vmulps      %6, %6, [rel PD_M2_613] ; %6 = (z10 * -2.613125930)
+    vmulps      %2, %2, [rel PD_1_082]  ; %2 = (z12 * 1.082392200)
+    vaddps      %6, %6, %3              ; %6 = tmp12
+    vsubps      %2, %2, %3              ; %2 = tmp10
+
+    ; -- Final output stage
+
+    vsubps      %6, %6, %4              ; %6 = tmp6
+    vsubps      %8, %8, %6              ; %8 = tmp5
+    vaddps      %2, %2, %8              ; %2 = tmp4
+
+    vsubps      %3, %7, %4              ; %3 = data7
+    vaddps      %7, %7, %4              ; %7 = data0
+    vsubps      %4, %5, %6              ; %4 = data6
+    vaddps      %5, %5, %6              ; %5 = data1
+    vsubps      %6, %1, %8              ; %6 = data5
+    vaddps      %1, %1, %8              ; %1 = data2
+    vsubps      %8, %9, %2              ; %8 = data3
+    vaddps      %9, %9, %2              ; %9 = data4
+%endmacro
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      32
+    GLOBAL_DATA(jconst_idct_float_avx2)
+
+EXTN(jconst_idct_float_avx2):
+
+PD_1_414        times 8  dd  1.414213562373095048801689
+PD_1_847        times 8  dd  1.847759065022573512256366
+PD_1_082        times 8  dd  1.082392200292393968799446
+PD_M2_613       times 8  dd -2.613125929752753055713286
+PD_RNDINT_MAGIC times 8  dd  100663296.0  ; (float)(0x00C00000 << 3)
+PB_CENTERJSAMP  times 32 db  CENTERJSAMPLE
+
+    ALIGNZ      32
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Perform dequantization and inverse DCT on one block of coefficients.
+;
+; GLOBAL(void)
+; jsimd_idct_float_avx2(void *dct_table, JCOEFPTR coef_block,
+;                       JSAMPARRAY output_buf, JDIMENSION output_col)
+;
+; r10 = void *dct_table
+; r11 = JCOEFPTR coef_block
+; r12 = JSAMPARRAY output_buf
+; r13d = JDIMENSION output_col
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_idct_float_avx2)
+
+EXTN(jsimd_idct_float_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    PUSH_XMM    1
+    COLLECT_ARGS 4
+
+    ; ---- Pass 1: process columns.
+
+%ifndef NO_ZERO_COLUMN_TEST_FLOAT_AVX2
+    mov         eax, dword [DWBLOCK(1, 0, r11, SIZEOF_JCOEF)]
+    or          eax, dword [DWBLOCK(2, 0, r11, SIZEOF_JCOEF)]
+    jnz         near .columnDCT
+
+    movdqa      xmm0, XMMWORD [XMMBLOCK(1, 0, r11, SIZEOF_JCOEF)]
+    movdqa      xmm1, XMMWORD [XMMBLOCK(2, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm0, xmm0, XMMWORD [XMMBLOCK(3, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm1, xmm1, XMMWORD [XMMBLOCK(4, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm0, xmm0, XMMWORD [XMMBLOCK(5, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm1, xmm1, XMMWORD [XMMBLOCK(6, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm0, xmm0, XMMWORD [XMMBLOCK(7, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm1, xmm1, xmm0
+    vpacksswb   xmm1, xmm1, xmm1
+    vpacksswb   xmm1, xmm1, xmm1
+    movd        eax, xmm1
+    test        rax, rax
+    jnz         short .columnDCT
+
+    ; -- AC terms all zero
+
+    vpmovsxwd   ymm8, XMMWORD [XMMBLOCK(0, 0, r11, SIZEOF_JCOEF)]
+    vcvtdq2ps   ymm8, ymm8
+    vmulps      ymm8, ymm8, YMMWORD [YMMBLOCK(0, 0, r10, SIZEOF_FLOAT_MULT_TYPE)]
+                ; ymm8 = in0 = (00 01 02 03 04 05 06 07)
+
+    vperm2f128  ymm1, ymm8, ymm8, 0x00  ; ymm1 = (00 01 02 03 00 01 02 03)
+    vperm2f128  ymm8, ymm8, ymm8, 0x11  ; ymm8 = (04 05 06 07 04 05 06 07)
+
+    vshufps     ymm0, ymm1, ymm1, 0x00  ; ymm0 = col0 = (00 00 00 00 ..)
+    vshufps     ymm7, ymm1, ymm1, 0x55  ; ymm7 = col1 = (01 01 01 01 ..)
+    vshufps     ymm6, ymm1, ymm1, 0xAA  ; ymm6 = col2 = (02 02 02 02 ..)
+    vshufps     ymm4, ymm1, ymm1, 0xFF  ; ymm4 = col3 = (03 03 03 03 ..)
+    vshufps     ymm2, ymm8, ymm8, 0x00  ; ymm2 = col4 = (04 04 04 04 ..)
+    vshufps     ymm1, ymm8, ymm8, 0x55  ; ymm1 = col5 = (05 05 05 05 ..)
+    vshufps     ymm5, ymm8, ymm8, 0xAA  ; ymm5 = col6 = (06 06 06 06 ..)
+    vshufps     ymm3, ymm8, ymm8, 0xFF  ; ymm3 = col7 = (07 07 07 07 ..)
+
+    jmp         near .column_end
+%endif
+.columnDCT:
+
+    vpmovsxwd   ymm0, XMMWORD [XMMBLOCK(0, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm1, XMMWORD [XMMBLOCK(1, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm2, XMMWORD [XMMBLOCK(2, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm3, XMMWORD [XMMBLOCK(3, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm4, XMMWORD [XMMBLOCK(4, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm5, XMMWORD [XMMBLOCK(5, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm6, XMMWORD [XMMBLOCK(6, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm7, XMMWORD [XMMBLOCK(7, 0, r11, SIZEOF_JCOEF)]
+
+    vcvtdq2ps   ymm0, ymm0
+    vcvtdq2ps   ymm1, ymm1
+    vcvtdq2ps   ymm2, ymm2
+    vcvtdq2ps   ymm3, ymm3
+    vcvtdq2ps   ymm4, ymm4
+    vcvtdq2ps   ymm5, ymm5
+    vcvtdq2ps   ymm6, ymm6
+    vcvtdq2ps   ymm7, ymm7
+
+    vmulps      ymm0, ymm0, YMMWORD [YMMBLOCK(0, 0, r10, SIZEOF_FLOAT_MULT_TYPE)]
+    vmulps      ymm1, ymm1, YMMWORD [YMMBLOCK(1, 0, r10, SIZEOF_FLOAT_MULT_TYPE)]
+    vmulps      ymm2, ymm2, YMMWORD [YMMBLOCK(2, 0, r10, SIZEOF_FLOAT_MULT_TYPE)]
+    vmulps      ymm3, ymm3, YMMWORD [YMMBLOCK(3, 0, r10, SIZEOF_FLOAT_MULT_TYPE)]
+    vmulps      ymm4, ymm4, YMMWORD [YMMBLOCK(4, 0, r10, SIZEOF_FLOAT_MULT_TYPE)]
+    vmulps      ymm5, ymm5, YMMWORD [YMMBLOCK(5, 0, r10, SIZEOF_FLOAT_MULT_TYPE)]
+    vmulps      ymm6, ymm6, YMMWORD [YMMBLOCK(6, 0, r10, SIZEOF_FLOAT_MULT_TYPE)]
+    vmulps      ymm7, ymm7, YMMWORD [YMMBLOCK(7, 0, r10, SIZEOF_FLOAT_MULT_TYPE)]
+
+    DODCT       ymm0, ymm1, ymm2, ymm3, ymm4, ymm5, ymm6, ymm7, ymm8
+               ; ymm6 = data0, ymm4 = data1, ymm0 = data2, ymm7 = data3,
+               ; ymm8 = data4, ymm5 = data5, ymm3 = data6, ymm2 = data7
+
+    DOTRANSPOSE ymm6, ymm4, ymm0, ymm7, ymm8, ymm5, ymm3, ymm2, ymm1
+               ; ymm0 = col0, ymm7 = col1, ymm6 = col2, ymm4 = col3,
+               ; ymm2 = col4, ymm1 = col5, ymm5 = col6, ymm3 = col7
+
+.column_end:
+
+    ; -- Prefetch the next coefficient block
+
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 0 * 32]
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 1 * 32]
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 2 * 32]
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 3 * 32]
+
+    ; ---- Pass 2: process rows.
+
+    DODCT       ymm0, ymm7, ymm6, ymm4, ymm2, ymm1, ymm5, ymm3, ymm8
+               ; ymm5 = data0, ymm2 = data1, ymm0 = data2, ymm3 = data3,
+               ; ymm8 = data4, ymm1 = data5, ymm4 = data6, ymm6 = data7
+
+    vmovaps     ymm7, [rel PD_RNDINT_MAGIC]  ; ymm7 = [rel PD_RNDINT_MAGIC]
+
+    vaddps      ymm5, ymm5, ymm7
+                ; ymm5 = roundint(data0 / 8) = (00 ** 10 ** 20 ** .. 70 **)
+    vaddps      ymm2, ymm2, ymm7
+                ; ymm2 = roundint(data1 / 8) = (01 ** 11 ** 21 ** .. 71 **)
+    vaddps      ymm0, ymm0, ymm7
+                ; ymm0 = roundint(data2 / 8) = (02 ** 12 ** 22 ** .. 72 **)
+    vaddps      ymm3, ymm3, ymm7
+                ; ymm3 = roundint(data3 / 8) = (03 ** 13 ** 23 ** .. 73 **)
+    vaddps      ymm8, ymm8, ymm7
+                ; ymm8 = roundint(data4 / 8) = (04 ** 14 ** 24 ** .. 74 **)
+    vaddps      ymm1, ymm1, ymm7
+                ; ymm1 = roundint(data5 / 8) = (05 ** 15 ** 25 ** .. 75 **)
+    vaddps      ymm4, ymm4, ymm7
+                ; ymm4 = roundint(data6 / 8) = (06 ** 16 ** 26 ** .. 76 **)
+    vaddps      ymm6, ymm6, ymm7
+                ; ymm6 = roundint(data7 / 8) = (07 ** 17 ** 27 ** .. 77 **)
+
+    vpslld      ymm2, ymm2, WORD_BIT    ; ymm2 = (-- 01 -- 11 -- 21 .. -- 71)
+    vpslld      ymm3, ymm3, WORD_BIT    ; ymm3 = (-- 03 -- 13 -- 23 .. -- 73)
+    vpslld      ymm1, ymm1, WORD_BIT    ; ymm1 = (-- 05 -- 15 -- 25 .. -- 75)
+    vpslld      ymm6, ymm6, WORD_BIT    ; ymm6 = (-- 07 -- 17 -- 27 .. -- 77)
+    vpblendw    ymm5, ymm5, ymm2, 0xAA  ; ymm5 = (00 01 10 11 20 21 .. 70 71)
+    vpblendw    ymm0, ymm0, ymm3, 0xAA  ; ymm0 = (02 03 12 13 22 23 .. 72 73)
+    vpblendw    ymm8, ymm8, ymm1, 0xAA  ; ymm8 = (04 05 14 15 24 25 .. 74 75)
+    vpblendw    ymm4, ymm4, ymm6, 0xAA  ; ymm4 = (06 07 16 17 26 27 .. 76 77)
+
+    vpacksswb   ymm5, ymm5, ymm8
+           ; ymm5 = (00 01 10 11 20 21 30 31 04 05 14 15 24 25 34 35
+           ;         40 41 50 51 60 61 70 71 44 45 54 55 64 65 74 75)
+    vpacksswb   ymm0, ymm0, ymm4
+           ; ymm0 = (02 03 12 13 22 23 32 33 06 07 16 17 26 27 36 37
+           ;         42 43 52 53 62 63 72 73 46 47 56 57 66 67 76 77)
+    vpaddb      ymm5, ymm5, [rel PB_CENTERJSAMP]
+    vpaddb      ymm0, ymm0, [rel PB_CENTERJSAMP]
+
+    vpunpcklwd  ymm1, ymm5, ymm0
+           ; ymm1 = (00 01 02 03 10 11 12 13 20 21 22 23 30 31 32 33
+           ;         40 41 42 43 50 51 52 53 60 61 62 63 70 71 72 73)
+    vpunpckhwd  ymm5, ymm5, ymm0
+           ; ymm5 = (04 05 06 07 14 15 16 17 24 25 26 27 34 35 36 37
+           ;         44 45 46 47 54 55 56 57 64 65 66 67 74 75 76 77)
+
+    vpunpckldq  ymm0, ymm1, ymm5        ; ymm0 = data01_45
+    vpunpckhdq  ymm1, ymm1, ymm5        ; ymm1 = data23_67
+
+    vextracti128 xmm6, ymm1, 1          ; xmm6 = data67
+    vextracti128 xmm4, ymm0, 1          ; xmm4 = data45
+    vextracti128 xmm2, ymm1, 0          ; xmm2 = data23
+    vextracti128 xmm0, ymm0, 0          ; xmm0 = data01
+
+    vpshufd     xmm1, xmm0, 0x4E
+                ; xmm1 = (10 11 12 13 14 15 16 17 00 01 02 03 04 05 06 07)
+    vpshufd     xmm3, xmm2, 0x4E
+                ; xmm3 = (30 31 32 33 34 35 36 37 20 21 22 23 24 25 26 27)
+    vpshufd     xmm5, xmm4, 0x4E
+                ; xmm5 = (50 51 52 53 54 55 56 57 40 41 42 43 44 45 46 47)
+    vpshufd     xmm7, xmm6, 0x4E
+                ; xmm7 = (70 71 72 73 74 75 76 77 60 61 62 63 64 65 66 67)
+
+    vzeroupper
+
+    mov         eax, r13d
+
+    mov         rdxp, JSAMPROW [r12 + 0 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    mov         rsip, JSAMPROW [r12 + 1 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    movq        XMM_MMWORD [rdx + rax * SIZEOF_JSAMPLE], xmm0
+    movq        XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE], xmm1
+
+    mov         rdxp, JSAMPROW [r12 + 2 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    mov         rsip, JSAMPROW [r12 + 3 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    movq        XMM_MMWORD [rdx + rax * SIZEOF_JSAMPLE], xmm2
+    movq        XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE], xmm3
+
+    mov         rdxp, JSAMPROW [r12 + 4 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    mov         rsip, JSAMPROW [r12 + 5 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    movq        XMM_MMWORD [rdx + rax * SIZEOF_JSAMPLE], xmm4
+    movq        XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE], xmm5
+
+    mov         rdxp, JSAMPROW [r12 + 6 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    mov         rsip, JSAMPROW [r12 + 7 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    movq        XMM_MMWORD [rdx + rax * SIZEOF_JSAMPLE], xmm6
+    movq        XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE], xmm7
+
+    UNCOLLECT_ARGS 4
+    POP_XMM     1
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
@@ -0,0 +1,359 @@
+;
+; Fast Integer Inverse DCT (64-bit AVX2)
+;
+; Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
+; Copyright (C) 2009, 2016, 2024-2026, D. R. Commander.
+; Copyright (C) 2018, Matthias Räncker.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+;
+; This file contains a fast, not so accurate integer implementation of the
+; inverse DCT (Discrete Cosine Transform).  The following code is based
+; directly on the IJG's original jidctfst.c; see jidctfst.c for more details.
+
+%include "jsimdext.inc"
+%include "jdct.inc"
+
+; --------------------------------------------------------------------------
+
+%define CONST_BITS  8  ; 14 is also OK.
+%define PASS1_BITS  2
+
+%if IFAST_SCALE_BITS != PASS1_BITS
+%error "'IFAST_SCALE_BITS' must be equal to 'PASS1_BITS'."
+%endif
+
+%if CONST_BITS == 8
+F_1_082 equ 277              ; FIX(1.082392200)
+F_1_414 equ 362              ; FIX(1.414213562)
+F_1_847 equ 473              ; FIX(1.847759065)
+F_2_613 equ 669              ; FIX(2.613125930)
+F_1_613 equ (F_2_613 - 256)  ; FIX(2.613125930) - FIX(1)
+%else
+; NASM cannot do compile-time arithmetic on floating-point constants.
+%define DESCALE(x, n)  (((x) + (1 << ((n) - 1))) >> (n))
+F_1_082 equ DESCALE(1162209775, 30 - CONST_BITS)  ; FIX(1.082392200)
+F_1_414 equ DESCALE(1518500249, 30 - CONST_BITS)  ; FIX(1.414213562)
+F_1_847 equ DESCALE(1984016188, 30 - CONST_BITS)  ; FIX(1.847759065)
+F_2_613 equ DESCALE(2805822602, 30 - CONST_BITS)  ; FIX(2.613125930)
+F_1_613 equ (F_2_613 - (1 << CONST_BITS))         ; FIX(2.613125930) - FIX(1)
+%endif
+
+; --------------------------------------------------------------------------
+; In-place 8x8x16-bit inverse matrix transpose using AVX2 instructions
+; %1-%4: Input/output registers
+; %5-%8: Temp registers
+
+%macro DOTRANSPOSE 8
+    ; %5 = (00 10 20 30 40 50 60 70  01 11 21 31 41 51 61 71)
+    ; %6 = (03 13 23 33 43 53 63 73  02 12 22 32 42 52 62 72)
+    ; %7 = (04 14 24 34 44 54 64 74  05 15 25 35 45 55 65 75)
+    ; %8 = (07 17 27 37 47 57 67 77  06 16 26 36 46 56 66 76)
+
+    ; transpose coefficients(phase 1)
+    vpermq      %5, %1, 0xD8
+                ; %5 = (00 10 20 30 01 11 21 31  40 50 60 70 41 51 61 71)
+    vpermq      %6, %2, 0x72
+                ; %6 = (02 12 22 32 03 13 23 33  42 52 62 72 43 53 63 73)
+    vpermq      %7, %3, 0xD8
+                ; %7 = (04 14 24 34 05 15 25 35  44 54 64 74 45 55 65 75)
+    vpermq      %8, %4, 0x72
+                ; %8 = (06 16 26 36 07 17 27 37  46 56 66 76 47 57 67 77)
+
+    ; transpose coefficients(phase 2)
+    vpunpcklwd  %1, %5, %6
+                ; %1 = (00 02 10 12 20 22 30 32  40 42 50 52 60 62 70 72)
+    vpunpckhwd  %2, %5, %6
+                ; %2 = (01 03 11 13 21 23 31 33  41 43 51 53 61 63 71 73)
+    vpunpcklwd  %3, %7, %8
+                ; %3 = (04 06 14 16 24 26 34 36  44 46 54 56 64 66 74 76)
+    vpunpckhwd  %4, %7, %8
+                ; %4 = (05 07 15 17 25 27 35 37  45 47 55 57 65 67 75 77)
+
+    ; transpose coefficients(phase 3)
+    vpunpcklwd  %5, %1, %2
+                ; %5 = (00 01 02 03 10 11 12 13  40 41 42 43 50 51 52 53)
+    vpunpcklwd  %6, %3, %4
+                ; %6 = (04 05 06 07 14 15 16 17  44 45 46 47 54 55 56 57)
+    vpunpckhwd  %7, %1, %2
+                ; %7 = (20 21 22 23 30 31 32 33  60 61 62 63 70 71 72 73)
+    vpunpckhwd  %8, %3, %4
+                ; %8 = (24 25 26 27 34 35 36 37  64 65 66 67 74 75 76 77)
+
+    ; transpose coefficients(phase 4)
+    vpunpcklqdq %1, %5, %6
+                ; %1 = (00 01 02 03 04 05 06 07  40 41 42 43 44 45 46 47)
+    vpunpckhqdq %2, %5, %6
+                ; %2 = (10 11 12 13 14 15 16 17  50 51 52 53 54 55 56 57)
+    vpunpcklqdq %3, %7, %8
+                ; %3 = (20 21 22 23 24 25 26 27  60 61 62 63 64 65 66 67)
+    vpunpckhqdq %4, %7, %8
+                ; %4 = (30 31 32 33 34 35 36 37  70 71 72 73 74 75 76 77)
+%endmacro
+
+; --------------------------------------------------------------------------
+; In-place 8x8x16-bit fast integer inverse DCT using AVX2 instructions
+; %1-%4: Input/output registers
+; %5-%7: Temp registers
+; %8:    Pass (1 or 2)
+
+%macro DODCT 8
+    ; -- Even part
+
+    vperm2i128  %5, %1, %1, 0x01         ; %5 = in4_0
+    vpsignw     %1, %1, [rel PW_1_NEG1]  ; %1 = in0_neg4
+    vpaddw      %5, %5, %1               ; %5 = tmp10_11
+
+    vperm2i128  %6, %3, %3, 0x01         ; %6 = in6_2
+    vpsignw     %3, %3, [rel PW_1_NEG1]  ; %3 = in2_neg6
+    vpaddw      %6, %6, %3
+                ; %6 = (in2 + in6)_(in2 - in6) = tmp13_(in2 - in6)
+
+    vpsllw      %7, %6, PRE_MULTIPLY_SCALE_BITS
+    vpmulhw     %7, %7, [rel PW_F1414]
+    vperm2i128  %3, %6, %6, 0x00        ; %3 = tmp13_13
+    vpsubw      %7, %7, %3              ; %7 = xx_tmp12
+    vpblendd    %6, %6, %7, 0xF0        ; %6 = tmp13_12
+
+    vpsubw      %3, %5, %6              ; %3 = tmp10_11 - tmp13_12 = tmp3_2
+    vpaddw      %1, %5, %6              ; %1 = tmp10_11 + tmp13_12 = tmp0_1
+
+    ; -- Odd part
+
+    vpsubw      %5, %2, %4              ; %5 = in5_1 - in3_7 = z10_12
+    vpaddw      %2, %2, %4              ; %2 = in5_1 + in3_7 = z13_11
+
+    vperm2i128  %4, %2, %2, 0x01        ; %4 = z11_13
+    vpsubw      %6, %2, %4              ; %6 = xx_(z11 - z13)
+    vpaddw      %2, %2, %4              ; %2 = tmp7_7
+
+    vpsllw      %6, %6, PRE_MULTIPLY_SCALE_BITS
+    vpmulhw     %6, %6, [rel PW_F1414]  ; %6 = xx_tmp11
+
+    ; To avoid overflow...
+    ;
+    ; (Original)
+    ; tmp12 = -2.613125930 * z10 + z5;
+    ;
+    ; (This implementation)
+    ; tmp12 = (-1.613125930 - 1) * z10 + z5;
+    ;       = -1.613125930 * z10 - z10 + z5;
+
+    vpsllw      %4, %5, PRE_MULTIPLY_SCALE_BITS
+    vperm2i128  %7, %4, %4, 0x01
+    vpaddw      %7, %7, %4
+    vpmulhw     %7, %7, [rel PW_F1847]  ; %7 = z5_z5
+    vpmulhw     %4, %4, [rel PW_MF1613_F1082]
+    vpsubw      %5, %4, %5
+    vpblendd    %4, %4, %5, 0x0F
+                ; %4 = (-1.613125930 * z10 - z10)_(1.082392200 * z12)
+    vpsignw     %7, %7, [rel PW_1_NEG1]  ; %7 = z5_negz5
+    vpaddw      %4, %4, %7               ; %4 = tmp12_10
+
+    vpsubw      %5, %4, %2              ; %5 = tmp12_10 - tmp7_7 = tmp6_xx
+    vperm2i128  %5, %2, %5, 0x20        ; %5 = tmp7_6
+    vpsubw      %6, %6, %5              ; %6 = xx_tmp5
+    vpaddw      %4, %4, %6              ; %4 = xx_tmp4
+    vperm2i128  %6, %4, %6, 0x31         ; %6 = tmp4_5
+    vpsignw     %6, %6, [rel PW_1_NEG1]  ; %6 = tmp4_neg5
+
+    ; -- Final output stage
+
+    vpsubw      %4, %1, %5              ; %4 = tmp0_1 - tmp7_6 = data7_6
+    vpaddw      %1, %1, %5              ; %1 = tmp0_1 + tmp7_6 = data0_1
+    vpsubw      %2, %3, %6              ; %2 = tmp3_2 - tmp4_neg5 = data3_2
+    vpaddw      %3, %3, %6              ; %3 = tmp3_2 + tmp4_neg5 = data4_5
+
+%if %8 == 2
+    vpsraw      %1, %1, (PASS1_BITS + 3)  ; descale
+    vpsraw      %2, %2, (PASS1_BITS + 3)  ; descale
+    vpsraw      %3, %3, (PASS1_BITS + 3)  ; descale
+    vpsraw      %4, %4, (PASS1_BITS + 3)  ; descale
+%endif
+%endmacro
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+; PRE_MULTIPLY_SCALE_BITS <= 2 (to avoid overflow)
+; CONST_BITS + CONST_SHIFT + PRE_MULTIPLY_SCALE_BITS == 16 (for pmulhw)
+
+%define PRE_MULTIPLY_SCALE_BITS  2
+%define CONST_SHIFT              (16 - PRE_MULTIPLY_SCALE_BITS - CONST_BITS)
+
+    ALIGNZ      32
+    GLOBAL_DATA(jconst_idct_ifast_avx2)
+
+EXTN(jconst_idct_ifast_avx2):
+
+PW_F1414         times 16 dw  F_1_414 << CONST_SHIFT
+PW_F1847         times 16 dw  F_1_847 << CONST_SHIFT
+PW_MF1613_F1082  times 8  dw -F_1_613 << CONST_SHIFT
+                 times 8  dw  F_1_082 << CONST_SHIFT
+PB_CENTERJSAMP   times 32 db  CENTERJSAMPLE
+PW_1_NEG1        times 8  dw  1
+                 times 8  dw -1
+
+    ALIGNZ      32
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Perform dequantization and inverse DCT on one block of coefficients.
+;
+; GLOBAL(void)
+; jsimd_idct_ifast_avx2(void *dct_table, JCOEFPTR coef_block,
+;                       JSAMPARRAY output_buf, JDIMENSION output_col)
+;
+; r10 = jpeg_component_info *compptr
+; r11 = JCOEFPTR coef_block
+; r12 = JSAMPARRAY output_buf
+; r13d = JDIMENSION output_col
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_idct_ifast_avx2)
+
+EXTN(jsimd_idct_ifast_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 4
+
+    ; ---- Pass 1: process columns.
+
+%ifndef NO_ZERO_COLUMN_TEST_IFAST_AVX2
+    mov         eax, dword [DWBLOCK(1, 0, r11, SIZEOF_JCOEF)]
+    or          eax, dword [DWBLOCK(2, 0, r11, SIZEOF_JCOEF)]
+    jnz         near .columnDCT
+
+    movdqa      xmm0, XMMWORD [XMMBLOCK(1, 0, r11, SIZEOF_JCOEF)]
+    movdqa      xmm1, XMMWORD [XMMBLOCK(2, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm0, xmm0, XMMWORD [XMMBLOCK(3, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm1, xmm1, XMMWORD [XMMBLOCK(4, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm0, xmm0, XMMWORD [XMMBLOCK(5, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm1, xmm1, XMMWORD [XMMBLOCK(6, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm0, xmm0, XMMWORD [XMMBLOCK(7, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm1, xmm1, xmm0
+    vpacksswb   xmm1, xmm1, xmm1
+    vpacksswb   xmm1, xmm1, xmm1
+    movd        eax, xmm1
+    test        rax, rax
+    jnz         short .columnDCT
+
+    ; -- AC terms all zero
+
+    movdqa      xmm5, XMMWORD [XMMBLOCK(0, 0, r11, SIZEOF_JCOEF)]
+    vpmullw     xmm5, xmm5, XMMWORD [XMMBLOCK(0, 0, r10, SIZEOF_IFAST_MULT_TYPE)]
+
+    vpunpcklwd  xmm4, xmm5, xmm5        ; xmm4 = (00 00 01 01 02 02 03 03)
+    vpunpckhwd  xmm5, xmm5, xmm5        ; xmm5 = (04 04 05 05 06 06 07 07)
+    vinserti128 ymm4, ymm4, xmm5, 1
+
+    vpshufd     ymm0, ymm4, 0x00
+           ; ymm0 = col0_4 = (00 00 00 00 00 00 00 00  04 04 04 04 04 04 04 04)
+    vpshufd     ymm1, ymm4, 0x55
+           ; ymm1 = col1_5 = (01 01 01 01 01 01 01 01  05 05 05 05 05 05 05 05)
+    vpshufd     ymm2, ymm4, 0xAA
+           ; ymm2 = col2_6 = (02 02 02 02 02 02 02 02  06 06 06 06 06 06 06 06)
+    vpshufd     ymm3, ymm4, 0xFF
+           ; ymm3 = col3_7 = (03 03 03 03 03 03 03 03  07 07 07 07 07 07 07 07)
+
+    jmp         near .column_end
+%endif
+.columnDCT:
+
+    vmovdqu     xmm0, XMMWORD [XMMBLOCK(0, 0, r11, SIZEOF_JCOEF)]
+    vmovdqu     xmm1, XMMWORD [XMMBLOCK(5, 0, r11, SIZEOF_JCOEF)]
+    vmovdqu     xmm2, XMMWORD [XMMBLOCK(2, 0, r11, SIZEOF_JCOEF)]
+    vmovdqu     xmm3, XMMWORD [XMMBLOCK(3, 0, r11, SIZEOF_JCOEF)]
+    vinserti128 ymm0, ymm0, XMMWORD [XMMBLOCK(4, 0, r11, SIZEOF_JCOEF)], 1
+                ; ymm0 = in0_4
+    vinserti128 ymm1, ymm1, XMMWORD [XMMBLOCK(1, 0, r11, SIZEOF_JCOEF)], 1
+                ; ymm1 = in5_1
+    vinserti128 ymm2, ymm2, XMMWORD [XMMBLOCK(6, 0, r11, SIZEOF_JCOEF)], 1
+                ; ymm2 = in2_6
+    vinserti128 ymm3, ymm3, XMMWORD [XMMBLOCK(7, 0, r11, SIZEOF_JCOEF)], 1
+                ; ymm3 = in3_7
+
+    vmovdqu     xmm4, XMMWORD [XMMBLOCK(0, 0, r10, SIZEOF_IFAST_MULT_TYPE)]
+    vmovdqu     xmm5, XMMWORD [XMMBLOCK(5, 0, r10, SIZEOF_IFAST_MULT_TYPE)]
+    vmovdqu     xmm6, XMMWORD [XMMBLOCK(2, 0, r10, SIZEOF_IFAST_MULT_TYPE)]
+    vmovdqu     xmm7, XMMWORD [XMMBLOCK(3, 0, r10, SIZEOF_IFAST_MULT_TYPE)]
+    vinserti128 ymm4, ymm4, XMMWORD [XMMBLOCK(4, 0, r10, SIZEOF_IFAST_MULT_TYPE)], 1
+    vinserti128 ymm5, ymm5, XMMWORD [XMMBLOCK(1, 0, r10, SIZEOF_IFAST_MULT_TYPE)], 1
+    vinserti128 ymm6, ymm6, XMMWORD [XMMBLOCK(6, 0, r10, SIZEOF_IFAST_MULT_TYPE)], 1
+    vinserti128 ymm7, ymm7, XMMWORD [XMMBLOCK(7, 0, r10, SIZEOF_IFAST_MULT_TYPE)], 1
+    vpmullw     ymm0, ymm0, ymm4
+    vpmullw     ymm1, ymm1, ymm5
+    vpmullw     ymm2, ymm2, ymm6
+    vpmullw     ymm3, ymm3, ymm7
+
+    DODCT       ymm0, ymm1, ymm2, ymm3, ymm4, ymm5, ymm6, 1
+               ; ymm0 = data0_1, ymm1 = data3_2, ymm2 = data4_5, ymm3 = data7_6
+
+    DOTRANSPOSE ymm0, ymm1, ymm2, ymm3, ymm4, ymm5, ymm6, ymm7
+               ; ymm0 = data0_4, ymm1 = data1_5, ymm2 = data2_6, ymm3 = data3_7
+
+.column_end:
+
+    ; -- Prefetch the next coefficient block
+
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 0 * 32]
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 1 * 32]
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 2 * 32]
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 3 * 32]
+
+    ; ---- Pass 2: process rows.
+
+    vperm2i128  ymm1, ymm1, ymm1, 0x01  ; ymm1 = in5_1
+
+    DODCT       ymm0, ymm1, ymm2, ymm3, ymm4, ymm5, ymm6, 2
+               ; ymm0 = data0_1, ymm1 = data3_2, ymm2 = data4_5, ymm3 = data7_6
+
+    DOTRANSPOSE ymm0, ymm1, ymm2, ymm3, ymm4, ymm5, ymm6, ymm7
+               ; ymm0 = data0_4, ymm1 = data1_5, ymm2 = data2_6, ymm3 = data3_7
+
+    vpacksswb   ymm0, ymm0, ymm1        ; ymm0 = data01_45
+    vpacksswb   ymm1, ymm2, ymm3        ; ymm1 = data23_67
+    vpaddb      ymm0, ymm0, [rel PB_CENTERJSAMP]
+    vpaddb      ymm1, ymm1, [rel PB_CENTERJSAMP]
+
+    vextracti128 xmm4, ymm0, 1          ; xmm4 = data45
+    vextracti128 xmm6, ymm1, 1          ; xmm6 = data67
+
+    vzeroupper
+
+    mov         eax, r13d
+
+    mov         rdxp, JSAMPROW [r12 + 0 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    mov         rsip, JSAMPROW [r12 + 1 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    movq        XMM_MMWORD [rdx + rax * SIZEOF_JSAMPLE], xmm0
+    movhps      XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE], xmm0
+
+    mov         rdxp, JSAMPROW [r12 + 2 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    mov         rsip, JSAMPROW [r12 + 3 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    movq        XMM_MMWORD [rdx + rax * SIZEOF_JSAMPLE], xmm1
+    movhps      XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE], xmm1
+
+    mov         rdxp, JSAMPROW [r12 + 4 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    mov         rsip, JSAMPROW [r12 + 5 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    movq        XMM_MMWORD [rdx + rax * SIZEOF_JSAMPLE], xmm4
+    movhps      XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE], xmm4
+
+    mov         rdxp, JSAMPROW [r12 + 6 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    mov         rsip, JSAMPROW [r12 + 7 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    movq        XMM_MMWORD [rdx + rax * SIZEOF_JSAMPLE], xmm6
+    movhps      XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE], xmm6
+
+    UNCOLLECT_ARGS 4
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
@@ -0,0 +1,343 @@
+;
+; Accurate Integer Inverse DCT (64-bit AVX-512)
+;
+; Copyright (C) 2026, D. R. Commander.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler).  Yasm does not
+; support AVX-512 instructions.
+;
+; This file contains a slower but more accurate integer implementation of the
+; inverse DCT (Discrete Cosine Transform).  The following code is based
+; directly on the IJG's original jidctint.c; see jidctint.c for more details.
+;
+; The whole 8x8 block fits in two ZMM registers, so each pass processes all
+; eight columns (or rows) at once.  Rather than transposing the block between
+; passes, vpermi2w gathers each pair of inputs that is needed by one vpmaddwd
+; instruction directly from the output of the previous pass.  The odd part is
+; computed using the rotations from jidctint.c folded into one 4x4 matrix of
+; constants, which produces the same results as the C code, since all of the
+; intermediate values are exact 32-bit integers.
+
+%include "jsimdext.inc"
+%include "jdct.inc"
+
+; --------------------------------------------------------------------------
+
+%define CONST_BITS  13
+%define PASS1_BITS  2
+
+%define DESCALE_P1  (CONST_BITS - PASS1_BITS)
+%define DESCALE_P2  (CONST_BITS + PASS1_BITS + 3)
+
+%if CONST_BITS == 13
+F_0_298 equ  2446  ; FIX(0.298631336)
+F_0_390 equ  3196  ; FIX(0.390180644)
+F_0_541 equ  4433  ; FIX(0.541196100)
+F_0_765 equ  6270  ; FIX(0.765366865)
+F_0_899 equ  7373  ; FIX(0.899976223)
+F_1_000 equ  8192  ; FIX(1.000000000)
+F_1_175 equ  9633  ; FIX(1.175875602)
+F_1_501 equ 12299  ; FIX(1.501321110)
+F_1_847 equ 15137  ; FIX(1.847759065)
+F_1_961 equ 16069  ; FIX(1.961570560)
+F_2_053 equ 16819  ; FIX(2.053119869)
+F_2_562 equ 20995  ; FIX(2.562915447)
+F_3_072 equ 25172  ; FIX(3.072711026)
+%else
+; NASM cannot do compile-time arithmetic on floating-point constants.
+%define DESCALE(x, n)  (((x) + (1 << ((n) - 1))) >> (n))
+F_0_298 equ DESCALE( 320652955, 30 - CONST_BITS)  ; FIX(0.298631336)
+F_0_390 equ DESCALE( 418953276, 30 - CONST_BITS)  ; FIX(0.390180644)
+F_0_541 equ DESCALE( 581104887, 30 - CONST_BITS)  ; FIX(0.541196100)
+F_0_765 equ DESCALE( 821806413, 30 - CONST_BITS)  ; FIX(0.765366865)
+F_0_899 equ DESCALE( 966342111, 30 - CONST_BITS)  ; FIX(0.899976223)
+F_1_000 equ (1 << CONST_BITS)                     ; FIX(1.000000000)
+F_1_175 equ DESCALE(1262586813, 30 - CONST_BITS)  ; FIX(1.175875602)
+F_1_501 equ DESCALE(1612031267, 30 - CONST_BITS)  ; FIX(1.501321110)
+F_1_847 equ DESCALE(1984016188, 30 - CONST_BITS)  ; FIX(1.847759065)
+F_1_961 equ DESCALE(2106220350, 30 - CONST_BITS)  ; FIX(1.961570560)
+F_2_053 equ DESCALE(2204520673, 30 - CONST_BITS)  ; FIX(2.053119869)
+F_2_562 equ DESCALE(2751909506, 30 - CONST_BITS)  ; FIX(2.562915447)
+F_3_072 equ DESCALE(3299298341, 30 - CONST_BITS)  ; FIX(3.072711026)
+%endif
+
+; Diagonal terms of the folded odd-part matrix (see DODCT)
+F_TMP0_IN7 equ (F_0_298 - F_0_899 - F_1_961 + F_1_175)
+F_TMP1_IN5 equ (F_2_053 - F_2_562 - F_0_390 + F_1_175)
+F_TMP2_IN3 equ (F_3_072 - F_2_562 - F_1_961 + F_1_175)
+F_TMP3_IN1 equ (F_1_501 - F_0_899 - F_0_390 + F_1_175)
+
+; --------------------------------------------------------------------------
+; In-place 8x8x16-bit accurate integer inverse DCT using AVX-512 instructions
+; %1-%2: Input/output registers
+; %3-%8: Temp registers
+; %9:    Pass (1 or 2)
+;
+; On input, %1 and %2 contain the 64 coefficients in the order expected by
+; PW_GATHER_P%9.  On output,
+;   %1 = (00 01 02 03 30 31 32 33  04 05 06 07 34 35 36 37
+;         10 11 12 13 20 21 22 23  14 15 16 17 24 25 26 27)
+;   %2 = (70 71 72 73 40 41 42 43  74 75 76 77 44 45 46 47
+;         60 61 62 63 50 51 52 53  64 65 66 67 54 55 56 57)
+; where the first digit is the output index (the row index in Pass 1, the
+; column index in Pass 2) and the second digit is the column (Pass 1) or row
+; (Pass 2) being transformed.
+
+%macro DODCT 9
+    vbroadcasti64x4 %3, [rel PW_GATHER_P %+ %9 + 0 * SIZEOF_YMMWORD]
+    vbroadcasti64x4 %4, [rel PW_GATHER_P %+ %9 + 1 * SIZEOF_YMMWORD]
+    vbroadcasti64x4 %5, [rel PW_GATHER_P %+ %9 + 2 * SIZEOF_YMMWORD]
+    vbroadcasti64x4 %6, [rel PW_GATHER_P %+ %9 + 3 * SIZEOF_YMMWORD]
+    vpermi2w    %3, %1, %2              ; %3 = in04_04
+    vpermi2w    %4, %1, %2              ; %4 = in26_26
+    vpermi2w    %5, %1, %2              ; %5 = in75_75
+    vpermi2w    %6, %1, %2              ; %6 = in31_31
+
+    ; -- Even part
+
+    ; (Original)
+    ; z1 = (z2 + z3) * 0.541196100;
+    ; tmp2 = z1 + z3 * -1.847759065;
+    ; tmp3 = z1 + z2 * 0.765366865;
+    ;
+    ; (This implementation)
+    ; tmp2 = z2 * 0.541196100 + z3 * (0.541196100 - 1.847759065);
+    ; tmp3 = z2 * (0.541196100 + 0.765366865) + z3 * 0.541196100;
+
+    vpmaddwd    %3, %3, [rel PW_F100_F100_F100_MF100]  ; %3 = tmp0_1
+    vpmaddwd    %4, %4, [rel PW_F130_F054_F054_MF130]  ; %4 = tmp3_2
+    vpaddd      %3, %3, [rel PD_DESCALE_P %+ %9]{1to16}
+
+    vpaddd      %7, %3, %4              ; %7 = tmp0_1 + tmp3_2 = tmp10_11
+    vpsubd      %8, %3, %4              ; %8 = tmp0_1 - tmp3_2 = tmp13_12
+
+    ; -- Odd part
+
+    ; (Original)
+    ; z1 = tmp0 + tmp3;  z2 = tmp1 + tmp2;
+    ; z3 = tmp0 + tmp2;  z4 = tmp1 + tmp3;
+    ; z5 = (z3 + z4) * 1.175875602;
+    ; tmp0 = tmp0 * 0.298631336;  tmp1 = tmp1 * 2.053119869;
+    ; tmp2 = tmp2 * 3.072711026;  tmp3 = tmp3 * 1.501321110;
+    ; z1 = z1 * -0.899976223;  z2 = z2 * -2.562915447;
+    ; z3 = z3 * -1.961570560;  z4 = z4 * -0.390180644;
+    ; z3 += z5;  z4 += z5;
+    ; tmp0 += z1 + z3;  tmp1 += z2 + z4;
+    ; tmp2 += z2 + z3;  tmp3 += z1 + z4;
+    ;
+    ; (This implementation)
+    ; tmp0 = in7 * (0.298631336 - 0.899976223 - 1.961570560 + 1.175875602) +
+    ;        in5 * 1.175875602 + in3 * (1.175875602 - 1.961570560) +
+    ;        in1 * (1.175875602 - 0.899976223);
+    ; tmp1 = in7 * 1.175875602 +
+    ;        in5 * (2.053119869 - 2.562915447 - 0.390180644 + 1.175875602) +
+    ;        in3 * (1.175875602 - 2.562915447) +
+    ;        in1 * (1.175875602 - 0.390180644);
+    ; tmp2 = in7 * (1.175875602 - 1.961570560) +
+    ;        in5 * (1.175875602 - 2.562915447) +
+    ;        in3 * (3.072711026 - 2.562915447 - 1.961570560 + 1.175875602) +
+    ;        in1 * 1.175875602;
+    ; tmp3 = in7 * (1.175875602 - 0.899976223) +
+    ;        in5 * (1.175875602 - 0.390180644) + in3 * 1.175875602 +
+    ;        in1 * (1.501321110 - 0.899976223 - 0.390180644 + 1.175875602);
+
+    vpmaddwd    %1, %5, [rel PW_F028_F079_MF079_MF139]
+    vpmaddwd    %2, %6, [rel PW_F118_F139_MF028_F118]
+    vpmaddwd    %5, %5, [rel PW_MF139_F118_F118_F028]
+    vpmaddwd    %6, %6, [rel PW_MF079_F028_MF139_F079]
+    vpaddd      %1, %1, %2              ; %1 = tmp3_2
+    vpaddd      %5, %5, %6              ; %5 = tmp0_1
+
+    ; -- Final output stage
+
+    vpaddd      %2, %7, %1              ; %2 = tmp10_11 + tmp3_2 = data0_1
+    vpsubd      %7, %7, %1              ; %7 = tmp10_11 - tmp3_2 = data7_6
+    vpaddd      %1, %8, %5              ; %1 = tmp13_12 + tmp0_1 = data3_2
+    vpsubd      %8, %8, %5              ; %8 = tmp13_12 - tmp0_1 = data4_5
+
+    vpsrad      %2, %2, DESCALE_P %+ %9
+    vpsrad      %7, %7, DESCALE_P %+ %9
+    vpsrad      %1, %1, DESCALE_P %+ %9
+    vpsrad      %8, %8, DESCALE_P %+ %9
+
+    vpackssdw   %1, %2, %1              ; %1 = data0_3_1_2
+    vpackssdw   %2, %7, %8              ; %2 = data7_4_6_5
+%endmacro
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      64
+    GLOBAL_DATA(jconst_idct_islow_avx512)
+
+EXTN(jconst_idct_islow_avx512):
+
+PW_F100_F100_F100_MF100    times 8  dw  F_1_000,  F_1_000
+                           times 8  dw  F_1_000, -F_1_000
+PW_F130_F054_F054_MF130    times 8  dw  (F_0_541 + F_0_765),  F_0_541
+                           times 8  dw  F_0_541, (F_0_541 - F_1_847)
+PW_F028_F079_MF079_MF139   times 8  dw  (F_1_175 - F_0_899), (F_1_175 - F_0_390)
+                           times 8  dw  (F_1_175 - F_1_961), (F_1_175 - F_2_562)
+PW_F118_F139_MF028_F118    times 8  dw  F_1_175, F_TMP3_IN1
+                           times 8  dw  F_TMP2_IN3, F_1_175
+PW_MF139_F118_F118_F028    times 8  dw  F_TMP0_IN7, F_1_175
+                           times 8  dw  F_1_175, F_TMP1_IN5
+PW_MF079_F028_MF139_F079   times 8  dw  (F_1_175 - F_1_961), (F_1_175 - F_0_899)
+                           times 8  dw  (F_1_175 - F_2_562), (F_1_175 - F_0_390)
+
+    ; The lower and upper halves of each 512-bit gather index are identical,
+    ; so only the lower halves are stored.  (The two halves of each vpmaddwd
+    ; constant above differ, since they produce two different outputs.)
+
+PW_GATHER_P1               dw   0, 32,  1, 33,  2, 34,  3, 35
+                           dw   4, 36,  5, 37,  6, 38,  7, 39
+                           dw  16, 48, 17, 49, 18, 50, 19, 51
+                           dw  20, 52, 21, 53, 22, 54, 23, 55
+                           dw  56, 40, 57, 41, 58, 42, 59, 43
+                           dw  60, 44, 61, 45, 62, 46, 63, 47
+                           dw  24,  8, 25,  9, 26, 10, 27, 11
+                           dw  28, 12, 29, 13, 30, 14, 31, 15
+PW_GATHER_P2               dw   0,  8, 16, 24, 20, 28,  4, 12
+                           dw  36, 44, 52, 60, 48, 56, 32, 40
+                           dw   2, 10, 18, 26, 22, 30,  6, 14
+                           dw  38, 46, 54, 62, 50, 58, 34, 42
+                           dw  11,  9, 27, 25, 31, 29, 15, 13
+                           dw  47, 45, 63, 61, 59, 57, 43, 41
+                           dw   3,  1, 19, 17, 23, 21,  7,  5
+                           dw  39, 37, 55, 53, 51, 49, 35, 33
+PW_TRANSPOSE               dw   0, 16, 20,  4, 36, 52, 48, 32
+                           dw   1, 17, 21,  5, 37, 53, 49, 33
+                           dw   2, 18, 22,  6, 38, 54, 50, 34
+                           dw   3, 19, 23,  7, 39, 55, 51, 35
+                           dw   8, 24, 28, 12, 44, 60, 56, 40
+                           dw   9, 25, 29, 13, 45, 61, 57, 41
+                           dw  10, 26, 30, 14, 46, 62, 58, 42
+                           dw  11, 27, 31, 15, 47, 63, 59, 43
+PD_DESCALE_P1              dd  1 << (DESCALE_P1 - 1)
+PD_DESCALE_P2              dd  1 << (DESCALE_P2 - 1)
+
+    ALIGNZ      32
+
+PB_CENTERJSAMP             times 32 db  CENTERJSAMPLE
+
+    ALIGNZ      64
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Perform dequantization and inverse DCT on one block of coefficients.
+;
+; GLOBAL(void)
+; jsimd_idct_islow_avx512(void *dct_table, JCOEFPTR coef_block,
+;                         JSAMPARRAY output_buf, JDIMENSION output_col)
+;
+; r10 = jpeg_component_info *compptr
+; r11 = JCOEFPTR coef_block
+; r12 = JSAMPARRAY output_buf
+; r13d = JDIMENSION output_col
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_idct_islow_avx512)
+
+EXTN(jsimd_idct_islow_avx512):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp                ; rbp = aligned rbp
+    COLLECT_ARGS 4
+
+    ; ---- Pass 1: process columns.
+
+    vmovdqu64   zmm0, ZMMWORD [ZMMBLOCK(0, 0, r11, SIZEOF_JCOEF)]
+                ; zmm0 = in0_1_2_3
+    vmovdqu64   zmm1, ZMMWORD [ZMMBLOCK(4, 0, r11, SIZEOF_JCOEF)]
+                ; zmm1 = in4_5_6_7
+
+%ifndef NO_ZERO_COLUMN_TEST_ISLOW_AVX512
+    vptestmw    k1, zmm0, zmm0
+    vptestmw    k2, zmm1, zmm1
+    kshiftrd    k1, k1, DCTSIZE         ; ignore the DC terms
+    kortestd    k1, k2
+    jnz         short .columnDCT
+
+    ; -- AC terms all zero
+
+    vpmullw     xmm0, xmm0, XMMWORD [XMMBLOCK(0, 0, r10, SIZEOF_ISLOW_MULT_TYPE)]
+    vpsllw      xmm0, xmm0, PASS1_BITS
+
+    vpermq      ymm0, ymm0, 0x50
+                ; ymm0 = (00 01 02 03 00 01 02 03  04 05 06 07 04 05 06 07)
+    vshufi64x2  zmm0, zmm0, zmm0, 0x44
+    vmovdqa64   zmm1, zmm0
+                ; zmm0 = data0_3_1_2, zmm1 = data7_4_6_5
+
+    jmp         near .column_end
+%endif
+.columnDCT:
+
+    vpmullw     zmm0, zmm0, ZMMWORD [ZMMBLOCK(0, 0, r10, SIZEOF_ISLOW_MULT_TYPE)]
+    vpmullw     zmm1, zmm1, ZMMWORD [ZMMBLOCK(4, 0, r10, SIZEOF_ISLOW_MULT_TYPE)]
+
+    DODCT       zmm0, zmm1, zmm16, zmm17, zmm18, zmm19, zmm20, zmm21, 1
+                ; zmm0 = data0_3_1_2, zmm1 = data7_4_6_5
+
+.column_end:
+
+    ; -- Prefetch the next coefficient block
+
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 0 * 64]
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 1 * 64]
+
+    ; ---- Pass 2: process rows.
+
+    DODCT       zmm0, zmm1, zmm16, zmm17, zmm18, zmm19, zmm20, zmm21, 2
+                ; zmm0 = data0_3_1_2, zmm1 = data7_4_6_5
+
+    vmovdqa64   zmm2, ZMMWORD [rel PW_TRANSPOSE + 0 * SIZEOF_ZMMWORD]
+    vmovdqa64   zmm3, ZMMWORD [rel PW_TRANSPOSE + 1 * SIZEOF_ZMMWORD]
+    vpermi2w    zmm2, zmm0, zmm1        ; zmm2 = data0_1_2_3
+    vpermi2w    zmm3, zmm0, zmm1        ; zmm3 = data4_5_6_7
+
+    vpmovswb    ymm0, zmm2              ; ymm0 = data0_1_2_3
+    vpmovswb    ymm1, zmm3              ; ymm1 = data4_5_6_7
+    vpaddb      ymm0, ymm0, [rel PB_CENTERJSAMP]
+    vpaddb      ymm1, ymm1, [rel PB_CENTERJSAMP]
+
+    vextracti128 xmm2, ymm0, 1          ; xmm2 = data23
+    vextracti128 xmm3, ymm1, 1          ; xmm3 = data67
+
+    vzeroupper
+
+    mov         eax, r13d
+
+    mov         rdxp, JSAMPROW [r12 + 0 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    mov         rsip, JSAMPROW [r12 + 1 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    movq        XMM_MMWORD [rdx + rax * SIZEOF_JSAMPLE], xmm0
+    pextrq      XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE], xmm0, 1
+
+    mov         rdxp, JSAMPROW [r12 + 2 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    mov         rsip, JSAMPROW [r12 + 3 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    movq        XMM_MMWORD [rdx + rax * SIZEOF_JSAMPLE], xmm2
+    pextrq      XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE], xmm2, 1
+
+    mov         rdxp, JSAMPROW [r12 + 4 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    mov         rsip, JSAMPROW [r12 + 5 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    movq        XMM_MMWORD [rdx + rax * SIZEOF_JSAMPLE], xmm1
+    pextrq      XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE], xmm1, 1
+
+    mov         rdxp, JSAMPROW [r12 + 6 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    mov         rsip, JSAMPROW [r12 + 7 * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    movq        XMM_MMWORD [rdx + rax * SIZEOF_JSAMPLE], xmm3
+    pextrq      XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE], xmm3, 1
+
+    UNCOLLECT_ARGS 4
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
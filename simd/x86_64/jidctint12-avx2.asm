@@ -0,0 +1,331 @@
+;
+; Accurate Integer Inverse DCT (64-bit AVX2, 12-bit samples)
+;
+; Copyright (C) 2026, D. R. Commander.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+;
+; This file contains a slower but more accurate integer implementation of the
+; inverse DCT (Discrete Cosine Transform).  The following code is based
+; directly on the IJG's original jidctint.c; see jidctint.c for more details.
+;
+; With 12-bit samples, the intermediate values require 32 bits, so this
+; implementation operates on eight 32-bit values per register and uses
+; vpmulld rather than vpmaddwd for the multiplications.
+
+%include "jsimdext.inc"
+%include "jdct.inc"
+
+; --------------------------------------------------------------------------
+
+%define CONST_BITS  13
+%define PASS1_BITS  1
+
+%define DESCALE_P1  (CONST_BITS - PASS1_BITS)
+%define DESCALE_P2  (CONST_BITS + PASS1_BITS + 3)
+
+F_0_298 equ  2446  ; FIX(0.298631336)
+F_0_390 equ  3196  ; FIX(0.390180644)
+F_0_541 equ  4433  ; FIX(0.541196100)
+F_0_765 equ  6270  ; FIX(0.765366865)
+F_0_899 equ  7373  ; FIX(0.899976223)
+F_1_175 equ  9633  ; FIX(1.175875602)
+F_1_501 equ 12299  ; FIX(1.501321110)
+F_1_847 equ 15137  ; FIX(1.847759065)
+F_1_961 equ 16069  ; FIX(1.961570560)
+F_2_053 equ 16819  ; FIX(2.053119869)
+F_2_562 equ 20995  ; FIX(2.562915447)
+F_3_072 equ 25172  ; FIX(3.072711026)
+
+; The C implementation range-limits the output of the inverse DCT by masking
+; it with RANGE_MASK (2 bits wider than legal samples) and using the result to
+; index a table.  The same result is obtained by sign-extending the lowest
+; RANGE_BITS bits of the output, adding CENTERJ12SAMPLE, and clamping.
+
+%define RANGE_BITS  14
+
+; --------------------------------------------------------------------------
+; In-place 8x8x32-bit matrix transpose using AVX2 instructions
+; %1-%8:  Input registers (rows 0-7)
+; %9-%16: Output registers (columns 0-7)
+
+%macro DOTRANSPOSE 16
+    ; %1 = (00 01 02 03 04 05 06 07), %2 = (10 11 12 13 14 15 16 17), ...
+
+    ; transpose coefficients(phase 1)
+    vpunpckldq  %9, %1, %2              ; %9  = (00 10 01 11 04 14 05 15)
+    vpunpckhdq  %10, %1, %2             ; %10 = (02 12 03 13 06 16 07 17)
+    vpunpckldq  %11, %3, %4             ; %11 = (20 30 21 31 24 34 25 35)
+    vpunpckhdq  %12, %3, %4             ; %12 = (22 32 23 33 26 36 27 37)
+    vpunpckldq  %13, %5, %6             ; %13 = (40 50 41 51 44 54 45 55)
+    vpunpckhdq  %14, %5, %6             ; %14 = (42 52 43 53 46 56 47 57)
+    vpunpckldq  %15, %7, %8             ; %15 = (60 70 61 71 64 74 65 75)
+    vpunpckhdq  %16, %7, %8             ; %16 = (62 72 63 73 66 76 67 77)
+
+    ; transpose coefficients(phase 2)
+    vpunpcklqdq %1, %9, %11             ; %1 = (00 10 20 30 04 14 24 34)
+    vpunpckhqdq %2, %9, %11             ; %2 = (01 11 21 31 05 15 25 35)
+    vpunpcklqdq %3, %10, %12            ; %3 = (02 12 22 32 06 16 26 36)
+    vpunpckhqdq %4, %10, %12            ; %4 = (03 13 23 33 07 17 27 37)
+    vpunpcklqdq %5, %13, %15            ; %5 = (40 50 60 70 44 54 64 74)
+    vpunpckhqdq %6, %13, %15            ; %6 = (41 51 61 71 45 55 65 75)
+    vpunpcklqdq %7, %14, %16            ; %7 = (42 52 62 72 46 56 66 76)
+    vpunpckhqdq %8, %14, %16            ; %8 = (43 53 63 73 47 57 67 77)
+
+    ; transpose coefficients(phase 3)
+    vperm2i128  %9, %1, %5, 0x20        ; %9  = (00 10 20 30 40 50 60 70)
+    vperm2i128  %13, %1, %5, 0x31       ; %13 = (04 14 24 34 44 54 64 74)
+    vperm2i128  %10, %2, %6, 0x20       ; %10 = (01 11 21 31 41 51 61 71)
+    vperm2i128  %14, %2, %6, 0x31       ; %14 = (05 15 25 35 45 55 65 75)
+    vperm2i128  %11, %3, %7, 0x20       ; %11 = (02 12 22 32 42 52 62 72)
+    vperm2i128  %15, %3, %7, 0x31       ; %15 = (06 16 26 36 46 56 66 76)
+    vperm2i128  %12, %4, %8, 0x20       ; %12 = (03 13 23 33 43 53 63 73)
+    vperm2i128  %16, %4, %8, 0x31       ; %16 = (07 17 27 37 47 57 67 77)
+%endmacro
+
+; --------------------------------------------------------------------------
+; In-place 8x8x32-bit accurate integer inverse DCT using AVX2 instructions
+; %1-%8:  Input registers (in0-in7)
+; %9-%16: Output registers (out0-out7)
+; %17:    Pass (1 or 2)
+
+%macro DOIDCT 17
+    ; -- Even part
+
+    vpaddd      %9, %3, %7
+    vpmulld     %9, %9, [rel PD_F054]   ; %9 = z1
+    vpmulld     %10, %7, [rel PD_MF184]
+    vpmulld     %11, %3, [rel PD_F076]
+    vpaddd      %10, %10, %9            ; %10 = tmp2
+    vpaddd      %11, %11, %9            ; %11 = tmp3
+
+    vpaddd      %12, %1, %5
+    vpsubd      %13, %1, %5
+    vpslld      %12, %12, CONST_BITS    ; %12 = tmp0
+    vpslld      %13, %13, CONST_BITS    ; %13 = tmp1
+
+    vpaddd      %1, %12, %11            ; %1 = tmp0 + tmp3 = tmp10
+    vpsubd      %3, %12, %11            ; %3 = tmp0 - tmp3 = tmp13
+    vpaddd      %5, %13, %10            ; %5 = tmp1 + tmp2 = tmp11
+    vpsubd      %7, %13, %10            ; %7 = tmp1 - tmp2 = tmp12
+
+    ; -- Odd part
+
+    vpaddd      %9, %8, %2              ; %9  = in7 + in1 = z1
+    vpaddd      %10, %6, %4             ; %10 = in5 + in3 = z2
+    vpaddd      %11, %8, %4             ; %11 = in7 + in3 = z3
+    vpaddd      %12, %6, %2             ; %12 = in5 + in1 = z4
+    vpaddd      %13, %11, %12
+    vpmulld     %13, %13, [rel PD_F117]  ; %13 = z5
+
+    vpmulld     %8, %8, [rel PD_F029]    ; %8 = tmp0
+    vpmulld     %6, %6, [rel PD_F205]    ; %6 = tmp1
+    vpmulld     %4, %4, [rel PD_F307]    ; %4 = tmp2
+    vpmulld     %2, %2, [rel PD_F150]    ; %2 = tmp3
+    vpmulld     %9, %9, [rel PD_MF089]   ; %9 = z1
+    vpmulld     %10, %10, [rel PD_MF256]  ; %10 = z2
+    vpmulld     %11, %11, [rel PD_MF196]  ; %11 = z3
+    vpmulld     %12, %12, [rel PD_MF039]  ; %12 = z4
+
+    vpaddd      %11, %11, %13           ; %11 = z3 + z5
+    vpaddd      %12, %12, %13           ; %12 = z4 + z5
+
+    vpaddd      %8, %8, %9
+    vpaddd      %6, %6, %10
+    vpaddd      %4, %4, %10
+    vpaddd      %2, %2, %9
+    vpaddd      %8, %8, %11             ; %8 = tmp0 + z1 + z3
+    vpaddd      %6, %6, %12             ; %6 = tmp1 + z2 + z4
+    vpaddd      %4, %4, %11             ; %4 = tmp2 + z2 + z3
+    vpaddd      %2, %2, %12             ; %2 = tmp3 + z1 + z4
+
+    ; -- Final output stage
+
+    vmovdqa     %9, [rel PD_DESCALE_P %+ %17]
+    vpaddd      %1, %1, %9
+    vpaddd      %5, %5, %9
+    vpaddd      %7, %7, %9
+    vpaddd      %3, %3, %9
+
+    vpaddd      %9, %1, %2              ; %9  = tmp10 + tmp3
+    vpsubd      %16, %1, %2             ; %16 = tmp10 - tmp3
+    vpaddd      %10, %5, %4             ; %10 = tmp11 + tmp2
+    vpsubd      %15, %5, %4             ; %15 = tmp11 - tmp2
+    vpaddd      %11, %7, %6             ; %11 = tmp12 + tmp1
+    vpsubd      %14, %7, %6             ; %14 = tmp12 - tmp1
+    vpaddd      %12, %3, %8             ; %12 = tmp13 + tmp0
+    vpsubd      %13, %3, %8             ; %13 = tmp13 - tmp0
+
+    vpsrad      %9, %9, DESCALE_P %+ %17    ; %9  = out0
+    vpsrad      %10, %10, DESCALE_P %+ %17  ; %10 = out1
+    vpsrad      %11, %11, DESCALE_P %+ %17  ; %11 = out2
+    vpsrad      %12, %12, DESCALE_P %+ %17  ; %12 = out3
+    vpsrad      %13, %13, DESCALE_P %+ %17  ; %13 = out4
+    vpsrad      %14, %14, DESCALE_P %+ %17  ; %14 = out5
+    vpsrad      %15, %15, DESCALE_P %+ %17  ; %15 = out6
+    vpsrad      %16, %16, DESCALE_P %+ %17  ; %16 = out7
+%endmacro
+
+; --------------------------------------------------------------------------
+; Range-limit one register of output samples
+; %1: Input/output register
+; %2: Register containing PD_CENTERJ12SAMPLE
+
+%macro RANGELIMIT 2
+    vpslld      %1, %1, 32 - RANGE_BITS
+    vpsrad      %1, %1, 32 - RANGE_BITS
+    vpaddd      %1, %1, %2
+%endmacro
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      32
+    GLOBAL_DATA(jconst12_idct_islow_avx2)
+
+EXTN(jconst12_idct_islow_avx2):
+
+PD_F029            times 8  dd  F_0_298
+PD_MF039           times 8  dd -F_0_390
+PD_F054            times 8  dd  F_0_541
+PD_F076            times 8  dd  F_0_765
+PD_MF089           times 8  dd -F_0_899
+PD_F117            times 8  dd  F_1_175
+PD_F150            times 8  dd  F_1_501
+PD_MF184           times 8  dd -F_1_847
+PD_MF196           times 8  dd -F_1_961
+PD_F205            times 8  dd  F_2_053
+PD_MF256           times 8  dd -F_2_562
+PD_F307            times 8  dd  F_3_072
+PD_DESCALE_P1      times 8  dd  1 << (DESCALE_P1 - 1)
+PD_DESCALE_P2      times 8  dd  1 << (DESCALE_P2 - 1)
+PD_CENTERJ12SAMPLE times 8  dd  CENTERJ12SAMPLE
+PW_MAXJ12SAMPLE    times 16 dw  MAXJ12SAMPLE
+
+    ALIGNZ      32
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Perform dequantization and inverse DCT on one block of coefficients.
+;
+; GLOBAL(void)
+; jsimd12_idct_islow_avx2(void *dct_table, JCOEFPTR coef_block,
+;                         J12SAMPARRAY output_buf, JDIMENSION output_col)
+
+; r10 = void *dct_table
+; r11 = JCOEFPTR coef_block
+; r12 = J12SAMPARRAY output_buf
+; r13d = JDIMENSION output_col
+
+    align       32
+    GLOBAL_FUNCTION(jsimd12_idct_islow_avx2)
+
+EXTN(jsimd12_idct_islow_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    PUSH_XMM    8
+    COLLECT_ARGS 4
+
+    ; ---- Pass 1: process columns.
+
+    vpmovsxwd   ymm0, XMMWORD [XMMBLOCK(0, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm1, XMMWORD [XMMBLOCK(1, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm2, XMMWORD [XMMBLOCK(2, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm3, XMMWORD [XMMBLOCK(3, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm4, XMMWORD [XMMBLOCK(4, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm5, XMMWORD [XMMBLOCK(5, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm6, XMMWORD [XMMBLOCK(6, 0, r11, SIZEOF_JCOEF)]
+    vpmovsxwd   ymm7, XMMWORD [XMMBLOCK(7, 0, r11, SIZEOF_JCOEF)]
+    vpmulld     ymm0, ymm0, \
+                YMMWORD [YMMBLOCK(0, 0, r10, SIZEOF_J12ISLOW_MULT_TYPE)]
+    vpmulld     ymm1, ymm1, \
+                YMMWORD [YMMBLOCK(1, 0, r10, SIZEOF_J12ISLOW_MULT_TYPE)]
+    vpmulld     ymm2, ymm2, \
+                YMMWORD [YMMBLOCK(2, 0, r10, SIZEOF_J12ISLOW_MULT_TYPE)]
+    vpmulld     ymm3, ymm3, \
+                YMMWORD [YMMBLOCK(3, 0, r10, SIZEOF_J12ISLOW_MULT_TYPE)]
+    vpmulld     ymm4, ymm4, \
+                YMMWORD [YMMBLOCK(4, 0, r10, SIZEOF_J12ISLOW_MULT_TYPE)]
+    vpmulld     ymm5, ymm5, \
+                YMMWORD [YMMBLOCK(5, 0, r10, SIZEOF_J12ISLOW_MULT_TYPE)]
+    vpmulld     ymm6, ymm6, \
+                YMMWORD [YMMBLOCK(6, 0, r10, SIZEOF_J12ISLOW_MULT_TYPE)]
+    vpmulld     ymm7, ymm7, \
+                YMMWORD [YMMBLOCK(7, 0, r10, SIZEOF_J12ISLOW_MULT_TYPE)]
+
+    DOIDCT      ymm0, ymm1, ymm2, ymm3, ymm4, ymm5, ymm6, ymm7, \
+                ymm8, ymm9, ymm10, ymm11, ymm12, ymm13, ymm14, ymm15, 1
+
+    ; ---- Pass 2: process rows.
+
+    DOTRANSPOSE ymm8, ymm9, ymm10, ymm11, ymm12, ymm13, ymm14, ymm15, \
+                ymm0, ymm1, ymm2, ymm3, ymm4, ymm5, ymm6, ymm7
+
+    DOIDCT      ymm0, ymm1, ymm2, ymm3, ymm4, ymm5, ymm6, ymm7, \
+                ymm8, ymm9, ymm10, ymm11, ymm12, ymm13, ymm14, ymm15, 2
+
+    vmovdqa     ymm0, [rel PD_CENTERJ12SAMPLE]
+    RANGELIMIT  ymm8, ymm0
+    RANGELIMIT  ymm9, ymm0
+    RANGELIMIT  ymm10, ymm0
+    RANGELIMIT  ymm11, ymm0
+    RANGELIMIT  ymm12, ymm0
+    RANGELIMIT  ymm13, ymm0
+    RANGELIMIT  ymm14, ymm0
+    RANGELIMIT  ymm15, ymm0
+
+    DOTRANSPOSE ymm8, ymm9, ymm10, ymm11, ymm12, ymm13, ymm14, ymm15, \
+                ymm0, ymm1, ymm2, ymm3, ymm4, ymm5, ymm6, ymm7
+
+    vmovdqa     ymm8, [rel PW_MAXJ12SAMPLE]
+    vpackusdw   ymm0, ymm0, ymm1
+    vpackusdw   ymm2, ymm2, ymm3
+    vpackusdw   ymm4, ymm4, ymm5
+    vpackusdw   ymm6, ymm6, ymm7
+    vpermq      ymm0, ymm0, 0xD8        ; ymm0 = (row 0, row 1)
+    vpermq      ymm2, ymm2, 0xD8        ; ymm2 = (row 2, row 3)
+    vpermq      ymm4, ymm4, 0xD8        ; ymm4 = (row 4, row 5)
+    vpermq      ymm6, ymm6, 0xD8        ; ymm6 = (row 6, row 7)
+    vpminuw     ymm0, ymm0, ymm8
+    vpminuw     ymm2, ymm2, ymm8
+    vpminuw     ymm4, ymm4, ymm8
+    vpminuw     ymm6, ymm6, ymm8
+
+    mov         eax, r13d
+
+    mov         rdxp, J12SAMPROW [r12 + 0 * SIZEOF_J12SAMPROW]
+    mov         rsip, J12SAMPROW [r12 + 1 * SIZEOF_J12SAMPROW]
+    vmovdqu     XMMWORD [rdx + rax * SIZEOF_J12SAMPLE], xmm0
+    vextracti128 XMMWORD [rsi + rax * SIZEOF_J12SAMPLE], ymm0, 1
+
+    mov         rdxp, J12SAMPROW [r12 + 2 * SIZEOF_J12SAMPROW]
+    mov         rsip, J12SAMPROW [r12 + 3 * SIZEOF_J12SAMPROW]
+    vmovdqu     XMMWORD [rdx + rax * SIZEOF_J12SAMPLE], xmm2
+    vextracti128 XMMWORD [rsi + rax * SIZEOF_J12SAMPLE], ymm2, 1
+
+    mov         rdxp, J12SAMPROW [r12 + 4 * SIZEOF_J12SAMPROW]
+    mov         rsip, J12SAMPROW [r12 + 5 * SIZEOF_J12SAMPROW]
+    vmovdqu     XMMWORD [rdx + rax * SIZEOF_J12SAMPLE], xmm4
+    vextracti128 XMMWORD [rsi + rax * SIZEOF_J12SAMPLE], ymm4, 1
+
+    mov         rdxp, J12SAMPROW [r12 + 6 * SIZEOF_J12SAMPROW]
+    mov         rsip, J12SAMPROW [r12 + 7 * SIZEOF_J12SAMPROW]
+    vmovdqu     XMMWORD [rdx + rax * SIZEOF_J12SAMPLE], xmm6
+    vextracti128 XMMWORD [rsi + rax * SIZEOF_J12SAMPLE], ymm6, 1
+
+    vzeroupper
+    UNCOLLECT_ARGS 4
+    POP_XMM     8
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
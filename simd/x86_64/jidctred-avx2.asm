@@ -0,0 +1,323 @@
+;
+; Scaled Integer Inverse DCT (64-bit AVX2)
+;
+; Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
+; Copyright (C) 2009, 2016, 2024-2026, D. R. Commander.
+; Copyright (C) 2018, Matthias Räncker.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+;
+; This file contains an inverse DCT routine that produces reduced-size output:
+; 4x4 pixels from an 8x8 DCT block.  It is based directly on the IJG's
+; original jidctred.c; see jidctred.c for more details.  The first pass
+; processes all eight columns in each 256-bit register, and the second pass is
+; the same as that of the SSE2 implementation.
+
+%include "jsimdext.inc"
+%include "jdct.inc"
+
+; --------------------------------------------------------------------------
+
+%define CONST_BITS    13
+%define PASS1_BITS    2
+
+%define DESCALE_P1_4  (CONST_BITS - PASS1_BITS + 1)
+%define DESCALE_P2_4  (CONST_BITS + PASS1_BITS + 3 + 1)
+
+%if CONST_BITS == 13
+F_0_211 equ  1730  ; FIX(0.211164243)
+F_0_509 equ  4176  ; FIX(0.509795579)
+F_0_601 equ  4926  ; FIX(0.601344887)
+F_0_765 equ  6270  ; FIX(0.765366865)
+F_0_899 equ  7373  ; FIX(0.899976223)
+F_1_061 equ  8697  ; FIX(1.061594337)
+F_1_451 equ 11893  ; FIX(1.451774981)
+F_1_847 equ 15137  ; FIX(1.847759065)
+F_2_172 equ 17799  ; FIX(2.172734803)
+F_2_562 equ 20995  ; FIX(2.562915447)
+%else
+; NASM cannot do compile-time arithmetic on floating-point constants.
+%define DESCALE(x, n)  (((x) + (1 << ((n) - 1))) >> (n))
+F_0_211 equ DESCALE( 226735879, 30 - CONST_BITS)  ; FIX(0.211164243)
+F_0_509 equ DESCALE( 547388834, 30 - CONST_BITS)  ; FIX(0.509795579)
+F_0_601 equ DESCALE( 645689155, 30 - CONST_BITS)  ; FIX(0.601344887)
+F_0_765 equ DESCALE( 821806413, 30 - CONST_BITS)  ; FIX(0.765366865)
+F_0_899 equ DESCALE( 966342111, 30 - CONST_BITS)  ; FIX(0.899976223)
+F_1_061 equ DESCALE(1139878239, 30 - CONST_BITS)  ; FIX(1.061594337)
+F_1_451 equ DESCALE(1558831516, 30 - CONST_BITS)  ; FIX(1.451774981)
+F_1_847 equ DESCALE(1984016188, 30 - CONST_BITS)  ; FIX(1.847759065)
+F_2_172 equ DESCALE(2332956230, 30 - CONST_BITS)  ; FIX(2.172734803)
+F_2_562 equ DESCALE(2751909506, 30 - CONST_BITS)  ; FIX(2.562915447)
+%endif
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_CONST
+
+    ALIGNZ      32
+    GLOBAL_DATA(jconst_idct_red_avx2)
+
+EXTN(jconst_idct_red_avx2):
+
+PW_F184_MF076   times 8  dw  F_1_847, -F_0_765
+PW_F256_F089    times 8  dw  F_2_562,  F_0_899
+PW_F106_MF217   times 8  dw  F_1_061, -F_2_172
+PW_MF060_MF050  times 8  dw -F_0_601, -F_0_509
+PW_F145_MF021   times 8  dw  F_1_451, -F_0_211
+PD_DESCALE_P1_4 times 8  dd  1 << (DESCALE_P1_4 - 1)
+PD_DESCALE_P2_4 times 4  dd  1 << (DESCALE_P2_4 - 1)
+PB_CENTERJSAMP  times 16 db  CENTERJSAMPLE
+
+    ALIGNZ      32
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Perform dequantization and inverse DCT on one block of coefficients,
+; producing a reduced-size 4x4 output block.
+;
+; GLOBAL(void)
+; jsimd_idct_4x4_avx2(void *dct_table, JCOEFPTR coef_block,
+;                     JSAMPARRAY output_buf, JDIMENSION output_col)
+;
+; r10 = void *dct_table
+; r11 = JCOEFPTR coef_block
+; r12 = JSAMPARRAY output_buf
+; r13d = JDIMENSION output_col
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_idct_4x4_avx2)
+
+EXTN(jsimd_idct_4x4_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 4
+
+    ; ---- Pass 1: process columns from input.
+
+%ifndef NO_ZERO_COLUMN_TEST_4X4_AVX2
+    mov         eax, dword [DWBLOCK(1, 0, r11, SIZEOF_JCOEF)]
+    or          eax, dword [DWBLOCK(2, 0, r11, SIZEOF_JCOEF)]
+    jnz         short .columnDCT
+
+    movdqa      xmm0, XMMWORD [XMMBLOCK(1, 0, r11, SIZEOF_JCOEF)]
+    movdqa      xmm1, XMMWORD [XMMBLOCK(2, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm0, xmm0, XMMWORD [XMMBLOCK(3, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm1, xmm1, XMMWORD [XMMBLOCK(5, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm0, xmm0, XMMWORD [XMMBLOCK(6, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm1, xmm1, XMMWORD [XMMBLOCK(7, 0, r11, SIZEOF_JCOEF)]
+    vpor        xmm0, xmm0, xmm1
+    vpacksswb   xmm0, xmm0, xmm0
+    vpacksswb   xmm0, xmm0, xmm0
+    movd        eax, xmm0
+    test        rax, rax
+    jnz         short .columnDCT
+
+    ; -- AC terms all zero
+
+    movdqa      xmm0, XMMWORD [XMMBLOCK(0, 0, r11, SIZEOF_JCOEF)]
+    vpmullw     xmm0, xmm0, XMMWORD [XMMBLOCK(0, 0, r10, SIZEOF_ISLOW_MULT_TYPE)]
+
+    vpsllw      xmm0, xmm0, PASS1_BITS
+
+    vpunpckhwd  xmm3, xmm0, xmm0        ; xmm3 = (04 04 05 05 06 06 07 07)
+    vpunpcklwd  xmm0, xmm0, xmm0        ; xmm0 = (00 00 01 01 02 02 03 03)
+
+    vpshufd     xmm1, xmm0, 0x50
+                ; xmm1 = [col0 col1] = (00 00 00 00 01 01 01 01)
+    vpshufd     xmm0, xmm0, 0xFA
+                ; xmm0 = [col2 col3] = (02 02 02 02 03 03 03 03)
+    vpshufd     xmm6, xmm3, 0x50
+                ; xmm6 = [col4 col5] = (04 04 04 04 05 05 05 05)
+    vpshufd     xmm3, xmm3, 0xFA
+                ; xmm3 = [col6 col7] = (06 06 06 06 07 07 07 07)
+
+    jmp         near .column_end
+%endif
+.columnDCT:
+
+    ; -- Odd part
+
+    vmovdqu     xmm0, XMMWORD [XMMBLOCK(1, 0, r11, SIZEOF_JCOEF)]
+    vmovdqu     xmm1, XMMWORD [XMMBLOCK(3, 0, r11, SIZEOF_JCOEF)]
+    vmovdqu     xmm2, XMMWORD [XMMBLOCK(5, 0, r11, SIZEOF_JCOEF)]
+    vmovdqu     xmm3, XMMWORD [XMMBLOCK(7, 0, r11, SIZEOF_JCOEF)]
+    vpmullw     xmm0, xmm0, XMMWORD [XMMBLOCK(1, 0, r10, SIZEOF_ISLOW_MULT_TYPE)]
+    vpmullw     xmm1, xmm1, XMMWORD [XMMBLOCK(3, 0, r10, SIZEOF_ISLOW_MULT_TYPE)]
+    vpmullw     xmm2, xmm2, XMMWORD [XMMBLOCK(5, 0, r10, SIZEOF_ISLOW_MULT_TYPE)]
+    vpmullw     xmm3, xmm3, XMMWORD [XMMBLOCK(7, 0, r10, SIZEOF_ISLOW_MULT_TYPE)]
+
+    vpunpcklwd  xmm4, xmm0, xmm1        ; xmm4 = (10 30 11 31 12 32 13 33)
+    vpunpckhwd  xmm0, xmm0, xmm1        ; xmm0 = (14 34 15 35 16 36 17 37)
+    vpunpcklwd  xmm5, xmm2, xmm3        ; xmm5 = (50 70 51 71 52 72 53 73)
+    vpunpckhwd  xmm2, xmm2, xmm3        ; xmm2 = (54 74 55 75 56 76 57 77)
+    vinserti128 ymm4, ymm4, xmm0, 1
+           ; ymm4 = (10 30 11 31 12 32 13 33  14 34 15 35 16 36 17 37)
+    vinserti128 ymm5, ymm5, xmm2, 1
+           ; ymm5 = (50 70 51 71 52 72 53 73  54 74 55 75 56 76 57 77)
+
+    vpmaddwd    ymm0, ymm4, [rel PW_F256_F089]    ; ymm0 = (tmp2)
+    vpmaddwd    ymm4, ymm4, [rel PW_F106_MF217]   ; ymm4 = (tmp0)
+    vpmaddwd    ymm1, ymm5, [rel PW_MF060_MF050]  ; ymm1 = (tmp2)
+    vpmaddwd    ymm5, ymm5, [rel PW_F145_MF021]   ; ymm5 = (tmp0)
+
+    vpaddd      ymm6, ymm1, ymm0        ; ymm6 = tmp2
+    vpaddd      ymm7, ymm5, ymm4        ; ymm7 = tmp0
+
+    ; -- Even part
+
+    vmovdqu     xmm0, XMMWORD [XMMBLOCK(0, 0, r11, SIZEOF_JCOEF)]
+    vmovdqu     xmm1, XMMWORD [XMMBLOCK(2, 0, r11, SIZEOF_JCOEF)]
+    vmovdqu     xmm2, XMMWORD [XMMBLOCK(6, 0, r11, SIZEOF_JCOEF)]
+    vpmullw     xmm0, xmm0, XMMWORD [XMMBLOCK(0, 0, r10, SIZEOF_ISLOW_MULT_TYPE)]
+    vpmullw     xmm1, xmm1, XMMWORD [XMMBLOCK(2, 0, r10, SIZEOF_ISLOW_MULT_TYPE)]
+    vpmullw     xmm2, xmm2, XMMWORD [XMMBLOCK(6, 0, r10, SIZEOF_ISLOW_MULT_TYPE)]
+
+    vpmovsxwd   ymm0, xmm0
+    vpslld      ymm0, ymm0, CONST_BITS + 1  ; ymm0 = tmp0
+
+    vpunpcklwd  xmm3, xmm1, xmm2        ; xmm3 = (20 60 21 61 22 62 23 63)
+    vpunpckhwd  xmm1, xmm1, xmm2        ; xmm1 = (24 64 25 65 26 66 27 67)
+    vinserti128 ymm3, ymm3, xmm1, 1
+           ; ymm3 = (20 60 21 61 22 62 23 63  24 64 25 65 26 66 27 67)
+    vpmaddwd    ymm3, ymm3, [rel PW_F184_MF076]  ; ymm3 = tmp2
+
+    vpaddd      ymm1, ymm0, ymm3        ; ymm1 = tmp10
+    vpsubd      ymm0, ymm0, ymm3        ; ymm0 = tmp12
+
+    ; -- Final output stage
+
+    vmovdqa     ymm5, [rel PD_DESCALE_P1_4]  ; ymm5 = [rel PD_DESCALE_P1_4]
+
+    vpaddd      ymm2, ymm1, ymm6        ; ymm2 = data0
+    vpsubd      ymm1, ymm1, ymm6        ; ymm1 = data3
+    vpaddd      ymm3, ymm0, ymm7        ; ymm3 = data1
+    vpsubd      ymm0, ymm0, ymm7        ; ymm0 = data2
+
+    vpaddd      ymm2, ymm2, ymm5
+    vpaddd      ymm1, ymm1, ymm5
+    vpaddd      ymm3, ymm3, ymm5
+    vpaddd      ymm0, ymm0, ymm5
+    vpsrad      ymm2, ymm2, DESCALE_P1_4
+    vpsrad      ymm1, ymm1, DESCALE_P1_4
+    vpsrad      ymm3, ymm3, DESCALE_P1_4
+    vpsrad      ymm0, ymm0, DESCALE_P1_4
+
+    vpackssdw   ymm2, ymm2, ymm3
+           ; ymm2 = (00 01 02 03 10 11 12 13  04 05 06 07 14 15 16 17)
+    vpackssdw   ymm0, ymm0, ymm1
+           ; ymm0 = (20 21 22 23 30 31 32 33  24 25 26 27 34 35 36 37)
+
+    vpunpcklwd  ymm4, ymm2, ymm0        ; transpose coefficients(phase 1)
+           ; ymm4 = (00 20 01 21 02 22 03 23  04 24 05 25 06 26 07 27)
+    vpunpckhwd  ymm5, ymm2, ymm0        ; transpose coefficients(phase 1)
+           ; ymm5 = (10 30 11 31 12 32 13 33  14 34 15 35 16 36 17 37)
+
+    vpunpcklwd  ymm1, ymm4, ymm5        ; transpose coefficients(phase 2)
+           ; ymm1 = (00 10 20 30 01 11 21 31  04 14 24 34 05 15 25 35)
+    vpunpckhwd  ymm0, ymm4, ymm5        ; transpose coefficients(phase 2)
+           ; ymm0 = (02 12 22 32 03 13 23 33  06 16 26 36 07 17 27 37)
+
+    vextracti128 xmm6, ymm1, 1
+                ; xmm6 = [col4 col5] = (04 14 24 34 05 15 25 35)
+    vextracti128 xmm3, ymm0, 1
+                ; xmm3 = [col6 col7] = (06 16 26 36 07 17 27 37)
+.column_end:
+
+    ; -- Prefetch the next coefficient block
+
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 0 * 32]
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 1 * 32]
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 2 * 32]
+    prefetchnta [r11 + DCTSIZE2 * SIZEOF_JCOEF + 3 * 32]
+
+    ; ---- Pass 2: process rows, store into output array.
+
+    ; -- Even part
+
+    vpmovsxwd   xmm4, xmm1
+    vpslld      xmm4, xmm4, CONST_BITS + 1  ; xmm4 = tmp0
+
+    ; -- Odd part
+
+    vpunpckhwd  xmm1, xmm1, xmm0
+    vpunpckhwd  xmm6, xmm6, xmm3
+    vpmaddwd    xmm5, xmm1, [rel PW_F106_MF217]   ; xmm5 = (tmp0)
+    vpmaddwd    xmm1, xmm1, [rel PW_F256_F089]    ; xmm1 = (tmp2)
+    vpmaddwd    xmm2, xmm6, [rel PW_F145_MF021]   ; xmm2 = (tmp0)
+    vpmaddwd    xmm6, xmm6, [rel PW_MF060_MF050]  ; xmm6 = (tmp2)
+
+    vpaddd      xmm6, xmm6, xmm1        ; xmm6 = tmp2
+    vpaddd      xmm2, xmm2, xmm5        ; xmm2 = tmp0
+
+    ; -- Even part
+
+    vpunpcklwd  xmm0, xmm0, xmm3
+    vpmaddwd    xmm0, xmm0, [rel PW_F184_MF076]  ; xmm0 = tmp2
+
+    vpsubd      xmm7, xmm4, xmm0        ; xmm7 = tmp12
+    vpaddd      xmm4, xmm4, xmm0        ; xmm4 = tmp10
+
+    ; -- Final output stage
+
+    vmovdqa     xmm1, [rel PD_DESCALE_P2_4]  ; xmm1 = [rel PD_DESCALE_P2_4]
+
+    vpsubd      xmm5, xmm4, xmm6        ; xmm5 = data3 = (03 13 23 33)
+    vpaddd      xmm4, xmm4, xmm6        ; xmm4 = data0 = (00 10 20 30)
+    vpsubd      xmm3, xmm7, xmm2        ; xmm3 = data2 = (02 12 22 32)
+    vpaddd      xmm7, xmm7, xmm2        ; xmm7 = data1 = (01 11 21 31)
+
+    vpaddd      xmm4, xmm4, xmm1
+    vpaddd      xmm7, xmm7, xmm1
+    vpsrad      xmm4, xmm4, DESCALE_P2_4
+    vpsrad      xmm7, xmm7, DESCALE_P2_4
+    vpaddd      xmm5, xmm5, xmm1
+    vpaddd      xmm3, xmm3, xmm1
+    vpsrad      xmm5, xmm5, DESCALE_P2_4
+    vpsrad      xmm3, xmm3, DESCALE_P2_4
+
+    vpackssdw   xmm4, xmm4, xmm3        ; xmm4 = (00 10 20 30 02 12 22 32)
+    vpackssdw   xmm7, xmm7, xmm5        ; xmm7 = (01 11 21 31 03 13 23 33)
+
+    vpunpckhwd  xmm0, xmm4, xmm7        ; transpose coefficients(phase 1)
+                                        ; xmm0 = (02 03 12 13 22 23 32 33)
+    vpunpcklwd  xmm4, xmm4, xmm7        ; transpose coefficients(phase 1)
+                                        ; xmm4 = (00 01 10 11 20 21 30 31)
+
+    vpunpckhdq  xmm6, xmm4, xmm0        ; transpose coefficients(phase 2)
+                                        ; xmm6 = (20 21 22 23 30 31 32 33)
+    vpunpckldq  xmm4, xmm4, xmm0        ; transpose coefficients(phase 2)
+                                        ; xmm4 = (00 01 02 03 10 11 12 13)
+
+    vpacksswb   xmm4, xmm4, xmm6       ; xmm4 = (00 01 02 03 10 11 12 13 20 ..)
+    vpaddb      xmm4, xmm4, [rel PB_CENTERJSAMP]
+
+    vpshufd     xmm2, xmm4, 0x39       ; xmm2 = (10 11 12 13 20 21 22 23 30 ..)
+    vpshufd     xmm1, xmm4, 0x4E       ; xmm1 = (20 21 22 23 30 31 32 33 00 ..)
+    vpshufd     xmm3, xmm4, 0x93       ; xmm3 = (30 31 32 33 00 01 02 03 10 ..)
+
+    vzeroupper
+
+    mov         eax, r13d
+
+    mov         rdxp, JSAMPROW [r12 + 0 * SIZEOF_JSAMPROW]
+    mov         rsip, JSAMPROW [r12 + 1 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm4
+    movd        XMM_DWORD [rsi + rax * SIZEOF_JSAMPLE], xmm2
+    mov         rdxp, JSAMPROW [r12 + 2 * SIZEOF_JSAMPROW]
+    mov         rsip, JSAMPROW [r12 + 3 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm1
+    movd        XMM_DWORD [rsi + rax * SIZEOF_JSAMPLE], xmm3
+
+    UNCOLLECT_ARGS 4
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
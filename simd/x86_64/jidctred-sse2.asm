@@ -2,7 +2,7 @@
 ; Scaled Integer Inverse DCT (64-bit SSE2)
 ;
 ; Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
-; Copyright (C) 2009, 2016, 2024-2025, D. R. Commander.
+; Copyright (C) 2009, 2016, 2024-2026, D. R. Commander.
 ; Copyright (C) 2018, Matthias Räncker.
 ; Copyright (C) 2023, Aliaksiej Kandracienka.
 ;
@@ -13,8 +13,11 @@
 ; This file should be assembled with NASM (Netwide Assembler) or Yasm.
 ;
 ; This file contains inverse DCT routines that produce reduced-size output:
-; either 4x4 or 2x2 pixels from an 8x8 DCT block.  The following code is based
-; directly on the IJG's original jidctred.c; see jidctred.c for more details.
+; 7x7, 6x6, 5x5, 4x4, 3x3, or 2x2 pixels from an 8x8 DCT block.  The 4x4 and
+; 2x2 routines are based directly on the IJG's original jidctred.c; see
+; jidctred.c for more details.  The 7x7, 6x6, 5x5, and 3x3 routines produce
+; the same results as the corresponding routines in jidctint.c, but each 1-D
+; pass is computed as a sum of PMADDWD products.
 
 %include "jsimdext.inc"
 %include "jdct.inc"
@@ -28,37 +31,79 @@
 %define DESCALE_P2_4  (CONST_BITS + PASS1_BITS + 3 + 1)
 %define DESCALE_P1_2  (CONST_BITS - PASS1_BITS + 2)
 %define DESCALE_P2_2  (CONST_BITS + PASS1_BITS + 3 + 2)
+%define DESCALE_P1    (CONST_BITS - PASS1_BITS)
+%define DESCALE_P2    (CONST_BITS + PASS1_BITS + 3)
 
 %if CONST_BITS == 13
+F_0_077 equ   637  ; FIX(0.077722536)
+F_0_170 equ  1395  ; FIX(0.170262339)
 F_0_211 equ  1730  ; FIX(0.211164243)
+F_0_314 equ  2578  ; FIX(0.314692123)
+F_0_353 equ  2896  ; FIX(0.353553391)
+F_0_366 equ  2998  ; FIX(0.366025404)
 F_0_509 equ  4176  ; FIX(0.509795579)
+F_0_513 equ  4209  ; FIX(0.513743148)
 F_0_601 equ  4926  ; FIX(0.601344887)
+F_0_613 equ  5027  ; FIX(0.613604268)
+F_0_707 equ  5793  ; FIX(0.707106781)
 F_0_720 equ  5906  ; FIX(0.720959822)
 F_0_765 equ  6270  ; FIX(0.765366865)
+F_0_790 equ  6476  ; FIX(0.790569415)
+F_0_831 equ  6810  ; FIX(0.831253876)
 F_0_850 equ  6967  ; FIX(0.850430095)
+F_0_881 equ  7223  ; FIX(0.881747734)
 F_0_899 equ  7373  ; FIX(0.899976223)
+F_0_935 equ  7663  ; FIX(0.935414347)
 F_1_061 equ  8697  ; FIX(1.061594337)
+F_1_224 equ 10033  ; FIX(1.224744871)
 F_1_272 equ 10426  ; FIX(1.272758580)
+F_1_274 equ 10438  ; FIX(1.274162392)
+F_1_378 equ 11295  ; FIX(1.378756276)
+F_1_414 equ 11585  ; FIX(1.414213562)
 F_1_451 equ 11893  ; FIX(1.451774981)
+F_1_841 equ 15083  ; FIX(1.841218003)
 F_1_847 equ 15137  ; FIX(1.847759065)
+F_1_870 equ 15326  ; FIX(1.870828693)
 F_2_172 equ 17799  ; FIX(2.172734803)
+F_2_176 equ 17828  ; FIX(2.176250899)
+F_2_470 equ 20239  ; FIX(2.470602249)
 F_2_562 equ 20995  ; FIX(2.562915447)
 F_3_624 equ 29692  ; FIX(3.624509785)
 %else
 ; NASM cannot do compile-time arithmetic on floating-point constants.
 %define DESCALE(x, n)  (((x) + (1 << ((n) - 1))) >> (n))
+F_0_077 equ DESCALE(  83453938, 30 - CONST_BITS)  ; FIX(0.077722536)
+F_0_170 equ DESCALE( 182817794, 30 - CONST_BITS)  ; FIX(0.170262339)
 F_0_211 equ DESCALE( 226735879, 30 - CONST_BITS)  ; FIX(0.211164243)
+F_0_314 equ DESCALE( 337898094, 30 - CONST_BITS)  ; FIX(0.314692123)
+F_0_353 equ DESCALE( 379625063, 30 - CONST_BITS)  ; FIX(0.353553391)
+F_0_366 equ DESCALE( 393016785, 30 - CONST_BITS)  ; FIX(0.366025404)
 F_0_509 equ DESCALE( 547388834, 30 - CONST_BITS)  ; FIX(0.509795579)
+F_0_513 equ DESCALE( 551627505, 30 - CONST_BITS)  ; FIX(0.513743148)
 F_0_601 equ DESCALE( 645689155, 30 - CONST_BITS)  ; FIX(0.601344887)
+F_0_613 equ DESCALE( 658852566, 30 - CONST_BITS)  ; FIX(0.613604268)
+F_0_707 equ DESCALE( 759250125, 30 - CONST_BITS)  ; FIX(0.707106781)
 F_0_720 equ DESCALE( 774124714, 30 - CONST_BITS)  ; FIX(0.720959822)
 F_0_765 equ DESCALE( 821806413, 30 - CONST_BITS)  ; FIX(0.765366865)
+F_0_790 equ DESCALE( 848867446, 30 - CONST_BITS)  ; FIX(0.790569415)
+F_0_831 equ DESCALE( 892552053, 30 - CONST_BITS)  ; FIX(0.831253876)
 F_0_850 equ DESCALE( 913142361, 30 - CONST_BITS)  ; FIX(0.850430095)
+F_0_881 equ DESCALE( 946769420, 30 - CONST_BITS)  ; FIX(0.881747734)
 F_0_899 equ DESCALE( 966342111, 30 - CONST_BITS)  ; FIX(0.899976223)
+F_0_935 equ DESCALE(1004393507, 30 - CONST_BITS)  ; FIX(0.935414347)
 F_1_061 equ DESCALE(1139878239, 30 - CONST_BITS)  ; FIX(1.061594337)
+F_1_224 equ DESCALE(1315059792, 30 - CONST_BITS)  ; FIX(1.224744871)
 F_1_272 equ DESCALE(1366614119, 30 - CONST_BITS)  ; FIX(1.272758580)
+F_1_274 equ DESCALE(1368121451, 30 - CONST_BITS)  ; FIX(1.274162392)
+F_1_378 equ DESCALE(1480428279, 30 - CONST_BITS)  ; FIX(1.378756276)
+F_1_414 equ DESCALE(1518500250, 30 - CONST_BITS)  ; FIX(1.414213562)
 F_1_451 equ DESCALE(1558831516, 30 - CONST_BITS)  ; FIX(1.451774981)
+F_1_841 equ DESCALE(1976992777, 30 - CONST_BITS)  ; FIX(1.841218003)
 F_1_847 equ DESCALE(1984016188, 30 - CONST_BITS)  ; FIX(1.847759065)
+F_1_870 equ DESCALE(2008787013, 30 - CONST_BITS)  ; FIX(1.870828693)
 F_2_172 equ DESCALE(2332956230, 30 - CONST_BITS)  ; FIX(2.172734803)
+F_2_176 equ DESCALE(2336731610, 30 - CONST_BITS)  ; FIX(2.176250899)
+F_2_470 equ DESCALE(2652788965, 30 - CONST_BITS)  ; FIX(2.470602249)
 F_2_562 equ DESCALE(2751909506, 30 - CONST_BITS)  ; FIX(2.562915447)
 F_3_624 equ DESCALE(3891787747, 30 - CONST_BITS)  ; FIX(3.624509785)
 %endif
@@ -78,10 +123,49 @@ PW_MF060_MF050  times 4  dw -F_0_601, -F_0_509
 PW_F145_MF021   times 4  dw  F_1_451, -F_0_211
 PW_F362_MF127   times 4  dw  F_3_624, -F_1_272
 PW_F085_MF072   times 4  dw  F_0_850, -F_0_720
+PW_7X7_0_02     times 4  dw  (1 << CONST_BITS), F_1_274
+PW_7X7_0_46     times 4  dw  F_0_881, (F_1_274 - F_0_077 - F_0_881)
+PW_7X7_0_13     times 4  dw  (F_0_613 + F_0_935 - F_0_170), (F_0_170 + F_0_935)
+PW_7X7_0_57     times 4  dw  F_0_613, 0
+PW_7X7_1_02     times 4  dw  (1 << CONST_BITS), F_0_314
+PW_7X7_1_46     times 4  dw  (F_0_881 - F_0_314 - F_1_841), -F_0_881
+PW_7X7_1_13     times 4  dw  (F_0_170 + F_0_935), (F_0_935 - F_0_170 - F_1_378)
+PW_7X7_1_57     times 4  dw -F_1_378, 0
+PW_7X7_2_02     times 4  dw  (1 << CONST_BITS), (F_0_314 + F_1_274 - F_2_470)
+PW_7X7_2_46     times 4  dw -F_0_314, F_1_274
+PW_7X7_2_13     times 4  dw  F_0_613, -F_1_378
+PW_7X7_2_57     times 4  dw  (F_0_613 + F_1_870 - F_1_378), 0
+PW_7X7_3_02     times 4  dw  (1 << CONST_BITS), -F_1_414
+PW_7X7_3_46     times 4  dw  F_1_414, -F_1_414
+PW_6X6_0_02     times 4  dw  (1 << CONST_BITS), F_1_224
+PW_6X6_0_46     times 4  dw  F_0_707, 0
+PW_6X6_0_13     times 4  dw  ((1 << CONST_BITS) + F_0_366), (1 << CONST_BITS)
+PW_6X6_0_57     times 4  dw  F_0_366, 0
+PW_6X6_1_02     times 4  dw  (1 << CONST_BITS), 0
+PW_6X6_1_46     times 4  dw -F_0_707 * 2, 0
+PW_6X6_1_13     times 4  dw  (1 << CONST_BITS), -(1 << CONST_BITS)
+PW_6X6_1_57     times 4  dw -(1 << CONST_BITS), 0
+PW_6X6_2_02     times 4  dw  (1 << CONST_BITS), -F_1_224
+PW_6X6_2_46     times 4  dw  F_0_707, 0
+PW_6X6_2_13     times 4  dw  F_0_366, -(1 << CONST_BITS)
+PW_6X6_2_57     times 4  dw  ((1 << CONST_BITS) + F_0_366), 0
+PW_5X5_0_02     times 4  dw  (1 << CONST_BITS), (F_0_353 + F_0_790)
+PW_5X5_0_46     times 4  dw  (F_0_790 - F_0_353), 0
+PW_5X5_0_13     times 4  dw  (F_0_513 + F_0_831), F_0_831
+PW_5X5_1_02     times 4  dw  (1 << CONST_BITS), (F_0_353 - F_0_790)
+PW_5X5_1_46     times 4  dw  (-F_0_353 - F_0_790), 0
+PW_5X5_1_13     times 4  dw  F_0_831, (F_0_831 - F_2_176)
+PW_5X5_2_02     times 4  dw  (1 << CONST_BITS), -F_0_353 * 4
+PW_5X5_2_46     times 4  dw  F_0_353 * 4, 0
+PW_3X3_0_02     times 4  dw  (1 << CONST_BITS), F_0_707
+PW_3X3_0_13     times 4  dw  F_1_224, 0
+PW_3X3_1_02     times 4  dw  (1 << CONST_BITS), -F_0_707 * 2
 PD_DESCALE_P1_4 times 4  dd  1 << (DESCALE_P1_4 - 1)
 PD_DESCALE_P2_4 times 4  dd  1 << (DESCALE_P2_4 - 1)
 PD_DESCALE_P1_2 times 4  dd  1 << (DESCALE_P1_2 - 1)
 PD_DESCALE_P2_2 times 4  dd  1 << (DESCALE_P2_2 - 1)
+PD_DESCALE_P1   times 4  dd  1 << (DESCALE_P1 - 1)
+PD_DESCALE_P2   times 4  dd  1 << (DESCALE_P2 - 1)
 PB_CENTERJSAMP  times 16 db  CENTERJSAMPLE
 
     ALIGNZ      32
@@ -572,6 +656,1462 @@ EXTN(jsimd_idct_2x2_sse2):
     pop         rbp
     ret
 
+; --------------------------------------------------------------------------
+;
+; Perform dequantization and inverse DCT on one block of coefficients,
+; producing a reduced-size 7x7 output block.
+;
+; GLOBAL(void)
+; jsimd_idct_7x7_sse2(void *dct_table, JCOEFPTR coef_block,
+;                     JSAMPARRAY output_buf, JDIMENSION output_col)
+;
+; r10 = void *dct_table
+; r11 = JCOEFPTR coef_block
+; r12 = JSAMPARRAY output_buf
+; r13d = JDIMENSION output_col
+
+%define wk(i)   r15 - (WK_NUM - (i)) * SIZEOF_XMMWORD  ; xmmword wk[WK_NUM]
+%define WK_NUM  15
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_idct_7x7_sse2)
+
+EXTN(jsimd_idct_7x7_sse2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    push        r15
+    and         rsp, byte (-SIZEOF_XMMWORD)  ; align to 128 bits
+    ; Allocate stack space for wk array.  r15 is used to access it.
+    mov         r15, rsp
+    sub         rsp, (SIZEOF_XMMWORD * WK_NUM)
+    COLLECT_ARGS 4
+
+    ; ---- Pass 1: process columns from input.
+
+    mov         rdx, r10                ; quantptr
+    mov         rsi, r11                ; inptr
+
+    ; -- Dequantize and interleave coefficients
+
+    pxor        xmm7, xmm7
+    movdqa      xmm0, XMMWORD [XMMBLOCK(0, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm0, XMMWORD [XMMBLOCK(0, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm1, XMMWORD [XMMBLOCK(2, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm1, XMMWORD [XMMBLOCK(2, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm2, xmm0
+    punpcklwd   xmm0, xmm1              ; xmm0 = (00 20 01 21 02 22 03 23)
+    punpckhwd   xmm2, xmm1              ; xmm2 = (04 24 05 25 06 26 07 27)
+    movdqa      XMMWORD [wk(0)], xmm0
+    movdqa      XMMWORD [wk(1)], xmm2
+    movdqa      xmm3, XMMWORD [XMMBLOCK(4, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm3, XMMWORD [XMMBLOCK(4, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm4, XMMWORD [XMMBLOCK(6, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm4, XMMWORD [XMMBLOCK(6, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm5, xmm3
+    punpcklwd   xmm3, xmm4              ; xmm3 = (40 60 41 61 42 62 43 63)
+    punpckhwd   xmm5, xmm4              ; xmm5 = (44 64 45 65 46 66 47 67)
+    movdqa      XMMWORD [wk(2)], xmm3
+    movdqa      XMMWORD [wk(3)], xmm5
+    movdqa      xmm0, XMMWORD [XMMBLOCK(1, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm0, XMMWORD [XMMBLOCK(1, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm1, XMMWORD [XMMBLOCK(3, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm1, XMMWORD [XMMBLOCK(3, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm2, xmm0
+    punpcklwd   xmm0, xmm1              ; xmm0 = (10 30 11 31 12 32 13 33)
+    punpckhwd   xmm2, xmm1              ; xmm2 = (14 34 15 35 16 36 17 37)
+    movdqa      XMMWORD [wk(4)], xmm0
+    movdqa      XMMWORD [wk(5)], xmm2
+    movdqa      xmm3, XMMWORD [XMMBLOCK(5, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm3, XMMWORD [XMMBLOCK(5, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm5, xmm3
+    punpcklwd   xmm3, xmm7              ; xmm3 = (50 -- 51 -- 52 -- 53 --)
+    punpckhwd   xmm5, xmm7              ; xmm5 = (54 -- 55 -- 56 -- 57 --)
+    movdqa      XMMWORD [wk(6)], xmm3
+    movdqa      XMMWORD [wk(7)], xmm5
+
+    ; -- Rows 0 and 6
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_7X7_0_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_7X7_0_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P1]  ; xmm0 = even0L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_7X7_0_13]
+    movdqa      xmm2, XMMWORD [wk(6)]
+    pmaddwd     xmm2, [rel PW_7X7_0_57]
+    paddd       xmm1, xmm2
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data0L
+    psubd       xmm2, xmm1              ; xmm2 = data6L
+    psrad       xmm0, DESCALE_P1
+    psrad       xmm2, DESCALE_P1
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_7X7_0_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_7X7_0_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P1]  ; xmm3 = even0H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_7X7_0_13]
+    movdqa      xmm5, XMMWORD [wk(7)]
+    pmaddwd     xmm5, [rel PW_7X7_0_57]
+    paddd       xmm4, xmm5
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data0H
+    psubd       xmm5, xmm4              ; xmm5 = data6H
+    psrad       xmm3, DESCALE_P1
+    psrad       xmm5, DESCALE_P1
+
+    packssdw    xmm0, xmm3              ; xmm0 = data0
+    packssdw    xmm2, xmm5              ; xmm2 = data6
+    pshuflw     xmm0, xmm0, 0xD8
+    pshufhw     xmm0, xmm0, 0xD8        ; xmm0 = (00 02 01 03 04 06 05 07)
+    pshuflw     xmm2, xmm2, 0xD8
+    pshufhw     xmm2, xmm2, 0xD8        ; xmm2 = (60 62 61 63 64 66 65 67)
+    movdqa      XMMWORD [wk(8)], xmm0
+    movdqa      XMMWORD [wk(14)], xmm2
+
+    ; -- Rows 1 and 5
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_7X7_1_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_7X7_1_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P1]  ; xmm0 = even1L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_7X7_1_13]
+    movdqa      xmm2, XMMWORD [wk(6)]
+    pmaddwd     xmm2, [rel PW_7X7_1_57]
+    paddd       xmm1, xmm2
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data1L
+    psubd       xmm2, xmm1              ; xmm2 = data5L
+    psrad       xmm0, DESCALE_P1
+    psrad       xmm2, DESCALE_P1
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_7X7_1_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_7X7_1_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P1]  ; xmm3 = even1H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_7X7_1_13]
+    movdqa      xmm5, XMMWORD [wk(7)]
+    pmaddwd     xmm5, [rel PW_7X7_1_57]
+    paddd       xmm4, xmm5
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data1H
+    psubd       xmm5, xmm4              ; xmm5 = data5H
+    psrad       xmm3, DESCALE_P1
+    psrad       xmm5, DESCALE_P1
+
+    packssdw    xmm0, xmm3              ; xmm0 = data1
+    packssdw    xmm2, xmm5              ; xmm2 = data5
+    pshuflw     xmm0, xmm0, 0xD8
+    pshufhw     xmm0, xmm0, 0xD8        ; xmm0 = (10 12 11 13 14 16 15 17)
+    pshuflw     xmm2, xmm2, 0xD8
+    pshufhw     xmm2, xmm2, 0xD8        ; xmm2 = (50 52 51 53 54 56 55 57)
+    movdqa      XMMWORD [wk(9)], xmm0
+    movdqa      XMMWORD [wk(13)], xmm2
+
+    ; -- Rows 2 and 4
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_7X7_2_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_7X7_2_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P1]  ; xmm0 = even2L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_7X7_2_13]
+    movdqa      xmm2, XMMWORD [wk(6)]
+    pmaddwd     xmm2, [rel PW_7X7_2_57]
+    paddd       xmm1, xmm2
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data2L
+    psubd       xmm2, xmm1              ; xmm2 = data4L
+    psrad       xmm0, DESCALE_P1
+    psrad       xmm2, DESCALE_P1
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_7X7_2_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_7X7_2_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P1]  ; xmm3 = even2H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_7X7_2_13]
+    movdqa      xmm5, XMMWORD [wk(7)]
+    pmaddwd     xmm5, [rel PW_7X7_2_57]
+    paddd       xmm4, xmm5
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data2H
+    psubd       xmm5, xmm4              ; xmm5 = data4H
+    psrad       xmm3, DESCALE_P1
+    psrad       xmm5, DESCALE_P1
+
+    packssdw    xmm0, xmm3              ; xmm0 = data2
+    packssdw    xmm2, xmm5              ; xmm2 = data4
+    pshuflw     xmm0, xmm0, 0xD8
+    pshufhw     xmm0, xmm0, 0xD8        ; xmm0 = (20 22 21 23 24 26 25 27)
+    pshuflw     xmm2, xmm2, 0xD8
+    pshufhw     xmm2, xmm2, 0xD8        ; xmm2 = (40 42 41 43 44 46 45 47)
+    movdqa      XMMWORD [wk(10)], xmm0
+    movdqa      XMMWORD [wk(12)], xmm2
+
+    ; -- Row 3
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_7X7_3_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_7X7_3_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P1]  ; xmm0 = even3L
+    psrad       xmm0, DESCALE_P1        ; xmm0 = data3L
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_7X7_3_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_7X7_3_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P1]  ; xmm3 = even3H
+    psrad       xmm3, DESCALE_P1        ; xmm3 = data3H
+
+    packssdw    xmm0, xmm3              ; xmm0 = data3
+    pshuflw     xmm0, xmm0, 0xD8
+    pshufhw     xmm0, xmm0, 0xD8        ; xmm0 = (30 32 31 33 34 36 35 37)
+    movdqa      XMMWORD [wk(11)], xmm0
+
+    ; -- Transpose coefficients
+
+    movdqa      xmm0, XMMWORD [wk(8)]
+    movdqa      xmm1, XMMWORD [wk(9)]
+    movdqa      xmm2, XMMWORD [wk(10)]
+    movdqa      xmm3, XMMWORD [wk(11)]
+    movdqa      xmm4, xmm0
+    punpckldq   xmm0, xmm1
+    punpckhdq   xmm4, xmm1
+    movdqa      xmm5, xmm2
+    punpckldq   xmm2, xmm3
+    punpckhdq   xmm5, xmm3
+    movdqa      xmm1, xmm0
+    punpcklqdq  xmm0, xmm2
+    punpckhqdq  xmm1, xmm2
+    movdqa      xmm3, xmm4
+    punpcklqdq  xmm4, xmm5
+    punpckhqdq  xmm3, xmm5
+    movdqa      XMMWORD [wk(0)], xmm0
+    movdqa      XMMWORD [wk(2)], xmm4
+    movdqa      XMMWORD [wk(4)], xmm1
+    movdqa      XMMWORD [wk(6)], xmm3
+
+    movdqa      xmm0, XMMWORD [wk(12)]
+    movdqa      xmm1, XMMWORD [wk(13)]
+    movdqa      xmm2, XMMWORD [wk(14)]
+    pxor        xmm3, xmm3
+    movdqa      xmm4, xmm0
+    punpckldq   xmm0, xmm1
+    punpckhdq   xmm4, xmm1
+    movdqa      xmm5, xmm2
+    punpckldq   xmm2, xmm3
+    punpckhdq   xmm5, xmm3
+    movdqa      xmm1, xmm0
+    punpcklqdq  xmm0, xmm2
+    punpckhqdq  xmm1, xmm2
+    movdqa      xmm3, xmm4
+    punpcklqdq  xmm4, xmm5
+    punpckhqdq  xmm3, xmm5
+    movdqa      XMMWORD [wk(1)], xmm0
+    movdqa      XMMWORD [wk(3)], xmm4
+    movdqa      XMMWORD [wk(5)], xmm1
+    movdqa      XMMWORD [wk(7)], xmm3
+
+    ; -- Prefetch the next coefficient block
+
+    prefetchnta [rsi + DCTSIZE2 * SIZEOF_JCOEF + 0 * 32]
+    prefetchnta [rsi + DCTSIZE2 * SIZEOF_JCOEF + 1 * 32]
+    prefetchnta [rsi + DCTSIZE2 * SIZEOF_JCOEF + 2 * 32]
+    prefetchnta [rsi + DCTSIZE2 * SIZEOF_JCOEF + 3 * 32]
+
+    ; ---- Pass 2: process rows, store into output array.
+
+    mov         rdi, r12                ; (JSAMPROW *)
+    mov         eax, r13d
+
+    ; -- Columns 0 and 6
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_7X7_0_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_7X7_0_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P2]  ; xmm0 = even0L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_7X7_0_13]
+    movdqa      xmm2, XMMWORD [wk(6)]
+    pmaddwd     xmm2, [rel PW_7X7_0_57]
+    paddd       xmm1, xmm2
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data0L
+    psubd       xmm2, xmm1              ; xmm2 = data6L
+    psrad       xmm0, DESCALE_P2
+    psrad       xmm2, DESCALE_P2
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_7X7_0_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_7X7_0_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P2]  ; xmm3 = even0H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_7X7_0_13]
+    movdqa      xmm5, XMMWORD [wk(7)]
+    pmaddwd     xmm5, [rel PW_7X7_0_57]
+    paddd       xmm4, xmm5
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data0H
+    psubd       xmm5, xmm4              ; xmm5 = data6H
+    psrad       xmm3, DESCALE_P2
+    psrad       xmm5, DESCALE_P2
+
+    packssdw    xmm0, xmm3              ; xmm0 = data0
+    packssdw    xmm2, xmm5              ; xmm2 = data6
+    movdqa      XMMWORD [wk(8)], xmm0
+    movdqa      XMMWORD [wk(14)], xmm2
+
+    ; -- Columns 1 and 5
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_7X7_1_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_7X7_1_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P2]  ; xmm0 = even1L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_7X7_1_13]
+    movdqa      xmm2, XMMWORD [wk(6)]
+    pmaddwd     xmm2, [rel PW_7X7_1_57]
+    paddd       xmm1, xmm2
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data1L
+    psubd       xmm2, xmm1              ; xmm2 = data5L
+    psrad       xmm0, DESCALE_P2
+    psrad       xmm2, DESCALE_P2
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_7X7_1_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_7X7_1_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P2]  ; xmm3 = even1H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_7X7_1_13]
+    movdqa      xmm5, XMMWORD [wk(7)]
+    pmaddwd     xmm5, [rel PW_7X7_1_57]
+    paddd       xmm4, xmm5
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data1H
+    psubd       xmm5, xmm4              ; xmm5 = data5H
+    psrad       xmm3, DESCALE_P2
+    psrad       xmm5, DESCALE_P2
+
+    packssdw    xmm0, xmm3              ; xmm0 = data1
+    packssdw    xmm2, xmm5              ; xmm2 = data5
+    movdqa      XMMWORD [wk(9)], xmm0
+    movdqa      XMMWORD [wk(13)], xmm2
+
+    ; -- Columns 2 and 4
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_7X7_2_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_7X7_2_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P2]  ; xmm0 = even2L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_7X7_2_13]
+    movdqa      xmm2, XMMWORD [wk(6)]
+    pmaddwd     xmm2, [rel PW_7X7_2_57]
+    paddd       xmm1, xmm2
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data2L
+    psubd       xmm2, xmm1              ; xmm2 = data4L
+    psrad       xmm0, DESCALE_P2
+    psrad       xmm2, DESCALE_P2
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_7X7_2_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_7X7_2_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P2]  ; xmm3 = even2H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_7X7_2_13]
+    movdqa      xmm5, XMMWORD [wk(7)]
+    pmaddwd     xmm5, [rel PW_7X7_2_57]
+    paddd       xmm4, xmm5
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data2H
+    psubd       xmm5, xmm4              ; xmm5 = data4H
+    psrad       xmm3, DESCALE_P2
+    psrad       xmm5, DESCALE_P2
+
+    packssdw    xmm0, xmm3              ; xmm0 = data2
+    packssdw    xmm2, xmm5              ; xmm2 = data4
+    movdqa      XMMWORD [wk(10)], xmm0
+    movdqa      XMMWORD [wk(12)], xmm2
+
+    ; -- Column 3
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_7X7_3_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_7X7_3_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P2]  ; xmm0 = even3L
+    psrad       xmm0, DESCALE_P2        ; xmm0 = data3L
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_7X7_3_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_7X7_3_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P2]  ; xmm3 = even3H
+    psrad       xmm3, DESCALE_P2        ; xmm3 = data3H
+
+    packssdw    xmm0, xmm3              ; xmm0 = data3
+    movdqa      XMMWORD [wk(11)], xmm0
+
+    movdqa      xmm0, XMMWORD [wk(8)]
+    movdqa      xmm1, XMMWORD [wk(10)]
+    movdqa      xmm2, XMMWORD [wk(12)]
+    packsswb    xmm0, XMMWORD [wk(9)]   ; xmm0 = (col0 col1)
+    packsswb    xmm1, XMMWORD [wk(11)]  ; xmm1 = (col2 col3)
+    packsswb    xmm2, XMMWORD [wk(13)]  ; xmm2 = (col4 col5)
+    movdqa      xmm3, XMMWORD [wk(14)]
+    packsswb    xmm3, xmm3              ; xmm3 = (col6 col6)
+
+    movdqa      xmm4, xmm0
+    psrldq      xmm4, 8
+    punpcklbw   xmm0, xmm4
+    movdqa      xmm4, xmm1
+    psrldq      xmm4, 8
+    punpcklbw   xmm1, xmm4
+    movdqa      xmm4, xmm2
+    psrldq      xmm4, 8
+    punpcklbw   xmm2, xmm4
+    movdqa      xmm4, xmm3
+    psrldq      xmm4, 8
+    punpcklbw   xmm3, xmm4
+
+    movdqa      xmm4, xmm0
+    punpcklwd   xmm0, xmm1              ; xmm0 = rows 0-3 (col0-col3)
+    punpckhwd   xmm4, xmm1              ; xmm4 = rows 4-7 (col0-col3)
+    movdqa      xmm5, xmm2
+    punpcklwd   xmm2, xmm3              ; xmm2 = rows 0-3 (col4-col7)
+    punpckhwd   xmm5, xmm3              ; xmm5 = rows 4-7 (col4-col7)
+    movdqa      xmm1, xmm0
+    punpckldq   xmm0, xmm2              ; xmm0 = (row0 row1)
+    punpckhdq   xmm1, xmm2              ; xmm1 = (row2 row3)
+    movdqa      xmm3, xmm4
+    punpckldq   xmm4, xmm5              ; xmm4 = (row4 row5)
+    punpckhdq   xmm3, xmm5              ; xmm3 = (row6 row7)
+
+    movdqa      xmm7, [rel PB_CENTERJSAMP]
+    paddb       xmm0, xmm7
+    paddb       xmm1, xmm7
+    paddb       xmm4, xmm7
+    paddb       xmm3, xmm7
+
+    mov         rdxp, JSAMPROW [rdi + 0 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm0
+    pextrw      ecx, xmm0, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE + 4], cx
+    pextrw      ecx, xmm0, 0x03
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 6], cl
+    pshufd      xmm6, xmm0, 0x4E
+    mov         rdxp, JSAMPROW [rdi + 1 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm6
+    pextrw      ecx, xmm6, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE + 4], cx
+    pextrw      ecx, xmm6, 0x03
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 6], cl
+    mov         rdxp, JSAMPROW [rdi + 2 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm1
+    pextrw      ecx, xmm1, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE + 4], cx
+    pextrw      ecx, xmm1, 0x03
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 6], cl
+    pshufd      xmm6, xmm1, 0x4E
+    mov         rdxp, JSAMPROW [rdi + 3 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm6
+    pextrw      ecx, xmm6, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE + 4], cx
+    pextrw      ecx, xmm6, 0x03
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 6], cl
+    mov         rdxp, JSAMPROW [rdi + 4 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm4
+    pextrw      ecx, xmm4, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE + 4], cx
+    pextrw      ecx, xmm4, 0x03
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 6], cl
+    pshufd      xmm6, xmm4, 0x4E
+    mov         rdxp, JSAMPROW [rdi + 5 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm6
+    pextrw      ecx, xmm6, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE + 4], cx
+    pextrw      ecx, xmm6, 0x03
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 6], cl
+    mov         rdxp, JSAMPROW [rdi + 6 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm3
+    pextrw      ecx, xmm3, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE + 4], cx
+    pextrw      ecx, xmm3, 0x03
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 6], cl
+
+    UNCOLLECT_ARGS 4
+    lea         rsp, [rbp - 8]
+    pop         r15
+    pop         rbp
+    ret
+
+; --------------------------------------------------------------------------
+;
+; Perform dequantization and inverse DCT on one block of coefficients,
+; producing a reduced-size 6x6 output block.
+;
+; GLOBAL(void)
+; jsimd_idct_6x6_sse2(void *dct_table, JCOEFPTR coef_block,
+;                     JSAMPARRAY output_buf, JDIMENSION output_col)
+;
+; r10 = void *dct_table
+; r11 = JCOEFPTR coef_block
+; r12 = JSAMPARRAY output_buf
+; r13d = JDIMENSION output_col
+
+%define wk(i)   r15 - (WK_NUM - (i)) * SIZEOF_XMMWORD  ; xmmword wk[WK_NUM]
+%define WK_NUM  14
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_idct_6x6_sse2)
+
+EXTN(jsimd_idct_6x6_sse2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    push        r15
+    and         rsp, byte (-SIZEOF_XMMWORD)  ; align to 128 bits
+    ; Allocate stack space for wk array.  r15 is used to access it.
+    mov         r15, rsp
+    sub         rsp, (SIZEOF_XMMWORD * WK_NUM)
+    COLLECT_ARGS 4
+
+    ; ---- Pass 1: process columns from input.
+
+    mov         rdx, r10                ; quantptr
+    mov         rsi, r11                ; inptr
+
+    ; -- Dequantize and interleave coefficients
+
+    pxor        xmm7, xmm7
+    movdqa      xmm0, XMMWORD [XMMBLOCK(0, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm0, XMMWORD [XMMBLOCK(0, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm1, XMMWORD [XMMBLOCK(2, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm1, XMMWORD [XMMBLOCK(2, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm2, xmm0
+    punpcklwd   xmm0, xmm1              ; xmm0 = (00 20 01 21 02 22 03 23)
+    punpckhwd   xmm2, xmm1              ; xmm2 = (04 24 05 25 06 26 07 27)
+    movdqa      XMMWORD [wk(0)], xmm0
+    movdqa      XMMWORD [wk(1)], xmm2
+    movdqa      xmm3, XMMWORD [XMMBLOCK(4, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm3, XMMWORD [XMMBLOCK(4, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm5, xmm3
+    punpcklwd   xmm3, xmm7              ; xmm3 = (40 -- 41 -- 42 -- 43 --)
+    punpckhwd   xmm5, xmm7              ; xmm5 = (44 -- 45 -- 46 -- 47 --)
+    movdqa      XMMWORD [wk(2)], xmm3
+    movdqa      XMMWORD [wk(3)], xmm5
+    movdqa      xmm0, XMMWORD [XMMBLOCK(1, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm0, XMMWORD [XMMBLOCK(1, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm1, XMMWORD [XMMBLOCK(3, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm1, XMMWORD [XMMBLOCK(3, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm2, xmm0
+    punpcklwd   xmm0, xmm1              ; xmm0 = (10 30 11 31 12 32 13 33)
+    punpckhwd   xmm2, xmm1              ; xmm2 = (14 34 15 35 16 36 17 37)
+    movdqa      XMMWORD [wk(4)], xmm0
+    movdqa      XMMWORD [wk(5)], xmm2
+    movdqa      xmm3, XMMWORD [XMMBLOCK(5, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm3, XMMWORD [XMMBLOCK(5, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm5, xmm3
+    punpcklwd   xmm3, xmm7              ; xmm3 = (50 -- 51 -- 52 -- 53 --)
+    punpckhwd   xmm5, xmm7              ; xmm5 = (54 -- 55 -- 56 -- 57 --)
+    movdqa      XMMWORD [wk(6)], xmm3
+    movdqa      XMMWORD [wk(7)], xmm5
+
+    ; -- Rows 0 and 5
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_6X6_0_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_6X6_0_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P1]  ; xmm0 = even0L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_6X6_0_13]
+    movdqa      xmm2, XMMWORD [wk(6)]
+    pmaddwd     xmm2, [rel PW_6X6_0_57]
+    paddd       xmm1, xmm2
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data0L
+    psubd       xmm2, xmm1              ; xmm2 = data5L
+    psrad       xmm0, DESCALE_P1
+    psrad       xmm2, DESCALE_P1
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_6X6_0_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_6X6_0_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P1]  ; xmm3 = even0H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_6X6_0_13]
+    movdqa      xmm5, XMMWORD [wk(7)]
+    pmaddwd     xmm5, [rel PW_6X6_0_57]
+    paddd       xmm4, xmm5
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data0H
+    psubd       xmm5, xmm4              ; xmm5 = data5H
+    psrad       xmm3, DESCALE_P1
+    psrad       xmm5, DESCALE_P1
+
+    packssdw    xmm0, xmm3              ; xmm0 = data0
+    packssdw    xmm2, xmm5              ; xmm2 = data5
+    pshuflw     xmm0, xmm0, 0xD8
+    pshufhw     xmm0, xmm0, 0xD8        ; xmm0 = (00 02 01 03 04 06 05 07)
+    pshuflw     xmm2, xmm2, 0xD8
+    pshufhw     xmm2, xmm2, 0xD8        ; xmm2 = (50 52 51 53 54 56 55 57)
+    movdqa      XMMWORD [wk(8)], xmm0
+    movdqa      XMMWORD [wk(13)], xmm2
+
+    ; -- Rows 1 and 4
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_6X6_1_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_6X6_1_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P1]  ; xmm0 = even1L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_6X6_1_13]
+    movdqa      xmm2, XMMWORD [wk(6)]
+    pmaddwd     xmm2, [rel PW_6X6_1_57]
+    paddd       xmm1, xmm2
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data1L
+    psubd       xmm2, xmm1              ; xmm2 = data4L
+    psrad       xmm0, DESCALE_P1
+    psrad       xmm2, DESCALE_P1
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_6X6_1_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_6X6_1_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P1]  ; xmm3 = even1H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_6X6_1_13]
+    movdqa      xmm5, XMMWORD [wk(7)]
+    pmaddwd     xmm5, [rel PW_6X6_1_57]
+    paddd       xmm4, xmm5
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data1H
+    psubd       xmm5, xmm4              ; xmm5 = data4H
+    psrad       xmm3, DESCALE_P1
+    psrad       xmm5, DESCALE_P1
+
+    packssdw    xmm0, xmm3              ; xmm0 = data1
+    packssdw    xmm2, xmm5              ; xmm2 = data4
+    pshuflw     xmm0, xmm0, 0xD8
+    pshufhw     xmm0, xmm0, 0xD8        ; xmm0 = (10 12 11 13 14 16 15 17)
+    pshuflw     xmm2, xmm2, 0xD8
+    pshufhw     xmm2, xmm2, 0xD8        ; xmm2 = (40 42 41 43 44 46 45 47)
+    movdqa      XMMWORD [wk(9)], xmm0
+    movdqa      XMMWORD [wk(12)], xmm2
+
+    ; -- Rows 2 and 3
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_6X6_2_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_6X6_2_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P1]  ; xmm0 = even2L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_6X6_2_13]
+    movdqa      xmm2, XMMWORD [wk(6)]
+    pmaddwd     xmm2, [rel PW_6X6_2_57]
+    paddd       xmm1, xmm2
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data2L
+    psubd       xmm2, xmm1              ; xmm2 = data3L
+    psrad       xmm0, DESCALE_P1
+    psrad       xmm2, DESCALE_P1
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_6X6_2_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_6X6_2_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P1]  ; xmm3 = even2H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_6X6_2_13]
+    movdqa      xmm5, XMMWORD [wk(7)]
+    pmaddwd     xmm5, [rel PW_6X6_2_57]
+    paddd       xmm4, xmm5
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data2H
+    psubd       xmm5, xmm4              ; xmm5 = data3H
+    psrad       xmm3, DESCALE_P1
+    psrad       xmm5, DESCALE_P1
+
+    packssdw    xmm0, xmm3              ; xmm0 = data2
+    packssdw    xmm2, xmm5              ; xmm2 = data3
+    pshuflw     xmm0, xmm0, 0xD8
+    pshufhw     xmm0, xmm0, 0xD8        ; xmm0 = (20 22 21 23 24 26 25 27)
+    pshuflw     xmm2, xmm2, 0xD8
+    pshufhw     xmm2, xmm2, 0xD8        ; xmm2 = (30 32 31 33 34 36 35 37)
+    movdqa      XMMWORD [wk(10)], xmm0
+    movdqa      XMMWORD [wk(11)], xmm2
+
+    ; -- Transpose coefficients
+
+    movdqa      xmm0, XMMWORD [wk(8)]
+    movdqa      xmm1, XMMWORD [wk(9)]
+    movdqa      xmm2, XMMWORD [wk(10)]
+    movdqa      xmm3, XMMWORD [wk(11)]
+    movdqa      xmm4, xmm0
+    punpckldq   xmm0, xmm1
+    punpckhdq   xmm4, xmm1
+    movdqa      xmm5, xmm2
+    punpckldq   xmm2, xmm3
+    punpckhdq   xmm5, xmm3
+    movdqa      xmm1, xmm0
+    punpcklqdq  xmm0, xmm2
+    punpckhqdq  xmm1, xmm2
+    movdqa      xmm3, xmm4
+    punpcklqdq  xmm4, xmm5
+    punpckhqdq  xmm3, xmm5
+    movdqa      XMMWORD [wk(0)], xmm0
+    movdqa      XMMWORD [wk(2)], xmm4
+    movdqa      XMMWORD [wk(4)], xmm1
+    movdqa      XMMWORD [wk(6)], xmm3
+
+    movdqa      xmm0, XMMWORD [wk(12)]
+    movdqa      xmm1, XMMWORD [wk(13)]
+    pxor        xmm2, xmm2
+    pxor        xmm3, xmm3
+    movdqa      xmm4, xmm0
+    punpckldq   xmm0, xmm1
+    punpckhdq   xmm4, xmm1
+    movdqa      xmm5, xmm2
+    punpckldq   xmm2, xmm3
+    punpckhdq   xmm5, xmm3
+    movdqa      xmm1, xmm0
+    punpcklqdq  xmm0, xmm2
+    punpckhqdq  xmm1, xmm2
+    movdqa      xmm3, xmm4
+    punpcklqdq  xmm4, xmm5
+    punpckhqdq  xmm3, xmm5
+    movdqa      XMMWORD [wk(1)], xmm0
+    movdqa      XMMWORD [wk(3)], xmm4
+    movdqa      XMMWORD [wk(5)], xmm1
+    movdqa      XMMWORD [wk(7)], xmm3
+
+    ; -- Prefetch the next coefficient block
+
+    prefetchnta [rsi + DCTSIZE2 * SIZEOF_JCOEF + 0 * 32]
+    prefetchnta [rsi + DCTSIZE2 * SIZEOF_JCOEF + 1 * 32]
+    prefetchnta [rsi + DCTSIZE2 * SIZEOF_JCOEF + 2 * 32]
+    prefetchnta [rsi + DCTSIZE2 * SIZEOF_JCOEF + 3 * 32]
+
+    ; ---- Pass 2: process rows, store into output array.
+
+    mov         rdi, r12                ; (JSAMPROW *)
+    mov         eax, r13d
+
+    ; -- Columns 0 and 5
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_6X6_0_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_6X6_0_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P2]  ; xmm0 = even0L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_6X6_0_13]
+    movdqa      xmm2, XMMWORD [wk(6)]
+    pmaddwd     xmm2, [rel PW_6X6_0_57]
+    paddd       xmm1, xmm2
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data0L
+    psubd       xmm2, xmm1              ; xmm2 = data5L
+    psrad       xmm0, DESCALE_P2
+    psrad       xmm2, DESCALE_P2
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_6X6_0_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_6X6_0_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P2]  ; xmm3 = even0H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_6X6_0_13]
+    movdqa      xmm5, XMMWORD [wk(7)]
+    pmaddwd     xmm5, [rel PW_6X6_0_57]
+    paddd       xmm4, xmm5
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data0H
+    psubd       xmm5, xmm4              ; xmm5 = data5H
+    psrad       xmm3, DESCALE_P2
+    psrad       xmm5, DESCALE_P2
+
+    packssdw    xmm0, xmm3              ; xmm0 = data0
+    packssdw    xmm2, xmm5              ; xmm2 = data5
+    movdqa      XMMWORD [wk(8)], xmm0
+    movdqa      XMMWORD [wk(13)], xmm2
+
+    ; -- Columns 1 and 4
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_6X6_1_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_6X6_1_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P2]  ; xmm0 = even1L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_6X6_1_13]
+    movdqa      xmm2, XMMWORD [wk(6)]
+    pmaddwd     xmm2, [rel PW_6X6_1_57]
+    paddd       xmm1, xmm2
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data1L
+    psubd       xmm2, xmm1              ; xmm2 = data4L
+    psrad       xmm0, DESCALE_P2
+    psrad       xmm2, DESCALE_P2
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_6X6_1_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_6X6_1_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P2]  ; xmm3 = even1H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_6X6_1_13]
+    movdqa      xmm5, XMMWORD [wk(7)]
+    pmaddwd     xmm5, [rel PW_6X6_1_57]
+    paddd       xmm4, xmm5
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data1H
+    psubd       xmm5, xmm4              ; xmm5 = data4H
+    psrad       xmm3, DESCALE_P2
+    psrad       xmm5, DESCALE_P2
+
+    packssdw    xmm0, xmm3              ; xmm0 = data1
+    packssdw    xmm2, xmm5              ; xmm2 = data4
+    movdqa      XMMWORD [wk(9)], xmm0
+    movdqa      XMMWORD [wk(12)], xmm2
+
+    ; -- Columns 2 and 3
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_6X6_2_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_6X6_2_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P2]  ; xmm0 = even2L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_6X6_2_13]
+    movdqa      xmm2, XMMWORD [wk(6)]
+    pmaddwd     xmm2, [rel PW_6X6_2_57]
+    paddd       xmm1, xmm2
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data2L
+    psubd       xmm2, xmm1              ; xmm2 = data3L
+    psrad       xmm0, DESCALE_P2
+    psrad       xmm2, DESCALE_P2
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_6X6_2_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_6X6_2_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P2]  ; xmm3 = even2H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_6X6_2_13]
+    movdqa      xmm5, XMMWORD [wk(7)]
+    pmaddwd     xmm5, [rel PW_6X6_2_57]
+    paddd       xmm4, xmm5
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data2H
+    psubd       xmm5, xmm4              ; xmm5 = data3H
+    psrad       xmm3, DESCALE_P2
+    psrad       xmm5, DESCALE_P2
+
+    packssdw    xmm0, xmm3              ; xmm0 = data2
+    packssdw    xmm2, xmm5              ; xmm2 = data3
+    movdqa      XMMWORD [wk(10)], xmm0
+    movdqa      XMMWORD [wk(11)], xmm2
+
+    movdqa      xmm0, XMMWORD [wk(8)]
+    movdqa      xmm1, XMMWORD [wk(10)]
+    movdqa      xmm2, XMMWORD [wk(12)]
+    packsswb    xmm0, XMMWORD [wk(9)]   ; xmm0 = (col0 col1)
+    packsswb    xmm1, XMMWORD [wk(11)]  ; xmm1 = (col2 col3)
+    packsswb    xmm2, XMMWORD [wk(13)]  ; xmm2 = (col4 col5)
+
+    movdqa      xmm4, xmm0
+    psrldq      xmm4, 8
+    punpcklbw   xmm0, xmm4
+    movdqa      xmm4, xmm1
+    psrldq      xmm4, 8
+    punpcklbw   xmm1, xmm4
+    movdqa      xmm4, xmm2
+    psrldq      xmm4, 8
+    punpcklbw   xmm2, xmm4
+    pxor        xmm3, xmm3
+
+    movdqa      xmm4, xmm0
+    punpcklwd   xmm0, xmm1              ; xmm0 = rows 0-3 (col0-col3)
+    punpckhwd   xmm4, xmm1              ; xmm4 = rows 4-7 (col0-col3)
+    movdqa      xmm5, xmm2
+    punpcklwd   xmm2, xmm3              ; xmm2 = rows 0-3 (col4-col7)
+    punpckhwd   xmm5, xmm3              ; xmm5 = rows 4-7 (col4-col7)
+    movdqa      xmm1, xmm0
+    punpckldq   xmm0, xmm2              ; xmm0 = (row0 row1)
+    punpckhdq   xmm1, xmm2              ; xmm1 = (row2 row3)
+    movdqa      xmm3, xmm4
+    punpckldq   xmm4, xmm5              ; xmm4 = (row4 row5)
+    punpckhdq   xmm3, xmm5              ; xmm3 = (row6 row7)
+
+    movdqa      xmm7, [rel PB_CENTERJSAMP]
+    paddb       xmm0, xmm7
+    paddb       xmm1, xmm7
+    paddb       xmm4, xmm7
+
+    mov         rdxp, JSAMPROW [rdi + 0 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm0
+    pextrw      ecx, xmm0, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE + 4], cx
+    pshufd      xmm6, xmm0, 0x4E
+    mov         rdxp, JSAMPROW [rdi + 1 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm6
+    pextrw      ecx, xmm6, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE + 4], cx
+    mov         rdxp, JSAMPROW [rdi + 2 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm1
+    pextrw      ecx, xmm1, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE + 4], cx
+    pshufd      xmm6, xmm1, 0x4E
+    mov         rdxp, JSAMPROW [rdi + 3 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm6
+    pextrw      ecx, xmm6, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE + 4], cx
+    mov         rdxp, JSAMPROW [rdi + 4 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm4
+    pextrw      ecx, xmm4, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE + 4], cx
+    pshufd      xmm6, xmm4, 0x4E
+    mov         rdxp, JSAMPROW [rdi + 5 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm6
+    pextrw      ecx, xmm6, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE + 4], cx
+
+    UNCOLLECT_ARGS 4
+    lea         rsp, [rbp - 8]
+    pop         r15
+    pop         rbp
+    ret
+
+; --------------------------------------------------------------------------
+;
+; Perform dequantization and inverse DCT on one block of coefficients,
+; producing a reduced-size 5x5 output block.
+;
+; GLOBAL(void)
+; jsimd_idct_5x5_sse2(void *dct_table, JCOEFPTR coef_block,
+;                     JSAMPARRAY output_buf, JDIMENSION output_col)
+;
+; r10 = void *dct_table
+; r11 = JCOEFPTR coef_block
+; r12 = JSAMPARRAY output_buf
+; r13d = JDIMENSION output_col
+
+%define wk(i)   r15 - (WK_NUM - (i)) * SIZEOF_XMMWORD  ; xmmword wk[WK_NUM]
+%define WK_NUM  11
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_idct_5x5_sse2)
+
+EXTN(jsimd_idct_5x5_sse2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    push        r15
+    and         rsp, byte (-SIZEOF_XMMWORD)  ; align to 128 bits
+    ; Allocate stack space for wk array.  r15 is used to access it.
+    mov         r15, rsp
+    sub         rsp, (SIZEOF_XMMWORD * WK_NUM)
+    COLLECT_ARGS 4
+
+    ; ---- Pass 1: process columns from input.
+
+    mov         rdx, r10                ; quantptr
+    mov         rsi, r11                ; inptr
+
+    ; -- Dequantize and interleave coefficients
+
+    pxor        xmm7, xmm7
+    movdqa      xmm0, XMMWORD [XMMBLOCK(0, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm0, XMMWORD [XMMBLOCK(0, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm1, XMMWORD [XMMBLOCK(2, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm1, XMMWORD [XMMBLOCK(2, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm2, xmm0
+    punpcklwd   xmm0, xmm1              ; xmm0 = (00 20 01 21 02 22 03 23)
+    punpckhwd   xmm2, xmm1              ; xmm2 = (04 24 05 25 06 26 07 27)
+    movdqa      XMMWORD [wk(0)], xmm0
+    movdqa      XMMWORD [wk(1)], xmm2
+    movdqa      xmm3, XMMWORD [XMMBLOCK(4, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm3, XMMWORD [XMMBLOCK(4, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm5, xmm3
+    punpcklwd   xmm3, xmm7              ; xmm3 = (40 -- 41 -- 42 -- 43 --)
+    punpckhwd   xmm5, xmm7              ; xmm5 = (44 -- 45 -- 46 -- 47 --)
+    movdqa      XMMWORD [wk(2)], xmm3
+    movdqa      XMMWORD [wk(3)], xmm5
+    movdqa      xmm0, XMMWORD [XMMBLOCK(1, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm0, XMMWORD [XMMBLOCK(1, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm1, XMMWORD [XMMBLOCK(3, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm1, XMMWORD [XMMBLOCK(3, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    movdqa      xmm2, xmm0
+    punpcklwd   xmm0, xmm1              ; xmm0 = (10 30 11 31 12 32 13 33)
+    punpckhwd   xmm2, xmm1              ; xmm2 = (14 34 15 35 16 36 17 37)
+    movdqa      XMMWORD [wk(4)], xmm0
+    movdqa      XMMWORD [wk(5)], xmm2
+
+    ; -- Rows 0 and 4
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_5X5_0_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_5X5_0_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P1]  ; xmm0 = even0L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_5X5_0_13]
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data0L
+    psubd       xmm2, xmm1              ; xmm2 = data4L
+    psrad       xmm0, DESCALE_P1
+    psrad       xmm2, DESCALE_P1
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_5X5_0_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_5X5_0_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P1]  ; xmm3 = even0H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_5X5_0_13]
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data0H
+    psubd       xmm5, xmm4              ; xmm5 = data4H
+    psrad       xmm3, DESCALE_P1
+    psrad       xmm5, DESCALE_P1
+
+    packssdw    xmm0, xmm3              ; xmm0 = data0
+    packssdw    xmm2, xmm5              ; xmm2 = data4
+    pshuflw     xmm0, xmm0, 0xD8
+    pshufhw     xmm0, xmm0, 0xD8        ; xmm0 = (00 02 01 03 04 06 05 07)
+    pshuflw     xmm2, xmm2, 0xD8
+    pshufhw     xmm2, xmm2, 0xD8        ; xmm2 = (40 42 41 43 44 46 45 47)
+    movdqa      XMMWORD [wk(6)], xmm0
+    movdqa      XMMWORD [wk(10)], xmm2
+
+    ; -- Rows 1 and 3
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_5X5_1_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_5X5_1_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P1]  ; xmm0 = even1L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_5X5_1_13]
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data1L
+    psubd       xmm2, xmm1              ; xmm2 = data3L
+    psrad       xmm0, DESCALE_P1
+    psrad       xmm2, DESCALE_P1
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_5X5_1_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_5X5_1_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P1]  ; xmm3 = even1H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_5X5_1_13]
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data1H
+    psubd       xmm5, xmm4              ; xmm5 = data3H
+    psrad       xmm3, DESCALE_P1
+    psrad       xmm5, DESCALE_P1
+
+    packssdw    xmm0, xmm3              ; xmm0 = data1
+    packssdw    xmm2, xmm5              ; xmm2 = data3
+    pshuflw     xmm0, xmm0, 0xD8
+    pshufhw     xmm0, xmm0, 0xD8        ; xmm0 = (10 12 11 13 14 16 15 17)
+    pshuflw     xmm2, xmm2, 0xD8
+    pshufhw     xmm2, xmm2, 0xD8        ; xmm2 = (30 32 31 33 34 36 35 37)
+    movdqa      XMMWORD [wk(7)], xmm0
+    movdqa      XMMWORD [wk(9)], xmm2
+
+    ; -- Row 2
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_5X5_2_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_5X5_2_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P1]  ; xmm0 = even2L
+    psrad       xmm0, DESCALE_P1        ; xmm0 = data2L
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_5X5_2_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_5X5_2_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P1]  ; xmm3 = even2H
+    psrad       xmm3, DESCALE_P1        ; xmm3 = data2H
+
+    packssdw    xmm0, xmm3              ; xmm0 = data2
+    pshuflw     xmm0, xmm0, 0xD8
+    pshufhw     xmm0, xmm0, 0xD8        ; xmm0 = (20 22 21 23 24 26 25 27)
+    movdqa      XMMWORD [wk(8)], xmm0
+
+    ; -- Transpose coefficients
+
+    movdqa      xmm0, XMMWORD [wk(6)]
+    movdqa      xmm1, XMMWORD [wk(7)]
+    movdqa      xmm2, XMMWORD [wk(8)]
+    movdqa      xmm3, XMMWORD [wk(9)]
+    movdqa      xmm4, xmm0
+    punpckldq   xmm0, xmm1
+    punpckhdq   xmm4, xmm1
+    movdqa      xmm5, xmm2
+    punpckldq   xmm2, xmm3
+    punpckhdq   xmm5, xmm3
+    movdqa      xmm1, xmm0
+    punpcklqdq  xmm0, xmm2
+    punpckhqdq  xmm1, xmm2
+    movdqa      xmm3, xmm4
+    punpcklqdq  xmm4, xmm5
+    punpckhqdq  xmm3, xmm5
+    movdqa      XMMWORD [wk(0)], xmm0
+    movdqa      XMMWORD [wk(2)], xmm4
+    movdqa      XMMWORD [wk(4)], xmm1
+
+    movdqa      xmm0, XMMWORD [wk(10)]
+    pxor        xmm1, xmm1
+    pxor        xmm2, xmm2
+    pxor        xmm3, xmm3
+    movdqa      xmm4, xmm0
+    punpckldq   xmm0, xmm1
+    punpckhdq   xmm4, xmm1
+    movdqa      xmm5, xmm2
+    punpckldq   xmm2, xmm3
+    punpckhdq   xmm5, xmm3
+    movdqa      xmm1, xmm0
+    punpcklqdq  xmm0, xmm2
+    punpckhqdq  xmm1, xmm2
+    movdqa      xmm3, xmm4
+    punpcklqdq  xmm4, xmm5
+    punpckhqdq  xmm3, xmm5
+    movdqa      XMMWORD [wk(1)], xmm0
+    movdqa      XMMWORD [wk(3)], xmm4
+    movdqa      XMMWORD [wk(5)], xmm1
+
+    ; -- Prefetch the next coefficient block
+
+    prefetchnta [rsi + DCTSIZE2 * SIZEOF_JCOEF + 0 * 32]
+    prefetchnta [rsi + DCTSIZE2 * SIZEOF_JCOEF + 1 * 32]
+    prefetchnta [rsi + DCTSIZE2 * SIZEOF_JCOEF + 2 * 32]
+    prefetchnta [rsi + DCTSIZE2 * SIZEOF_JCOEF + 3 * 32]
+
+    ; ---- Pass 2: process rows, store into output array.
+
+    mov         rdi, r12                ; (JSAMPROW *)
+    mov         eax, r13d
+
+    ; -- Columns 0 and 4
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_5X5_0_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_5X5_0_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P2]  ; xmm0 = even0L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_5X5_0_13]
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data0L
+    psubd       xmm2, xmm1              ; xmm2 = data4L
+    psrad       xmm0, DESCALE_P2
+    psrad       xmm2, DESCALE_P2
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_5X5_0_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_5X5_0_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P2]  ; xmm3 = even0H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_5X5_0_13]
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data0H
+    psubd       xmm5, xmm4              ; xmm5 = data4H
+    psrad       xmm3, DESCALE_P2
+    psrad       xmm5, DESCALE_P2
+
+    packssdw    xmm0, xmm3              ; xmm0 = data0
+    packssdw    xmm2, xmm5              ; xmm2 = data4
+    movdqa      XMMWORD [wk(6)], xmm0
+    movdqa      XMMWORD [wk(10)], xmm2
+
+    ; -- Columns 1 and 3
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_5X5_1_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_5X5_1_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P2]  ; xmm0 = even1L
+    movdqa      xmm1, XMMWORD [wk(4)]
+    pmaddwd     xmm1, [rel PW_5X5_1_13]
+    movdqa      xmm2, xmm0
+    paddd       xmm0, xmm1              ; xmm0 = data1L
+    psubd       xmm2, xmm1              ; xmm2 = data3L
+    psrad       xmm0, DESCALE_P2
+    psrad       xmm2, DESCALE_P2
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_5X5_1_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_5X5_1_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P2]  ; xmm3 = even1H
+    movdqa      xmm4, XMMWORD [wk(5)]
+    pmaddwd     xmm4, [rel PW_5X5_1_13]
+    movdqa      xmm5, xmm3
+    paddd       xmm3, xmm4              ; xmm3 = data1H
+    psubd       xmm5, xmm4              ; xmm5 = data3H
+    psrad       xmm3, DESCALE_P2
+    psrad       xmm5, DESCALE_P2
+
+    packssdw    xmm0, xmm3              ; xmm0 = data1
+    packssdw    xmm2, xmm5              ; xmm2 = data3
+    movdqa      XMMWORD [wk(7)], xmm0
+    movdqa      XMMWORD [wk(9)], xmm2
+
+    ; -- Column 2
+
+    movdqa      xmm0, XMMWORD [wk(0)]
+    pmaddwd     xmm0, [rel PW_5X5_2_02]
+    movdqa      xmm2, XMMWORD [wk(2)]
+    pmaddwd     xmm2, [rel PW_5X5_2_46]
+    paddd       xmm0, xmm2
+    paddd       xmm0, [rel PD_DESCALE_P2]  ; xmm0 = even2L
+    psrad       xmm0, DESCALE_P2        ; xmm0 = data2L
+    movdqa      xmm3, XMMWORD [wk(1)]
+    pmaddwd     xmm3, [rel PW_5X5_2_02]
+    movdqa      xmm5, XMMWORD [wk(3)]
+    pmaddwd     xmm5, [rel PW_5X5_2_46]
+    paddd       xmm3, xmm5
+    paddd       xmm3, [rel PD_DESCALE_P2]  ; xmm3 = even2H
+    psrad       xmm3, DESCALE_P2        ; xmm3 = data2H
+
+    packssdw    xmm0, xmm3              ; xmm0 = data2
+    movdqa      XMMWORD [wk(8)], xmm0
+
+    movdqa      xmm0, XMMWORD [wk(6)]
+    movdqa      xmm1, XMMWORD [wk(8)]
+    movdqa      xmm2, XMMWORD [wk(10)]
+    packsswb    xmm0, XMMWORD [wk(7)]   ; xmm0 = (col0 col1)
+    packsswb    xmm1, XMMWORD [wk(9)]   ; xmm1 = (col2 col3)
+    pxor        xmm7, xmm7
+    packsswb    xmm2, xmm7              ; xmm2 = (col4 ----)
+
+    movdqa      xmm4, xmm0
+    psrldq      xmm4, 8
+    punpcklbw   xmm0, xmm4
+    movdqa      xmm4, xmm1
+    psrldq      xmm4, 8
+    punpcklbw   xmm1, xmm4
+    movdqa      xmm4, xmm2
+    psrldq      xmm4, 8
+    punpcklbw   xmm2, xmm4
+    pxor        xmm3, xmm3
+
+    movdqa      xmm4, xmm0
+    punpcklwd   xmm0, xmm1              ; xmm0 = rows 0-3 (col0-col3)
+    punpckhwd   xmm4, xmm1              ; xmm4 = rows 4-7 (col0-col3)
+    movdqa      xmm5, xmm2
+    punpcklwd   xmm2, xmm3              ; xmm2 = rows 0-3 (col4-col7)
+    punpckhwd   xmm5, xmm3              ; xmm5 = rows 4-7 (col4-col7)
+    movdqa      xmm1, xmm0
+    punpckldq   xmm0, xmm2              ; xmm0 = (row0 row1)
+    punpckhdq   xmm1, xmm2              ; xmm1 = (row2 row3)
+    movdqa      xmm3, xmm4
+    punpckldq   xmm4, xmm5              ; xmm4 = (row4 row5)
+    punpckhdq   xmm3, xmm5              ; xmm3 = (row6 row7)
+
+    movdqa      xmm7, [rel PB_CENTERJSAMP]
+    paddb       xmm0, xmm7
+    paddb       xmm1, xmm7
+    paddb       xmm4, xmm7
+
+    mov         rdxp, JSAMPROW [rdi + 0 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm0
+    pextrw      ecx, xmm0, 0x02
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 4], cl
+    pshufd      xmm6, xmm0, 0x4E
+    mov         rdxp, JSAMPROW [rdi + 1 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm6
+    pextrw      ecx, xmm6, 0x02
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 4], cl
+    mov         rdxp, JSAMPROW [rdi + 2 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm1
+    pextrw      ecx, xmm1, 0x02
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 4], cl
+    pshufd      xmm6, xmm1, 0x4E
+    mov         rdxp, JSAMPROW [rdi + 3 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm6
+    pextrw      ecx, xmm6, 0x02
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 4], cl
+    mov         rdxp, JSAMPROW [rdi + 4 * SIZEOF_JSAMPROW]
+    movd        XMM_DWORD [rdx + rax * SIZEOF_JSAMPLE], xmm4
+    pextrw      ecx, xmm4, 0x02
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 4], cl
+
+    UNCOLLECT_ARGS 4
+    lea         rsp, [rbp - 8]
+    pop         r15
+    pop         rbp
+    ret
+
+; --------------------------------------------------------------------------
+;
+; Perform dequantization and inverse DCT on one block of coefficients,
+; producing a reduced-size 3x3 output block.
+;
+; GLOBAL(void)
+; jsimd_idct_3x3_sse2(void *dct_table, JCOEFPTR coef_block,
+;                     JSAMPARRAY output_buf, JDIMENSION output_col)
+;
+; r10 = void *dct_table
+; r11 = JCOEFPTR coef_block
+; r12 = JSAMPARRAY output_buf
+; r13d = JDIMENSION output_col
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_idct_3x3_sse2)
+
+EXTN(jsimd_idct_3x3_sse2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 4
+
+    ; ---- Pass 1: process columns from input.
+
+    mov         rdx, r10                ; quantptr
+    mov         rsi, r11                ; inptr
+
+    movdqa      xmm0, XMMWORD [XMMBLOCK(0, 0, rsi, SIZEOF_JCOEF)]
+    movdqa      xmm1, XMMWORD [XMMBLOCK(2, 0, rsi, SIZEOF_JCOEF)]
+    movdqa      xmm2, XMMWORD [XMMBLOCK(1, 0, rsi, SIZEOF_JCOEF)]
+    pmullw      xmm0, XMMWORD [XMMBLOCK(0, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    pmullw      xmm1, XMMWORD [XMMBLOCK(2, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    pmullw      xmm2, XMMWORD [XMMBLOCK(1, 0, rdx, SIZEOF_ISLOW_MULT_TYPE)]
+    pxor        xmm3, xmm3
+    punpcklwd   xmm0, xmm1              ; xmm0 = (00 20 01 21 02 22 03 23)
+    punpcklwd   xmm2, xmm3              ; xmm2 = (10 -- 11 -- 12 -- 13 --)
+
+    movdqa      xmm4, xmm0
+    pmaddwd     xmm0, [rel PW_3X3_0_02]  ; xmm0 = even0
+    pmaddwd     xmm4, [rel PW_3X3_1_02]  ; xmm4 = even1
+    pmaddwd     xmm2, [rel PW_3X3_0_13]  ; xmm2 = odd0
+    movdqa      xmm5, [rel PD_DESCALE_P1]
+    paddd       xmm0, xmm5
+    paddd       xmm4, xmm5
+
+    movdqa      xmm1, xmm0
+    paddd       xmm0, xmm2              ; xmm0 = data0 = (00 01 02 03)
+    psubd       xmm1, xmm2              ; xmm1 = data2 = (20 21 22 23)
+    psrad       xmm0, DESCALE_P1
+    psrad       xmm4, DESCALE_P1        ; xmm4 = data1 = (10 11 12 13)
+    psrad       xmm1, DESCALE_P1
+
+    packssdw    xmm0, xmm4              ; xmm0 = (00 01 02 03 10 11 12 13)
+    packssdw    xmm1, xmm1              ; xmm1 = (20 21 22 23 20 21 22 23)
+    pshuflw     xmm0, xmm0, 0xD8
+    pshufhw     xmm0, xmm0, 0xD8        ; xmm0 = (00 02 01 03 10 12 11 13)
+    pshuflw     xmm1, xmm1, 0xD8
+    pshufhw     xmm1, xmm1, 0xD8        ; xmm1 = (20 22 21 23 20 22 21 23)
+    pshufd      xmm0, xmm0, 0xD8        ; xmm0 = (00 02 10 12 01 03 11 13)
+    pshufd      xmm1, xmm1, 0xD8        ; xmm1 = (20 22 20 22 21 23 21 23)
+    movdqa      xmm2, xmm0
+    punpcklqdq  xmm0, xmm1              ; xmm0 = (00 02 10 12 20 22 20 22)
+    punpckhqdq  xmm2, xmm1              ; xmm2 = (01 03 11 13 21 23 21 23)
+
+    ; ---- Pass 2: process rows, store into output array.
+
+    mov         rdi, r12                ; (JSAMPROW *)
+    mov         eax, r13d
+
+    movdqa      xmm4, xmm0
+    pmaddwd     xmm0, [rel PW_3X3_0_02]  ; xmm0 = even0
+    pmaddwd     xmm4, [rel PW_3X3_1_02]  ; xmm4 = even1
+    pmaddwd     xmm2, [rel PW_3X3_0_13]  ; xmm2 = odd0
+    movdqa      xmm5, [rel PD_DESCALE_P2]
+    paddd       xmm0, xmm5
+    paddd       xmm4, xmm5
+
+    movdqa      xmm1, xmm0
+    paddd       xmm0, xmm2              ; xmm0 = data0 = (00 10 20 **)
+    psubd       xmm1, xmm2              ; xmm1 = data2 = (02 12 22 **)
+    psrad       xmm0, DESCALE_P2
+    psrad       xmm4, DESCALE_P2        ; xmm4 = data1 = (01 11 21 **)
+    psrad       xmm1, DESCALE_P2
+
+    packssdw    xmm0, xmm4              ; xmm0 = (00 10 20 ** 01 11 21 **)
+    packssdw    xmm1, xmm1              ; xmm1 = (02 12 22 ** 02 12 22 **)
+    packsswb    xmm0, xmm1              ; xmm0 = (00 10 20 ** 01 11 21 ** ..)
+    paddb       xmm0, [rel PB_CENTERJSAMP]
+
+    movdqa      xmm1, xmm0
+    movdqa      xmm2, xmm0
+    psrldq      xmm1, 4                 ; xmm1 = (01 11 21 ** 02 12 22 ** ..)
+    psrldq      xmm2, 8                 ; xmm2 = (02 12 22 ** 02 12 22 ** ..)
+    punpcklbw   xmm0, xmm1              ; xmm0 = (00 01 10 11 20 21 ** ** ..)
+    punpcklbw   xmm2, xmm2              ; xmm2 = (02 02 12 12 22 22 ** ** ..)
+    punpcklwd   xmm0, xmm2              ; xmm0 = (00 01 02 02 10 11 12 12 ..)
+
+    mov         rdxp, JSAMPROW [rdi + 0 * SIZEOF_JSAMPROW]
+    pextrw      ecx, xmm0, 0x00
+    mov         word [rdx + rax * SIZEOF_JSAMPLE], cx
+    pextrw      ecx, xmm0, 0x01
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 2], cl
+    mov         rdxp, JSAMPROW [rdi + 1 * SIZEOF_JSAMPROW]
+    pextrw      ecx, xmm0, 0x02
+    mov         word [rdx + rax * SIZEOF_JSAMPLE], cx
+    pextrw      ecx, xmm0, 0x03
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 2], cl
+    mov         rdxp, JSAMPROW [rdi + 2 * SIZEOF_JSAMPROW]
+    pextrw      ecx, xmm0, 0x04
+    mov         word [rdx + rax * SIZEOF_JSAMPLE], cx
+    pextrw      ecx, xmm0, 0x05
+    mov         byte [rdx + rax * SIZEOF_JSAMPLE + 2], cl
+
+    UNCOLLECT_ARGS 4
+    pop         rbp
+    ret
+
 ; For some reason, the OS X linker does not honor the request to align the
 ; segment unless we do this.
     align       32
@@ -0,0 +1,130 @@
+;
+; Floating Point Sample Conversion and Quantization (64-bit AVX2)
+;
+; Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
+; Copyright (C) 2009, 2016, 2024-2026, D. R. Commander.
+; Copyright (C) 2018, Matthias Räncker.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+
+%include "jsimdext.inc"
+%include "jdct.inc"
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Load one row of samples, apply unsigned->signed conversion, and store the
+; row into the workspace as floats
+;
+; %1 = row, %2 = ymm register (temporary)
+
+%macro CONVROW 2
+    mov         rsip, JSAMPROW [r10 + (%1) * SIZEOF_JSAMPROW]     ; (JSAMPLE *)
+    vpmovzxbd   %2, XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE]
+    vpaddd      %2, %2, ymm7
+    vcvtdq2ps   %2, %2
+    vmovups     YMMWORD [YMMBLOCK((%1), 0, r12, SIZEOF_FAST_FLOAT)], %2
+%endmacro
+
+; Load data into workspace, applying unsigned->signed conversion
+;
+; GLOBAL(void)
+; jsimd_convsamp_float_avx2(JSAMPARRAY sample_data, JDIMENSION start_col,
+;                           FAST_FLOAT *workspace)
+;
+; r10 = JSAMPARRAY sample_data
+; r11d = JDIMENSION start_col
+; r12 = FAST_FLOAT *workspace
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_convsamp_float_avx2)
+
+EXTN(jsimd_convsamp_float_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 3
+
+    vpcmpeqd    ymm7, ymm7, ymm7
+    vpslld      ymm7, ymm7, 7       ; ymm7 = { 0xFFFFFF80 0xFFFFFF80 .. }
+
+    mov         eax, r11d
+
+    CONVROW     0, ymm0
+    CONVROW     1, ymm1
+    CONVROW     2, ymm2
+    CONVROW     3, ymm3
+    CONVROW     4, ymm4
+    CONVROW     5, ymm5
+    CONVROW     6, ymm0
+    CONVROW     7, ymm1
+
+    vzeroupper
+    UNCOLLECT_ARGS 3
+    pop         rbp
+    ret
+
+; --------------------------------------------------------------------------
+;
+; Quantize/descale the coefficients, and store into coef_block
+;
+; GLOBAL(void)
+; jsimd_quantize_float_avx2(JCOEFPTR coef_block, FAST_FLOAT *divisors,
+;                           FAST_FLOAT *workspace)
+;
+; r10 = JCOEFPTR coef_block
+; r11 = FAST_FLOAT *divisors
+; r12 = FAST_FLOAT *workspace
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_quantize_float_avx2)
+
+EXTN(jsimd_quantize_float_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 3
+
+    mov         rax, DCTSIZE2 / 32
+.quantloop:
+    vmovups     ymm0, YMMWORD [YMMBLOCK(0, 0, r12, SIZEOF_FAST_FLOAT)]
+    vmovups     ymm1, YMMWORD [YMMBLOCK(1, 0, r12, SIZEOF_FAST_FLOAT)]
+    vmovups     ymm2, YMMWORD [YMMBLOCK(2, 0, r12, SIZEOF_FAST_FLOAT)]
+    vmovups     ymm3, YMMWORD [YMMBLOCK(3, 0, r12, SIZEOF_FAST_FLOAT)]
+    vmulps      ymm0, ymm0, YMMWORD [YMMBLOCK(0, 0, r11, SIZEOF_FAST_FLOAT)]
+    vmulps      ymm1, ymm1, YMMWORD [YMMBLOCK(1, 0, r11, SIZEOF_FAST_FLOAT)]
+    vmulps      ymm2, ymm2, YMMWORD [YMMBLOCK(2, 0, r11, SIZEOF_FAST_FLOAT)]
+    vmulps      ymm3, ymm3, YMMWORD [YMMBLOCK(3, 0, r11, SIZEOF_FAST_FLOAT)]
+
+    vcvtps2dq   ymm0, ymm0
+    vcvtps2dq   ymm1, ymm1
+    vcvtps2dq   ymm2, ymm2
+    vcvtps2dq   ymm3, ymm3
+
+    vpackssdw   ymm0, ymm0, ymm1    ; ymm0 = (00 .. 03 10 .. 13 04 .. 07 14 .. 17)
+    vpackssdw   ymm2, ymm2, ymm3    ; ymm2 = (20 .. 23 30 .. 33 24 .. 27 34 .. 37)
+    vpermq      ymm0, ymm0, 0xD8    ; ymm0 = (00 .. 07 10 .. 17)
+    vpermq      ymm2, ymm2, 0xD8    ; ymm2 = (20 .. 27 30 .. 37)
+
+    vmovdqu     YMMWORD [YMMBLOCK(0, 0, r10, SIZEOF_JCOEF)], ymm0
+    vmovdqu     YMMWORD [YMMBLOCK(2, 0, r10, SIZEOF_JCOEF)], ymm2
+
+    add         r12, 32 * SIZEOF_FAST_FLOAT
+    add         r11, 32 * SIZEOF_FAST_FLOAT
+    add         r10, byte 32 * SIZEOF_JCOEF
+    dec         rax
+    jnz         short .quantloop
+
+    vzeroupper
+    UNCOLLECT_ARGS 3
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
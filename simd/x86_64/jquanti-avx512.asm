@@ -0,0 +1,152 @@
+;
+; Integer Sample Conversion and Quantization (64-bit AVX-512)
+;
+; Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
+; Copyright (C) 2009, 2016, 2018, 2024-2026, D. R. Commander.
+; Copyright (C) 2016, Matthieu Darbois.
+; Copyright (C) 2018, Matthias Räncker.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler).  Yasm does not
+; support AVX-512 instructions.
+
+%include "jsimdext.inc"
+%include "jdct.inc"
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Load data into workspace, applying unsigned->signed conversion
+;
+; GLOBAL(void)
+; jsimd_convsamp_avx512(JSAMPARRAY sample_data, JDIMENSION start_col,
+;                       DCTELEM *workspace)
+;
+; r10 = JSAMPARRAY sample_data
+; r11d = JDIMENSION start_col
+; r12 = DCTELEM *workspace
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_convsamp_avx512)
+
+EXTN(jsimd_convsamp_avx512):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 3
+
+    mov         eax, r11d
+
+    mov         rsip, JSAMPROW [r10 + 0 * SIZEOF_JSAMPROW]        ; (JSAMPLE *)
+    mov         rdip, JSAMPROW [r10 + 1 * SIZEOF_JSAMPROW]        ; (JSAMPLE *)
+    movq        xmm0, XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE]
+    pinsrq      xmm0, XMM_MMWORD [rdi + rax * SIZEOF_JSAMPLE], 1
+
+    mov         rsip, JSAMPROW [r10 + 2 * SIZEOF_JSAMPROW]        ; (JSAMPLE *)
+    mov         rdip, JSAMPROW [r10 + 3 * SIZEOF_JSAMPROW]        ; (JSAMPLE *)
+    movq        xmm1, XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE]
+    pinsrq      xmm1, XMM_MMWORD [rdi + rax * SIZEOF_JSAMPLE], 1
+
+    mov         rsip, JSAMPROW [r10 + 4 * SIZEOF_JSAMPROW]        ; (JSAMPLE *)
+    mov         rdip, JSAMPROW [r10 + 5 * SIZEOF_JSAMPROW]        ; (JSAMPLE *)
+    movq        xmm2, XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE]
+    pinsrq      xmm2, XMM_MMWORD [rdi + rax * SIZEOF_JSAMPLE], 1
+
+    mov         rsip, JSAMPROW [r10 + 6 * SIZEOF_JSAMPROW]        ; (JSAMPLE *)
+    mov         rdip, JSAMPROW [r10 + 7 * SIZEOF_JSAMPROW]        ; (JSAMPLE *)
+    movq        xmm3, XMM_MMWORD [rsi + rax * SIZEOF_JSAMPLE]
+    pinsrq      xmm3, XMM_MMWORD [rdi + rax * SIZEOF_JSAMPLE], 1
+
+    vinserti128 ymm0, ymm0, xmm1, 1
+    vinserti128 ymm2, ymm2, xmm3, 1
+
+    vpmovzxbw   zmm0, ymm0
+                ; zmm0 = (00 01 02 03 04 05 06 07 ... 30 31 32 33 34 35 36 37)
+    vpmovzxbw   zmm1, ymm2
+                ; zmm1 = (40 41 42 43 44 45 46 47 ... 70 71 72 73 74 75 76 77)
+
+    vpternlogd  zmm7, zmm7, zmm7, 0xFF
+    vpsllw      zmm7, zmm7, 7       ; zmm7 = { 0xFF80 0xFF80 0xFF80 0xFF80 .. }
+
+    vpaddw      zmm0, zmm0, zmm7
+    vpaddw      zmm1, zmm1, zmm7
+
+    vmovdqu64   ZMMWORD [ZMMBLOCK(0, 0, r12, SIZEOF_DCTELEM)], zmm0
+    vmovdqu64   ZMMWORD [ZMMBLOCK(4, 0, r12, SIZEOF_DCTELEM)], zmm1
+
+    vzeroupper
+    UNCOLLECT_ARGS 3
+    pop         rbp
+    ret
+
+; --------------------------------------------------------------------------
+;
+; Quantize/descale the coefficients, and store into coef_block
+;
+; This implementation is based on an algorithm described in
+;   "Optimizing subroutines in assembly language:
+;   An optimization guide for x86 platforms" (https://agner.org/optimize).
+;
+; AVX-512 has no equivalent of vpsignw, so the sign of each coefficient is
+; restored by negating the quotient under a mask derived from the sign bits of
+; the input.  (The quotient of a zero coefficient is always zero, so this
+; produces the same results as the AVX2 implementation.)
+;
+; GLOBAL(void)
+; jsimd_quantize_avx512(JCOEFPTR coef_block, DCTELEM *divisors,
+;                       DCTELEM *workspace)
+
+%define RECIPROCAL(m, n, b) \
+  ZMMBLOCK(DCTSIZE * 0 + (m), (n), (b), SIZEOF_DCTELEM)
+%define CORRECTION(m, n, b) \
+  ZMMBLOCK(DCTSIZE * 1 + (m), (n), (b), SIZEOF_DCTELEM)
+%define SCALE(m, n, b) \
+  ZMMBLOCK(DCTSIZE * 2 + (m), (n), (b), SIZEOF_DCTELEM)
+
+; r10 = JCOEFPTR coef_block
+; r11 = DCTELEM *divisors
+; r12 = DCTELEM *workspace
+
+    align       32
+    GLOBAL_FUNCTION(jsimd_quantize_avx512)
+
+EXTN(jsimd_quantize_avx512):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 3
+
+    vmovdqu64   zmm4, [ZMMBLOCK(0, 0, r12, SIZEOF_DCTELEM)]
+    vmovdqu64   zmm5, [ZMMBLOCK(4, 0, r12, SIZEOF_DCTELEM)]
+    vpabsw      zmm0, zmm4
+    vpabsw      zmm1, zmm5
+    vpmovw2m    k1, zmm4                ; k1 = (coefficient < 0)
+    vpmovw2m    k2, zmm5
+
+    vpaddw      zmm0, zmm0, ZMMWORD [CORRECTION(0, 0, r11)]
+                ; correction + roundfactor
+    vpaddw      zmm1, zmm1, ZMMWORD [CORRECTION(4, 0, r11)]
+    vpmulhuw    zmm0, zmm0, ZMMWORD [RECIPROCAL(0, 0, r11)]  ; reciprocal
+    vpmulhuw    zmm1, zmm1, ZMMWORD [RECIPROCAL(4, 0, r11)]
+    vpmulhuw    zmm0, zmm0, ZMMWORD [SCALE(0, 0, r11)]       ; scale
+    vpmulhuw    zmm1, zmm1, ZMMWORD [SCALE(4, 0, r11)]
+
+    vpxord      zmm2, zmm2, zmm2
+    vpsubw      zmm0{k1}, zmm2, zmm0
+    vpsubw      zmm1{k2}, zmm2, zmm1
+
+    vmovdqu64   [ZMMBLOCK(0, 0, r10, SIZEOF_DCTELEM)], zmm0
+    vmovdqu64   [ZMMBLOCK(4, 0, r10, SIZEOF_DCTELEM)], zmm1
+
+    vzeroupper
+    UNCOLLECT_ARGS 3
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
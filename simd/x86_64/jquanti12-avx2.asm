@@ -0,0 +1,163 @@
+;
+; Integer Sample Conversion and Quantization (64-bit AVX2, 12-bit samples)
+;
+; Copyright (C) 2026, D. R. Commander.
+;
+; Based on the x86 SIMD extension for IJG JPEG library
+; Copyright (C) 1999-2006, MIYASAKA Masaru.
+; For conditions of distribution and use, see copyright notice in jsimdext.inc
+;
+; This file should be assembled with NASM (Netwide Assembler) or Yasm.
+;
+; With 12-bit samples, the DCT coefficients and quantization divisors do not
+; fit in 16 bits, so the routines in this file operate on 32-bit DCTELEMs.
+
+%include "jsimdext.inc"
+%include "jdct.inc"
+
+; --------------------------------------------------------------------------
+    SECTION     SEG_TEXT
+    BITS        64
+
+; Load data into workspace, applying unsigned->signed conversion
+;
+; GLOBAL(void)
+; jsimd12_convsamp_avx2(J12SAMPARRAY sample_data, JDIMENSION start_col,
+;                       int *workspace)
+;
+; r10 = J12SAMPARRAY sample_data
+; r11d = JDIMENSION start_col
+; r12 = int *workspace
+
+    align       32
+    GLOBAL_FUNCTION(jsimd12_convsamp_avx2)
+
+EXTN(jsimd12_convsamp_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 3
+
+    mov         eax, r11d
+
+    vpcmpeqd    ymm7, ymm7, ymm7
+    vpsrld      ymm7, ymm7, 31
+    vpslld      ymm7, ymm7, 11      ; ymm7 = { 2048 2048 2048 2048 .. }
+
+    mov         rsip, J12SAMPROW [r10 + 0 * SIZEOF_J12SAMPROW]
+    mov         rdip, J12SAMPROW [r10 + 1 * SIZEOF_J12SAMPROW]
+    vpmovsxwd   ymm0, XMMWORD [rsi + rax * SIZEOF_J12SAMPLE]
+    vpmovsxwd   ymm1, XMMWORD [rdi + rax * SIZEOF_J12SAMPLE]
+    mov         rsip, J12SAMPROW [r10 + 2 * SIZEOF_J12SAMPROW]
+    mov         rdip, J12SAMPROW [r10 + 3 * SIZEOF_J12SAMPROW]
+    vpmovsxwd   ymm2, XMMWORD [rsi + rax * SIZEOF_J12SAMPLE]
+    vpmovsxwd   ymm3, XMMWORD [rdi + rax * SIZEOF_J12SAMPLE]
+
+    vpsubd      ymm0, ymm0, ymm7
+    vpsubd      ymm1, ymm1, ymm7
+    vpsubd      ymm2, ymm2, ymm7
+    vpsubd      ymm3, ymm3, ymm7
+
+    vmovdqu     YMMWORD [YMMBLOCK(0, 0, r12, SIZEOF_J12DCTELEM)], ymm0
+    vmovdqu     YMMWORD [YMMBLOCK(1, 0, r12, SIZEOF_J12DCTELEM)], ymm1
+    vmovdqu     YMMWORD [YMMBLOCK(2, 0, r12, SIZEOF_J12DCTELEM)], ymm2
+    vmovdqu     YMMWORD [YMMBLOCK(3, 0, r12, SIZEOF_J12DCTELEM)], ymm3
+
+    mov         rsip, J12SAMPROW [r10 + 4 * SIZEOF_J12SAMPROW]
+    mov         rdip, J12SAMPROW [r10 + 5 * SIZEOF_J12SAMPROW]
+    vpmovsxwd   ymm0, XMMWORD [rsi + rax * SIZEOF_J12SAMPLE]
+    vpmovsxwd   ymm1, XMMWORD [rdi + rax * SIZEOF_J12SAMPLE]
+    mov         rsip, J12SAMPROW [r10 + 6 * SIZEOF_J12SAMPROW]
+    mov         rdip, J12SAMPROW [r10 + 7 * SIZEOF_J12SAMPROW]
+    vpmovsxwd   ymm2, XMMWORD [rsi + rax * SIZEOF_J12SAMPLE]
+    vpmovsxwd   ymm3, XMMWORD [rdi + rax * SIZEOF_J12SAMPLE]
+
+    vpsubd      ymm0, ymm0, ymm7
+    vpsubd      ymm1, ymm1, ymm7
+    vpsubd      ymm2, ymm2, ymm7
+    vpsubd      ymm3, ymm3, ymm7
+
+    vmovdqu     YMMWORD [YMMBLOCK(4, 0, r12, SIZEOF_J12DCTELEM)], ymm0
+    vmovdqu     YMMWORD [YMMBLOCK(5, 0, r12, SIZEOF_J12DCTELEM)], ymm1
+    vmovdqu     YMMWORD [YMMBLOCK(6, 0, r12, SIZEOF_J12DCTELEM)], ymm2
+    vmovdqu     YMMWORD [YMMBLOCK(7, 0, r12, SIZEOF_J12DCTELEM)], ymm3
+
+    vzeroupper
+    UNCOLLECT_ARGS 3
+    pop         rbp
+    ret
+
+; --------------------------------------------------------------------------
+;
+; Quantize/descale the coefficients, and store into coef_block
+;
+; The 12-bit divisors are the raw quantization values multiplied by 8, so
+; the dividends and divisors are both less than 2^21.  That guarantees that
+; a single-precision floating point division, truncated toward zero, produces
+; exactly the same quotient as the integer division in the C implementation.
+;
+; GLOBAL(void)
+; jsimd12_quantize_avx2(JCOEFPTR coef_block, int *divisors, int *workspace)
+
+%macro DOQUANT 1
+    vmovdqu     ymm0, YMMWORD [YMMBLOCK(%1 + 0, 0, r12, SIZEOF_J12DCTELEM)]
+    vmovdqu     ymm1, YMMWORD [YMMBLOCK(%1 + 1, 0, r12, SIZEOF_J12DCTELEM)]
+    vmovdqu     ymm4, YMMWORD [YMMBLOCK(%1 + 0, 0, r11, SIZEOF_J12DCTELEM)]
+    vmovdqu     ymm5, YMMWORD [YMMBLOCK(%1 + 1, 0, r11, SIZEOF_J12DCTELEM)]
+    vpabsd      ymm2, ymm0
+    vpabsd      ymm3, ymm1
+
+    vpsrld      ymm6, ymm4, 1
+    vpsrld      ymm7, ymm5, 1
+    vpaddd      ymm2, ymm2, ymm6        ; temp += qval >> 1
+    vpaddd      ymm3, ymm3, ymm7
+
+    vcvtdq2ps   ymm2, ymm2
+    vcvtdq2ps   ymm3, ymm3
+    vcvtdq2ps   ymm4, ymm4
+    vcvtdq2ps   ymm5, ymm5
+    vdivps      ymm2, ymm2, ymm4
+    vdivps      ymm3, ymm3, ymm5
+    vcvttps2dq  ymm2, ymm2              ; temp /= qval
+    vcvttps2dq  ymm3, ymm3
+
+    vpsignd     ymm2, ymm2, ymm0
+    vpsignd     ymm3, ymm3, ymm1
+
+    ; Truncate to 16 bits, as the C implementation does.
+    vpslld      ymm2, ymm2, 16
+    vpslld      ymm3, ymm3, 16
+    vpsrad      ymm2, ymm2, 16
+    vpsrad      ymm3, ymm3, 16
+    vpackssdw   ymm2, ymm2, ymm3
+    vpermq      ymm2, ymm2, 0xD8
+
+    vmovdqu     YMMWORD [YMMBLOCK(%1, 0, r10, SIZEOF_JCOEF)], ymm2
+%endmacro
+
+; r10 = JCOEFPTR coef_block
+; r11 = int *divisors
+; r12 = int *workspace
+
+    align       32
+    GLOBAL_FUNCTION(jsimd12_quantize_avx2)
+
+EXTN(jsimd12_quantize_avx2):
+    ENDBR64
+    push        rbp
+    mov         rbp, rsp
+    COLLECT_ARGS 3
+
+    DOQUANT     0
+    DOQUANT     2
+    DOQUANT     4
+    DOQUANT     6
+
+    vzeroupper
+    UNCOLLECT_ARGS 3
+    pop         rbp
+    ret
+
+; For some reason, the OS X linker does not honor the request to align the
+; segment unless we do this.
+    align       32
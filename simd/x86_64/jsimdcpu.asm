@@ -2,7 +2,7 @@
 ; SIMD instruction support check
 ;
 ; Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
-; Copyright (C) 2016, D. R. Commander.
+; Copyright (C) 2016, 2026, D. R. Commander.
 ; Copyright (C) 2023, Aliaksiej Kandracienka.
 ;
 ; Based on
@@ -39,7 +39,7 @@ EXTN(jpeg_simd_cpu_support):
     or          rdi, JSIMD_SSE
 
     ; Check whether CPUID leaf 07H is supported
-    ; (leaf 07H is used to check for AVX2 instruction support)
+    ; (leaf 07H is used to check for AVX2 and AVX-512 instruction support)
     mov         rax, 0
     cpuid
     cmp         rax, 7
@@ -49,9 +49,9 @@ EXTN(jpeg_simd_cpu_support):
     mov         rax, 7
     xor         rcx, rcx
     cpuid
-    mov         rax, rbx                ; rax = Extended feature flags
+    mov         r8, rbx                 ; r8 = Extended feature flags
 
-    test        rax, 1 << 5             ; bit5:AVX2
+    test        r8, 1 << 5              ; bit5:AVX2
     jz          short .return
 
     ; Check for AVX2 O/S support
@@ -65,6 +65,7 @@ EXTN(jpeg_simd_cpu_support):
 
     xor         rcx, rcx
     xgetbv
+    mov         r9, rax                 ; r9 = XFEATURE_ENABLED_MASK
     and         rax, 6
     cmp         rax, 6                  ; O/S does not manage XMM/YMM state
                                         ; using XSAVE
@@ -72,6 +73,20 @@ EXTN(jpeg_simd_cpu_support):
 
     or          rdi, JSIMD_AVX2
 
+    ; Check for AVX-512 instruction support
+    mov         eax, r8d
+    and         eax, 0xC0010000         ; bit16:AVX512F, bit30:AVX512BW,
+    cmp         eax, 0xC0010000         ; bit31:AVX512VL
+    jnz         short .return
+
+    ; Check for AVX-512 O/S support
+    and         r9, 0xE6
+    cmp         r9, 0xE6                ; O/S does not manage opmask/ZMM state
+                                        ; using XSAVE
+    jnz         short .return
+
+    or          rdi, JSIMD_AVX512
+
 .return:
     mov         rax, rdi
 
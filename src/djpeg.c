@@ -91,6 +91,7 @@ static JDIMENSION max_scans;    /* for -maxscans switch */
 static char *outfilename;       /* for -outfile switch */
 static boolean nooverwrite;     /* for -nooverwrite switch */
 static boolean memsrc;          /* for -memsrc switch */
+static boolean mmapsrc;         /* for -mmapsrc switch */
 static boolean report;          /* for -report switch */
 static boolean skip, crop;
 static JDIMENSION skip_start, skip_end;
@@ -178,6 +179,7 @@ usage(void)
   fprintf(stderr, "  -outfile name  Specify name for output file\n");
   fprintf(stderr, "  -nooverwrite   Don't overwrite output file if it exists\n");
   fprintf(stderr, "  -memsrc        Load input file into memory before decompressing\n");
+  fprintf(stderr, "  -mmapsrc       Memory-map input file (if possible) before decompressing\n");
   fprintf(stderr, "  -report        Report decompression progress\n");
   fprintf(stderr, "  -skip Y0,Y1    Decompress all rows except those between Y0 and Y1 (inclusive)\n");
   fprintf(stderr, "  -crop WxH+X+Y  Decompress only a rectangular subregion of the image\n");
@@ -212,6 +214,7 @@ parse_switches(j_decompress_ptr cinfo, int argc, char **argv,
   outfilename = NULL;
   nooverwrite = FALSE;
   memsrc = FALSE;
+  mmapsrc = FALSE;
   report = FALSE;
   skip = FALSE;
   crop = FALSE;
@@ -403,6 +406,10 @@ parse_switches(j_decompress_ptr cinfo, int argc, char **argv,
       /* Use in-memory source manager */
       memsrc = TRUE;
 
+    } else if (keymatch(arg, "mmapsrc", 2)) {
+      /* Use memory-mapped file source manager */
+      mmapsrc = TRUE;
+
     } else if (keymatch(arg, "pnm", 1) || keymatch(arg, "ppm", 1)) {
       /* PPM/PGM output format. */
       requested_fmt = FMT_PPM;
@@ -695,7 +702,9 @@ main(int argc, char **argv)
     } while (nbytes == INPUT_BUF_SIZE);
     fprintf(stderr, "Compressed size:  %lu bytes\n", insize);
     jpeg_mem_src(&cinfo, inbuffer, insize);
-  } else
+  } else if (mmapsrc)
+    jpeg_mmap_src(&cinfo, input_file);
+  else
     jpeg_stdio_src(&cinfo, input_file);
 
   /* Read file header, set default decompression parameters */
@@ -5,7 +5,7 @@
  * Copyright (C) 1994-1998, Thomas G. Lane.
  * Modified 2003-2010 by Guido Vollbeding.
  * libjpeg-turbo Modifications:
- * Copyright (C) 2022, 2024-2025, D. R. Commander.
+ * Copyright (C) 2022, 2024-2026, D. R. Commander.
  * For conditions of distribution and use, see the accompanying README.ijg
  * file.
  *
@@ -106,6 +106,7 @@ jpeg_CreateCompress(j_compress_ptr cinfo, int version, size_t structsize)
       (*cinfo->mem->alloc_small) ((j_common_ptr)cinfo, JPOOL_PERMANENT,
                                   sizeof(my_comp_master));
   memset(cinfo->master, 0, sizeof(my_comp_master));
+  cinfo->master->num_threads = 1;
 #ifdef WITH_SIMD
   cinfo->master->simd_support = JSIMD_UNDEFINED;
   cinfo->master->simd_huffman = 1;
@@ -4,7 +4,7 @@
  * This file was part of the Independent JPEG Group's software:
  * Copyright (C) 1994-1996, Thomas G. Lane.
  * libjpeg-turbo Modifications:
- * Copyright (C) 2022, 2024, D. R. Commander.
+ * Copyright (C) 2022, 2024, 2026, D. R. Commander.
  * For conditions of distribution and use, see the accompanying README.ijg
  * file.
  *
@@ -63,6 +63,22 @@ jpeg_start_compress(j_compress_ptr cinfo, boolean write_all_tables)
   cinfo->global_state = (cinfo->raw_data_in ? CSTATE_RAW_OK : CSTATE_SCANNING);
 }
 
+
+/*
+ * Set the maximum number of threads that the compressor may use.  This may be
+ * called at any time prior to jpeg_start_compress(), and the setting persists
+ * across images compressed using the same object.
+ */
+
+GLOBAL(void)
+jpeg_set_num_threads(j_compress_ptr cinfo, int num_threads)
+{
+  if (cinfo->global_state != CSTATE_START)
+    ERREXIT1(cinfo, JERR_BAD_STATE, cinfo->global_state);
+
+  cinfo->master->num_threads = num_threads;
+}
+
 #endif
 
 
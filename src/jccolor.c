@@ -5,7 +5,7 @@
  * Copyright (C) 1991-1996, Thomas G. Lane.
  * libjpeg-turbo Modifications:
  * Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
- * Copyright (C) 2009-2012, 2015, 2022, 2024-2025, D. R. Commander.
+ * Copyright (C) 2009-2012, 2015, 2022, 2024-2026, D. R. Commander.
  * For conditions of distribution and use, see the accompanying README.ijg
  * file.
  *
@@ -496,9 +496,9 @@ _jinit_color_converter(j_compress_ptr cinfo)
     if (cinfo->in_color_space == JCS_GRAYSCALE)
       cconvert->pub._color_convert = grayscale_convert;
     else if (IsExtRGB(cinfo->in_color_space)) {
-#ifdef WITH_SIMD
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
       if (jsimd_set_rgb_gray(cinfo))
-        cconvert->pub._color_convert = jsimd_color_convert;
+        cconvert->pub._color_convert = _jsimd_color_convert;
       else
 #endif
       {
@@ -588,9 +588,9 @@ _jinit_color_converter(j_compress_ptr cinfo)
     if (cinfo->num_components != 3)
       ERREXIT(cinfo, JERR_BAD_J_COLORSPACE);
     if (IsExtRGB(cinfo->in_color_space)) {
-#ifdef WITH_SIMD
-      if (jsimd_set_rgb_ycc(cinfo))
-        cconvert->pub._color_convert = jsimd_color_convert;
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE != 16
+      if (_jsimd_set_rgb_ycc(cinfo))
+        cconvert->pub._color_convert = _jsimd_color_convert;
       else
 #endif
       {
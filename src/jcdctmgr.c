@@ -688,7 +688,7 @@ _jinit_forward_dct(j_compress_ptr cinfo)
   case JDCT_ISLOW:
     fdct->pub._forward_DCT = forward_DCT;
 #ifdef WITH_SIMD
-    if (!jsimd_set_fdct_islow(cinfo, &fdct->dct))
+    if (!_jsimd_set_fdct_islow(cinfo, &fdct->dct))
 #endif
       fdct->dct = _jpeg_fdct_islow;
     break;
@@ -696,7 +696,7 @@ _jinit_forward_dct(j_compress_ptr cinfo)
 #ifdef DCT_IFAST_SUPPORTED
   case JDCT_IFAST:
     fdct->pub._forward_DCT = forward_DCT;
-#ifdef WITH_SIMD
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
     if (!jsimd_set_fdct_ifast(cinfo, &fdct->dct))
 #endif
       fdct->dct = _jpeg_fdct_ifast;
@@ -705,7 +705,7 @@ _jinit_forward_dct(j_compress_ptr cinfo)
 #ifdef DCT_FLOAT_SUPPORTED
   case JDCT_FLOAT:
     fdct->pub._forward_DCT = forward_DCT_float;
-#ifdef WITH_SIMD
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
     if (!jsimd_set_fdct_float(cinfo, &fdct->float_dct))
 #endif
       fdct->float_dct = jpeg_fdct_float;
@@ -726,22 +726,22 @@ _jinit_forward_dct(j_compress_ptr cinfo)
 #endif
 #if defined(DCT_ISLOW_SUPPORTED) || defined(DCT_IFAST_SUPPORTED)
 #ifdef WITH_SIMD
-    if (!jsimd_set_convsamp(cinfo, &fdct->convsamp))
+    if (!_jsimd_set_convsamp(cinfo, &fdct->convsamp))
 #endif
       fdct->convsamp = convsamp;
 #ifdef WITH_SIMD
-    if (!jsimd_set_quantize(cinfo, &fdct->quantize))
+    if (!_jsimd_set_quantize(cinfo, &fdct->quantize))
 #endif
       fdct->quantize = quantize;
     break;
 #endif
 #ifdef DCT_FLOAT_SUPPORTED
   case JDCT_FLOAT:
-#ifdef WITH_SIMD
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
     if (!jsimd_set_convsamp_float(cinfo, &fdct->float_convsamp))
 #endif
       fdct->float_convsamp = convsamp_float;
-#ifdef WITH_SIMD
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
     if (!jsimd_set_quantize_float(cinfo, &fdct->float_quantize))
 #endif
       fdct->float_quantize = quantize_float;
@@ -35,6 +35,7 @@
 #include "jchuff.h"             /* Declarations shared with jc*huff.c */
 #include <limits.h>
 #include "jpeg_nbits.h"
+#include "jthread.h"
 
 
 /* Expanded entropy encoder object for Huffman encoding.
@@ -93,6 +94,13 @@ typedef struct {
 #ifdef ENTROPY_OPT_SUPPORTED    /* Statistics tables for optimization */
   long *dc_count_ptrs[NUM_HUFF_TBLS];
   long *ac_count_ptrs[NUM_HUFF_TBLS];
+
+  /* Multithreaded statistics gathering (these workspaces have image
+   * lifespan)
+   */
+  c_deferred_gather gather;
+  struct huff_gather_task *gather_tasks;
+  int max_gather_tasks;         /* allocated size of gather_tasks[] */
 #endif
 
 #ifdef WITH_SIMD
@@ -123,6 +131,8 @@ METHODDEF(void) finish_pass_huff(j_compress_ptr cinfo);
 #ifdef ENTROPY_OPT_SUPPORTED
 METHODDEF(boolean) encode_mcu_gather(j_compress_ptr cinfo,
                                      JBLOCKROW *MCU_data);
+METHODDEF(boolean) encode_mcu_defer(j_compress_ptr cinfo,
+                                    JBLOCKROW *MCU_data);
 METHODDEF(void) finish_pass_gather(j_compress_ptr cinfo);
 #endif
 
@@ -143,6 +153,8 @@ start_pass_huff(j_compress_ptr cinfo, boolean gather_statistics)
   if (gather_statistics) {
 #ifdef ENTROPY_OPT_SUPPORTED
     entropy->pub.encode_mcu = encode_mcu_gather;
+    if (jpeg_start_deferred_gather(cinfo, &entropy->gather))
+      entropy->pub.encode_mcu = encode_mcu_defer;
     entropy->pub.finish_pass = finish_pass_gather;
 #else
     ERREXIT(cinfo, JERR_NOT_COMPILED);
@@ -789,9 +801,12 @@ finish_pass_huff(j_compress_ptr cinfo)
 #ifdef ENTROPY_OPT_SUPPORTED
 
 
-/* Process a single block's worth of coefficients */
+/* Process a single block's worth of coefficients.  Returns FALSE if the block
+ * contains an out-of-range coefficient value.  (This function is also called
+ * by worker threads, so it must not call the error manager.)
+ */
 
-LOCAL(void)
+LOCAL(boolean)
 htest_one_block(j_compress_ptr cinfo, JCOEFPTR block, int last_dc_val,
                 long dc_counts[], long ac_counts[])
 {
@@ -816,7 +831,7 @@ htest_one_block(j_compress_ptr cinfo, JCOEFPTR block, int last_dc_val,
    * Since we're encoding a difference, the range limit is twice as much.
    */
   if (nbits > max_coef_bits + 1)
-    ERREXIT(cinfo, JERR_BAD_DCT_COEF);
+    return FALSE;
 
   /* Count the Huffman symbol for the number of bits */
   dc_counts[nbits]++;
@@ -845,7 +860,7 @@ htest_one_block(j_compress_ptr cinfo, JCOEFPTR block, int last_dc_val,
         nbits++;
       /* Check for out-of-range coefficient values */
       if (nbits > max_coef_bits)
-        ERREXIT(cinfo, JERR_BAD_DCT_COEF);
+        return FALSE;
 
       /* Count Huffman symbol for run length / number of bits */
       ac_counts[(r << 4) + nbits]++;
@@ -857,6 +872,8 @@ htest_one_block(j_compress_ptr cinfo, JCOEFPTR block, int last_dc_val,
   /* If the last coef(s) were zero, emit an end-of-block code */
   if (r > 0)
     ac_counts[0]++;
+
+  return TRUE;
 }
 
 
@@ -887,9 +904,11 @@ encode_mcu_gather(j_compress_ptr cinfo, JBLOCKROW *MCU_data)
   for (blkn = 0; blkn < cinfo->blocks_in_MCU; blkn++) {
     ci = cinfo->MCU_membership[blkn];
     compptr = cinfo->cur_comp_info[ci];
-    htest_one_block(cinfo, MCU_data[blkn][0], entropy->saved.last_dc_val[ci],
-                    entropy->dc_count_ptrs[compptr->dc_tbl_no],
-                    entropy->ac_count_ptrs[compptr->ac_tbl_no]);
+    if (!htest_one_block(cinfo, MCU_data[blkn][0],
+                         entropy->saved.last_dc_val[ci],
+                         entropy->dc_count_ptrs[compptr->dc_tbl_no],
+                         entropy->ac_count_ptrs[compptr->ac_tbl_no]))
+      ERREXIT(cinfo, JERR_BAD_DCT_COEF);
     entropy->saved.last_dc_val[ci] = MCU_data[blkn][0][0];
   }
 
@@ -897,6 +916,256 @@ encode_mcu_gather(j_compress_ptr cinfo, JBLOCKROW *MCU_data)
 }
 
 
+/*
+ * Multithreaded statistics gathering
+ *
+ * When Huffman statistics are gathered using multiple threads, all of the DCT
+ * blocks in the scan are available in the whole-image coefficient buffer by
+ * the time finish_pass_gather() is called.  Thus, encode_mcu_defer() merely
+ * records the location of each MCU, and finish_pass_gather() divides the
+ * MCU rows among the threads.  Each thread counts the symbols in its MCU rows
+ * using private statistics tables, which are then summed in the calling
+ * thread.  Since the counts are simply added, the Huffman tables (and thus the
+ * JPEG image) are identical to those produced by serial gathering.
+ */
+
+GLOBAL(boolean)
+jpeg_start_deferred_gather(j_compress_ptr cinfo, c_deferred_gather *gather)
+{
+  size_t num_blocks;
+
+  gather->num_MCUs = 0;
+  gather->num_threads = 0;
+  if (cinfo->master->gather_threads <= 1 || cinfo->MCU_rows_in_scan < 2 ||
+      cinfo->MCUs_per_row < 2)
+    return FALSE;
+
+  num_blocks = (size_t)cinfo->MCU_rows_in_scan * cinfo->blocks_in_MCU;
+  if (gather->row_blocks == NULL || gather->max_blocks < num_blocks) {
+    gather->row_blocks = (JBLOCKROW *)
+      (*cinfo->mem->alloc_large) ((j_common_ptr)cinfo, JPOOL_IMAGE,
+                                  num_blocks * sizeof(JBLOCKROW));
+    gather->max_blocks = num_blocks;
+  }
+  gather->num_threads = cinfo->master->gather_threads;
+  return TRUE;
+}
+
+
+GLOBAL(boolean)
+jpeg_defer_mcu(j_compress_ptr cinfo, c_deferred_gather *gather,
+               JBLOCKROW *MCU_data)
+{
+  JDIMENSION MCU_row = gather->num_MCUs / cinfo->MCUs_per_row;
+  JDIMENSION MCU_col = gather->num_MCUs % cinfo->MCUs_per_row;
+  JBLOCKROW *first;
+  int blkn;
+
+  if (MCU_row >= cinfo->MCU_rows_in_scan)
+    return FALSE;
+  first = gather->row_blocks + (size_t)MCU_row * cinfo->blocks_in_MCU;
+
+  if (MCU_col == 0) {
+    for (blkn = 0; blkn < cinfo->blocks_in_MCU; blkn++)
+      first[blkn] = MCU_data[blkn];
+  } else {
+    /* Each subsequent MCU in the row must be offset from the first by the
+     * component's MCU width.
+     */
+    for (blkn = 0; blkn < cinfo->blocks_in_MCU; blkn++) {
+      jpeg_component_info *compptr =
+        cinfo->cur_comp_info[cinfo->MCU_membership[blkn]];
+
+      if (MCU_data[blkn] != first[blkn] + MCU_col * compptr->MCU_width)
+        return FALSE;
+    }
+  }
+
+  gather->num_MCUs++;
+  return TRUE;
+}
+
+
+GLOBAL(void)
+jpeg_get_deferred_mcu(j_compress_ptr cinfo, const c_deferred_gather *gather,
+                      JDIMENSION MCU_num, JBLOCKROW *MCU_data)
+{
+  JDIMENSION MCU_col = MCU_num % cinfo->MCUs_per_row;
+  JBLOCKROW *first = gather->row_blocks +
+    (size_t)(MCU_num / cinfo->MCUs_per_row) * cinfo->blocks_in_MCU;
+  int blkn;
+
+  for (blkn = 0; blkn < cinfo->blocks_in_MCU; blkn++) {
+    jpeg_component_info *compptr =
+      cinfo->cur_comp_info[cinfo->MCU_membership[blkn]];
+
+    MCU_data[blkn] = first[blkn] + MCU_col * compptr->MCU_width;
+  }
+}
+
+
+GLOBAL(int)
+jpeg_split_deferred_gather(j_compress_ptr cinfo,
+                           const c_deferred_gather *gather,
+                           JDIMENSION *MCUs_per_task)
+{
+  JDIMENSION num_rows = gather->num_MCUs / cinfo->MCUs_per_row;
+  JDIMENSION rows_per_task;
+  int num_tasks = gather->num_threads;
+
+  if (num_rows < 1)
+    num_rows = 1;
+  if ((JDIMENSION)num_tasks > num_rows)
+    num_tasks = (int)num_rows;
+  rows_per_task = (num_rows + num_tasks - 1) / num_tasks;
+  *MCUs_per_task = rows_per_task * cinfo->MCUs_per_row;
+  return (int)((gather->num_MCUs + *MCUs_per_task - 1) / *MCUs_per_task);
+}
+
+
+/* Private statistics tables and MCU range for one thread */
+
+typedef struct huff_gather_task {
+  j_compress_ptr cinfo;
+  const c_deferred_gather *gather;
+  JDIMENSION start_MCU, end_MCU;
+  boolean bad_coef;             /* TRUE if an invalid coefficient was found */
+  long dc_counts[NUM_HUFF_TBLS][257];
+  long ac_counts[NUM_HUFF_TBLS][257];
+} huff_gather_task;
+
+
+METHODDEF(void)
+gather_mcu_rows(void *arg)
+{
+  huff_gather_task *task = (huff_gather_task *)arg;
+  j_compress_ptr cinfo = task->cinfo;
+  JBLOCKROW MCU_data[C_MAX_BLOCKS_IN_MCU];
+  int last_dc_val[MAX_COMPS_IN_SCAN];
+  JDIMENSION MCU_num;
+  int blkn, ci;
+  jpeg_component_info *compptr;
+
+  memset(task->dc_counts, 0, sizeof(task->dc_counts));
+  memset(task->ac_counts, 0, sizeof(task->ac_counts));
+
+  /* The DC predictions at the start of the range are the DC values of the
+   * last block of each component in the preceding MCU.
+   */
+  for (ci = 0; ci < cinfo->comps_in_scan; ci++)
+    last_dc_val[ci] = 0;
+  if (task->start_MCU > 0) {
+    jpeg_get_deferred_mcu(cinfo, task->gather, task->start_MCU - 1, MCU_data);
+    for (blkn = 0; blkn < cinfo->blocks_in_MCU; blkn++)
+      last_dc_val[cinfo->MCU_membership[blkn]] = MCU_data[blkn][0][0];
+  }
+
+  for (MCU_num = task->start_MCU; MCU_num < task->end_MCU; MCU_num++) {
+    /* Re-initialize DC predictions to 0 at the start of each restart
+     * interval
+     */
+    if (cinfo->restart_interval && MCU_num % cinfo->restart_interval == 0) {
+      for (ci = 0; ci < cinfo->comps_in_scan; ci++)
+        last_dc_val[ci] = 0;
+    }
+
+    jpeg_get_deferred_mcu(cinfo, task->gather, MCU_num, MCU_data);
+    for (blkn = 0; blkn < cinfo->blocks_in_MCU; blkn++) {
+      ci = cinfo->MCU_membership[blkn];
+      compptr = cinfo->cur_comp_info[ci];
+      if (!htest_one_block(cinfo, MCU_data[blkn][0], last_dc_val[ci],
+                           task->dc_counts[compptr->dc_tbl_no],
+                           task->ac_counts[compptr->ac_tbl_no])) {
+        task->bad_coef = TRUE;
+        return;
+      }
+      last_dc_val[ci] = MCU_data[blkn][0][0];
+    }
+  }
+}
+
+
+/*
+ * Record one MCU for multithreaded statistics gathering.
+ */
+
+METHODDEF(boolean)
+encode_mcu_defer(j_compress_ptr cinfo, JBLOCKROW *MCU_data)
+{
+  huff_entropy_ptr entropy = (huff_entropy_ptr)cinfo->entropy;
+  JBLOCKROW recorded_MCU[C_MAX_BLOCKS_IN_MCU];
+  JDIMENSION MCU_num;
+
+  if (jpeg_defer_mcu(cinfo, &entropy->gather, MCU_data))
+    return TRUE;
+
+  /* The coefficient controller did not supply the DCT blocks in the expected
+   * layout, so gather the statistics for the rest of the scan serially,
+   * starting with the MCUs that have already been recorded.
+   */
+  entropy->gather.num_threads = 0;
+  entropy->pub.encode_mcu = encode_mcu_gather;
+  for (MCU_num = 0; MCU_num < entropy->gather.num_MCUs; MCU_num++) {
+    jpeg_get_deferred_mcu(cinfo, &entropy->gather, MCU_num, recorded_MCU);
+    encode_mcu_gather(cinfo, recorded_MCU);
+  }
+  return encode_mcu_gather(cinfo, MCU_data);
+}
+
+
+/*
+ * Count the symbols in the recorded MCUs using multiple threads.
+ */
+
+LOCAL(void)
+gather_deferred(j_compress_ptr cinfo)
+{
+  huff_entropy_ptr entropy = (huff_entropy_ptr)cinfo->entropy;
+  huff_gather_task *tasks;
+  JDIMENSION MCUs_per_task;
+  int num_tasks, t, tbl, i;
+
+  num_tasks = jpeg_split_deferred_gather(cinfo, &entropy->gather,
+                                         &MCUs_per_task);
+  if (num_tasks < 1)
+    return;
+  if (entropy->gather_tasks == NULL ||
+      entropy->max_gather_tasks < num_tasks) {
+    entropy->gather_tasks = (huff_gather_task *)
+      (*cinfo->mem->alloc_large) ((j_common_ptr)cinfo, JPOOL_IMAGE,
+                                  num_tasks * sizeof(huff_gather_task));
+    entropy->max_gather_tasks = num_tasks;
+  }
+  tasks = entropy->gather_tasks;
+  for (t = 0; t < num_tasks; t++) {
+    tasks[t].cinfo = cinfo;
+    tasks[t].gather = &entropy->gather;
+    tasks[t].start_MCU = t * MCUs_per_task;
+    tasks[t].end_MCU = MIN(tasks[t].start_MCU + MCUs_per_task,
+                           entropy->gather.num_MCUs);
+    tasks[t].bad_coef = FALSE;
+  }
+
+  jthread_run(entropy->gather.num_threads, gather_mcu_rows, tasks,
+              sizeof(huff_gather_task), num_tasks);
+
+  for (t = 0; t < num_tasks; t++) {
+    if (tasks[t].bad_coef)
+      ERREXIT(cinfo, JERR_BAD_DCT_COEF);
+    for (tbl = 0; tbl < NUM_HUFF_TBLS; tbl++) {
+      if (entropy->dc_count_ptrs[tbl] != NULL) {
+        for (i = 0; i < 257; i++)
+          entropy->dc_count_ptrs[tbl][i] += tasks[t].dc_counts[tbl][i];
+      }
+      if (entropy->ac_count_ptrs[tbl] != NULL) {
+        for (i = 0; i < 257; i++)
+          entropy->ac_count_ptrs[tbl][i] += tasks[t].ac_counts[tbl][i];
+      }
+    }
+  }
+}
+
+
 /*
  * Generate the best Huffman code table for the given counts, fill htbl.
  * Note this is also used by jcphuff.c and jclhuff.c.
@@ -1105,6 +1374,11 @@ finish_pass_gather(j_compress_ptr cinfo)
   boolean did_dc[NUM_HUFF_TBLS];
   boolean did_ac[NUM_HUFF_TBLS];
 
+  if (entropy->gather.num_threads) {
+    gather_deferred(cinfo);
+    entropy->gather.num_threads = 0;
+  }
+
   /* It's important not to apply jpeg_gen_optimal_table more than once
    * per table, because it clobbers the input frequency counts!
    */
@@ -1159,4 +1433,9 @@ jinit_huff_encoder(j_compress_ptr cinfo)
     entropy->dc_count_ptrs[i] = entropy->ac_count_ptrs[i] = NULL;
 #endif
   }
+#ifdef ENTROPY_OPT_SUPPORTED
+  entropy->gather.row_blocks = NULL;
+  entropy->gather.num_threads = 0;
+  entropy->gather_tasks = NULL;
+#endif
 }
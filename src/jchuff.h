@@ -4,7 +4,7 @@
  * This file was part of the Independent JPEG Group's software:
  * Copyright (C) 1991-1997, Thomas G. Lane.
  * libjpeg-turbo Modifications:
- * Copyright (C) 2022, 2025, D. R. Commander.
+ * Copyright (C) 2022, 2025-2026, D. R. Commander.
  * For conditions of distribution and use, see the accompanying README.ijg
  * file.
  *
@@ -49,4 +49,43 @@ EXTERN(void) jpeg_make_c_derived_tbl(j_compress_ptr cinfo, boolean isDC,
 EXTERN(void) jpeg_gen_optimal_table(j_compress_ptr cinfo, JHUFF_TBL *htbl,
                                     long freq[]);
 
+/* State for deferred (multithreaded) statistics gathering.  When Huffman
+ * statistics for a scan are gathered using multiple threads, the gathering
+ * pass merely records the location of each MCU's DCT blocks in the
+ * whole-image coefficient buffer, and the symbols are counted in parallel by
+ * finish_pass().
+ */
+
+typedef struct {
+  JBLOCKROW *row_blocks;        /* blocks of first MCU in each MCU row */
+  size_t max_blocks;            /* allocated size of row_blocks[] */
+  JDIMENSION num_MCUs;          /* # of MCUs recorded so far */
+  int num_threads;              /* # of threads, or 0 if not deferring */
+} c_deferred_gather;
+
+/* Prepare to defer statistics gathering for the current scan.  Returns FALSE
+ * if the scan's statistics should be gathered serially.
+ */
+EXTERN(boolean) jpeg_start_deferred_gather(j_compress_ptr cinfo,
+                                           c_deferred_gather *gather);
+
+/* Record the next MCU.  Returns FALSE if the MCU's DCT blocks are not laid
+ * out as expected, in which case the MCU is not recorded.
+ */
+EXTERN(boolean) jpeg_defer_mcu(j_compress_ptr cinfo,
+                               c_deferred_gather *gather, JBLOCKROW *MCU_data);
+
+/* Retrieve the DCT blocks of a previously-recorded MCU */
+EXTERN(void) jpeg_get_deferred_mcu(j_compress_ptr cinfo,
+                                   const c_deferred_gather *gather,
+                                   JDIMENSION MCU_num, JBLOCKROW *MCU_data);
+
+/* Divide the recorded MCUs into at most gather->num_threads tasks, each of
+ * which consists of whole MCU rows.  Returns the number of tasks and stores
+ * the number of MCUs per task (except the last) in *MCUs_per_task.
+ */
+EXTERN(int) jpeg_split_deferred_gather(j_compress_ptr cinfo,
+                                       const c_deferred_gather *gather,
+                                       JDIMENSION *MCUs_per_task);
+
 #endif /* JCHUFF_H */
@@ -162,7 +162,9 @@ start_pass_lhuff(j_compress_ptr cinfo, boolean gather_statistics)
         ERREXIT1(cinfo, JERR_NO_HUFF_TABLE, dctbl);
       /* Allocate and zero the statistics tables */
       /* Note that jpeg_gen_optimal_table expects 257 entries in each table! */
-      if (entropy->count_ptrs[dctbl] == NULL)
+      if (cinfo->master->lhuff_counts != NULL)
+        entropy->count_ptrs[dctbl] = cinfo->master->lhuff_counts[dctbl];
+      else if (entropy->count_ptrs[dctbl] == NULL)
         entropy->count_ptrs[dctbl] = (long *)
           (*cinfo->mem->alloc_small) ((j_common_ptr)cinfo, JPOOL_IMAGE,
                                       257 * sizeof(long));
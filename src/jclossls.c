@@ -17,6 +17,9 @@
 #define JPEG_INTERNALS
 #include "jinclude.h"
 #include "jpeglib.h"
+#ifdef WITH_SIMD
+#include "../simd/jsimd.h"
+#endif
 #include "jlossls.h"
 
 #ifdef C_LOSSLESS_SUPPORTED
@@ -235,6 +238,55 @@ jpeg_difference_first_row(j_compress_ptr cinfo, int ci,
   }
 }
 
+
+#ifdef WITH_SIMD
+
+/*
+ * SIMD differencers.  These use the same initial predictors as the C
+ * differencers and account for the restart interval in the same way.
+ */
+
+METHODDEF(void)
+simd_difference(j_compress_ptr cinfo, int ci,
+                _JSAMPROW input_buf, _JSAMPROW prev_row,
+                JDIFFROW diff_buf, JDIMENSION width)
+{
+  lossless_comp_ptr losslessc = (lossless_comp_ptr)cinfo->fdct;
+
+  (*losslessc->difference_simd) (input_buf, prev_row, diff_buf, width,
+                                 INITIAL_PREDICTOR2);
+
+  /* Account for restart interval (no-op if not using restarts) */
+  if (cinfo->restart_interval) {
+    if (--losslessc->restart_rows_to_go[ci] == 0)
+      reset_predictor(cinfo, ci);
+  }
+}
+
+METHODDEF(void)
+simd_difference_first_row(j_compress_ptr cinfo, int ci,
+                          _JSAMPROW input_buf, _JSAMPROW prev_row,
+                          JDIFFROW diff_buf, JDIMENSION width)
+{
+  lossless_comp_ptr losslessc = (lossless_comp_ptr)cinfo->fdct;
+
+  (*losslessc->difference_first_row_simd) (input_buf, prev_row, diff_buf,
+                                           width, INITIAL_PREDICTORx);
+
+  /* Account for restart interval (no-op if not using restarts) */
+  if (cinfo->restart_interval) {
+    if (--(losslessc->restart_rows_to_go[ci]) == 0) {
+      reset_predictor(cinfo, ci);
+      return;
+    }
+  }
+
+  losslessc->predict_difference[ci] = simd_difference;
+}
+
+#endif
+
+
 /*
  * Reset predictor at the start of a pass or restart interval.
  */
@@ -249,7 +301,12 @@ reset_predictor(j_compress_ptr cinfo, int ci)
     cinfo->restart_interval / cinfo->MCUs_per_row;
 
   /* Set difference function to first row function */
-  losslessc->predict_difference[ci] = jpeg_difference_first_row;
+#ifdef WITH_SIMD
+  if (losslessc->difference_simd)
+    losslessc->predict_difference[ci] = simd_difference_first_row;
+  else
+#endif
+    losslessc->predict_difference[ci] = jpeg_difference_first_row;
 }
 
 
@@ -296,6 +353,14 @@ start_pass_lossless(j_compress_ptr cinfo)
     ERREXIT2(cinfo, JERR_BAD_RESTART,
              cinfo->restart_interval, cinfo->MCUs_per_row);
 
+#ifdef WITH_SIMD
+  losslessc->difference_first_row_simd = NULL;
+  losslessc->difference_simd = NULL;
+  if (_jsimd_set_difference(cinfo, 1,
+                            &losslessc->difference_first_row_simd))
+    _jsimd_set_difference(cinfo, cinfo->Ss, &losslessc->difference_simd);
+#endif
+
   /* Set predictors for start of pass */
   for (ci = 0; ci < cinfo->num_components; ci++)
     reset_predictor(cinfo, ci);
@@ -22,6 +22,7 @@
 #include "jpeglib.h"
 #include "jpegapicomp.h"
 #include "jcmaster.h"
+#include "jthread.h"
 #ifdef WITH_PROFILE
 #include "tjutil.h"
 #endif
@@ -611,7 +612,7 @@ prepare_for_pass(j_compress_ptr cinfo)
     select_scan_parameters(cinfo);
     per_scan_setup(cinfo);
     if (cinfo->Ss != 0 || cinfo->Ah == 0 || cinfo->arith_code ||
-        cinfo->master->lossless) {
+        cinfo->master->lossless || cinfo->master->parallel_scans) {
       (*cinfo->entropy->start_pass) (cinfo, TRUE);
       (*cinfo->coef->start_pass) (cinfo, JBUF_CRANK_DEST);
       master->pub.call_pass_startup = FALSE;
@@ -696,10 +697,18 @@ finish_pass_master(j_compress_ptr cinfo)
     master->pass_type = output_pass;
     if (!cinfo->optimize_coding)
       master->scan_number++;
+    if (master->pub.parallel_scans) {
+      master->pass_type = huff_opt_pass;
+      master->scan_number++;
+    }
     break;
   case huff_opt_pass:
     /* next pass is always output of current scan */
     master->pass_type = output_pass;
+    if (master->pub.parallel_scans) {
+      master->pass_type = huff_opt_pass;
+      master->scan_number++;
+    }
     break;
   case output_pass:
     /* next pass is either optimization or output of next scan */
@@ -797,9 +806,39 @@ jinit_c_master_control(j_compress_ptr cinfo, boolean transcode_only)
     /* for normal compression, first pass is always this type: */
     master->pass_type = main_pass;
   }
+
+  /* The Huffman encoders can gather statistics using multiple threads only if
+   * all of the DCT blocks in a scan remain in the whole-image coefficient
+   * buffer until the end of the pass.  That is not the case when transcoding,
+   * since jctrans.c generates dummy blocks on the fly.
+   */
+  master->pub.gather_threads = 1;
+  if (!transcode_only && cinfo->optimize_coding)
+    master->pub.gather_threads = master->pub.num_threads ?
+                                 master->pub.num_threads : jthread_num_cpus();
+
+  /* The scans of a progressive Huffman-coded image can be encoded in parallel
+   * once all of the DCT coefficients are in the whole-image coefficient
+   * buffer.  In that case, the main pass and the subsequent "optimization"
+   * passes merely record the layout of each scan for the progressive Huffman
+   * encoder, which encodes all of the scans and writes the frame and scan
+   * headers at the end of the last pass.
+   */
+  master->pub.parallel_scans = FALSE;
+#if defined(C_PROGRESSIVE_SUPPORTED) && defined(ENTROPY_OPT_SUPPORTED) && \
+    defined(WITH_THREADS)
+  if (!transcode_only && cinfo->progressive_mode && !cinfo->arith_code &&
+      cinfo->optimize_coding && cinfo->num_scans > 1 &&
+      (master->pub.num_threads ? master->pub.num_threads :
+                                 jthread_num_cpus()) > 1)
+    master->pub.parallel_scans = TRUE;
+#endif
+
   master->scan_number = 0;
   master->pass_number = 0;
-  if (cinfo->optimize_coding)
+  if (master->pub.parallel_scans)
+    master->total_passes = cinfo->num_scans;
+  else if (cinfo->optimize_coding)
     master->total_passes = cinfo->num_scans * 2;
   else
     master->total_passes = cinfo->num_scans;
@@ -205,6 +205,18 @@ jpeg_destroy(j_common_ptr cinfo)
   }
 #endif
 
+  /* Release any resources that the data source manager holds outside of the
+   * memory manager's pools.
+   */
+  if (cinfo->is_decompressor && cinfo->mem != NULL) {
+    j_decompress_ptr dinfo = (j_decompress_ptr)cinfo;
+
+    if (dinfo->master != NULL && dinfo->master->release_source != NULL) {
+      (*dinfo->master->release_source) (dinfo);
+      dinfo->master->release_source = NULL;
+    }
+  }
+
   /* We need only tell the memory manager to release everything. */
   /* NB: mem pointer is NULL if memory mgr failed to initialize. */
   if (cinfo->mem != NULL)
@@ -6,7 +6,7 @@
  * Lossless JPEG Modifications:
  * Copyright (C) 1999, Ken Murchison.
  * libjpeg-turbo Modifications:
- * Copyright (C) 2011, 2015, 2018, 2021-2022, 2024-2025, D. R. Commander.
+ * Copyright (C) 2011, 2015, 2018, 2021-2022, 2024-2026, D. R. Commander.
  * Copyright (C) 2016, 2018, 2022, Matthieu Darbois.
  * Copyright (C) 2020, Arm Limited.
  * Copyright (C) 2021, Alex Richardson.
@@ -18,6 +18,10 @@
  * We do not support output suspension in this module, since the library
  * currently does not allow multiple-scan files to be written with output
  * suspension.
+ *
+ * If cinfo->master->parallel_scans is TRUE, then this module also encodes all
+ * of the scans in parallel, once the whole-image coefficient buffer has been
+ * filled (see "Parallel scan encoding" below.)
  */
 
 #define JPEG_INTERNALS
@@ -28,6 +32,7 @@
 #endif
 #include "jchuff.h"             /* Declarations shared with jc*huff.c */
 #include <limits.h>
+#include <setjmp.h>
 
 #ifdef HAVE_INTRIN_H
 #include <intrin.h>
@@ -44,6 +49,7 @@
 #ifdef C_PROGRESSIVE_SUPPORTED
 
 #include "jpeg_nbits.h"
+#include "jthread.h"
 
 
 /* Expanded entropy encoder object for progressive Huffman encoding. */
@@ -93,6 +99,21 @@ typedef struct {
 
   /* Statistics tables for optimization; again, one set is enough */
   long *count_ptrs[NUM_HUFF_TBLS];
+
+  /* Multithreaded statistics gathering (these workspaces have image
+   * lifespan)
+   */
+  c_deferred_gather gather;
+  boolean (*serial_encode_mcu) (j_compress_ptr cinfo, JBLOCKROW *MCU_data);
+  struct phuff_gather_task *gather_tasks;
+  int max_gather_tasks;         /* allocated size of gather_tasks[] */
+
+  /* Parallel scan encoding (scan_tasks has image lifespan) */
+  boolean record_scans;         /* TRUE if recording scans for later */
+  struct phuff_scan_task *scan_tasks;
+  int num_recorded_scans;
+  /* Application's error_exit() method, while scans are being written */
+  void (*error_exit) (j_common_ptr cinfo);
 } phuff_entropy_encoder;
 
 typedef phuff_entropy_encoder *phuff_entropy_ptr;
@@ -138,8 +159,11 @@ METHODDEF(int) encode_mcu_AC_refine_prepare
    UJCOEF *absvalues, size_t *bits);
 METHODDEF(boolean) encode_mcu_AC_refine(j_compress_ptr cinfo,
                                         JBLOCKROW *MCU_data);
+METHODDEF(boolean) encode_mcu_defer(j_compress_ptr cinfo,
+                                    JBLOCKROW *MCU_data);
 METHODDEF(void) finish_pass_phuff(j_compress_ptr cinfo);
 METHODDEF(void) finish_pass_gather_phuff(j_compress_ptr cinfo);
+LOCAL(void) start_pass_record(j_compress_ptr cinfo);
 
 
 /* Count bit loop zeroes */
@@ -185,6 +209,11 @@ start_pass_phuff(j_compress_ptr cinfo, boolean gather_statistics)
   entropy->cinfo = cinfo;
   entropy->gather_statistics = gather_statistics;
 
+  if (entropy->record_scans) {
+    start_pass_record(cinfo);
+    return;
+  }
+
   is_DC_band = (cinfo->Ss == 0);
 
   /* We assume jcmaster.c already validated the scan parameters. */
@@ -222,6 +251,18 @@ start_pass_phuff(j_compress_ptr cinfo, boolean gather_statistics)
   else
     entropy->pub.finish_pass = finish_pass_phuff;
 
+  /* Statistics for initial scans can be gathered using multiple threads.
+   * Refinement scans are always processed serially, since DC refinement scans
+   * have no statistics and the EOB runs in AC refinement scans depend on the
+   * correction bits buffered for all of the preceding blocks.
+   */
+  entropy->gather.num_threads = 0;
+  if (gather_statistics && cinfo->Ah == 0 &&
+      jpeg_start_deferred_gather(cinfo, &entropy->gather)) {
+    entropy->serial_encode_mcu = entropy->pub.encode_mcu;
+    entropy->pub.encode_mcu = encode_mcu_defer;
+  }
+
   /* Only DC coefficients may be interleaved, so cinfo->comps_in_scan = 1
    * for AC coefficients.
    */
@@ -1025,6 +1066,273 @@ finish_pass_phuff(j_compress_ptr cinfo)
 }
 
 
+/*
+ * Multithreaded statistics gathering for initial scans (see jchuff.c)
+ */
+
+/* Private statistics tables and MCU range for one thread */
+
+typedef struct phuff_gather_task {
+  j_compress_ptr cinfo;
+  const c_deferred_gather *gather;
+  JDIMENSION start_MCU, end_MCU;
+  boolean bad_coef;             /* TRUE if an invalid coefficient was found */
+  /* AC scans only: An EOB run cannot be counted until the next block with
+   * nonzero coefficients or restart marker, so each thread returns the length
+   * of the run at the start of its range (which may continue a run from the
+   * preceding range) and the length of the run at the end (which may be
+   * continued by the following range.)  ended_run is TRUE if the range
+   * contains anything that ends an EOB run.
+   */
+  boolean ended_run;
+  JDIMENSION lead_EOBRUN, tail_EOBRUN;
+  long counts[NUM_HUFF_TBLS][257];
+} phuff_gather_task;
+
+
+/* Count the symbol(s) that emit_eobrun() would emit for an EOB run of the
+ * given length, taking into account that encode_mcu_AC_first() forces out
+ * runs of length 0x7FFF.
+ */
+
+LOCAL(void)
+count_eobrun(long counts[], JDIMENSION EOBRUN)
+{
+  counts[14 << 4] += EOBRUN / 0x7FFF;
+  EOBRUN %= 0x7FFF;
+  if (EOBRUN > 0)
+    counts[(JPEG_NBITS_NONZERO(EOBRUN) - 1) << 4]++;
+}
+
+
+METHODDEF(void)
+gather_mcu_rows_DC_first(void *arg)
+{
+  phuff_gather_task *task = (phuff_gather_task *)arg;
+  j_compress_ptr cinfo = task->cinfo;
+  JBLOCKROW MCU_data[C_MAX_BLOCKS_IN_MCU];
+  int last_dc_val[MAX_COMPS_IN_SCAN];
+  register int temp, temp2;
+  register int nbits;
+  JDIMENSION MCU_num;
+  int blkn, ci;
+  int Al = cinfo->Al;
+  int max_coef_bits = cinfo->data_precision + 2;
+  ISHIFT_TEMPS
+
+  memset(task->counts, 0, sizeof(task->counts));
+
+  /* The DC predictions at the start of the range are the point-transformed DC
+   * values of the last block of each component in the preceding MCU.
+   */
+  for (ci = 0; ci < cinfo->comps_in_scan; ci++)
+    last_dc_val[ci] = 0;
+  if (task->start_MCU > 0) {
+    jpeg_get_deferred_mcu(cinfo, task->gather, task->start_MCU - 1, MCU_data);
+    for (blkn = 0; blkn < cinfo->blocks_in_MCU; blkn++)
+      last_dc_val[cinfo->MCU_membership[blkn]] =
+        IRIGHT_SHIFT((int)(MCU_data[blkn][0][0]), Al);
+  }
+
+  for (MCU_num = task->start_MCU; MCU_num < task->end_MCU; MCU_num++) {
+    if (cinfo->restart_interval && MCU_num % cinfo->restart_interval == 0) {
+      for (ci = 0; ci < cinfo->comps_in_scan; ci++)
+        last_dc_val[ci] = 0;
+    }
+
+    jpeg_get_deferred_mcu(cinfo, task->gather, MCU_num, MCU_data);
+    for (blkn = 0; blkn < cinfo->blocks_in_MCU; blkn++) {
+      ci = cinfo->MCU_membership[blkn];
+
+      /* This must agree with encode_mcu_DC_first(). */
+      temp2 = IRIGHT_SHIFT((int)(MCU_data[blkn][0][0]), Al);
+      temp = temp2 - last_dc_val[ci];
+      last_dc_val[ci] = temp2;
+      if (temp < 0)
+        temp = -temp;
+      nbits = JPEG_NBITS(temp);
+      if (nbits > max_coef_bits + 1) {
+        task->bad_coef = TRUE;
+        return;
+      }
+      task->counts[cinfo->cur_comp_info[ci]->dc_tbl_no][nbits]++;
+    }
+  }
+}
+
+
+METHODDEF(void)
+gather_mcu_rows_AC_first(void *arg)
+{
+  phuff_gather_task *task = (phuff_gather_task *)arg;
+  j_compress_ptr cinfo = task->cinfo;
+  JBLOCKROW MCU_data[C_MAX_BLOCKS_IN_MCU];
+  const int *natural_order = jpeg_natural_order + cinfo->Ss;
+  int Sl = cinfo->Se - cinfo->Ss + 1;
+  int Al = cinfo->Al;
+  int max_coef_bits = cinfo->data_precision + 2;
+  long *counts = task->counts[cinfo->cur_comp_info[0]->ac_tbl_no];
+  register int temp, nbits, r, k;
+  JDIMENSION MCU_num, EOBRUN = 0;
+  boolean ended_run = FALSE;
+
+  memset(task->counts, 0, sizeof(task->counts));
+
+  /* End the current EOB run.  The first such run in the range is counted by
+   * the calling thread, since it may continue a run from the preceding range.
+   */
+#define END_EOBRUN() { \
+  if (!ended_run) { \
+    task->lead_EOBRUN = EOBRUN; \
+    ended_run = TRUE; \
+  } else \
+    count_eobrun(counts, EOBRUN); \
+  EOBRUN = 0; \
+}
+
+  for (MCU_num = task->start_MCU; MCU_num < task->end_MCU; MCU_num++) {
+    /* A restart marker ends the EOB run. */
+    if (cinfo->restart_interval && MCU_num > 0 &&
+        MCU_num % cinfo->restart_interval == 0)
+      END_EOBRUN();
+
+    /* This must agree with encode_mcu_AC_first(). */
+    jpeg_get_deferred_mcu(cinfo, task->gather, MCU_num, MCU_data);
+    r = 0;
+    for (k = 0; k < Sl; k++) {
+      temp = MCU_data[0][0][natural_order[k]];
+      if (temp < 0)
+        temp = -temp;
+      temp >>= Al;
+      if (temp == 0) {
+        r++;
+        continue;
+      }
+      /* The first nonzero coefficient in a block ends the EOB run. */
+      if (r == k)
+        END_EOBRUN();
+      while (r > 15) {
+        counts[0xF0]++;
+        r -= 16;
+      }
+      nbits = JPEG_NBITS_NONZERO(temp);
+      if (nbits > max_coef_bits) {
+        task->bad_coef = TRUE;
+        return;
+      }
+      counts[(r << 4) + nbits]++;
+      r = 0;
+    }
+
+    if (r > 0) {                /* If there are trailing zeroes, */
+      EOBRUN++;                 /* count an EOB */
+      if (ended_run && EOBRUN == 0x7FFF) {
+        counts[14 << 4]++;      /* force it out to avoid overflow */
+        EOBRUN = 0;
+      }
+    }
+  }
+
+  if (!ended_run)
+    task->lead_EOBRUN = EOBRUN;
+  task->ended_run = ended_run;
+  task->tail_EOBRUN = ended_run ? EOBRUN : 0;
+}
+
+
+/*
+ * Record one MCU for multithreaded statistics gathering.
+ */
+
+METHODDEF(boolean)
+encode_mcu_defer(j_compress_ptr cinfo, JBLOCKROW *MCU_data)
+{
+  phuff_entropy_ptr entropy = (phuff_entropy_ptr)cinfo->entropy;
+  JBLOCKROW recorded_MCU[C_MAX_BLOCKS_IN_MCU];
+  JDIMENSION MCU_num;
+
+  if (jpeg_defer_mcu(cinfo, &entropy->gather, MCU_data))
+    return TRUE;
+
+  /* The coefficient controller did not supply the DCT blocks in the expected
+   * layout, so gather the statistics for the rest of the scan serially,
+   * starting with the MCUs that have already been recorded.
+   */
+  entropy->gather.num_threads = 0;
+  entropy->pub.encode_mcu = entropy->serial_encode_mcu;
+  for (MCU_num = 0; MCU_num < entropy->gather.num_MCUs; MCU_num++) {
+    jpeg_get_deferred_mcu(cinfo, &entropy->gather, MCU_num, recorded_MCU);
+    (*entropy->serial_encode_mcu) (cinfo, recorded_MCU);
+  }
+  return (*entropy->serial_encode_mcu) (cinfo, MCU_data);
+}
+
+
+/*
+ * Count the symbols in the recorded MCUs using multiple threads.
+ */
+
+LOCAL(void)
+gather_deferred(j_compress_ptr cinfo)
+{
+  phuff_entropy_ptr entropy = (phuff_entropy_ptr)cinfo->entropy;
+  phuff_gather_task *tasks;
+  JDIMENSION MCUs_per_task, EOBRUN = 0;
+  int num_tasks, t, tbl, i;
+
+  num_tasks = jpeg_split_deferred_gather(cinfo, &entropy->gather,
+                                         &MCUs_per_task);
+  if (num_tasks < 1)
+    return;
+  if (entropy->gather_tasks == NULL ||
+      entropy->max_gather_tasks < num_tasks) {
+    entropy->gather_tasks = (phuff_gather_task *)
+      (*cinfo->mem->alloc_large) ((j_common_ptr)cinfo, JPOOL_IMAGE,
+                                  num_tasks * sizeof(phuff_gather_task));
+    entropy->max_gather_tasks = num_tasks;
+  }
+  tasks = entropy->gather_tasks;
+  for (t = 0; t < num_tasks; t++) {
+    tasks[t].cinfo = cinfo;
+    tasks[t].gather = &entropy->gather;
+    tasks[t].start_MCU = t * MCUs_per_task;
+    tasks[t].end_MCU = MIN(tasks[t].start_MCU + MCUs_per_task,
+                           entropy->gather.num_MCUs);
+    tasks[t].bad_coef = FALSE;
+  }
+
+  jthread_run(entropy->gather.num_threads,
+              cinfo->Ss == 0 ? gather_mcu_rows_DC_first :
+                               gather_mcu_rows_AC_first,
+              tasks, sizeof(phuff_gather_task), num_tasks);
+
+  for (t = 0; t < num_tasks; t++) {
+    if (tasks[t].bad_coef)
+      ERREXIT(cinfo, JERR_BAD_DCT_COEF);
+    for (tbl = 0; tbl < NUM_HUFF_TBLS; tbl++) {
+      if (entropy->count_ptrs[tbl] != NULL) {
+        for (i = 0; i < 257; i++)
+          entropy->count_ptrs[tbl][i] += tasks[t].counts[tbl][i];
+      }
+    }
+  }
+
+  /* Count the EOB runs that span range boundaries. */
+  if (cinfo->Ss != 0) {
+    long *counts = entropy->count_ptrs[entropy->ac_tbl_no];
+
+    for (t = 0; t < num_tasks; t++) {
+      EOBRUN += tasks[t].lead_EOBRUN;
+      if (tasks[t].ended_run) {
+        count_eobrun(counts, EOBRUN);
+        EOBRUN = tasks[t].tail_EOBRUN;
+      }
+    }
+    count_eobrun(counts, EOBRUN);
+  }
+}
+
+
 /*
  * Finish up a statistics-gathering pass and create the new Huffman tables.
  */
@@ -1039,6 +1347,11 @@ finish_pass_gather_phuff(j_compress_ptr cinfo)
   JHUFF_TBL **htblptr;
   boolean did[NUM_HUFF_TBLS];
 
+  if (entropy->gather.num_threads) {
+    gather_deferred(cinfo);
+    entropy->gather.num_threads = 0;
+  }
+
   /* Flush out buffered data (all we care about is counting the EOB symbol) */
   emit_eobrun(entropy);
 
@@ -1072,6 +1385,401 @@ finish_pass_gather_phuff(j_compress_ptr cinfo)
 }
 
 
+/*
+ * Parallel scan encoding
+ *
+ * When encoding a progressive JPEG image with multiple threads, all of the
+ * DCT coefficients are in the whole-image coefficient buffer after the main
+ * pass, and each scan only reads them.  Thus, jcmaster.c performs one cheap
+ * pass per scan, during which this module merely records the location of each
+ * MCU's DCT blocks.  At the end of the last pass, each scan is assigned to a
+ * thread, which gathers the statistics for the scan, generates its optimal
+ * Huffman tables, and encodes the scan into a private memory buffer.  The
+ * calling thread then writes the frame header and each scan's header and
+ * entropy-coded data, in scan script order, to the data destination.  The
+ * output is identical to that of serial encoding.
+ *
+ * Each scan is encoded using a private copy of the compression object, which
+ * is set up by the calling thread so that the worker thread never allocates
+ * memory from the memory manager, calls the application's error manager, or
+ * writes to the application's destination manager.  Errors in a worker thread
+ * longjmp() back to that thread's starting point and are reported by the
+ * calling thread once all of the scans have been encoded.
+ */
+
+#define SCAN_BUFFER_INITIAL_SIZE  65536
+
+typedef struct phuff_scan_task {
+  struct jpeg_compress_struct cinfo;  /* private copy (must be first) */
+  struct jpeg_comp_master master;     /* private copy */
+  struct jpeg_error_mgr err;          /* private copy */
+  struct jpeg_destination_mgr dest;   /* private memory destination */
+  phuff_entropy_encoder entropy;      /* private entropy encoder */
+  c_deferred_gather layout;           /* location of each MCU's DCT blocks */
+  jmp_buf *setjmp_buffer;             /* worker thread's starting point */
+  boolean failed;                     /* TRUE if an error occurred */
+  JOCTET *buffer;                     /* entropy-coded data for the scan */
+  size_t buffer_size;                 /* allocated size of buffer */
+} phuff_scan_task;
+
+
+/*
+ * Initialize for a pass that records the layout of a scan.
+ */
+
+METHODDEF(boolean) encode_mcu_record(j_compress_ptr cinfo,
+                                     JBLOCKROW *MCU_data);
+METHODDEF(void) finish_pass_record(j_compress_ptr cinfo);
+
+LOCAL(void)
+start_pass_record(j_compress_ptr cinfo)
+{
+  phuff_entropy_ptr entropy = (phuff_entropy_ptr)cinfo->entropy;
+  phuff_scan_task *task;
+  size_t num_blocks =
+    (size_t)cinfo->MCU_rows_in_scan * cinfo->blocks_in_MCU;
+
+  if (entropy->scan_tasks == NULL) {
+    entropy->scan_tasks = (phuff_scan_task *)
+      (*cinfo->mem->alloc_large) ((j_common_ptr)cinfo, JPOOL_IMAGE,
+                                  cinfo->num_scans * sizeof(phuff_scan_task));
+    entropy->num_recorded_scans = 0;
+  }
+  if (entropy->num_recorded_scans >= cinfo->num_scans)
+    ERREXIT(cinfo, JERR_BAD_BUFFER_MODE);
+  task = &entropy->scan_tasks[entropy->num_recorded_scans];
+
+  task->layout.row_blocks = (JBLOCKROW *)
+    (*cinfo->mem->alloc_large) ((j_common_ptr)cinfo, JPOOL_IMAGE,
+                                num_blocks * sizeof(JBLOCKROW));
+  task->layout.max_blocks = num_blocks;
+  task->layout.num_MCUs = 0;
+  task->layout.num_threads = 0;
+
+  entropy->pub.encode_mcu = encode_mcu_record;
+  entropy->pub.finish_pass = finish_pass_record;
+}
+
+
+/*
+ * Record the location of one MCU's DCT blocks.
+ */
+
+METHODDEF(boolean)
+encode_mcu_record(j_compress_ptr cinfo, JBLOCKROW *MCU_data)
+{
+  phuff_entropy_ptr entropy = (phuff_entropy_ptr)cinfo->entropy;
+  phuff_scan_task *task = &entropy->scan_tasks[entropy->num_recorded_scans];
+
+  /* jccoefct.c always supplies the DCT blocks in the expected layout. */
+  if (!jpeg_defer_mcu(cinfo, &task->layout, MCU_data))
+    ERREXIT(cinfo, JERR_BAD_BUFFER_MODE);
+
+  return TRUE;
+}
+
+
+/*
+ * Proxy methods for the private copies of the compression object
+ */
+
+METHODDEF(void)
+scan_error_exit(j_common_ptr cinfo)
+{
+  phuff_scan_task *task = (phuff_scan_task *)cinfo;
+
+  longjmp(*task->setjmp_buffer, 1);
+}
+
+METHODDEF(void)
+scan_emit_message(j_common_ptr cinfo, int msg_level)
+{
+  /* Warnings and trace messages are not reported from worker threads. */
+}
+
+METHODDEF(boolean)
+scan_empty_output_buffer(j_compress_ptr cinfo)
+{
+  phuff_scan_task *task = (phuff_scan_task *)cinfo;
+  JOCTET *buffer;
+
+  buffer = (JOCTET *)realloc(task->buffer, task->buffer_size * 2);
+  if (buffer == NULL)
+    ERREXIT1(cinfo, JERR_OUT_OF_MEMORY, 10);
+
+  task->buffer = buffer;
+  task->dest.next_output_byte = buffer + task->buffer_size;
+  task->dest.free_in_buffer = task->buffer_size;
+  task->buffer_size *= 2;
+  return TRUE;
+}
+
+
+/*
+ * Set up the private copy of the compression object for the scan whose layout
+ * was just recorded.  This is called by the calling thread.
+ */
+
+LOCAL(void)
+setup_scan_task(j_compress_ptr cinfo, phuff_scan_task *task)
+{
+  j_compress_ptr tinfo = &task->cinfo;
+  phuff_entropy_ptr tentropy = &task->entropy;
+  jpeg_component_info *comp_info;
+  JHUFF_TBL **htblptr;
+  int ci, tbl;
+
+  /* Copy the per-scan parameters, which jcmaster.c will change for the next
+   * scan.  per_scan_setup() also stores MCU dimensions in the component info,
+   * so each scan needs its own copy of that as well.
+   */
+  *tinfo = *cinfo;
+  comp_info = (jpeg_component_info *)
+    (*cinfo->mem->alloc_small) ((j_common_ptr)cinfo, JPOOL_IMAGE,
+                                cinfo->num_components *
+                                sizeof(jpeg_component_info));
+  memcpy(comp_info, cinfo->comp_info,
+         cinfo->num_components * sizeof(jpeg_component_info));
+  tinfo->comp_info = comp_info;
+  for (ci = 0; ci < cinfo->comps_in_scan; ci++)
+    tinfo->cur_comp_info[ci] =
+      &comp_info[cinfo->cur_comp_info[ci]->component_index];
+  tinfo->progress = NULL;
+
+  /* The scan is encoded using a single thread. */
+  task->master = *cinfo->master;
+  task->master.gather_threads = 1;
+  task->master.parallel_scans = FALSE;
+  tinfo->master = &task->master;
+
+  task->err = *cinfo->err;
+  task->err.error_exit = scan_error_exit;
+  task->err.emit_message = scan_emit_message;
+
+  task->dest.next_output_byte = NULL;
+  task->dest.free_in_buffer = 0;
+  task->dest.init_destination = NULL;
+  task->dest.empty_output_buffer = scan_empty_output_buffer;
+  task->dest.term_destination = NULL;
+  tinfo->dest = &task->dest;
+  task->buffer = NULL;
+  task->failed = FALSE;
+
+  /* Set up the private entropy encoder for statistics gathering.  This
+   * allocates the statistics tables and any correction bit buffer.
+   */
+  memset(tentropy, 0, sizeof(phuff_entropy_encoder));
+  tentropy->pub.start_pass = start_pass_phuff;
+  tinfo->entropy = (struct jpeg_entropy_encoder *)tentropy;
+  start_pass_phuff(tinfo, TRUE);
+
+  /* Allocate private Huffman tables and derived tables, so that the worker
+   * thread need not allocate them.
+   */
+  for (tbl = 0; tbl < NUM_HUFF_TBLS; tbl++)
+    tinfo->dc_huff_tbl_ptrs[tbl] = tinfo->ac_huff_tbl_ptrs[tbl] = NULL;
+  for (ci = 0; ci < tinfo->comps_in_scan; ci++) {
+    if (tinfo->Ss == 0) {
+      if (tinfo->Ah != 0)       /* DC refinement needs no table */
+        continue;
+      tbl = tinfo->cur_comp_info[ci]->dc_tbl_no;
+      htblptr = &tinfo->dc_huff_tbl_ptrs[tbl];
+    } else {
+      tbl = tinfo->cur_comp_info[ci]->ac_tbl_no;
+      htblptr = &tinfo->ac_huff_tbl_ptrs[tbl];
+    }
+    if (*htblptr == NULL) {
+      *htblptr = (JHUFF_TBL *)
+        (*cinfo->mem->alloc_small) ((j_common_ptr)cinfo, JPOOL_IMAGE,
+                                    sizeof(JHUFF_TBL));
+      (*htblptr)->sent_table = FALSE;
+    }
+    if (tentropy->derived_tbls[tbl] == NULL)
+      tentropy->derived_tbls[tbl] = (c_derived_tbl *)
+        (*cinfo->mem->alloc_small) ((j_common_ptr)cinfo, JPOOL_IMAGE,
+                                    sizeof(c_derived_tbl));
+  }
+}
+
+
+/*
+ * Encode one scan into a private memory buffer.  This is called by a worker
+ * thread.
+ */
+
+METHODDEF(void)
+encode_scan(void *arg)
+{
+  phuff_scan_task *task = (phuff_scan_task *)arg;
+  j_compress_ptr cinfo = &task->cinfo;
+  jmp_buf setjmp_buffer;
+  JBLOCKROW MCU_data[C_MAX_BLOCKS_IN_MCU];
+  JDIMENSION MCU_num;
+
+  cinfo->err = &task->err;
+  task->setjmp_buffer = &setjmp_buffer;
+  if (setjmp(setjmp_buffer)) {
+    free(task->buffer);
+    task->buffer = NULL;
+    task->failed = TRUE;
+    return;
+  }
+
+  /* Gather statistics and generate optimal Huffman tables (DC refinement
+   * scans need no tables.)
+   */
+  if (cinfo->Ss != 0 || cinfo->Ah == 0) {
+    for (MCU_num = 0; MCU_num < task->layout.num_MCUs; MCU_num++) {
+      jpeg_get_deferred_mcu(cinfo, &task->layout, MCU_num, MCU_data);
+      (*cinfo->entropy->encode_mcu) (cinfo, MCU_data);
+    }
+    (*cinfo->entropy->finish_pass) (cinfo);
+  }
+
+  /* Encode the scan */
+  task->buffer = (JOCTET *)malloc(SCAN_BUFFER_INITIAL_SIZE);
+  if (task->buffer == NULL)
+    ERREXIT1(cinfo, JERR_OUT_OF_MEMORY, 10);
+  task->buffer_size = SCAN_BUFFER_INITIAL_SIZE;
+  task->dest.next_output_byte = task->buffer;
+  task->dest.free_in_buffer = task->buffer_size;
+  start_pass_phuff(cinfo, FALSE);
+  for (MCU_num = 0; MCU_num < task->layout.num_MCUs; MCU_num++) {
+    jpeg_get_deferred_mcu(cinfo, &task->layout, MCU_num, MCU_data);
+    (*cinfo->entropy->encode_mcu) (cinfo, MCU_data);
+  }
+  (*cinfo->entropy->finish_pass) (cinfo);
+}
+
+
+LOCAL(void)
+free_scan_buffers(phuff_entropy_ptr entropy)
+{
+  int s;
+
+  for (s = 0; s < entropy->num_recorded_scans; s++) {
+    free(entropy->scan_tasks[s].buffer);
+    entropy->scan_tasks[s].buffer = NULL;
+  }
+}
+
+
+/* Proxy error handler, which is installed while the scans are being written.
+ * The application's error_exit() method may not return, so the scan buffers
+ * must be freed before it is called.
+ */
+
+METHODDEF(void)
+write_scans_error_exit(j_common_ptr cinfo)
+{
+  phuff_entropy_ptr entropy =
+    (phuff_entropy_ptr)((j_compress_ptr)cinfo)->entropy;
+  j_compress_ptr main_cinfo = entropy->cinfo;
+
+  free_scan_buffers(entropy);
+  main_cinfo->err->error_exit = entropy->error_exit;
+  (*main_cinfo->err->error_exit) ((j_common_ptr)main_cinfo);
+}
+
+
+/*
+ * Encode all of the recorded scans in parallel, and write the frame header
+ * and the scans to the data destination.
+ */
+
+LOCAL(void)
+encode_scans(j_compress_ptr cinfo)
+{
+  phuff_entropy_ptr entropy = (phuff_entropy_ptr)cinfo->entropy;
+  struct jpeg_destination_mgr *dest = cinfo->dest;
+  int num_threads = cinfo->master->num_threads ?
+                    cinfo->master->num_threads : jthread_num_cpus();
+  int s, tbl;
+
+  jthread_run(num_threads, encode_scan, entropy->scan_tasks,
+              sizeof(phuff_scan_task), entropy->num_recorded_scans);
+
+  for (s = 0; s < entropy->num_recorded_scans; s++) {
+    phuff_scan_task *task = &entropy->scan_tasks[s];
+
+    if (task->failed) {
+      free_scan_buffers(entropy);
+      cinfo->err->msg_code = task->err.msg_code;
+      cinfo->err->msg_parm = task->err.msg_parm;
+      (*cinfo->err->error_exit) ((j_common_ptr)cinfo);
+    }
+  }
+
+  entropy->error_exit = cinfo->err->error_exit;
+  cinfo->err->error_exit = write_scans_error_exit;
+
+  (*cinfo->marker->write_frame_header) (cinfo);
+  for (s = 0; s < entropy->num_recorded_scans; s++) {
+    phuff_scan_task *task = &entropy->scan_tasks[s];
+    j_compress_ptr tinfo = &task->cinfo;
+    const JOCTET *data = task->buffer;
+    size_t size = task->buffer_size - task->dest.free_in_buffer, n;
+
+    /* Write the scan header (including the scan's Huffman tables) */
+    tinfo->err = cinfo->err;
+    tinfo->dest = dest;
+    tinfo->entropy = cinfo->entropy;
+    (*cinfo->marker->write_scan_header) (tinfo);
+
+    /* Write the entropy-coded data */
+    while (size > 0) {
+      n = MIN(size, dest->free_in_buffer);
+      memcpy(dest->next_output_byte, data, n);
+      dest->next_output_byte += n;
+      dest->free_in_buffer -= n;
+      data += n;
+      size -= n;
+      if (dest->free_in_buffer == 0 && !(*dest->empty_output_buffer) (cinfo))
+        ERREXIT(cinfo, JERR_CANT_SUSPEND);
+    }
+    free(task->buffer);
+    task->buffer = NULL;
+
+    /* Leave the same Huffman tables in the compression object as serial
+     * encoding would.
+     */
+    for (tbl = 0; tbl < NUM_HUFF_TBLS; tbl++) {
+      if (tinfo->dc_huff_tbl_ptrs[tbl] != NULL) {
+        if (cinfo->dc_huff_tbl_ptrs[tbl] == NULL)
+          cinfo->dc_huff_tbl_ptrs[tbl] =
+            jpeg_alloc_huff_table((j_common_ptr)cinfo);
+        *cinfo->dc_huff_tbl_ptrs[tbl] = *tinfo->dc_huff_tbl_ptrs[tbl];
+      }
+      if (tinfo->ac_huff_tbl_ptrs[tbl] != NULL) {
+        if (cinfo->ac_huff_tbl_ptrs[tbl] == NULL)
+          cinfo->ac_huff_tbl_ptrs[tbl] =
+            jpeg_alloc_huff_table((j_common_ptr)cinfo);
+        *cinfo->ac_huff_tbl_ptrs[tbl] = *tinfo->ac_huff_tbl_ptrs[tbl];
+      }
+    }
+  }
+
+  cinfo->err->error_exit = entropy->error_exit;
+}
+
+
+/*
+ * Finish up a pass that records the layout of a scan.
+ */
+
+METHODDEF(void)
+finish_pass_record(j_compress_ptr cinfo)
+{
+  phuff_entropy_ptr entropy = (phuff_entropy_ptr)cinfo->entropy;
+
+  setup_scan_task(cinfo, &entropy->scan_tasks[entropy->num_recorded_scans]);
+  entropy->num_recorded_scans++;
+
+  if (cinfo->master->is_last_pass)
+    encode_scans(cinfo);
+}
+
+
 /*
  * Module initialization routine for progressive Huffman entropy encoding.
  */
@@ -1094,6 +1802,12 @@ jinit_phuff_encoder(j_compress_ptr cinfo)
     entropy->count_ptrs[i] = NULL;
   }
   entropy->bit_buffer = NULL;   /* needed only in AC refinement scan */
+  entropy->gather.row_blocks = NULL;
+  entropy->gather.num_threads = 0;
+  entropy->gather_tasks = NULL;
+  entropy->record_scans = cinfo->master->parallel_scans;
+  entropy->scan_tasks = NULL;
+  entropy->num_recorded_scans = 0;
 }
 
 #endif /* C_PROGRESSIVE_SUPPORTED */
@@ -517,9 +517,9 @@ _jinit_downsampler(j_compress_ptr cinfo)
 #ifdef INPUT_SMOOTHING_SUPPORTED
       smoothok = FALSE;
 #endif
-#ifdef WITH_SIMD
-      if (jsimd_set_h2v1_downsample(cinfo))
-        downsample->methods[ci] = jsimd_h2v1_downsample;
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE != 16
+      if (_jsimd_set_h2v1_downsample(cinfo))
+        downsample->methods[ci] = _jsimd_h2v1_downsample;
       else
 #endif
         downsample->methods[ci] = h2v1_downsample;
@@ -532,9 +532,9 @@ _jinit_downsampler(j_compress_ptr cinfo)
       } else
 #endif
       {
-#ifdef WITH_SIMD
-        if (jsimd_set_h2v2_downsample(cinfo))
-          downsample->methods[ci] = jsimd_h2v2_downsample;
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE != 16
+        if (_jsimd_set_h2v2_downsample(cinfo))
+          downsample->methods[ci] = _jsimd_h2v2_downsample;
         else
 #endif
           downsample->methods[ci] = h2v2_downsample;
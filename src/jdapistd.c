@@ -40,6 +40,45 @@
 LOCAL(boolean) output_pass_setup(j_decompress_ptr cinfo);
 
 
+#ifdef D_MULTISCAN_FILES_SUPPORTED
+
+/*
+ * Determine whether the remaining scans of a progressive JPEG image can be
+ * skipped (see the skip_tail_scans field in struct jpeg_decomp_master.)  This
+ * is called after each scan is completed.
+ */
+
+LOCAL(boolean)
+tail_scans_unused(j_decompress_ptr cinfo)
+{
+  int ci, coefi;
+  jpeg_component_info *compptr;
+
+  if (!cinfo->master->skip_tail_scans || !cinfo->progressive_mode ||
+      cinfo->coef_bits == NULL)
+    return FALSE;
+
+  for (ci = 0, compptr = cinfo->comp_info; ci < cinfo->num_components;
+       ci++, compptr++) {
+    if (!compptr->component_needed)
+      continue;
+    if (compptr->_DCT_scaled_size != 1 || cinfo->coef_bits[ci][0] != 0)
+      return FALSE;
+    /* Refer to the computation of change_dc in decompress_smooth_data() */
+    for (coefi = 1; coefi <= 9; coefi++) {
+      if (cinfo->coef_bits[ci][coefi] != -1)
+        break;
+    }
+    if (coefi > 9)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+#endif
+
+
 /*
  * Decompression initialization.
  * jpeg_read_header must be completed before calling this.
@@ -65,8 +104,24 @@ jpeg_start_decompress(j_decompress_ptr cinfo)
     cinfo->global_state = DSTATE_PRELOAD;
   }
   if (cinfo->global_state == DSTATE_PRELOAD) {
-    /* If file has multiple scans, absorb them all into the coef buffer */
-    if (cinfo->inputctl->has_multiple_scans) {
+    if (cinfo->master->coef_source != NULL) {
+      /* All scans have already been absorbed into the coef buffer of another
+       * decompression object, which we share.  Adopt the state that the
+       * output side needs from that object, and skip the rest of the input.
+       */
+      j_decompress_ptr source = cinfo->master->coef_source;
+      int ci;
+
+      for (ci = 0; ci < cinfo->num_components; ci++)
+        cinfo->comp_info[ci].quant_table = source->comp_info[ci].quant_table;
+      cinfo->coef_bits = source->coef_bits;
+      cinfo->master->last_good_iMCU_row = source->master->last_good_iMCU_row;
+      cinfo->input_scan_number = source->input_scan_number;
+      cinfo->input_iMCU_row = source->input_iMCU_row;
+      (*cinfo->inputctl->finish_input_pass) (cinfo);
+      cinfo->inputctl->eoi_reached = TRUE;
+    } else if (cinfo->inputctl->has_multiple_scans) {
+      /* If file has multiple scans, absorb them all into the coef buffer */
 #ifdef D_MULTISCAN_FILES_SUPPORTED
       for (;;) {
         int retcode;
@@ -79,6 +134,13 @@ jpeg_start_decompress(j_decompress_ptr cinfo)
           return FALSE;
         if (retcode == JPEG_REACHED_EOI)
           break;
+        if (retcode == JPEG_SCAN_COMPLETED && tail_scans_unused(cinfo)) {
+          /* Pretend that we have reached EOI, so that neither the output
+           * pass nor jpeg_finish_decompress() reads any more input.
+           */
+          cinfo->inputctl->eoi_reached = TRUE;
+          break;
+        }
         /* Advance progress counter if appropriate */
         if (cinfo->progress != NULL &&
             (retcode == JPEG_ROW_COMPLETED || retcode == JPEG_REACHED_SOS)) {
@@ -100,6 +162,24 @@ jpeg_start_decompress(j_decompress_ptr cinfo)
 }
 
 
+/*
+ * Enable or disable pipelined decompression.  This may be called at any time
+ * prior to jpeg_start_decompress(), and the setting persists across images
+ * decompressed using the same object.
+ */
+
+GLOBAL(void)
+jpeg_set_pipelining(j_decompress_ptr cinfo, boolean enable)
+{
+  if (cinfo->global_state != DSTATE_START &&
+      cinfo->global_state != DSTATE_INHEADER &&
+      cinfo->global_state != DSTATE_READY)
+    ERREXIT1(cinfo, JERR_BAD_STATE, cinfo->global_state);
+
+  cinfo->master->pipelined = enable;
+}
+
+
 /*
  * Set up for an output pass, and perform any dummy pass(es) needed.
  * Common subroutine for jpeg_start_decompress and jpeg_start_output.
@@ -359,7 +439,10 @@ _jpeg_read_scanlines(j_decompress_ptr cinfo, _JSAMPARRAY scanlines,
   row_ctr = 0;
   if (cinfo->main->_process_data == NULL)
     ERREXIT1(cinfo, JERR_BAD_PRECISION, cinfo->data_precision);
-  (*cinfo->main->_process_data) (cinfo, scanlines, &row_ctr, max_lines);
+#if BITS_IN_JSAMPLE != 16
+  if (!_jread_scanlines_pipelined(cinfo, scanlines, &row_ctr, max_lines))
+#endif
+    (*cinfo->main->_process_data) (cinfo, scanlines, &row_ctr, max_lines);
   cinfo->output_scanline += row_ctr;
   return row_ctr;
 #else
@@ -629,6 +712,13 @@ _jpeg_skip_scanlines(j_decompress_ptr cinfo, JDIMENSION num_lines)
 
   /* Skip the iMCU rows that we can safely skip. */
   for (i = 0; i < lines_to_skip; i += lines_per_iMCU_row) {
+    /* In pipelined mode, some of the iMCU rows may have already been
+     * entropy-decoded.  Those rows need only be discarded.
+     */
+    if (cinfo->input_iMCU_row > cinfo->output_iMCU_row) {
+      cinfo->output_iMCU_row++;
+      continue;
+    }
     for (y = 0; y < coef->MCU_rows_per_iMCU_row; y++) {
       for (x = 0; x < cinfo->MCUs_per_row; x++) {
         /* Calling decode_mcu() with a NULL pointer causes it to discard the
@@ -5,7 +5,7 @@
  * Copyright (C) 1994-1996, Thomas G. Lane.
  * Modified 2009-2011 by Guido Vollbeding.
  * libjpeg-turbo Modifications:
- * Copyright (C) 2013, 2016, 2022, D. R. Commander.
+ * Copyright (C) 2013, 2016, 2022, 2026, D. R. Commander.
  * For conditions of distribution and use, see the accompanying README.ijg
  * file.
  *
@@ -18,10 +18,16 @@
  * than 8 bits on your machine, you may need to do some tweaking.
  */
 
-/* this is not a core library module, so it doesn't define JPEG_INTERNALS */
+/* this is not a core library module, but jpeg_mmap_src() needs to register a
+   cleanup method with the decompression master, so we define JPEG_INTERNALS */
+#define JPEG_INTERNALS
 #include "jinclude.h"
 #include "jpeglib.h"
 #include "jerror.h"
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 
 /* Expanded data source object for stdio input */
@@ -39,6 +45,19 @@ typedef my_source_mgr *my_src_ptr;
 #define INPUT_BUF_SIZE  4096    /* choose an efficiently fread'able size */
 
 
+/* Expanded data source object for memory-mapped file input */
+
+typedef struct {
+  my_source_mgr stdio;          /* stdio source (used if the file cannot be
+                                   mapped) */
+
+  void *map_addr;               /* start of file mapping, or NULL if none */
+  size_t map_size;              /* size of file mapping */
+} my_mmap_source_mgr;
+
+typedef my_mmap_source_mgr *my_mmap_src_ptr;
+
+
 /*
  * Initialize source --- called by jpeg_read_header
  * before any data is actually read.
@@ -62,6 +81,12 @@ init_mem_source(j_decompress_ptr cinfo)
   /* no work necessary here */
 }
 
+METHODDEF(void)
+init_mmap_source(j_decompress_ptr cinfo)
+{
+  init_source(cinfo);
+}
+
 
 /*
  * Fill the input buffer --- called whenever buffer is emptied.
@@ -129,8 +154,9 @@ fill_mem_input_buffer(j_decompress_ptr cinfo)
   };
 
   /* The whole JPEG data is expected to reside in the supplied memory
-   * buffer, so any request for more data beyond the given buffer size
-   * is treated as an error.
+   * buffer (or file mapping), so any request for more data beyond the given
+   * buffer size is treated as an error.  This is how truncated JPEG files are
+   * handled when memory-mapped.
    */
   WARNMS(cinfo, JWRN_JPEG_EOF);
 
@@ -203,6 +229,29 @@ term_source(j_decompress_ptr cinfo)
 }
 
 
+#ifdef HAVE_MMAP
+
+/*
+ * Release the file mapping --- called by jpeg_destroy, or by jpeg_mmap_src
+ * before it maps another file.  The mapping is not released by term_source,
+ * because a series of JPEG images may be read from the same file.
+ */
+
+METHODDEF(void)
+release_mmap_source(j_decompress_ptr cinfo)
+{
+  my_mmap_src_ptr src = (my_mmap_src_ptr)cinfo->src;
+
+  if (src->map_addr != NULL) {
+    munmap(src->map_addr, src->map_size);
+    src->map_addr = NULL;
+    src->map_size = 0;
+  }
+}
+
+#endif
+
+
 /*
  * Prepare for input from a stdio stream.
  * The caller must have already opened the stream, and is responsible
@@ -287,3 +336,86 @@ jpeg_mem_src(j_decompress_ptr cinfo, const unsigned char *inbuffer,
   src->bytes_in_buffer = (size_t)insize;
   src->next_input_byte = (const JOCTET *)inbuffer;
 }
+
+
+/*
+ * Prepare for input from a memory-mapped file.
+ * The caller must have already opened the file, and is responsible for
+ * closing it after finishing decompression.  The file is mapped read-only from the current file
+ * position to the end of the file, and the whole mapping is passed to the
+ * decompressor as one buffer, so no data is copied.  The mapping is released
+ * when this function is called again or when the JPEG object is destroyed.
+ * If the file cannot be mapped (for instance, because it is a pipe or because
+ * memory-mapped I/O is not supported on this platform), then the file is read
+ * using stdio, as with jpeg_stdio_src().
+ */
+
+GLOBAL(void)
+jpeg_mmap_src(j_decompress_ptr cinfo, FILE *infile)
+{
+  my_mmap_src_ptr src;
+#ifdef HAVE_MMAP
+  struct stat st;
+  long offset;
+  void *map_addr;
+#endif
+
+  if (cinfo->src == NULL) {     /* first time for this JPEG object? */
+    cinfo->src = (struct jpeg_source_mgr *)
+      (*cinfo->mem->alloc_small) ((j_common_ptr)cinfo, JPOOL_PERMANENT,
+                                  sizeof(my_mmap_source_mgr));
+    src = (my_mmap_src_ptr)cinfo->src;
+    src->stdio.buffer = (JOCTET *)
+      (*cinfo->mem->alloc_small) ((j_common_ptr)cinfo, JPOOL_PERMANENT,
+                                  INPUT_BUF_SIZE * sizeof(JOCTET));
+    src->map_addr = NULL;
+    src->map_size = 0;
+  } else if (cinfo->src->init_source != init_mmap_source) {
+    /* It is unsafe to reuse the existing source manager unless it was created
+     * by this function.
+     */
+    ERREXIT(cinfo, JERR_BUFFER_SIZE);
+  }
+
+  src = (my_mmap_src_ptr)cinfo->src;
+#ifdef HAVE_MMAP
+  release_mmap_source(cinfo);
+#endif
+  src->stdio.pub.init_source = init_mmap_source;
+  src->stdio.pub.fill_input_buffer = fill_input_buffer;
+  src->stdio.pub.skip_input_data = skip_input_data;
+  src->stdio.pub.resync_to_restart = jpeg_resync_to_restart;
+  src->stdio.pub.term_source = term_source;
+  src->stdio.infile = infile;
+  src->stdio.pub.bytes_in_buffer = 0;
+  src->stdio.pub.next_input_byte = NULL;
+
+#ifdef HAVE_MMAP
+  /* Only regular files can be mapped.  If the file is empty (or the file
+   * position is at the end of the file), then we fall back to stdio so that
+   * the usual "empty input file" error is generated.
+   */
+  if (fstat(fileno(infile), &st) < 0 || !S_ISREG(st.st_mode) ||
+      (offset = ftell(infile)) < 0 || st.st_size <= (off_t)offset ||
+      (off_t)(size_t)st.st_size != st.st_size)
+    return;
+
+  map_addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE,
+                  fileno(infile), 0);
+  if (map_addr == MAP_FAILED)
+    return;
+#ifdef MADV_SEQUENTIAL
+  /* The decompressor reads the data front to back, so the kernel can read
+   * ahead aggressively and discard pages behind the read position.
+   */
+  madvise(map_addr, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+
+  src->map_addr = map_addr;
+  src->map_size = (size_t)st.st_size;
+  src->stdio.pub.fill_input_buffer = fill_mem_input_buffer;
+  src->stdio.pub.next_input_byte = (const JOCTET *)map_addr + offset;
+  src->stdio.pub.bytes_in_buffer = (size_t)(st.st_size - offset);
+  cinfo->master->release_source = release_mmap_source;
+#endif
+}
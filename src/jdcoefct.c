@@ -39,6 +39,12 @@ LOCAL(boolean) smoothing_ok(j_decompress_ptr cinfo);
 METHODDEF(int) decompress_smooth_data(j_decompress_ptr cinfo,
                                       _JSAMPIMAGE output_buf);
 #endif
+#ifdef PIPELINE_SUPPORTED
+METHODDEF(int) decompress_pipelined(j_decompress_ptr cinfo,
+                                    _JSAMPIMAGE output_buf);
+
+#define PIPELINE_ROWS  4        /* # of iMCU rows in the coefficient ring */
+#endif
 
 
 /*
@@ -48,6 +54,24 @@ METHODDEF(int) decompress_smooth_data(j_decompress_ptr cinfo,
 METHODDEF(void)
 start_input_pass(j_decompress_ptr cinfo)
 {
+#ifdef PIPELINE_SUPPORTED
+  my_coef_ptr coef = (my_coef_ptr)cinfo->coef;
+
+  /* The size of the coefficient ring depends on the scan parameters, so we
+   * cannot allocate it until now.
+   */
+  if (coef->pub._decompress_data == decompress_pipelined &&
+      coef->ring == NULL) {
+    coef->ring_row_blocks =
+      (size_t)cinfo->MCUs_per_row * cinfo->blocks_in_MCU;
+    if (cinfo->comps_in_scan == 1)
+      coef->ring_row_blocks *= cinfo->cur_comp_info[0]->v_samp_factor;
+    coef->ring = (JBLOCKROW)
+      (*cinfo->mem->alloc_large) ((j_common_ptr)cinfo, JPOOL_IMAGE,
+                                  PIPELINE_ROWS * coef->ring_row_blocks *
+                                  sizeof(JBLOCK));
+  }
+#endif
   cinfo->input_iMCU_row = 0;
   start_iMCU_row(cinfo);
 }
@@ -96,22 +120,34 @@ decompress_onepass(j_decompress_ptr cinfo, _JSAMPIMAGE output_buf)
   _JSAMPARRAY output_ptr;
   JDIMENSION start_col, output_col;
   jpeg_component_info *compptr;
-  _inverse_DCT_method_ptr inverse_DCT;
+  _inverse_DCT_method_ptr inverse_DCT, inverse_DCT_dconly, inverse_DCT_sparse;
+  _inverse_DCT_method_ptr block_DCT;
+  int *last_nonzero = cinfo->entropy->last_nonzero;
 
   /* Loop to process as much as one whole iMCU row */
   for (yoffset = coef->MCU_vert_offset; yoffset < coef->MCU_rows_per_iMCU_row;
        yoffset++) {
     for (MCU_col_num = coef->MCU_ctr; MCU_col_num <= last_MCU_col;
          MCU_col_num++) {
+      /* MCUs outside of the cropping region (see jpeg_crop_scanline()) must
+       * still be entropy-decoded in order to advance the bit reader and the DC
+       * predictions, but calling decode_mcu() with a NULL pointer causes it to
+       * discard the decoded coefficients rather than storing them.
+       */
+      boolean in_crop = (MCU_col_num >= cinfo->master->first_iMCU_col &&
+                         MCU_col_num <= cinfo->master->last_iMCU_col);
+
       /* Try to fetch an MCU.  Entropy decoder expects buffer to be zeroed. */
-      jzero_far((void *)coef->MCU_buffer[0],
-                (size_t)(cinfo->blocks_in_MCU * sizeof(JBLOCK)));
+      if (in_crop)
+        jzero_far((void *)coef->MCU_buffer[0],
+                  (size_t)(cinfo->blocks_in_MCU * sizeof(JBLOCK)));
       if (!cinfo->entropy->insufficient_data)
         cinfo->master->last_good_iMCU_row = cinfo->input_iMCU_row;
 #ifdef WITH_PROFILE
       cinfo->master->start = getTime();
 #endif
-      if (!(*cinfo->entropy->decode_mcu) (cinfo, coef->MCU_buffer)) {
+      if (!(*cinfo->entropy->decode_mcu) (cinfo,
+                                          in_crop ? coef->MCU_buffer : NULL)) {
         /* Suspension forced; update state counters and exit */
         coef->MCU_vert_offset = yoffset;
         coef->MCU_ctr = MCU_col_num;
@@ -131,8 +167,7 @@ decompress_onepass(j_decompress_ptr cinfo, _JSAMPIMAGE output_buf)
       /* Only perform the IDCT on blocks that are contained within the desired
        * cropping region.
        */
-      if (MCU_col_num >= cinfo->master->first_iMCU_col &&
-          MCU_col_num <= cinfo->master->last_iMCU_col) {
+      if (in_crop) {
         /* Determine where data should go in output_buf and do the IDCT thing.
          * We skip dummy blocks at the right and bottom edges (but blkn gets
          * incremented past them!).  Note the inner loop relies on having
@@ -147,6 +182,10 @@ decompress_onepass(j_decompress_ptr cinfo, _JSAMPIMAGE output_buf)
             continue;
           }
           inverse_DCT = cinfo->idct->_inverse_DCT[compptr->component_index];
+          inverse_DCT_dconly =
+            cinfo->idct->_inverse_DCT_dconly[compptr->component_index];
+          inverse_DCT_sparse =
+            cinfo->idct->_inverse_DCT_sparse[compptr->component_index];
           useful_width = (MCU_col_num < last_MCU_col) ?
                          compptr->MCU_width : compptr->last_col_width;
           output_ptr = output_buf[compptr->component_index] +
@@ -161,9 +200,20 @@ decompress_onepass(j_decompress_ptr cinfo, _JSAMPIMAGE output_buf)
 #ifdef WITH_PROFILE
                 cinfo->master->start = getTime();
 #endif
-                (*inverse_DCT) (cinfo, compptr,
-                                (JCOEFPTR)coef->MCU_buffer[blkn + xindex],
-                                output_ptr, output_col);
+                /* If the entropy decoder told us where the last nonzero
+                 * coefficient in the block is, then use a faster IDCT method
+                 * for DC-only and sparse blocks.
+                 */
+                if (last_nonzero == NULL ||
+                    last_nonzero[blkn + xindex] >= IDCT_SPARSE_COEFS)
+                  block_DCT = inverse_DCT;
+                else if (last_nonzero[blkn + xindex] == 0)
+                  block_DCT = inverse_DCT_dconly;
+                else
+                  block_DCT = inverse_DCT_sparse;
+                (*block_DCT) (cinfo, compptr,
+                              (JCOEFPTR)coef->MCU_buffer[blkn + xindex],
+                              output_ptr, output_col);
 #ifdef WITH_PROFILE
                 cinfo->master->idct_elapsed +=
                   getTime() - cinfo->master->start;
@@ -193,6 +243,373 @@ decompress_onepass(j_decompress_ptr cinfo, _JSAMPIMAGE output_buf)
 }
 
 
+#ifdef PIPELINE_SUPPORTED
+
+/*
+ * Entropy-decode one iMCU row into the coefficient ring (input side of
+ * pipelined mode.)  The caller must ensure that the ring has room for the
+ * row.  Return value is JPEG_ROW_COMPLETED, JPEG_SCAN_COMPLETED, or
+ * JPEG_SUSPENDED.
+ */
+
+LOCAL(int)
+decode_iMCU_row(j_decompress_ptr cinfo)
+{
+  my_coef_ptr coef = (my_coef_ptr)cinfo->coef;
+  JDIMENSION MCU_col_num;       /* index of current MCU within row */
+  JBLOCKROW row_buf = coef->ring +
+    (cinfo->input_iMCU_row % PIPELINE_ROWS) * coef->ring_row_blocks;
+  JBLOCKROW MCU_blocks;
+  int blkn, yoffset;
+
+  for (yoffset = coef->MCU_vert_offset; yoffset < coef->MCU_rows_per_iMCU_row;
+       yoffset++) {
+    for (MCU_col_num = coef->MCU_ctr; MCU_col_num < cinfo->MCUs_per_row;
+         MCU_col_num++) {
+      /* The output side inverse-transforms only the MCUs within the cropping
+       * region, so the others need not be stored (see decompress_onepass().)
+       */
+      boolean in_crop = (MCU_col_num >= cinfo->master->first_iMCU_col &&
+                         MCU_col_num <= cinfo->master->last_iMCU_col);
+
+      MCU_blocks = row_buf + ((size_t)yoffset * cinfo->MCUs_per_row +
+                              MCU_col_num) * cinfo->blocks_in_MCU;
+      for (blkn = 0; blkn < cinfo->blocks_in_MCU; blkn++)
+        coef->MCU_buffer[blkn] = MCU_blocks + blkn;
+      /* Try to fetch an MCU.  Entropy decoder expects buffer to be zeroed. */
+      if (in_crop)
+        jzero_far((void *)MCU_blocks,
+                  (size_t)(cinfo->blocks_in_MCU * sizeof(JBLOCK)));
+      if (!cinfo->entropy->insufficient_data)
+        cinfo->master->last_good_iMCU_row = cinfo->input_iMCU_row;
+      if (!(*cinfo->entropy->decode_mcu) (cinfo,
+                                          in_crop ? coef->MCU_buffer : NULL)) {
+        /* Suspension forced; update state counters and exit */
+        coef->MCU_vert_offset = yoffset;
+        coef->MCU_ctr = MCU_col_num;
+        return JPEG_SUSPENDED;
+      }
+    }
+    /* Completed an MCU row, but perhaps not an iMCU row */
+    coef->MCU_ctr = 0;
+  }
+
+  /* Completed the iMCU row; make it available to the output side */
+  if (coef->sync != NULL) {
+    jthread_lock(coef->sync);
+    cinfo->input_iMCU_row++;
+    jthread_broadcast(coef->sync);
+    jthread_unlock(coef->sync);
+  } else
+    cinfo->input_iMCU_row++;
+
+  if (cinfo->input_iMCU_row < cinfo->total_iMCU_rows) {
+    start_iMCU_row(cinfo);
+    return JPEG_ROW_COMPLETED;
+  }
+  /* Completed the scan */
+  (*cinfo->inputctl->finish_input_pass) (cinfo);
+  return JPEG_SCAN_COMPLETED;
+}
+
+
+/*
+ * Inverse-transform one iMCU row from the coefficient ring (output side of
+ * pipelined mode.)  This works like the IDCT loop in decompress_onepass().
+ */
+
+LOCAL(void)
+inverse_DCT_iMCU_row(j_decompress_ptr cinfo, JDIMENSION iMCU_row,
+                     _JSAMPIMAGE output_buf)
+{
+  my_coef_ptr coef = (my_coef_ptr)cinfo->coef;
+  JDIMENSION MCU_col_num;       /* index of current MCU within row */
+  JDIMENSION last_MCU_col = cinfo->MCUs_per_row - 1;
+  JDIMENSION last_iMCU_row = cinfo->total_iMCU_rows - 1;
+  JBLOCKROW row_buf = coef->ring +
+    (iMCU_row % PIPELINE_ROWS) * coef->ring_row_blocks;
+  JBLOCKROW MCU_blocks;
+  int MCU_rows, blkn, ci, xindex, yindex, yoffset, useful_width;
+  _JSAMPARRAY output_ptr;
+  JDIMENSION start_col, output_col;
+  jpeg_component_info *compptr;
+  _inverse_DCT_method_ptr inverse_DCT;
+
+  /* Same as MCU_rows_per_iMCU_row in start_iMCU_row(), but for this row */
+  if (cinfo->comps_in_scan > 1)
+    MCU_rows = 1;
+  else if (iMCU_row < last_iMCU_row)
+    MCU_rows = cinfo->cur_comp_info[0]->v_samp_factor;
+  else
+    MCU_rows = cinfo->cur_comp_info[0]->last_row_height;
+
+  for (yoffset = 0; yoffset < MCU_rows; yoffset++) {
+    for (MCU_col_num = cinfo->master->first_iMCU_col;
+         MCU_col_num <= cinfo->master->last_iMCU_col &&
+         MCU_col_num <= last_MCU_col; MCU_col_num++) {
+      MCU_blocks = row_buf + ((size_t)yoffset * cinfo->MCUs_per_row +
+                              MCU_col_num) * cinfo->blocks_in_MCU;
+      blkn = 0;                 /* index of current DCT block within MCU */
+      for (ci = 0; ci < cinfo->comps_in_scan; ci++) {
+        compptr = cinfo->cur_comp_info[ci];
+        /* Don't bother to IDCT an uninteresting component. */
+        if (!compptr->component_needed) {
+          blkn += compptr->MCU_blocks;
+          continue;
+        }
+        inverse_DCT = cinfo->idct->_inverse_DCT[compptr->component_index];
+        useful_width = (MCU_col_num < last_MCU_col) ?
+                       compptr->MCU_width : compptr->last_col_width;
+        output_ptr = output_buf[compptr->component_index] +
+                     yoffset * compptr->_DCT_scaled_size;
+        start_col = (MCU_col_num - cinfo->master->first_iMCU_col) *
+                    compptr->MCU_sample_width;
+        for (yindex = 0; yindex < compptr->MCU_height; yindex++) {
+          if (iMCU_row < last_iMCU_row ||
+              yoffset + yindex < compptr->last_row_height) {
+            output_col = start_col;
+            for (xindex = 0; xindex < useful_width; xindex++) {
+              (*inverse_DCT) (cinfo, compptr,
+                              (JCOEFPTR)(MCU_blocks + blkn + xindex),
+                              output_ptr, output_col);
+              output_col += compptr->_DCT_scaled_size;
+            }
+          }
+          blkn += compptr->MCU_width;
+          output_ptr += compptr->_DCT_scaled_size;
+        }
+      }
+    }
+  }
+}
+
+
+/*
+ * Decompress and return one iMCU row in pipelined mode.  When called from the
+ * reconstruction thread, this waits for the input side to decode the row.
+ * Otherwise, it decodes the row itself, unless the row was decoded ahead
+ * during a previous call to _jread_scanlines_pipelined().
+ * Return value is JPEG_ROW_COMPLETED, JPEG_SCAN_COMPLETED, or JPEG_SUSPENDED.
+ */
+
+METHODDEF(int)
+decompress_pipelined(j_decompress_ptr cinfo, _JSAMPIMAGE output_buf)
+{
+  my_coef_ptr coef = (my_coef_ptr)cinfo->coef;
+  JDIMENSION iMCU_row = cinfo->output_iMCU_row;
+
+  if (coef->sync != NULL) {
+    boolean row_ready;
+
+    jthread_lock(coef->sync);
+    while (cinfo->input_iMCU_row <= iMCU_row && !coef->input_stopped)
+      jthread_wait(coef->sync);
+    row_ready = (cinfo->input_iMCU_row > iMCU_row);
+    jthread_unlock(coef->sync);
+    if (!row_ready)
+      return JPEG_SUSPENDED;
+  } else if (cinfo->input_iMCU_row <= iMCU_row) {
+    if (decode_iMCU_row(cinfo) == JPEG_SUSPENDED)
+      return JPEG_SUSPENDED;
+  }
+
+  inverse_DCT_iMCU_row(cinfo, iMCU_row, output_buf);
+
+  /* Release the row's slot in the ring */
+  if (coef->sync != NULL) {
+    jthread_lock(coef->sync);
+    cinfo->output_iMCU_row++;
+    jthread_broadcast(coef->sync);
+    jthread_unlock(coef->sync);
+  } else
+    cinfo->output_iMCU_row++;
+
+  return iMCU_row < cinfo->total_iMCU_rows - 1 ?
+         JPEG_ROW_COMPLETED : JPEG_SCAN_COMPLETED;
+}
+
+
+/*
+ * Body of the reconstruction thread.  This runs the main controller, and thus
+ * the IDCT, upsampling, color conversion, and color quantization steps, until
+ * the requested number of scanlines has been produced or the input side stops.
+ * None of those steps can raise an error or emit a warning once an output
+ * pass has started, so the error manager is never called from this thread.
+ */
+
+METHODDEF(void)
+reconstruct_rows(void *arg)
+{
+  j_decompress_ptr cinfo = (j_decompress_ptr)arg;
+  my_coef_ptr coef = (my_coef_ptr)cinfo->coef;
+  JDIMENSION prev_row_ctr;
+
+  do {
+    prev_row_ctr = coef->worker_row_ctr;
+    (*cinfo->main->_process_data) (cinfo, coef->worker_buf,
+                                   &coef->worker_row_ctr,
+                                   coef->worker_rows_avail);
+  } while (coef->worker_row_ctr > prev_row_ctr &&
+           coef->worker_row_ctr < coef->worker_rows_avail);
+
+  jthread_lock(coef->sync);
+  coef->output_done = TRUE;
+  jthread_broadcast(coef->sync);
+  jthread_unlock(coef->sync);
+}
+
+
+/*
+ * Stop the reconstruction thread once it has consumed all of the iMCU rows
+ * that have been decoded, and restore the application's error handlers.
+ */
+
+LOCAL(void)
+stop_pipeline(j_decompress_ptr cinfo)
+{
+  my_coef_ptr coef = (my_coef_ptr)cinfo->coef;
+
+  jthread_lock(coef->sync);
+  coef->input_stopped = TRUE;
+  jthread_broadcast(coef->sync);
+  jthread_unlock(coef->sync);
+  jthread_join(coef->worker);
+  coef->worker = NULL;
+  jthread_sync_destroy(coef->sync);
+  coef->sync = NULL;
+
+  cinfo->err->error_exit = coef->error_exit;
+  cinfo->err->emit_message = coef->emit_message;
+}
+
+
+/*
+ * Proxy error handlers, which are installed while the reconstruction thread is
+ * running.  The application's error_exit() method, and its emit_message()
+ * method for warnings, may not return (for instance, they may longjmp() to a
+ * setjmp() point in the calling thread.)  Thus, the reconstruction thread must
+ * be stopped before those methods are called.
+ */
+
+METHODDEF(void)
+pipeline_error_exit(j_common_ptr cinfo)
+{
+  stop_pipeline((j_decompress_ptr)cinfo);
+  (*cinfo->err->error_exit) (cinfo);
+}
+
+METHODDEF(void)
+pipeline_emit_message(j_common_ptr cinfo, int msg_level)
+{
+  my_coef_ptr coef = (my_coef_ptr)((j_decompress_ptr)cinfo)->coef;
+
+  if (msg_level < 0) {
+    stop_pipeline((j_decompress_ptr)cinfo);
+    (*cinfo->err->emit_message) (cinfo, msg_level);
+  } else
+    (*coef->emit_message) (cinfo, msg_level);
+}
+
+#endif /* PIPELINE_SUPPORTED */
+
+
+/*
+ * Read scanlines in pipelined mode.  The calling thread entropy-decodes iMCU
+ * rows into the coefficient ring while a reconstruction thread converts them
+ * into scanlines.  The entropy decoder and the source manager thus always run
+ * in the calling thread.
+ */
+
+GLOBAL(boolean)
+_jread_scanlines_pipelined(j_decompress_ptr cinfo, _JSAMPARRAY scanlines,
+                           JDIMENSION *row_ctr, JDIMENSION max_lines)
+{
+#ifdef PIPELINE_SUPPORTED
+  my_coef_ptr coef = (my_coef_ptr)cinfo->coef;
+  JDIMENSION lines_per_iMCU_row, last_line, last_iMCU_row;
+  boolean stop;
+
+  if (cinfo->master->lossless || coef->ring == NULL)
+    return FALSE;
+
+  /* Determine the last iMCU row that is needed in order to produce the
+   * requested scanlines.  We never decode past that row, so that the
+   * entropy decoder raises exactly the same warnings that it would raise
+   * without pipelining, even if the application later skips the rest of the
+   * image.  Context-based upsampling needs the next iMCU row in order to
+   * produce the last row group of an iMCU row.
+   */
+  lines_per_iMCU_row =
+    cinfo->max_v_samp_factor * cinfo->_min_DCT_scaled_size;
+  if (max_lines > cinfo->output_height - cinfo->output_scanline)
+    max_lines = cinfo->output_height - cinfo->output_scanline;
+  last_line = cinfo->output_scanline + max_lines - 1;
+  last_iMCU_row = last_line / lines_per_iMCU_row;
+  if (cinfo->upsample->need_context_rows &&
+      last_line % lines_per_iMCU_row >=
+      lines_per_iMCU_row - cinfo->max_v_samp_factor)
+    last_iMCU_row++;
+  if (last_iMCU_row > cinfo->total_iMCU_rows - 1)
+    last_iMCU_row = cinfo->total_iMCU_rows - 1;
+
+  /* Starting a thread is worthwhile only if at least two iMCU rows remain to
+   * be decoded.
+   */
+  if (cinfo->input_iMCU_row >= last_iMCU_row)
+    return FALSE;
+
+  if ((coef->sync = jthread_sync_create()) == NULL)
+    return FALSE;
+  coef->input_stopped = FALSE;
+  coef->output_done = FALSE;
+  coef->worker_buf = scanlines;
+  coef->worker_row_ctr = *row_ctr;
+  coef->worker_rows_avail = max_lines;
+  coef->error_exit = cinfo->err->error_exit;
+  coef->emit_message = cinfo->err->emit_message;
+  cinfo->err->error_exit = pipeline_error_exit;
+  cinfo->err->emit_message = pipeline_emit_message;
+  if ((coef->worker = jthread_start(reconstruct_rows, cinfo)) == NULL) {
+    cinfo->err->error_exit = coef->error_exit;
+    cinfo->err->emit_message = coef->emit_message;
+    jthread_sync_destroy(coef->sync);
+    coef->sync = NULL;
+    return FALSE;
+  }
+
+  for (;;) {
+    /* Wait for a free slot in the ring */
+    jthread_lock(coef->sync);
+    while (!coef->output_done &&
+           cinfo->input_iMCU_row >= cinfo->output_iMCU_row + PIPELINE_ROWS)
+      jthread_wait(coef->sync);
+    stop = coef->output_done || cinfo->input_iMCU_row > last_iMCU_row;
+    jthread_unlock(coef->sync);
+    if (stop)
+      break;
+    /* A warning stops the pipeline (see pipeline_emit_message()), in which
+     * case we leave the rest of the work to the serial code path.
+     */
+    if (decode_iMCU_row(cinfo) == JPEG_SUSPENDED || coef->sync == NULL)
+      break;
+  }
+  if (coef->sync != NULL)
+    stop_pipeline(cinfo);
+
+  /* If the reconstruction thread produced no scanlines (because the input
+   * side suspended or the pipeline was stopped early), then let the caller
+   * read them in the usual way.
+   */
+  if (coef->worker_row_ctr == *row_ctr)
+    return FALSE;
+  *row_ctr = coef->worker_row_ctr;
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
+
 /*
  * Dummy consume-input routine for single-pass operation.
  */
@@ -900,13 +1317,20 @@ _jinit_d_coef_controller(j_decompress_ptr cinfo, boolean need_full_buffer)
       if (cinfo->progressive_mode)
         access_rows *= 5;
 #endif
-      coef->whole_image[ci] = (*cinfo->mem->request_virt_barray)
-        ((j_common_ptr)cinfo, JPOOL_IMAGE, TRUE,
-         (JDIMENSION)jround_up((long)compptr->width_in_blocks,
-                               (long)compptr->h_samp_factor),
-         (JDIMENSION)jround_up((long)compptr->height_in_blocks,
-                               (long)compptr->v_samp_factor),
-         (JDIMENSION)access_rows);
+      if (cinfo->master->coef_source != NULL)
+        /* Read the coefficients from another object's buffer (see
+         * jpeg_start_decompress().)
+         */
+        coef->whole_image[ci] =
+          cinfo->master->coef_source->coef->coef_arrays[ci];
+      else
+        coef->whole_image[ci] = (*cinfo->mem->request_virt_barray)
+          ((j_common_ptr)cinfo, JPOOL_IMAGE, TRUE,
+           (JDIMENSION)jround_up((long)compptr->width_in_blocks,
+                                 (long)compptr->h_samp_factor),
+           (JDIMENSION)jround_up((long)compptr->height_in_blocks,
+                                 (long)compptr->v_samp_factor),
+           (JDIMENSION)access_rows);
     }
     coef->pub.consume_data = consume_data;
     coef->pub._decompress_data = decompress_data;
@@ -928,6 +1352,14 @@ _jinit_d_coef_controller(j_decompress_ptr cinfo, boolean need_full_buffer)
     coef->pub.consume_data = dummy_consume_data;
     coef->pub._decompress_data = decompress_onepass;
     coef->pub.coef_arrays = NULL; /* flag for no virtual arrays */
+#ifdef PIPELINE_SUPPORTED
+    /* Raw data output and two-pass color quantization never read more than
+     * one iMCU row at a time, so pipelining cannot help them.
+     */
+    if (cinfo->master->pipelined && !cinfo->raw_data_out &&
+        !(cinfo->quantize_colors && cinfo->two_pass_quantize))
+      coef->pub._decompress_data = decompress_pipelined;
+#endif
   }
 
   /* Allocate the workspace buffer */
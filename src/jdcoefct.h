@@ -6,13 +6,14 @@
  * libjpeg-turbo Modifications:
  * Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
  * Copyright (C) 2020, Google, Inc.
- * Copyright (C) 2022, D. R. Commander.
+ * Copyright (C) 2022, 2026, D. R. Commander.
  * For conditions of distribution and use, see the accompanying README.ijg
  * file.
  */
 
 #define JPEG_INTERNALS
 #include "jpeglib.h"
+#include "jsamplecomp.h"
 
 
 #if BITS_IN_JSAMPLE != 16 || defined(D_LOSSLESS_SUPPORTED)
@@ -22,6 +23,14 @@
 #undef BLOCK_SMOOTHING_SUPPORTED
 #endif
 
+/* Pipelined decompression requires thread support.  It is also disabled in
+ * profiling builds, since the profiling code is not thread-safe.
+ */
+#if defined(WITH_THREADS) && !defined(WITH_PROFILE)
+#define PIPELINE_SUPPORTED
+#include "jthread.h"
+#endif
+
 
 /* Private buffer controller object */
 
@@ -57,6 +66,35 @@ typedef struct {
   int *coef_bits_latch;
 #define SAVED_COEFS  10         /* we save coef_bits[0..9] */
 #endif
+
+#ifdef PIPELINE_SUPPORTED
+  /* In pipelined mode, the input side entropy-decodes iMCU rows into a ring
+   * buffer, and the output side inverse-transforms them, possibly in a
+   * separate reconstruction thread.  The coefficients for each iMCU row are
+   * stored in MCU order.  The ring holds iMCU rows cinfo->output_iMCU_row
+   * through cinfo->input_iMCU_row - 1.
+   */
+  JBLOCKROW ring;               /* ring buffer of PIPELINE_ROWS iMCU rows */
+  size_t ring_row_blocks;       /* # of blocks per iMCU row in ring */
+
+  /* The remaining fields are used only while the reconstruction thread is
+   * running.  sync is non-NULL only during that time, and it protects
+   * cinfo->input_iMCU_row, cinfo->output_iMCU_row, input_stopped, and
+   * output_done.
+   */
+  jthread_sync *sync;
+  jthread *worker;
+  boolean input_stopped;        /* TRUE if input side will decode no more */
+  boolean output_done;          /* TRUE if reconstruction thread is done */
+  _JSAMPARRAY worker_buf;       /* scanlines being filled by the thread */
+  JDIMENSION worker_row_ctr;    /* # of scanlines filled so far */
+  JDIMENSION worker_rows_avail; /* # of scanlines requested */
+  /* The application's error handlers, which are replaced by proxies while the
+   * reconstruction thread is running
+   */
+  void (*error_exit) (j_common_ptr cinfo);
+  void (*emit_message) (j_common_ptr cinfo, int msg_level);
+#endif
 } my_coef_controller;
 
 typedef my_coef_controller *my_coef_ptr;
@@ -85,4 +123,18 @@ start_iMCU_row(j_decompress_ptr cinfo)
   coef->MCU_vert_offset = 0;
 }
 
+
+#if BITS_IN_JSAMPLE != 16
+
+/* Read scanlines using a separate reconstruction thread, if pipelined mode is
+ * enabled and worthwhile.  Returns FALSE, without reading any scanlines, if
+ * the caller should read them in the usual way.
+ */
+EXTERN(boolean) _jread_scanlines_pipelined(j_decompress_ptr cinfo,
+                                           _JSAMPARRAY scanlines,
+                                           JDIMENSION *row_ctr,
+                                           JDIMENSION max_lines);
+
+#endif
+
 #endif /* BITS_IN_JSAMPLE != 16 || defined(D_LOSSLESS_SUPPORTED) */
@@ -6,7 +6,7 @@
  * Modified 2011 by Guido Vollbeding.
  * libjpeg-turbo Modifications:
  * Copyright 2009 Pierre Ossman <ossman@cendio.se> for Cendio AB
- * Copyright (C) 2009, 2011-2012, 2014-2015, 2022, 2024-2025, D. R. Commander.
+ * Copyright (C) 2009, 2011-2012, 2014-2015, 2022, 2024-2026, D. R. Commander.
  * Copyright (C) 2013, Linaro Limited.
  * For conditions of distribution and use, see the accompanying README.ijg
  * file.
@@ -718,9 +718,9 @@ _jinit_color_deconverter(j_decompress_ptr cinfo)
 #endif
     cinfo->out_color_components = rgb_pixelsize[cinfo->out_color_space];
     if (cinfo->jpeg_color_space == JCS_YCbCr) {
-#ifdef WITH_SIMD
-      if (jsimd_set_ycc_rgb(cinfo))
-        cconvert->pub._color_convert = jsimd_color_deconvert;
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE != 16
+      if (_jsimd_set_ycc_rgb(cinfo))
+        cconvert->pub._color_convert = _jsimd_color_deconvert;
       else
 #endif
       {
@@ -825,9 +825,9 @@ _jinit_color_deconverter(j_decompress_ptr cinfo)
     cinfo->out_color_components = 3;
     if (cinfo->dither_mode == JDITHER_NONE) {
       if (cinfo->jpeg_color_space == JCS_YCbCr) {
-#ifdef WITH_SIMD
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
         if (jsimd_set_ycc_rgb565(cinfo))
-          cconvert->pub._color_convert = jsimd_color_deconvert;
+          cconvert->pub._color_convert = _jsimd_color_deconvert;
         else
 #endif
         {
@@ -4,7 +4,7 @@
  * This file was part of the Independent JPEG Group's software:
  * Copyright (C) 1994-1996, Thomas G. Lane.
  * libjpeg-turbo Modifications:
- * Copyright (C) 2015, 2022, 2025, D. R. Commander.
+ * Copyright (C) 2015, 2022, 2025-2026, D. R. Commander.
  * For conditions of distribution and use, see the accompanying README.ijg
  * file.
  *
@@ -49,7 +49,11 @@ typedef unsigned short UDCTELEM;
 typedef unsigned int UDCTELEM2;
 #endif
 #else
+#ifndef WITH_SIMD
 typedef JLONG DCTELEM;          /* must have 32 bits */
+#else
+typedef int DCTELEM;            /* 32-bit lanes with SIMD */
+#endif
 typedef unsigned long long UDCTELEM2;
 #endif
 
@@ -126,10 +130,30 @@ EXTERN(void) _jpeg_idct_islow(j_decompress_ptr cinfo,
                               jpeg_component_info *compptr,
                               JCOEFPTR coef_block, _JSAMPARRAY output_buf,
                               JDIMENSION output_col);
+EXTERN(void) _jpeg_idct_islow_dconly(j_decompress_ptr cinfo,
+                                     jpeg_component_info *compptr,
+                                     JCOEFPTR coef_block,
+                                     _JSAMPARRAY output_buf,
+                                     JDIMENSION output_col);
+EXTERN(void) _jpeg_idct_islow_sparse(j_decompress_ptr cinfo,
+                                     jpeg_component_info *compptr,
+                                     JCOEFPTR coef_block,
+                                     _JSAMPARRAY output_buf,
+                                     JDIMENSION output_col);
 EXTERN(void) _jpeg_idct_ifast(j_decompress_ptr cinfo,
                               jpeg_component_info *compptr,
                               JCOEFPTR coef_block, _JSAMPARRAY output_buf,
                               JDIMENSION output_col);
+EXTERN(void) _jpeg_idct_ifast_dconly(j_decompress_ptr cinfo,
+                                     jpeg_component_info *compptr,
+                                     JCOEFPTR coef_block,
+                                     _JSAMPARRAY output_buf,
+                                     JDIMENSION output_col);
+EXTERN(void) _jpeg_idct_ifast_sparse(j_decompress_ptr cinfo,
+                                     jpeg_component_info *compptr,
+                                     JCOEFPTR coef_block,
+                                     _JSAMPARRAY output_buf,
+                                     JDIMENSION output_col);
 EXTERN(void) _jpeg_idct_float(j_decompress_ptr cinfo,
                               jpeg_component_info *compptr,
                               JCOEFPTR coef_block, _JSAMPARRAY output_buf,
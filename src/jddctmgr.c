@@ -105,10 +105,12 @@ start_pass(j_decompress_ptr cinfo)
   jpeg_component_info *compptr;
   int method = 0;
   _inverse_DCT_method_ptr method_ptr = NULL;
+  _inverse_DCT_method_ptr dconly_method_ptr, sparse_method_ptr;
   JQUANT_TBL *qtbl;
 
   for (ci = 0, compptr = cinfo->comp_info; ci < cinfo->num_components;
        ci++, compptr++) {
+    dconly_method_ptr = sparse_method_ptr = NULL;
     /* Select the proper IDCT routine for this component's scaling */
     switch (compptr->_DCT_scaled_size) {
 #ifdef IDCT_SCALING_SUPPORTED
@@ -117,7 +119,7 @@ start_pass(j_decompress_ptr cinfo)
       method = JDCT_ISLOW;      /* jidctred uses islow-style table */
       break;
     case 2:
-#ifdef WITH_SIMD
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
       if (jsimd_set_idct_2x2(cinfo))
         method_ptr = jsimd_idct_2x2;
       else
@@ -126,11 +128,16 @@ start_pass(j_decompress_ptr cinfo)
       method = JDCT_ISLOW;      /* jidctred uses islow-style table */
       break;
     case 3:
-      method_ptr = _jpeg_idct_3x3;
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
+      if (jsimd_set_idct_3x3(cinfo))
+        method_ptr = jsimd_idct_3x3;
+      else
+#endif
+        method_ptr = _jpeg_idct_3x3;
       method = JDCT_ISLOW;      /* jidctint uses islow-style table */
       break;
     case 4:
-#ifdef WITH_SIMD
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
       if (jsimd_set_idct_4x4(cinfo))
         method_ptr = jsimd_idct_4x4;
       else
@@ -139,15 +146,30 @@ start_pass(j_decompress_ptr cinfo)
       method = JDCT_ISLOW;      /* jidctred uses islow-style table */
       break;
     case 5:
-      method_ptr = _jpeg_idct_5x5;
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
+      if (jsimd_set_idct_5x5(cinfo))
+        method_ptr = jsimd_idct_5x5;
+      else
+#endif
+        method_ptr = _jpeg_idct_5x5;
       method = JDCT_ISLOW;      /* jidctint uses islow-style table */
       break;
     case 6:
-      method_ptr = _jpeg_idct_6x6;
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
+      if (jsimd_set_idct_6x6(cinfo))
+        method_ptr = jsimd_idct_6x6;
+      else
+#endif
+        method_ptr = _jpeg_idct_6x6;
       method = JDCT_ISLOW;      /* jidctint uses islow-style table */
       break;
     case 7:
-      method_ptr = _jpeg_idct_7x7;
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
+      if (jsimd_set_idct_7x7(cinfo))
+        method_ptr = jsimd_idct_7x7;
+      else
+#endif
+        method_ptr = _jpeg_idct_7x7;
       method = JDCT_ISLOW;      /* jidctint uses islow-style table */
       break;
 #endif
@@ -156,28 +178,36 @@ start_pass(j_decompress_ptr cinfo)
 #ifdef DCT_ISLOW_SUPPORTED
       case JDCT_ISLOW:
 #ifdef WITH_SIMD
-        if (jsimd_set_idct_islow(cinfo))
-          method_ptr = jsimd_idct_islow;
+        if (_jsimd_set_idct_islow(cinfo))
+          method_ptr = _jsimd_idct_islow;
         else
 #endif
+        {
           method_ptr = _jpeg_idct_islow;
+          sparse_method_ptr = _jpeg_idct_islow_sparse;
+        }
+        dconly_method_ptr = _jpeg_idct_islow_dconly;
         method = JDCT_ISLOW;
         break;
 #endif
 #ifdef DCT_IFAST_SUPPORTED
       case JDCT_IFAST:
-#ifdef WITH_SIMD
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
         if (jsimd_set_idct_ifast(cinfo))
           method_ptr = jsimd_idct_ifast;
         else
 #endif
+        {
           method_ptr = _jpeg_idct_ifast;
+          sparse_method_ptr = _jpeg_idct_ifast_sparse;
+        }
+        dconly_method_ptr = _jpeg_idct_ifast_dconly;
         method = JDCT_IFAST;
         break;
 #endif
 #ifdef DCT_FLOAT_SUPPORTED
       case JDCT_FLOAT:
-#ifdef WITH_SIMD
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
         if (jsimd_set_idct_float(cinfo))
           method_ptr = jsimd_idct_float;
         else
@@ -230,6 +260,14 @@ start_pass(j_decompress_ptr cinfo)
       break;
     }
     idct->pub._inverse_DCT[ci] = method_ptr;
+    /* The SIMD IDCT implementations are faster than the C implementations
+     * even for sparse blocks, but nothing is faster than filling a block with
+     * its DC value.
+     */
+    idct->pub._inverse_DCT_dconly[ci] =
+      dconly_method_ptr ? dconly_method_ptr : method_ptr;
+    idct->pub._inverse_DCT_sparse[ci] =
+      sparse_method_ptr ? sparse_method_ptr : method_ptr;
     /* Create multiplier table from quant table.
      * However, we can skip this if the component is uninteresting
      * or if we already built the table.  Also, if no quant table
@@ -6,7 +6,7 @@
  * Lossless JPEG Modifications:
  * Copyright (C) 1999, Ken Murchison.
  * libjpeg-turbo Modifications:
- * Copyright (C) 2009-2011, 2016, 2018-2019, 2022, D. R. Commander.
+ * Copyright (C) 2009-2011, 2016, 2018-2019, 2022, 2026, D. R. Commander.
  * Copyright (C) 2018, Matthias Räncker.
  * For conditions of distribution and use, see the accompanying README.ijg
  * file.
@@ -28,6 +28,7 @@
 #include "jpeglib.h"
 #include "jdhuff.h"             /* Declarations shared with jd*huff.c */
 #include "jpegapicomp.h"
+#include "jthread.h"
 #include "jstdhuff.c"
 
 
@@ -57,20 +58,28 @@ typedef struct {
   /* Pointers to derived tables (these workspaces have image lifespan) */
   d_derived_tbl *dc_derived_tbls[NUM_HUFF_TBLS];
   d_derived_tbl *ac_derived_tbls[NUM_HUFF_TBLS];
+  d_fast_tbl *dc_fast_tbls[NUM_HUFF_TBLS];
+  d_fast_tbl *ac_fast_tbls[NUM_HUFF_TBLS];
 
   /* Precalculated info set up by start_pass for use in decode_mcu: */
 
   /* Pointers to derived tables to be used for each block within an MCU */
   d_derived_tbl *dc_cur_tbls[D_MAX_BLOCKS_IN_MCU];
   d_derived_tbl *ac_cur_tbls[D_MAX_BLOCKS_IN_MCU];
+  d_fast_tbl *dc_cur_fast_tbls[D_MAX_BLOCKS_IN_MCU];
+  d_fast_tbl *ac_cur_fast_tbls[D_MAX_BLOCKS_IN_MCU];
   /* Whether we care about the DC and AC coefficient values for each block */
   boolean dc_needed[D_MAX_BLOCKS_IN_MCU];
   boolean ac_needed[D_MAX_BLOCKS_IN_MCU];
+
+  /* Zigzag index of the last nonzero coefficient in each block of the most
+   * recently decoded MCU (pointed to by pub.last_nonzero)
+   */
+  int last_nonzero[D_MAX_BLOCKS_IN_MCU];
 } huff_entropy_decoder;
 
 typedef huff_entropy_decoder *huff_entropy_ptr;
 
-
 /*
  * Initialize for a Huffman-compressed scan.
  */
@@ -101,6 +110,10 @@ start_pass_huff_decoder(j_decompress_ptr cinfo)
     jpeg_make_d_derived_tbl(cinfo, TRUE, dctbl, pdtbl);
     pdtbl = (d_derived_tbl **)(entropy->ac_derived_tbls) + actbl;
     jpeg_make_d_derived_tbl(cinfo, FALSE, actbl, pdtbl);
+    jpeg_make_d_fast_tbl(cinfo, TRUE, entropy->dc_derived_tbls[dctbl],
+                         &entropy->dc_fast_tbls[dctbl]);
+    jpeg_make_d_fast_tbl(cinfo, FALSE, entropy->ac_derived_tbls[actbl],
+                         &entropy->ac_fast_tbls[actbl]);
     /* Initialize DC predictions to 0 */
     entropy->saved.last_dc_val[ci] = 0;
   }
@@ -112,6 +125,8 @@ start_pass_huff_decoder(j_decompress_ptr cinfo)
     /* Precalculate which table to use for each block */
     entropy->dc_cur_tbls[blkn] = entropy->dc_derived_tbls[compptr->dc_tbl_no];
     entropy->ac_cur_tbls[blkn] = entropy->ac_derived_tbls[compptr->ac_tbl_no];
+    entropy->dc_cur_fast_tbls[blkn] = entropy->dc_fast_tbls[compptr->dc_tbl_no];
+    entropy->ac_cur_fast_tbls[blkn] = entropy->ac_fast_tbls[compptr->ac_tbl_no];
     /* Decide whether we really care about the coefficient values */
     if (compptr->component_needed) {
       entropy->dc_needed[blkn] = TRUE;
@@ -129,6 +144,17 @@ start_pass_huff_decoder(j_decompress_ptr cinfo)
 
   /* Initialize restart counter */
   entropy->restarts_to_go = cinfo->restart_interval;
+
+  /* If requested, resume decoding from the middle of the entropy-coded data
+   * (see jpeg_huff_find_row_states() below.)
+   */
+  if (cinfo->master->resume_huff) {
+    entropy->bitstate.get_buffer = cinfo->master->resume_get_buffer;
+    entropy->bitstate.bits_left = cinfo->master->resume_bits_left;
+    for (ci = 0; ci < cinfo->comps_in_scan; ci++)
+      entropy->saved.last_dc_val[ci] = cinfo->master->resume_dc_val[ci];
+    cinfo->master->resume_huff = FALSE;
+  }
 }
 
 
@@ -384,49 +410,6 @@ no_more_bytes:
 }
 
 
-/* Macro version of the above, which performs much better but does not
-   handle markers.  We have to hand off any blocks with markers to the
-   slower routines. */
-
-#define GET_BYTE { \
-  register int c0, c1; \
-  c0 = *buffer++; \
-  c1 = *buffer; \
-  /* Pre-execute most common case */ \
-  get_buffer = (get_buffer << 8) | c0; \
-  bits_left += 8; \
-  if (c0 == 0xFF) { \
-    /* Pre-execute case of FF/00, which represents an FF data byte */ \
-    buffer++; \
-    if (c1 != 0) { \
-      /* Oops, it's actually a marker indicating end of compressed data. */ \
-      cinfo->unread_marker = c1; \
-      /* Back out pre-execution and fill the buffer with zero bits */ \
-      buffer -= 2; \
-      get_buffer &= ~0xFF; \
-    } \
-  } \
-}
-
-#if SIZEOF_SIZE_T == 8 || defined(_WIN64) || (defined(__x86_64__) && defined(__ILP32__))
-
-/* Pre-fetch 48 bytes, because the holding register is 64-bit */
-#define FILL_BIT_BUFFER_FAST \
-  if (bits_left <= 16) { \
-    GET_BYTE GET_BYTE GET_BYTE GET_BYTE GET_BYTE GET_BYTE \
-  }
-
-#else
-
-/* Pre-fetch 16 bytes, because the holding register is 32-bit */
-#define FILL_BIT_BUFFER_FAST \
-  if (bits_left <= 16) { \
-    GET_BYTE GET_BYTE \
-  }
-
-#endif
-
-
 /*
  * Out-of-line code for Huffman code decoding.
  * See jdhuff.h for info about usage.
@@ -503,6 +486,81 @@ static const int extend_offset[16] = { /* entry n is (-1 << n) + 1 */
 #endif /* AVOID_TABLES */
 
 
+/*
+ * Decode a Huffman code from the first nbits (<= HUFF_FAST_BITS) bits of
+ * bits, as jpeg_huff_decode() would.  Returns the code length, or 0 if the
+ * bits do not contain a complete code.
+ */
+
+LOCAL(int)
+fast_tbl_decode(d_derived_tbl *dtbl, int bits, int nbits, int *sym)
+{
+  int l;
+
+  for (l = 1; l <= nbits; l++) {
+    JLONG code = bits >> (nbits - l);
+
+    if (code <= dtbl->maxcode[l]) {
+      *sym = dtbl->pub->huffval[(int)(code + dtbl->valoffset[l]) & 0xFF];
+      return l;
+    }
+  }
+  return 0;
+}
+
+
+/*
+ * Compute a combined lookup table from a derived table.
+ */
+
+GLOBAL(void)
+jpeg_make_d_fast_tbl(j_decompress_ptr cinfo, boolean isDC, d_derived_tbl *dtbl,
+                     d_fast_tbl **pftbl)
+{
+  d_fast_tbl *ftbl;
+  int look;
+
+  /* Allocate a workspace if we haven't already done so. */
+  if (*pftbl == NULL)
+    *pftbl = (d_fast_tbl *)
+      (*cinfo->mem->alloc_small) ((j_common_ptr)cinfo, JPOOL_IMAGE,
+                                  sizeof(d_fast_tbl));
+  ftbl = *pftbl;
+
+  for (look = 0; look < (1 << HUFF_FAST_BITS); look++) {
+    int nb, sym, r, s, value = 0, remaining, eob_nb, eob_sym;
+    int entry;
+
+    ftbl->lookup[look] = 0;
+    if ((nb = fast_tbl_decode(dtbl, look, HUFF_FAST_BITS, &sym)) == 0)
+      continue;
+    r = isDC ? 0 : sym >> 4;
+    s = isDC ? sym : sym & 15;
+    remaining = HUFF_FAST_BITS - nb - s;
+    if (remaining < 0)
+      continue;
+
+    if (s) {
+      int bits = (look >> remaining) & ((1 << s) - 1);
+
+      value = HUFF_EXTEND(bits, s);
+    }
+    entry = (nb + s) | (r << 4) | (int)((unsigned int)value << 16);
+
+    if (!isDC) {
+      if (s == 0 && r != 15)
+        entry |= FAST_EOB;
+      else if (remaining > 0 &&
+               (eob_nb = fast_tbl_decode(dtbl, look & ((1 << remaining) - 1),
+                                         remaining, &eob_sym)) != 0 &&
+               (eob_sym & 15) == 0 && (eob_sym >> 4) != 15)
+        entry |= eob_nb << 9;
+    }
+    ftbl->lookup[look] = entry;
+  }
+}
+
+
 /*
  * Check for a restart marker & resynchronize decoder.
  * Returns FALSE if must suspend.
@@ -566,6 +624,7 @@ decode_mcu_slow(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
     d_derived_tbl *dctbl = entropy->dc_cur_tbls[blkn];
     d_derived_tbl *actbl = entropy->ac_cur_tbls[blkn];
     register int s, k, r;
+    int last = 0;
 
     /* Decode a single block's worth of coefficients */
 
@@ -616,6 +675,7 @@ decode_mcu_slow(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
            * if k >= DCTSIZE2, which could happen if the data is corrupted.
            */
           (*block)[jpeg_natural_order[k]] = (JCOEF)s;
+          last = k;
         } else {
           if (r != 15)
             break;
@@ -644,6 +704,8 @@ decode_mcu_slow(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
         }
       }
     }
+
+    entropy->last_nonzero[blkn] = last;
   }
 
   /* Completed MCU, so update state */
@@ -678,13 +740,23 @@ decode_mcu_fast(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
     JBLOCKROW block = MCU_data ? MCU_data[blkn] : NULL;
     d_derived_tbl *dctbl = entropy->dc_cur_tbls[blkn];
     d_derived_tbl *actbl = entropy->ac_cur_tbls[blkn];
+    d_fast_tbl *dcfast = entropy->dc_cur_fast_tbls[blkn];
+    d_fast_tbl *acfast = entropy->ac_cur_fast_tbls[blkn];
     register int s, k, r, l;
+    int last = 0;
 
-    HUFF_DECODE_FAST(s, l, dctbl);
+    FILL_BIT_BUFFER_FAST
+    s = dcfast->lookup[PEEK_BITS(HUFF_FAST_BITS)];
     if (s) {
-      FILL_BIT_BUFFER_FAST
-      r = GET_BITS(s);
-      s = HUFF_EXTEND(r, s);
+      DROP_BITS(FAST_NBITS(s));
+      s = FAST_VALUE(s);
+    } else {
+      HUFF_DECODE_FAST(s, l, dctbl);
+      if (s) {
+        FILL_BIT_BUFFER_FAST
+        r = GET_BITS(s);
+        s = HUFF_EXTEND(r, s);
+      }
     }
 
     if (entropy->dc_needed[blkn]) {
@@ -701,6 +773,22 @@ decode_mcu_fast(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
     if (entropy->ac_needed[blkn] && block) {
 
       for (k = 1; k < DCTSIZE2; k++) {
+        FILL_BIT_BUFFER_FAST
+        s = acfast->lookup[PEEK_BITS(HUFF_FAST_BITS)];
+        if (s) {
+          DROP_BITS(FAST_NBITS(s));
+          if (s & FAST_EOB) break;
+          k += FAST_RUN(s);
+          (*block)[jpeg_natural_order[k]] = (JCOEF)FAST_VALUE(s);
+          last = k;
+          /* An EOB code is never emitted after the last coefficient. */
+          if (FAST_EOB_NBITS(s) && k < DCTSIZE2 - 1) {
+            DROP_BITS(FAST_EOB_NBITS(s));
+            break;
+          }
+          continue;
+        }
+
         HUFF_DECODE_FAST(s, l, actbl);
         r = s >> 4;
         s &= 15;
@@ -711,6 +799,7 @@ decode_mcu_fast(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
           r = GET_BITS(s);
           s = HUFF_EXTEND(r, s);
           (*block)[jpeg_natural_order[k]] = (JCOEF)s;
+          last = k;
         } else {
           if (r != 15) break;
           k += 15;
@@ -720,6 +809,19 @@ decode_mcu_fast(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
     } else {
 
       for (k = 1; k < DCTSIZE2; k++) {
+        FILL_BIT_BUFFER_FAST
+        s = acfast->lookup[PEEK_BITS(HUFF_FAST_BITS)];
+        if (s) {
+          DROP_BITS(FAST_NBITS(s));
+          if (s & FAST_EOB) break;
+          k += FAST_RUN(s);
+          if (FAST_EOB_NBITS(s) && k < DCTSIZE2 - 1) {
+            DROP_BITS(FAST_EOB_NBITS(s));
+            break;
+          }
+          continue;
+        }
+
         HUFF_DECODE_FAST(s, l, actbl);
         r = s >> 4;
         s &= 15;
@@ -734,6 +836,8 @@ decode_mcu_fast(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
         }
       }
     }
+
+    entropy->last_nonzero[blkn] = last;
   }
 
   if (cinfo->unread_marker != 0) {
@@ -764,8 +868,6 @@ decode_mcu_fast(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
  * this module, since we'll just re-assign them on the next call.)
  */
 
-#define BUFSIZE  (DCTSIZE2 * 8)
-
 METHODDEF(boolean)
 decode_mcu(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
 {
@@ -777,7 +879,14 @@ decode_mcu(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
     if (entropy->restarts_to_go == 0)
       if (!process_restart(cinfo))
         return FALSE;
-    usefast = 0;
+    /* The fast path cannot read past the RSTn marker that terminates the
+     * restart interval, so it would almost certainly hit the marker and fall
+     * back to the slow path while decoding the last MCU in the interval.  We
+     * avoid decoding that MCU twice by using the slow path for it.  The fast
+     * path handles all other MCUs in the interval.
+     */
+    if (entropy->restarts_to_go == 1)
+      usefast = 0;
   }
 
   if (cinfo->src->bytes_in_buffer < BUFSIZE * (size_t)cinfo->blocks_in_MCU ||
@@ -806,6 +915,352 @@ use_slow:
 }
 
 
+/*
+ * Speculative parallel Huffman decoding
+ *
+ * If an image has no restart markers, then the location of each MCU in the
+ * entropy-coded data is unknown until all preceding MCUs have been decoded.
+ * However, Huffman codes tend to resynchronize quickly, so a decoder that
+ * starts at an arbitrary bit offset usually finds the true MCU boundaries
+ * after a few MCUs.  jpeg_huff_find_row_states() exploits this by splitting
+ * the entropy-coded data into chunks, each of which is decoded by a separate
+ * thread starting at the beginning of the chunk (a guess.)  Each thread
+ * records the bit offset of every MCU that it decodes, along with the DC
+ * predictions relative to its starting point.  The chunks are then checked in
+ * order.  Once a true MCU boundary matches an MCU boundary found by the thread
+ * that decoded a chunk, the remainder of that thread's results are known to
+ * be correct, since decoding is deterministic, and the DC predictions can be
+ * corrected by adding the true DC predictions at the synchronization point.
+ * Any part of a chunk that precedes the synchronization point is re-decoded
+ * serially.
+ *
+ * Only the MCU boundaries and DC predictions are computed, not the DCT
+ * coefficients.  The caller can use the results to decode bands of iMCU rows
+ * in parallel (see the resume_huff field in struct jpeg_decomp_master.)
+ */
+
+#define SPEC_MIN_CHUNK_SIZE  4096 /* minimum size of a chunk, in bytes */
+
+typedef struct {
+  const JOCTET *data;           /* unstuffed entropy-coded data */
+  size_t num_bits;              /* # of bits of entropy-coded data */
+  int blocks_in_MCU;
+  int MCU_membership[D_MAX_BLOCKS_IN_MCU];
+  d_derived_tbl *dc_tbls[D_MAX_BLOCKS_IN_MCU];
+  d_derived_tbl *ac_tbls[D_MAX_BLOCKS_IN_MCU];
+} spec_scan_info;
+
+typedef struct {
+  const spec_scan_info *scan;
+  size_t start_bit, end_bit;    /* extent of the chunk */
+  jpeg_huff_row_state *mcus;    /* state at the start of each MCU found */
+  size_t num_mcus, max_mcus;
+} spec_chunk;
+
+
+/* Return the nbits (<= 16) bits at bit offset pos. */
+
+INLINE
+LOCAL(int)
+spec_peek_bits(const JOCTET *data, size_t pos, int nbits)
+{
+  const JOCTET *ptr = data + (pos >> 3);
+  unsigned int bits = ((unsigned int)ptr[0] << 16) |
+                      ((unsigned int)ptr[1] << 8) | (unsigned int)ptr[2];
+
+  return (int)(bits >> (24 - (int)(pos & 7) - nbits)) & ((1 << nbits) - 1);
+}
+
+
+/* Decode a Huffman code at bit offset *pos, and advance *pos past it.  Returns
+ * -1 if the code is invalid.
+ */
+
+INLINE
+LOCAL(int)
+spec_huff_decode(const JOCTET *data, size_t *pos, d_derived_tbl *htbl)
+{
+  int look = spec_peek_bits(data, *pos, HUFF_LOOKAHEAD), nb, l;
+
+  if ((nb = (htbl->lookup[look] >> HUFF_LOOKAHEAD)) <= HUFF_LOOKAHEAD) {
+    *pos += nb;
+    return htbl->lookup[look] & ((1 << HUFF_LOOKAHEAD) - 1);
+  }
+  for (l = HUFF_LOOKAHEAD + 1; l <= 16; l++) {
+    JLONG code = spec_peek_bits(data, *pos, l);
+
+    if (code <= htbl->maxcode[l]) {
+      *pos += l;
+      return htbl->pub->huffval[(int)(code + htbl->valoffset[l]) & 0xFF];
+    }
+  }
+  return -1;
+}
+
+
+/* Decode one MCU at bit offset *pos, discarding the coefficients but updating
+ * the DC predictions.  Returns FALSE if the data is invalid.  A block occupies
+ * at most 64 * (16 + 15) bits, so checking the offset at the start of each
+ * block ensures that we never read more than JPEG_HUFF_SPEC_PADDING bytes past
+ * the end of the data.
+ */
+
+LOCAL(boolean)
+spec_decode_mcu(const spec_scan_info *scan, size_t *pos, int *dc_val)
+{
+  const JOCTET *data = scan->data;
+  size_t bitpos = *pos;
+  int blkn, ci, s, k, r;
+
+  for (blkn = 0; blkn < scan->blocks_in_MCU; blkn++) {
+    if (bitpos > scan->num_bits)
+      return FALSE;
+
+    /* Section F.2.2.1: decode the DC coefficient difference */
+    if ((s = spec_huff_decode(data, &bitpos, scan->dc_tbls[blkn])) < 0)
+      return FALSE;
+    if (s) {
+      r = spec_peek_bits(data, bitpos, s);
+      bitpos += s;
+      s = HUFF_EXTEND(r, s);
+    }
+    ci = scan->MCU_membership[blkn];
+    dc_val[ci] = (int)((unsigned int)dc_val[ci] + (unsigned int)s);
+
+    /* Section F.2.2.2: skip the AC coefficients */
+    for (k = 1; k < DCTSIZE2; k++) {
+      if ((s = spec_huff_decode(data, &bitpos, scan->ac_tbls[blkn])) < 0)
+        return FALSE;
+
+      r = s >> 4;
+      s &= 15;
+
+      if (s) {
+        k += r;
+        bitpos += s;
+      } else {
+        if (r != 15)
+          break;
+        k += 15;
+      }
+    }
+  }
+
+  *pos = bitpos;
+  return TRUE;
+}
+
+
+/* Decode the MCUs in one chunk, starting at the beginning of the chunk and
+ * stopping at the first MCU boundary at or beyond the end of the chunk.  This
+ * is executed by the worker threads.
+ */
+
+METHODDEF(void)
+spec_decode_chunk(void *arg)
+{
+  spec_chunk *chunk = (spec_chunk *)arg;
+  size_t pos = chunk->start_bit;
+  int dc_val[MAX_COMPS_IN_SCAN];
+
+  memset(dc_val, 0, sizeof(dc_val));
+  for (;;) {
+    if (chunk->num_mcus >= chunk->max_mcus) {
+      size_t max_mcus = chunk->max_mcus ? chunk->max_mcus * 2 : 1024;
+      jpeg_huff_row_state *mcus = (jpeg_huff_row_state *)
+        realloc(chunk->mcus, max_mcus * sizeof(jpeg_huff_row_state));
+
+      /* Out of memory: the remainder of the chunk will be decoded serially. */
+      if (mcus == NULL)
+        break;
+      chunk->mcus = mcus;
+      chunk->max_mcus = max_mcus;
+    }
+    chunk->mcus[chunk->num_mcus].bit_offset = pos;
+    memcpy(chunk->mcus[chunk->num_mcus].last_dc_val, dc_val, sizeof(dc_val));
+    chunk->num_mcus++;
+    if (pos >= chunk->end_bit || !spec_decode_mcu(chunk->scan, &pos, dc_val))
+      break;
+  }
+}
+
+
+/* Return the index of the MCU boundary at bit offset pos in the chunk, or -1
+ * if the thread that decoded the chunk did not find that boundary.
+ */
+
+LOCAL(long)
+spec_find_mcu(const spec_chunk *chunk, size_t pos)
+{
+  size_t lo = 0, hi = chunk->num_mcus;
+
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+
+    if (chunk->mcus[mid].bit_offset < pos)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if (lo < chunk->num_mcus && chunk->mcus[lo].bit_offset == pos)
+    return (long)lo;
+  return -1;
+}
+
+
+/*
+ * Compute the Huffman decoder state at the start of each iMCU row of a
+ * single-scan sequential Huffman-coded image with no restart markers, using
+ * up to num_threads threads.  data points to the scan's entropy-coded data,
+ * with byte stuffing removed, and it must be followed by at least
+ * JPEG_HUFF_SPEC_PADDING zero bytes.  The header must have been read, but
+ * decompression must not have started.
+ *
+ * Returns an array of cinfo->total_iMCU_rows states (with image lifespan), or
+ * NULL if the data is invalid or truncated.  In that case, the caller should
+ * decode the image normally, so that errors are handled in the usual manner.
+ */
+
+GLOBAL(jpeg_huff_row_state *)
+jpeg_huff_find_row_states(j_decompress_ptr cinfo, const JOCTET *data,
+                          size_t num_bytes, int num_threads)
+{
+  spec_scan_info scan;
+  spec_chunk *chunks = NULL;
+  jpeg_huff_row_state *rows, *result = NULL;
+  d_derived_tbl *dc_derived_tbls[NUM_HUFF_TBLS];
+  d_derived_tbl *ac_derived_tbls[NUM_HUFF_TBLS];
+  size_t MCUs_per_iMCU_row, total_MCUs, MCU = 0, chunk_bits, pos = 0;
+  int num_chunks, ci, c, dc_val[MAX_COMPS_IN_SCAN];
+
+  if (cinfo->progressive_mode || cinfo->arith_code ||
+      cinfo->master->lossless || cinfo->restart_interval ||
+      cinfo->comps_in_scan < 1 || num_bytes == 0 ||
+      num_bytes > ((size_t)-1) / 8 - JPEG_HUFF_SPEC_PADDING)
+    return NULL;
+
+  /* Set up the derived tables and MCU layout, as start_pass_huff_decoder()
+   * and per_scan_setup() (in jdinput.c) would.
+   */
+  std_huff_tables((j_common_ptr)cinfo);
+  for (c = 0; c < NUM_HUFF_TBLS; c++)
+    dc_derived_tbls[c] = ac_derived_tbls[c] = NULL;
+  scan.data = data;
+  scan.num_bits = num_bytes * 8;
+  scan.blocks_in_MCU = 0;
+  for (ci = 0; ci < cinfo->comps_in_scan; ci++) {
+    jpeg_component_info *compptr = cinfo->cur_comp_info[ci];
+    int mcublks = cinfo->comps_in_scan == 1 ? 1 :
+                  compptr->h_samp_factor * compptr->v_samp_factor;
+
+    jpeg_make_d_derived_tbl(cinfo, TRUE, compptr->dc_tbl_no,
+                            &dc_derived_tbls[compptr->dc_tbl_no]);
+    jpeg_make_d_derived_tbl(cinfo, FALSE, compptr->ac_tbl_no,
+                            &ac_derived_tbls[compptr->ac_tbl_no]);
+    if (scan.blocks_in_MCU + mcublks > D_MAX_BLOCKS_IN_MCU)
+      return NULL;
+    while (mcublks-- > 0) {
+      scan.MCU_membership[scan.blocks_in_MCU] = ci;
+      scan.dc_tbls[scan.blocks_in_MCU] = dc_derived_tbls[compptr->dc_tbl_no];
+      scan.ac_tbls[scan.blocks_in_MCU] = ac_derived_tbls[compptr->ac_tbl_no];
+      scan.blocks_in_MCU++;
+    }
+  }
+  if (cinfo->comps_in_scan == 1) {
+    jpeg_component_info *compptr = cinfo->cur_comp_info[0];
+
+    MCUs_per_iMCU_row =
+      (size_t)compptr->width_in_blocks * compptr->v_samp_factor;
+    total_MCUs =
+      (size_t)compptr->width_in_blocks * compptr->height_in_blocks;
+  } else {
+    MCUs_per_iMCU_row = (size_t)
+      jdiv_round_up((long)cinfo->image_width,
+                    (long)(cinfo->max_h_samp_factor * DCTSIZE));
+    total_MCUs = MCUs_per_iMCU_row * cinfo->total_iMCU_rows;
+  }
+  if (MCUs_per_iMCU_row == 0 || total_MCUs == 0)
+    return NULL;
+
+  rows = (jpeg_huff_row_state *)
+    (*cinfo->mem->alloc_large) ((j_common_ptr)cinfo, JPOOL_IMAGE,
+                                cinfo->total_iMCU_rows *
+                                sizeof(jpeg_huff_row_state));
+
+  /* Decode the chunks speculatively. */
+  num_chunks = num_threads;
+  if ((size_t)num_chunks > num_bytes / SPEC_MIN_CHUNK_SIZE)
+    num_chunks = (int)(num_bytes / SPEC_MIN_CHUNK_SIZE);
+  if (num_chunks < 1)
+    num_chunks = 1;
+  chunk_bits = num_bytes / num_chunks * 8;
+  if ((chunks = (spec_chunk *)calloc(num_chunks, sizeof(spec_chunk))) == NULL)
+    return NULL;
+  for (c = 0; c < num_chunks; c++) {
+    chunks[c].scan = &scan;
+    chunks[c].start_bit = c * chunk_bits;
+    chunks[c].end_bit =
+      c == num_chunks - 1 ? scan.num_bits : (c + 1) * chunk_bits;
+  }
+  jthread_run(num_threads, spec_decode_chunk, chunks, sizeof(spec_chunk),
+              num_chunks);
+
+  /* Follow the true MCU boundaries from the beginning of the data, adopting
+   * each chunk's results as soon as they are synchronized with the true
+   * boundaries.
+   */
+  memset(dc_val, 0, sizeof(dc_val));
+  while (MCU < total_MCUs) {
+    spec_chunk *chunk;
+    long sync;
+
+    if (MCU % MCUs_per_iMCU_row == 0) {
+      rows[MCU / MCUs_per_iMCU_row].bit_offset = pos;
+      memcpy(rows[MCU / MCUs_per_iMCU_row].last_dc_val, dc_val,
+             sizeof(dc_val));
+    }
+
+    c = (int)(pos / chunk_bits);
+    chunk = &chunks[c < num_chunks ? c : num_chunks - 1];
+    sync = spec_find_mcu(chunk, pos);
+    if (sync >= 0 && (size_t)sync + 1 < chunk->num_mcus) {
+      const jpeg_huff_row_state *base = &chunk->mcus[sync], *mcu = base + 1;
+      int base_dc_val[MAX_COMPS_IN_SCAN];
+
+      memcpy(base_dc_val, dc_val, sizeof(dc_val));
+      for (;;) {
+        pos = mcu->bit_offset;
+        for (ci = 0; ci < cinfo->comps_in_scan; ci++)
+          dc_val[ci] = (int)((unsigned int)base_dc_val[ci] +
+                             (unsigned int)mcu->last_dc_val[ci] -
+                             (unsigned int)base->last_dc_val[ci]);
+        if (++MCU >= total_MCUs || ++mcu >= chunk->mcus + chunk->num_mcus)
+          break;
+        if (MCU % MCUs_per_iMCU_row == 0) {
+          rows[MCU / MCUs_per_iMCU_row].bit_offset = pos;
+          memcpy(rows[MCU / MCUs_per_iMCU_row].last_dc_val, dc_val,
+                 sizeof(dc_val));
+        }
+      }
+    } else {
+      if (!spec_decode_mcu(&scan, &pos, dc_val))
+        goto bailout;
+      MCU++;
+    }
+  }
+
+  /* The last MCU must end within the data. */
+  if (pos <= scan.num_bits)
+    result = rows;
+
+bailout:
+  for (c = 0; c < num_chunks; c++)
+    free(chunks[c].mcus);
+  free(chunks);
+  return result;
+}
+
+
 /*
  * Module initialization routine for Huffman entropy decoding.
  */
@@ -828,9 +1283,11 @@ jinit_huff_decoder(j_decompress_ptr cinfo)
   cinfo->entropy = (struct jpeg_entropy_decoder *)entropy;
   entropy->pub.start_pass = start_pass_huff_decoder;
   entropy->pub.decode_mcu = decode_mcu;
+  entropy->pub.last_nonzero = entropy->last_nonzero;
 
   /* Mark tables unallocated */
   for (i = 0; i < NUM_HUFF_TBLS; i++) {
     entropy->dc_derived_tbls[i] = entropy->ac_derived_tbls[i] = NULL;
+    entropy->dc_fast_tbls[i] = entropy->ac_fast_tbls[i] = NULL;
   }
 }
@@ -6,7 +6,7 @@
  * Lossless JPEG Modifications:
  * Copyright (C) 1999, Ken Murchison.
  * libjpeg-turbo Modifications:
- * Copyright (C) 2010-2011, 2015-2016, 2021, D. R. Commander.
+ * Copyright (C) 2010-2011, 2015-2016, 2021, 2026, D. R. Commander.
  * Copyright (C) 2018, Matthias Räncker.
  * For conditions of distribution and use, see the accompanying README.ijg
  * file.
@@ -55,6 +55,49 @@ EXTERN(void) jpeg_make_d_derived_tbl(j_decompress_ptr cinfo, boolean isDC,
                                      int tblno, d_derived_tbl **pdtbl);
 
 
+/*
+ * Combined lookup tables for the fast path.
+ *
+ * The lookahead table in d_derived_tbl yields one Huffman symbol per lookup,
+ * after which the fast path must fetch the coefficient's magnitude bits
+ * separately.  A combined lookup table is indexed by the next HUFF_FAST_BITS
+ * bits of the input data stream.  If those bits contain a complete Huffman
+ * code followed by all of its magnitude bits, then the table entry contains
+ * the decoded coefficient value, the zero run length, and the total number of
+ * bits to discard.  For AC tables, if the remaining bits also contain an EOB
+ * code, then the entry also contains the length of that code, so that the
+ * last coefficient in a block and the EOB can be decoded with one lookup.  An
+ * entry of 0 means that the fast path must fall back to the lookahead
+ * table.
+ *
+ * These tables are built along with the derived tables whenever a scan
+ * begins, and they are used only by the fast paths in jdhuff.c and
+ * jdphuff.c.
+ */
+
+#define HUFF_FAST_BITS  10      /* # of bits of lookahead */
+
+typedef struct {
+  /* Bits 0-3 of each entry contain the number of bits in the Huffman code and
+   * its magnitude bits, bits 4-7 contain the zero run length, bit 8 is set if
+   * the code is an EOB code, bits 9-12 contain the number of bits in the
+   * subsequent EOB code (or 0 if none), and bits 16-31 contain the
+   * coefficient value.
+   */
+  int lookup[1 << HUFF_FAST_BITS];
+} d_fast_tbl;
+
+#define FAST_NBITS(entry)      ((entry) & 15)
+#define FAST_RUN(entry)        (((entry) >> 4) & 15)
+#define FAST_EOB               0x100
+#define FAST_EOB_NBITS(entry)  (((entry) >> 9) & 15)
+#define FAST_VALUE(entry)      ((entry) >> 16)
+
+/* Compute a combined lookup table from a derived table */
+EXTERN(void) jpeg_make_d_fast_tbl(j_decompress_ptr cinfo, boolean isDC,
+                                  d_derived_tbl *dtbl, d_fast_tbl **pftbl);
+
+
 /*
  * Fetching the next N bits from the input stream is a time-critical operation
  * for the Huffman decoders.  We implement it with a combination of inline
@@ -179,6 +222,54 @@ EXTERN(boolean) jpeg_fill_bit_buffer(bitread_working_state *state,
                                      register bit_buf_type get_buffer,
                                      register int bits_left, int nbits);
 
+/* Macro version of jpeg_fill_bit_buffer(), which performs much better but
+   does not handle markers.  The fast paths in jd*huff.c use this with a local
+   variable (buffer) that points to the next input byte.  If a marker is
+   encountered, then cinfo->unread_marker is set, and the caller must hand off
+   the MCU to the slower routines. */
+
+#define GET_BYTE { \
+  register int c0, c1; \
+  c0 = *buffer++; \
+  c1 = *buffer; \
+  /* Pre-execute most common case */ \
+  get_buffer = (get_buffer << 8) | c0; \
+  bits_left += 8; \
+  if (c0 == 0xFF) { \
+    /* Pre-execute case of FF/00, which represents an FF data byte */ \
+    buffer++; \
+    if (c1 != 0) { \
+      /* Oops, it's actually a marker indicating end of compressed data. */ \
+      cinfo->unread_marker = c1; \
+      /* Back out pre-execution and fill the buffer with zero bits */ \
+      buffer -= 2; \
+      get_buffer &= ~0xFF; \
+    } \
+  } \
+}
+
+#if SIZEOF_SIZE_T == 8 || defined(_WIN64) || (defined(__x86_64__) && defined(__ILP32__))
+
+/* Pre-fetch 48 bytes, because the holding register is 64-bit */
+#define FILL_BIT_BUFFER_FAST \
+  if (bits_left <= 16) { \
+    GET_BYTE GET_BYTE GET_BYTE GET_BYTE GET_BYTE GET_BYTE \
+  }
+
+#else
+
+/* Pre-fetch 16 bytes, because the holding register is 32-bit */
+#define FILL_BIT_BUFFER_FAST \
+  if (bits_left <= 16) { \
+    GET_BYTE GET_BYTE \
+  }
+
+#endif
+
+/* The fast paths are used only if at least this many bytes per block remain
+   in the source buffer, so that they never read past the end of it. */
+#define BUFSIZE  (DCTSIZE2 * 8)
+
 
 /*
  * Code for extracting next Huffman-coded symbol from input bit stream.
@@ -6,7 +6,7 @@
  * Lossless JPEG Modifications:
  * Copyright (C) 1999, Ken Murchison.
  * libjpeg-turbo Modifications:
- * Copyright (C) 2022, D. R. Commander.
+ * Copyright (C) 2022, 2026, D. R. Commander.
  * For conditions of distribution and use, see the accompanying README.ijg
  * file.
  *
@@ -47,10 +47,14 @@ typedef struct {
   /* Pointers to derived tables (these workspaces have image lifespan) */
   d_derived_tbl *derived_tbls[NUM_HUFF_TBLS];
 
+  /* Pointers to combined lookup tables for the fast path */
+  d_fast_tbl *fast_tbls[NUM_HUFF_TBLS];
+
   /* Precalculated info set up by start_pass for use in decode_mcus: */
 
   /* Pointers to derived tables to be used for each data unit within an MCU */
   d_derived_tbl *cur_tbls[D_MAX_BLOCKS_IN_MCU];
+  d_fast_tbl *cur_fast_tbls[D_MAX_BLOCKS_IN_MCU];
 
   /* Pointers to the proper output difference row for each group of data units
    * within an MCU.  For each component, there are Vi groups of Hi data units.
@@ -97,6 +101,8 @@ start_pass_lhuff_decoder(j_decompress_ptr cinfo)
     /* We may do this more than once for a table, but it's not expensive */
     jpeg_make_d_derived_tbl(cinfo, TRUE, dctbl,
                             &entropy->derived_tbls[dctbl]);
+    jpeg_make_d_fast_tbl(cinfo, TRUE, entropy->derived_tbls[dctbl],
+                         &entropy->fast_tbls[dctbl]);
   }
 
   /* Precalculate decoding info for each sample in an MCU of this scan */
@@ -113,6 +119,8 @@ start_pass_lhuff_decoder(j_decompress_ptr cinfo)
         entropy->output_ptr_index[sampn] = ptrn;
         /* Precalculate which table to use for each sample */
         entropy->cur_tbls[sampn] = entropy->derived_tbls[compptr->dc_tbl_no];
+        entropy->cur_fast_tbls[sampn] =
+          entropy->fast_tbls[compptr->dc_tbl_no];
       }
     }
   }
@@ -188,6 +196,110 @@ process_restart(j_decompress_ptr cinfo)
 }
 
 
+LOCAL(boolean)
+decode_mcu_slow(j_decompress_ptr cinfo)
+{
+  lhuff_entropy_ptr entropy = (lhuff_entropy_ptr)cinfo->entropy;
+  int sampn;
+  BITREAD_STATE_VARS;
+
+  /* Load up working state */
+  BITREAD_LOAD_STATE(cinfo, entropy->bitstate);
+
+  /* Outer loop handles the samples in the MCU */
+  for (sampn = 0; sampn < cinfo->blocks_in_MCU; sampn++) {
+    d_derived_tbl *dctbl = entropy->cur_tbls[sampn];
+    register int s, r;
+
+    /* Section H.2.2: decode the sample difference */
+    HUFF_DECODE(s, br_state, dctbl, return FALSE, label1);
+    if (s) {
+      if (s == 16)      /* special case: always output 32768 */
+        s = 32768;
+      else {            /* normal case: fetch subsequent bits */
+        CHECK_BIT_BUFFER(br_state, s, return FALSE);
+        r = GET_BITS(s);
+        s = HUFF_EXTEND(r, s);
+      }
+    }
+
+    /* Output the sample difference */
+    *entropy->output_ptr[entropy->output_ptr_index[sampn]]++ = (JDIFF)s;
+  }
+
+  /* Completed MCU, so update state */
+  BITREAD_SAVE_STATE(cinfo, entropy->bitstate);
+  return TRUE;
+}
+
+
+LOCAL(boolean)
+decode_mcu_fast(j_decompress_ptr cinfo)
+{
+  lhuff_entropy_ptr entropy = (lhuff_entropy_ptr)cinfo->entropy;
+  BITREAD_STATE_VARS;
+  JOCTET *buffer;
+  int sampn, ptrn;
+
+  /* Load up working state */
+  BITREAD_LOAD_STATE(cinfo, entropy->bitstate);
+  buffer = (JOCTET *)br_state.next_input_byte;
+
+  /* Outer loop handles the samples in the MCU */
+  for (sampn = 0; sampn < cinfo->blocks_in_MCU; sampn++) {
+    d_derived_tbl *dctbl = entropy->cur_tbls[sampn];
+    d_fast_tbl *dcfast = entropy->cur_fast_tbls[sampn];
+    register int s, r, l;
+
+    /* Section H.2.2: decode the sample difference */
+    FILL_BIT_BUFFER_FAST
+    s = dcfast->lookup[PEEK_BITS(HUFF_FAST_BITS)];
+    if (s) {
+      DROP_BITS(FAST_NBITS(s));
+      s = FAST_VALUE(s);
+    } else {
+      HUFF_DECODE_FAST(s, l, dctbl);
+      if (s) {
+        if (s == 16)    /* special case: always output 32768 */
+          s = 32768;
+        else {          /* normal case: fetch subsequent bits */
+          FILL_BIT_BUFFER_FAST
+          r = GET_BITS(s);
+          s = HUFF_EXTEND(r, s);
+        }
+      }
+    }
+
+    /* Output the sample difference */
+    *entropy->output_ptr[entropy->output_ptr_index[sampn]]++ = (JDIFF)s;
+  }
+
+  if (cinfo->unread_marker != 0) {
+    /* We hit a marker, so back out the output pointers and let the slow path
+     * decode the MCU.  Each output pointer was advanced by MCU_width samples.
+     */
+    cinfo->unread_marker = 0;
+    for (ptrn = 0; ptrn < entropy->num_output_ptrs; ptrn++)
+      entropy->output_ptr[ptrn] -= entropy->output_ptr_info[ptrn].MCU_width;
+    return FALSE;
+  }
+
+  br_state.bytes_in_buffer -= (buffer - br_state.next_input_byte);
+  br_state.next_input_byte = buffer;
+  BITREAD_SAVE_STATE(cinfo, entropy->bitstate);
+  return TRUE;
+}
+
+
+/* The fast path is used only if at least this many bytes per sample remain in
+ * the source buffer.  A sample difference occupies at most 31 bits (a 16-bit
+ * Huffman code followed by 15 additional bits), which may expand to 8 bytes
+ * because of byte stuffing, and FILL_BIT_BUFFER_FAST may read ahead by up to
+ * 13 bytes.
+ */
+#define LBUFSIZE  32
+
+
 /*
  * Decode and return nMCU MCUs' worth of Huffman-compressed differences.
  * Each MCU is also disassembled and placed accordingly in diff_buf.
@@ -208,9 +320,8 @@ decode_mcus(j_decompress_ptr cinfo, JDIFFIMAGE diff_buf,
             JDIMENSION MCU_row_num, JDIMENSION MCU_col_num, JDIMENSION nMCU)
 {
   lhuff_entropy_ptr entropy = (lhuff_entropy_ptr)cinfo->entropy;
-  int sampn, ci, yoffset, MCU_width, ptrn;
+  int ci, yoffset, MCU_width, ptrn;
   JDIMENSION mcu_num;
-  BITREAD_STATE_VARS;
 
   /* Set output pointer locations based on MCU_col_num */
   for (ptrn = 0; ptrn < entropy->num_output_ptrs; ptrn++) {
@@ -238,36 +349,15 @@ decode_mcus(j_decompress_ptr cinfo, JDIFFIMAGE diff_buf,
 
   } else {
 
-    /* Load up working state */
-    BITREAD_LOAD_STATE(cinfo, entropy->bitstate);
-
-    /* Outer loop handles the number of MCUs requested */
+    /* Loop handles the number of MCUs requested */
 
     for (mcu_num = 0; mcu_num < nMCU; mcu_num++) {
-
-      /* Inner loop handles the samples in the MCU */
-      for (sampn = 0; sampn < cinfo->blocks_in_MCU; sampn++) {
-        d_derived_tbl *dctbl = entropy->cur_tbls[sampn];
-        register int s, r;
-
-        /* Section H.2.2: decode the sample difference */
-        HUFF_DECODE(s, br_state, dctbl, return mcu_num, label1);
-        if (s) {
-          if (s == 16)  /* special case: always output 32768 */
-            s = 32768;
-          else {        /* normal case: fetch subsequent bits */
-            CHECK_BIT_BUFFER(br_state, s, return mcu_num);
-            r = GET_BITS(s);
-            s = HUFF_EXTEND(r, s);
-          }
-        }
-
-        /* Output the sample difference */
-        *entropy->output_ptr[entropy->output_ptr_index[sampn]]++ = (JDIFF)s;
-      }
-
-      /* Completed MCU, so update state */
-      BITREAD_SAVE_STATE(cinfo, entropy->bitstate);
+      if (cinfo->src->bytes_in_buffer >=
+          LBUFSIZE * (size_t)cinfo->blocks_in_MCU &&
+          cinfo->unread_marker == 0 && decode_mcu_fast(cinfo))
+        continue;
+      if (!decode_mcu_slow(cinfo))
+        return mcu_num;
     }
   }
 
@@ -296,6 +386,7 @@ jinit_lhuff_decoder(j_decompress_ptr cinfo)
   /* Mark tables unallocated */
   for (i = 0; i < NUM_HUFF_TBLS; i++) {
     entropy->derived_tbls[i] = NULL;
+    entropy->fast_tbls[i] = NULL;
   }
 }
 
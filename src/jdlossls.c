@@ -17,6 +17,9 @@
 #define JPEG_INTERNALS
 #include "jinclude.h"
 #include "jpeglib.h"
+#ifdef WITH_SIMD
+#include "../simd/jsimd.h"
+#endif
 #include "jlossls.h"
 
 #ifdef D_LOSSLESS_SUPPORTED
@@ -163,27 +166,44 @@ jpeg_undifference7(j_decompress_ptr cinfo, int comp_index,
 }
 
 
+#ifdef WITH_SIMD
+
 /*
- * Undifferencer for the first row in a scan or restart interval.  The first
- * sample in the row is undifferenced using the special predictor constant
- * x=2^(P-Pt-1).  The rest of the samples are undifferenced using the
- * 1-D horizontal predictor (1).
+ * SIMD undifferencer for the second and subsequent rows in a scan or restart
+ * interval.  This is used only with predictors 1-5.
  */
 
 METHODDEF(void)
-jpeg_undifference_first_row(j_decompress_ptr cinfo, int comp_index,
-                            JDIFFROW diff_buf, JDIFFROW prev_row,
-                            JDIFFROW undiff_buf, JDIMENSION width)
+simd_undifference(j_decompress_ptr cinfo, int comp_index,
+                  JDIFFROW diff_buf, JDIFFROW prev_row,
+                  JDIFFROW undiff_buf, JDIMENSION width)
 {
   lossless_decomp_ptr losslessd = (lossless_decomp_ptr)cinfo->idct;
 
-  UNDIFFERENCE_1D(INITIAL_PREDICTORx);
+  (*losslessd->undifference_simd) (diff_buf, prev_row, undiff_buf, width,
+                                   INITIAL_PREDICTOR2);
+}
+
+#endif
+
+
+/*
+ * Select the undifferencer that corresponds to the predictor specified in the
+ * scan header.
+ */
+
+LOCAL(void)
+select_undifferencer(j_decompress_ptr cinfo, int comp_index)
+{
+  lossless_decomp_ptr losslessd = (lossless_decomp_ptr)cinfo->idct;
+
+#ifdef WITH_SIMD
+  if (losslessd->undifference_simd) {
+    losslessd->predict_undifference[comp_index] = simd_undifference;
+    return;
+  }
+#endif
 
-  /*
-   * Now that we have undifferenced the first row, we want to use the
-   * undifferencer that corresponds to the predictor specified in the
-   * scan header.
-   */
   switch (cinfo->Ss) {
   case 1:
     losslessd->predict_undifference[comp_index] = jpeg_undifference1;
@@ -213,6 +233,47 @@ jpeg_undifference_first_row(j_decompress_ptr cinfo, int comp_index,
 }
 
 
+/*
+ * Undifferencer for the first row in a scan or restart interval.  The first
+ * sample in the row is undifferenced using the special predictor constant
+ * x=2^(P-Pt-1).  The rest of the samples are undifferenced using the
+ * 1-D horizontal predictor (1).
+ */
+
+METHODDEF(void)
+jpeg_undifference_first_row(j_decompress_ptr cinfo, int comp_index,
+                            JDIFFROW diff_buf, JDIFFROW prev_row,
+                            JDIFFROW undiff_buf, JDIMENSION width)
+{
+  UNDIFFERENCE_1D(INITIAL_PREDICTORx);
+
+  /*
+   * Now that we have undifferenced the first row, we want to use the
+   * undifferencer that corresponds to the predictor specified in the
+   * scan header.
+   */
+  select_undifferencer(cinfo, comp_index);
+}
+
+
+#ifdef WITH_SIMD
+
+METHODDEF(void)
+simd_undifference_first_row(j_decompress_ptr cinfo, int comp_index,
+                            JDIFFROW diff_buf, JDIFFROW prev_row,
+                            JDIFFROW undiff_buf, JDIMENSION width)
+{
+  lossless_decomp_ptr losslessd = (lossless_decomp_ptr)cinfo->idct;
+
+  (*losslessd->undifference_first_row_simd) (diff_buf, prev_row, undiff_buf,
+                                             width, INITIAL_PREDICTORx);
+
+  select_undifferencer(cinfo, comp_index);
+}
+
+#endif
+
+
 /*********************** Sample upscaling by 2^Pt ************************/
 
 METHODDEF(void)
@@ -260,9 +321,23 @@ start_pass_lossless(j_decompress_ptr cinfo)
     ERREXIT4(cinfo, JERR_BAD_PROGRESSION,
              cinfo->Ss, cinfo->Se, cinfo->Ah, cinfo->Al);
 
+#ifdef WITH_SIMD
+  losslessd->undifference_first_row_simd = NULL;
+  losslessd->undifference_simd = NULL;
+  if (jsimd_set_undifference(cinfo, 1,
+                             &losslessd->undifference_first_row_simd))
+    jsimd_set_undifference(cinfo, cinfo->Ss, &losslessd->undifference_simd);
+#endif
+
   /* Set undifference functions to first row function */
-  for (ci = 0; ci < cinfo->num_components; ci++)
-    losslessd->predict_undifference[ci] = jpeg_undifference_first_row;
+  for (ci = 0; ci < cinfo->num_components; ci++) {
+#ifdef WITH_SIMD
+    if (losslessd->undifference_first_row_simd)
+      losslessd->predict_undifference[ci] = simd_undifference_first_row;
+    else
+#endif
+      losslessd->predict_undifference[ci] = jpeg_undifference_first_row;
+  }
 
   /* Set scaler function based on Pt */
   if (cinfo->Al)
@@ -6,7 +6,7 @@
  * Lossless JPEG Modifications:
  * Copyright (C) 1999, Ken Murchison.
  * libjpeg-turbo Modifications:
- * Copyright (C) 2015-2016, 2018-2022, D. R. Commander.
+ * Copyright (C) 2015-2016, 2018-2022, 2026, D. R. Commander.
  * For conditions of distribution and use, see the accompanying README.ijg
  * file.
  *
@@ -26,6 +26,7 @@
 #include "jinclude.h"
 #include "jpeglib.h"
 #include "jdhuff.h"             /* Declarations shared with jd*huff.c */
+#include "jpegapicomp.h"
 #include <limits.h>
 
 
@@ -59,6 +60,13 @@ typedef struct {
   d_derived_tbl *derived_tbls[NUM_HUFF_TBLS];
 
   d_derived_tbl *ac_derived_tbl; /* active table during an AC scan */
+
+  /* Pointers to combined lookup tables for the fast paths (these workspaces
+   * also have image lifespan)
+   */
+  d_fast_tbl *fast_tbls[NUM_HUFF_TBLS];
+
+  d_fast_tbl *ac_fast_tbl;      /* active combined table during an AC scan */
 } phuff_entropy_decoder;
 
 typedef phuff_entropy_decoder *phuff_entropy_ptr;
@@ -72,6 +80,8 @@ METHODDEF(boolean) decode_mcu_DC_refine(j_decompress_ptr cinfo,
                                         JBLOCKROW *MCU_data);
 METHODDEF(boolean) decode_mcu_AC_refine(j_decompress_ptr cinfo,
                                         JBLOCKROW *MCU_data);
+METHODDEF(boolean) decode_mcu_AC_skip(j_decompress_ptr cinfo,
+                                      JBLOCKROW *MCU_data);
 
 
 /*
@@ -155,6 +165,12 @@ start_pass_phuff_decoder(j_decompress_ptr cinfo)
     else
       entropy->pub.decode_mcu = decode_mcu_AC_refine;
   }
+  /* We don't need the ACs if the component is uninteresting or if we're
+   * producing a 1/8th-size image, so we can skip the scan.
+   */
+  if (!is_DC_band && (!cinfo->cur_comp_info[0]->component_needed ||
+                      cinfo->cur_comp_info[0]->_DCT_scaled_size == 1))
+    entropy->pub.decode_mcu = decode_mcu_AC_skip;
 
   for (ci = 0; ci < cinfo->comps_in_scan; ci++) {
     compptr = cinfo->cur_comp_info[ci];
@@ -173,6 +189,12 @@ start_pass_phuff_decoder(j_decompress_ptr cinfo)
       jpeg_make_d_derived_tbl(cinfo, FALSE, tbl, pdtbl);
       /* remember the single active table */
       entropy->ac_derived_tbl = entropy->derived_tbls[tbl];
+      /* the combined table is used only by decode_mcu_AC_first_fast() */
+      if (cinfo->Ah == 0) {
+        jpeg_make_d_fast_tbl(cinfo, FALSE, entropy->ac_derived_tbl,
+                             &entropy->fast_tbls[tbl]);
+        entropy->ac_fast_tbl = entropy->fast_tbls[tbl];
+      }
     }
     /* Initialize DC predictions to 0 */
     entropy->saved.last_dc_val[ci] = 0;
@@ -362,8 +384,8 @@ decode_mcu_DC_first(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
  * or first pass of successive approximation).
  */
 
-METHODDEF(boolean)
-decode_mcu_AC_first(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
+LOCAL(boolean)
+decode_mcu_AC_first_slow(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
 {
   phuff_entropy_ptr entropy = (phuff_entropy_ptr)cinfo->entropy;
   int Se = cinfo->Se;
@@ -374,64 +396,189 @@ decode_mcu_AC_first(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
   BITREAD_STATE_VARS;
   d_derived_tbl *tbl;
 
+  /* Load up working state.
+   * We can avoid loading/saving bitread state if in an EOB run.
+   */
+  EOBRUN = entropy->saved.EOBRUN;       /* only part of saved state we need */
+
+  /* There is always only one block per MCU */
+
+  if (EOBRUN > 0)               /* if it's a band of zeroes... */
+    EOBRUN--;                   /* ...process it now (we do nothing) */
+  else {
+    BITREAD_LOAD_STATE(cinfo, entropy->bitstate);
+    block = MCU_data[0];
+    tbl = entropy->ac_derived_tbl;
+
+    for (k = cinfo->Ss; k <= Se; k++) {
+      HUFF_DECODE(s, br_state, tbl, return FALSE, label2);
+      r = s >> 4;
+      s &= 15;
+      if (s) {
+        k += r;
+        CHECK_BIT_BUFFER(br_state, s, return FALSE);
+        r = GET_BITS(s);
+        s = HUFF_EXTEND(r, s);
+        /* Scale and output coefficient in natural (dezigzagged) order */
+        (*block)[jpeg_natural_order[k]] = (JCOEF)LEFT_SHIFT(s, Al);
+      } else {
+        if (r == 15) {          /* ZRL */
+          k += 15;              /* skip 15 zeroes in band */
+        } else {                /* EOBr, run length is 2^r + appended bits */
+          EOBRUN = 1 << r;
+          if (r) {              /* EOBr, r > 0 */
+            CHECK_BIT_BUFFER(br_state, r, return FALSE);
+            r = GET_BITS(r);
+            EOBRUN += r;
+          }
+          EOBRUN--;             /* this band is processed at this moment */
+          break;                /* force end-of-band */
+        }
+      }
+    }
+
+    BITREAD_SAVE_STATE(cinfo, entropy->bitstate);
+  }
+
+  /* Completed MCU, so update state */
+  entropy->saved.EOBRUN = EOBRUN;       /* only part of saved state we need */
+  return TRUE;
+}
+
+
+/* Fast path for the above, which uses the same approach as decode_mcu_fast()
+ * in jdhuff.c.  Returns FALSE if the MCU must be decoded using the slow path,
+ * either because a marker was encountered or because the data is corrupt (in
+ * which case the slow path generates the appropriate warning.)
+ */
+
+LOCAL(boolean)
+decode_mcu_AC_first_fast(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
+{
+  phuff_entropy_ptr entropy = (phuff_entropy_ptr)cinfo->entropy;
+  int Se = cinfo->Se;
+  int Al = cinfo->Al;
+  register int s, k, r, l;
+  unsigned int EOBRUN;
+  JBLOCKROW block;
+  BITREAD_STATE_VARS;
+  JOCTET *buffer;
+  d_derived_tbl *tbl;
+  d_fast_tbl *ftbl;
+
+  EOBRUN = entropy->saved.EOBRUN;
+
+  if (EOBRUN > 0)
+    EOBRUN--;
+  else {
+    BITREAD_LOAD_STATE(cinfo, entropy->bitstate);
+    buffer = (JOCTET *)br_state.next_input_byte;
+    block = MCU_data[0];
+    tbl = entropy->ac_derived_tbl;
+    ftbl = entropy->ac_fast_tbl;
+
+    for (k = cinfo->Ss; k <= Se; k++) {
+      FILL_BIT_BUFFER_FAST
+      s = ftbl->lookup[PEEK_BITS(HUFF_FAST_BITS)];
+      if (s) {
+        DROP_BITS(FAST_NBITS(s));
+        if (s & FAST_EOB) {
+          r = FAST_RUN(s);
+          EOBRUN = 1 << r;
+          if (r) {
+            FILL_BIT_BUFFER_FAST
+            r = GET_BITS(r);
+            EOBRUN += r;
+          }
+          EOBRUN--;
+          break;
+        }
+        k += FAST_RUN(s);
+        /* Don't store anything for ZRL, since k may now be outside of the
+         * band.
+         */
+        if (FAST_VALUE(s))
+          (*block)[jpeg_natural_order[k]] =
+            (JCOEF)LEFT_SHIFT(FAST_VALUE(s), Al);
+        continue;
+      }
+
+      HUFF_DECODE_FAST(s, l, tbl);
+      if (l > 16)
+        return FALSE;
+      r = s >> 4;
+      s &= 15;
+      if (s) {
+        k += r;
+        FILL_BIT_BUFFER_FAST
+        r = GET_BITS(s);
+        s = HUFF_EXTEND(r, s);
+        (*block)[jpeg_natural_order[k]] = (JCOEF)LEFT_SHIFT(s, Al);
+      } else {
+        if (r == 15) {
+          k += 15;
+        } else {
+          EOBRUN = 1 << r;
+          if (r) {
+            FILL_BIT_BUFFER_FAST
+            r = GET_BITS(r);
+            EOBRUN += r;
+          }
+          EOBRUN--;
+          break;
+        }
+      }
+    }
+
+    if (cinfo->unread_marker != 0) {
+      cinfo->unread_marker = 0;
+      return FALSE;
+    }
+
+    br_state.bytes_in_buffer -= (buffer - br_state.next_input_byte);
+    br_state.next_input_byte = buffer;
+    BITREAD_SAVE_STATE(cinfo, entropy->bitstate);
+  }
+
+  entropy->saved.EOBRUN = EOBRUN;
+  return TRUE;
+}
+
+
+METHODDEF(boolean)
+decode_mcu_AC_first(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
+{
+  phuff_entropy_ptr entropy = (phuff_entropy_ptr)cinfo->entropy;
+  int usefast = 1;
+
   /* Process restart marker if needed; may have to suspend */
   if (cinfo->restart_interval) {
     if (entropy->restarts_to_go == 0)
       if (!process_restart(cinfo))
         return FALSE;
+    /* The fast path cannot read past the RSTn marker that terminates the
+     * restart interval, so we use the slow path for the last MCU in the
+     * interval (refer to decode_mcu() in jdhuff.c.)
+     */
+    if (entropy->restarts_to_go == 1)
+      usefast = 0;
   }
 
+  if (cinfo->src->bytes_in_buffer < BUFSIZE || cinfo->unread_marker != 0)
+    usefast = 0;
+
   /* If we've run out of data, just leave the MCU set to zeroes.
    * This way, we return uniform gray for the remainder of the segment.
    */
   if (!entropy->pub.insufficient_data) {
 
-    /* Load up working state.
-     * We can avoid loading/saving bitread state if in an EOB run.
-     */
-    EOBRUN = entropy->saved.EOBRUN;     /* only part of saved state we need */
-
-    /* There is always only one block per MCU */
-
-    if (EOBRUN > 0)             /* if it's a band of zeroes... */
-      EOBRUN--;                 /* ...process it now (we do nothing) */
-    else {
-      BITREAD_LOAD_STATE(cinfo, entropy->bitstate);
-      block = MCU_data[0];
-      tbl = entropy->ac_derived_tbl;
-
-      for (k = cinfo->Ss; k <= Se; k++) {
-        HUFF_DECODE(s, br_state, tbl, return FALSE, label2);
-        r = s >> 4;
-        s &= 15;
-        if (s) {
-          k += r;
-          CHECK_BIT_BUFFER(br_state, s, return FALSE);
-          r = GET_BITS(s);
-          s = HUFF_EXTEND(r, s);
-          /* Scale and output coefficient in natural (dezigzagged) order */
-          (*block)[jpeg_natural_order[k]] = (JCOEF)LEFT_SHIFT(s, Al);
-        } else {
-          if (r == 15) {        /* ZRL */
-            k += 15;            /* skip 15 zeroes in band */
-          } else {              /* EOBr, run length is 2^r + appended bits */
-            EOBRUN = 1 << r;
-            if (r) {            /* EOBr, r > 0 */
-              CHECK_BIT_BUFFER(br_state, r, return FALSE);
-              r = GET_BITS(r);
-              EOBRUN += r;
-            }
-            EOBRUN--;           /* this band is processed at this moment */
-            break;              /* force end-of-band */
-          }
-        }
-      }
-
-      BITREAD_SAVE_STATE(cinfo, entropy->bitstate);
+    if (usefast) {
+      if (!decode_mcu_AC_first_fast(cinfo, MCU_data)) goto use_slow;
+    } else {
+use_slow:
+      if (!decode_mcu_AC_first_slow(cinfo, MCU_data)) return FALSE;
     }
 
-    /* Completed MCU, so update state */
-    entropy->saved.EOBRUN = EOBRUN;     /* only part of saved state we need */
   }
 
   /* Account for restart interval (no-op if not using restarts) */
@@ -498,8 +645,8 @@ decode_mcu_DC_refine(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
  * MCU decoding for AC successive approximation refinement scan.
  */
 
-METHODDEF(boolean)
-decode_mcu_AC_refine(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
+LOCAL(boolean)
+decode_mcu_AC_refine_slow(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
 {
   phuff_entropy_ptr entropy = (phuff_entropy_ptr)cinfo->entropy;
   int Se = cinfo->Se;
@@ -514,130 +661,243 @@ decode_mcu_AC_refine(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
   int num_newnz;
   int newnz_pos[DCTSIZE2];
 
-  /* Process restart marker if needed; may have to suspend */
-  if (cinfo->restart_interval) {
-    if (entropy->restarts_to_go == 0)
-      if (!process_restart(cinfo))
-        return FALSE;
-  }
+  /* Load up working state */
+  BITREAD_LOAD_STATE(cinfo, entropy->bitstate);
+  EOBRUN = entropy->saved.EOBRUN; /* only part of saved state we need */
 
-  /* If we've run out of data, don't modify the MCU.
-   */
-  if (!entropy->pub.insufficient_data) {
+  /* There is always only one block per MCU */
+  block = MCU_data[0];
+  tbl = entropy->ac_derived_tbl;
 
-    /* Load up working state */
-    BITREAD_LOAD_STATE(cinfo, entropy->bitstate);
-    EOBRUN = entropy->saved.EOBRUN; /* only part of saved state we need */
+  /* If we are forced to suspend, we must undo the assignments to any newly
+   * nonzero coefficients in the block, because otherwise we'd get confused
+   * next time about which coefficients were already nonzero.
+   * But we need not undo addition of bits to already-nonzero coefficients;
+   * instead, we can test the current bit to see if we already did it.
+   */
+  num_newnz = 0;
 
-    /* There is always only one block per MCU */
-    block = MCU_data[0];
-    tbl = entropy->ac_derived_tbl;
+  /* initialize coefficient loop counter to start of band */
+  k = cinfo->Ss;
 
-    /* If we are forced to suspend, we must undo the assignments to any newly
-     * nonzero coefficients in the block, because otherwise we'd get confused
-     * next time about which coefficients were already nonzero.
-     * But we need not undo addition of bits to already-nonzero coefficients;
-     * instead, we can test the current bit to see if we already did it.
-     */
-    num_newnz = 0;
-
-    /* initialize coefficient loop counter to start of band */
-    k = cinfo->Ss;
-
-    if (EOBRUN == 0) {
-      for (; k <= Se; k++) {
-        HUFF_DECODE(s, br_state, tbl, goto undoit, label3);
-        r = s >> 4;
-        s &= 15;
-        if (s) {
-          if (s != 1)           /* size of new coef should always be 1 */
-            WARNMS(cinfo, JWRN_HUFF_BAD_CODE);
+  if (EOBRUN == 0) {
+    for (; k <= Se; k++) {
+      HUFF_DECODE(s, br_state, tbl, goto undoit, label3);
+      r = s >> 4;
+      s &= 15;
+      if (s) {
+        if (s != 1)             /* size of new coef should always be 1 */
+          WARNMS(cinfo, JWRN_HUFF_BAD_CODE);
+        CHECK_BIT_BUFFER(br_state, 1, goto undoit);
+        if (GET_BITS(1))
+          s = p1;               /* newly nonzero coef is positive */
+        else
+          s = m1;               /* newly nonzero coef is negative */
+      } else {
+        if (r != 15) {
+          EOBRUN = 1 << r;      /* EOBr, run length is 2^r + appended bits */
+          if (r) {
+            CHECK_BIT_BUFFER(br_state, r, goto undoit);
+            r = GET_BITS(r);
+            EOBRUN += r;
+          }
+          break;                /* rest of block is handled by EOB logic */
+        }
+        /* note s = 0 for processing ZRL */
+      }
+      /* Advance over already-nonzero coefs and r still-zero coefs,
+       * appending correction bits to the nonzeroes.  A correction bit is 1
+       * if the absolute value of the coefficient must be increased.
+       */
+      do {
+        thiscoef = *block + jpeg_natural_order[k];
+        if (*thiscoef != 0) {
           CHECK_BIT_BUFFER(br_state, 1, goto undoit);
-          if (GET_BITS(1))
-            s = p1;             /* newly nonzero coef is positive */
-          else
-            s = m1;             /* newly nonzero coef is negative */
-        } else {
-          if (r != 15) {
-            EOBRUN = 1 << r;    /* EOBr, run length is 2^r + appended bits */
-            if (r) {
-              CHECK_BIT_BUFFER(br_state, r, goto undoit);
-              r = GET_BITS(r);
-              EOBRUN += r;
+          if (GET_BITS(1)) {
+            if ((*thiscoef & p1) == 0) { /* do nothing if already set it */
+              if (*thiscoef >= 0)
+                *thiscoef += (JCOEF)p1;
+              else
+                *thiscoef += (JCOEF)m1;
             }
-            break;              /* rest of block is handled by EOB logic */
           }
-          /* note s = 0 for processing ZRL */
+        } else {
+          if (--r < 0)
+            break;              /* reached target zero coefficient */
         }
-        /* Advance over already-nonzero coefs and r still-zero coefs,
-         * appending correction bits to the nonzeroes.  A correction bit is 1
-         * if the absolute value of the coefficient must be increased.
-         */
-        do {
-          thiscoef = *block + jpeg_natural_order[k];
-          if (*thiscoef != 0) {
-            CHECK_BIT_BUFFER(br_state, 1, goto undoit);
-            if (GET_BITS(1)) {
-              if ((*thiscoef & p1) == 0) { /* do nothing if already set it */
-                if (*thiscoef >= 0)
-                  *thiscoef += (JCOEF)p1;
-                else
-                  *thiscoef += (JCOEF)m1;
-              }
-            }
-          } else {
-            if (--r < 0)
-              break;            /* reached target zero coefficient */
+        k++;
+      } while (k <= Se);
+      if (s) {
+        int pos = jpeg_natural_order[k];
+        /* Output newly nonzero coefficient */
+        (*block)[pos] = (JCOEF)s;
+        /* Remember its position in case we have to suspend */
+        newnz_pos[num_newnz++] = pos;
+      }
+    }
+  }
+
+  if (EOBRUN > 0) {
+    /* Scan any remaining coefficient positions after the end-of-band
+     * (the last newly nonzero coefficient, if any).  Append a correction
+     * bit to each already-nonzero coefficient.  A correction bit is 1
+     * if the absolute value of the coefficient must be increased.
+     */
+    for (; k <= Se; k++) {
+      thiscoef = *block + jpeg_natural_order[k];
+      if (*thiscoef != 0) {
+        CHECK_BIT_BUFFER(br_state, 1, goto undoit);
+        if (GET_BITS(1)) {
+          if ((*thiscoef & p1) == 0) { /* do nothing if already changed it */
+            if (*thiscoef >= 0)
+              *thiscoef += (JCOEF)p1;
+            else
+              *thiscoef += (JCOEF)m1;
           }
-          k++;
-        } while (k <= Se);
-        if (s) {
-          int pos = jpeg_natural_order[k];
-          /* Output newly nonzero coefficient */
-          (*block)[pos] = (JCOEF)s;
-          /* Remember its position in case we have to suspend */
-          newnz_pos[num_newnz++] = pos;
         }
       }
     }
+    /* Count one block completed in EOB run */
+    EOBRUN--;
+  }
 
-    if (EOBRUN > 0) {
-      /* Scan any remaining coefficient positions after the end-of-band
-       * (the last newly nonzero coefficient, if any).  Append a correction
-       * bit to each already-nonzero coefficient.  A correction bit is 1
-       * if the absolute value of the coefficient must be increased.
+  /* Completed MCU, so update state */
+  BITREAD_SAVE_STATE(cinfo, entropy->bitstate);
+  entropy->saved.EOBRUN = EOBRUN; /* only part of saved state we need */
+  return TRUE;
+
+undoit:
+  /* Re-zero any output coefficients that we made newly nonzero */
+  while (num_newnz > 0)
+    (*block)[newnz_pos[--num_newnz]] = 0;
+
+  return FALSE;
+}
+
+
+/* Fast path for the above.  Returns FALSE if the MCU must be decoded using the
+ * slow path, either because a marker was encountered or because the data is
+ * corrupt.  As with suspension in the slow path, any newly nonzero
+ * coefficients are re-zeroed, and correction bits that were already applied
+ * will be detected and skipped by the slow path.
+ */
+
+LOCAL(boolean)
+decode_mcu_AC_refine_fast(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
+{
+  phuff_entropy_ptr entropy = (phuff_entropy_ptr)cinfo->entropy;
+  int Se = cinfo->Se;
+  int p1 = 1 << cinfo->Al;
+  int m1 = (NEG_1) << cinfo->Al;
+  register int s, k, r, l;
+  unsigned int EOBRUN;
+  JBLOCKROW block;
+  JCOEFPTR thiscoef;
+  BITREAD_STATE_VARS;
+  JOCTET *buffer;
+  d_derived_tbl *tbl;
+  int num_newnz;
+  int newnz_pos[DCTSIZE2];
+
+  BITREAD_LOAD_STATE(cinfo, entropy->bitstate);
+  buffer = (JOCTET *)br_state.next_input_byte;
+  EOBRUN = entropy->saved.EOBRUN;
+
+  block = MCU_data[0];
+  tbl = entropy->ac_derived_tbl;
+  num_newnz = 0;
+  k = cinfo->Ss;
+
+  if (EOBRUN == 0) {
+    for (; k <= Se; k++) {
+      HUFF_DECODE_FAST(s, l, tbl);
+      if (l > 16)
+        goto undoit;
+      r = s >> 4;
+      s &= 15;
+      if (s) {
+        /* Let the slow path generate the warning for a bad coefficient
+         * size.
+         */
+        if (s != 1)
+          goto undoit;
+        FILL_BIT_BUFFER_FAST
+        if (GET_BITS(1))
+          s = p1;
+        else
+          s = m1;
+      } else {
+        if (r != 15) {
+          EOBRUN = 1 << r;
+          if (r) {
+            FILL_BIT_BUFFER_FAST
+            r = GET_BITS(r);
+            EOBRUN += r;
+          }
+          break;
+        }
+      }
+      /* Correction bits are read one at a time, so it is faster to refill
+       * the bit buffer only when it is empty.
        */
-      for (; k <= Se; k++) {
+      do {
         thiscoef = *block + jpeg_natural_order[k];
         if (*thiscoef != 0) {
-          CHECK_BIT_BUFFER(br_state, 1, goto undoit);
+          if (bits_left < 1)
+            FILL_BIT_BUFFER_FAST
           if (GET_BITS(1)) {
-            if ((*thiscoef & p1) == 0) { /* do nothing if already changed it */
+            if ((*thiscoef & p1) == 0) {
               if (*thiscoef >= 0)
                 *thiscoef += (JCOEF)p1;
               else
                 *thiscoef += (JCOEF)m1;
             }
           }
+        } else {
+          if (--r < 0)
+            break;
         }
+        k++;
+      } while (k <= Se);
+      if (s) {
+        int pos = jpeg_natural_order[k];
+        (*block)[pos] = (JCOEF)s;
+        newnz_pos[num_newnz++] = pos;
       }
-      /* Count one block completed in EOB run */
-      EOBRUN--;
     }
+  }
 
-    /* Completed MCU, so update state */
-    BITREAD_SAVE_STATE(cinfo, entropy->bitstate);
-    entropy->saved.EOBRUN = EOBRUN; /* only part of saved state we need */
+  if (EOBRUN > 0) {
+    for (; k <= Se; k++) {
+      thiscoef = *block + jpeg_natural_order[k];
+      if (*thiscoef != 0) {
+        if (bits_left < 1)
+          FILL_BIT_BUFFER_FAST
+        if (GET_BITS(1)) {
+          if ((*thiscoef & p1) == 0) {
+            if (*thiscoef >= 0)
+              *thiscoef += (JCOEF)p1;
+            else
+              *thiscoef += (JCOEF)m1;
+          }
+        }
+      }
+    }
+    EOBRUN--;
   }
 
-  /* Account for restart interval (no-op if not using restarts) */
-  if (cinfo->restart_interval)
-    entropy->restarts_to_go--;
+  if (cinfo->unread_marker != 0) {
+    cinfo->unread_marker = 0;
+    goto undoit;
+  }
 
+  br_state.bytes_in_buffer -= (buffer - br_state.next_input_byte);
+  br_state.next_input_byte = buffer;
+  BITREAD_SAVE_STATE(cinfo, entropy->bitstate);
+  entropy->saved.EOBRUN = EOBRUN;
   return TRUE;
 
 undoit:
-  /* Re-zero any output coefficients that we made newly nonzero */
   while (num_newnz > 0)
     (*block)[newnz_pos[--num_newnz]] = 0;
 
@@ -645,6 +905,120 @@ undoit:
 }
 
 
+METHODDEF(boolean)
+decode_mcu_AC_refine(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
+{
+  phuff_entropy_ptr entropy = (phuff_entropy_ptr)cinfo->entropy;
+  int usefast = 1;
+
+  /* Process restart marker if needed; may have to suspend */
+  if (cinfo->restart_interval) {
+    if (entropy->restarts_to_go == 0)
+      if (!process_restart(cinfo))
+        return FALSE;
+    if (entropy->restarts_to_go == 1)
+      usefast = 0;
+  }
+
+  if (cinfo->src->bytes_in_buffer < BUFSIZE || cinfo->unread_marker != 0)
+    usefast = 0;
+
+  /* If we've run out of data, don't modify the MCU.
+   */
+  if (!entropy->pub.insufficient_data) {
+
+    if (usefast) {
+      if (!decode_mcu_AC_refine_fast(cinfo, MCU_data)) goto use_slow;
+    } else {
+use_slow:
+      if (!decode_mcu_AC_refine_slow(cinfo, MCU_data)) return FALSE;
+    }
+
+  }
+
+  /* Account for restart interval (no-op if not using restarts) */
+  if (cinfo->restart_interval)
+    entropy->restarts_to_go--;
+
+  return TRUE;
+}
+
+
+/*
+ * MCU "decoding" for an AC scan whose coefficients are not needed.  Rather
+ * than decoding the scan, we search for the marker that terminates each
+ * restart interval (or the scan), which is much faster than Huffman decoding.
+ * The coefficients are left unchanged.
+ */
+
+METHODDEF(boolean)
+decode_mcu_AC_skip(j_decompress_ptr cinfo, JBLOCKROW *MCU_data)
+{
+  phuff_entropy_ptr entropy = (phuff_entropy_ptr)cinfo->entropy;
+  struct jpeg_source_mgr *datasrc = cinfo->src;
+  const JOCTET *next_input_byte, *ptr;
+  size_t bytes_in_buffer;
+  int c;
+
+  /* Process restart marker if needed; may have to suspend */
+  if (cinfo->restart_interval) {
+    if (entropy->restarts_to_go == 0)
+      if (!process_restart(cinfo))
+        return FALSE;
+  }
+
+  /* Skip to the next marker, unless we are already up against one.  We
+   * update the data source only after consuming an entire run of data bytes
+   * or an entire stuffed zero byte, so if we have to suspend, then we resume
+   * at a point where the search can be restarted.
+   */
+  next_input_byte = datasrc->next_input_byte;
+  bytes_in_buffer = datasrc->bytes_in_buffer;
+  while (cinfo->unread_marker == 0) {
+    if (bytes_in_buffer == 0) {
+      if (!(*datasrc->fill_input_buffer) (cinfo))
+        return FALSE;
+      next_input_byte = datasrc->next_input_byte;
+      bytes_in_buffer = datasrc->bytes_in_buffer;
+    }
+    ptr = (const JOCTET *)memchr(next_input_byte, 0xFF, bytes_in_buffer);
+    if (ptr == NULL) {
+      next_input_byte += bytes_in_buffer;
+      bytes_in_buffer = 0;
+    } else {
+      bytes_in_buffer -= ptr - next_input_byte + 1;
+      next_input_byte = ptr + 1;
+      /* Read the byte after the FF.  (Any number of FF fill bytes may
+       * precede a marker.)
+       */
+      do {
+        if (bytes_in_buffer == 0) {
+          if (!(*datasrc->fill_input_buffer) (cinfo))
+            return FALSE;
+          next_input_byte = datasrc->next_input_byte;
+          bytes_in_buffer = datasrc->bytes_in_buffer;
+        }
+        c = *next_input_byte++;
+        bytes_in_buffer--;
+      } while (c == 0xFF);
+      /* A zero byte is a stuffed zero.  Anything else is a marker, which
+       * will be read by read_restart_marker() or read_markers().
+       */
+      if (c != 0)
+        cinfo->unread_marker = c;
+    }
+    datasrc->next_input_byte = next_input_byte;
+    datasrc->bytes_in_buffer = bytes_in_buffer;
+  }
+
+  /* Account for restart interval (no-op if not using restarts) */
+  if (cinfo->restart_interval)
+    entropy->restarts_to_go--;
+
+  return TRUE;
+}
+
+
 /*
  * Module initialization routine for progressive Huffman entropy decoding.
  */
@@ -661,10 +1035,12 @@ jinit_phuff_decoder(j_decompress_ptr cinfo)
                                 sizeof(phuff_entropy_decoder));
   cinfo->entropy = (struct jpeg_entropy_decoder *)entropy;
   entropy->pub.start_pass = start_pass_phuff_decoder;
+  entropy->pub.last_nonzero = NULL;
 
   /* Mark derived tables unallocated */
   for (i = 0; i < NUM_HUFF_TBLS; i++) {
     entropy->derived_tbls[i] = NULL;
+    entropy->fast_tbls[i] = NULL;
   }
 
   /* Create progression status table */
@@ -504,14 +504,14 @@ _jinit_upsampler(j_decompress_ptr cinfo)
     } else if (h_in_group * 2 == h_out_group && v_in_group == v_out_group) {
       /* Special cases for 2h1v upsampling */
       if (do_fancy && compptr->downsampled_width > 2) {
-#ifdef WITH_SIMD
-        if (jsimd_set_h2v1_fancy_upsample(cinfo))
-          upsample->methods[ci] = jsimd_h2v1_fancy_upsample;
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE != 16
+        if (_jsimd_set_h2v1_fancy_upsample(cinfo))
+          upsample->methods[ci] = _jsimd_h2v1_fancy_upsample;
         else
 #endif
           upsample->methods[ci] = h2v1_fancy_upsample;
       } else {
-#ifdef WITH_SIMD
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
         if (jsimd_set_h2v1_upsample(cinfo))
           upsample->methods[ci] = jsimd_h2v1_upsample;
         else
@@ -521,7 +521,8 @@ _jinit_upsampler(j_decompress_ptr cinfo)
     } else if (h_in_group == h_out_group &&
                v_in_group * 2 == v_out_group && do_fancy) {
       /* Non-fancy upsampling is handled by the generic method */
-#if defined(WITH_SIMD) && (SIMD_ARCHITECTURE == ARM64 || SIMD_ARCHITECTURE == ARM)
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8 && \
+    (SIMD_ARCHITECTURE == ARM64 || SIMD_ARCHITECTURE == ARM)
       if (jsimd_set_h1v2_fancy_upsample(cinfo))
         upsample->methods[ci] = jsimd_h1v2_fancy_upsample;
       else
@@ -532,15 +533,15 @@ _jinit_upsampler(j_decompress_ptr cinfo)
                v_in_group * 2 == v_out_group) {
       /* Special cases for 2h2v upsampling */
       if (do_fancy && compptr->downsampled_width > 2) {
-#ifdef WITH_SIMD
-        if (jsimd_set_h2v2_fancy_upsample(cinfo))
-          upsample->methods[ci] = jsimd_h2v2_fancy_upsample;
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE != 16
+        if (_jsimd_set_h2v2_fancy_upsample(cinfo))
+          upsample->methods[ci] = _jsimd_h2v2_fancy_upsample;
         else
 #endif
           upsample->methods[ci] = h2v2_fancy_upsample;
         upsample->pub.need_context_rows = TRUE;
       } else {
-#ifdef WITH_SIMD
+#if defined(WITH_SIMD) && BITS_IN_JSAMPLE == 8
         if (jsimd_set_h2v2_upsample(cinfo))
           upsample->methods[ci] = jsimd_h2v2_upsample;
         else
@@ -386,4 +386,231 @@ _jpeg_idct_ifast(j_decompress_ptr cinfo, jpeg_component_info *compptr,
   }
 }
 
+/*
+ * Perform dequantization and inverse DCT on a block of coefficients in which
+ * all of the AC coefficients are zero.  The output is identical to that of
+ * _jpeg_idct_ifast(), which reduces to this for such blocks.
+ */
+
+GLOBAL(void)
+_jpeg_idct_ifast_dconly(j_decompress_ptr cinfo, jpeg_component_info *compptr,
+                        JCOEFPTR coef_block, _JSAMPARRAY output_buf,
+                        JDIMENSION output_col)
+{
+  IFAST_MULT_TYPE *quantptr = (IFAST_MULT_TYPE *)compptr->dct_table;
+  _JSAMPROW outptr;
+  _JSAMPLE *range_limit = IDCT_range_limit(cinfo);
+  _JSAMPLE outval;
+  int ctr, dcval;
+  SHIFT_TEMPS                   /* for DESCALE */
+  ISHIFT_TEMPS                  /* for IDESCALE */
+  SCALING_FACTOR
+
+  dcval = (int)DEQUANTIZE(coef_block[0], quantptr[0]);
+  dcval = IDESCALE(dcval, PASS1_BITS + 3);
+
+  /* Let the regular IDCT method handle wildly out-of-range outputs.  (Refer to
+   * the comment in _jpeg_idct_islow_dconly().)
+   */
+  if (dcval < -2 * (_MAXJSAMPLE + 1) || dcval >= 2 * (_MAXJSAMPLE + 1)) {
+    (*cinfo->idct->_inverse_DCT[compptr->component_index])
+      (cinfo, compptr, coef_block, output_buf, output_col);
+    return;
+  }
+  outval = range_limit[dcval & RANGE_MASK];
+
+  for (ctr = 0; ctr < DCTSIZE; ctr++) {
+    outptr = output_buf[ctr] + output_col;
+    outptr[0] = outval;
+    outptr[1] = outval;
+    outptr[2] = outval;
+    outptr[3] = outval;
+    outptr[4] = outval;
+    outptr[5] = outval;
+    outptr[6] = outval;
+    outptr[7] = outval;
+  }
+}
+
+
+/*
+ * Perform dequantization and inverse DCT on a block of coefficients in which
+ * all of the nonzero coefficients are within the upper left 4x4 quadrant.
+ * This is _jpeg_idct_ifast() with the terms that are known to be zero removed,
+ * so the output is identical.
+ */
+
+GLOBAL(void)
+_jpeg_idct_ifast_sparse(j_decompress_ptr cinfo, jpeg_component_info *compptr,
+                        JCOEFPTR coef_block, _JSAMPARRAY output_buf,
+                        JDIMENSION output_col)
+{
+  DCTELEM tmp0, tmp1, tmp2, tmp3, tmp4, tmp5, tmp6, tmp7;
+  DCTELEM tmp10, tmp11, tmp12, tmp13;
+  DCTELEM z5, z10, z11, z13;
+  JCOEFPTR inptr;
+  IFAST_MULT_TYPE *quantptr;
+  int *wsptr;
+  _JSAMPROW outptr;
+  _JSAMPLE *range_limit = IDCT_range_limit(cinfo);
+  int ctr;
+  int workspace[DCTSIZE2];      /* buffers data between passes */
+  SHIFT_TEMPS                   /* for DESCALE */
+  ISHIFT_TEMPS                  /* for IDESCALE */
+  SCALING_FACTOR
+
+  /* Pass 1: process columns from input, store into work array.  Only the
+   * first 4 columns are nonzero, and only the first 4 rows of each column are
+   * nonzero.
+   */
+
+  inptr = coef_block;
+  quantptr = (IFAST_MULT_TYPE *)compptr->dct_table;
+  wsptr = workspace;
+  for (ctr = DCTSIZE / 2; ctr > 0; ctr--) {
+    if (inptr[DCTSIZE * 1] == 0 && inptr[DCTSIZE * 2] == 0 &&
+        inptr[DCTSIZE * 3] == 0) {
+      /* AC terms all zero */
+      int dcval = (int)DEQUANTIZE(inptr[DCTSIZE * 0], quantptr[DCTSIZE * 0]);
+
+      wsptr[DCTSIZE * 0] = dcval;
+      wsptr[DCTSIZE * 1] = dcval;
+      wsptr[DCTSIZE * 2] = dcval;
+      wsptr[DCTSIZE * 3] = dcval;
+      wsptr[DCTSIZE * 4] = dcval;
+      wsptr[DCTSIZE * 5] = dcval;
+      wsptr[DCTSIZE * 6] = dcval;
+      wsptr[DCTSIZE * 7] = dcval;
+
+      inptr++;                  /* advance pointers to next column */
+      quantptr++;
+      wsptr++;
+      continue;
+    }
+
+    /* Even part: y4 and y6 are zero. */
+
+    tmp10 = DEQUANTIZE(inptr[DCTSIZE * 0], quantptr[DCTSIZE * 0]);
+    tmp13 = DEQUANTIZE(inptr[DCTSIZE * 2], quantptr[DCTSIZE * 2]);
+
+    tmp12 = MULTIPLY(tmp13, FIX_1_414213562) - tmp13; /* 2*c4 */
+
+    tmp0 = tmp10 + tmp13;       /* phase 2 */
+    tmp3 = tmp10 - tmp13;
+    tmp1 = tmp10 + tmp12;
+    tmp2 = tmp10 - tmp12;
+
+    /* Odd part: y5 and y7 are zero. */
+
+    z11 = DEQUANTIZE(inptr[DCTSIZE * 1], quantptr[DCTSIZE * 1]);
+    z13 = DEQUANTIZE(inptr[DCTSIZE * 3], quantptr[DCTSIZE * 3]);
+    z10 = -z13;
+
+    tmp7 = z11 + z13;           /* phase 5 */
+    tmp11 = MULTIPLY(z11 - z13, FIX_1_414213562); /* 2*c4 */
+
+    z5 = MULTIPLY(z10 + z11, FIX_1_847759065); /* 2*c2 */
+    tmp10 = MULTIPLY(z11, FIX_1_082392200) - z5; /* 2*(c2-c6) */
+    tmp12 = MULTIPLY(z10, -FIX_2_613125930) + z5; /* -2*(c2+c6) */
+
+    tmp6 = tmp12 - tmp7;        /* phase 2 */
+    tmp5 = tmp11 - tmp6;
+    tmp4 = tmp10 + tmp5;
+
+    wsptr[DCTSIZE * 0] = (int)(tmp0 + tmp7);
+    wsptr[DCTSIZE * 7] = (int)(tmp0 - tmp7);
+    wsptr[DCTSIZE * 1] = (int)(tmp1 + tmp6);
+    wsptr[DCTSIZE * 6] = (int)(tmp1 - tmp6);
+    wsptr[DCTSIZE * 2] = (int)(tmp2 + tmp5);
+    wsptr[DCTSIZE * 5] = (int)(tmp2 - tmp5);
+    wsptr[DCTSIZE * 4] = (int)(tmp3 + tmp4);
+    wsptr[DCTSIZE * 3] = (int)(tmp3 - tmp4);
+
+    inptr++;                    /* advance pointers to next column */
+    quantptr++;
+    wsptr++;
+  }
+
+  /* Pass 2: process rows from work array, store into output array.  Only the
+   * first 4 columns of the work array were filled in, and the rest are
+   * treated as zero.
+   */
+
+  wsptr = workspace;
+  for (ctr = 0; ctr < DCTSIZE; ctr++) {
+    outptr = output_buf[ctr] + output_col;
+
+#ifndef NO_ZERO_ROW_TEST
+    if (wsptr[1] == 0 && wsptr[2] == 0 && wsptr[3] == 0) {
+      /* AC terms all zero */
+      _JSAMPLE dcval =
+        range_limit[IDESCALE(wsptr[0], PASS1_BITS + 3) & RANGE_MASK];
+
+      outptr[0] = dcval;
+      outptr[1] = dcval;
+      outptr[2] = dcval;
+      outptr[3] = dcval;
+      outptr[4] = dcval;
+      outptr[5] = dcval;
+      outptr[6] = dcval;
+      outptr[7] = dcval;
+
+      wsptr += DCTSIZE;         /* advance pointer to next row */
+      continue;
+    }
+#endif
+
+    /* Even part: y4 and y6 are zero. */
+
+    tmp10 = (DCTELEM)wsptr[0];
+    tmp13 = (DCTELEM)wsptr[2];
+
+    tmp12 = MULTIPLY(tmp13, FIX_1_414213562) - tmp13;
+
+    tmp0 = tmp10 + tmp13;
+    tmp3 = tmp10 - tmp13;
+    tmp1 = tmp10 + tmp12;
+    tmp2 = tmp10 - tmp12;
+
+    /* Odd part: y5 and y7 are zero. */
+
+    z11 = (DCTELEM)wsptr[1];
+    z13 = (DCTELEM)wsptr[3];
+    z10 = -z13;
+
+    tmp7 = z11 + z13;           /* phase 5 */
+    tmp11 = MULTIPLY(z11 - z13, FIX_1_414213562); /* 2*c4 */
+
+    z5 = MULTIPLY(z10 + z11, FIX_1_847759065); /* 2*c2 */
+    tmp10 = MULTIPLY(z11, FIX_1_082392200) - z5; /* 2*(c2-c6) */
+    tmp12 = MULTIPLY(z10, -FIX_2_613125930) + z5; /* -2*(c2+c6) */
+
+    tmp6 = tmp12 - tmp7;        /* phase 2 */
+    tmp5 = tmp11 - tmp6;
+    tmp4 = tmp10 + tmp5;
+
+    /* Final output stage: scale down by a factor of 8 and range-limit */
+
+    outptr[0] =
+      range_limit[IDESCALE(tmp0 + tmp7, PASS1_BITS + 3) & RANGE_MASK];
+    outptr[7] =
+      range_limit[IDESCALE(tmp0 - tmp7, PASS1_BITS + 3) & RANGE_MASK];
+    outptr[1] =
+      range_limit[IDESCALE(tmp1 + tmp6, PASS1_BITS + 3) & RANGE_MASK];
+    outptr[6] =
+      range_limit[IDESCALE(tmp1 - tmp6, PASS1_BITS + 3) & RANGE_MASK];
+    outptr[2] =
+      range_limit[IDESCALE(tmp2 + tmp5, PASS1_BITS + 3) & RANGE_MASK];
+    outptr[5] =
+      range_limit[IDESCALE(tmp2 - tmp5, PASS1_BITS + 3) & RANGE_MASK];
+    outptr[4] =
+      range_limit[IDESCALE(tmp3 + tmp4, PASS1_BITS + 3) & RANGE_MASK];
+    outptr[3] =
+      range_limit[IDESCALE(tmp3 - tmp4, PASS1_BITS + 3) & RANGE_MASK];
+
+    wsptr += DCTSIZE;           /* advance pointer to next row */
+  }
+}
+
+
 #endif /* DCT_IFAST_SUPPORTED */
@@ -435,6 +435,262 @@ _jpeg_idct_islow(j_decompress_ptr cinfo, jpeg_component_info *compptr,
   }
 }
 
+/*
+ * Perform dequantization and inverse DCT on a block of coefficients in which
+ * all of the AC coefficients are zero.  The output is identical to that of
+ * _jpeg_idct_islow(), which reduces to this for such blocks.
+ */
+
+GLOBAL(void)
+_jpeg_idct_islow_dconly(j_decompress_ptr cinfo, jpeg_component_info *compptr,
+                        JCOEFPTR coef_block, _JSAMPARRAY output_buf,
+                        JDIMENSION output_col)
+{
+  ISLOW_MULT_TYPE *quantptr = (ISLOW_MULT_TYPE *)compptr->dct_table;
+  _JSAMPROW outptr;
+  _JSAMPLE *range_limit = IDCT_range_limit(cinfo);
+  _JSAMPLE outval;
+  int ctr, dcval;
+  SHIFT_TEMPS
+  SCALING_FACTOR
+
+  dcval = LEFT_SHIFT(DEQUANTIZE(coef_block[0], quantptr[0]), PASS1_BITS);
+  dcval = (int)DESCALE((JLONG)dcval, PASS1_BITS + 3);
+
+  /* The range-limiting table clamps IDCT outputs that are moderately out of
+   * range, but the SIMD implementations of the IDCT also clamp outputs that
+   * are wildly out of range.  Such outputs can only occur with corrupt JPEG
+   * images, so we let the regular IDCT method handle them.  That ensures that
+   * the output is the same regardless of which method is used.
+   */
+  if (dcval < -2 * (_MAXJSAMPLE + 1) || dcval >= 2 * (_MAXJSAMPLE + 1)) {
+    (*cinfo->idct->_inverse_DCT[compptr->component_index])
+      (cinfo, compptr, coef_block, output_buf, output_col);
+    return;
+  }
+  outval = range_limit[dcval & RANGE_MASK];
+
+  for (ctr = 0; ctr < DCTSIZE; ctr++) {
+    outptr = output_buf[ctr] + output_col;
+    outptr[0] = outval;
+    outptr[1] = outval;
+    outptr[2] = outval;
+    outptr[3] = outval;
+    outptr[4] = outval;
+    outptr[5] = outval;
+    outptr[6] = outval;
+    outptr[7] = outval;
+  }
+}
+
+
+/*
+ * Perform dequantization and inverse DCT on a block of coefficients in which
+ * all of the nonzero coefficients are within the upper left 4x4 quadrant.
+ * This is _jpeg_idct_islow() with the terms that are known to be zero removed,
+ * so the output is identical.
+ */
+
+GLOBAL(void)
+_jpeg_idct_islow_sparse(j_decompress_ptr cinfo, jpeg_component_info *compptr,
+                        JCOEFPTR coef_block, _JSAMPARRAY output_buf,
+                        JDIMENSION output_col)
+{
+  JLONG tmp0, tmp1, tmp2, tmp3;
+  JLONG tmp10, tmp11, tmp12, tmp13;
+  JLONG z1, z2, z3, z4, z5;
+  JCOEFPTR inptr;
+  ISLOW_MULT_TYPE *quantptr;
+  int *wsptr;
+  _JSAMPROW outptr;
+  _JSAMPLE *range_limit = IDCT_range_limit(cinfo);
+  int ctr;
+  int workspace[DCTSIZE2];      /* buffers data between passes */
+  SHIFT_TEMPS
+  SCALING_FACTOR
+
+  /* Pass 1: process columns from input, store into work array.  Only the
+   * first 4 columns are nonzero, and only the first 4 rows of each column are
+   * nonzero.
+   */
+
+  inptr = coef_block;
+  quantptr = (ISLOW_MULT_TYPE *)compptr->dct_table;
+  wsptr = workspace;
+  for (ctr = DCTSIZE / 2; ctr > 0; ctr--) {
+    if (inptr[DCTSIZE * 1] == 0 && inptr[DCTSIZE * 2] == 0 &&
+        inptr[DCTSIZE * 3] == 0) {
+      /* AC terms all zero */
+      int dcval = LEFT_SHIFT(DEQUANTIZE(inptr[DCTSIZE * 0],
+                             quantptr[DCTSIZE * 0]), PASS1_BITS);
+
+      wsptr[DCTSIZE * 0] = dcval;
+      wsptr[DCTSIZE * 1] = dcval;
+      wsptr[DCTSIZE * 2] = dcval;
+      wsptr[DCTSIZE * 3] = dcval;
+      wsptr[DCTSIZE * 4] = dcval;
+      wsptr[DCTSIZE * 5] = dcval;
+      wsptr[DCTSIZE * 6] = dcval;
+      wsptr[DCTSIZE * 7] = dcval;
+
+      inptr++;                  /* advance pointers to next column */
+      quantptr++;
+      wsptr++;
+      continue;
+    }
+
+    /* Even part: y4 and y6 are zero. */
+
+    z2 = DEQUANTIZE(inptr[DCTSIZE * 2], quantptr[DCTSIZE * 2]);
+
+    z1 = MULTIPLY(z2, FIX_0_541196100);
+    tmp2 = z1;
+    tmp3 = z1 + MULTIPLY(z2, FIX_0_765366865);
+
+    z2 = DEQUANTIZE(inptr[DCTSIZE * 0], quantptr[DCTSIZE * 0]);
+
+    tmp0 = LEFT_SHIFT(z2, CONST_BITS);
+
+    tmp10 = tmp0 + tmp3;
+    tmp13 = tmp0 - tmp3;
+    tmp11 = tmp0 + tmp2;
+    tmp12 = tmp0 - tmp2;
+
+    /* Odd part: y5 and y7 are zero. */
+
+    z2 = DEQUANTIZE(inptr[DCTSIZE * 3], quantptr[DCTSIZE * 3]);
+    z1 = DEQUANTIZE(inptr[DCTSIZE * 1], quantptr[DCTSIZE * 1]);
+
+    z5 = MULTIPLY(z2 + z1, FIX_1_175875602); /* sqrt(2) * c3 */
+
+    tmp2 = MULTIPLY(z2, FIX_3_072711026); /* sqrt(2) * ( c1+c3+c5-c7) */
+    tmp3 = MULTIPLY(z1, FIX_1_501321110); /* sqrt(2) * ( c1+c3-c5-c7) */
+    z3 = MULTIPLY(z2, -FIX_1_961570560); /* sqrt(2) * (-c3-c5) */
+    z4 = MULTIPLY(z1, -FIX_0_390180644); /* sqrt(2) * ( c5-c3) */
+    z1 = MULTIPLY(z1, -FIX_0_899976223); /* sqrt(2) * ( c7-c3) */
+    z2 = MULTIPLY(z2, -FIX_2_562915447); /* sqrt(2) * (-c1-c3) */
+
+    z3 += z5;
+    z4 += z5;
+
+    tmp0 = z1 + z3;
+    tmp1 = z2 + z4;
+    tmp2 += z2 + z3;
+    tmp3 += z1 + z4;
+
+    /* Final output stage: inputs are tmp10..tmp13, tmp0..tmp3 */
+
+    wsptr[DCTSIZE * 0] = (int)DESCALE(tmp10 + tmp3, CONST_BITS - PASS1_BITS);
+    wsptr[DCTSIZE * 7] = (int)DESCALE(tmp10 - tmp3, CONST_BITS - PASS1_BITS);
+    wsptr[DCTSIZE * 1] = (int)DESCALE(tmp11 + tmp2, CONST_BITS - PASS1_BITS);
+    wsptr[DCTSIZE * 6] = (int)DESCALE(tmp11 - tmp2, CONST_BITS - PASS1_BITS);
+    wsptr[DCTSIZE * 2] = (int)DESCALE(tmp12 + tmp1, CONST_BITS - PASS1_BITS);
+    wsptr[DCTSIZE * 5] = (int)DESCALE(tmp12 - tmp1, CONST_BITS - PASS1_BITS);
+    wsptr[DCTSIZE * 3] = (int)DESCALE(tmp13 + tmp0, CONST_BITS - PASS1_BITS);
+    wsptr[DCTSIZE * 4] = (int)DESCALE(tmp13 - tmp0, CONST_BITS - PASS1_BITS);
+
+    inptr++;                    /* advance pointers to next column */
+    quantptr++;
+    wsptr++;
+  }
+
+  /* Pass 2: process rows from work array, store into output array.  Only the
+   * first 4 columns of the work array were filled in, and the rest are
+   * treated as zero.
+   */
+
+  wsptr = workspace;
+  for (ctr = 0; ctr < DCTSIZE; ctr++) {
+    outptr = output_buf[ctr] + output_col;
+
+#ifndef NO_ZERO_ROW_TEST
+    if (wsptr[1] == 0 && wsptr[2] == 0 && wsptr[3] == 0) {
+      /* AC terms all zero */
+      _JSAMPLE dcval = range_limit[(int)DESCALE((JLONG)wsptr[0],
+                                                PASS1_BITS + 3) & RANGE_MASK];
+
+      outptr[0] = dcval;
+      outptr[1] = dcval;
+      outptr[2] = dcval;
+      outptr[3] = dcval;
+      outptr[4] = dcval;
+      outptr[5] = dcval;
+      outptr[6] = dcval;
+      outptr[7] = dcval;
+
+      wsptr += DCTSIZE;         /* advance pointer to next row */
+      continue;
+    }
+#endif
+
+    /* Even part: y4 and y6 are zero. */
+
+    z2 = (JLONG)wsptr[2];
+
+    z1 = MULTIPLY(z2, FIX_0_541196100);
+    tmp2 = z1;
+    tmp3 = z1 + MULTIPLY(z2, FIX_0_765366865);
+
+    tmp0 = LEFT_SHIFT((JLONG)wsptr[0], CONST_BITS);
+
+    tmp10 = tmp0 + tmp3;
+    tmp13 = tmp0 - tmp3;
+    tmp11 = tmp0 + tmp2;
+    tmp12 = tmp0 - tmp2;
+
+    /* Odd part: y5 and y7 are zero. */
+
+    z2 = (JLONG)wsptr[3];
+    z1 = (JLONG)wsptr[1];
+
+    z5 = MULTIPLY(z2 + z1, FIX_1_175875602); /* sqrt(2) * c3 */
+
+    tmp2 = MULTIPLY(z2, FIX_3_072711026); /* sqrt(2) * ( c1+c3+c5-c7) */
+    tmp3 = MULTIPLY(z1, FIX_1_501321110); /* sqrt(2) * ( c1+c3-c5-c7) */
+    z3 = MULTIPLY(z2, -FIX_1_961570560); /* sqrt(2) * (-c3-c5) */
+    z4 = MULTIPLY(z1, -FIX_0_390180644); /* sqrt(2) * ( c5-c3) */
+    z1 = MULTIPLY(z1, -FIX_0_899976223); /* sqrt(2) * ( c7-c3) */
+    z2 = MULTIPLY(z2, -FIX_2_562915447); /* sqrt(2) * (-c1-c3) */
+
+    z3 += z5;
+    z4 += z5;
+
+    tmp0 = z1 + z3;
+    tmp1 = z2 + z4;
+    tmp2 += z2 + z3;
+    tmp3 += z1 + z4;
+
+    /* Final output stage: inputs are tmp10..tmp13, tmp0..tmp3 */
+
+    outptr[0] = range_limit[(int)DESCALE(tmp10 + tmp3,
+                                         CONST_BITS + PASS1_BITS + 3) &
+                            RANGE_MASK];
+    outptr[7] = range_limit[(int)DESCALE(tmp10 - tmp3,
+                                         CONST_BITS + PASS1_BITS + 3) &
+                            RANGE_MASK];
+    outptr[1] = range_limit[(int)DESCALE(tmp11 + tmp2,
+                                         CONST_BITS + PASS1_BITS + 3) &
+                            RANGE_MASK];
+    outptr[6] = range_limit[(int)DESCALE(tmp11 - tmp2,
+                                         CONST_BITS + PASS1_BITS + 3) &
+                            RANGE_MASK];
+    outptr[2] = range_limit[(int)DESCALE(tmp12 + tmp1,
+                                         CONST_BITS + PASS1_BITS + 3) &
+                            RANGE_MASK];
+    outptr[5] = range_limit[(int)DESCALE(tmp12 - tmp1,
+                                         CONST_BITS + PASS1_BITS + 3) &
+                            RANGE_MASK];
+    outptr[3] = range_limit[(int)DESCALE(tmp13 + tmp0,
+                                         CONST_BITS + PASS1_BITS + 3) &
+                            RANGE_MASK];
+    outptr[4] = range_limit[(int)DESCALE(tmp13 - tmp0,
+                                         CONST_BITS + PASS1_BITS + 3) &
+                            RANGE_MASK];
+
+    wsptr += DCTSIZE;           /* advance pointer to next row */
+  }
+}
+
 #ifdef IDCT_SCALING_SUPPORTED
 
 
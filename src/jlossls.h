@@ -6,7 +6,7 @@
  * Lossless JPEG Modifications:
  * Copyright (C) 1999, Ken Murchison.
  * libjpeg-turbo Modifications:
- * Copyright (C) 2022, D. R. Commander.
+ * Copyright (C) 2022, 2026, D. R. Commander.
  * For conditions of distribution and use, see the accompanying README.ijg
  * file.
  *
@@ -66,6 +66,18 @@ typedef struct {
   /* Sample scaling */
   void (*scaler_scale) (j_compress_ptr cinfo, _JSAMPROW input_buf,
                         _JSAMPROW output_buf, JDIMENSION width);
+
+#ifdef WITH_SIMD
+  /* SIMD differencers for the first row and the remaining rows in a scan or
+   * restart interval (NULL if not available)
+   */
+  void (*difference_first_row_simd) (_JSAMPROW input_buf, _JSAMPROW prev_row,
+                                     JDIFFROW diff_buf, JDIMENSION width,
+                                     int initial_predictor);
+  void (*difference_simd) (_JSAMPROW input_buf, _JSAMPROW prev_row,
+                           JDIFFROW diff_buf, JDIMENSION width,
+                           int initial_predictor);
+#endif
 } jpeg_lossless_compressor;
 
 typedef jpeg_lossless_compressor *lossless_comp_ptr;
@@ -92,6 +104,18 @@ typedef struct {
   /* Sample scaling */
   void (*scaler_scale) (j_decompress_ptr cinfo, JDIFFROW diff_buf,
                         _JSAMPROW output_buf, JDIMENSION width);
+
+#ifdef WITH_SIMD
+  /* SIMD undifferencers for the first row and the remaining rows in a scan or
+   * restart interval (NULL if not available)
+   */
+  void (*undifference_first_row_simd) (JDIFFROW diff_buf, JDIFFROW prev_row,
+                                       JDIFFROW undiff_buf, JDIMENSION width,
+                                       int initial_predictor);
+  void (*undifference_simd) (JDIFFROW diff_buf, JDIFFROW prev_row,
+                             JDIFFROW undiff_buf, JDIMENSION width,
+                             int initial_predictor);
+#endif
 } jpeg_lossless_decompressor;
 
 typedef jpeg_lossless_decompressor *lossless_decomp_ptr;
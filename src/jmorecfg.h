@@ -369,7 +369,7 @@ static const int rgb_pixelsize[JPEG_NUMCS] = {
  */
 
 #ifndef MULTIPLIER
-#ifndef WITH_SIMD
+#if !defined(WITH_SIMD) || BITS_IN_JSAMPLE != 8
 #define MULTIPLIER  int         /* type for fastest integer multiply */
 #else
 #define MULTIPLIER  short       /* prefer 16-bit with SIMD for parellelism */
@@ -98,6 +98,28 @@ struct jpeg_comp_master {
   boolean is_last_pass;         /* True during last pass */
   boolean lossless;             /* True if lossless mode is enabled */
 
+  /* Number of threads requested by the application (see
+   * jpeg_set_num_threads()), or 0 to use one thread per CPU
+   */
+  int num_threads;
+  /* Number of threads to use when gathering Huffman statistics in the
+   * current compression cycle.  This is computed by jinit_c_master_control().
+   */
+  int gather_threads;
+  /* TRUE if the scans of a progressive JPEG image should be encoded in
+   * parallel once the whole-image coefficient buffer has been filled (see
+   * jcphuff.c.)  This is computed by jinit_c_master_control().
+   */
+  boolean parallel_scans;
+  /* If non-NULL, then the lossless Huffman encoder gathers its statistics
+   * into these NUM_HUFF_TBLS 257-entry tables (indexed by table number)
+   * instead of its own, and it generates the optimal Huffman tables from
+   * their contents at the end of the statistics-gathering pass.  This allows
+   * the TurboJPEG API library to merge the statistics for bands of an image
+   * that are compressed in parallel (see setupCompBands() in turbojpeg.c.)
+   */
+  long (*lhuff_counts)[257];
+
   /* SIMD-specific variables */
   unsigned int simd_support;
   unsigned int simd_huffman;
@@ -179,6 +201,10 @@ struct jpeg_color_converter {
   void (*color_convert_simd) (JDIMENSION img_width, JSAMPARRAY input_buf,
                               JSAMPIMAGE output_buf, JDIMENSION output_row,
                               int num_rows);
+  void (*color_convert_simd_12) (JDIMENSION img_width,
+                                 J12SAMPARRAY input_buf,
+                                 J12SAMPIMAGE output_buf,
+                                 JDIMENSION output_row, int num_rows);
 };
 
 /* Downsampling */
@@ -203,6 +229,18 @@ struct jpeg_downsampler {
                                 JDIMENSION v_samp_factor,
                                 JDIMENSION width_blocks, JSAMPARRAY input_data,
                                 JSAMPARRAY output_data);
+  void (*h2v1_downsample_simd_12) (JDIMENSION image_width,
+                                   int max_v_samp_factor,
+                                   JDIMENSION v_samp_factor,
+                                   JDIMENSION width_blocks,
+                                   J12SAMPARRAY input_data,
+                                   J12SAMPARRAY output_data);
+  void (*h2v2_downsample_simd_12) (JDIMENSION image_width,
+                                   int max_v_samp_factor,
+                                   JDIMENSION v_samp_factor,
+                                   JDIMENSION width_blocks,
+                                   J12SAMPARRAY input_data,
+                                   J12SAMPARRAY output_data);
 
   boolean need_context_rows;    /* TRUE if need rows above & below */
 };
@@ -278,6 +316,46 @@ struct jpeg_decomp_master {
   /* Last iMCU row that was successfully decoded */
   JDIMENSION last_good_iMCU_row;
 
+  /* Huffman decoder state with which to begin the first scan, if resume_huff
+   * is TRUE.  This allows a band of iMCU rows to be decoded from the middle of
+   * the entropy-coded data (see jpeg_huff_find_row_states().)
+   */
+  boolean resume_huff;
+  unsigned int resume_get_buffer;
+  int resume_bits_left;
+  int resume_dc_val[MAX_COMPS_IN_SCAN];
+
+  /* TRUE if entropy decoding and reconstruction of single-scan lossy images
+   * should be performed in separate threads (see jpeg_set_pipelining().)
+   */
+  boolean pipelined;
+
+  /* If non-NULL, then the output pass reads the DCT coefficients from the
+   * whole-image coefficient buffer of this decompression object, which must
+   * have absorbed all scans of the same multi-scan JPEG image, rather than
+   * decoding them.  This allows several decompression objects to reconstruct
+   * different bands of the same image in parallel.
+   */
+  j_decompress_ptr coef_source;
+
+  /* If TRUE, then jpeg_start_decompress() stops reading a progressive JPEG
+   * image once the remaining scans cannot affect the output.  That is the
+   * case if all of the components that are needed are being scaled to 1/8
+   * (so the inverse DCT uses only the DC coefficients), all DC scans are
+   * complete, and all of those components have already received some AC
+   * coefficient data (so block smoothing will not interpolate the DC
+   * coefficients.)  jpeg_finish_decompress() then does not read the rest of
+   * the image, so this should be enabled only if the data source will not
+   * be used to read anything else.
+   */
+  boolean skip_tail_scans;
+
+  /* If non-NULL, then jpeg_destroy() calls this method to release resources
+   * held by the data source manager that are not allocated from the memory
+   * manager's pools (see jpeg_mmap_src().)
+   */
+  void (*release_source) (j_decompress_ptr cinfo);
+
   /* Tail of list of saved markers */
   jpeg_saved_marker_ptr marker_list_end;
 
@@ -399,7 +477,10 @@ struct jpeg_marker_reader {
 struct jpeg_entropy_decoder {
   void (*start_pass) (j_decompress_ptr cinfo);
 
-  /* Lossy mode */
+  /* Lossy mode.  For single-scan sequential images, MCU_data may be NULL, in
+   * which case the MCU is decoded (advancing the bit reader and the DC
+   * predictions) but its coefficients are discarded.
+   */
   boolean (*decode_mcu) (j_decompress_ptr cinfo, JBLOCKROW *MCU_data);
   /* Lossless mode */
   JDIMENSION (*decode_mcus) (j_decompress_ptr cinfo, JDIFFIMAGE diff_buf,
@@ -410,6 +491,13 @@ struct jpeg_entropy_decoder {
   /* This is here to share code between baseline and progressive decoders; */
   /* other modules probably should not use it */
   boolean insufficient_data;    /* set TRUE after emitting warning */
+
+  /* Lossy mode: If this is non-NULL, then decode_mcu() stores into it an upper
+   * bound on the zigzag index of the last nonzero coefficient in each block of
+   * the MCU (0 if all of the AC coefficients are zero.)  The coefficient
+   * controller uses this to select a faster IDCT method for sparse blocks.
+   */
+  int *last_nonzero;
 };
 
 /* Lossy mode: Inverse DCT (also performs dequantization)
@@ -427,6 +515,12 @@ typedef void (*inverse_DCT_12_method_ptr) (j_decompress_ptr cinfo,
                                            J12SAMPARRAY output_buf,
                                            JDIMENSION output_col);
 
+/* The first 10 coefficients in zigzag order are all within the upper left 4x4
+ * quadrant of the block, so the IDCT of a block whose nonzero coefficients are
+ * all among those coefficients can skip the other 12 coefficients.
+ */
+#define IDCT_SPARSE_COEFS  10
+
 struct jpeg_inverse_dct {
   void (*start_pass) (j_decompress_ptr cinfo);
 
@@ -434,13 +528,32 @@ struct jpeg_inverse_dct {
   /* It is useful to allow each component to have a separate IDCT method. */
   inverse_DCT_method_ptr inverse_DCT[MAX_COMPONENTS];
   inverse_DCT_12_method_ptr inverse_DCT_12[MAX_COMPONENTS];
+  /* Equivalent IDCT methods for blocks in which all of the AC coefficients are
+   * zero and for blocks in which all of the nonzero coefficients are among the
+   * first IDCT_SPARSE_COEFS coefficients in zigzag order.  These are the same
+   * as inverse_DCT[] or inverse_DCT_12[] if no faster method is available.
+   */
+  inverse_DCT_method_ptr inverse_DCT_dconly[MAX_COMPONENTS];
+  inverse_DCT_12_method_ptr inverse_DCT_dconly_12[MAX_COMPONENTS];
+  inverse_DCT_method_ptr inverse_DCT_sparse[MAX_COMPONENTS];
+  inverse_DCT_12_method_ptr inverse_DCT_sparse_12[MAX_COMPONENTS];
 
   void (*idct_simd) (void *dct_table, JCOEFPTR coef_block,
                      JSAMPARRAY output_buf, JDIMENSION output_col);
   void (*idct_2x2_simd) (void *dct_table, JCOEFPTR coef_block,
                          JSAMPARRAY output_buf, JDIMENSION output_col);
+  void (*idct_3x3_simd) (void *dct_table, JCOEFPTR coef_block,
+                         JSAMPARRAY output_buf, JDIMENSION output_col);
   void (*idct_4x4_simd) (void *dct_table, JCOEFPTR coef_block,
                          JSAMPARRAY output_buf, JDIMENSION output_col);
+  void (*idct_5x5_simd) (void *dct_table, JCOEFPTR coef_block,
+                         JSAMPARRAY output_buf, JDIMENSION output_col);
+  void (*idct_6x6_simd) (void *dct_table, JCOEFPTR coef_block,
+                         JSAMPARRAY output_buf, JDIMENSION output_col);
+  void (*idct_7x7_simd) (void *dct_table, JCOEFPTR coef_block,
+                         JSAMPARRAY output_buf, JDIMENSION output_col);
+  void (*idct_simd_12) (void *dct_table, JCOEFPTR coef_block,
+                        J12SAMPARRAY output_buf, JDIMENSION output_col);
 };
 
 /* Upsampling (note that upsampler must also call color converter) */
@@ -472,6 +585,14 @@ struct jpeg_upsampler {
   void (*merged_upsample_simd) (JDIMENSION output_width, JSAMPIMAGE input_buf,
                                 JDIMENSION in_row_group_ctr,
                                 JSAMPARRAY output_buf);
+  void (*h2v1_upsample_simd_12) (int max_v_samp_factor,
+                                 JDIMENSION output_width,
+                                 J12SAMPARRAY input_data,
+                                 J12SAMPARRAY *output_data_ptr);
+  void (*h2v2_upsample_simd_12) (int max_v_samp_factor,
+                                 JDIMENSION output_width,
+                                 J12SAMPARRAY input_data,
+                                 J12SAMPARRAY *output_data_ptr);
 
   boolean need_context_rows;    /* TRUE if need rows above & below */
 };
@@ -493,6 +614,10 @@ struct jpeg_color_deconverter {
   void (*color_convert_simd) (JDIMENSION out_width, JSAMPIMAGE input_buf,
                               JDIMENSION input_row, JSAMPARRAY output_buf,
                               int num_rows);
+  void (*color_convert_simd_12) (JDIMENSION out_width,
+                                 J12SAMPIMAGE input_buf,
+                                 JDIMENSION input_row,
+                                 J12SAMPARRAY output_buf, int num_rows);
 };
 
 /* Color quantization or color precision reduction */
@@ -638,6 +763,17 @@ EXTERN(void) j12init_lossless_decompressor(j_decompress_ptr cinfo);
 EXTERN(void) j16init_lossless_decompressor(j_decompress_ptr cinfo);
 #endif
 
+/* Speculative parallel Huffman decoding (jdhuff.c) */
+#define JPEG_HUFF_SPEC_PADDING  256 /* # of zero bytes required after data */
+typedef struct {
+  size_t bit_offset;            /* offset of MCU in entropy-coded data */
+  int last_dc_val[MAX_COMPS_IN_SCAN]; /* DC predictions at start of MCU */
+} jpeg_huff_row_state;
+EXTERN(jpeg_huff_row_state *) jpeg_huff_find_row_states(j_decompress_ptr cinfo,
+                                                        const JOCTET *data,
+                                                        size_t num_bytes,
+                                                        int num_threads);
+
 /* Memory manager initialization */
 EXTERN(void) jinit_memory_mgr(j_common_ptr cinfo);
 
@@ -7,7 +7,7 @@
  * Lossless JPEG Modifications:
  * Copyright (C) 1999, Ken Murchison.
  * libjpeg-turbo Modifications:
- * Copyright (C) 2009-2011, 2013-2014, 2016-2017, 2020, 2022-2024,
+ * Copyright (C) 2009-2011, 2013-2014, 2016-2017, 2020, 2022-2024, 2026,
              D. R. Commander.
  * Copyright (C) 2015, Google, Inc.
  * For conditions of distribution and use, see the accompanying README.ijg
@@ -984,6 +984,12 @@ EXTERN(void) jpeg_destroy_decompress(j_decompress_ptr cinfo);
 EXTERN(void) jpeg_stdio_dest(j_compress_ptr cinfo, FILE *outfile);
 EXTERN(void) jpeg_stdio_src(j_decompress_ptr cinfo, FILE *infile);
 
+/* Data source manager: memory-mapped file (falls back to stdio if the file
+ * cannot be mapped.)  Caller is responsible for opening the file before and
+ * closing after.
+ */
+EXTERN(void) jpeg_mmap_src(j_decompress_ptr cinfo, FILE *infile);
+
 /* Data source and destination managers: memory buffers. */
 EXTERN(void) jpeg_mem_dest(j_compress_ptr cinfo, unsigned char **outbuffer,
                            unsigned long *outsize);
@@ -1042,6 +1048,9 @@ EXTERN(JDIMENSION) jpeg12_write_raw_data(j_compress_ptr cinfo,
                                          J12SAMPIMAGE data,
                                          JDIMENSION num_lines);
 
+/* Enable multithreaded compression.  See libjpeg.txt. */
+EXTERN(void) jpeg_set_num_threads(j_compress_ptr cinfo, int num_threads);
+
 /* Write a special marker.  See libjpeg.txt concerning safe usage. */
 EXTERN(void) jpeg_write_marker(j_compress_ptr cinfo, int marker,
                                const JOCTET *dataptr, unsigned int datalen);
@@ -1099,6 +1108,9 @@ EXTERN(JDIMENSION) jpeg12_read_raw_data(j_decompress_ptr cinfo,
                                         J12SAMPIMAGE data,
                                         JDIMENSION max_lines);
 
+/* Enable pipelined (multithreaded) decompression.  See libjpeg.txt. */
+EXTERN(void) jpeg_set_pipelining(j_decompress_ptr cinfo, boolean enable);
+
 /* Additional entry points for buffered-image mode. */
 EXTERN(boolean) jpeg_has_multiple_scans(j_decompress_ptr cinfo);
 EXTERN(boolean) jpeg_start_output(j_decompress_ptr cinfo, int scan_number);
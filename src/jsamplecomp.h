@@ -83,6 +83,11 @@
 #define _jcopy_sample_rows  j16copy_sample_rows
 #endif
 
+/* SIMD functions (jsimd.h) */
+#ifdef C_LOSSLESS_SUPPORTED
+#define _jsimd_set_difference  jsimd16_set_difference
+#endif
+
 /* Internal fields (cdjpeg.h) */
 
 #if defined(C_LOSSLESS_SUPPORTED) || defined(D_LOSSLESS_SUPPORTED)
@@ -145,6 +150,8 @@
 /* Use the 12-bit method in the jpeg_inverse_dct structure. */
 #define _inverse_DCT_method_ptr  inverse_DCT_12_method_ptr
 #define _inverse_DCT  inverse_DCT_12
+#define _inverse_DCT_dconly  inverse_DCT_dconly_12
+#define _inverse_DCT_sparse  inverse_DCT_sparse_12
 /* Use the 12-bit method in the jpeg_upsampler structure. */
 #define _upsample  upsample_12
 /* Use the 12-bit method in the jpeg_color_converter structure. */
@@ -180,12 +187,19 @@
 
 #define _jcopy_sample_rows  j12copy_sample_rows
 
+/* Global internal functions (jdcoefct.h) */
+#define _jread_scanlines_pipelined  j12read_scanlines_pipelined
+
 /* Global internal functions (jdct.h) */
 #define _jpeg_fdct_islow  jpeg12_fdct_islow
 #define _jpeg_fdct_ifast  jpeg12_fdct_ifast
 
 #define _jpeg_idct_islow  jpeg12_idct_islow
+#define _jpeg_idct_islow_dconly  jpeg12_idct_islow_dconly
+#define _jpeg_idct_islow_sparse  jpeg12_idct_islow_sparse
 #define _jpeg_idct_ifast  jpeg12_idct_ifast
+#define _jpeg_idct_ifast_dconly  jpeg12_idct_ifast_dconly
+#define _jpeg_idct_ifast_sparse  jpeg12_idct_ifast_sparse
 #define _jpeg_idct_float  jpeg12_idct_float
 #define _jpeg_idct_7x7  jpeg12_idct_7x7
 #define _jpeg_idct_6x6  jpeg12_idct_6x6
@@ -203,6 +217,26 @@
 #define _jpeg_idct_15x15  jpeg12_idct_15x15
 #define _jpeg_idct_16x16  jpeg12_idct_16x16
 
+/* SIMD functions (jsimd.h, jsimddct.h) */
+#define _jsimd_set_rgb_ycc  jsimd12_set_rgb_ycc
+#define _jsimd_color_convert  jsimd12_color_convert
+#define _jsimd_set_ycc_rgb  jsimd12_set_ycc_rgb
+#define _jsimd_color_deconvert  jsimd12_color_deconvert
+#define _jsimd_set_h2v1_downsample  jsimd12_set_h2v1_downsample
+#define _jsimd_h2v1_downsample  jsimd12_h2v1_downsample
+#define _jsimd_set_h2v2_downsample  jsimd12_set_h2v2_downsample
+#define _jsimd_h2v2_downsample  jsimd12_h2v2_downsample
+#define _jsimd_set_h2v1_fancy_upsample  jsimd12_set_h2v1_fancy_upsample
+#define _jsimd_h2v1_fancy_upsample  jsimd12_h2v1_fancy_upsample
+#define _jsimd_set_h2v2_fancy_upsample  jsimd12_set_h2v2_fancy_upsample
+#define _jsimd_h2v2_fancy_upsample  jsimd12_h2v2_fancy_upsample
+#define _jsimd_set_convsamp  jsimd12_set_convsamp
+#define _jsimd_set_fdct_islow  jsimd12_set_fdct_islow
+#define _jsimd_set_quantize  jsimd12_set_quantize
+#define _jsimd_set_idct_islow  jsimd12_set_idct_islow
+#define _jsimd_idct_islow  jsimd12_idct_islow
+#define _jsimd_set_difference  jsimd12_set_difference
+
 /* Internal fields (cdjpeg.h) */
 
 /* Use the 12-bit buffer in the cjpeg_source_struct and djpeg_dest_struct
@@ -261,6 +295,8 @@
 /* Use the 8-bit method in the jpeg_inverse_dct structure. */
 #define _inverse_DCT_method_ptr  inverse_DCT_method_ptr
 #define _inverse_DCT  inverse_DCT
+#define _inverse_DCT_dconly  inverse_DCT_dconly
+#define _inverse_DCT_sparse  inverse_DCT_sparse
 /* Use the 8-bit method in the jpeg_upsampler structure. */
 #define _upsample  upsample
 /* Use the 8-bit method in the jpeg_color_converter structure. */
@@ -296,12 +332,19 @@
 
 #define _jcopy_sample_rows  jcopy_sample_rows
 
+/* Global internal functions (jdcoefct.h) */
+#define _jread_scanlines_pipelined  jread_scanlines_pipelined
+
 /* Global internal functions (jdct.h) */
 #define _jpeg_fdct_islow  jpeg_fdct_islow
 #define _jpeg_fdct_ifast  jpeg_fdct_ifast
 
 #define _jpeg_idct_islow  jpeg_idct_islow
+#define _jpeg_idct_islow_dconly  jpeg_idct_islow_dconly
+#define _jpeg_idct_islow_sparse  jpeg_idct_islow_sparse
 #define _jpeg_idct_ifast  jpeg_idct_ifast
+#define _jpeg_idct_ifast_dconly  jpeg_idct_ifast_dconly
+#define _jpeg_idct_ifast_sparse  jpeg_idct_ifast_sparse
 #define _jpeg_idct_float  jpeg_idct_float
 #define _jpeg_idct_7x7  jpeg_idct_7x7
 #define _jpeg_idct_6x6  jpeg_idct_6x6
@@ -319,6 +362,26 @@
 #define _jpeg_idct_15x15  jpeg_idct_15x15
 #define _jpeg_idct_16x16  jpeg_idct_16x16
 
+/* SIMD functions (jsimd.h, jsimddct.h) */
+#define _jsimd_set_rgb_ycc  jsimd_set_rgb_ycc
+#define _jsimd_color_convert  jsimd_color_convert
+#define _jsimd_set_ycc_rgb  jsimd_set_ycc_rgb
+#define _jsimd_color_deconvert  jsimd_color_deconvert
+#define _jsimd_set_h2v1_downsample  jsimd_set_h2v1_downsample
+#define _jsimd_h2v1_downsample  jsimd_h2v1_downsample
+#define _jsimd_set_h2v2_downsample  jsimd_set_h2v2_downsample
+#define _jsimd_h2v2_downsample  jsimd_h2v2_downsample
+#define _jsimd_set_h2v1_fancy_upsample  jsimd_set_h2v1_fancy_upsample
+#define _jsimd_h2v1_fancy_upsample  jsimd_h2v1_fancy_upsample
+#define _jsimd_set_h2v2_fancy_upsample  jsimd_set_h2v2_fancy_upsample
+#define _jsimd_h2v2_fancy_upsample  jsimd_h2v2_fancy_upsample
+#define _jsimd_set_convsamp  jsimd_set_convsamp
+#define _jsimd_set_fdct_islow  jsimd_set_fdct_islow
+#define _jsimd_set_quantize  jsimd_set_quantize
+#define _jsimd_set_idct_islow  jsimd_set_idct_islow
+#define _jsimd_idct_islow  jsimd_idct_islow
+#define _jsimd_set_difference  jsimd_set_difference
+
 /* Internal fields (cdjpeg.h) */
 
 /* Use the 8-bit buffer in the cjpeg_source_struct and djpeg_dest_struct
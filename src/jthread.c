@@ -0,0 +1,383 @@
+/*
+ * jthread.c
+ *
+ * Copyright (C) 2026, D. R. Commander.
+ * For conditions of distribution and use, see the accompanying README.ijg
+ * file.
+ *
+ * This file contains a minimal thread pool that is used by the multithreaded
+ * code paths in libjpeg-turbo and the TurboJPEG API library.  Tasks are
+ * distributed to the worker threads (and the calling thread) on a
+ * first-come, first-served basis, so the tasks need not be of equal size.
+ * It also contains thin wrappers for starting a single thread and for
+ * synchronizing two threads that exchange data through a shared buffer.
+ */
+
+#define JPEG_INTERNALS
+#include "jinclude.h"
+#include "jpeglib.h"
+#include "jthread.h"
+
+#ifdef WITH_THREADS
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#endif
+
+
+#ifdef WITH_THREADS
+
+typedef struct {
+  jthread_task_fn task;
+  char *args;
+  size_t arg_size;
+  int num_tasks, next_task;
+#ifdef _WIN32
+  CRITICAL_SECTION lock;
+#else
+  pthread_mutex_t lock;
+#endif
+} task_queue;
+
+
+/* Perform tasks until none remain.  This is the body of each worker thread,
+ * and the calling thread also executes it.
+ */
+
+LOCAL(void)
+run_tasks(task_queue *queue)
+{
+  for (;;) {
+    int task_index;
+
+#ifdef _WIN32
+    EnterCriticalSection(&queue->lock);
+#else
+    pthread_mutex_lock(&queue->lock);
+#endif
+    task_index = queue->next_task;
+    if (task_index < queue->num_tasks)
+      queue->next_task++;
+#ifdef _WIN32
+    LeaveCriticalSection(&queue->lock);
+#else
+    pthread_mutex_unlock(&queue->lock);
+#endif
+
+    if (task_index >= queue->num_tasks)
+      break;
+    (*queue->task) (queue->args + (size_t)task_index * queue->arg_size);
+  }
+}
+
+#ifdef _WIN32
+
+static DWORD WINAPI
+thread_main(LPVOID arg)
+{
+  run_tasks((task_queue *)arg);
+  return 0;
+}
+
+#else
+
+static void *
+thread_main(void *arg)
+{
+  run_tasks((task_queue *)arg);
+  return NULL;
+}
+
+#endif
+
+
+struct jthread_sync {
+#ifdef _WIN32
+  CRITICAL_SECTION lock;
+  CONDITION_VARIABLE cond;
+#else
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+#endif
+};
+
+struct jthread {
+  jthread_task_fn task;
+  void *arg;
+#ifdef _WIN32
+  HANDLE handle;
+#else
+  pthread_t handle;
+#endif
+};
+
+#ifdef _WIN32
+
+static DWORD WINAPI
+single_thread_main(LPVOID arg)
+{
+  jthread *thread = (jthread *)arg;
+
+  (*thread->task) (thread->arg);
+  return 0;
+}
+
+#else
+
+static void *
+single_thread_main(void *arg)
+{
+  jthread *thread = (jthread *)arg;
+
+  (*thread->task) (thread->arg);
+  return NULL;
+}
+
+#endif
+
+#endif /* WITH_THREADS */
+
+
+GLOBAL(int)
+jthread_num_cpus(void)
+{
+#if defined(WITH_THREADS) && defined(_WIN32)
+  SYSTEM_INFO sysinfo;
+
+  GetSystemInfo(&sysinfo);
+  if (sysinfo.dwNumberOfProcessors >= 1)
+    return (int)sysinfo.dwNumberOfProcessors;
+#elif defined(WITH_THREADS) && defined(_SC_NPROCESSORS_ONLN)
+  long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+  if (num_cpus >= 1)
+    return num_cpus > 1024 ? 1024 : (int)num_cpus;
+#endif
+  return 1;
+}
+
+
+GLOBAL(void)
+jthread_run(int num_threads, jthread_task_fn task, void *args,
+            size_t arg_size, int num_tasks)
+{
+#ifdef WITH_THREADS
+  task_queue queue;
+#ifdef _WIN32
+  HANDLE *threads;
+#else
+  pthread_t *threads;
+#endif
+  int i, num_created = 0;
+
+  if (num_threads > num_tasks)
+    num_threads = num_tasks;
+  if (num_threads <= 1)
+    goto sequential;
+
+  threads = malloc(sizeof(threads[0]) * (num_threads - 1));
+  if (threads == NULL)
+    goto sequential;
+
+  queue.task = task;
+  queue.args = (char *)args;
+  queue.arg_size = arg_size;
+  queue.num_tasks = num_tasks;
+  queue.next_task = 0;
+#ifdef _WIN32
+  InitializeCriticalSection(&queue.lock);
+#else
+  if (pthread_mutex_init(&queue.lock, NULL) != 0) {
+    free(threads);
+    goto sequential;
+  }
+#endif
+
+  /* If a thread cannot be created, then the threads that were created (and
+   * the calling thread) will perform the remaining tasks.
+   */
+  for (i = 0; i < num_threads - 1; i++) {
+#ifdef _WIN32
+    if ((threads[i] = CreateThread(NULL, 0, thread_main, &queue, 0,
+                                   NULL)) == NULL)
+      break;
+#else
+    if (pthread_create(&threads[i], NULL, thread_main, &queue) != 0)
+      break;
+#endif
+    num_created++;
+  }
+
+  run_tasks(&queue);
+
+  for (i = 0; i < num_created; i++) {
+#ifdef _WIN32
+    WaitForSingleObject(threads[i], INFINITE);
+    CloseHandle(threads[i]);
+#else
+    pthread_join(threads[i], NULL);
+#endif
+  }
+
+#ifdef _WIN32
+  DeleteCriticalSection(&queue.lock);
+#else
+  pthread_mutex_destroy(&queue.lock);
+#endif
+  free(threads);
+  return;
+
+sequential:
+#endif
+  {
+    int task_index;
+
+    for (task_index = 0; task_index < num_tasks; task_index++)
+      (*task) ((char *)args + (size_t)task_index * arg_size);
+  }
+}
+
+
+GLOBAL(jthread_sync *)
+jthread_sync_create(void)
+{
+#ifdef WITH_THREADS
+  jthread_sync *sync = (jthread_sync *)malloc(sizeof(jthread_sync));
+
+  if (sync == NULL)
+    return NULL;
+#ifdef _WIN32
+  InitializeCriticalSection(&sync->lock);
+  InitializeConditionVariable(&sync->cond);
+#else
+  if (pthread_mutex_init(&sync->lock, NULL) != 0) {
+    free(sync);
+    return NULL;
+  }
+  if (pthread_cond_init(&sync->cond, NULL) != 0) {
+    pthread_mutex_destroy(&sync->lock);
+    free(sync);
+    return NULL;
+  }
+#endif
+  return sync;
+#else
+  return NULL;
+#endif
+}
+
+
+GLOBAL(void)
+jthread_sync_destroy(jthread_sync *sync)
+{
+#ifdef WITH_THREADS
+  if (sync == NULL)
+    return;
+#ifdef _WIN32
+  DeleteCriticalSection(&sync->lock);
+#else
+  pthread_cond_destroy(&sync->cond);
+  pthread_mutex_destroy(&sync->lock);
+#endif
+  free(sync);
+#endif
+}
+
+
+GLOBAL(void)
+jthread_lock(jthread_sync *sync)
+{
+#ifdef WITH_THREADS
+#ifdef _WIN32
+  EnterCriticalSection(&sync->lock);
+#else
+  pthread_mutex_lock(&sync->lock);
+#endif
+#endif
+}
+
+
+GLOBAL(void)
+jthread_unlock(jthread_sync *sync)
+{
+#ifdef WITH_THREADS
+#ifdef _WIN32
+  LeaveCriticalSection(&sync->lock);
+#else
+  pthread_mutex_unlock(&sync->lock);
+#endif
+#endif
+}
+
+
+GLOBAL(void)
+jthread_wait(jthread_sync *sync)
+{
+#ifdef WITH_THREADS
+#ifdef _WIN32
+  SleepConditionVariableCS(&sync->cond, &sync->lock, INFINITE);
+#else
+  pthread_cond_wait(&sync->cond, &sync->lock);
+#endif
+#endif
+}
+
+
+GLOBAL(void)
+jthread_broadcast(jthread_sync *sync)
+{
+#ifdef WITH_THREADS
+#ifdef _WIN32
+  WakeAllConditionVariable(&sync->cond);
+#else
+  pthread_cond_broadcast(&sync->cond);
+#endif
+#endif
+}
+
+
+GLOBAL(jthread *)
+jthread_start(jthread_task_fn task, void *arg)
+{
+#ifdef WITH_THREADS
+  jthread *thread = (jthread *)malloc(sizeof(jthread));
+
+  if (thread == NULL)
+    return NULL;
+  thread->task = task;
+  thread->arg = arg;
+#ifdef _WIN32
+  if ((thread->handle = CreateThread(NULL, 0, single_thread_main, thread, 0,
+                                     NULL)) == NULL) {
+#else
+  if (pthread_create(&thread->handle, NULL, single_thread_main,
+                     thread) != 0) {
+#endif
+    free(thread);
+    return NULL;
+  }
+  return thread;
+#else
+  return NULL;
+#endif
+}
+
+
+GLOBAL(void)
+jthread_join(jthread *thread)
+{
+#ifdef WITH_THREADS
+  if (thread == NULL)
+    return;
+#ifdef _WIN32
+  WaitForSingleObject(thread->handle, INFINITE);
+  CloseHandle(thread->handle);
+#else
+  pthread_join(thread->handle, NULL);
+#endif
+  free(thread);
+#endif
+}
@@ -0,0 +1,69 @@
+/*
+ * jthread.h
+ *
+ * Copyright (C) 2026, D. R. Commander.
+ * For conditions of distribution and use, see the accompanying README.ijg
+ * file.
+ *
+ * This file contains declarations for the minimal thread pool used by the
+ * multithreaded code paths in libjpeg-turbo and the TurboJPEG API library.
+ * These declarations are considered internal to the JPEG library; most
+ * applications using the library shouldn't need to include this file.
+ */
+
+/* Function that performs one task.  arg points to the task's argument
+ * structure.
+ */
+typedef void (*jthread_task_fn) (void *arg);
+
+/* Return the number of logical CPUs available to this process, or 1 if that
+ * cannot be determined or if the library was built without thread support.
+ */
+EXTERN(int) jthread_num_cpus(void);
+
+/* Perform num_tasks tasks using up to num_threads threads (including the
+ * calling thread.)  task is called once for each of the num_tasks argument
+ * structures in the args array, each of which is arg_size bytes in size.
+ * This function does not return until all tasks have completed.  If the
+ * library was built without thread support, if num_threads <= 1, or if
+ * threads cannot be created, then the tasks are performed sequentially by the
+ * calling thread.
+ */
+EXTERN(void) jthread_run(int num_threads, jthread_task_fn task, void *args,
+                         size_t arg_size, int num_tasks);
+
+/* Mutex and condition variable pair, used to synchronize threads that
+ * exchange data through a shared buffer
+ */
+typedef struct jthread_sync jthread_sync;
+
+/* Thread started by jthread_start() */
+typedef struct jthread jthread;
+
+/* Create a synchronization object.  Returns NULL if the object cannot be
+ * created or if the library was built without thread support.
+ */
+EXTERN(jthread_sync *) jthread_sync_create(void);
+EXTERN(void) jthread_sync_destroy(jthread_sync *sync);
+
+/* Acquire or release the mutex */
+EXTERN(void) jthread_lock(jthread_sync *sync);
+EXTERN(void) jthread_unlock(jthread_sync *sync);
+
+/* Wait on the condition variable.  The mutex must be held by the calling
+ * thread, and spurious wakeups are possible, so the caller must recheck its
+ * wait condition after this function returns.
+ */
+EXTERN(void) jthread_wait(jthread_sync *sync);
+
+/* Wake all threads that are waiting on the condition variable */
+EXTERN(void) jthread_broadcast(jthread_sync *sync);
+
+/* Call task(arg) in a new thread.  Returns NULL if the thread cannot be
+ * created or if the library was built without thread support, in which case
+ * task is not called.
+ */
+EXTERN(jthread *) jthread_start(jthread_task_fn task, void *arg);
+
+/* Wait for a thread started by jthread_start() to finish, and free it */
+EXTERN(void) jthread_join(jthread *thread);
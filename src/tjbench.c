@@ -97,7 +97,8 @@ static int tjErrorLine = -1, tjErrorCode = -1;
 static int stopOnWarning = 0, bottomUp = 0, noRealloc = 1, precision = 8,
   fastUpsample = 0, fastDCT = 0, optimize = 0, progressive = 0, maxScans = 0,
   arithmetic = 0, lossless = 0, restartIntervalBlocks = 0,
-  restartIntervalRows = 0, maxMemory = 0, maxPixels = 0, noICC = 0;
+  restartIntervalRows = 0, maxMemory = 0, maxPixels = 0, noICC = 0,
+  numThreads = 1, pipeline = 0;
 static char *ext = "ppm";
 static int sampleSize, compOnly = 0, decompOnly = 0, doWrite = 1,
   pf = TJPF_BGR, quiet = 0, doTile = 0, doYUV = 0, yuvAlign = 1;
@@ -212,6 +213,10 @@ static int decomp(unsigned char **jpegBufs, size_t *jpegSizes, void *dstBuf,
     THROW_TJ();
   if (tj3Set(handle, TJPARAM_MAXPIXELS, maxPixels) == -1)
     THROW_TJ();
+  if (tj3Set(handle, TJPARAM_NUMTHREADS, numThreads) == -1)
+    THROW_TJ();
+  if (tj3Set(handle, TJPARAM_PIPELINE, pipeline) == -1)
+    THROW_TJ();
   if (noICC && tj3Set(handle, TJPARAM_SAVEMARKERS, 0) == -1)
     THROW_TJ();
 
@@ -475,6 +480,8 @@ static int fullTest(tjhandle handle, void *srcBuf, int w, int h, int subsamp,
       THROW_TJ();
     if (tj3Set(handle, TJPARAM_MAXMEMORY, maxMemory) == -1)
       THROW_TJ();
+    if (tj3Set(handle, TJPARAM_NUMTHREADS, numThreads) == -1)
+      THROW_TJ();
 
     if (doYUV) {
       yuvSize = tj3YUVBufSize(tilew, yuvAlign, tileh, subsamp);
@@ -952,6 +959,9 @@ static void usage(char *progName)
   printf("-nowrite\n");
   printf("    Do not write reference or output images (improves consistency of benchmark\n");
   printf("    results)\n");
+  printf("-pipeline\n");
+  printf("    Perform entropy decoding and image reconstruction in separate threads when\n");
+  printf("    decompressing single-scan lossy JPEG images\n");
   printf("-pixelformat {rgb|bgr|rgbx|bgrx|xbgr|xrgb|gray}\n");
   printf("    Use the specified pixel format for packed-pixel source/destination buffers\n");
   printf("    [default = BGR]\n");
@@ -973,6 +983,9 @@ static void usage(char *progName)
   printf("-strict\n");
   printf("    Immediately discontinue the current compression/decompression/transform\n");
   printf("    operation if a warning (non-fatal error) occurs\n");
+  printf("-threads N\n");
+  printf("    Use up to N threads when compressing or decompressing JPEG images\n");
+  printf("    (0 = one thread per CPU) [default = 1]\n");
   printf("-tile\n");
   printf("    Compress/transform the input image into separate JPEG tiles of varying\n");
   printf("    sizes (useful for measuring JPEG overhead)\n");
@@ -1184,7 +1197,9 @@ int main(int argc, char *argv[])
                MATCH_ARG(argv[i], "-optimise", 2)) {
         optimize = 1;
         xformOpt |= TJXOPT_OPTIMIZE;
-      } else if (MATCH_ARG(argv[i], "-pixelformat", 3) && i < argc - 1) {
+      } else if (MATCH_ARG(argv[i], "-pipeline", 4))
+        pipeline = 1;
+      else if (MATCH_ARG(argv[i], "-pixelformat", 3) && i < argc - 1) {
         i++;
         if (!strcasecmp(argv[i], "bgr"))
           pf = TJPF_BGR;
@@ -1292,6 +1307,11 @@ int main(int argc, char *argv[])
           }
           if (!match) usage(argv[0]);
         } else usage(argv[0]);
+      } else if (MATCH_ARG(argv[i], "-threads", 3) && i < argc - 1) {
+        int tempi = atoi(argv[++i]);
+
+        if (tempi < 0) usage(argv[0]);
+        numThreads = tempi;
       } else if (MATCH_ARG(argv[i], "-tile", 3)) {
         doTile = 1;  xformOpt |= TJXOPT_CROP;
       } else if (MATCH_ARG(argv[i], "-transverse", 7))
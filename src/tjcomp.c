@@ -114,7 +114,10 @@ static void usage(char *programName)
   printf("    implies -optimize unless -arithmetic is also specified)\n");
   printf("-restart N\n");
   printf("    Add a restart marker every N MCU rows [default = 0 (no restart markers)].\n");
-  printf("    Append 'B' to specify the restart marker interval in MCUs (lossy only.)\n\n");
+  printf("    Append 'B' to specify the restart marker interval in MCUs (lossy only.)\n");
+  printf("-threads N\n");
+  printf("    Use up to N threads to compress JPEG images with restart markers or to\n");
+  printf("    optimize Huffman tables (0 = one thread per CPU) [default = 1]\n\n");
 
   printf("LOSSY JPEG OPTIONS (CAN BE ABBREVIATED)\n");
   printf("---------------------------------------\n");
@@ -152,8 +155,8 @@ int main(int argc, char **argv)
   int i, retval = 0;
   int arithmetic = -1, colorspace = TJCS_DEFAULT, fastDCT = -1,
     losslessPSV = -1, losslessPt = -1, maxMemory = -1, noICC = 0,
-    optimize = -1, pixelFormat = TJPF_UNKNOWN, precision = 8, progressive = -1,
-    quality = DEFAULT_QUALITY, restartIntervalBlocks = -1,
+    numThreads = -1, optimize = -1, pixelFormat = TJPF_UNKNOWN, precision = 8,
+    progressive = -1, quality = DEFAULT_QUALITY, restartIntervalBlocks = -1,
     restartIntervalRows = -1, subsamp = DEFAULT_SUBSAMP;
   char *iccFilename = NULL;
   tjhandle tjInstance = NULL;
@@ -220,6 +223,11 @@ int main(int argc, char **argv)
         restartIntervalBlocks = tempi;
       else
         restartIntervalRows = tempi;
+    } else if (MATCH_ARG(argv[i], "-threads", 2) && i < argc - 1) {
+      int tempi = atoi(argv[++i]);
+
+      if (tempi < 0) usage(argv[0]);
+      numThreads = tempi;
     } else if (MATCH_ARG(argv[i], "-subsamp", 2) && i < argc - 1) {
       i++;
       if (MATCH_ARG(argv[i], "444", 3))
@@ -284,6 +292,9 @@ int main(int argc, char **argv)
     THROW_TJ("setting TJPARAM_RESTARTROWS");
   if (maxMemory >= 0 && tj3Set(tjInstance, TJPARAM_MAXMEMORY, maxMemory) < 0)
     THROW_TJ("setting TJPARAM_MAXMEMORY");
+  if (numThreads >= 0 &&
+      tj3Set(tjInstance, TJPARAM_NUMTHREADS, numThreads) < 0)
+    THROW_TJ("setting TJPARAM_NUMTHREADS");
   if (noICC && tj3Set(tjInstance, TJPARAM_SAVEMARKERS, 0) < 0)
     THROW_TJ("setting TJPARAM_SAVEMARKERS");
 
@@ -107,10 +107,16 @@ static void usage(char *programName)
   printf("-noicc\n");
   printf("    Do not transfer the embedded ICC profile (if any) from the JPEG image to a\n");
   printf("    PNG output image\n");
+  printf("-pipeline\n");
+  printf("    Perform entropy decoding and image reconstruction in separate threads when\n");
+  printf("    decompressing single-scan lossy JPEG images\n");
   printf("-strict\n");
   printf("    Treat all warnings as fatal; abort immediately if incomplete or corrupt\n");
   printf("    data is encountered in the JPEG image, rather than trying to salvage the\n");
-  printf("    rest of the image\n\n");
+  printf("    rest of the image\n");
+  printf("-threads N\n");
+  printf("    Use up to N threads to decompress lossy JPEG images or lossless JPEG\n");
+  printf("    images with restart markers (0 = one thread per CPU) [default = 1]\n\n");
 
   printf("LOSSY JPEG OPTIONS (CAN BE ABBREVIATED)\n");
   printf("---------------------------------------\n");
@@ -163,8 +169,8 @@ int main(int argc, char **argv)
 {
   int i, retval = 0;
   int colorspace, fastDCT = -1, fastUpsample = -1, jpegPrecision, lossless,
-    maxMemory = -1, maxScans = -1, noICC = 0, pixelFormat = TJPF_UNKNOWN,
-    precision = -1, stopOnWarning = -1, subsamp;
+    maxMemory = -1, maxScans = -1, noICC = 0, numThreads = -1, pipeline = 0,
+    pixelFormat = TJPF_UNKNOWN, precision = -1, stopOnWarning = -1, subsamp;
   tjregion croppingRegion = TJUNCROPPED;
   tjscalingfactor scalingFactor = TJUNSCALED;
   char *iccFilename = NULL;
@@ -215,6 +221,8 @@ int main(int argc, char **argv)
       noICC = 1;
     else if (MATCH_ARG(argv[i], "-nosmooth", 2))
       fastUpsample = 1;
+    else if (MATCH_ARG(argv[i], "-pipeline", 2))
+      pipeline = 1;
     else if (MATCH_ARG(argv[i], "-precision", 4) && i < argc - 1) {
       int tempi = atoi(argv[++i]);
 
@@ -225,7 +233,12 @@ int main(int argc, char **argv)
       pixelFormat = TJPF_RGB;
     else if (MATCH_ARG(argv[i], "-strict", 3))
       stopOnWarning = 1;
-    else if (MATCH_ARG(argv[i], "-scale", 2) && i < argc - 1) {
+    else if (MATCH_ARG(argv[i], "-threads", 2) && i < argc - 1) {
+      int tempi = atoi(argv[++i]);
+
+      if (tempi < 0) usage(argv[0]);
+      numThreads = tempi;
+    } else if (MATCH_ARG(argv[i], "-scale", 2) && i < argc - 1) {
       int match = 0, temp_num = 0, temp_denom = 0, j;
 
       if (sscanf(argv[++i], "%d/%d", &temp_num, &temp_denom) < 2)
@@ -265,6 +278,11 @@ int main(int argc, char **argv)
     THROW_TJ("setting TJPARAM_MAXMEMORY");
   if (noICC && tj3Set(tjInstance, TJPARAM_SAVEMARKERS, 0) < 0)
     THROW_TJ("setting TJPARAM_SAVEMARKERS");
+  if (numThreads >= 0 &&
+      tj3Set(tjInstance, TJPARAM_NUMTHREADS, numThreads) < 0)
+    THROW_TJ("setting TJPARAM_NUMTHREADS");
+  if (pipeline && tj3Set(tjInstance, TJPARAM_PIPELINE, 1) < 0)
+    THROW_TJ("setting TJPARAM_PIPELINE");
 
   if ((jpegFile = fopen(argv[i++], "rb")) == NULL)
     THROW_UNIX("opening input file");
@@ -66,6 +66,9 @@ static void usage(char *progName)
   printf("-lossless = test lossless JPEG compression/decompression\n");
   printf("-alloc = test automatic JPEG buffer allocation\n");
   printf("-bmp = test packed-pixel image I/O\n");
+  printf("-threads N = test multithreaded compression/decompression using N threads\n");
+  printf("             (implies restart markers)\n");
+  printf("-pipeline = test pipelined decompression\n");
   exit(1);
 }
 
@@ -101,7 +104,8 @@ static const int _4sampleFormats[] = {
 static const int _onlyGray[] = { TJPF_GRAY };
 static const int _onlyRGB[] = { TJPF_RGB };
 
-static int doYUV = 0, lossless = 0, psv = 1, alloc = 0, yuvAlign = 4;
+static int doYUV = 0, lossless = 0, psv = 1, alloc = 0, yuvAlign = 4,
+  numThreads = 1, pipeline = 0;
 static int precision = 8, sampleSize, maxSample, tolerance, redToY, yellowToY;
 
 static int exitStatus = 0;
@@ -721,6 +725,12 @@ static void doTest(int w, int h, const int *formats, int nformats, int subsamp,
       TRY_TJ(dhandle, tj3Set(dhandle, TJPARAM_FASTUPSAMPLE, 1));
   }
   TRY_TJ(chandle, tj3Set(chandle, TJPARAM_SUBSAMP, subsamp));
+  if (numThreads != 1) {
+    TRY_TJ(chandle, tj3Set(chandle, TJPARAM_NUMTHREADS, numThreads));
+    TRY_TJ(dhandle, tj3Set(dhandle, TJPARAM_NUMTHREADS, numThreads));
+  }
+  if (pipeline)
+    TRY_TJ(dhandle, tj3Set(dhandle, TJPARAM_PIPELINE, 1));
 
   for (pfi = 0; pfi < nformats; pfi++) {
     if (formats[pfi] == TJPF_CMYK &&
@@ -729,6 +739,24 @@ static void doTest(int w, int h, const int *formats, int nformats, int subsamp,
     for (i = 0; i < 2; i++) {
       TRY_TJ(chandle, tj3Set(chandle, TJPARAM_BOTTOMUP, i == 1));
       TRY_TJ(dhandle, tj3Set(dhandle, TJPARAM_BOTTOMUP, i == 1));
+      /* Test multithreaded compression and decompression with restart
+         markers and multithreaded decompression without restart markers. */
+      if (numThreads != 1) {
+        /* Lossless JPEG restart intervals must be a multiple of the MCU row
+           width, so specify the restart interval in rows. */
+        if (lossless) {
+          TRY_TJ(chandle, tj3Set(chandle, TJPARAM_RESTARTROWS,
+                                 i == 0 ? 2 : 0));
+        } else {
+          TRY_TJ(chandle, tj3Set(chandle, TJPARAM_RESTARTBLOCKS,
+                                 i == 0 ? 2 : 0));
+        }
+        /* Test multithreaded decompression of progressive JPEG images using
+           the last pixel format. */
+        if (!lossless)
+          TRY_TJ(chandle, tj3Set(chandle, TJPARAM_PROGRESSIVE,
+                                 pfi == nformats - 1));
+      }
       pf = formats[pfi];
       if (!alloc) size = bufSize;
       compTest(chandle, &dstBuf, &size, w, h, pf, basename);
@@ -947,6 +975,193 @@ bailout:
 }
 
 
+static int decompCropped(tjhandle handle, unsigned char *jpegBuf,
+                         size_t jpegSize, void *dstBuf)
+{
+  if (precision <= 8)
+    return tj3Decompress8(handle, jpegBuf, jpegSize, (unsigned char *)dstBuf,
+                          0, TJPF_RGB);
+  else
+    return tj3Decompress12(handle, jpegBuf, jpegSize, (short *)dstBuf, 0,
+                           TJPF_RGB);
+}
+
+
+static void indexTest(void)
+{
+  /* Verify that decompressing a cropping region using a random-access index
+     produces the same output as decompressing it without the index. */
+  static const tjscalingfactor sf[3] = { { 1, 1 }, { 1, 2 }, { 3, 8 } };
+  int w = 75, h = 301, i, subsamp, sfi, y;
+  void *srcBuf = NULL, *dstBuf = NULL, *refBuf = NULL;
+  unsigned char *jpegBuf = NULL, *indexBuf = NULL;
+  size_t jpegSize = 0, indexSize = 0;
+  tjhandle chandle = NULL, dhandle = NULL, dhandle2 = NULL;
+
+  if ((chandle = tj3Init(TJINIT_COMPRESS)) == NULL ||
+      (dhandle = tj3Init(TJINIT_DECOMPRESS)) == NULL ||
+      (dhandle2 = tj3Init(TJINIT_DECOMPRESS)) == NULL)
+    THROW_TJ(NULL);
+  TRY_TJ(chandle, tj3Set(chandle, TJPARAM_PRECISION, precision));
+  TRY_TJ(chandle, tj3Set(chandle, TJPARAM_QUALITY, 95));
+
+  if ((srcBuf = malloc(w * h * 3 * sampleSize)) == NULL ||
+      (dstBuf = malloc(w * h * 3 * sampleSize)) == NULL ||
+      (refBuf = malloc(w * h * 3 * sampleSize)) == NULL)
+    THROW("Memory allocation failure");
+  for (i = 0; i < w * h * 3; i++)
+    setVal(srcBuf, i, random() % (maxSample + 1));
+
+  printf("Random-access index test\n");
+  for (subsamp = 0; subsamp < TJ_NUMSAMP; subsamp++) {
+    TRY_TJ(chandle, tj3Set(chandle, TJPARAM_SUBSAMP, subsamp));
+    if (precision <= 8) {
+      TRY_TJ(chandle, tj3Compress8(chandle, (unsigned char *)srcBuf, w, 0, h,
+                                   TJPF_RGB, &jpegBuf, &jpegSize));
+    } else {
+      TRY_TJ(chandle, tj3Compress12(chandle, (short *)srcBuf, w, 0, h,
+                                    TJPF_RGB, &jpegBuf, &jpegSize));
+    }
+    TRY_TJ(dhandle, tj3BuildIndex(dhandle, jpegBuf, jpegSize, &indexBuf,
+                                  &indexSize));
+    TRY_TJ(dhandle, tj3SetIndex(dhandle, indexBuf, indexSize));
+    tj3Free(indexBuf);  indexBuf = NULL;
+    TRY_TJ(dhandle2, tj3DecompressHeader(dhandle2, jpegBuf, jpegSize));
+
+    for (sfi = 0; sfi < 3; sfi++) {
+      int scaledWidth = TJSCALED(w, sf[sfi]);
+      int scaledHeight = TJSCALED(h, sf[sfi]);
+      int x = TJSCALED(tjMCUWidth[subsamp], sf[sfi]);
+
+      if (x >= scaledWidth) x = 0;
+      TRY_TJ(dhandle, tj3SetScalingFactor(dhandle, sf[sfi]));
+      TRY_TJ(dhandle2, tj3SetScalingFactor(dhandle2, sf[sfi]));
+      for (y = 1; y < scaledHeight; y += 23) {
+        tjregion cr;
+
+        cr.x = x;  cr.y = y;  cr.w = scaledWidth - x;
+        cr.h = scaledHeight - y < 19 ? scaledHeight - y : 19;
+        TRY_TJ(dhandle, tj3SetCroppingRegion(dhandle, cr));
+        TRY_TJ(dhandle2, tj3SetCroppingRegion(dhandle2, cr));
+        TRY_TJ(dhandle, decompCropped(dhandle, jpegBuf, jpegSize, dstBuf));
+        TRY_TJ(dhandle2, decompCropped(dhandle2, jpegBuf, jpegSize, refBuf));
+        if (memcmp(dstBuf, refBuf, cr.w * cr.h * 3 * sampleSize)) {
+          printf("%s %d/%d %dx%d+%d+%d: ", subNameLong[subsamp],
+                 sf[sfi].num, sf[sfi].denom, cr.w, cr.h, cr.x, cr.y);
+          THROW("Output differs when using index");
+        }
+      }
+      TRY_TJ(dhandle, tj3SetCroppingRegion(dhandle, TJUNCROPPED));
+      TRY_TJ(dhandle2, tj3SetCroppingRegion(dhandle2, TJUNCROPPED));
+    }
+  }
+
+  /* Progressive JPEG images cannot be indexed. */
+  TRY_TJ(chandle, tj3Set(chandle, TJPARAM_PROGRESSIVE, 1));
+  if (precision <= 8) {
+    TRY_TJ(chandle, tj3Compress8(chandle, (unsigned char *)srcBuf, w, 0, h,
+                                 TJPF_RGB, &jpegBuf, &jpegSize));
+  } else {
+    TRY_TJ(chandle, tj3Compress12(chandle, (short *)srcBuf, w, 0, h, TJPF_RGB,
+                                  &jpegBuf, &jpegSize));
+  }
+  if (tj3BuildIndex(dhandle, jpegBuf, jpegSize, &indexBuf, &indexSize) == 0)
+    THROW("tj3BuildIndex() should have failed");
+  printf("Done.\n");
+
+bailout:
+  free(srcBuf);
+  free(dstBuf);
+  free(refBuf);
+  tj3Free(jpegBuf);
+  tj3Free(indexBuf);
+  tj3Destroy(chandle);
+  tj3Destroy(dhandle);
+  tj3Destroy(dhandle2);
+}
+
+
+static void decompFileTest(void)
+{
+  /* Verify that tj3DecompressFile*() produces the same output as
+     tj3Decompress*() and that it returns a partial image, along with a
+     warning, if the JPEG file is truncated. */
+  int w = 75, h = 51, i, width = 0, height = 0;
+  void *srcBuf = NULL, *dstBuf = NULL, *refBuf = NULL;
+  unsigned char *jpegBuf = NULL;
+  size_t jpegSize = 0;
+  tjhandle chandle = NULL, dhandle = NULL;
+  char filename[80] = { 0 };
+
+  if ((chandle = tj3Init(TJINIT_COMPRESS)) == NULL ||
+      (dhandle = tj3Init(TJINIT_DECOMPRESS)) == NULL)
+    THROW_TJ(NULL);
+  TRY_TJ(chandle, tj3Set(chandle, TJPARAM_PRECISION, precision));
+  TRY_TJ(chandle, tj3Set(chandle, TJPARAM_LOSSLESS, lossless));
+  TRY_TJ(chandle, tj3Set(chandle, TJPARAM_QUALITY, 95));
+  TRY_TJ(chandle, tj3Set(chandle, TJPARAM_SUBSAMP,
+                         lossless ? TJSAMP_444 : TJSAMP_420));
+
+  if ((srcBuf = malloc(w * h * 3 * sampleSize)) == NULL ||
+      (refBuf = malloc(w * h * 3 * sampleSize)) == NULL)
+    THROW("Memory allocation failure");
+  for (i = 0; i < w * h * 3; i++)
+    setVal(srcBuf, i, random() % (maxSample + 1));
+
+  printf("tj3DecompressFile() test\n");
+  if (precision <= 8) {
+    TRY_TJ(chandle, tj3Compress8(chandle, (unsigned char *)srcBuf, w, 0, h,
+                                 TJPF_RGB, &jpegBuf, &jpegSize));
+    TRY_TJ(dhandle, tj3Decompress8(dhandle, jpegBuf, jpegSize,
+                                   (unsigned char *)refBuf, 0, TJPF_RGB));
+  } else if (precision <= 12) {
+    TRY_TJ(chandle, tj3Compress12(chandle, (short *)srcBuf, w, 0, h, TJPF_RGB,
+                                  &jpegBuf, &jpegSize));
+    TRY_TJ(dhandle, tj3Decompress12(dhandle, jpegBuf, jpegSize,
+                                    (short *)refBuf, 0, TJPF_RGB));
+  } else {
+    TRY_TJ(chandle, tj3Compress16(chandle, (unsigned short *)srcBuf, w, 0, h,
+                                  TJPF_RGB, &jpegBuf, &jpegSize));
+    TRY_TJ(dhandle, tj3Decompress16(dhandle, jpegBuf, jpegSize,
+                                    (unsigned short *)refBuf, 0, TJPF_RGB));
+  }
+
+  SNPRINTF(filename, 80, "test_decompfile%d_%d.jpg", precision, getpid());
+  for (i = 0; i < 2; i++) {
+    /* The second iteration decompresses a truncated JPEG file. */
+    writeJPEG(jpegBuf, i == 0 ? jpegSize : jpegSize * 3 / 4, filename);
+    if (precision <= 8)
+      dstBuf = tj3DecompressFile8(dhandle, filename, &width, 1, &height,
+                                  TJPF_RGB);
+    else if (precision <= 12)
+      dstBuf = tj3DecompressFile12(dhandle, filename, &width, 1, &height,
+                                   TJPF_RGB);
+    else
+      dstBuf = tj3DecompressFile16(dhandle, filename, &width, 1, &height,
+                                   TJPF_RGB);
+    if (dstBuf == NULL) THROW_TJ(dhandle);
+    if (width != w || height != h)
+      THROW("tj3DecompressFile() returned incorrect dimensions");
+    if (i == 0) {
+      if (memcmp(dstBuf, refBuf, w * h * 3 * sampleSize))
+        THROW("Output differs when decompressing from a file");
+    } else if (tj3GetErrorCode(dhandle) != TJERR_WARNING)
+      THROW("tj3DecompressFile() should have generated a warning");
+    tj3Free(dstBuf);  dstBuf = NULL;
+  }
+  printf("Done.\n");
+
+bailout:
+  unlink(filename);
+  free(srcBuf);
+  tj3Free(dstBuf);
+  free(refBuf);
+  tj3Free(jpegBuf);
+  tj3Destroy(chandle);
+  tj3Destroy(dhandle);
+}
+
+
 static void rgb_to_cmyk(int r, int g, int b, int *c, int *m, int *y, int *k)
 {
   double ctmp = 1.0 - ((double)r / (double)maxSample);
@@ -1392,6 +1607,14 @@ int main(int argc, char *argv[])
       else if (!strcasecmp(argv[i], "-lossless")) lossless = 1;
       else if (!strcasecmp(argv[i], "-alloc")) alloc = 1;
       else if (!strcasecmp(argv[i], "-bmp")) bmp = 1;
+      else if (!strcasecmp(argv[i], "-pipeline")) pipeline = 1;
+      else if (!strcasecmp(argv[i], "-threads") && i < argc - 1) {
+        int tempi = atoi(argv[++i]);
+
+        if (tempi < 0)
+          usage(argv[0]);
+        numThreads = tempi;
+      }
       else if (!strcasecmp(argv[i], "-precision") && i < argc - 1) {
         int tempi = atoi(argv[++i]);
 
@@ -1417,6 +1640,9 @@ int main(int argc, char *argv[])
 
   if (bmp) return bmpTest();
   if (alloc) printf("Testing automatic buffer allocation\n");
+  if (numThreads != 1)
+    printf("Testing multithreaded compression/decompression\n");
+  if (pipeline) printf("Testing pipelined decompression\n");
   if (doYUV) num4bf = 4;
   overflowTest();
   doTest(35, 39, _3sampleFormats, 2, TJSAMP_444, "test");
@@ -1443,6 +1669,8 @@ int main(int argc, char *argv[])
     doTest(35, 39, _4sampleFormats, 4, TJSAMP_GRAY, "test");
   }
   bufSizeTest();
+  if (!lossless && !doYUV) indexTest();
+  if (!doYUV) decompFileTest();
   if (doYUV) {
     printf("\n--------------------\n\n");
     doTest(48, 48, _onlyRGB, 1, TJSAMP_444, "test_yuv0");
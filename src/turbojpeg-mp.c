@@ -73,6 +73,63 @@
 
 /******************************** Compressor *********************************/
 
+/* Compress one band of a packed-pixel image (see setupCompBands()).  If the
+   band's Huffman statistics are to be merged with those of the other bands,
+   then the first call performs the statistics-gathering pass and leaves the
+   band's instance active, and the second call performs the output pass. */
+static void GET_NAME(compressBand, BITS_IN_JSAMPLE) (void *arg)
+{
+  static const char FUNCTION_NAME[] = GET_STRING(tj3Compress, BITS_IN_JSAMPLE);
+  tjcompband *band = (tjcompband *)arg;
+  _JSAMPROW *row_pointer = (_JSAMPROW *)band->rowPointers;
+  tjinstance *this = (tjinstance *)band->handle;
+  j_compress_ptr cinfo;
+  int retval = 0;
+
+  if (this == NULL) {
+    if ((this = (tjinstance *)tj3Init(TJINIT_COMPRESS)) == NULL) {
+      SNPRINTF(band->errStr, JMSG_LENGTH_MAX, "%s", errStr);
+      band->retval = -1;
+      return;
+    }
+    band->handle = (tjhandle)this;
+  }
+  cinfo = &this->cinfo;
+
+  CATCH_LIBJPEG(this);
+
+  if (cinfo->global_state == CSTATE_START) {
+    copyCompParams(this, band->parent);
+    cinfo->image_width = band->parent->cinfo.image_width;
+    cinfo->image_height = band->numLines;
+    cinfo->data_precision = band->parent->cinfo.data_precision;
+    setCompDefaults(this, band->pixelFormat, FALSE);
+    cinfo->master->lhuff_counts = band->huffCounts;
+    jpeg_mem_dest_tj(cinfo, &band->jpegBuf, &band->jpegSize, TRUE);
+
+    jpeg_start_compress(cinfo, TRUE);
+    if (band->firstLine == 0 && band->parent->iccBuf != NULL &&
+        band->parent->iccSize != 0)
+      jpeg_write_icc_profile(cinfo, band->parent->iccBuf,
+                             (unsigned int)band->parent->iccSize);
+    while (cinfo->next_scanline < cinfo->image_height)
+      _jpeg_write_scanlines(cinfo, &row_pointer[cinfo->next_scanline],
+                            cinfo->image_height - cinfo->next_scanline);
+    if (band->huffCounts != NULL) goto bailout;
+  }
+  jpeg_finish_compress(cinfo);
+  if (!finishCompBand(band))
+    THROW("Unexplained structure of band JPEG image");
+
+bailout:
+  band->retval = retval;
+  band->warning = this->jerr.warning;
+  if (retval == -1 || this->jerr.warning)
+    SNPRINTF(band->errStr, JMSG_LENGTH_MAX, "%s", this->errStr);
+  if (retval == -1 || cinfo->global_state == CSTATE_START)
+    destroyCompBand(band);
+}
+
 /* TurboJPEG 3.0+ */
 DLLEXPORT int GET_NAME(tj3Compress, BITS_IN_JSAMPLE)
   (tjhandle handle, const _JSAMPLE *srcBuf, int width, int pitch, int height,
@@ -82,6 +139,8 @@ DLLEXPORT int GET_NAME(tj3Compress, BITS_IN_JSAMPLE)
   int i, retval = 0;
   boolean alloc = TRUE;
   _JSAMPROW *row_pointer = NULL;
+  int numBands = 0;
+  tjcompband *bands = NULL;
 
   GET_CINSTANCE(handle)
   if ((this->init & COMPRESS) == 0)
@@ -122,26 +181,61 @@ DLLEXPORT int GET_NAME(tj3Compress, BITS_IN_JSAMPLE)
   if (this->noRealloc) alloc = FALSE;
   jpeg_mem_dest_tj(cinfo, jpegBuf, jpegSize, alloc);
 
-  jpeg_start_compress(cinfo, TRUE);
-  if (this->iccBuf != NULL && this->iccSize != 0)
-    jpeg_write_icc_profile(cinfo, this->iccBuf, (unsigned int)this->iccSize);
   for (i = 0; i < height; i++) {
     if (this->bottomUp)
       row_pointer[i] = (_JSAMPROW)&srcBuf[(height - i - 1) * (size_t)pitch];
     else
       row_pointer[i] = (_JSAMPROW)&srcBuf[i * (size_t)pitch];
   }
+
+  numBands = setupCompBands(this, &bands);
+  if (numBands > 0) {
+    int numThreads = this->numThreads ? this->numThreads : jthread_num_cpus();
+    int pass, numPasses = bands[0].huffCounts ? 2 : 1;
+
+    for (i = 0; i < numBands; i++) {
+      bands[i].rowPointers = &row_pointer[bands[i].firstLine];
+      bands[i].pixelFormat = pixelFormat;
+    }
+    for (pass = 0; pass < numPasses && retval == 0; pass++) {
+      if (pass > 0) mergeCompBandStats(bands, numBands);
+      jthread_run(numThreads, GET_NAME(compressBand, BITS_IN_JSAMPLE), bands,
+                  sizeof(tjcompband), numBands);
+      for (i = 0; i < numBands; i++) {
+        if (bands[i].retval == -1 || bands[i].warning) {
+          SNPRINTF(this->errStr, JMSG_LENGTH_MAX, "%s", bands[i].errStr);
+          this->isInstanceError = TRUE;
+          SNPRINTF(errStr, JMSG_LENGTH_MAX, "%s", bands[i].errStr);
+          if (bands[i].retval == -1) {
+            retval = -1;
+            this->jerr.warning = FALSE;
+            break;
+          }
+          this->jerr.warning = TRUE;
+        }
+      }
+    }
+    if (retval == 0) writeCompBands(this, bands, numBands);
+    goto bailout;
+  }
+
+  jpeg_start_compress(cinfo, TRUE);
+  if (this->iccBuf != NULL && this->iccSize != 0)
+    jpeg_write_icc_profile(cinfo, this->iccBuf, (unsigned int)this->iccSize);
   while (cinfo->next_scanline < cinfo->image_height)
     _jpeg_write_scanlines(cinfo, &row_pointer[cinfo->next_scanline],
                           cinfo->image_height - cinfo->next_scanline);
   jpeg_finish_compress(cinfo);
 
 bailout:
+  if (numBands > 0 && alloc)
+    (*cinfo->dest->term_destination) (cinfo);
   if (cinfo->global_state > CSTATE_START && alloc)
     (*cinfo->dest->term_destination) (cinfo);
   if (cinfo->global_state > CSTATE_START || retval == -1)
     jpeg_abort_compress(cinfo);
   free(row_pointer);
+  freeCompBands(bands, numBands);
   if (this->jerr.warning) retval = -1;
   return retval;
 }
@@ -149,6 +243,72 @@ bailout:
 
 /******************************* Decompressor ********************************/
 
+/* Decompress one band of a JPEG image (see setupDecompBands()) */
+static void GET_NAME(decompressBand, BITS_IN_JSAMPLE) (void *arg)
+{
+  static const char FUNCTION_NAME[] =
+    GET_STRING(tj3Decompress, BITS_IN_JSAMPLE);
+  tjdecompband *band = (tjdecompband *)arg;
+  j_decompress_ptr parentinfo = &band->parent->dinfo;
+  _JSAMPROW *row_pointer = (_JSAMPROW *)band->rowPointers;
+  tjinstance *this;
+  j_decompress_ptr dinfo;
+  int retval = 0;
+
+  if ((this = (tjinstance *)tj3Init(TJINIT_DECOMPRESS)) == NULL) {
+    SNPRINTF(band->errStr, JMSG_LENGTH_MAX, "%s", errStr);
+    band->retval = -1;
+    return;
+  }
+  dinfo = &this->dinfo;
+  this->jerr.stopOnWarning = band->parent->jerr.stopOnWarning;
+  dinfo->mem->max_memory_to_use = (long)band->parent->maxMemory * 1048576L;
+
+  CATCH_LIBJPEG(this);
+
+  jpeg_mem_src_tj(dinfo, band->jpegBuf, band->jpegSize);
+  jpeg_read_header(dinfo, TRUE);
+  dinfo->data_precision = parentinfo->data_precision;
+  dinfo->out_color_space = parentinfo->out_color_space;
+  dinfo->do_fancy_upsampling = parentinfo->do_fancy_upsampling;
+  dinfo->dct_method = parentinfo->dct_method;
+  dinfo->scale_num = parentinfo->scale_num;
+  dinfo->scale_denom = parentinfo->scale_denom;
+  if (band->shareCoefs)
+    dinfo->master->coef_source = parentinfo;
+  if (band->resumeHuff) {
+    dinfo->master->resume_huff = TRUE;
+    dinfo->master->resume_get_buffer = band->getBuffer;
+    dinfo->master->resume_bits_left = band->bitsLeft;
+    memcpy(dinfo->master->resume_dc_val, band->lastDCVal,
+           sizeof(band->lastDCVal));
+  }
+
+  jpeg_start_decompress(dinfo);
+
+#if BITS_IN_JSAMPLE != 16
+  if (band->skipLines > 0 &&
+      _jpeg_skip_scanlines(dinfo, band->skipLines) != band->skipLines)
+    THROW("Unexplained mismatch between specified and actual band boundary");
+#endif
+  while (dinfo->output_scanline < band->skipLines + band->numLines)
+    _jpeg_read_scanlines(dinfo,
+                         &row_pointer[dinfo->output_scanline - band->skipLines],
+                         band->skipLines + band->numLines -
+                         dinfo->output_scanline);
+  /* Check for trailing data after the last band, as single-threaded
+     decompression would. */
+  if (dinfo->output_scanline == dinfo->output_height)
+    jpeg_finish_decompress(dinfo);
+
+bailout:
+  band->retval = retval;
+  band->warning = this->jerr.warning;
+  if (retval == -1 || this->jerr.warning)
+    SNPRINTF(band->errStr, JMSG_LENGTH_MAX, "%s", this->errStr);
+  tj3Destroy((tjhandle)this);
+}
+
 /* TurboJPEG 3.0+ */
 DLLEXPORT int GET_NAME(tj3Decompress, BITS_IN_JSAMPLE)
   (tjhandle handle, const unsigned char *jpegBuf, size_t jpegSize,
@@ -157,10 +317,12 @@ DLLEXPORT int GET_NAME(tj3Decompress, BITS_IN_JSAMPLE)
   static const char FUNCTION_NAME[] =
     GET_STRING(tj3Decompress, BITS_IN_JSAMPLE);
   _JSAMPROW *row_pointer = NULL;
-  int croppedHeight, i, retval = 0;
+  int croppedHeight, i, retval = 0, numBands = 0;
 #if BITS_IN_JSAMPLE != 16
-  int scaledWidth;
+  int scaledWidth, cropY;
 #endif
+  unsigned char *bandBuf = NULL;
+  tjdecompband *bands = NULL;
   struct my_progress_mgr progress;
 
   GET_DINSTANCE(handle);
@@ -188,6 +350,9 @@ DLLEXPORT int GET_NAME(tj3Decompress, BITS_IN_JSAMPLE)
     jpeg_read_header(dinfo, TRUE);
   }
   setDecompParameters(this);
+#if BITS_IN_JSAMPLE != 16
+  useIndex(this, jpegBuf, jpegSize, &bandBuf, &cropY);
+#endif
 #if BITS_IN_JSAMPLE == 12
   if (this->precision == 8 && !this->lossless)
     dinfo->data_precision = 12;
@@ -206,7 +371,16 @@ DLLEXPORT int GET_NAME(tj3Decompress, BITS_IN_JSAMPLE)
   dinfo->scale_num = this->scalingFactor.num;
   dinfo->scale_denom = this->scalingFactor.denom;
 
-  jpeg_start_decompress(dinfo);
+  numBands = setupDecompBands(this, jpegBuf, jpegSize, &bands);
+  if (numBands == 0 || bands[0].shareCoefs) {
+    jpeg_set_pipelining(dinfo, this->pipeline);
+    jpeg_start_decompress(dinfo);
+  }
+  if (numBands > 0 && bands[0].shareCoefs && !shareCoefBuffer(this)) {
+    freeDecompBands(bands, numBands);
+    bands = NULL;
+    numBands = 0;
+  }
 
 #if BITS_IN_JSAMPLE != 16
   if (this->croppingRegion.x != 0 ||
@@ -246,33 +420,51 @@ DLLEXPORT int GET_NAME(tj3Decompress, BITS_IN_JSAMPLE)
       row_pointer[i] = &dstBuf[i * (size_t)pitch];
   }
 
+  if (numBands > 0) {
+    int numThreads = this->numThreads ? this->numThreads : jthread_num_cpus();
+
+    for (i = 0; i < numBands; i++)
+      bands[i].rowPointers = &row_pointer[bands[i].firstLine];
+    jthread_run(numThreads, GET_NAME(decompressBand, BITS_IN_JSAMPLE), bands,
+                sizeof(tjdecompband), numBands);
+    for (i = 0; i < numBands; i++) {
+      if (bands[i].retval == -1 || bands[i].warning) {
+        SNPRINTF(this->errStr, JMSG_LENGTH_MAX, "%s", bands[i].errStr);
+        this->isInstanceError = TRUE;
+        SNPRINTF(errStr, JMSG_LENGTH_MAX, "%s", bands[i].errStr);
+        if (bands[i].retval == -1) {
+          retval = -1;
+          this->jerr.warning = FALSE;
+          break;
+        }
+        this->jerr.warning = TRUE;
+      }
+    }
+    goto bailout;
+  }
 #if BITS_IN_JSAMPLE != 16
-  if (this->croppingRegion.y != 0 || this->croppingRegion.h != 0) {
-    if (this->croppingRegion.y != 0) {
-      JDIMENSION lines = _jpeg_skip_scanlines(dinfo, this->croppingRegion.y);
+  else if (this->croppingRegion.y != 0 || this->croppingRegion.h != 0) {
+    if (cropY != 0) {
+      JDIMENSION lines = _jpeg_skip_scanlines(dinfo, cropY);
 
-      if ((int)lines != this->croppingRegion.y)
+      if ((int)lines != cropY)
         THROWI("Unexplained mismatch between specified (%d) and\n"
                "actual (%d) cropping region upper boundary",
-               this->croppingRegion.y, (int)lines);
+               cropY, (int)lines);
     }
-    while ((int)dinfo->output_scanline <
-           this->croppingRegion.y + this->croppingRegion.h)
-      _jpeg_read_scanlines(dinfo, &row_pointer[dinfo->output_scanline -
-                                               this->croppingRegion.y],
-                           this->croppingRegion.y + this->croppingRegion.h -
+    while ((int)dinfo->output_scanline < cropY + this->croppingRegion.h)
+      _jpeg_read_scanlines(dinfo, &row_pointer[dinfo->output_scanline - cropY],
+                           cropY + this->croppingRegion.h -
                            dinfo->output_scanline);
-    if (this->croppingRegion.y + this->croppingRegion.h !=
-        (int)dinfo->output_height) {
+    if (cropY + this->croppingRegion.h != (int)dinfo->output_height) {
       JDIMENSION lines = _jpeg_skip_scanlines(dinfo, dinfo->output_height -
-                                                     this->croppingRegion.y -
+                                                     cropY -
                                                      this->croppingRegion.h);
 
-      if (lines != dinfo->output_height - this->croppingRegion.y -
-                   this->croppingRegion.h)
+      if (lines != dinfo->output_height - cropY - this->croppingRegion.h)
         THROWI("Unexplained mismatch between specified (%d) and\n"
                "actual (%d) cropping region lower boundary",
-               this->croppingRegion.y + this->croppingRegion.h,
+               cropY + this->croppingRegion.h,
                (int)(dinfo->output_height - lines));
     }
   } else
@@ -287,11 +479,86 @@ DLLEXPORT int GET_NAME(tj3Decompress, BITS_IN_JSAMPLE)
 bailout:
   if (dinfo->global_state > DSTATE_START) jpeg_abort_decompress(dinfo);
   free(row_pointer);
+  free(bandBuf);
+  freeDecompBands(bands, numBands);
   if (this->jerr.warning) retval = -1;
   return retval;
 }
 
 
+/* TurboJPEG 3.2+ */
+DLLEXPORT _JSAMPLE *GET_NAME(tj3DecompressFile, BITS_IN_JSAMPLE)
+  (tjhandle handle, const char *filename, int *width, int align, int *height,
+   int pixelFormat)
+{
+  static const char FUNCTION_NAME[] =
+    GET_STRING(tj3DecompressFile, BITS_IN_JSAMPLE);
+  int retval = 0, dstWidth, dstHeight;
+  unsigned char *jpegBuf = NULL;
+  size_t jpegSize = 0, pitch;
+  boolean mapped = FALSE;
+  _JSAMPLE *dstBuf = NULL;
+
+  GET_TJINSTANCE(handle, NULL)
+  if ((this->init & DECOMPRESS) == 0)
+    THROW("Instance has not been initialized for decompression");
+
+  if (!filename || !width || align < 1 || !height || pixelFormat < 0 ||
+      pixelFormat >= TJ_NUMPF)
+    THROW("Invalid argument");
+  if ((align & (align - 1)) != 0)
+    THROW("Alignment must be a power of 2");
+
+  if (mapFile(filename, &jpegBuf, &jpegSize, &mapped) < 0)
+    THROW_UNIX("Cannot read input file");
+  if (jpegSize == 0)
+    THROW("Input file contains no data");
+
+  if (tj3DecompressHeader(handle, jpegBuf, jpegSize) == -1) {
+    retval = -1;  goto bailout;
+  }
+
+  /* Compute the destination image dimensions in the same manner as
+     tj3Decompress*() */
+  dstWidth = this->jpegWidth;  dstHeight = this->jpegHeight;
+#if BITS_IN_JSAMPLE != 16
+  if (!this->lossless) {
+    dstWidth = this->croppingRegion.w ? this->croppingRegion.w :
+               TJSCALED(this->jpegWidth, this->scalingFactor);
+    dstHeight = this->croppingRegion.h ? this->croppingRegion.h :
+                TJSCALED(this->jpegHeight, this->scalingFactor);
+  }
+#endif
+
+  pitch = PAD((size_t)dstWidth * tjPixelSize[pixelFormat], align);
+  if (pitch > (size_t)INT_MAX ||
+#if ULLONG_MAX > SIZE_MAX
+      (unsigned long long)pitch * (unsigned long long)dstHeight >
+      (unsigned long long)((size_t)-1) ||
+#endif
+      (dstBuf = (_JSAMPLE *)malloc(pitch * dstHeight *
+                                   sizeof(_JSAMPLE))) == NULL)
+    THROW("Memory allocation failure");
+
+  /* If the JPEG image is truncated or corrupt and TJPARAM_STOPONWARNING is
+     unset, then tj3Decompress*() returns -1 but still decompresses as much of
+     the image as possible, so we return the image and leave the warning for
+     tj3GetErrorStr() and tj3GetErrorCode() to report. */
+  if (GET_NAME(tj3Decompress, BITS_IN_JSAMPLE)
+        (handle, jpegBuf, jpegSize, dstBuf, (int)pitch, pixelFormat) == -1 &&
+      (!this->jerr.warning || this->jerr.stopOnWarning)) {
+    retval = -1;  goto bailout;
+  }
+
+  *width = dstWidth;  *height = dstHeight;
+
+bailout:
+  if (jpegBuf) unmapFile(jpegBuf, jpegSize, mapped);
+  if (retval < 0) { free(dstBuf);  dstBuf = NULL; }
+  return dstBuf;
+}
+
+
 /*************************** Packed-Pixel Image I/O **************************/
 
 #if BITS_IN_JSAMPLE != 16 || defined(C_LOSSLESS_SUPPORTED)
@@ -46,6 +46,11 @@
 #include "transupp.h"
 #include "jpegapicomp.h"
 #include "cdjpeg.h"
+#include "jthread.h"
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #undef tj3Init
 DLLEXPORT tjhandle tj3Init(int initType);
@@ -110,6 +115,7 @@ typedef struct _tjinstance {
   boolean isInstanceError;
   unsigned char *iccBuf, *decompICCBuf;
   size_t iccSize, decompICCSize;
+  unsigned char *index;
   /* Parameters */
   boolean bottomUp;
   boolean noRealloc;
@@ -138,6 +144,8 @@ typedef struct _tjinstance {
   int maxMemory;
   int maxPixels;
   int saveMarkers;
+  int numThreads;
+  int pipeline;
 } tjinstance;
 
 static tjhandle _tjInitCompress(tjinstance *this);
@@ -377,6 +385,7 @@ static void setCompDefaults(tjinstance *this, int pixelFormat, boolean yuv)
   this->cinfo.Y_density = (UINT16)this->yDensity;
   this->cinfo.density_unit = (UINT8)this->densityUnits;
   this->cinfo.mem->max_memory_to_use = (long)this->maxMemory * 1048576L;
+  jpeg_set_num_threads(&this->cinfo, this->numThreads);
 
   if (this->lossless && !yuv) {
 #ifdef C_LOSSLESS_SUPPORTED
@@ -536,6 +545,872 @@ static void setDecompParameters(tjinstance *this)
 }
 
 
+/* Multithreaded decompression
+
+   A JPEG image can be decoded in parallel by splitting it into horizontal
+   bands of iMCU rows and decoding each band using a separate libjpeg instance
+   from a self-contained JPEG image that consists of the original headers (with
+   a modified image height) followed by the band's entropy-coded data.  Each
+   band also includes the iMCU rows immediately above and below it (if any), so
+   that context-dependent upsampling of the band's edge rows produces the same
+   output as single-threaded decompression.  The extra rows are decoded but not
+   written to the destination image.
+
+   If the image has restart markers, then each band begins on a restart
+   boundary, since the Huffman decoder's state is reset at each restart
+   boundary.  This also applies to lossless JPEG images, since the predictors
+   are reset at each restart boundary.  Lossless JPEG images never require the
+   extra rows, because vertically subsampled lossless JPEG images are
+   decompressed using a single thread.  Otherwise, if the image is Huffman-coded, then the Huffman
+   decoder's state at the start of each iMCU row is determined using
+   speculative parallel Huffman decoding (see jpeg_huff_find_row_states() in
+   jdhuff.c), and each band begins with the Huffman decoder in that state.
+
+   Multi-scan (progressive, etc.) images are instead absorbed into the
+   whole-image coefficient buffer of the parent instance, which requires a
+   single thread.  Each band then uses a separate libjpeg instance that reads
+   only the JPEG headers and takes its DCT coefficients from the parent's
+   buffer (see the coef_source field in struct jpeg_decomp_master), so only
+   the inverse DCT, block smoothing, upsampling, and color conversion steps
+   are performed in parallel. */
+
+typedef struct {
+  tjinstance *parent;
+  unsigned char *jpegBuf;           /* self-contained JPEG image */
+  size_t jpegSize;
+  void *rowPointers;                /* destination rows for this band */
+  JDIMENSION firstLine;             /* first output row of this band */
+  JDIMENSION skipLines, numLines;   /* rows to skip, rows to read */
+  boolean shareCoefs;               /* TRUE if using parent's coefficients */
+  boolean resumeHuff;               /* TRUE if starting mid-stream */
+  unsigned int getBuffer;           /* initial Huffman decoder state */
+  int bitsLeft;
+  int lastDCVal[MAX_COMPS_IN_SCAN];
+  int retval;
+  boolean warning;
+  char errStr[JMSG_LENGTH_MAX];
+} tjdecompband;
+
+static void freeDecompBands(tjdecompband *bands, int numBands)
+{
+  int i;
+
+  if (!bands) return;
+  for (i = 0; i < numBands; i++)
+    free(bands[i].jpegBuf);
+  free(bands);
+}
+
+/* Returns the offset of the SOF marker's length field within the JPEG
+   headers, or 0 if the SOF marker cannot be found.  The image height is stored
+   at offsets 3 and 4 relative to that position. */
+static size_t findSOF(const unsigned char *jpegBuf, size_t sosEnd)
+{
+  size_t pos = 2;
+
+  while (pos + 4 <= sosEnd) {
+    int marker;
+
+    if (jpegBuf[pos] != 0xFF) return 0;
+    while (pos < sosEnd && jpegBuf[pos] == 0xFF) pos++;
+    if (pos + 3 > sosEnd) return 0;
+    marker = jpegBuf[pos++];
+    if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 &&
+        marker != 0xC8 && marker != 0xCC)
+      return pos + 5 <= sosEnd ? pos : 0;
+    pos += (jpegBuf[pos] << 8) | jpegBuf[pos + 1];
+  }
+  return 0;
+}
+
+/* Remove the byte stuffing from the entropy-coded data that begins at offset
+   sosEnd in jpegBuf, and return a copy of the data (followed by
+   JPEG_HUFF_SPEC_PADDING zero bytes) that is suitable for passing to
+   jpeg_huff_find_row_states().  The memory is allocated from the libjpeg
+   memory pool, since jpeg_huff_find_row_states() may throw an error if a
+   Huffman table is invalid.  *dataEnd (if non-NULL) receives the offset of the
+   marker that terminates the entropy-coded data.  Returns NULL if the
+   entropy-coded data is truncated. */
+static JOCTET *unstuffEntropyData(j_decompress_ptr dinfo,
+                                  const unsigned char *jpegBuf,
+                                  size_t jpegSize, size_t sosEnd,
+                                  size_t *dataSize, size_t *dataEnd)
+{
+  JOCTET *data;
+  size_t pos = sosEnd;
+
+  data = (JOCTET *)(*dinfo->mem->alloc_large)
+    ((j_common_ptr)dinfo, JPOOL_IMAGE,
+     jpegSize - sosEnd + JPEG_HUFF_SPEC_PADDING);
+  *dataSize = 0;
+  for (;;) {
+    const unsigned char *ptr = pos < jpegSize ?
+      (const unsigned char *)memchr(&jpegBuf[pos], 0xFF, jpegSize - pos) :
+      NULL;
+    size_t markerPos;
+
+    if (!ptr) return NULL;
+    markerPos = ptr - jpegBuf;
+    memcpy(&data[*dataSize], &jpegBuf[pos], markerPos - pos);
+    *dataSize += markerPos - pos;
+    pos = markerPos + 1;
+    while (pos < jpegSize && jpegBuf[pos] == 0xFF) pos++;
+    if (pos >= jpegSize) return NULL;
+    if (jpegBuf[pos] != 0) {
+      if (dataEnd) *dataEnd = markerPos;
+      break;
+    }
+    data[(*dataSize)++] = 0xFF;
+    pos++;
+  }
+  memset(&data[*dataSize], 0, JPEG_HUFF_SPEC_PADDING);
+  return data;
+}
+
+#define MCU_INDEX(row)  ((row) * mcuRowsPerIMCU * mcusPerRow)
+#define IS_CUT_ROW(row) \
+  (restartInterval == 0 || MCU_INDEX(row) % restartInterval == 0)
+
+/* Returns the number of bands, or 0 if the JPEG image cannot be (or should
+   not be) decompressed using multiple threads.  The JPEG header must have
+   been read from jpegBuf, and the output parameters must have been set. */
+static int setupDecompBands(tjinstance *this, const unsigned char *jpegBuf,
+                            size_t jpegSize, tjdecompband **bandsOut)
+{
+  j_decompress_ptr dinfo = &this->dinfo;
+  tjdecompband *bands = NULL;
+  size_t sosEnd, sofPos, pos, *intervalStart = NULL, *intervalEnd = NULL,
+    dataSize = 0;
+  JOCTET *data = NULL;
+  jpeg_huff_row_state *rowStates = NULL;
+  JDIMENSION *cuts = NULL, mcusPerRow, mcuRowsPerIMCU, totalMCUs, totalRows,
+    iMCUHeight, outIMCUHeight, restartInterval = dinfo->restart_interval;
+  int numThreads = this->numThreads, numBands = 0, numIntervals = 0,
+    maxIntervals, b;
+  boolean lossless = dinfo->master->lossless;
+  int dataUnit = lossless ? 1 : DCTSIZE;
+
+  *bandsOut = NULL;
+  if (numThreads == 0) numThreads = jthread_num_cpus();
+  /* Lossless JPEG images can only be split on restart boundaries.  Since
+     jpeg_skip_scanlines() does not support lossless JPEG images, their bands
+     cannot include context rows, so vertically subsampled lossless JPEG
+     images are also excluded. */
+  if (numThreads <= 1 ||
+      (lossless && (restartInterval == 0 || jpeg_has_multiple_scans(dinfo) ||
+                    dinfo->max_v_samp_factor != 1)) ||
+      (restartInterval == 0 && dinfo->arith_code &&
+       !jpeg_has_multiple_scans(dinfo)) ||
+      this->croppingRegion.x != 0 || this->croppingRegion.y != 0 ||
+      this->croppingRegion.w != 0 || this->croppingRegion.h != 0 ||
+      dinfo->src->next_input_byte < jpegBuf ||
+      dinfo->src->next_input_byte > jpegBuf + jpegSize)
+    return 0;
+
+  jpeg_calc_output_dimensions(dinfo);
+
+  sosEnd = dinfo->src->next_input_byte - jpegBuf;
+  totalRows = dinfo->total_iMCU_rows;
+  iMCUHeight = dinfo->max_v_samp_factor * dataUnit;
+  outIMCUHeight = dinfo->max_v_samp_factor * dinfo->_min_DCT_v_scaled_size;
+  if (dinfo->comps_in_scan == 1) {
+    mcusPerRow = dinfo->comp_info[0].width_in_blocks;
+    mcuRowsPerIMCU = dinfo->comp_info[0].v_samp_factor;
+    totalMCUs = mcusPerRow * dinfo->comp_info[0].height_in_blocks;
+  } else {
+    mcusPerRow = (dinfo->image_width + dinfo->max_h_samp_factor * dataUnit -
+                  1) / (dinfo->max_h_samp_factor * dataUnit);
+    mcuRowsPerIMCU = 1;
+    totalMCUs = mcusPerRow * totalRows;
+  }
+  maxIntervals = restartInterval ?
+    (int)((totalMCUs + restartInterval - 1) / restartInterval) : 0;
+  if (numThreads > (int)totalRows) numThreads = (int)totalRows;
+  if (numThreads <= 1) return 0;
+
+  if (jpeg_has_multiple_scans(dinfo)) {
+    /* Each band consists of the headers (which end with the first scan's SOS
+       marker) followed by an EOI marker, and it is decompressed from the
+       parent's coefficient buffer after the parent has absorbed all scans. */
+    if ((bands = (tjdecompband *)calloc(numThreads,
+                                        sizeof(tjdecompband))) == NULL)
+      return 0;
+    for (b = 0; b < numThreads; b++) {
+      JDIMENSION startRow = (JDIMENSION)((unsigned long long)totalRows * b /
+                                         numThreads);
+      JDIMENSION endRow = (JDIMENSION)((unsigned long long)totalRows *
+                                       (b + 1) / numThreads);
+
+      bands[b].jpegSize = sosEnd + 2;
+      if ((bands[b].jpegBuf = (unsigned char *)malloc(bands[b].jpegSize)) ==
+          NULL) {
+        freeDecompBands(bands, numThreads);
+        return 0;
+      }
+      memcpy(bands[b].jpegBuf, jpegBuf, sosEnd);
+      bands[b].jpegBuf[sosEnd] = 0xFF;
+      bands[b].jpegBuf[sosEnd + 1] = JPEG_EOI;
+      bands[b].parent = this;
+      bands[b].shareCoefs = TRUE;
+      bands[b].firstLine = bands[b].skipLines = startRow * outIMCUHeight;
+      bands[b].numLines = (endRow < totalRows ? endRow * outIMCUHeight :
+                           dinfo->output_height) - bands[b].firstLine;
+    }
+    *bandsOut = bands;
+    return numThreads;
+  }
+
+  /* Locate the SOF marker, so that the image height can be modified. */
+  if ((sofPos = findSOF(jpegBuf, sosEnd)) == 0) return 0;
+
+  if (restartInterval) {
+    /* Locate the restart markers.  If the entropy-coded data is truncated or
+       the restart markers are out of sequence, then we fall back to
+       single-threaded decompression, which handles such errors
+       gracefully. */
+    if ((intervalStart = (size_t *)malloc(sizeof(size_t) * maxIntervals)) ==
+        NULL ||
+        (intervalEnd = (size_t *)malloc(sizeof(size_t) * maxIntervals)) ==
+        NULL)
+      goto bailout;
+    pos = sosEnd;
+    intervalStart[0] = pos;
+    for (;;) {
+      const unsigned char *ptr = pos < jpegSize ?
+        (const unsigned char *)memchr(&jpegBuf[pos], 0xFF, jpegSize - pos) :
+        NULL;
+      size_t markerPos;
+
+      if (!ptr) goto bailout;
+      markerPos = ptr - jpegBuf;
+      pos = markerPos + 1;
+      while (pos < jpegSize && jpegBuf[pos] == 0xFF) pos++;
+      if (pos >= jpegSize) goto bailout;
+      if (jpegBuf[pos] == 0) {
+        pos++;
+        continue;
+      }
+      intervalEnd[numIntervals++] = markerPos;
+      if (jpegBuf[pos] < JPEG_RST0 || jpegBuf[pos] > JPEG_RST0 + 7) break;
+      if (numIntervals >= maxIntervals ||
+          jpegBuf[pos] != JPEG_RST0 + ((numIntervals - 1) & 7))
+        goto bailout;
+      intervalStart[numIntervals] = ++pos;
+    }
+    if (numIntervals != maxIntervals) goto bailout;
+  } else {
+    /* Find the Huffman decoder state at the start of each iMCU row.  If the
+       entropy-coded data is truncated or corrupt, then we fall back to
+       single-threaded decompression. */
+    if ((data = unstuffEntropyData(dinfo, jpegBuf, jpegSize, sosEnd,
+                                   &dataSize, NULL)) == NULL ||
+        (rowStates = jpeg_huff_find_row_states(dinfo, data, dataSize,
+                                               numThreads)) == NULL)
+      goto bailout;
+  }
+
+  /* Split the image into bands of approximately equal height, each of which
+     begins on a restart boundary (if applicable.) */
+  if ((cuts = (JDIMENSION *)malloc(sizeof(JDIMENSION) * (numThreads + 1))) ==
+      NULL)
+    goto bailout;
+  cuts[0] = 0;
+  for (b = 1; b < numThreads; b++) {
+    JDIMENSION row = (JDIMENSION)((unsigned long long)totalRows * b /
+                                  numThreads);
+
+    if (row <= cuts[numBands]) row = cuts[numBands] + 1;
+    while (row < totalRows && !IS_CUT_ROW(row)) row++;
+    if (row >= totalRows) break;
+    cuts[++numBands] = row;
+  }
+  cuts[++numBands] = totalRows;
+  if (numBands < 2) {
+    numBands = 0;
+    goto bailout;
+  }
+
+  if ((bands = (tjdecompband *)calloc(numBands, sizeof(tjdecompband))) ==
+      NULL) {
+    numBands = 0;
+    goto bailout;
+  }
+  for (b = 0; b < numBands; b++) {
+    JDIMENSION startRow = cuts[b], endRow = cuts[b + 1];
+    JDIMENSION firstRow = startRow, lastRow = endRow, height;
+    int firstInterval = 0, lastInterval = 0, i;
+    size_t startByte = 0, endByte = 0, j;
+    unsigned char *ptr;
+
+    if (firstRow > 0 && !lossless) {
+      firstRow--;
+      while (firstRow > 0 && !IS_CUT_ROW(firstRow)) firstRow--;
+    }
+    if (lastRow < totalRows && !lossless) {
+      lastRow++;
+      while (lastRow < totalRows && !IS_CUT_ROW(lastRow)) lastRow++;
+    }
+    height = lastRow < totalRows ? (lastRow - firstRow) * iMCUHeight :
+             dinfo->image_height - firstRow * iMCUHeight;
+
+    bands[b].jpegSize = sosEnd + 2;
+    if (restartInterval) {
+      firstInterval = (int)(MCU_INDEX(firstRow) / restartInterval);
+      lastInterval = lastRow < totalRows ?
+                     (int)(MCU_INDEX(lastRow) / restartInterval) :
+                     numIntervals;
+      for (i = firstInterval; i < lastInterval; i++)
+        bands[b].jpegSize += intervalEnd[i] - intervalStart[i] +
+                             (i > firstInterval ? 2 : 0);
+    } else {
+      /* The first byte of the band's entropy-coded data, which may be
+         partially consumed by the preceding iMCU row, is passed to the
+         Huffman decoder as its initial state. */
+      startByte = rowStates[firstRow].bit_offset >> 3;
+      endByte = lastRow < totalRows ?
+                (rowStates[lastRow].bit_offset + 7) >> 3 : dataSize;
+      for (j = startByte + 1; j < endByte; j++)
+        bands[b].jpegSize += data[j] == 0xFF ? 2 : 1;
+    }
+    if ((bands[b].jpegBuf = (unsigned char *)malloc(bands[b].jpegSize)) ==
+        NULL) {
+      freeDecompBands(bands, numBands);
+      bands = NULL;
+      numBands = 0;
+      goto bailout;
+    }
+    ptr = bands[b].jpegBuf;
+    memcpy(ptr, jpegBuf, sosEnd);
+    ptr[sofPos + 3] = (unsigned char)(height >> 8);
+    ptr[sofPos + 4] = (unsigned char)(height & 0xFF);
+    ptr += sosEnd;
+    if (restartInterval) {
+      for (i = firstInterval; i < lastInterval; i++) {
+        if (i > firstInterval) {
+          *ptr++ = 0xFF;
+          *ptr++ = (unsigned char)(JPEG_RST0 + ((i - firstInterval - 1) & 7));
+        }
+        memcpy(ptr, &jpegBuf[intervalStart[i]],
+               intervalEnd[i] - intervalStart[i]);
+        ptr += intervalEnd[i] - intervalStart[i];
+      }
+    } else {
+      for (j = startByte + 1; j < endByte; j++) {
+        *ptr++ = data[j];
+        if (data[j] == 0xFF) *ptr++ = 0;
+      }
+      bands[b].resumeHuff = TRUE;
+      bands[b].bitsLeft = 8 - (int)(rowStates[firstRow].bit_offset & 7);
+      bands[b].getBuffer = data[startByte] & ((1U << bands[b].bitsLeft) - 1);
+      memcpy(bands[b].lastDCVal, rowStates[firstRow].last_dc_val,
+             sizeof(bands[b].lastDCVal));
+    }
+    *ptr++ = 0xFF;
+    *ptr++ = JPEG_EOI;
+
+    bands[b].parent = this;
+    bands[b].firstLine = startRow * outIMCUHeight;
+    bands[b].skipLines = (startRow - firstRow) * outIMCUHeight;
+    bands[b].numLines = (endRow < totalRows ? endRow * outIMCUHeight :
+                         dinfo->output_height) - bands[b].firstLine;
+  }
+
+bailout:
+  free(intervalStart);
+  free(intervalEnd);
+  free(cuts);
+  *bandsOut = bands;
+  return bands ? numBands : 0;
+}
+
+/* Prepare the parent's whole-image coefficient buffer for sharing with bands
+   that were set up by setupDecompBands().  Returns FALSE if the image should
+   be decompressed using a single thread after all.  Rows of the buffer that
+   were never written (because a component was missing from all scans) are
+   zeroed by the memory manager when they are first accessed, so we access
+   every row here in order to prevent the bands from doing that
+   concurrently. */
+static boolean shareCoefBuffer(tjinstance *this)
+{
+  j_decompress_ptr dinfo = &this->dinfo;
+  jvirt_barray_ptr *coefArrays = dinfo->coef->coef_arrays;
+  jpeg_component_info *compptr;
+  JDIMENSION row, numRows;
+  int ci;
+
+  /* If absorbing the scans generated warnings, then the image is damaged, so
+     leave it to the single-threaded code path to handle it gracefully. */
+  if (this->jerr.warning || coefArrays == NULL ||
+      !dinfo->inputctl->eoi_reached)
+    return FALSE;
+
+  for (ci = 0, compptr = dinfo->comp_info; ci < dinfo->num_components;
+       ci++, compptr++) {
+    numRows = (compptr->height_in_blocks + compptr->v_samp_factor - 1) /
+              compptr->v_samp_factor * compptr->v_samp_factor;
+    for (row = 0; row < numRows; row += compptr->v_samp_factor)
+      (*dinfo->mem->access_virt_barray) ((j_common_ptr)dinfo, coefArrays[ci],
+                                         row, compptr->v_samp_factor, TRUE);
+  }
+  return TRUE;
+}
+
+/* Random-access decompression
+
+   Decompressing a cropping region normally requires Huffman-decoding every
+   MCU from the start of the scan to the bottom of the region, so the cost of
+   decompressing a region is proportional to its position within the image.
+   An index (see tj3BuildIndex()) records the Huffman decoder state at the
+   start of each iMCU row of a single-scan sequential Huffman-coded JPEG image
+   with no restart markers, which allows tj3Decompress*() to decode only the
+   iMCU rows that are needed.  Those rows (plus one iMCU row above and below
+   them, so that context-dependent upsampling of the region's edge rows
+   produces the same output as decompressing the whole image) are decompressed
+   from a self-contained JPEG image that is constructed in the same manner as
+   the bands used for multithreaded decompression.
+
+   A serialized index consists of a 40-byte header:
+
+     bytes 0-3    "TJIX"
+     bytes 4-11   size of the JPEG image
+     bytes 12-19  offset of the entropy-coded data
+     bytes 20-27  offset of the marker that terminates the entropy-coded data
+     bytes 28-31  FNV-1a hash of the JPEG headers (the bytes preceding the
+                  entropy-coded data)
+     bytes 32-35  number of iMCU rows
+     bytes 36-39  number of components in the scan
+
+   followed by one entry per iMCU row:
+
+     bytes 0-7    offset of the byte containing the first bit of the iMCU row
+     byte 8       number of bits in that byte that belong to the previous row
+     bytes 9-     DC predictor of each component (4 bytes per component) at
+                  the start of the iMCU row
+
+   All values are unsigned little-endian integers, and all offsets are relative
+   to the start of the JPEG image (including byte stuffing.) */
+
+#define INDEX_HEADER_SIZE  40
+#define INDEX_ENTRY_SIZE(comps)  (9 + 4 * (size_t)(comps))
+
+static void putLE(unsigned char *ptr, unsigned long long value, int bytes)
+{
+  while (bytes-- > 0) {
+    *ptr++ = (unsigned char)(value & 0xFF);
+    value >>= 8;
+  }
+}
+
+static unsigned long long getLE(const unsigned char *ptr, int bytes)
+{
+  unsigned long long value = 0;
+
+  while (bytes-- > 0)
+    value = (value << 8) | ptr[bytes];
+  return value;
+}
+
+static unsigned int hashHeaders(const unsigned char *jpegBuf, size_t sosEnd)
+{
+  unsigned int hash = 2166136261U;
+  size_t i;
+
+  for (i = 0; i < sosEnd; i++)
+    hash = ((hash ^ jpegBuf[i]) * 16777619U) & 0xFFFFFFFFU;
+  return hash;
+}
+
+/* Returns the offset of the entropy-coded data byte that follows the one at
+   offset pos, skipping the stuffed zero byte (and any fill bytes) after a
+   0xFF data byte */
+static size_t nextDataByte(const unsigned char *jpegBuf, size_t pos,
+                           size_t dataEnd)
+{
+  if (jpegBuf[pos++] != 0xFF) return pos;
+  while (pos < dataEnd && jpegBuf[pos] == 0xFF) pos++;
+  return pos < dataEnd ? pos + 1 : dataEnd;
+}
+
+/* If an index that matches the JPEG image has been set (see tj3SetIndex()),
+   and the cropping region does not require all iMCU rows, then replace the
+   JPEG image with a self-contained JPEG image containing only the iMCU rows
+   that are needed, and read its header.  *bandBuf receives the new JPEG image,
+   which the caller must free after decompression, and *cropY receives the
+   upper boundary of the cropping region relative to the new image.  The JPEG
+   header must have been read from jpegBuf. */
+static void useIndex(tjinstance *this, const unsigned char *jpegBuf,
+                     size_t jpegSize, unsigned char **bandBuf, int *cropY)
+{
+  j_decompress_ptr dinfo = &this->dinfo;
+  const unsigned char *index = this->index, *entry;
+  size_t sosEnd, sofPos, dataEnd, entrySize, start, end, bandSize;
+  JDIMENSION totalRows = dinfo->total_iMCU_rows, outIMCUHeight, iMCUHeight,
+    firstRow, lastRow, height;
+  unsigned char *ptr;
+  int bitsLeft, ci;
+
+  *bandBuf = NULL;
+  *cropY = this->croppingRegion.y;
+  if (!index || (this->croppingRegion.y == 0 && this->croppingRegion.h == 0) ||
+      dinfo->src->next_input_byte < jpegBuf ||
+      dinfo->src->next_input_byte > jpegBuf + jpegSize)
+    return;
+
+  sosEnd = dinfo->src->next_input_byte - jpegBuf;
+  dataEnd = (size_t)getLE(index + 20, 8);
+  if (getLE(index + 4, 8) != jpegSize || getLE(index + 12, 8) != sosEnd ||
+      getLE(index + 28, 4) != hashHeaders(jpegBuf, sosEnd) ||
+      getLE(index + 32, 4) != totalRows ||
+      getLE(index + 36, 4) != (unsigned long long)dinfo->comps_in_scan ||
+      jpeg_has_multiple_scans(dinfo) || dinfo->arith_code ||
+      dinfo->master->lossless || dinfo->restart_interval ||
+      (sofPos = findSOF(jpegBuf, sosEnd)) == 0)
+    return;
+
+  dinfo->scale_num = this->scalingFactor.num;
+  dinfo->scale_denom = this->scalingFactor.denom;
+  jpeg_calc_output_dimensions(dinfo);
+  iMCUHeight = dinfo->max_v_samp_factor * DCTSIZE;
+  outIMCUHeight = dinfo->max_v_samp_factor * dinfo->_min_DCT_v_scaled_size;
+  firstRow = (JDIMENSION)this->croppingRegion.y / outIMCUHeight;
+  if (firstRow > 0) firstRow--;
+  lastRow = ((JDIMENSION)(this->croppingRegion.y + this->croppingRegion.h) +
+             outIMCUHeight - 1) / outIMCUHeight + 1;
+  if (lastRow > totalRows) lastRow = totalRows;
+  if (firstRow == 0 && lastRow == totalRows) return;
+
+  /* The first byte of the first iMCU row, which may be partially consumed by
+     the preceding iMCU row, is passed to the Huffman decoder as its initial
+     state. */
+  entrySize = INDEX_ENTRY_SIZE(dinfo->comps_in_scan);
+  entry = index + INDEX_HEADER_SIZE + entrySize * firstRow;
+  start = nextDataByte(jpegBuf, (size_t)getLE(entry, 8), dataEnd);
+  end = lastRow < totalRows ?
+        nextDataByte(jpegBuf,
+                     (size_t)getLE(index + INDEX_HEADER_SIZE +
+                                   entrySize * lastRow, 8), dataEnd) :
+        dataEnd;
+  height = lastRow < totalRows ? (lastRow - firstRow) * iMCUHeight :
+           dinfo->image_height - firstRow * iMCUHeight;
+
+  bandSize = sosEnd + (end - start) + 2;
+  if ((*bandBuf = (unsigned char *)malloc(bandSize)) == NULL) return;
+  ptr = *bandBuf;
+  memcpy(ptr, jpegBuf, sosEnd);
+  ptr[sofPos + 3] = (unsigned char)(height >> 8);
+  ptr[sofPos + 4] = (unsigned char)(height & 0xFF);
+  ptr += sosEnd;
+  memcpy(ptr, &jpegBuf[start], end - start);
+  ptr += end - start;
+  *ptr++ = 0xFF;
+  *ptr++ = JPEG_EOI;
+
+  jpeg_abort_decompress(dinfo);
+  jpeg_mem_src_tj(dinfo, *bandBuf, bandSize);
+  jpeg_read_header(dinfo, TRUE);
+  bitsLeft = 8 - entry[8];
+  dinfo->master->resume_huff = TRUE;
+  dinfo->master->resume_get_buffer =
+    jpegBuf[getLE(entry, 8)] & ((1U << bitsLeft) - 1);
+  dinfo->master->resume_bits_left = bitsLeft;
+  for (ci = 0; ci < dinfo->comps_in_scan; ci++)
+    dinfo->master->resume_dc_val[ci] =
+      (int)(unsigned int)getLE(entry + 9 + 4 * ci, 4);
+
+  *cropY -= (int)(firstRow * outIMCUHeight);
+}
+
+
+/* Multithreaded compression
+
+   If the JPEG image will have restart markers, then the entropy encoder's
+   state is reset at each restart boundary, so the image can be compressed in
+   parallel by splitting it into horizontal bands of iMCU rows, each of which
+   begins on a restart boundary.  Each band is compressed using a separate
+   libjpeg instance into a separate JPEG image with the same parameters (other
+   than the image height), and the bands' entropy-coded data segments are then
+   joined, using the headers from the first band (with the image height
+   modified) and inserting a restart marker between each pair of bands.  The
+   restart markers within each band are renumbered so that they are in
+   sequence with those of the preceding bands.  Since color conversion and
+   downsampling do not cross iMCU row boundaries, the output is identical to
+   that of single-threaded compression.
+
+   This requires the Huffman tables to be known in advance, so Huffman table
+   optimization (which is always used for progressive and 12-bit Huffman-coded
+   JPEG images) precludes multithreaded compression.  Lossless JPEG images are
+   the exception.  Their Huffman tables are always optimized, but the
+   statistics-gathering pass and the output pass are separate, and neither
+   depends on other bands.  Thus, each band performs its statistics-gathering
+   pass in parallel, the statistics for all bands are merged (see the
+   lhuff_counts field in struct jpeg_comp_master), and each band then performs
+   its output pass in parallel, generating the same Huffman tables that
+   single-threaded compression would. */
+
+typedef struct {
+  tjinstance *parent;
+  const void *rowPointers;          /* source rows for this band */
+  int pixelFormat;
+  JDIMENSION firstLine, numLines;   /* first source row, number of rows */
+  int firstInterval;                /* index of the first restart interval */
+  unsigned char *jpegBuf;           /* self-contained JPEG image */
+  size_t jpegSize;
+  size_t sofPos;                    /* position of the SOF marker's length */
+  size_t dataStart;                 /* start of the entropy-coded data */
+  long (*huffCounts)[257];          /* lossless Huffman statistics (or NULL) */
+  tjhandle handle;                  /* libjpeg instance between passes */
+  int retval;
+  boolean warning;
+  char errStr[JMSG_LENGTH_MAX];
+} tjcompband;
+
+/* Destroy a band's TurboJPEG instance, which may have been left active after
+   the statistics-gathering pass */
+static void destroyCompBand(tjcompband *band)
+{
+  tjinstance *inst = (tjinstance *)band->handle;
+
+  if (!inst) return;
+  if (inst->cinfo.global_state > CSTATE_START) {
+    (*inst->cinfo.dest->term_destination) (&inst->cinfo);
+    jpeg_abort_compress(&inst->cinfo);
+  }
+  tj3Destroy(band->handle);
+  band->handle = NULL;
+}
+
+static void freeCompBands(tjcompband *bands, int numBands)
+{
+  int i;
+
+  if (!bands) return;
+  for (i = 0; i < numBands; i++) {
+    destroyCompBand(&bands[i]);
+    free(bands[i].jpegBuf);
+    free(bands[i].huffCounts);
+  }
+  free(bands);
+}
+
+/* Merge the Huffman statistics that were gathered for the bands of a lossless
+   JPEG image, so that the output pass for each band generates the same
+   Huffman tables */
+static void mergeCompBandStats(tjcompband *bands, int numBands)
+{
+  int b, tbl, i;
+
+  for (tbl = 0; tbl < NUM_HUFF_TBLS; tbl++) {
+    for (i = 0; i < 257; i++) {
+      long count = 0;
+
+      for (b = 0; b < numBands; b++)
+        count += bands[b].huffCounts[tbl][i];
+      for (b = 0; b < numBands; b++)
+        bands[b].huffCounts[tbl][i] = count;
+    }
+  }
+}
+
+/* Returns the number of bands, or 0 if the image cannot be (or should not be)
+   compressed using multiple threads.  The compression parameters must have
+   been set. */
+static int setupCompBands(tjinstance *this, tjcompband **bandsOut)
+{
+  j_compress_ptr cinfo = &this->cinfo;
+  tjcompband *bands = NULL;
+  JDIMENSION *cuts = NULL, mcusPerRow, mcuRowsPerIMCU, totalRows, iMCUHeight,
+    restartInterval = cinfo->restart_interval;
+  int numThreads = this->numThreads, numBands = 0, maxH = 1, maxV = 1, b, ci;
+  int dataUnit = this->lossless ? 1 : DCTSIZE;
+  boolean mergeStats = this->lossless && !cinfo->arith_code;
+
+  *bandsOut = NULL;
+  if (numThreads == 0) numThreads = jthread_num_cpus();
+  if (numThreads <= 1 || cinfo->num_scans > 0 ||
+      (!this->lossless && !cinfo->arith_code &&
+       (cinfo->optimize_coding || cinfo->data_precision != 8)) ||
+      (cinfo->restart_interval == 0 && cinfo->restart_in_rows <= 0) ||
+      cinfo->num_components < 1 || cinfo->num_components > MAX_COMPS_IN_SCAN)
+    return 0;
+
+  /* Subsampling is disabled in lossless mode (see jinit_c_master_control().) */
+  if (!this->lossless) {
+    for (ci = 0; ci < cinfo->num_components; ci++) {
+      maxH = MAX(maxH, cinfo->comp_info[ci].h_samp_factor);
+      maxV = MAX(maxV, cinfo->comp_info[ci].v_samp_factor);
+    }
+  }
+  iMCUHeight = maxV * dataUnit;
+  totalRows = (cinfo->image_height + iMCUHeight - 1) / iMCUHeight;
+  if (cinfo->num_components == 1) {
+    mcusPerRow = (cinfo->image_width + dataUnit - 1) / dataUnit;
+    mcuRowsPerIMCU = maxV;
+  } else {
+    mcusPerRow = (cinfo->image_width + maxH * dataUnit - 1) /
+                 (maxH * dataUnit);
+    mcuRowsPerIMCU = 1;
+  }
+  if (cinfo->restart_in_rows > 0)
+    restartInterval = (JDIMENSION)MIN((long)cinfo->restart_in_rows *
+                                      (long)mcusPerRow, 65535L);
+  if (numThreads > (int)totalRows) numThreads = (int)totalRows;
+  if (numThreads <= 1) return 0;
+
+  /* Split the image into bands of approximately equal height, each of which
+     begins on a restart boundary. */
+  if ((cuts = (JDIMENSION *)malloc(sizeof(JDIMENSION) * (numThreads + 1))) ==
+      NULL)
+    return 0;
+  cuts[0] = 0;
+  for (b = 1; b < numThreads; b++) {
+    JDIMENSION row = (JDIMENSION)((unsigned long long)totalRows * b /
+                                  numThreads);
+
+    if (row <= cuts[numBands]) row = cuts[numBands] + 1;
+    while (row < totalRows && !IS_CUT_ROW(row)) row++;
+    if (row >= totalRows) break;
+    cuts[++numBands] = row;
+  }
+  cuts[++numBands] = totalRows;
+  if (numBands < 2 ||
+      (bands = (tjcompband *)calloc(numBands, sizeof(tjcompband))) == NULL) {
+    free(cuts);
+    return 0;
+  }
+  for (b = 0; b < numBands; b++) {
+    bands[b].parent = this;
+    bands[b].firstLine = cuts[b] * iMCUHeight;
+    bands[b].numLines = (b < numBands - 1 ? cuts[b + 1] * iMCUHeight :
+                         cinfo->image_height) - bands[b].firstLine;
+    bands[b].firstInterval = (int)(MCU_INDEX(cuts[b]) / restartInterval);
+    if (mergeStats &&
+        (bands[b].huffCounts =
+         (long (*)[257])calloc(NUM_HUFF_TBLS, sizeof(long[257]))) == NULL) {
+      freeCompBands(bands, numBands);
+      free(cuts);
+      return 0;
+    }
+  }
+  free(cuts);
+  *bandsOut = bands;
+  return numBands;
+}
+
+/* Copy the compression parameters from one TurboJPEG instance to another */
+static void copyCompParams(tjinstance *dst, tjinstance *src)
+{
+  dst->quality = src->quality;
+  dst->subsamp = src->subsamp;
+  dst->precision = src->precision;
+  dst->colorspace = src->colorspace;
+  dst->fastDCT = src->fastDCT;
+  dst->optimize = src->optimize;
+  dst->progressive = src->progressive;
+  dst->arithmetic = src->arithmetic;
+  dst->lossless = src->lossless;
+  dst->losslessPSV = src->losslessPSV;
+  dst->losslessPt = src->losslessPt;
+  dst->restartIntervalBlocks = src->restartIntervalBlocks;
+  dst->restartIntervalRows = src->restartIntervalRows;
+  dst->xDensity = src->xDensity;
+  dst->yDensity = src->yDensity;
+  dst->densityUnits = src->densityUnits;
+  dst->maxMemory = src->maxMemory;
+  dst->jerr.stopOnWarning = src->jerr.stopOnWarning;
+}
+
+/* Locate the SOF marker and the entropy-coded data in a band's JPEG image, and
+   renumber the band's restart markers so that they follow those of the
+   preceding bands.  Returns FALSE if the JPEG image is not as expected. */
+static boolean finishCompBand(tjcompband *band)
+{
+  unsigned char *buf = band->jpegBuf;
+  size_t size = band->jpegSize, pos = 2;
+
+  if (size < 4 || buf[0] != 0xFF || buf[1] != 0xD8 ||
+      buf[size - 2] != 0xFF || buf[size - 1] != JPEG_EOI)
+    return FALSE;
+
+  while (band->dataStart == 0) {
+    int marker;
+
+    if (pos + 4 > size || buf[pos] != 0xFF) return FALSE;
+    marker = buf[pos + 1];
+    pos += 2;
+    if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 &&
+        marker != 0xC8 && marker != 0xCC)
+      band->sofPos = pos;
+    pos += (buf[pos] << 8) | buf[pos + 1];
+    if (marker == 0xDA) band->dataStart = pos;
+  }
+  if (band->sofPos == 0 || band->sofPos + 5 > band->dataStart ||
+      band->dataStart > size - 2)
+    return FALSE;
+
+  if (band->firstInterval & 7) {
+    for (pos = band->dataStart; pos < size - 3; pos++) {
+      if (buf[pos] == 0xFF && buf[pos + 1] >= JPEG_RST0 &&
+          buf[pos + 1] <= JPEG_RST0 + 7) {
+        pos++;
+        buf[pos] = (unsigned char)(JPEG_RST0 + ((buf[pos] - JPEG_RST0 +
+                                                 band->firstInterval) & 7));
+      }
+    }
+  }
+  return TRUE;
+}
+
+/* Write a block of data to the destination manager of a compressor that has
+   not been started */
+static void writeBytes(j_compress_ptr cinfo, const unsigned char *buf,
+                       size_t size)
+{
+  struct jpeg_destination_mgr *dest = cinfo->dest;
+
+  while (size > 0) {
+    size_t bytes;
+
+    if (dest->free_in_buffer == 0 &&
+        !(*dest->empty_output_buffer) (cinfo))
+      ERREXIT(cinfo, JERR_CANT_SUSPEND);
+    bytes = MIN(size, dest->free_in_buffer);
+    memcpy(dest->next_output_byte, buf, bytes);
+    dest->next_output_byte += bytes;
+    dest->free_in_buffer -= bytes;
+    buf += bytes;
+    size -= bytes;
+  }
+}
+
+/* Join the JPEG images produced by the bands into a single JPEG image */
+static void writeCompBands(tjinstance *this, tjcompband *bands, int numBands)
+{
+  j_compress_ptr cinfo = &this->cinfo;
+  static const unsigned char eoi[2] = { 0xFF, JPEG_EOI };
+  unsigned char *header = bands[0].jpegBuf;
+  int b;
+
+  header[bands[0].sofPos + 3] = (unsigned char)(cinfo->image_height >> 8);
+  header[bands[0].sofPos + 4] = (unsigned char)(cinfo->image_height & 0xFF);
+
+  (*cinfo->dest->init_destination) (cinfo);
+  writeBytes(cinfo, header, bands[0].dataStart);
+  for (b = 0; b < numBands; b++) {
+    if (b > 0) {
+      unsigned char rst[2];
+
+      rst[0] = 0xFF;
+      rst[1] = (unsigned char)(JPEG_RST0 + ((bands[b].firstInterval - 1) & 7));
+      writeBytes(cinfo, rst, 2);
+    }
+    writeBytes(cinfo, &bands[b].jpegBuf[bands[b].dataStart],
+               bands[b].jpegSize - 2 - bands[b].dataStart);
+  }
+  writeBytes(cinfo, eoi, 2);
+  (*cinfo->dest->term_destination) (cinfo);
+}
+
+
 static void processFlags(tjhandle handle, int flags, int operation)
 {
   tjinstance *this = (tjinstance *)handle;
@@ -606,6 +1481,7 @@ DLLEXPORT tjhandle tj3InitVersion(int initType, int apiVersion)
   this->yDensity = 1;
   this->scalingFactor = TJUNSCALED;
   this->saveMarkers = 2;
+  this->numThreads = 1;
 
   this->apiVersion = apiVersion;
   this->numSamp = apiVersion >= 3002000 ? TJ_NUMSAMP : 7;
@@ -654,6 +1530,7 @@ destroy_decompress:
 bailout:
   free(this->iccBuf);
   free(this->decompICCBuf);
+  free(this->index);
   free(this);
 }
 
@@ -852,6 +1729,14 @@ DLLEXPORT int tj3Set(tjhandle handle, int param, int value)
   case TJPARAM_SAVEMARKERS:
     SET_PARAM(saveMarkers, 0, 4);
     break;
+  case TJPARAM_NUMTHREADS:
+    SET_PARAM(numThreads, 0, -1);
+    break;
+  case TJPARAM_PIPELINE:
+    if (!(this->init & DECOMPRESS))
+      THROW("TJPARAM_PIPELINE is not applicable to compression instances.");
+    SET_BOOL_PARAM(pipeline);
+    break;
   default:
     THROW("Invalid parameter");
   }
@@ -920,6 +1805,10 @@ DLLEXPORT int tj3Get(tjhandle handle, int param)
     return this->maxPixels;
   case TJPARAM_SAVEMARKERS:
     return this->saveMarkers;
+  case TJPARAM_NUMTHREADS:
+    return this->numThreads;
+  case TJPARAM_PIPELINE:
+    return this->pipeline;
   }
 
   return -1;
@@ -1251,6 +2140,83 @@ bailout:
 }
 
 
+/* Map a JPEG file into memory, read-only, so that it can be passed to
+   tj3Decompress*() without copying it.  If the file cannot be mapped, then it
+   is read into a newly-allocated buffer instead.  Returns 0 if successful or
+   -1 (with errno set) if an error occurred.  An empty file is returned as a
+   NULL buffer with a size of 0. */
+
+static int mapFile(const char *filename, unsigned char **buf, size_t *size,
+                   boolean *mapped)
+{
+  FILE *file = NULL;
+  long len;
+  int retval = -1, err;
+#ifdef HAVE_MMAP
+  struct stat st;
+  void *addr;
+#endif
+
+  *buf = NULL;  *size = 0;  *mapped = FALSE;
+
+#ifdef _MSC_VER
+  if (fopen_s(&file, filename, "rb") || file == NULL)
+#else
+  if ((file = fopen(filename, "rb")) == NULL)
+#endif
+    return -1;
+
+#ifdef HAVE_MMAP
+  if (fstat(fileno(file), &st) == 0 && S_ISREG(st.st_mode) &&
+      st.st_size > 0 && (off_t)(size_t)st.st_size == st.st_size &&
+      (addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE,
+                   fileno(file), 0)) != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+    madvise(addr, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+    *buf = (unsigned char *)addr;
+    *size = (size_t)st.st_size;
+    *mapped = TRUE;
+    retval = 0;  goto bailout;
+  }
+#endif
+
+  if (fseek(file, 0, SEEK_END) < 0 || (len = ftell(file)) < 0 ||
+      fseek(file, 0, SEEK_SET) < 0)
+    goto bailout;
+  if (len > 0) {
+    if ((*buf = (unsigned char *)malloc(len)) == NULL) {
+      errno = ENOMEM;
+      goto bailout;
+    }
+    if (fread(*buf, len, 1, file) < 1) {
+      if (!ferror(file)) errno = EIO;
+      free(*buf);  *buf = NULL;
+      goto bailout;
+    }
+    *size = (size_t)len;
+  }
+  retval = 0;
+
+bailout:
+  err = errno;
+  fclose(file);
+  errno = err;
+  return retval;
+}
+
+static void unmapFile(unsigned char *buf, size_t size, boolean mapped)
+{
+#ifdef HAVE_MMAP
+  if (mapped) {
+    munmap(buf, size);
+    return;
+  }
+#endif
+  free(buf);
+}
+
+
 /* tj3Compress*() is implemented in turbojpeg-mp.c */
 #define BITS_IN_JSAMPLE  8
 #include "turbojpeg-mp.c"
@@ -1856,6 +2822,11 @@ static tjhandle _tjInitDecompress(tjinstance *this)
   jpeg_create_decompress(&this->dinfo);
   /* Make an initial call so it will create the source manager */
   jpeg_mem_src_tj(&this->dinfo, buffer, 1);
+  /* The source manager never reads anything after the JPEG image, so we can
+     stop reading a progressive JPEG image once the remaining scans cannot
+     affect the output (for instance, when decompressing a grayscale image with
+     a scaling factor of 1/8.) */
+  this->dinfo.master->skip_tail_scans = TRUE;
 
   this->init |= DECOMPRESS;
   return (tjhandle)this;
@@ -2115,6 +3086,151 @@ bailout:
 }
 
 
+/* TurboJPEG 3.2+ */
+DLLEXPORT int tj3BuildIndex(tjhandle handle, const unsigned char *jpegBuf,
+                            size_t jpegSize, unsigned char **indexBuf,
+                            size_t *indexSize)
+{
+  static const char FUNCTION_NAME[] = "tj3BuildIndex";
+  int retval = 0, numThreads, ci;
+  size_t sosEnd, dataSize, dataEnd = 0, entrySize, size, pos, byte = 0;
+  JOCTET *data;
+  jpeg_huff_row_state *rowStates;
+  unsigned char *buf = NULL, *ptr;
+  JDIMENSION row;
+
+  GET_DINSTANCE(handle);
+  if ((this->init & DECOMPRESS) == 0)
+    THROW("Instance has not been initialized for decompression");
+
+  if (jpegBuf == NULL || jpegSize <= 0 || indexBuf == NULL ||
+      indexSize == NULL)
+    THROW("Invalid argument");
+
+  CATCH_LIBJPEG(this);
+
+  jpeg_mem_src_tj(dinfo, jpegBuf, jpegSize);
+  jpeg_read_header(dinfo, TRUE);
+  setDecompParameters(this);
+
+  if (jpeg_has_multiple_scans(dinfo) || dinfo->arith_code ||
+      dinfo->master->lossless)
+    THROW("Only single-scan Huffman-coded JPEG images can be indexed");
+  if (dinfo->restart_interval)
+    THROW("JPEG images with restart markers cannot be indexed");
+
+  numThreads = this->numThreads ? this->numThreads : jthread_num_cpus();
+  sosEnd = dinfo->src->next_input_byte - jpegBuf;
+  if ((data = unstuffEntropyData(dinfo, jpegBuf, jpegSize, sosEnd, &dataSize,
+                                 &dataEnd)) == NULL ||
+      (rowStates = jpeg_huff_find_row_states(dinfo, data, dataSize,
+                                             numThreads)) == NULL)
+    THROW("JPEG image is truncated or corrupt");
+
+  entrySize = INDEX_ENTRY_SIZE(dinfo->comps_in_scan);
+  size = INDEX_HEADER_SIZE + entrySize * dinfo->total_iMCU_rows;
+  if ((buf = (unsigned char *)malloc(size)) == NULL)
+    THROW("Memory allocation failure");
+  ptr = buf;
+  memcpy(ptr, "TJIX", 4);
+  putLE(ptr + 4, jpegSize, 8);
+  putLE(ptr + 12, sosEnd, 8);
+  putLE(ptr + 20, dataEnd, 8);
+  putLE(ptr + 28, hashHeaders(jpegBuf, sosEnd), 4);
+  putLE(ptr + 32, dinfo->total_iMCU_rows, 4);
+  putLE(ptr + 36, dinfo->comps_in_scan, 4);
+  ptr += INDEX_HEADER_SIZE;
+
+  /* Convert the offset of each iMCU row within the unstuffed entropy-coded
+     data into an offset within the JPEG image.  unstuffEntropyData() has
+     already established that each 0xFF data byte is followed by a stuffed zero
+     byte (possibly preceded by fill bytes.) */
+  pos = sosEnd;
+  for (row = 0; row < dinfo->total_iMCU_rows; row++, ptr += entrySize) {
+    size_t target = rowStates[row].bit_offset >> 3;
+
+    while (byte < target) {
+      const unsigned char *ff =
+        (const unsigned char *)memchr(&jpegBuf[pos], 0xFF, dataEnd - pos);
+      size_t run = ff ? (size_t)(ff - &jpegBuf[pos]) : dataEnd - pos;
+
+      if (run > target - byte) run = target - byte;
+      pos += run;
+      byte += run;
+      if (byte < target) {
+        pos = nextDataByte(jpegBuf, pos, dataEnd);
+        byte++;
+      }
+    }
+    putLE(ptr, pos, 8);
+    ptr[8] = (unsigned char)(rowStates[row].bit_offset & 7);
+    for (ci = 0; ci < dinfo->comps_in_scan; ci++)
+      putLE(ptr + 9 + 4 * ci, (unsigned int)rowStates[row].last_dc_val[ci],
+            4);
+  }
+  *indexBuf = buf;
+  *indexSize = size;
+  buf = NULL;
+
+bailout:
+  if (dinfo->global_state > DSTATE_START) jpeg_abort_decompress(dinfo);
+  free(buf);
+  if (this->jerr.warning) retval = -1;
+  return retval;
+}
+
+
+/* TurboJPEG 3.2+ */
+DLLEXPORT int tj3SetIndex(tjhandle handle, const unsigned char *indexBuf,
+                          size_t indexSize)
+{
+  static const char FUNCTION_NAME[] = "tj3SetIndex";
+  int retval = 0, comps;
+  size_t jpegSize, sosEnd, dataEnd, entrySize, pos, lastPos;
+  unsigned long long numRows, row;
+  const unsigned char *entry;
+
+  GET_TJINSTANCE(handle, -1);
+  if ((this->init & DECOMPRESS) == 0)
+    THROW("Instance has not been initialized for decompression");
+
+  free(this->index);
+  this->index = NULL;
+  if (indexBuf == NULL || indexSize == 0)
+    return 0;
+
+  if (indexSize < INDEX_HEADER_SIZE || memcmp(indexBuf, "TJIX", 4))
+    THROW("Invalid index");
+  jpegSize = (size_t)getLE(indexBuf + 4, 8);
+  sosEnd = (size_t)getLE(indexBuf + 12, 8);
+  dataEnd = (size_t)getLE(indexBuf + 20, 8);
+  numRows = getLE(indexBuf + 32, 4);
+  comps = (int)getLE(indexBuf + 36, 4);
+  if (sosEnd > dataEnd || dataEnd > jpegSize || numRows < 1 || comps < 1 ||
+      comps > MAX_COMPS_IN_SCAN)
+    THROW("Invalid index");
+  entrySize = INDEX_ENTRY_SIZE(comps);
+  if ((indexSize - INDEX_HEADER_SIZE) / entrySize != numRows ||
+      (indexSize - INDEX_HEADER_SIZE) % entrySize != 0)
+    THROW("Invalid index");
+  lastPos = sosEnd;
+  for (row = 0, entry = indexBuf + INDEX_HEADER_SIZE; row < numRows;
+       row++, entry += entrySize) {
+    pos = (size_t)getLE(entry, 8);
+    if (pos < lastPos || pos >= dataEnd || entry[8] > 7)
+      THROW("Invalid index");
+    lastPos = pos;
+  }
+
+  if ((this->index = (unsigned char *)malloc(indexSize)) == NULL)
+    THROW("Memory allocation failure");
+  memcpy(this->index, indexBuf, indexSize);
+
+bailout:
+  return retval;
+}
+
+
 /* tj3Decompress*() is implemented in turbojpeg-mp.c */
 
 /* TurboJPEG 1.2+ */
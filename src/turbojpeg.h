@@ -993,7 +993,86 @@ enum TJPARAM {
    *   ICC profile that was previously extracted from a JPEG image to the PNG
    *   image.
    */
-  TJPARAM_SAVEMARKERS
+  TJPARAM_SAVEMARKERS,
+  /**
+   * Number of threads [compression, decompression]
+   *
+   * **Value**
+   * - `1` *[default]* Compress or decompress using only the calling thread.
+   * - `0` Use one thread per logical CPU.
+   * - `N` Use up to `N` threads (including the calling thread.)
+   *
+   * If this parameter is set to a value other than `1`, then
+   * #tj3Decompress8(), #tj3Decompress12(), and #tj3Decompress16() decode JPEG
+   * images by splitting
+   * the image into horizontal bands and decoding the bands in parallel.  If
+   * the JPEG image contains restart markers, then each band begins on a
+   * restart boundary.  Otherwise, the starting point of each band is found by
+   * decoding the entropy-coded data speculatively in parallel, starting from
+   * guessed positions, and validating the results.  (This requires an extra
+   * pass through the entropy-coded data, so the speedup is smaller than with
+   * restart markers.)  If the JPEG image is a multi-scan (such as
+   * progressive) JPEG image, then all scans are decoded using the calling
+   * thread, and the inverse DCT, block smoothing, upsampling, and color
+   * conversion steps are performed for each band in parallel.  Lossless JPEG
+   * images are decoded in parallel only if they contain restart markers and
+   * are not vertically subsampled.  The output is identical to that of
+   * single-threaded decompression.  This parameter currently has no effect
+   * unless the JPEG image is either a lossy JPEG image that is multi-scan or
+   * has a restart interval or uses Huffman coding or a single-scan lossless
+   * JPEG image that has a restart interval, no cropping region has been
+   * specified (see #tj3SetCroppingRegion()), and TurboJPEG was built with
+   * multithreading support.
+   *
+   * If this parameter is set to a value other than `1`, then #tj3Compress8(),
+   * #tj3Compress12(), and #tj3Compress16() compress packed-pixel images by
+   * splitting the image into horizontal bands that begin on restart
+   * boundaries, compressing the bands in parallel, and joining the results.
+   * When generating a lossless JPEG image that uses Huffman entropy coding,
+   * the bands are processed in two passes:  the first pass gathers the
+   * statistics for the optimal Huffman tables in parallel, and the second
+   * pass encodes the bands in parallel using the combined statistics.  The
+   * output is identical to that of single-threaded compression.  This
+   * parameter currently has no effect on compression unless a restart marker
+   * interval has been specified (see #TJPARAM_RESTARTBLOCKS and
+   * #TJPARAM_RESTARTROWS), the JPEG image will be a single-scan lossy JPEG
+   * image for which either arithmetic entropy coding is used or the data
+   * precision is 8 and Huffman table optimization is disabled (see
+   * #TJPARAM_ARITHMETIC and #TJPARAM_OPTIMIZE) or a lossless JPEG image (see
+   * #TJPARAM_LOSSLESS), and TurboJPEG was built with multithreading
+   * support.
+   *
+   * Otherwise, if this parameter is set to a value other than `1`, then the
+   * compression functions use multiple threads to generate optimized Huffman
+   * tables (see #TJPARAM_OPTIMIZE.)  For single-scan JPEG images, the
+   * statistics for the optimized Huffman tables are gathered in parallel.  For
+   * progressive JPEG images (see #TJPARAM_PROGRESSIVE), the scans are gathered
+   * and encoded in parallel, once all of the DCT coefficients have been
+   * computed.  Each scan is encoded into a separate memory buffer, and the
+   * scans are then written to the JPEG image in order.  The output is
+   * identical to that of single-threaded compression.  This parameter
+   * currently has no effect on compression if arithmetic entropy coding is
+   * used (see #TJPARAM_ARITHMETIC.)
+   */
+  TJPARAM_NUMTHREADS,
+  /**
+   * Pipelined decompression [decompression]
+   *
+   * **Value**
+   * - `0` *[default]* Perform all decompression steps in the calling thread.
+   * - `1` Perform Huffman or arithmetic decoding in the calling thread, and
+   * perform the inverse DCT, upsampling, and color conversion steps in a
+   * second thread, so that the two halves of the decompression pipeline
+   * overlap.
+   *
+   * The output is identical to that of single-threaded decompression.  This
+   * parameter currently has no effect unless the JPEG image is a single-scan
+   * lossy JPEG image, it is being decompressed using #tj3Decompress8() or
+   * #tj3Decompress12(), and TurboJPEG was built with multithreading support.
+   * This parameter is also ignored if the image is decompressed in horizontal
+   * bands (see #TJPARAM_NUMTHREADS.)
+   */
+  TJPARAM_PIPELINE
 };
 
 
@@ -2060,6 +2139,70 @@ DLLEXPORT int tj3SetScalingFactor(tjhandle handle,
 DLLEXPORT int tj3SetCroppingRegion(tjhandle handle, tjregion croppingRegion);
 
 
+/**
+ * Build a random-access index for a JPEG image.
+ *
+ * The index records the state of the Huffman decoder at the start of each
+ * iMCU row of the JPEG image.  If the index is associated with a TurboJPEG
+ * decompression instance (see #tj3SetIndex()), then #tj3Decompress8() and
+ * #tj3Decompress12() use it to seek directly to the iMCU rows that are needed
+ * to decompress the cropping region (see #tj3SetCroppingRegion()), rather
+ * than decoding the JPEG image from the beginning.  This greatly accelerates
+ * the decompression of small regions from large JPEG images.  The index can
+ * be stored alongside the JPEG image and reused across TurboJPEG instances and
+ * processes.
+ *
+ * Only single-scan Huffman-coded lossy JPEG images with no restart markers can
+ * be indexed.  This function also reads the JPEG header, as
+ * #tj3DecompressHeader() does.
+ *
+ * @param handle handle to a TurboJPEG instance that has been initialized for
+ * decompression
+ *
+ * @param jpegBuf pointer to a byte buffer containing the JPEG image
+ *
+ * @param jpegSize size of the JPEG image (in bytes)
+ *
+ * @param indexBuf address of a pointer to a byte buffer.  Upon successful
+ * return, `*indexBuf` will point to a byte buffer containing the index.  This
+ * buffer should be freed using #tj3Free().
+ *
+ * @param indexSize address of a size_t variable.  Upon successful return, the
+ * variable will contain the size of the index (in bytes.)
+ *
+ * @return 0 if successful, or -1 if an error occurred (see #tj3GetErrorStr()
+ * and #tj3GetErrorCode().)
+ */
+DLLEXPORT int tj3BuildIndex(tjhandle handle, const unsigned char *jpegBuf,
+                            size_t jpegSize, unsigned char **indexBuf,
+                            size_t *indexSize);
+
+
+/**
+ * Associate a random-access index (see #tj3BuildIndex()) with a TurboJPEG
+ * decompression instance.
+ *
+ * The index is used only when decompressing a cropping region from the JPEG
+ * image from which the index was built.  Other JPEG images are decompressed
+ * normally, so the index need not be removed before decompressing them.
+ *
+ * @param handle handle to a TurboJPEG instance that has been initialized for
+ * decompression
+ *
+ * @param indexBuf pointer to a byte buffer containing an index that was
+ * previously generated by #tj3BuildIndex(), or NULL to remove any existing
+ * index from the TurboJPEG instance.  A copy of the index is stored in the
+ * TurboJPEG instance, so the buffer can be freed after this function returns.
+ *
+ * @param indexSize size of the index (in bytes)
+ *
+ * @return 0 if successful, or -1 if an error occurred (see #tj3GetErrorStr()
+ * and #tj3GetErrorCode().)
+ */
+DLLEXPORT int tj3SetIndex(tjhandle handle, const unsigned char *indexBuf,
+                          size_t indexSize);
+
+
 /**
  * Decompress a JPEG image with 2 to 8 bits of data precision per sample into a
  * packed-pixel RGB, grayscale, or CMYK image with the same data precision.
@@ -2147,6 +2290,80 @@ DLLEXPORT int tj3Decompress16(tjhandle handle, const unsigned char *jpegBuf,
                               int pitch, int pixelFormat);
 
 
+/**
+ * Decompress a JPEG file with 2 to 8 bits of data precision per sample into a
+ * newly-allocated packed-pixel RGB, grayscale, or CMYK image with the same
+ * data precision.  This function memory-maps the JPEG file read-only (on
+ * platforms that support memory-mapped I/O) and passes the whole mapping to
+ * #tj3Decompress8(), so the JPEG data is not copied.  If the file cannot be
+ * mapped, then it is read into memory instead.  The
+ * @ref TJPARAM "parameters" that describe the JPEG image will be set when
+ * this function returns.
+ *
+ * @note The scaling factor (see #tj3SetScalingFactor()) and cropping region
+ * (see #tj3SetCroppingRegion()) that are associated with the TurboJPEG
+ * instance are applied as with #tj3Decompress8().  Note that the JPEG file
+ * must not be truncated by another process while it is being decompressed.
+ *
+ * @param handle handle to a TurboJPEG instance that has been initialized for
+ * decompression
+ *
+ * @param filename name of a file containing the JPEG image to decompress
+ *
+ * @param width pointer to an integer variable that will receive the width (in
+ * pixels) of the decompressed image
+ *
+ * @param align row alignment (in samples) of the packed-pixel buffer to be
+ * returned (must be a power of 2.)  Setting this parameter to n will cause all
+ * rows in the buffer to be padded to the nearest multiple of n samples
+ * (1 = unpadded.)
+ *
+ * @param height pointer to an integer variable that will receive the height
+ * (in pixels) of the decompressed image
+ *
+ * @param pixelFormat pixel format of the packed-pixel buffer to be returned
+ * (see @ref TJPF "Pixel formats".)
+ *
+ * @return a pointer to a newly-allocated buffer containing the decompressed
+ * image, or NULL if an error occurred (see #tj3GetErrorStr() and
+ * #tj3GetErrorCode().)  This buffer should be freed using #tj3Free().  If the
+ * JPEG image is truncated or corrupt and #TJPARAM_STOPONWARNING is unset, then
+ * as much of the image as possible is decompressed and returned, and
+ * #tj3GetErrorCode() returns @ref TJERR_WARNING.
+ */
+DLLEXPORT unsigned char *tj3DecompressFile8(tjhandle handle,
+                                            const char *filename, int *width,
+                                            int align, int *height,
+                                            int pixelFormat);
+
+/**
+ * Decompress a JPEG file with 9 to 12 bits of data precision per sample into
+ * a newly-allocated packed-pixel RGB, grayscale, or CMYK image with the same
+ * data precision.  This function memory-maps the JPEG file read-only (on
+ * platforms that support memory-mapped I/O) and passes the whole mapping to
+ * #tj3Decompress12(), so the JPEG data is not copied.
+ *
+ * \details \copydetails tj3DecompressFile8()
+ */
+DLLEXPORT short *tj3DecompressFile12(tjhandle handle, const char *filename,
+                                     int *width, int align, int *height,
+                                     int pixelFormat);
+
+/**
+ * Decompress a lossless JPEG file with 13 to 16 bits of data precision per
+ * sample into a newly-allocated packed-pixel RGB, grayscale, or CMYK image
+ * with the same data precision.  This function memory-maps the JPEG file
+ * read-only (on platforms that support memory-mapped I/O) and passes the whole
+ * mapping to #tj3Decompress16(), so the JPEG data is not copied.
+ *
+ * \details \copydetails tj3DecompressFile8()
+ */
+DLLEXPORT unsigned short *tj3DecompressFile16(tjhandle handle,
+                                              const char *filename,
+                                              int *width, int align,
+                                              int *height, int pixelFormat);
+
+
 /**
  * Decompress an 8-bit-per-sample lossy JPEG image into separate
  * 8-bit-per-sample Y, U (Cb), and V (Cr) image planes.  This function performs